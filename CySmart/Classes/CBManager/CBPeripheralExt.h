@@ -33,6 +33,12 @@
 #import <Foundation/Foundation.h>
 @import CoreBluetooth;
 
+/*!
+ *  @discussion RSSI value that indicates the RSSI was not available
+ *
+ */
+#define RSSI_UNDEFINED_VALUE    127
+
 /*!
  *  @class CBPeripheralExt
  *
@@ -52,6 +58,14 @@
 
 @property (nonatomic, retain)CBPeripheral		*mPeripheral;
 
+/*!
+ *  @property identifier
+ *
+ *  @discussion  Identifier of the peripheral.
+ *
+ */
+@property (nonatomic, retain)NSUUID             *identifier;
+
 /*!
  *  @property mAdvertisementData
  *
@@ -69,4 +83,47 @@
  */
 @property (nonatomic, retain)NSNumber           *mRSSI;
 
+/*!
+ *  @property smoothedRSSI
+ *
+ *  @discussion   Moving average of the RSSI over the advertisements received, in dBm. RSSI_UNDEFINED_VALUE until an
+ *							RSSI is available.
+ *
+ */
+@property (nonatomic)double                     smoothedRSSI;
+
+/*!
+ *  @property lastSeenTime
+ *
+ *  @discussion   Time of the last advertisement received, on the CACurrentMediaTime clock
+ *
+ */
+@property (nonatomic)NSTimeInterval             lastSeenTime;
+
+/*!
+ *  @property lastUpdateTime
+ *
+ *  @discussion   Time of the last advertisement applied to the RSSI and advertisement data, on the CACurrentMediaTime
+ *							clock
+ *
+ */
+@property (nonatomic)NSTimeInterval             lastUpdateTime;
+
+/*!
+ *  @property scanIndex
+ *
+ *  @discussion   Position of the peripheral in the published scan list, NSNotFound until it is published
+ *
+ */
+@property (nonatomic)NSUInteger                 scanIndex;
+
+/*!
+ *  @method displayName
+ *
+ *  @discussion   Name shown for the peripheral: the advertised local name, else the name of the peripheral, else
+ *							"Unknown Peripheral".
+ *
+ */
+-(NSString *)displayName;
+
 @end
@@ -30,11 +30,38 @@
  *
  */
 #import "CBPeripheralExt.h"
+#import "Constants.h"
 
 @implementation CBPeripheralExt
 
 @synthesize mPeripheral;
+@synthesize identifier;
 @synthesize mAdvertisementData;
 @synthesize mRSSI;
+@synthesize smoothedRSSI;
+@synthesize lastSeenTime;
+@synthesize lastUpdateTime;
+@synthesize scanIndex;
+
+- (id)init {
+    if (self = [super init])
+    {
+        smoothedRSSI = RSSI_UNDEFINED_VALUE;
+        scanIndex = NSNotFound;
+    }
+    return self;
+}
+
+-(NSString *)displayName
+{
+    NSString *name = [mAdvertisementData valueForKey:CBAdvertisementDataLocalNameKey];
+    
+    // If the peripheral name is not found in advertisement data, then check whether it is there in peripheral object. If it's not found then assign it as unknown peripheral
+    if (name.length < 1)
+    {
+        name = mPeripheral.name.length > 0 ? mPeripheral.name : LOCALIZEDSTRING(@"unknownPeripheral");
+    }
+    return name;
+}
 
 @end
@@ -38,31 +38,6 @@
 @interface AccelerometerModel : NSObject
 
 
-/*!
- *  @property xValue
- *
- *  @discussion The accelerometer X coordinate value
- *
- */
-
-@property(nonatomic) float xValue;
-
-/*!
- *  @property yValue
- *
- *  @discussion The accelerometer Y coordinate value
- *
- */
-@property(nonatomic) float yValue;
-
-/*!
- *  @property zValue
- *
- *  @discussion The accelerometer Z coordinate value
- *
- */
-@property(nonatomic) float zValue;
-
 /*!
  *  @property scanIntervalString
  *
@@ -132,15 +107,6 @@
  */
 -(void) updateXYZCharacteristics;
 
-/*!
- *  @method getXYZValuesWithCharacteristic:
- *
- *  @discussion Method to get the accelerometer X,Y and Z values
- *
- */
-
--(void) getXYZValuesWithCharacteristic:(CBCharacteristic *)characteristic;
-
 /*!
  *  @method readAccelerometerCharacteristics
  *
@@ -74,7 +74,7 @@
     NSData  *valData = [NSData dataWithBytes:(void*)&val length:sizeof(val)];
     [[[CyCBManager sharedManager] myPeripheral] writeValue:valData forCharacteristic:scanIntervalCharacteristic type:CBCharacteristicWriteWithoutResponse];
     
-    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:ACCELEROMETER_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:scanIntervalCharacteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",WRITE_REQUEST,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:valData]]];
+    [Utilities logTraceWithService:ACCELEROMETER_SERVICE_UUID characteristic:scanIntervalCharacteristic.UUID descriptor:nil operation:GATT_TRACE_WRITE_REQUEST data:valData error:nil];
 }
 
 /*!
@@ -90,7 +90,7 @@
     NSData  *valData = [NSData dataWithBytes:(void*)&val length:sizeof(val)];
     [[[CyCBManager sharedManager] myPeripheral] writeValue:valData forCharacteristic:dataAccumulationCharacteristic type:CBCharacteristicWriteWithoutResponse];
     
-    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:ACCELEROMETER_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:dataAccumulationCharacteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",WRITE_REQUEST,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:valData]]];
+    [Utilities logTraceWithService:ACCELEROMETER_SERVICE_UUID characteristic:dataAccumulationCharacteristic.UUID descriptor:nil operation:GATT_TRACE_WRITE_REQUEST data:valData error:nil];
 }
 
 /*!
@@ -172,11 +172,11 @@
             
             if (status)
             {
-                [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:ACCELEROMETER_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:START_NOTIFY];
+                [Utilities logTraceWithService:ACCELEROMETER_SERVICE_UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_START_NOTIFY data:nil error:nil];
             }
             else
             {
-                 [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:ACCELEROMETER_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:STOP_NOTIFY];
+                 [Utilities logTraceWithService:ACCELEROMETER_SERVICE_UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_STOP_NOTIFY data:nil error:nil];
             }
         }
     }
@@ -198,54 +198,25 @@
     {
         [[[CyCBManager sharedManager] myPeripheral] readValueForCharacteristic:scanIntervalCharacteristic];
         
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:ACCELEROMETER_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:scanIntervalCharacteristic.UUID] descriptor:nil operation:READ_REQUEST];
+        [Utilities logTraceWithService:ACCELEROMETER_SERVICE_UUID characteristic:scanIntervalCharacteristic.UUID descriptor:nil operation:GATT_TRACE_READ_REQUEST data:nil error:nil];
     }
     
     if (dataAccumulationCharacteristic != nil)
     {
         [[[CyCBManager sharedManager] myPeripheral] readValueForCharacteristic:dataAccumulationCharacteristic];
         
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:ACCELEROMETER_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:dataAccumulationCharacteristic.UUID] descriptor:nil operation:READ_REQUEST];
+        [Utilities logTraceWithService:ACCELEROMETER_SERVICE_UUID characteristic:dataAccumulationCharacteristic.UUID descriptor:nil operation:GATT_TRACE_READ_REQUEST data:nil error:nil];
     }
     
     if (sensorTypecharacteristic != nil)
     {
         [[[CyCBManager sharedManager] myPeripheral] readValueForCharacteristic:sensorTypecharacteristic];
         
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:ACCELEROMETER_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:sensorTypecharacteristic.UUID] descriptor:nil operation:READ_REQUEST];
+        [Utilities logTraceWithService:ACCELEROMETER_SERVICE_UUID characteristic:sensorTypecharacteristic.UUID descriptor:nil operation:GATT_TRACE_READ_REQUEST data:nil error:nil];
     }
 }
 
 
-/*!
- *  @method getXYZValuesWithCharacteristic:
- *
- *  @discussion Method to get the accelerometer X,Y and Z values
- *
- */
-
-
--(void) getXYZValuesWithCharacteristic:(CBCharacteristic *)characteristic
-{
-    NSData *data = [characteristic value];
-    const uint8_t *reportData = (uint8_t *)[data bytes];
-    
-    if ([characteristic.UUID isEqual:ACCELEROMETER_READING_X_CHARACTERISTIC_UUID])
-    {
-        _xValue = CFSwapInt16LittleToHost(*(uint16_t *) &reportData[0]);
-    }
-    else if ([characteristic.UUID isEqual:ACCELEROMETER_READING_Y_CHARACTERISTIC_UUID])
-    {
-        _yValue = CFSwapInt16LittleToHost(*(uint16_t *) &reportData[0]);
-    }
-    else if ([characteristic.UUID isEqual:ACCELEROMETER_READING_Z_CHARACTERISTIC_UUID])
-    {
-        _zValue = CFSwapInt16LittleToHost(*(uint16_t *) &reportData[0]);
-    }
-
-    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",NOTIFY_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:data]]];
-}
-
 /*!
  *  @method getValuesForAcclerometerCharacteristics:
  *
@@ -270,7 +241,7 @@
         _sensorTypeString = [NSString stringWithFormat:@"%d",reportData[0]];
     }
     
-    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",READ_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:data]]];
+    [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_READ_RESPONSE data:data error:nil];
 
 }
 
@@ -33,6 +33,7 @@
 #import "BPModel.h"
 #import "CyCBManager.h"
 #import "Constants.h"
+#import "GATTMeasurements.h"
 
 /*!
  *  @class BPModel
@@ -78,7 +79,7 @@
     
     if (bpCharacteristic)
     {
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:BP_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:BP_MEASUREMENT_CHARACTERISTIC_UUID] descriptor:nil operation:START_NOTIFY];
+        [Utilities logTraceWithService:BP_SERVICE_UUID characteristic:BP_MEASUREMENT_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_START_NOTIFY data:nil error:nil];
         
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:YES forCharacteristic:bpCharacteristic];
     }
@@ -100,7 +101,7 @@
         {
             [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:NO forCharacteristic:bpCharacteristic];
             
-            [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:BP_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:BP_MEASUREMENT_CHARACTERISTIC_UUID] descriptor:nil operation:STOP_NOTIFY];
+            [Utilities logTraceWithService:BP_SERVICE_UUID characteristic:BP_MEASUREMENT_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_STOP_NOTIFY data:nil error:nil];
         }
     }
 }
@@ -163,33 +164,32 @@
 -(void) getBloodPressureDataFromChar:(CBCharacteristic *)characteristic
 {
     NSData *data = [characteristic value];
-    const uint8_t *reportData = (uint8_t *)[data bytes];
+    gatt_blood_pressure_measurement measurement;
     
-    // Checking the flag
-    
-    if (!(reportData[0] & 0x00))
+    if (gatt_decode_blood_pressure_measurement([data bytes], (uint32_t)[data length], &measurement) != 0)
     {
-        // BP details in units of mmHg
-        _bloodPressureUnitString = BLOOD_PRESSURE_UNIT_mmHg;
+        // Checking the flag
         
+        if (!(measurement.header.flags & GATT_BLOOD_PRESSURE_KPA))
+        {
+            // BP details in units of mmHg
+            _bloodPressureUnitString = BLOOD_PRESSURE_UNIT_mmHg;
+        }
+        else
+        {
+            //BP details in units of kPa
+            _bloodPressureUnitString = BLOOD_PRESSURE_UNIT_kPa;
+        }
+        
+        _systolicPressureValue = measurement.systolic;
+        _diastolicPressureValue = measurement.diastolic;
     }
-    else
-    {
-        //BP details in units of kPa
-        _bloodPressureUnitString = BLOOD_PRESSURE_UNIT_kPa;
-    }
-    
-     int16_t systolicData = (int16_t) CFSwapInt16LittleToHost(*(int16_t *) &reportData[1]);
-    _systolicPressureValue = [Utilities convertSFLOATFromData:systolicData];
-    
-    int16_t diastolicData = (int16_t) CFSwapInt16LittleToHost(*(int16_t *) &reportData[3]);
-    _diastolicPressureValue = [Utilities convertSFLOATFromData:diastolicData];
     
     if (cbCharacteristicHandler != nil) {
         cbCharacteristicHandler(YES,nil);
     }
     
-     [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",NOTIFY_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:data]]];
+     [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_NOTIFY_RESPONSE data:data error:nil];
 }
 
 @end
@@ -46,14 +46,6 @@
 
 @property (strong,nonatomic) NSString *sensorScanIntervalString;
 
-/*!
- *  @property pressureValueString
- *
- *  @discussion The barometer pressure value
- *
- */
-@property (strong,nonatomic) NSString *pressureValueString;
-
 /*!
  *  @property sensorTypeString
  *
@@ -65,7 +65,7 @@
     
     if (barometerReadingCharacteristic != nil)
     {
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:BAROMETER_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:barometerReadingCharacteristic.UUID] descriptor:nil operation:STOP_NOTIFY];
+        [Utilities logTraceWithService:BAROMETER_SERVICE_UUID characteristic:barometerReadingCharacteristic.UUID descriptor:nil operation:GATT_TRACE_STOP_NOTIFY data:nil error:nil];
         
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:NO forCharacteristic:barometerReadingCharacteristic];
     }
@@ -117,7 +117,7 @@
 {
     if (barometerReadingCharacteristic != nil)
     {
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:barometerReadingCharacteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:barometerReadingCharacteristic.UUID] descriptor:nil operation:START_NOTIFY];
+        [Utilities logTraceWithService:barometerReadingCharacteristic.service.UUID characteristic:barometerReadingCharacteristic.UUID descriptor:nil operation:GATT_TRACE_START_NOTIFY data:nil error:nil];
         
         
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:YES forCharacteristic:barometerReadingCharacteristic];
@@ -139,21 +139,21 @@
     {
         [[[CyCBManager sharedManager] myPeripheral] readValueForCharacteristic:sensorTypeCharacteristic];
         
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:ANALOG_TEMPERATURE_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:sensorTypeCharacteristic.UUID] descriptor:nil operation:READ_REQUEST];
+        [Utilities logTraceWithService:ANALOG_TEMPERATURE_SERVICE_UUID characteristic:sensorTypeCharacteristic.UUID descriptor:nil operation:GATT_TRACE_READ_REQUEST data:nil error:nil];
     }
     
     if (sensorScanIntervalCharacteristic != nil)
     {
         [[[CyCBManager sharedManager] myPeripheral] readValueForCharacteristic:sensorScanIntervalCharacteristic];
         
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:ANALOG_TEMPERATURE_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:sensorScanIntervalCharacteristic.UUID] descriptor:nil operation:READ_REQUEST];
+        [Utilities logTraceWithService:ANALOG_TEMPERATURE_SERVICE_UUID characteristic:sensorScanIntervalCharacteristic.UUID descriptor:nil operation:GATT_TRACE_READ_REQUEST data:nil error:nil];
     }
     
     if (dataAccumulationCharacterstic != nil)
     {
         [[[CyCBManager sharedManager] myPeripheral] readValueForCharacteristic:dataAccumulationCharacterstic];
         
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:ANALOG_TEMPERATURE_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:dataAccumulationCharacterstic.UUID] descriptor:nil operation:READ_REQUEST];
+        [Utilities logTraceWithService:ANALOG_TEMPERATURE_SERVICE_UUID characteristic:dataAccumulationCharacterstic.UUID descriptor:nil operation:GATT_TRACE_READ_REQUEST data:nil error:nil];
     }
     
 }
@@ -174,26 +174,19 @@
     {
         _sensorTypeString = [NSString stringWithFormat:@"%d",reportData[0]];
         
-         [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",READ_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:dataValue]]];
+         [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_READ_RESPONSE data:dataValue error:nil];
     }
     else if ([characteristic.UUID isEqual:BAROMETER_SENSOR_SCAN_INTERVAL_CHARACTERISTIC_UUID])
     {
         _sensorScanIntervalString = [NSString stringWithFormat:@"%d",reportData[0]];
         
-         [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",READ_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:dataValue]]];
+         [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_READ_RESPONSE data:dataValue error:nil];
     }
     else if ([characteristic.UUID isEqual:BAROMETER_DATA_ACCUMULATION_CHARACTERISTIC_UUID])
     {
         _filterTypeConfigurationString = [NSString stringWithFormat:@"%d",reportData[0]];
         
-         [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",READ_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:dataValue]]];
-    }
-    else if ([characteristic.UUID isEqual:BAROMETER_READING_CHARACTERISTIC_UUID])
-    {
-        float pressureValue = CFSwapInt16LittleToHost(*(uint16_t *) &reportData[0]);
-        _pressureValueString = [NSString stringWithFormat:@"%f",pressureValue];
-        
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",NOTIFY_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:dataValue]]];
+         [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_READ_RESPONSE data:dataValue error:nil];
     }
 
 }
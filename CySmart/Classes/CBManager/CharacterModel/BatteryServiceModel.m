@@ -89,7 +89,7 @@
     if (_batteryCharacterisic != nil)
     {
         isCharacteristicRead = YES;
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:BATTERY_LEVEL_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:BATTERY_LEVEL_CHARACTERISTIC_UUID] descriptor:nil operation:READ_REQUEST];
+        [Utilities logTraceWithService:BATTERY_LEVEL_SERVICE_UUID characteristic:BATTERY_LEVEL_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_READ_REQUEST data:nil error:nil];
         
         [[[CyCBManager sharedManager] myPeripheral] readValueForCharacteristic:_batteryCharacterisic];
     }
@@ -107,7 +107,7 @@
 
     if (_batteryCharacterisic != nil)
     {
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:BATTERY_LEVEL_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:BATTERY_LEVEL_CHARACTERISTIC_UUID] descriptor:nil operation:START_NOTIFY];
+        [Utilities logTraceWithService:BATTERY_LEVEL_SERVICE_UUID characteristic:BATTERY_LEVEL_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_START_NOTIFY data:nil error:nil];
         
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:YES forCharacteristic:_batteryCharacterisic];
     }
@@ -127,7 +127,7 @@
         if (_batteryCharacterisic.isNotifying)
         {
             [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:NO forCharacteristic:_batteryCharacterisic];
-            [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:BATTERY_LEVEL_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:BATTERY_LEVEL_CHARACTERISTIC_UUID] descriptor:nil operation:STOP_NOTIFY];
+            [Utilities logTraceWithService:BATTERY_LEVEL_SERVICE_UUID characteristic:BATTERY_LEVEL_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_STOP_NOTIFY data:nil error:nil];
         }
     }
 }
@@ -215,11 +215,11 @@
     
     if (!isCharacteristicRead)
     {
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",NOTIFY_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:data]]];
+        [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_NOTIFY_RESPONSE data:data error:nil];
     }
     else
     {
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",READ_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:data]]];
+        [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_READ_RESPONSE data:data error:nil];
         isCharacteristicRead = NO;
     }
     
@@ -31,6 +31,7 @@
  */
 
 #import <Foundation/Foundation.h>
+#import "CyChecksum.h"
 
 @interface BootLoaderServiceModel : NSObject
 
@@ -138,6 +139,14 @@
  */
 @property (nonatomic, readonly) BOOL isWriteWithoutResponseSupported;
 
+/*!
+ * @property negotiatedGattMtu
+ *
+ * @discussion Maximum length of a single write to the bootloader characteristic
+ *
+ */
+@property (nonatomic, readonly) unsigned int negotiatedGattMtu;
+
 /*!
  *  @method discoverCharacteristicsWithCompletionHandler:
  *
@@ -162,6 +171,14 @@
  */
 -(void) writeCharacteristicValueWithData:(NSData *)data command:(unsigned short)commandCode;
 
+/*!
+ *  @method sendDataPayloadSizeWithLimit:
+ *
+ *  @discussion Returns SEND_DATA payload size not exceeding limit for which every command packet fills whole writes of negotiatedGattMtu bytes
+ *
+ */
+-(unsigned short) sendDataPayloadSizeWithLimit:(unsigned short)limit;
+
 /*!
  *  @method stopUpdate
  *
@@ -192,7 +209,7 @@
  *  @discussion Method to set the checksum calculation type
  *
  */
--(void) setCheckSumType:(NSString *)type;
+-(void) setCheckSumType:(cy_checksum_type)type;
 
 /*!
  *  @method translateErrorCode:
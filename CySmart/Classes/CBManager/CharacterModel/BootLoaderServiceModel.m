@@ -35,6 +35,7 @@
 #import "CyCBManager.h"
 #import "Constants.h"
 #import "NSData+hexString.h"
+#import "OTATransferEngine.h"
 
 #define COMMAND_PACKET_MIN_SIZE  7
 
@@ -54,10 +55,10 @@
     void (^cbCharacteristicDiscoverHandler)(BOOL success, NSError *error);
     void (^cbBootloaderCharacteristicNotificationHandler)(NSError *error, id command, unsigned char otaError);
     CBCharacteristic * bootloaderCharacteristic;
+    id bootloaderSubscription;
     
     NSMutableArray * commandArray;
-    NSString * checkSumType;
-    unsigned int negotiatedGattMtu;
+    cy_checksum_type checkSumType;
 }
 
 @end
@@ -71,19 +72,24 @@
     if (self)
     {
         commandArray = [[NSMutableArray alloc] init];
-        negotiatedGattMtu = DEFAULT_GATT_MTU;
+        _negotiatedGattMtu = DEFAULT_GATT_MTU;
         _isWriteWithoutResponseSupported = NO;
     }
     return self;
 }
 
+-(void)dealloc
+{
+    [[[CyCBManager sharedManager] characteristicRouter] unsubscribe:bootloaderSubscription];
+}
+
 /*!
  *  @method setCheckSumType:
  *
  *  @discussion Method to set the checksum calculation type
  *
  */
--(void) setCheckSumType:(NSString *) type
+-(void) setCheckSumType:(cy_checksum_type) type
 {
     checkSumType = type;
 }
@@ -113,9 +119,17 @@
   NSLog(@"Cypress: enableNotificationForBootloaderCharacteristicAndSetNotificationHandler");
     cbBootloaderCharacteristicNotificationHandler = handler;
     
+    if (bootloaderSubscription == nil)
+    {
+        __weak BootLoaderServiceModel *weakSelf = self;
+        bootloaderSubscription = [[[CyCBManager sharedManager] characteristicRouter] subscribeToCharacteristic:BOOT_LOADER_CHARACTERISTIC_UUID ofService:CUSTOM_BOOT_LOADER_SERVICE_UUID handler:^(CBCharacteristic *characteristic, NSError *error) {
+            [weakSelf handleBootloaderCharacteristicUpdate:characteristic error:error];
+        }];
+    }
+    
     if (bootloaderCharacteristic != nil)
     {
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:bootloaderCharacteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:bootloaderCharacteristic.UUID] descriptor:nil operation:START_NOTIFY];
+        [Utilities logTraceWithService:bootloaderCharacteristic.service.UUID characteristic:bootloaderCharacteristic.UUID descriptor:nil operation:GATT_TRACE_START_NOTIFY data:nil error:nil];
         
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:YES forCharacteristic:bootloaderCharacteristic];
     }
@@ -137,44 +151,23 @@
             [commandArray addObject:@(commandCode)];
         }
         
-        NSString * serviceName = [ResourceHandler getServiceNameForUUID:bootloaderCharacteristic.service.UUID];
-        NSString * characteristicName = [ResourceHandler getCharacteristicNameForUUID:bootloaderCharacteristic.UUID];
-        NSString * operationInfo = [NSString stringWithFormat:@"%@%@ %@",WRITE_REQUEST,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:data]];
-        [Utilities logDataWithService:serviceName characteristic:characteristicName descriptor:nil operation:operationInfo];
+        [Utilities logTraceWithService:bootloaderCharacteristic.service.UUID characteristic:bootloaderCharacteristic.UUID descriptor:nil operation:GATT_TRACE_WRITE_REQUEST data:data error:nil];
         
         if (self.isWriteWithoutResponseSupported)
         {
-            NSUInteger totalLength = data.length;
-            NSUInteger localLength = 0;
-            uint8_t localBytes[negotiatedGattMtu];
-            NSData *localData;
-            //Write data by chunks of 20 bytes
+            NSUInteger offset = 0;
+            //Write data by chunks of negotiated MTU size. Chunks share the bytes of the packet, which they keep alive.
             do
             {
-                if (totalLength > negotiatedGattMtu)
-                {
-                    for (int i = 0; i < negotiatedGattMtu; i++)
-                    {
-                        localBytes[i] = ((uint8_t *)data.bytes)[localLength + i];
-                    }
-                    localData = [NSMutableData dataWithBytes:localBytes length:negotiatedGattMtu];
-                    totalLength -= negotiatedGattMtu;
-                    localLength += negotiatedGattMtu;
-                }
-                else
-                {
-                    uint8_t lastBytes[totalLength];
-                    for (int i = 0; i < totalLength; i++)
-                    {
-                        lastBytes[i] = ((uint8_t *)data.bytes)[localLength + i];
-                    }
-                    localData = [NSMutableData dataWithBytes:lastBytes length:totalLength];
-                    totalLength = 0;
-                }
+                NSUInteger length = MIN(data.length - offset, (NSUInteger)_negotiatedGattMtu);
+                NSData *localData = [[NSData alloc] initWithBytesNoCopy:(void *)((const uint8_t *)data.bytes + offset) length:length deallocator:^(void *bytes, NSUInteger sliceLength) {
+                    (void)data;
+                }];
+                offset += length;
               NSLog(@"Cypress: writing bytes=%@", [localData hexString]);
                 [[[CyCBManager sharedManager] myPeripheral] writeValue:localData forCharacteristic:bootloaderCharacteristic type:CBCharacteristicWriteWithoutResponse];
             }
-            while (totalLength > 0);
+            while (offset < data.length);
         }
         else
         {
@@ -184,6 +177,25 @@
     }
 }
 
+/*!
+ *  @method sendDataPayloadSizeWithLimit:
+ *
+ *  @discussion Returns SEND_DATA payload size for which every command packet fills whole writes of negotiated MTU size
+ *
+ */
+-(unsigned short) sendDataPayloadSizeWithLimit:(unsigned short)limit
+{
+    if (!self.isWriteWithoutResponseSupported)
+    {
+        // Writes with response are not split into chunks
+        return limit;
+    }
+    uint32_t size = ota_transfer_chunk_size(_negotiatedGattMtu, COMMAND_PACKET_MIN_SIZE, limit);
+    
+    // No payload fills whole writes when the command overhead is as long as the writes
+    return size > 0 ? (unsigned short)size : limit;
+}
+
 /*!
  *  @method stopUpdate
  *
@@ -194,11 +206,13 @@
 {
   NSLog(@"Cypress: stopUpdate");
     cbBootloaderCharacteristicNotificationHandler = nil;
+    [[[CyCBManager sharedManager] characteristicRouter] unsubscribe:bootloaderSubscription];
+    bootloaderSubscription = nil;
     [commandArray removeAllObjects];
     
     if (bootloaderCharacteristic != nil)
     {
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:bootloaderCharacteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:bootloaderCharacteristic.UUID] descriptor:nil operation:STOP_NOTIFY];
+        [Utilities logTraceWithService:bootloaderCharacteristic.service.UUID characteristic:bootloaderCharacteristic.UUID descriptor:nil operation:GATT_TRACE_STOP_NOTIFY data:nil error:nil];
         
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:NO forCharacteristic:bootloaderCharacteristic];
     }
@@ -227,14 +241,14 @@
                 if ((characteristic.properties & CBCharacteristicPropertyWriteWithoutResponse) != 0)
                 {
                     if ([peripheral respondsToSelector:@selector(maximumWriteValueLengthForType:)]) {
-                        negotiatedGattMtu = (unsigned int)[peripheral maximumWriteValueLengthForType:CBCharacteristicWriteWithoutResponse];
+                        _negotiatedGattMtu = (unsigned int)[peripheral maximumWriteValueLengthForType:CBCharacteristicWriteWithoutResponse];
                     }
                     _isWriteWithoutResponseSupported = YES;
                 }
                 else if ((characteristic.properties & CBCharacteristicPropertyWrite) != 0)
                 {
                     if ([peripheral respondsToSelector:@selector(maximumWriteValueLengthForType:)]) {
-                        negotiatedGattMtu = (unsigned int)[peripheral maximumWriteValueLengthForType:CBCharacteristicWriteWithResponse];
+                        _negotiatedGattMtu = (unsigned int)[peripheral maximumWriteValueLengthForType:CBCharacteristicWriteWithResponse];
                     }
                     _isWriteWithoutResponseSupported = NO;
                 }
@@ -249,14 +263,16 @@
     }
 }
 
+#pragma mark - Bootloader characteristic updates
+
 /*!
- *  @method peripheral: didUpdateValueForCharacteristic: error:
+ *  @method handleBootloaderCharacteristicUpdate: error:
  *
- *  @discussion Invoked on the characteristic value change/read
+ *  @discussion Handles a response of the bootloader characteristic, routed by the CharacteristicRouter subscription
  *
  */
--(void)peripheral:(CBPeripheral *)peripheral didUpdateValueForCharacteristic:(CBCharacteristic *)characteristic error:(NSError *)error {
-  NSLog(@"Cypress: didUpdateValueForCharacteristic: %@", characteristic.UUID);
+-(void)handleBootloaderCharacteristicUpdate:(CBCharacteristic *)characteristic error:(NSError *)error {
+  NSLog(@"Cypress: handleBootloaderCharacteristicUpdate: %@", characteristic.UUID);
     if (error == nil) {
         if ([characteristic.UUID isEqual:BOOT_LOADER_CHARACTERISTIC_UUID]) {
             unsigned char *bytes = (unsigned char *) [characteristic.value bytes];
@@ -321,7 +337,7 @@
                 }
             }
         }
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@", NOTIFY_RESPONSE, DATA_SEPERATOR, [Utilities convertDataToLoggerFormat:characteristic.value]]];
+        [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_NOTIFY_RESPONSE data:characteristic.value error:nil];
     } else {
         cbBootloaderCharacteristicNotificationHandler(error, 0, ERR_UNKNOWN);
     }
@@ -482,17 +498,9 @@
     
     //Add the data to send to the command packet
     if (SEND_DATA == commandCode || PROGRAM_ROW == commandCode) {
-        NSArray * dataArray = [dataDict objectForKey:ROW_DATA];
-        for (int i = 0; i<dataArray.count; i++) {
-            NSString * value = dataArray[i];
-            
-            unsigned int outVal;
-            NSScanner * scanner = [NSScanner scannerWithString:value];
-            [scanner scanHexInt:&outVal];
-            
-            unsigned short valueToWrite = (unsigned short)outVal;
-            commandPacket[idx++] = valueToWrite;
-        }
+        NSData * rowData = [dataDict objectForKey:ROW_DATA];
+        [rowData getBytes:&commandPacket[idx] length:rowData.length];
+        idx += rowData.length;
     }
     
     if (SET_ACTIVE_APP == commandCode) {
@@ -500,7 +508,7 @@
         commandPacket[idx++] = activeApp;
     }
    
-    unsigned short checkSum  = [self calculateChecksumWithCommandPacket:commandPacket withSize:(idx) type:checkSumType];
+    unsigned short checkSum  = cy_packet_checksum(checkSumType, commandPacket, idx);
     commandPacket[idx++] = checkSum;
     commandPacket[idx++] = checkSum >> 8;
     commandPacket[idx++] = COMMAND_END_BYTE;
@@ -574,17 +582,12 @@
     }
     if (SET_EIV == commandCode || SEND_DATA == commandCode || PROGRAM_DATA == commandCode)
     {
-        NSArray * dataArr = [dataDict objectForKey:ROW_DATA];
-        for (NSString * byteStr in dataArr)
-        {
-            uint32_t byte;
-            NSScanner * scanner = [NSScanner scannerWithString:byteStr];
-            [scanner scanHexInt:&byte];
-            commandPacket[idx++] = byte;
-        }
+        NSData * rowData = [dataDict objectForKey:ROW_DATA];
+        [rowData getBytes:&commandPacket[idx] length:rowData.length];
+        idx += rowData.length;
     }
     
-    uint16_t checkSum  = [self calculateChecksumWithCommandPacket:commandPacket withSize:(idx) type:checkSumType];
+    uint16_t checkSum  = cy_packet_checksum(checkSumType, commandPacket, idx);
     commandPacket[idx++] = checkSum;
     commandPacket[idx++] = checkSum >> 8;
     commandPacket[idx++] = COMMAND_END_BYTE;
@@ -595,56 +598,6 @@
     return data;
 }
 
-/*!
- *  @method calculateChacksumWithCommandPacket: withSize: type:
- *
- *  @discussion Method to calculate the checksum
- *
- */
--(unsigned short) calculateChecksumWithCommandPacket:(unsigned char [])array withSize:(int)packetSize type:(NSString *)type
-{
-  NSLog(@"Cypress: calculateChecksumWithCommandPacket");
-    if ([type isEqualToString:CHECK_SUM])
-    {
-        // Sum checksum
-        unsigned short sum = 0;
-        
-        for (int i = 0; i< packetSize; i++)
-        {
-            sum = sum + array[i];
-        }
-        return ~sum+1;
-    }
-    else
-    {
-        // CRC 16
-        unsigned short sum = 0xffff;
-        
-        unsigned short tmp;
-        int i;
-        
-        if (packetSize == 0)
-            return (~sum);
-        
-        do
-        {
-            for (i = 0, tmp = 0x00ff & *array++; i < 8; i++, tmp >>= 1)
-            {
-                if ((sum & 0x0001) ^ (tmp & 0x0001))
-                    sum = (sum >> 1) ^ 0x8408;
-                else
-                    sum >>= 1;
-            }
-        }
-        while (--packetSize);
-        
-        sum = ~sum;
-        tmp = sum;
-        sum = (sum << 8) | (tmp >> 8 & 0xFF);
-        return sum;
-    }
-}
-
 -(NSString *) errorMessageForErrorCode:(unsigned char)errorCode {
     switch(errorCode) {
         case ERR_FILE:
@@ -32,6 +32,7 @@
 #import "CSCModel.h"
 #import "CyCBManager.h"
 #import "Constants.h"
+#import "GATTMeasurements.h"
 
 
 /*!
@@ -98,7 +99,7 @@
     
     if (CSCCharacteristic)
     {
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:CSC_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:CSC_CHARACTERISTIC_UUID] descriptor:nil operation:START_NOTIFY];
+        [Utilities logTraceWithService:CSC_SERVICE_UUID characteristic:CSC_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_START_NOTIFY data:nil error:nil];
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:YES forCharacteristic:CSCCharacteristic];
     }
 }
@@ -118,7 +119,7 @@
     {
         if (CSCCharacteristic.isNotifying)
         {
-            [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:CSC_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:CSC_CHARACTERISTIC_UUID] descriptor:nil operation:STOP_NOTIFY];
+            [Utilities logTraceWithService:CSC_SERVICE_UUID characteristic:CSC_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_STOP_NOTIFY data:nil error:nil];
             [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:NO forCharacteristic:CSCCharacteristic];
         }
     }
@@ -194,36 +195,28 @@
 -(void) getCSCData:(CBCharacteristic *)characteristic
 {
     NSData *data =[characteristic value];
-    const uint8_t *reportData = [data bytes];
+    gatt_csc_measurement measurement;
     
-    int bitPosition = 1;
-    // Checking Cumulative Wheel Revolutions present
-    
-    if ((reportData[0] & 0x01) == 1)
+    if (gatt_decode_csc_measurement([data bytes], (uint32_t)[data length], &measurement) != 0)
     {
-        // Cumulative Wheel Revolutions present
-        uint32_t  wheelRevolutionsCount = (uint32_t)CFSwapInt32LittleToHost(*(uint32_t *)&reportData[bitPosition]);
-        bitPosition += 6;
+        // Checking Cumulative Wheel Revolutions present
         
+        uint32_t wheelRevolutionsCount = measurement.wheel_revolutions;
         if (wheelRevolutionsCount && _wheelRadius)
         {
             float wheelCircumference;
             wheelCircumference = (2 * 3.14 * _wheelRadius)/1000.0;
             self.coveredDistance = (float)wheelRevolutionsCount * wheelCircumference;
         }
-    }
-  
-    if ((reportData[0] & 0x02) > 0)
-    {
-        // Cumulative Crank Revolutions present
-        uint16_t CrankRevolutionsCount = CFSwapInt16LittleToHost(*(uint16_t *)(&reportData[bitPosition]));
-        bitPosition += 2;
         
-        uint16_t LastEvent = CFSwapInt16LittleToHost(*(uint16_t *)(&reportData[bitPosition]));
-        [self calculateRPMForCrankrevolutions:CrankRevolutionsCount eventTime:LastEvent];
+        if (measurement.header.flags & GATT_CSC_CRANK_REVOLUTIONS)
+        {
+            // Cumulative Crank Revolutions present
+            [self calculateRPMForCrankrevolutions:measurement.crank_revolutions eventTime:measurement.last_crank_event_time];
+        }
     }
     
-    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:CSC_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:CSC_CHARACTERISTIC_UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",NOTIFY_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:data]]];
+    [Utilities logTraceWithService:CSC_SERVICE_UUID characteristic:CSC_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_NOTIFY_RESPONSE data:data error:nil];
 
 }
 
@@ -96,7 +96,7 @@
     
     for (CBCharacteristic *aChar in deviceInfoCharArray)
     {
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:DEVICE_INFO_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:aChar.UUID] descriptor:nil operation:READ_REQUEST];
+        [Utilities logTraceWithService:DEVICE_INFO_SERVICE_UUID characteristic:aChar.UUID descriptor:nil operation:GATT_TRACE_READ_REQUEST data:nil error:nil];
         [[[CyCBManager sharedManager] myPeripheral] readValueForCharacteristic:aChar];
     }
 }
@@ -240,7 +240,7 @@
         }
     }
     
-    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:DEVICE_INFO_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",READ_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:charData]]];
+    [Utilities logTraceWithService:DEVICE_INFO_SERVICE_UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_READ_RESPONSE data:charData error:nil];
     
     charCount ++;
     
@@ -77,7 +77,7 @@
 -(void)updateProximityCharacteristicWithHandler:(void (^) (BOOL success, NSError *error))handler
 {
     cbTransmissionPowerCharacteristicHandler = handler;
-    [self logFindMeDataWithService:transmissionPowerCharacteristic.service characteristic:transmissionPowerCharacteristic data:READ_REQUEST];
+    [Utilities logTraceWithService:transmissionPowerCharacteristic.service.UUID characteristic:transmissionPowerCharacteristic.UUID descriptor:nil operation:GATT_TRACE_READ_REQUEST data:nil error:nil];
     [[[CyCBManager sharedManager] myPeripheral] readValueForCharacteristic:transmissionPowerCharacteristic];
 }
 
@@ -94,7 +94,7 @@
     uint8_t val = option; // The value which you want to write.
     NSData* valData = [NSData dataWithBytes:(void*)&val length:sizeof(val)];
     
-    [self logFindMeDataWithService:linkLossCharacteristic.service characteristic:linkLossCharacteristic data:[NSString stringWithFormat:@"%@%@ %@",WRITE_REQUEST,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:valData]]];
+    [Utilities logTraceWithService:linkLossCharacteristic.service.UUID characteristic:linkLossCharacteristic.UUID descriptor:nil operation:GATT_TRACE_WRITE_REQUEST data:valData error:nil];
     [[[CyCBManager sharedManager] myPeripheral] writeValue:valData forCharacteristic:linkLossCharacteristic type:CBCharacteristicWriteWithResponse];
 }
 
@@ -112,7 +112,7 @@
     NSData* valData = [NSData dataWithBytes:(void*)&val length:sizeof(val)];
     
     [[[CyCBManager sharedManager] myPeripheral] writeValue:valData forCharacteristic:_immediateAlertCharacteristic type:CBCharacteristicWriteWithoutResponse];
-    [self logFindMeDataWithService:_immediateAlertCharacteristic.service characteristic:_immediateAlertCharacteristic data:[NSString stringWithFormat:@"%@%@ %@",WRITE_REQUEST,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:valData]]];
+    [Utilities logTraceWithService:_immediateAlertCharacteristic.service.UUID characteristic:_immediateAlertCharacteristic.UUID descriptor:nil operation:GATT_TRACE_WRITE_REQUEST data:valData error:nil];
     
     cbImmedieteAlertCharacteristicHandler(YES,nil);
 }
@@ -222,14 +222,14 @@
         _transmissionPowerValue = dataPointer[0];
         
         // Data logging
-        [self logFindMeDataWithService:transmissionPowerCharacteristic.service characteristic:transmissionPowerCharacteristic data:[NSString stringWithFormat:@"%@%@ %@",READ_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:data]]];
+        [Utilities logTraceWithService:transmissionPowerCharacteristic.service.UUID characteristic:transmissionPowerCharacteristic.UUID descriptor:nil operation:GATT_TRACE_READ_RESPONSE data:data error:nil];
         
         if (cbTransmissionPowerCharacteristicHandler != nil)
         {
             cbTransmissionPowerCharacteristicHandler(YES,nil);
         }
         
-        [self logFindMeDataWithService:transmissionPowerCharacteristic.service characteristic:transmissionPowerCharacteristic data:READ_REQUEST];
+        [Utilities logTraceWithService:transmissionPowerCharacteristic.service.UUID characteristic:transmissionPowerCharacteristic.UUID descriptor:nil operation:GATT_TRACE_READ_REQUEST data:nil error:nil];
         
         [[[CyCBManager sharedManager] myPeripheral] readValueForCharacteristic:transmissionPowerCharacteristic];
 
@@ -260,29 +260,17 @@
     {
         if (error == nil)
         {
-            [self logFindMeDataWithService:linkLossCharacteristic.service characteristic:linkLossCharacteristic data:[NSString stringWithFormat:@"%@- %@",WRITE_REQUEST_STATUS,WRITE_SUCCESS]];
+            [Utilities logTraceWithService:linkLossCharacteristic.service.UUID characteristic:linkLossCharacteristic.UUID descriptor:nil operation:GATT_TRACE_WRITE_RESPONSE data:nil error:nil];
             cbLinkLossCharacteristicHandler(YES,nil);
             
         }
         else
         {
-            [self logFindMeDataWithService:linkLossCharacteristic.service characteristic:linkLossCharacteristic data:[NSString stringWithFormat:@"%@- %@%@",WRITE_REQUEST_STATUS,WRITE_ERROR,[error.userInfo objectForKey:NSLocalizedDescriptionKey]]];
+            [Utilities logTraceWithService:linkLossCharacteristic.service.UUID characteristic:linkLossCharacteristic.UUID descriptor:nil operation:GATT_TRACE_WRITE_RESPONSE data:nil error:error];
             cbLinkLossCharacteristicHandler(NO,error);
             
         }
     }
 }
 
-/*!
- *  @method logFindMeDataWithService: characteristic: data:
- *
- *  @discussion Method to log details of various operations
- *
- */
--(void) logFindMeDataWithService:(CBService *)service characteristic:(CBCharacteristic *)characteristic data:(NSString *)dataString
-{
-    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:dataString];
-}
-
-
 @end
@@ -39,32 +39,31 @@
 
 
 /*!
- *  @property glucoseRecords
+ *  @property recordCount
  *
- *  @discussion The glucose data records received from the kit
+ *  @discussion Number of glucose records received from the kit, each sequence number counted once
  *
  */
 
-@property (nonatomic, retain) NSMutableArray *glucoseRecords;
-
+@property (nonatomic, readonly) NSUInteger recordCount;
 
 /*!
- *  @property recordNameArray
+ *  @property latestRecordIndex
  *
- *  @discussion Array of the name of records 
+ *  @discussion Index of the record received last, NSNotFound if there are no records
  *
  */
 
-@property (strong, nonatomic) NSMutableArray *recordNameArray;
+@property (nonatomic, readonly) NSUInteger latestRecordIndex;
 
 /*!
- *  @property contextInfoArray
+ *  @property downloadRate
  *
- *  @discussion Array of glucose measurement context data
+ *  @discussion Records per second received by the last read of all records
  *
  */
 
-@property (strong, nonatomic) NSMutableArray *contextInfoArray;
+@property (nonatomic, readonly) double downloadRate;
 
 /*!
  *  @method startDiscoverChar:
@@ -98,6 +97,48 @@
 
 -(void) writeRACPCharacteristicWithValueString:(NSString *)Value;
 
+/*!
+ *  @method readAllRecordsWithProgressHandler:
+ *
+ *  @discussion Request every stored record. The handler is called for each record as it arrives with the number of
+ *  records and the records per second so far, and once more with finished set when the kit reports the request done.
+ */
+
+-(void) readAllRecordsWithProgressHandler:(void (^) (NSUInteger recordCount, double recordsPerSecond, BOOL finished))handler;
+
+/*!
+ *  @method recordNames
+ *
+ *  @discussion Names of the records in the order they were received
+ */
+
+-(NSArray *) recordNames;
+
+/*!
+ *  @method recordNameAtIndex:
+ *
+ *  @discussion Name of the record, its sequence number and time
+ */
+
+-(NSString *) recordNameAtIndex:(NSUInteger)index;
+
+/*!
+ *  @method glucoseDataAtIndex:
+ *
+ *  @discussion Glucose data of the record, as returned by getGlucoseData:
+ */
+
+-(NSMutableDictionary *) glucoseDataAtIndex:(NSUInteger)index;
+
+/*!
+ *  @method contextInfoForRecordAtIndex:
+ *
+ *  @discussion Context information of the record, as returned by getGlucoseContextInfoFromData:. Returns nil if no
+ *  context was received for it.
+ */
+
+-(NSMutableDictionary *) contextInfoForRecordAtIndex:(NSUInteger)index;
+
 /*!
  *  @method getGlucoseData:
  *
@@ -33,6 +33,8 @@
 #import "GlucoseModel.h"
 #import "Utilities.h"
 #import "Constants.h"
+#import "GATTMeasurements.h"
+#import "GlucoseRecordStore.h"
 
 #define CONCENTRATION_UNIT_IN_KG        @"kg/L"
 #define CONCENTRATION_UNIT_IN_MOL       @"mol/L"
@@ -43,6 +45,12 @@
 #define MEDICATION_UNIT_KG              @"kilograms"
 #define MEDICATION_UNIT_LITRE           @"liters"
 
+#define RACP_REPORT_STORED_RECORDS      0x01
+#define RACP_RESPONSE_CODE              0x06
+#define RACP_RESPONSE_LENGTH            4
+
+#define RECORD_TIME_FORMAT              @"yyyy MMM dd hh:mm:ss"
+
 /*!
  *  @class GlucoseModel
  *
@@ -58,21 +66,41 @@
 {
     void(^cbCharacteristicHandler)(BOOL success, NSError *error);
     void(^cbcharacteristicDiscoverHandler)(BOOL success, NSError *error);
+    void(^downloadProgressHandler)(NSUInteger recordCount, double recordsPerSecond, BOOL finished);
     
     CBCharacteristic *glucoseMeasurementChar, *recordAccessControlPointChar, *glucoseMeasurementContextChar;
+    
+    glucose_record_store recordStore;
+    CFAbsoluteTime downloadStartTime;
+    NSUInteger downloadedRecordCount;
 }
 
 - (instancetype)init
 {
     self = [super init];
     if (self) {
-        _glucoseRecords = [NSMutableArray array];
-        _recordNameArray = [NSMutableArray array];
-        _contextInfoArray = [NSMutableArray array];
+        if (!glucose_store_init(&recordStore)) {
+            return nil;
+        }
     }
     return self;
 }
 
+-(void)dealloc
+{
+    glucose_store_free(&recordStore);
+}
+
+-(NSUInteger)recordCount
+{
+    return recordStore.record_count;
+}
+
+-(NSUInteger)latestRecordIndex
+{
+    return recordStore.latest == GLUCOSE_NO_RECORD ? NSNotFound : (NSUInteger)recordStore.latest;
+}
+
 /*!
  *  @method startDiscoverChar:
  *
@@ -109,19 +137,19 @@
     if (glucoseMeasurementChar) {
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:YES forCharacteristic:glucoseMeasurementChar];
         
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:GLUCOSE_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:GLUCOSE_MEASUREMENT_CHARACTERISTIC_UUID] descriptor:nil operation:START_NOTIFY];
+        [Utilities logTraceWithService:GLUCOSE_SERVICE_UUID characteristic:GLUCOSE_MEASUREMENT_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_START_NOTIFY data:nil error:nil];
     }
     
     if (recordAccessControlPointChar) {
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:YES forCharacteristic:recordAccessControlPointChar];
         
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:GLUCOSE_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:GLUCOSE_RECORD_ACCESS_CONTROL_POINT_UUID] descriptor:nil operation:START_INDICATE];
+        [Utilities logTraceWithService:GLUCOSE_SERVICE_UUID characteristic:GLUCOSE_RECORD_ACCESS_CONTROL_POINT_UUID descriptor:nil operation:GATT_TRACE_START_INDICATE data:nil error:nil];
     }
     
     if(glucoseMeasurementContextChar){
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:YES forCharacteristic:glucoseMeasurementContextChar];
         
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:GLUCOSE_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:GLUCOSE_MEASUREMENT_CONTEXT_UUID] descriptor:nil operation:START_NOTIFY];
+        [Utilities logTraceWithService:GLUCOSE_SERVICE_UUID characteristic:GLUCOSE_MEASUREMENT_CONTEXT_UUID descriptor:nil operation:GATT_TRACE_START_NOTIFY data:nil error:nil];
     }
         
 }
@@ -137,12 +165,57 @@
     NSData *dataToWrite = [Utilities dataFromHexString:Value];
     if (recordAccessControlPointChar != nil) {
         
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:GLUCOSE_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:GLUCOSE_RECORD_ACCESS_CONTROL_POINT_UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@%@",WRITE_REQUEST,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:dataToWrite]]];
+        [Utilities logTraceWithService:GLUCOSE_SERVICE_UUID characteristic:GLUCOSE_RECORD_ACCESS_CONTROL_POINT_UUID descriptor:nil operation:GATT_TRACE_WRITE_REQUEST data:dataToWrite error:nil];
 
         [[[CyCBManager sharedManager] myPeripheral] writeValue:dataToWrite forCharacteristic:recordAccessControlPointChar type:CBCharacteristicWriteWithResponse];
     }
 }
 
+/*!
+ *  @method readAllRecordsWithProgressHandler:
+ *
+ *  @discussion Request every stored record, reporting each record as it arrives
+ */
+
+-(void) readAllRecordsWithProgressHandler:(void (^) (NSUInteger recordCount, double recordsPerSecond, BOOL finished))handler{
+    
+    downloadProgressHandler = handler;
+    cbCharacteristicHandler = nil;
+    downloadedRecordCount = 0;
+    downloadStartTime = CFAbsoluteTimeGetCurrent();
+    
+    const uint8_t command[] = {RACP_REPORT_STORED_RECORDS, 0x01};
+    NSData *dataToWrite = [NSData dataWithBytes:command length:sizeof(command)];
+    if (recordAccessControlPointChar != nil) {
+        
+        [Utilities logTraceWithService:GLUCOSE_SERVICE_UUID characteristic:GLUCOSE_RECORD_ACCESS_CONTROL_POINT_UUID descriptor:nil operation:GATT_TRACE_WRITE_REQUEST data:dataToWrite error:nil];
+        
+        [[[CyCBManager sharedManager] myPeripheral] writeValue:dataToWrite forCharacteristic:recordAccessControlPointChar type:CBCharacteristicWriteWithResponse];
+    }
+}
+
+/*!
+ *  @method reportDownloadProgressFinished:
+ *
+ *  @discussion Pass the number of records read so far and their rate to the progress handler
+ */
+
+-(void) reportDownloadProgressFinished:(BOOL)finished{
+    
+    if (downloadProgressHandler == nil) {
+        return;
+    }
+    
+    CFAbsoluteTime elapsed = CFAbsoluteTimeGetCurrent() - downloadStartTime;
+    double rate = elapsed > 0 ? downloadedRecordCount / elapsed : 0;
+    void(^handler)(NSUInteger recordCount, double recordsPerSecond, BOOL finished) = downloadProgressHandler;
+    if (finished) {
+        _downloadRate = rate;
+        downloadProgressHandler = nil;
+    }
+    handler(downloadedRecordCount, rate, finished);
+}
+
 /*!
  *  @method removePreviousRecords
  *
@@ -151,9 +224,7 @@
 
 -(void) removePreviousRecords{
    
-    [_contextInfoArray removeAllObjects];
-    [_glucoseRecords removeAllObjects];
-    [_recordNameArray removeAllObjects];
+    glucose_store_clear(&recordStore);
 }
 
 /*!
@@ -165,21 +236,21 @@
 {
     if (glucoseMeasurementChar){
         if (glucoseMeasurementChar.isNotifying){
-            [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:GLUCOSE_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:GLUCOSE_MEASUREMENT_CHARACTERISTIC_UUID] descriptor:nil operation:STOP_NOTIFY];
+            [Utilities logTraceWithService:GLUCOSE_SERVICE_UUID characteristic:GLUCOSE_MEASUREMENT_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_STOP_NOTIFY data:nil error:nil];
             [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:NO forCharacteristic:glucoseMeasurementChar];
         }
     }
    
     if (recordAccessControlPointChar) {
         if (recordAccessControlPointChar.isNotifying) {
-             [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:GLUCOSE_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:GLUCOSE_RECORD_ACCESS_CONTROL_POINT_UUID] descriptor:nil operation:STOP_INDICATE];
+             [Utilities logTraceWithService:GLUCOSE_SERVICE_UUID characteristic:GLUCOSE_RECORD_ACCESS_CONTROL_POINT_UUID descriptor:nil operation:GATT_TRACE_STOP_INDICATE data:nil error:nil];
             [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:NO forCharacteristic:recordAccessControlPointChar];
         }
     }
     
     if (glucoseMeasurementContextChar) {
         if (glucoseMeasurementContextChar.isNotifying) {
-             [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:GLUCOSE_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:GLUCOSE_MEASUREMENT_CONTEXT_UUID] descriptor:nil operation:STOP_NOTIFY];
+             [Utilities logTraceWithService:GLUCOSE_SERVICE_UUID characteristic:GLUCOSE_MEASUREMENT_CONTEXT_UUID descriptor:nil operation:GATT_TRACE_STOP_NOTIFY data:nil error:nil];
             [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:NO forCharacteristic:glucoseMeasurementContextChar];
         }
     }
@@ -244,35 +315,48 @@
     {
         if ([characteristic.UUID isEqual:GLUCOSE_MEASUREMENT_CHARACTERISTIC_UUID])
         {
-            if ([_glucoseRecords containsObject:characteristic.value]){
-                [_glucoseRecords removeObject:characteristic.value];
-                [_recordNameArray removeObject:[self getRecordNameFromcharacteristicValue:characteristic.value]];
+            // A record received again replaces the earlier one of its sequence number
+            gatt_glucose_measurement measurement;
+            if (gatt_decode_glucose_measurement([characteristic.value bytes], (uint32_t)[characteristic.value length], &measurement) != 0 &&
+                glucose_store_add_measurement(&recordStore, &measurement) != GLUCOSE_NO_RECORD)
+            {
+                downloadedRecordCount++;
+                [self reportDownloadProgressFinished:NO];
             }
             
-            [_glucoseRecords addObject:characteristic.value];
-            [_recordNameArray addObject:[self getRecordNameFromcharacteristicValue:characteristic.value]];
-            
-            [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:GLUCOSE_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:GLUCOSE_MEASUREMENT_CHARACTERISTIC_UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",NOTIFY_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:characteristic.value]]];
+            [Utilities logTraceWithService:GLUCOSE_SERVICE_UUID characteristic:GLUCOSE_MEASUREMENT_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_NOTIFY_RESPONSE data:characteristic.value error:nil];
 
         }
         else if ([characteristic.UUID isEqual:GLUCOSE_MEASUREMENT_CONTEXT_UUID])
         {
-            if (![_contextInfoArray containsObject:characteristic.value]) {
-                [_contextInfoArray addObject:characteristic.value];
+            gatt_glucose_context context;
+            if (gatt_decode_glucose_context([characteristic.value bytes], (uint32_t)[characteristic.value length], &context) != 0) {
+                glucose_store_add_context(&recordStore, &context);
             }
             
-            [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:GLUCOSE_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:GLUCOSE_MEASUREMENT_CONTEXT_UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",NOTIFY_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:characteristic.value]]];
+            [Utilities logTraceWithService:GLUCOSE_SERVICE_UUID characteristic:GLUCOSE_MEASUREMENT_CONTEXT_UUID descriptor:nil operation:GATT_TRACE_NOTIFY_RESPONSE data:characteristic.value error:nil];
         }
         else if ([characteristic.UUID isEqual:GLUCOSE_RECORD_ACCESS_CONTROL_POINT_UUID]){
             
-            [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:GLUCOSE_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:GLUCOSE_RECORD_ACCESS_CONTROL_POINT_UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",INDICATE_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:characteristic.value]]];
+            [Utilities logTraceWithService:GLUCOSE_SERVICE_UUID characteristic:GLUCOSE_RECORD_ACCESS_CONTROL_POINT_UUID descriptor:nil operation:GATT_TRACE_INDICATE_RESPONSE data:characteristic.value error:nil];
+            
+            // The response code ends the report of stored records, whether records were found or not
+            const uint8_t *response = [characteristic.value bytes];
+            if ([characteristic.value length] >= RACP_RESPONSE_LENGTH && response[0] == RACP_RESPONSE_CODE && response[2] == RACP_REPORT_STORED_RECORDS) {
+                [self reportDownloadProgressFinished:YES];
+            }
         }
         
-        cbCharacteristicHandler(YES,nil);
+        if (cbCharacteristicHandler) {
+            cbCharacteristicHandler(YES,nil);
+        }
     }
     else
     {
-        cbCharacteristicHandler(NO,error);
+        [self reportDownloadProgressFinished:YES];
+        if (cbCharacteristicHandler) {
+            cbCharacteristicHandler(NO,error);
+        }
     }
 }
 
@@ -283,124 +367,131 @@
     if ([characteristic.UUID isEqual:GLUCOSE_RECORD_ACCESS_CONTROL_POINT_UUID]) {
         if (error == nil) {
             
-            [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@- %@",WRITE_REQUEST_STATUS,WRITE_SUCCESS]];
+            [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_WRITE_RESPONSE data:nil error:nil];
         }
         else
         {
-            [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@- %@%@",WRITE_REQUEST_STATUS,WRITE_ERROR,[error.userInfo objectForKey:NSLocalizedDescriptionKey]]];
+            [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_WRITE_RESPONSE data:nil error:error];
         }
     }
 }
 
 
+/*!
+ *  @method timeStringOfMeasurement:time:
+ *
+ *  @discussion Returns the time of the measurement as shown in the record list, nil if its base time is not a valid
+ *  date. The time is in the calendar of the kit, so it is formatted without time zone.
+ *
+ */
+
+-(NSString *) timeStringOfMeasurement:(const gatt_glucose_measurement *)measurement time:(int64_t)time
+{
+    static NSDateFormatter *dateFormat;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        dateFormat = [[NSDateFormatter alloc] init];
+        [dateFormat setTimeZone:[NSTimeZone timeZoneForSecondsFromGMT:0]];
+        [dateFormat setDateFormat:RECORD_TIME_FORMAT];
+    });
+    
+    gatt_date_time baseTime = measurement->base_time;
+    if (baseTime.month < 1 || baseTime.month > 12 || baseTime.day < 1 || baseTime.day > 31 ||
+        baseTime.hours > 23 || baseTime.minutes > 59 || baseTime.seconds > 59)
+    {
+        return nil;
+    }
+    return [dateFormat stringFromDate:[NSDate dateWithTimeIntervalSince1970:time]];
+}
+
 /*!
  *  @method getGlucoseData:
  *
- *  @discussion  Instance method to parse the data received from the peripheral
+ *  @discussion  Instance method to parse the data received from the peripheral. Returns an empty dictionary if the
+ *  value is shorter than its flags say.
  */
 
 -(NSMutableDictionary *) getGlucoseData:(NSData *)characteristicValue
 {
-    NSData *charData = characteristicValue;
-    uint8_t *dataPointer = (uint8_t *)[charData bytes];
-    uint8_t flags = dataPointer[0];
-    
-    NSMutableDictionary *dataDict = [NSMutableDictionary dictionary];
-    int16_t timeOffset = 0;
-    
-    // Get the sequence number
-    dataPointer++;
-    
-    uint16_t sequenceNumber = (uint16_t) CFSwapInt16LittleToHost(*(uint16_t *) dataPointer);
-    [dataDict setObject:[NSNumber numberWithUnsignedInteger:sequenceNumber] forKey:SEQUENCE_NUMBER];
-    // Get date
-    
-    dataPointer+=2;
-    uint16_t year = CFSwapInt16LittleToHost(*(uint16_t*)dataPointer); dataPointer += 2;
-    uint8_t month = *(uint8_t*)dataPointer; dataPointer++;
-    uint8_t day = *(uint8_t*)dataPointer; dataPointer++;
-    uint8_t hour = *(uint8_t*)dataPointer; dataPointer++;
-    uint8_t min = *(uint8_t*)dataPointer; dataPointer++;
-    uint8_t sec = *(uint8_t*)dataPointer; dataPointer++;
-    
-    NSString * dateString = [NSString stringWithFormat:@"%d %d %d %d %d %d", year, month, day, hour, min, sec];
-    
-    NSDateFormatter *dateFormat = [[NSDateFormatter alloc] init];
-    [dateFormat setDateFormat: @"yyyy MM dd HH mm ss"];
-    NSDate* date = [dateFormat dateFromString:dateString];
-    
-    if (flags & 0x01) {
-        // Time Offset Present
-        
-        timeOffset = CFSwapInt16LittleToHost(*(int16_t *) dataPointer);
-        dataPointer= dataPointer + 2;
+    gatt_glucose_measurement measurement;
+    if (gatt_decode_glucose_measurement([characteristicValue bytes], (uint32_t)[characteristicValue length], &measurement) == 0)
+    {
+        return [NSMutableDictionary dictionary];
     }
+    int64_t time = glucose_calendar_seconds(&measurement.base_time) + (int64_t)measurement.time_offset * 60;
+    return [self glucoseDataOfMeasurement:&measurement time:time];
+}
 
-    if (timeOffset > 0) {
-        date = [date dateByAddingTimeInterval:timeOffset * 60];
+/*!
+ *  @method glucoseDataAtIndex:
+ *
+ *  @discussion Glucose data of the record
+ */
+
+-(NSMutableDictionary *) glucoseDataAtIndex:(NSUInteger)index
+{
+    if (index >= recordStore.record_count)
+    {
+        return [NSMutableDictionary dictionary];
     }
-    /*EEE for day, yyyy for Year, dd for date, MM for month*/
-    
-    [dateFormat setDateFormat:@"yyyy MMM dd"];
-    NSString* dateFormattedString = [dateFormat stringFromDate:date];
-    
-    [dateFormat setDateFormat:@"hh:mm:ss"];
-    NSString* timeFormattedString = [dateFormat stringFromDate:date];
+    const glucose_record *record = &recordStore.records[index];
+    return [self glucoseDataOfMeasurement:&record->measurement time:record->time];
+}
+
+/*!
+ *  @method glucoseDataOfMeasurement:time:
+ *
+ *  @discussion Dictionary of the measurement fields for display
+ */
+
+-(NSMutableDictionary *) glucoseDataOfMeasurement:(const gatt_glucose_measurement *)measurementPointer time:(int64_t)time
+{
+    NSMutableDictionary *dataDict = [NSMutableDictionary dictionary];
+    gatt_glucose_measurement measurement = *measurementPointer;
+    uint32_t flags = measurement.header.flags;
     
+    // Get the sequence number
+    [dataDict setObject:[NSNumber numberWithUnsignedInteger:measurement.sequence_number] forKey:SEQUENCE_NUMBER];
     
-    if( dateFormattedString && timeFormattedString )
+    // Get date, with the time offset if present
+    NSString *timeString = [self timeStringOfMeasurement:&measurement time:time];
+    if (timeString)
     {
-        NSString *timeString = [NSString stringWithFormat:@"%@ %@", dateFormattedString, timeFormattedString];
         [dataDict setObject:timeString forKey:BASE_TIME];
     }
     
-    
     // Checking whether Glucose concentration,type or sample location present
     
-    if (flags & 0x02)
+    if (flags & GATT_GLUCOSE_CONCENTRATION)
     {
         // Checking Glucose concentration unit
         
-        float concentrationValue;
-        
-        if (!(flags & 0x04))
+        if (!(flags & GATT_GLUCOSE_MOL_PER_LITRE))
         {
             // Unit is kg/L
-            
             [dataDict setObject:CONCENTRATION_UNIT_IN_KG forKey:CONCENTRATION_UNIT];
-            
-            int16_t tempData = (uint16_t)CFSwapInt16LittleToHost(*((uint16_t *) dataPointer));
-            concentrationValue = [Utilities convertSFLOATFromData:tempData];
-            
-            dataPointer +=2;
         }
         else
         {
             // Unit is mol/L
-            
             [dataDict setObject:CONCENTRATION_UNIT_IN_MOL forKey:CONCENTRATION_UNIT];
-            
-            int16_t tempData = (uint16_t)CFSwapInt16LittleToHost(*((uint16_t *) dataPointer));
-            concentrationValue = [Utilities convertSFLOATFromData:tempData];
-            dataPointer +=2;
         }
         
-        [dataDict setObject:[NSString stringWithFormat:@"%f",concentrationValue] forKey:CONCENTRATION_VALUE];
+        [dataDict setObject:[NSString stringWithFormat:@"%f",measurement.concentration] forKey:CONCENTRATION_VALUE];
         
         // Get type
         
-        uint8_t tempValue = *(uint8_t *)dataPointer;
-        uint8_t typeValue = tempValue & 0x0F;
+        uint8_t typeValue = measurement.type_and_location & 0x0F;
         [dataDict setObject:[self getTypeNameForValue:typeValue] forKey:TYPE];
         
         // Get sample location
         
-        uint8_t locationValue = (tempValue >> 4) & 0x0F;
+        uint8_t locationValue = (measurement.type_and_location >> 4) & 0x0F;
         [dataDict setObject:[self getSampleLocationForValue:locationValue] forKey:SAMPLE_LOCATION];
     }
     
     // Checking whether the context information is available
-    if (flags & 0x10) {
+    if (flags & GATT_GLUCOSE_CONTEXT_FOLLOWS) {
         [dataDict setObject:[NSNumber numberWithBool:YES] forKey:CONTEXT_INFO_PRESENT];
     }
     else{
@@ -413,102 +504,105 @@
 /*!
  *  @method getGlucoseContextInfoFromData:
  *
- *  @discussion Method to parse the value from the glucose measurement context characteristic
+ *  @discussion Method to parse the value from the glucose measurement context characteristic. Returns an empty
+ *  dictionary if the value is shorter than its flags say.
  *
  */
 
 -(NSMutableDictionary *) getGlucoseContextInfoFromData:(NSData *) characteristicValue
 {
     
+    gatt_glucose_context context;
+    if (gatt_decode_glucose_context([characteristicValue bytes], (uint32_t)[characteristicValue length], &context) == 0)
+    {
+        return [NSMutableDictionary dictionary];
+    }
+    return [self contextInfoOfContext:&context];
+}
+
+/*!
+ *  @method contextInfoForRecordAtIndex:
+ *
+ *  @discussion Context information of the record, nil if no context was received for it
+ *
+ */
+
+-(NSMutableDictionary *) contextInfoForRecordAtIndex:(NSUInteger)index
+{
+    if (index >= recordStore.record_count)
+    {
+        return nil;
+    }
+    const gatt_glucose_context *context = glucose_store_context_of(&recordStore, (uint32_t)index);
+    return context ? [self contextInfoOfContext:context] : nil;
+}
+
+/*!
+ *  @method contextInfoOfContext:
+ *
+ *  @discussion Dictionary of the context fields for display
+ *
+ */
+
+-(NSMutableDictionary *) contextInfoOfContext:(const gatt_glucose_context *)contextPointer
+{
     NSMutableDictionary *contextDataDict = [NSMutableDictionary dictionary];
-    
-    uint8_t *dataPointer = (uint8_t *) [characteristicValue bytes];
-    uint8_t flags = dataPointer[0];
+    gatt_glucose_context context = *contextPointer;
+    uint32_t flags = context.header.flags;
     
     // Get the sequence number
-    dataPointer++;
-    
-    uint16_t sequenceNumber = (uint16_t) CFSwapInt16LittleToHost(*(uint16_t *) dataPointer);
-    [contextDataDict setObject:[NSNumber numberWithUnsignedInteger:sequenceNumber] forKey:SEQUENCE_NUMBER];
+    [contextDataDict setObject:[NSNumber numberWithUnsignedInteger:context.sequence_number] forKey:SEQUENCE_NUMBER];
     
-    dataPointer += 2;
     // Checking Carbohydrate ID And Carbohydrate Present
     
-    if (flags & 01) {
+    if (flags & GATT_GLUCOSE_CONTEXT_CARBOHYDRATE) {
         
-        dataPointer = dataPointer + 1;
-        uint8_t carboHydrateID = *(uint8_t *)dataPointer;
-        [contextDataDict setObject:[self getCarbohydrateIDForValue:carboHydrateID] forKey:CARBOHYDARATE_ID];
+        [contextDataDict setObject:[self getCarbohydrateIDForValue:context.carbohydrate_id] forKey:CARBOHYDARATE_ID];
         
         // Getting carbohydrate in units of Kg
-        dataPointer++;
-        
-        int16_t carbohydrateData = (int16_t)CFSwapInt16LittleToHost(*(int16_t *) dataPointer);
-        float carbohydrate = [Utilities convertSFLOATFromData:carbohydrateData];
-        
-        dataPointer = dataPointer + 2;
-        [contextDataDict setObject:[NSString stringWithFormat:@"%f Kg",carbohydrate] forKey:CARBOHYDARATE];
+        [contextDataDict setObject:[NSString stringWithFormat:@"%f Kg",context.carbohydrate] forKey:CARBOHYDARATE];
     }
     
     // Checking meal present
     
-    if (flags & 0x02) {
-        
-        uint8_t mealValue = *(uint8_t *)dataPointer;
-        dataPointer++;
-        [contextDataDict setObject:[self getMealInfoForValue:mealValue] forKey:MEAL];
+    if (flags & GATT_GLUCOSE_CONTEXT_MEAL) {
+        [contextDataDict setObject:[self getMealInfoForValue:context.meal] forKey:MEAL];
     }
     
     // Checking Tester-Health Present
     
-    if (flags & 0x04) {
+    if (flags & GATT_GLUCOSE_CONTEXT_TESTER_HEALTH) {
         
-        uint8_t tempValue = *(uint8_t *)dataPointer;
-        uint8_t testerValue = (tempValue & 0x0F);
+        uint8_t testerValue = (context.tester_and_health & 0x0F);
         [contextDataDict setObject:[self getTesterInfo:testerValue] forKey:TESTER];
         
-        uint8_t healthValue = ((tempValue >> 4) & 0x0F);
+        uint8_t healthValue = ((context.tester_and_health >> 4) & 0x0F);
         [contextDataDict setObject:[self getMealInfoForValue:healthValue] forKey:HEALTH];
-        dataPointer++;
     }
     
     // Checking Exercise Duration And Exercise Intensity Present
     
-    if (flags & 0x08) {
-        
-        uint16_t exerciseduration = CFSwapInt16LittleToHost(*(uint16_t *) dataPointer);
-        [contextDataDict setObject:[NSString stringWithFormat:@"%d %@",exerciseduration,EXERCISE_DURATION_UNIT] forKey:EXERCISE_DURATION];
-        
-        dataPointer = dataPointer + 2;
+    if (flags & GATT_GLUCOSE_CONTEXT_EXERCISE) {
         
-        uint8_t exerciseIntensity = *(uint8_t *)dataPointer;
-        [contextDataDict setObject:[NSString stringWithFormat:@"%d",exerciseIntensity] forKey:EXERCISE_INTENSITY];
-        
-        dataPointer++;
+        [contextDataDict setObject:[NSString stringWithFormat:@"%d %@",context.exercise_duration,EXERCISE_DURATION_UNIT] forKey:EXERCISE_DURATION];
+        [contextDataDict setObject:[NSString stringWithFormat:@"%d",context.exercise_intensity] forKey:EXERCISE_INTENSITY];
     }
     
     // Checking Medication ID And Medication Present
     
     float medicationValue = 0.0;
     
-    if (flags & 0x10) {
-        
-        uint8_t medicationID = *(uint8_t *) dataPointer;
-        [contextDataDict setObject:[self getMedicationIDInfoForValue:medicationID] forKey:MEDICATION_ID];
-        
-        dataPointer++;
-        
-        int16_t medicationData = (int16_t)CFSwapInt16LittleToHost(*(int16_t *) dataPointer);
-        medicationValue = [Utilities convertSFLOATFromData:medicationData];
+    if (flags & GATT_GLUCOSE_CONTEXT_MEDICATION) {
         
-        dataPointer = dataPointer + 2;
+        [contextDataDict setObject:[self getMedicationIDInfoForValue:context.medication_id] forKey:MEDICATION_ID];
+        medicationValue = context.medication;
     }
     
     // Checking Medication Value Units
     
     NSString *medicationUnit = @"";
     
-    if (flags & 0x20) {
+    if (flags & GATT_GLUCOSE_CONTEXT_MEDICATION_LITRE) {
         medicationUnit = MEDICATION_UNIT_LITRE;
     }
     else{
@@ -521,67 +615,47 @@
     
     // CHECKING HbA1c Present
     
-    if (flags & 0x04) {
-        int16_t diebeticsData = (int16_t) CFSwapInt16LittleToHost(*(int16_t *) dataPointer);
-        float hbA1cValue = [Utilities convertSFLOATFromData:diebeticsData];
-        [contextDataDict setObject:[NSString stringWithFormat:@"%f",hbA1cValue] forKey:HBA1C];
+    if (flags & GATT_GLUCOSE_CONTEXT_HBA1C) {
+        [contextDataDict setObject:[NSString stringWithFormat:@"%f",context.hba1c] forKey:HBA1C];
     }
     return contextDataDict;
 }
 
 
--(NSString *)getRecordNameFromcharacteristicValue:(NSData *)characteristicValue{
-    
-    NSString *recordName = @"";
-    NSString *timeString = @"";
-    uint8_t *dataPointer = (uint8_t *)[characteristicValue bytes];
-    uint8_t flags = dataPointer[0];
-    
-    dataPointer++;
-    uint16_t sequenceNumber = CFSwapInt16LittleToHost(*(uint16_t *)dataPointer);
-    dataPointer = dataPointer + 2;
-    
-    uint16_t year = CFSwapInt16LittleToHost(*(uint16_t*)dataPointer); dataPointer += 2;
-    uint8_t month = *(uint8_t*)dataPointer; dataPointer++;
-    uint8_t day = *(uint8_t*)dataPointer; dataPointer++;
-    uint8_t hour = *(uint8_t*)dataPointer; dataPointer++;
-    uint8_t min = *(uint8_t*)dataPointer; dataPointer++;
-    uint8_t sec = *(uint8_t*)dataPointer; dataPointer++;
-    
-    int16_t timeOffset = 0;
-    if (flags & 0x01) {
-        timeOffset = CFSwapInt16LittleToHost(*(int16_t *) dataPointer);
-    }
-    
-    // Adding the time offset with base time
-    
-    NSString * dateString = [NSString stringWithFormat:@"%d %d %d %d %d %d", year, month, day, hour, min, sec];
-    
-    NSDateFormatter *dateFormat = [[NSDateFormatter alloc] init];
-    [dateFormat setDateFormat: @"yyyy MM dd HH mm ss"];
-    NSDate* date = [dateFormat dateFromString:dateString];
-    
-    if (timeOffset > 0) {
-        date = [date dateByAddingTimeInterval:timeOffset * 60];
-    }
-    
-    /*EEE for day, yyyy for Year, dd for date, MM for month*/
-    
-    [dateFormat setDateFormat:@"yyyy MMM dd"];
-    NSString* dateFormattedString = [dateFormat stringFromDate:date];
-    
-    [dateFormat setDateFormat:@"hh:mm:ss"];
-    NSString* timeFormattedString = [dateFormat stringFromDate:date];
-    
+/*!
+ *  @method recordNameAtIndex:
+ *
+ *  @discussion Name of the record, its sequence number and time
+ *
+ */
+
+-(NSString *)recordNameAtIndex:(NSUInteger)index{
     
-    if( dateFormattedString && timeFormattedString )
+    if (index >= recordStore.record_count)
     {
-        timeString = [NSString stringWithFormat:@"%@ %@", dateFormattedString, timeFormattedString];
+        return @"";
     }
+    const glucose_record *record = &recordStore.records[index];
+    NSString *timeString = [self timeStringOfMeasurement:&record->measurement time:record->time] ?: @"";
+    return [NSString stringWithFormat:@"%d - %@",record->measurement.sequence_number,timeString];
+}
 
-    recordName = [NSString stringWithFormat:@"%d - %@",sequenceNumber,timeString];
+/*!
+ *  @method recordNames
+ *
+ *  @discussion Names of the records in the order they were received. They are formatted here, when shown, rather
+ *  than as each record arrives.
+ *
+ */
+
+-(NSArray *)recordNames{
     
-    return recordName;
+    NSMutableArray *names = [NSMutableArray arrayWithCapacity:recordStore.record_count];
+    for (NSUInteger index = 0; index < recordStore.record_count; index++)
+    {
+        [names addObject:[self recordNameAtIndex:index]];
+    }
+    return names;
 }
 
 
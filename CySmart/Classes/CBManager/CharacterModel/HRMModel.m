@@ -32,6 +32,7 @@
 
 #import "HRMModel.h"
 #import "CyCBManager.h"
+#import "GATTMeasurements.h"
 
 #define MAX_NUM_RR_INTERVALS 3 // Display up to 3 RR intervals
 
@@ -91,7 +92,7 @@
             if ([aChar.UUID isEqual:HRM_CHARACTERISTIC_UUID]) {
                 if (aChar.isNotifying) {
                     [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:NO  forCharacteristic:aChar];
-                    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:HRM_HEART_RATE_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:HRM_CHARACTERISTIC_UUID] descriptor:nil operation:STOP_NOTIFY];
+                    [Utilities logTraceWithService:HRM_HEART_RATE_SERVICE_UUID characteristic:HRM_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_STOP_NOTIFY data:nil error:nil];
                 }
                 cbCharacteristicDiscoveryHandler(YES,nil);
                 break;
@@ -114,12 +115,12 @@
         for (CBCharacteristic *aChar in service.characteristics) {
             if ([aChar.UUID isEqual:HRM_CHARACTERISTIC_UUID]) {
                 [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:YES forCharacteristic:aChar];
-                [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:HRM_HEART_RATE_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:HRM_CHARACTERISTIC_UUID] descriptor:nil operation:START_NOTIFY];
+                [Utilities logTraceWithService:HRM_HEART_RATE_SERVICE_UUID characteristic:HRM_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_START_NOTIFY data:nil error:nil];
                 
                 cbCharacteristicDiscoveryHandler(YES,nil);
             } else if([aChar.UUID isEqual:HRM_BODY_LOCATION_CHARACTERISTIC_UUID]) {
                 [[[CyCBManager sharedManager] myPeripheral] readValueForCharacteristic:aChar];
-                [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:HRM_HEART_RATE_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:HRM_BODY_LOCATION_CHARACTERISTIC_UUID] descriptor:nil operation:READ_REQUEST];
+                [Utilities logTraceWithService:HRM_HEART_RATE_SERVICE_UUID characteristic:HRM_BODY_LOCATION_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_READ_REQUEST data:nil error:nil];
             }
         }
     }
@@ -154,63 +155,49 @@
     // https://developer.bluetooth.org/gatt/characteristics/Pages/CharacteristicViewer.aspx?u=org.bluetooth.characteristic.heart_rate_measurement.xml //
     
     NSData *data = [characteristic value];
-    const uint8_t *bytes = [data bytes];
+    gatt_heart_rate_measurement measurement;
     
-    NSUInteger offset = 1;// One byte for Flags field
-    
-    // Bits Per Minute (BPM)
-    if ((bytes[0] & 0x01) == 0) { // BPM as uint8
-        self.bpmValue = bytes[1];
-        offset = offset + 1;
-    }
-    else { // BPM as uint16
-        self.bpmValue = CFSwapInt16LittleToHost(*(uint16_t *)(&bytes[1]));
-        offset =  offset + 2;
-    }
-    
-    // Sensor Contact Status
-    if ((bytes[0] & 0x06) == 0x06) { // feature supported and contact detected
-        self.sensorContact = SENSOR_CONTACT_DETECTED;
-    } else if ((bytes[0] & 0x06) == 0x04) { // feature supported but contact not detected
-        self.sensorContact = SENSOR_CONTACT_NOT_DETECTED;
-    } else { // feature not supported
-        self.sensorContact = SENSOR_CONTACT_NOT_SUPPORTED;
-    }
-    
-    // Energy Expended (EE)
-    if (bytes[0] & 0x08) // EE present
-    {
-        uint16_t ee = CFSwapInt16LittleToHost(*(uint16_t *)(&bytes[offset]));
-        self.energyExpended = [NSString stringWithFormat:@"%d", ee];
-        offset =  offset + 2;
-    }
-    else // EE not present
+    // A value shorter than its flags say is logged but not shown
+    if (gatt_decode_heart_rate_measurement([data bytes], (uint32_t)[data length], &measurement) != 0)
     {
-        self.energyExpended = @"0";
-    }
-    
-    // RR interval
-    if (bytes[0] & 0x10)
-    {
-        // The number of RR-interval values is total bytes left / 2 (size of uint16)
-        NSUInteger length = [data length];
-        NSUInteger count = (length - offset) / 2;
-        uint16_t RRinterval = 0 ;
-        for (int i = 0; i < count && i < MAX_NUM_RR_INTERVALS; i++) { // Display up to 3 RR-intervals
-            // The unit for RR interval is 1/1024 seconds
-            RRinterval = CFSwapInt16LittleToHost(*(uint16_t *)(&bytes[offset]));
-            RRinterval = ((double)RRinterval / 1024.0 ) * 1000.0;
-            offset = offset + 2; // Plus 2 bytes //
-            if (i == 0) {
-                self.RRinterval = [NSString stringWithFormat:@"%d",RRinterval];
-            } else {
-                self.RRinterval = [self.RRinterval stringByAppendingString:[NSString stringWithFormat:@"\n%d",RRinterval]];
+        uint32_t flags = measurement.header.flags;
+        
+        // Bits Per Minute (BPM), as uint8 or uint16
+        self.bpmValue = measurement.heart_rate;
+        
+        // Sensor Contact Status
+        if ((flags & GATT_HEART_RATE_CONTACT_MASK) == GATT_HEART_RATE_CONTACT_DETECTED) { // feature supported and contact detected
+            self.sensorContact = SENSOR_CONTACT_DETECTED;
+        } else if ((flags & GATT_HEART_RATE_CONTACT_MASK) == GATT_HEART_RATE_CONTACT_NOT_DETECTED) { // feature supported but contact not detected
+            self.sensorContact = SENSOR_CONTACT_NOT_DETECTED;
+        } else { // feature not supported
+            self.sensorContact = SENSOR_CONTACT_NOT_SUPPORTED;
+        }
+        
+        // Energy Expended (EE)
+        if (flags & GATT_HEART_RATE_ENERGY_EXPENDED) // EE present
+        {
+            self.energyExpended = [NSString stringWithFormat:@"%d", measurement.energy_expended];
+        }
+        else // EE not present
+        {
+            self.energyExpended = @"0";
+        }
+        
+        // RR interval
+        if (measurement.rr_interval_count > 0)
+        {
+            NSMutableString *intervals = [NSMutableString string];
+            for (uint32_t i = 0; i < measurement.rr_interval_count && i < MAX_NUM_RR_INTERVALS; i++) { // Display up to 3 RR-intervals
+                // The unit for RR interval is 1/1024 seconds
+                uint16_t RRinterval = ((double)measurement.rr_intervals[i] / 1024.0 ) * 1000.0;
+                [intervals appendFormat:i == 0 ? @"%d" : @"\n%d", RRinterval];
             }
-            NSLog(@"%@", self.RRinterval);
+            self.RRinterval = intervals;
         }
     }
     
-    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:HRM_HEART_RATE_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:HRM_CHARACTERISTIC_UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",NOTIFY_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:data]]];
+    [Utilities logTraceWithService:HRM_HEART_RATE_SERVICE_UUID characteristic:HRM_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_NOTIFY_RESPONSE data:data error:nil];
 }
 
 /*!
@@ -221,11 +208,9 @@
  */
 -(BOOL)getSensorContactStatusFromCharacteristic:(CBCharacteristic *)characteristic {
     NSData *data = [characteristic value];
-    const uint8_t *reportData = [data bytes];
-    if((reportData[0] & 0x02) == 4) {
-        return YES;
-    }
-    return NO;
+    gatt_cursor cursor = gatt_cursor_make([data bytes], (uint32_t)[data length]);
+    uint8_t flags = gatt_read_u8(&cursor);
+    return (flags & GATT_HEART_RATE_CONTACT_MASK) == GATT_HEART_RATE_CONTACT_DETECTED;
 }
 
 /*!
@@ -264,7 +249,7 @@
         self.sensorLocation = LOCATION_NA;
     }
     
-    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",READ_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:sensorData]]];
+    [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_READ_RESPONSE data:sensorData error:nil];
 }
 
 @end
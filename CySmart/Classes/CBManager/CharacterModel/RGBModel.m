@@ -221,18 +221,18 @@
  */
 -(void) logColorData:(NSData *)data
 {
-    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:RGB_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:RGB_CHARACTERISTIC_UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",WRITE_REQUEST,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:data]]];
+    [Utilities logTraceWithService:RGB_SERVICE_UUID characteristic:RGB_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_WRITE_REQUEST data:data error:nil];
 }
 
 -(void) logWriteStatusWithError:(NSError *)error
 {
     if (error == nil)
     {
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:RGB_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:RGB_CHARACTERISTIC_UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@- %@",WRITE_REQUEST_STATUS,WRITE_SUCCESS]];
+        [Utilities logTraceWithService:RGB_SERVICE_UUID characteristic:RGB_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_WRITE_RESPONSE data:nil error:nil];
     }
     else
     {
-       [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:RGB_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:RGB_CHARACTERISTIC_UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@- %@%@",WRITE_REQUEST_STATUS,WRITE_ERROR,[error.userInfo objectForKey:NSLocalizedDescriptionKey]]];
+       [Utilities logTraceWithService:RGB_SERVICE_UUID characteristic:RGB_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_WRITE_RESPONSE data:nil error:error];
     }
 }
 
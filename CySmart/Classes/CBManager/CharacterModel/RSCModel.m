@@ -31,6 +31,7 @@
  */
 #import "RSCModel.h"
 #import "CyCBManager.h"
+#import "GATTMeasurements.h"
 
 /*!
  *  @class RSCModel
@@ -91,7 +92,7 @@
     cbCharacteristicHandler = handler;
     if(RSCCharacter)
     {
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:RSC_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:RSC_CHARACTERISTIC_UUID] descriptor:nil operation:START_NOTIFY];
+        [Utilities logTraceWithService:RSC_SERVICE_UUID characteristic:RSC_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_START_NOTIFY data:nil error:nil];
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:YES forCharacteristic:RSCCharacter];
     }
 }
@@ -109,7 +110,7 @@
     {
         if (RSCCharacter.isNotifying)
         {
-            [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:RSC_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:RSC_CHARACTERISTIC_UUID] descriptor:nil operation:STOP_NOTIFY];
+            [Utilities logTraceWithService:RSC_SERVICE_UUID characteristic:RSC_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_STOP_NOTIFY data:nil error:nil];
             [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:NO forCharacteristic:RSCCharacter];
         }
     }
@@ -173,56 +174,33 @@
 - (void)getRSCData:(CBCharacteristic *)characteristic
 {
     NSData *data = [characteristic value];      // 1
-    const uint8_t *reportData = [data bytes];
-     NSInteger shiftVal = 1;
-
-    //    Instantaneous Speed ------ Unit is in m/s with a resolution of 1/256 s
-    uint16_t _instantaneousSpeed = CFSwapInt16LittleToHost(*(uint16_t *)(&reportData[shiftVal]));
-    //Unit is in m/s with a resolution of 1/256 s
-    //Convert to km/hr  ( m/s *3.6)
-    self.InstantaneousSpeed = 3.6*(_instantaneousSpeed/256.0);
+    gatt_rsc_measurement measurement;
     
-    shiftVal+=2;
-    
-    //    Instantaneous Cadence ---- Unit is in 1/minute (or RPM) with a resolutions of 1 1/min (or 1 RPM)
-    
-    uint8_t _instantaneousCadence = reportData[shiftVal++];
-    self.InstantaneousCadence = (float)_instantaneousCadence;
-    
-    uint16_t _instantaneousStrideLength = 0;
-    uint32_t _totalDistancePresent = 0;
-    
-    self.InstantaneousStrideLength = 0.0f;
-
-    if ((reportData[0] & 0x01) == 1)
+    if (gatt_decode_rsc_measurement([data bytes], (uint32_t)[data length], &measurement) != 0)
     {
-        //Instantaneous Stride Length Present
-        // Instantaneous Stride Length ---- Unit is in meter with a resolution of 1/100 m (or centimeter).
-         _instantaneousStrideLength = CFSwapInt16LittleToHost(*(uint16_t *)(&reportData[shiftVal]));
-        self.InstantaneousStrideLength = ((float)_instantaneousStrideLength)/100.0f;
+        //    Instantaneous Speed ------ Unit is in m/s with a resolution of 1/256 s
+        //Convert to km/hr  ( m/s *3.6)
+        self.InstantaneousSpeed = 3.6*(measurement.speed/256.0);
         
-        shiftVal += 2 ;
-    }
-
-    if (reportData[0] & 0x02)
-    {
-        //Total Distance Present
-        // Unit is in meter with a resolution of 1/10 m (or decimeter)
-        _totalDistancePresent =(uint32_t)CFSwapInt32LittleToHost(*(uint32_t*)&reportData[shiftVal]);
+        //    Instantaneous Cadence ---- Unit is in 1/minute (or RPM) with a resolutions of 1 1/min (or 1 RPM)
+        self.InstantaneousCadence = (float)measurement.cadence;
         
-        if (_totalDistancePresent)
+        // Instantaneous Stride Length ---- Unit is in meter with a resolution of 1/100 m (or centimeter), 0 if absent
+        self.InstantaneousStrideLength = ((float)measurement.stride_length)/100.0f;
+        
+        // Total Distance ---- Unit is in meter with a resolution of 1/10 m (or decimeter)
+        if (measurement.total_distance)
         {
-            self.TotalDistance = _totalDistancePresent/10.0;
-
+            self.TotalDistance = measurement.total_distance/10.0;
+        }
+        
+        if ((measurement.header.flags & GATT_RSC_RUNNING) == 0)
+        {
+            self.IsWalking = YES ;
         }
     }
     
-    if ((reportData[0] & 0x04) == 0)
-    {
-        self.IsWalking = YES ;
-    }
-    
-    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:RSC_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:RSC_CHARACTERISTIC_UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",NOTIFY_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:data]]];
+    [Utilities logTraceWithService:RSC_SERVICE_UUID characteristic:RSC_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_NOTIFY_RESPONSE data:data error:nil];
     
 }
 
@@ -39,6 +39,7 @@
 #import "TemperatureModel.h"
 #import "FindMeModel.h"
 #import "BatteryServiceModel.h"
+#import "SensorFrameQueue.h"
 
 
 
@@ -87,6 +88,15 @@
  */
 @property (nonatomic, strong) BatteryServiceModel *batteryModel;
 
+/*!
+ *  @property frameQueue
+ *
+ *  @discussion Queue of the sensor frames assembled from the accelerometer, barometer and temperature readings.
+ *  Consumers such as loggers and exporters attach their own sensor_frame_reader to it, on any thread.
+ *
+ */
+@property (nonatomic, readonly) sensor_frame_queue *frameQueue;
+
 /*!
  *  @method startDiscoverBarometerCharacteristicsWithHandler:
  *
@@ -120,12 +130,21 @@
 -(void) startDiscoverBatteryCharacteristicsWithHandler:(void (^) (BOOL success, NSError *error))handler;
 
 /*!
- *  @method startUpdateAccelerometerXYZValueswithHandler:
+ *  @method setFrameHandler:
+ *
+ *  @discussion Method to set the handler that receives the sensor frames. Frames are passed in batches on the main
+ *  queue, as many as arrived since the previous batch.
+ *
+ */
+-(void) setFrameHandler:(void (^) (const sensor_frame *frames, NSUInteger count))handler;
+
+/*!
+ *  @method startUpdateAccelerometerXYZValues
  *
  *  @discussion Method to start updating the accelerometer X,Y and Z coordinate values
  *
  */
--(void) startUpdateAccelerometerXYZValueswithHandler:(void (^) (BOOL success, NSError *error))handler;
+-(void) startUpdateAccelerometerXYZValues;
 
 /*!
  *  @method readValuesForAccelerometerCharacteristicsWithHandler:
@@ -137,12 +156,12 @@
 -(void) readValuesForAccelerometerCharacteristicsWithHandler:(void (^) (BOOL success, NSError *error))handler;
 
 /*!
- *  @method startUpdateBarometerPressureValueWithHandler
+ *  @method startUpdateBarometerPressureValue
  *
  *  @discussion Method to start updating barometer pressure value reading
  *
  */
--(void) startUpdateBarometerPressureValueWithHandler:(void (^) (BOOL success, NSError *error))handler;
+-(void) startUpdateBarometerPressureValue;
 
 /*!
  *  @method readValuesForBarometerCharacteristicsWithHandler:
@@ -153,12 +172,12 @@
 -(void) readValuesForBarometerCharacteristicsWithHandler:(void (^) (BOOL success, NSError *error))handler;
 
 /*!
- *  @method startUpdateTemperatureValueCharacteristicWithHandler:
+ *  @method startUpdateTemperatureValue
  *
  *  @discussion Method to start updating temperature reading
  *
  */
--(void) startUpdateTemperatureValueCharacteristicWithHandler:(void (^) (BOOL success, NSError *error))handler;
+-(void) startUpdateTemperatureValue;
 
 /*!
  *  @method readValuesForTemperatureCharacteristicsWithHandler:
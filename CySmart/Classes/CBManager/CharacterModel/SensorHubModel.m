@@ -33,6 +33,11 @@
 
 #import "SensorHubModel.h"
 #import "Constants.h"
+#import "GATTDecoder.h"
+
+#define SENSOR_FRAME_QUEUE_CAPACITY     1024
+#define SENSOR_FRAME_BATCH_SIZE         64
+#define SENSOR_FRAME_WINDOW             0.1
 
 /*!
  *  @class SensorHubModel
@@ -49,14 +54,17 @@
     void(^barometerCharactristicDiscoverHandler)(BOOL success, NSError *error);
     void(^temperatureCharactristicDiscoverHandler)(BOOL success, NSError *error);
     
-    void (^accelerometerXYZcharacteristicHandler)(BOOL success, NSError *error);
     void (^accelerometerCharacteristicsHandler)(BOOL success, NSError *error);
-    
-    void (^barometerPressureValueUpdationHandler)(BOOL success, NSError *error);
     void (^barometerCharacteristicsHandler)(BOOL success, NSError *error);
-    
-    void (^temperatureValueUpdationHandler)(BOOL success, NSError *error);
     void (^temperatureCharacteristicsHandler)(BOOL success, NSError *error);
+    
+    void (^frameHandler)(const sensor_frame *frames, NSUInteger count);
+    NSArray *sensorSubscriptions;
+    sensor_frame_queue frameQueue;
+    sensor_frame_assembler frameAssembler;
+    sensor_frame_reader handlerReader;
+    sensor_frame frameBatch[SENSOR_FRAME_BATCH_SIZE];
+    BOOL isFrameDeliveryScheduled;
 
     void (^immedieteAlertCharacteristicsDiscoverHandler)(BOOL success, NSError *error);
     void (^batteryServiceCharacteristicsDiscoverHandler)(BOOL success, NSError *error);
@@ -81,10 +89,36 @@
         _barometer = [[BarometerModel alloc] init];
         _temperatureSensor = [[TemperatureModel alloc] init];
         _findMeModel = [[FindMeModel alloc] init];
+        
+        // The frame is complete once the three axes of a scan are in; pressure and temperature join the frame they arrive in
+        if (!sensor_frame_queue_init(&frameQueue, SENSOR_FRAME_QUEUE_CAPACITY)) {
+            return nil;
+        }
+        sensor_frame_assembler_init(&frameAssembler, SENSOR_ACCELEROMETER_CHANNELS, SENSOR_FRAME_WINDOW);
+        sensor_frame_reader_init(&handlerReader, &frameQueue);
+        
+        sensorSubscriptions = @[[self subscribeToChannel:SENSOR_CHANNEL_X characteristic:ACCELEROMETER_READING_X_CHARACTERISTIC_UUID service:ACCELEROMETER_SERVICE_UUID],
+                                [self subscribeToChannel:SENSOR_CHANNEL_Y characteristic:ACCELEROMETER_READING_Y_CHARACTERISTIC_UUID service:ACCELEROMETER_SERVICE_UUID],
+                                [self subscribeToChannel:SENSOR_CHANNEL_Z characteristic:ACCELEROMETER_READING_Z_CHARACTERISTIC_UUID service:ACCELEROMETER_SERVICE_UUID],
+                                [self subscribeToChannel:SENSOR_CHANNEL_PRESSURE characteristic:BAROMETER_READING_CHARACTERISTIC_UUID service:BAROMETER_SERVICE_UUID],
+                                [self subscribeToChannel:SENSOR_CHANNEL_TEMPERATURE characteristic:TEMPERATURE_READING_CHARACTERISTIC_UUID service:ANALOG_TEMPERATURE_SERVICE_UUID]];
     }
     return self;
 }
 
+-(void)dealloc
+{
+    for (id subscription in sensorSubscriptions) {
+        [[[CyCBManager sharedManager] characteristicRouter] unsubscribe:subscription];
+    }
+    sensor_frame_queue_free(&frameQueue);
+}
+
+-(sensor_frame_queue *)frameQueue
+{
+    return &frameQueue;
+}
+
 #pragma mark - Discover service characteristics
 
 /*!
@@ -195,14 +229,24 @@
 #pragma mark - Handling service characteristics
 
 /*!
- *  @method startUpdateAccelerometerXYZValueswithHandler:
+ *  @method setFrameHandler:
+ *
+ *  @discussion Method to set the handler that receives the sensor frames
+ *
+ */
+-(void) setFrameHandler:(void (^) (const sensor_frame *frames, NSUInteger count))handler
+{
+    frameHandler = handler;
+}
+
+/*!
+ *  @method startUpdateAccelerometerXYZValues
  *
  *  @discussion Method to start updating the accelerometer X,Y and Z coordinate values
  *
  */
--(void) startUpdateAccelerometerXYZValueswithHandler:(void (^) (BOOL success, NSError *error))handler
+-(void) startUpdateAccelerometerXYZValues
 {
-    accelerometerXYZcharacteristicHandler = handler;
     [_accelerometer updateXYZCharacteristics];
 }
 
@@ -220,15 +264,14 @@
 }
 
 /*!
- *  @method startUpdateBarometerPressureValueWithHandler
+ *  @method startUpdateBarometerPressureValue
  *
  *  @discussion Method to start updating barometer pressure value reading
  *
  */
 
--(void) startUpdateBarometerPressureValueWithHandler:(void (^) (BOOL success, NSError *error))handler
+-(void) startUpdateBarometerPressureValue
 {
-    barometerPressureValueUpdationHandler = handler;
     [_barometer updateValueForPressure];
 }
 
@@ -248,15 +291,14 @@
 
 
 /*!
- *  @method startUpdateTemperatureValueCharacteristicWithHandler:
+ *  @method startUpdateTemperatureValue
  *
  *  @discussion Method to start updating temperature reading
  *
  */
 
--(void) startUpdateTemperatureValueCharacteristicWithHandler:(void (^) (BOOL success, NSError *error))handler
+-(void) startUpdateTemperatureValue
 {
-    temperatureValueUpdationHandler = handler;
     [_temperatureSensor updateValueForTemperature];
 }
 
@@ -283,17 +325,101 @@
 
 -(void) stopUpdate
 {
-    accelerometerXYZcharacteristicHandler = nil;
+    frameHandler = nil;
     [_accelerometer stopUpdate];
-    
-    barometerPressureValueUpdationHandler = nil;
     [_barometer stopUpdate];
-    
-    temperatureValueUpdationHandler = nil;
     [_temperatureSensor stopUpdate];
     
 }
 
+#pragma mark - Sensor frames
+
+/*!
+ *  @method subscribeToChannel:characteristic:service:
+ *
+ *  @discussion Method to route the readings of a sensor characteristic to the frame being assembled
+ *
+ */
+
+-(id) subscribeToChannel:(sensor_channel)channel characteristic:(CBUUID *)characteristicUUID service:(CBUUID *)serviceUUID
+{
+    __weak SensorHubModel *weakSelf = self;
+    return [[[CyCBManager sharedManager] characteristicRouter] subscribeToCharacteristic:characteristicUUID ofService:serviceUUID handler:^(CBCharacteristic *characteristic, NSError *error) {
+        if (error == nil) {
+            [weakSelf addSampleWithCharacteristic:characteristic channel:channel];
+        }
+    }];
+}
+
+/*!
+ *  @method addSampleWithCharacteristic:channel:
+ *
+ *  @discussion Method to add the reading of a sensor channel to the frame being assembled
+ *
+ */
+
+-(void) addSampleWithCharacteristic:(CBCharacteristic *)characteristic channel:(sensor_channel)channel
+{
+    NSData *data = characteristic.value;
+    gatt_cursor cursor = gatt_cursor_make([data bytes], (uint32_t)[data length]);
+    float value = (channel == SENSOR_CHANNEL_TEMPERATURE) ? gatt_read_u32(&cursor) : gatt_read_u16(&cursor);
+    
+    [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_NOTIFY_RESPONSE data:data error:nil];
+    
+    if (cursor.failed) {
+        return;
+    }
+    
+    if (sensor_frame_assembler_add(&frameAssembler, &frameQueue, channel, value, CFAbsoluteTimeGetCurrent()) > 0 || !(frameAssembler.frame.fresh & SENSOR_ACCELEROMETER_CHANNELS)) {
+        [self scheduleFrameDelivery];
+    }
+}
+
+/*!
+ *  @method scheduleFrameDelivery
+ *
+ *  @discussion Method to pass the frames to the handler once the notifications already queued on the main queue are
+ *  handled, so a burst of notifications reaches the handler as one batch
+ *
+ */
+
+-(void) scheduleFrameDelivery
+{
+    if (isFrameDeliveryScheduled) {
+        return;
+    }
+    isFrameDeliveryScheduled = YES;
+    
+    __weak SensorHubModel *weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [weakSelf deliverFrames];
+    });
+}
+
+/*!
+ *  @method deliverFrames
+ *
+ *  @discussion Method to pass the frames published since the last batch to the handler
+ *
+ */
+
+-(void) deliverFrames
+{
+    isFrameDeliveryScheduled = NO;
+    
+    // Pressure and temperature scans do not wait for the accelerometer axes
+    if (!(frameAssembler.frame.fresh & SENSOR_ACCELEROMETER_CHANNELS)) {
+        sensor_frame_assembler_flush(&frameAssembler, &frameQueue);
+    }
+    
+    uint32_t count;
+    while ((count = sensor_frame_reader_read(&handlerReader, frameBatch, SENSOR_FRAME_BATCH_SIZE)) > 0) {
+        if (frameHandler != nil) {
+            frameHandler(frameBatch, count);
+        }
+    }
+}
+
 
 
 #pragma mark - CBCharacteristicManagerDelegate
@@ -359,53 +485,29 @@
 
 -(void)peripheral:(CBPeripheral *)peripheral didUpdateValueForCharacteristic:(CBCharacteristic *)characteristic error:(NSError *)error
 {
+    // Sensor readings are routed to addSampleWithCharacteristic:channel: by the characteristic router
     if ([characteristic.service.UUID isEqual:ACCELEROMETER_SERVICE_UUID])
     {
-        if ([characteristic.UUID isEqual:ACCELEROMETER_READING_X_CHARACTERISTIC_UUID] || [characteristic.UUID isEqual:ACCELEROMETER_READING_Y_CHARACTERISTIC_UUID] || [characteristic.UUID isEqual:ACCELEROMETER_READING_Z_CHARACTERISTIC_UUID])
-        {
-            [_accelerometer getXYZValuesWithCharacteristic:characteristic];
-            accelerometerXYZcharacteristicHandler(YES,nil);
-        }
-        else
-        {
-            [_accelerometer getValuesForAcclerometerCharacteristics:characteristic];
-            
-            if (accelerometerCharacteristicsHandler != nil) {
-                accelerometerCharacteristicsHandler(YES,nil);
-            }
+        [_accelerometer getValuesForAcclerometerCharacteristics:characteristic];
+        
+        if (accelerometerCharacteristicsHandler != nil) {
+            accelerometerCharacteristicsHandler(YES,nil);
         }
     }
     else if ([characteristic.service.UUID isEqual:BAROMETER_SERVICE_UUID])
     {
+        [_barometer getValuesForBarometerCharacteristics:characteristic];
         
-        if ([characteristic.UUID isEqual:BAROMETER_READING_CHARACTERISTIC_UUID])
-        {
-            [_barometer getValuesForBarometerCharacteristics:characteristic];
-            barometerPressureValueUpdationHandler(YES,nil);
-        }
-        else
-        {
-            [_barometer getValuesForBarometerCharacteristics:characteristic];
-            
-            if (barometerCharacteristicsHandler != nil) {
-                barometerCharacteristicsHandler(YES,nil);
-            }
+        if (barometerCharacteristicsHandler != nil) {
+            barometerCharacteristicsHandler(YES,nil);
         }
     }
     else if ([characteristic.service.UUID isEqual:ANALOG_TEMPERATURE_SERVICE_UUID])
     {
-        if ([characteristic.UUID isEqual:TEMPERATURE_READING_CHARACTERISTIC_UUID])
-        {
-            [_temperatureSensor getValuesForTemperatureCharacteristics:characteristic];
-            temperatureValueUpdationHandler(YES,nil);
-        }
-        else
-        {
-            [_temperatureSensor getValuesForTemperatureCharacteristics:characteristic];
-            
-            if (temperatureCharacteristicsHandler != nil) {
-                temperatureCharacteristicsHandler(YES,nil);
-            }
+        [_temperatureSensor getValuesForTemperatureCharacteristics:characteristic];
+        
+        if (temperatureCharacteristicsHandler != nil) {
+            temperatureCharacteristicsHandler(YES,nil);
         }
     }
     else if([characteristic.service.UUID isEqual:BATTERY_LEVEL_SERVICE_UUID])
@@ -56,15 +56,6 @@
 
 @property (strong,nonatomic) NSString *sensorScanIntervalString;
 
-/*!
- *  @property temperatureValueString
- *
- *  @discussion The temperature value
- *
- */
-
-@property (strong,nonatomic) NSString *temperatureValueString;
-
 /*!
  *  @method stopUpdate
  *
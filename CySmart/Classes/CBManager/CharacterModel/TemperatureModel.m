@@ -62,7 +62,7 @@
 {
     if (temperatureReadCharacteristic != nil)
     {
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:ANALOG_TEMPERATURE_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:temperatureReadCharacteristic.UUID] descriptor:nil operation:STOP_NOTIFY];
+        [Utilities logTraceWithService:ANALOG_TEMPERATURE_SERVICE_UUID characteristic:temperatureReadCharacteristic.UUID descriptor:nil operation:GATT_TRACE_STOP_NOTIFY data:nil error:nil];
         
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:NO forCharacteristic:temperatureReadCharacteristic];
     }
@@ -81,7 +81,7 @@
     NSData  *valData = [NSData dataWithBytes:(void*)&val length:sizeof(val)];
     [[[CyCBManager sharedManager] myPeripheral] writeValue:valData forCharacteristic:sensorScanintervalCharacteristic type:CBCharacteristicWriteWithoutResponse];
     
-    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:sensorScanintervalCharacteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:sensorScanintervalCharacteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",WRITE_REQUEST,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:valData]]];
+    [Utilities logTraceWithService:sensorScanintervalCharacteristic.service.UUID characteristic:sensorScanintervalCharacteristic.UUID descriptor:nil operation:GATT_TRACE_WRITE_REQUEST data:valData error:nil];
 }
 
 /*!
@@ -127,22 +127,14 @@
     {
         _sensorTypeString = [NSString stringWithFormat:@"%d",reportData[0]];
         
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",READ_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:dataValue]]];
+        [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_READ_RESPONSE data:dataValue error:nil];
 
     }
     else if ([characteristic.UUID isEqual:TEMPERATURE_SENSOR_SCAN_INTERVAL_CHARACTERISTIC_UUID])
     {
         _sensorScanIntervalString = [NSString stringWithFormat:@"%d",reportData[0]];
         
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",READ_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:dataValue]]];
-
-    }
-    else if ([characteristic.UUID isEqual:TEMPERATURE_READING_CHARACTERISTIC_UUID])
-    {
-        double tempValue = CFSwapInt32LittleToHost(*(uint32_t *) &reportData[0]);
-        _temperatureValueString = [NSString stringWithFormat:@"%f",tempValue];
-        
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",NOTIFY_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:dataValue]]];
+        [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_READ_RESPONSE data:dataValue error:nil];
 
     }
 }
@@ -157,7 +149,7 @@
 {
     if (temperatureReadCharacteristic != nil)
     {
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:temperatureReadCharacteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:temperatureReadCharacteristic.UUID] descriptor:nil operation:START_NOTIFY];
+        [Utilities logTraceWithService:temperatureReadCharacteristic.service.UUID characteristic:temperatureReadCharacteristic.UUID descriptor:nil operation:GATT_TRACE_START_NOTIFY data:nil error:nil];
         
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:YES forCharacteristic:temperatureReadCharacteristic];
     }
@@ -175,14 +167,14 @@
     {
         [[[CyCBManager sharedManager] myPeripheral] readValueForCharacteristic:sensorScanintervalCharacteristic];
         
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:sensorScanintervalCharacteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:sensorScanintervalCharacteristic.UUID] descriptor:nil operation:READ_REQUEST];
+        [Utilities logTraceWithService:sensorScanintervalCharacteristic.service.UUID characteristic:sensorScanintervalCharacteristic.UUID descriptor:nil operation:GATT_TRACE_READ_REQUEST data:nil error:nil];
     }
     
     if (sensorTypeCharacteristic != nil)
     {
         [[[CyCBManager sharedManager] myPeripheral] readValueForCharacteristic:sensorTypeCharacteristic];
         
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:sensorTypeCharacteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:sensorTypeCharacteristic.UUID] descriptor:nil operation:READ_REQUEST];
+        [Utilities logTraceWithService:sensorTypeCharacteristic.service.UUID characteristic:sensorTypeCharacteristic.UUID descriptor:nil operation:GATT_TRACE_READ_REQUEST data:nil error:nil];
     }
     
 }
@@ -32,6 +32,7 @@
 
 #import "ThermometerModel.h"
 #import "CyCBManager.h"
+#import "GATTMeasurements.h"
 
 
 // Temperature units
@@ -113,7 +114,7 @@
                 if (aChar.isNotifying)
                 {
                     [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:NO  forCharacteristic:aChar];
-                    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:THM_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:THM_TEMPERATURE_MEASUREMENT_CHARACTERISTIC_UUID] descriptor:nil operation:STOP_INDICATE];
+                    [Utilities logTraceWithService:THM_SERVICE_UUID characteristic:THM_TEMPERATURE_MEASUREMENT_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_STOP_INDICATE data:nil error:nil];
                 }
                 cbCharacteristicDiscoverHandler(YES,nil);
             }
@@ -139,7 +140,7 @@
             {
                 [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:YES forCharacteristic:aChar];
                 
-                [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:THM_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:THM_TEMPERATURE_MEASUREMENT_CHARACTERISTIC_UUID] descriptor:nil operation:START_INDICATE];
+                [Utilities logTraceWithService:THM_SERVICE_UUID characteristic:THM_TEMPERATURE_MEASUREMENT_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_START_INDICATE data:nil error:nil];
                 
                 cbCharacteristicDiscoverHandler(YES,nil);
             }
@@ -147,7 +148,7 @@
             {
                 [[[CyCBManager sharedManager] myPeripheral] readValueForCharacteristic:aChar];
                 
-                [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:THM_SERVICE_UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:THM_TEMPERATURE_TYPE_CHARACTERISTIC_UUID] descriptor:nil operation:READ_REQUEST];
+                [Utilities logTraceWithService:THM_SERVICE_UUID characteristic:THM_TEMPERATURE_TYPE_CHARACTERISTIC_UUID descriptor:nil operation:GATT_TRACE_READ_REQUEST data:nil error:nil];
             }
         }
     }
@@ -198,97 +199,44 @@
   
     // Convert the contents of the characteristic value to a data-object //
     NSData *data = [characteristic value];
+    gatt_temperature_measurement measurement;
     
-    // Get the byte sequence of the data-object //
-    const uint8_t *reportData = [data bytes];
-    
-    // Initialise the offset variable //
-    NSUInteger offset = 1;
-    // Initialise the bpm variable //
-   
-    if ((reportData[0] & 0x01) == 0) {
-        
-        [self calculateTemperaturefromCharacteristic:characteristic];
-
-        offset = offset + 4; // Plus 4 byte //
-        self.mesurementType = TEMPERATURE_UNIT_IN_CELCIUS;
-    }
-    else {
-        
-        [self calculateTemperaturefromCharacteristic:characteristic];
-
-        offset =  offset + 4; // Plus 4 bytes //
-        self.mesurementType = TEMPERATURE_UNIT_IN_FAHRENHEIT;
-    }
-    
-    
-    /* timestamp */
-    if( (reportData[0] & 0x02) )
+    if (gatt_decode_temperature_measurement([data bytes], (uint32_t)[data length], &measurement) != 0)
     {
-        uint16_t year = CFSwapInt16LittleToHost(*(uint16_t *) &reportData[offset]); offset += 2;
-        uint8_t month = *(uint8_t *) &reportData[offset]; offset++;
-        uint8_t day = *(uint8_t*) &reportData[offset]; offset++;
-        uint8_t hour = *(uint8_t*) &reportData[offset]; offset++;
-        uint8_t min = *(uint8_t*) &reportData[offset]; offset++;
-        uint8_t sec = *(uint8_t*) &reportData[offset]; offset++;
-        
-        NSString * dateString = [NSString stringWithFormat:@"%d %d %d %d %d %d", year, month, day, hour, min, sec];
-        
-        NSDateFormatter *dateFormat = [[NSDateFormatter alloc] init];
-        [dateFormat setDateFormat: @"yyyy MM dd HH mm ss"];
-        NSDate* date = [dateFormat dateFromString:dateString];
-        
-        [dateFormat setDateFormat:@"EEE MMM dd, yyyy"];
-        NSString* dateFormattedString = [dateFormat stringFromDate:date];
-        
-        [dateFormat setDateFormat:@"h:mm a"];
-        NSString* timeFormattedString = [dateFormat stringFromDate:date];
+        self.tempStringValue = [NSString stringWithFormat:@"%.2f",(float) measurement.temperature];
         
+        if ((measurement.header.flags & GATT_TEMPERATURE_FAHRENHEIT) == 0) {
+            self.mesurementType = TEMPERATURE_UNIT_IN_CELCIUS;
+        }
+        else {
+            self.mesurementType = TEMPERATURE_UNIT_IN_FAHRENHEIT;
+        }
         
-        if( dateFormattedString && timeFormattedString )
+        /* timestamp */
+        if (measurement.header.flags & GATT_TEMPERATURE_TIME_STAMP)
         {
-            self.timeStampString = [NSString stringWithFormat:@"%@ at %@", dateFormattedString, timeFormattedString];
+            gatt_date_time timeStamp = measurement.time_stamp;
+            NSString * dateString = [NSString stringWithFormat:@"%d %d %d %d %d %d", timeStamp.year, timeStamp.month, timeStamp.day, timeStamp.hours, timeStamp.minutes, timeStamp.seconds];
+            
+            NSDateFormatter *dateFormat = [[NSDateFormatter alloc] init];
+            [dateFormat setDateFormat: @"yyyy MM dd HH mm ss"];
+            NSDate* date = [dateFormat dateFromString:dateString];
+            
+            [dateFormat setDateFormat:@"EEE MMM dd, yyyy"];
+            NSString* dateFormattedString = [dateFormat stringFromDate:date];
+            
+            [dateFormat setDateFormat:@"h:mm a"];
+            NSString* timeFormattedString = [dateFormat stringFromDate:date];
+            
+            
+            if( dateFormattedString && timeFormattedString )
+            {
+                self.timeStampString = [NSString stringWithFormat:@"%@ at %@", dateFormattedString, timeFormattedString];
+            }
         }
     }
     
-    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",NOTIFY_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:data]]];
-}
-
-/*!
- *  @method calculateTemperaturefromCharacteristic
- *
- *  @discussion Method to calculate the temperature
- *
- */
-
-
--(void) calculateTemperaturefromCharacteristic:(CBCharacteristic *)characteristic
-{
-    // Convert the contents of the characteristic value to a data-object //
-    NSData *data = [characteristic value];
-    
-    // Get the byte sequence of the data-object //
-    const uint8_t *reportDataPointer = [data bytes];
-    reportDataPointer++;
-    
-    
-    int32_t tempData = (int32_t)CFSwapInt32LittleToHost(*(uint32_t *)reportDataPointer);
-
-    int32_t exponent = (tempData & 0xFF000000) >> 24;
-    int32_t mantissa = (int32_t)(tempData & 0x00FFFFFF);
-    
- 
-    if (mantissa >= 0x800000) {
-        mantissa = -(0x01000000 - mantissa);
-    }
-    
-    if (exponent >= 0x80) {
-        exponent = -(0x0100 - exponent);
-    }
-    
-    
-    float tempValue = (float)(mantissa * pow(10, exponent));
-    self.tempStringValue = [NSString stringWithFormat:@"%.2f",(float) tempValue];
+    [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_NOTIFY_RESPONSE data:data error:nil];
 }
 
 /*!
@@ -301,11 +249,11 @@
 -(BOOL)isTempTypeValid:(CBCharacteristic *)characteristic
 {
     NSData * updatedValue = characteristic.value;
-    uint8_t* dataPointer = (uint8_t*)[updatedValue bytes];
+    gatt_cursor cursor = gatt_cursor_make([updatedValue bytes], (uint32_t)[updatedValue length]);
     
-    uint8_t flags = dataPointer[0];
+    uint8_t flags = gatt_read_u8(&cursor);
     
-     if( flags & 0x04 )
+     if( flags & GATT_TEMPERATURE_TYPE )
      {
          return true;
      }
@@ -324,8 +272,8 @@
     /* temperature type */
     
     NSData * updatedValue = characteristic.value;
-    uint8_t* dataPointer = (uint8_t*)[updatedValue bytes];
-    uint8_t type = *(uint8_t*)dataPointer;
+    gatt_cursor cursor = gatt_cursor_make([updatedValue bytes], (uint32_t)[updatedValue length]);
+    uint8_t type = gatt_read_u8(&cursor);
     NSString* location = nil;
     
     switch (type)
@@ -365,7 +313,7 @@
         self.tempType = [NSString stringWithFormat:@"%@", location];
     }
     
-    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",READ_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:updatedValue]]];
+    [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_READ_RESPONSE data:updatedValue error:nil];
 }
 
 
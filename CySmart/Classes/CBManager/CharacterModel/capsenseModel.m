@@ -45,6 +45,7 @@
 
     CBUUID *characteristicUUID;
     CBCharacteristic *capsenseCharacteristic;
+    id capsenseSubscription;
 }
 
 @end
@@ -61,6 +62,11 @@
     return self;
 }
 
+-(void)dealloc
+{
+    [[[CyCBManager sharedManager] characteristicRouter] unsubscribe:capsenseSubscription];
+}
+
 /*!
  *  @method startDiscoverCharacteristicWithUUID: completionHandler
  *
@@ -81,7 +87,16 @@
 -(void)updateCharacteristicWithHandler:(void (^) (BOOL success, NSError *error))handler
 {
     cbCharacteristicHandler = handler;
-    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:capsenseCharacteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:capsenseCharacteristic.UUID] descriptor:nil operation:START_NOTIFY];
+    
+    if (capsenseSubscription == nil)
+    {
+        CharacteristicValueHandler valueHandler = [self valueHandlerForCharacteristicUUID:capsenseCharacteristic.UUID];
+        if (valueHandler != nil)
+        {
+            capsenseSubscription = [[[CyCBManager sharedManager] characteristicRouter] subscribeToCharacteristic:capsenseCharacteristic.UUID ofService:capsenseCharacteristic.service.UUID handler:valueHandler];
+        }
+    }
+    [Utilities logTraceWithService:capsenseCharacteristic.service.UUID characteristic:capsenseCharacteristic.UUID descriptor:nil operation:GATT_TRACE_START_NOTIFY data:nil error:nil];
     [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:YES forCharacteristic:capsenseCharacteristic];
 }
 
@@ -93,11 +108,13 @@
 -(void)stopUpdate
 {
     cbCharacteristicHandler = nil;
+    [[[CyCBManager sharedManager] characteristicRouter] unsubscribe:capsenseSubscription];
+    capsenseSubscription = nil;
     if (capsenseCharacteristic != nil)
     {
         if (capsenseCharacteristic.isNotifying)
         {
-            [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:capsenseCharacteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:capsenseCharacteristic.UUID] descriptor:nil operation:STOP_NOTIFY];
+            [Utilities logTraceWithService:capsenseCharacteristic.service.UUID characteristic:capsenseCharacteristic.UUID descriptor:nil operation:GATT_TRACE_STOP_NOTIFY data:nil error:nil];
             [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:NO forCharacteristic:capsenseCharacteristic];
         }
     }
@@ -141,54 +158,81 @@
     }
 }
 
+#pragma mark - CapSense values
+
 /*!
- *  @method didUpdateValueForCharacteristic
+ *  @method valueHandlerForCharacteristicUUID:
  *
- *  @discussion Parse the CapSense value from the characteristic.
+ *  @discussion Returns the handler that parses the values of a CapSense characteristic, nil if the characteristic is
+ *  not a CapSense one. The parser is picked once here rather than for every notification.
  */
--(void)peripheral:(CBPeripheral *)peripheral didUpdateValueForCharacteristic:(CBCharacteristic *)characteristic error:(NSError *)error
+-(CharacteristicValueHandler)valueHandlerForCharacteristicUUID:(CBUUID *)UUID
 {
-    
-    NSData *data = characteristic.value;
-    uint8_t *dataPointer = (uint8_t *)[data bytes];
+    __weak capsenseModel *weakSelf = self;
     
     /**
      * Parse the CapSense proximity value from the characteristic
      */
-    if ([characteristic.UUID isEqual:CAPSENSE_PROXIMITY_CHARACTERISTIC_UUID] || [characteristic.UUID isEqual:CUSTOM_CAPSENSE_PROXIMITY_CHARACTERISTIC_UUID])
+    if ([UUID isEqual:CAPSENSE_PROXIMITY_CHARACTERISTIC_UUID] || [UUID isEqual:CUSTOM_CAPSENSE_PROXIMITY_CHARACTERISTIC_UUID])
     {
-        uint8_t value = dataPointer[0];
-        _proximityValue = value;
-        cbCharacteristicHandler(YES, nil);
+        return ^(CBCharacteristic *characteristic, NSError *error) {
+            NSData *data = characteristic.value;
+            BOOL success = (error == nil && [data length] >= 1);
+            if (success) {
+                weakSelf.proximityValue = ((const uint8_t *)[data bytes])[0];
+            }
+            [weakSelf handleValueOfCharacteristic:characteristic success:success error:error];
+        };
     }
     /**
      * Parse the CapSense slider value from the characteristic
      */
-    else if ([characteristic.UUID isEqual:CAPSENSE_SLIDER_CHARACTERISTIC_UUID] || [characteristic.UUID isEqual:CUSTOM_CAPSENSE_SLIDER_CHARACTERISTIC_UUID])
+    else if ([UUID isEqual:CAPSENSE_SLIDER_CHARACTERISTIC_UUID] || [UUID isEqual:CUSTOM_CAPSENSE_SLIDER_CHARACTERISTIC_UUID])
     {
-        uint8_t value = dataPointer[0];
-        _capsenseSliderValue = value;
-        cbCharacteristicHandler(YES, nil);
+        return ^(CBCharacteristic *characteristic, NSError *error) {
+            NSData *data = characteristic.value;
+            BOOL success = (error == nil && [data length] >= 1);
+            if (success) {
+                weakSelf.capsenseSliderValue = ((const uint8_t *)[data bytes])[0];
+            }
+            [weakSelf handleValueOfCharacteristic:characteristic success:success error:error];
+        };
     }
     /**
      * Parse the CapSense buttons value from the characteristic
      */
-    else if ([characteristic.UUID isEqual:CAPSENSE_BUTTON_CHARACTERISTIC_UUID] || [characteristic.UUID isEqual:CUSTOM_CAPSENSE_BUTTONS_CHARACTERISTIC_UUID])
+    else if ([UUID isEqual:CAPSENSE_BUTTON_CHARACTERISTIC_UUID] || [UUID isEqual:CUSTOM_CAPSENSE_BUTTONS_CHARACTERISTIC_UUID])
     {
-        uint8_t numberOfButtons = dataPointer[0];
-        _capsenseButtonCount = numberOfButtons;
-        
-        // Getting the 16 bit button status flag        
-        _capsenseButtonStatus1 = dataPointer[1];
-        _capsenseButtonStatus2 = dataPointer[2];
-        cbCharacteristicHandler(YES, nil);
+        return ^(CBCharacteristic *characteristic, NSError *error) {
+            NSData *data = characteristic.value;
+            BOOL success = (error == nil && [data length] >= 3);
+            if (success) {
+                const uint8_t *dataPointer = [data bytes];
+                weakSelf.capsenseButtonCount = dataPointer[0];
+                
+                // Getting the 16 bit button status flag
+                weakSelf.capsenseButtonStatus1 = dataPointer[1];
+                weakSelf.capsenseButtonStatus2 = dataPointer[2];
+            }
+            [weakSelf handleValueOfCharacteristic:characteristic success:success error:error];
+        };
     }
-    else
+    return nil;
+}
+
+/*!
+ *  @method handleValueOfCharacteristic:success:error:
+ *
+ *  @discussion Reports a parsed CapSense value to the handler and logs it
+ */
+-(void)handleValueOfCharacteristic:(CBCharacteristic *)characteristic success:(BOOL)success error:(NSError *)error
+{
+    if (cbCharacteristicHandler != nil)
     {
-        cbCharacteristicHandler(NO, error);
+        cbCharacteristicHandler(success, error);
     }
     
-    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",NOTIFY_RESPONSE,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:data]]];
+    [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_NOTIFY_RESPONSE data:characteristic.value error:nil];
 }
 
 @end
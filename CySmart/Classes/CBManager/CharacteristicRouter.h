@@ -0,0 +1,95 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import <CoreBluetooth/CoreBluetooth.h>
+
+/*!
+ *  @discussion Handler of the value updates of a characteristic. error is set when the read or notification failed.
+ *
+ */
+typedef void (^CharacteristicValueHandler)(CBCharacteristic *characteristic, NSError *error);
+
+/*!
+ *  @class CharacteristicRouter
+ *
+ *  @discussion Routes characteristic value updates to the handlers subscribed to them. Handlers are registered per
+ *  service and characteristic UUID; once the characteristics of a service are discovered the subscriptions are
+ *  resolved into a table keyed by the characteristic itself, so an update is routed with a single lookup and reaches
+ *  every handler subscribed to it. Used on the main queue only.
+ *
+ */
+@interface CharacteristicRouter : NSObject
+
+/*!
+ *  @method subscribeToCharacteristic:ofService:handler:
+ *
+ *  @discussion Registers a handler for the value updates of a characteristic. Takes effect at once if the
+ *  characteristics of the service are already discovered. Returns the subscription to pass to unsubscribe:.
+ *
+ */
+-(id)subscribeToCharacteristic:(CBUUID *)characteristicUUID ofService:(CBUUID *)serviceUUID handler:(CharacteristicValueHandler)handler;
+
+/*!
+ *  @method unsubscribe:
+ *
+ *  @discussion Removes a subscription. Does nothing for nil or a subscription already removed.
+ *
+ */
+-(void)unsubscribe:(id)subscription;
+
+/*!
+ *  @method resolveCharacteristicsOfService:
+ *
+ *  @discussion Binds the subscriptions to the discovered characteristics of the service
+ *
+ */
+-(void)resolveCharacteristicsOfService:(CBService *)service;
+
+/*!
+ *  @method dispatchValueOfCharacteristic:error:
+ *
+ *  @discussion Passes a value update to the handlers subscribed to the characteristic. Returns NO if there are none.
+ *
+ */
+-(BOOL)dispatchValueOfCharacteristic:(CBCharacteristic *)characteristic error:(NSError *)error;
+
+/*!
+ *  @method removeResolvedCharacteristics
+ *
+ *  @discussion Forgets the discovered characteristics, when the peripheral disconnects. The subscriptions are kept
+ *  and resolved again on the next discovery.
+ *
+ */
+-(void)removeResolvedCharacteristics;
+
+@end
@@ -0,0 +1,178 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import "CharacteristicRouter.h"
+
+/*!
+ *  @class CharacteristicSubscription
+ *
+ *  @discussion Handler registered for a characteristic of a service
+ *
+ */
+@interface CharacteristicSubscription : NSObject
+
+@property (nonatomic, strong) CBUUID *serviceUUID;
+@property (nonatomic, strong) CBUUID *characteristicUUID;
+@property (nonatomic, copy) CharacteristicValueHandler handler;
+
+@end
+
+@implementation CharacteristicSubscription
+
+@end
+
+/*!
+ *  @class CharacteristicRouter
+ *
+ *  @discussion Resolves the subscriptions against the discovered characteristics and routes their value updates
+ *
+ */
+@interface CharacteristicRouter ()
+{
+    NSMutableDictionary *subscriptionsByService;    // Service UUID -> characteristic UUID -> subscriptions
+    NSMutableArray *resolvedServices;               // Services whose characteristics are discovered
+    NSMapTable *dispatchTable;                      // Characteristic -> handlers, rebuilt when the subscriptions change
+}
+
+@end
+
+@implementation CharacteristicRouter
+
+-(instancetype)init {
+    if (self = [super init])
+    {
+        subscriptionsByService = [[NSMutableDictionary alloc] init];
+        resolvedServices = [[NSMutableArray alloc] init];
+        dispatchTable = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+                                              valueOptions:NSPointerFunctionsStrongMemory];
+    }
+    return self;
+}
+
+-(id)subscribeToCharacteristic:(CBUUID *)characteristicUUID ofService:(CBUUID *)serviceUUID handler:(CharacteristicValueHandler)handler {
+    CharacteristicSubscription *subscription = [[CharacteristicSubscription alloc] init];
+    subscription.serviceUUID = serviceUUID;
+    subscription.characteristicUUID = characteristicUUID;
+    subscription.handler = handler;
+    
+    NSMutableDictionary *characteristics = [subscriptionsByService objectForKey:serviceUUID];
+    if (characteristics == nil) {
+        characteristics = [[NSMutableDictionary alloc] init];
+        [subscriptionsByService setObject:characteristics forKey:serviceUUID];
+    }
+    NSMutableArray *subscriptions = [characteristics objectForKey:characteristicUUID];
+    if (subscriptions == nil) {
+        subscriptions = [[NSMutableArray alloc] init];
+        [characteristics setObject:subscriptions forKey:characteristicUUID];
+    }
+    [subscriptions addObject:subscription];
+    
+    [self resolveServicesWithUUID:serviceUUID];
+    return subscription;
+}
+
+-(void)unsubscribe:(id)subscription {
+    if (![subscription isKindOfClass:[CharacteristicSubscription class]]) {
+        return;
+    }
+    CharacteristicSubscription *removed = subscription;
+    NSMutableDictionary *characteristics = [subscriptionsByService objectForKey:removed.serviceUUID];
+    NSMutableArray *subscriptions = [characteristics objectForKey:removed.characteristicUUID];
+    if (subscriptions == nil || [subscriptions indexOfObjectIdenticalTo:removed] == NSNotFound) {
+        return;
+    }
+    
+    [subscriptions removeObjectIdenticalTo:removed];
+    if (subscriptions.count == 0) {
+        [characteristics removeObjectForKey:removed.characteristicUUID];
+    }
+    if (characteristics.count == 0) {
+        [subscriptionsByService removeObjectForKey:removed.serviceUUID];
+    }
+    [self resolveServicesWithUUID:removed.serviceUUID];
+}
+
+-(void)resolveCharacteristicsOfService:(CBService *)service {
+    if ([resolvedServices indexOfObjectIdenticalTo:service] == NSNotFound) {
+        [resolvedServices addObject:service];
+    }
+    
+    NSDictionary *characteristics = [subscriptionsByService objectForKey:service.UUID];
+    for (CBCharacteristic *characteristic in service.characteristics)
+    {
+        NSArray *subscriptions = [characteristics objectForKey:characteristic.UUID];
+        if (subscriptions.count == 0) {
+            [dispatchTable removeObjectForKey:characteristic];
+            continue;
+        }
+        
+        // A new array each time, so that a handler may subscribe or unsubscribe while the old one is dispatched
+        NSMutableArray *handlers = [NSMutableArray arrayWithCapacity:subscriptions.count];
+        for (CharacteristicSubscription *subscription in subscriptions) {
+            [handlers addObject:subscription.handler];
+        }
+        [dispatchTable setObject:[handlers copy] forKey:characteristic];
+    }
+}
+
+/*!
+ *  @method resolveServicesWithUUID:
+ *
+ *  @discussion Binds the subscriptions again in the discovered services of a UUID, after they changed
+ *
+ */
+-(void)resolveServicesWithUUID:(CBUUID *)serviceUUID {
+    for (CBService *service in resolvedServices)
+    {
+        if ([service.UUID isEqual:serviceUUID]) {
+            [self resolveCharacteristicsOfService:service];
+        }
+    }
+}
+
+-(BOOL)dispatchValueOfCharacteristic:(CBCharacteristic *)characteristic error:(NSError *)error {
+    NSArray *handlers = [dispatchTable objectForKey:characteristic];
+    if (handlers == nil) {
+        return NO;
+    }
+    for (CharacteristicValueHandler handler in handlers) {
+        handler(characteristic, error);
+    }
+    return YES;
+}
+
+-(void)removeResolvedCharacteristics {
+    [resolvedServices removeAllObjects];
+    [dispatchTable removeAllObjects];
+}
+
+@end
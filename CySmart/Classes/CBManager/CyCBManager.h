@@ -36,6 +36,11 @@
 #import "LoggerHandler.h"
 #import "ResourceHandler.h"
 #import "Utilities.h"
+#import "ScanRegistry.h"
+#import "ScanPolicy.h"
+#import "CharacteristicRouter.h"
+
+@class OTAFirmwareImage;
 
 
 /*!
@@ -60,6 +65,15 @@
  */
 - (void) bluetoothStateUpdatedToState:(BOOL)state;
 
+@optional
+/*!
+ *  @method discoveryDidUpdateWithDiff:
+ *
+ *  @discussion This method is invoked at most once per publish interval with the changes of foundPeripherals. When it
+ *  is implemented, discoveryDidRefresh is not invoked for scan changes.
+ */
+- (void) discoveryDidUpdateWithDiff:(ScanRegistryDiff *)diff;
+
 @end
 
 @protocol cbCharacteristicManagerDelegate <NSObject>
@@ -171,10 +185,35 @@
 /*!
  *  @property foundPeripherals
  *
- *  @discussion  All discovered peripherals while scanning.
+ *  @discussion  All discovered peripherals while scanning, as CBPeripheralExt in the order they were found.
  *
  */
-@property (retain, nonatomic) NSMutableArray    *foundPeripherals;
+@property (readonly, nonatomic) NSArray         *foundPeripherals;
+
+/*!
+ *  @property scanRegistry
+ *
+ *  @discussion  Registry of the discovered peripherals.
+ *
+ */
+@property (readonly, nonatomic) ScanRegistry    *scanRegistry;
+
+/*!
+ *  @property scanPolicy
+ *
+ *  @discussion  Services, filters, aging and duty cycle of the scan. Setting it while scanning restarts the scan.
+ *
+ */
+@property (copy, nonatomic) ScanPolicy          *scanPolicy;
+
+/*!
+ *  @property characteristicRouter
+ *
+ *  @discussion  Routes characteristic value updates to the handlers subscribed to them. A value update with
+ *  subscribers is passed to them instead of cbCharacteristicDelegate.
+ *
+ */
+@property (readonly, nonatomic) CharacteristicRouter *characteristicRouter;
 
 /*!
  *  @property foundServices
@@ -263,4 +302,47 @@
  */
 - (void) disconnectPeripheral:(CBPeripheral*)peripheral;
 
+/*!
+ *  @method connectSessionPeripheral:connectionHandler:
+ *
+ *  @discussion	 Establishes a connection to a peripheral of a multi-device upgrade. The connection is tracked apart from
+ *  myPeripheral; handler is invoked on connection, connection failure and disconnection.
+ *
+ */
+- (void) connectSessionPeripheral:(CBPeripheral*)peripheral connectionHandler:(void (^)(BOOL connected, NSError *error))handler;
+
+/*!
+ *  @method disconnectSessionPeripheral:
+ *
+ *  @discussion	 Cancels the connection to a peripheral of a multi-device upgrade
+ *
+ */
+- (void) disconnectSessionPeripheral:(CBPeripheral*)peripheral;
+
+/*!
+ *  @method bootloaderPeripherals
+ *
+ *  @discussion	 Returns the discovered peripherals, other than myPeripheral, that advertise the bootloader service
+ *
+ */
+- (NSArray *) bootloaderPeripherals;
+
+/*!
+ *  @method upgradePeripherals:firmwareImage:header:securityKey:completionHandler:
+ *
+ *  @discussion	 Upgrades the peripherals with a CYACD image at once, each through its own session. The number of
+ *  peripherals connected at a time and the total on-air bandwidth are limited. completionHandler is invoked once every
+ *  peripheral has finished.
+ *
+ */
+- (void) upgradePeripherals:(NSArray *)peripherals firmwareImage:(OTAFirmwareImage *)image header:(NSDictionary *)header securityKey:(NSData *)securityKey completionHandler:(void (^)(NSUInteger upgradedCount, NSUInteger failedCount))completionHandler;
+
+/*!
+ *  @method cancelPeripheralUpgrades
+ *
+ *  @discussion	 Disconnects every peripheral of a multi-device upgrade still in progress
+ *
+ */
+- (void) cancelPeripheralUpgrades;
+
 @end
@@ -35,9 +35,18 @@
 #import "CBPeripheralExt.h"
 #import "ResourceHandler.h"
 #import "Utilities.h"
+#import "OTAUpgradeScheduler.h"
+#import <QuartzCore/QuartzCore.h>
 
 #define MY_DOMAIN       @"myDomain"
 
+// Limits of a multi-device upgrade: peripherals connected at a time and total on-air bytes per second
+#define MULTI_DEVICE_OTA_MAX_CONNECTIONS    4
+#define MULTI_DEVICE_OTA_BYTES_PER_SECOND   20000
+
+// Shortest time between two updates of the device list
+#define SCAN_PUBLISH_INTERVAL   0.2
+
 /*!
  *  @class CyCBManager
  *
@@ -47,10 +56,13 @@
 @interface CyCBManager () <CBCentralManagerDelegate, CBPeripheralDelegate>
 {
     CBCentralManager *centralManager;
-    NSMutableArray *peripheralArray;
+    ScanPolicyEngine *scanEngine;
     
     void (^cbCommunicationHandler)(BOOL success, NSError *error);
     BOOL isTimeOutAlert;
+    
+    NSMutableDictionary *sessionConnectionHandlers; // Connection handlers of multi-device upgrade peripherals by identifier
+    OTAUpgradeScheduler *upgradeScheduler; // Scheduler of the multi-device upgrade in progress
 }
 @end
 
@@ -62,7 +74,8 @@
 @synthesize myCharacteristic;
 @synthesize serviceUUIDDict;
 @synthesize cbDiscoveryDelegate;
-@synthesize foundPeripherals;
+@synthesize scanRegistry;
+@synthesize characteristicRouter;
 @synthesize foundServices;
 @synthesize characteristicDescriptors;
 @synthesize characteristicProperties;
@@ -93,9 +106,15 @@
     if (self = [super init])
     {
         centralManager = [[CBCentralManager alloc] initWithDelegate:self queue:nil];
-        foundPeripherals = [[NSMutableArray alloc] init];
         foundServices = [[NSMutableArray alloc] init];
-        peripheralArray = [[NSMutableArray alloc] init];
+        scanRegistry = [[ScanRegistry alloc] initWithPublishInterval:SCAN_PUBLISH_INTERVAL];
+        __weak CyCBManager *weakSelf = self;
+        scanRegistry.publishHandler = ^(ScanRegistryDiff *diff) {
+            [weakSelf discoveryDidUpdateWithDiff:diff];
+        };
+        scanEngine = [[ScanPolicyEngine alloc] initWithCentralManager:centralManager registry:scanRegistry];
+        sessionConnectionHandlers = [[NSMutableDictionary alloc] init];
+        characteristicRouter = [[CharacteristicRouter alloc] init];
         serviceUUIDDict = [NSMutableDictionary dictionaryWithDictionary:[ResourceHandler getItemsFromPropertyList:k_SERVICE_UUID_PLIST_NAME]];
         bootloaderFileArray = nil;
         bootloaderSecurityKey = nil;
@@ -106,10 +125,61 @@
 
 #pragma mark - Discovery
 
+/*!
+ *  @method foundPeripherals
+ *
+ *  @discussion Returns the published peripherals of the scan registry.
+ *
+ */
+- (NSArray *) foundPeripherals
+{
+    return scanRegistry.devices;
+}
+
+/*!
+ *  @method scanPolicy
+ *
+ *  @discussion Returns the policy of the scan engine.
+ *
+ */
+- (ScanPolicy *) scanPolicy
+{
+    return scanEngine.policy;
+}
+
+/*!
+ *  @method setScanPolicy:
+ *
+ *  @discussion Sets the policy of the scan engine, restarting the scan if it is running.
+ *
+ */
+- (void) setScanPolicy:(ScanPolicy *)policy
+{
+    scanEngine.policy = policy;
+}
+
+/*!
+ *  @method discoveryDidUpdateWithDiff:
+ *
+ *  @discussion Passes a diff of the scan registry on to the discovery delegate.
+ *
+ */
+- (void) discoveryDidUpdateWithDiff:(ScanRegistryDiff *)diff
+{
+    if ([cbDiscoveryDelegate respondsToSelector:@selector(discoveryDidUpdateWithDiff:)])
+    {
+        [cbDiscoveryDelegate discoveryDidUpdateWithDiff:diff];
+    }
+    else
+    {
+        [cbDiscoveryDelegate discoveryDidRefresh];
+    }
+}
+
 /*!
  *  @method startScanning
  *
- *  @discussion Scan for advertising peripherals.
+ *  @discussion Scan for advertising peripherals by the scan policy.
  *
  */
 - (void) startScanning
@@ -117,11 +187,7 @@
     if((NSInteger)[centralManager state] == CBCentralManagerStatePoweredOn)
     {
         [cbDiscoveryDelegate bluetoothStateUpdatedToState:YES];
-        NSDictionary *options = [NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithBool:NO], CBCentralManagerScanOptionAllowDuplicatesKey, nil];
-//        [centralManager scanForPeripheralsWithServices:nil options:options];
-      CBUUID* core2DFUUUID = [CBUUID UUIDWithString:@"00060000-f8ce-11e4-abf4-0002a5d5c51b"];
-      NSArray<CBUUID*>* svcs = @[core2DFUUUID];
-      [centralManager scanForPeripheralsWithServices:svcs options:options];
+        [scanEngine start];
     }
     else if ([centralManager state] == CBCentralManagerStateUnsupported)
     {
@@ -138,7 +204,7 @@
  */
 - (void) stopScanning
 {
-    [centralManager stopScan];
+    [scanEngine stop];
 }
 
 /*!
@@ -149,16 +215,10 @@
  */
 - (void)centralManager:(CBCentralManager *)central didDiscoverPeripheral:(CBPeripheral *)peripheral advertisementData:(NSDictionary *)advertisementData RSSI:(NSNumber *)RSSI
 {
-    // Add the peripheral to the list of discovered peripherals
-    if (![peripheralArray containsObject:peripheral] && peripheral.state != CBPeripheralStateConnected)
+    // Add the peripheral to the list of discovered peripherals if the policy admits it, or update it in place
+    if (peripheral.state != CBPeripheralStateConnected)
     {
-        CBPeripheralExt *peripheralExt = [[CBPeripheralExt alloc] init];
-        peripheralExt.mPeripheral = [peripheral copy];
-        peripheralExt.mAdvertisementData = [advertisementData copy];
-        peripheralExt.mRSSI = [RSSI copy];
-        [peripheralArray addObject:peripheral];
-        [foundPeripherals addObject:peripheralExt];
-        [cbDiscoveryDelegate discoveryDidRefresh];
+        [scanEngine handleAdvertisementOfPeripheral:peripheral identifier:peripheral.identifier advertisementData:advertisementData RSSI:RSSI time:CACurrentMediaTime()];
     }
 }
 
@@ -233,6 +293,127 @@
     }
 }
 
+/*!
+ *  @method connectSessionPeripheral:connectionHandler:
+ *
+ *  @discussion	 Connect to a peripheral of a multi-device upgrade.
+ *
+ */
+- (void) connectSessionPeripheral:(CBPeripheral*)peripheral connectionHandler:(void (^)(BOOL connected, NSError *error))handler
+{
+    if ((NSInteger)[centralManager state] != CBCentralManagerStatePoweredOn)
+    {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            handler(NO, nil);
+        });
+        return;
+    }
+    
+    [sessionConnectionHandlers setObject:[handler copy] forKey:peripheral.identifier];
+    [centralManager connectPeripheral:peripheral options:nil];
+    [[LoggerHandler logManager] addLogData:[NSString stringWithFormat:@"[%@] %@", peripheral.name, CONNECTION_REQUEST]];
+}
+
+/*!
+ *  @method disconnectSessionPeripheral:
+ *
+ *  @discussion	 Disconnect a peripheral of a multi-device upgrade.
+ *
+ */
+- (void) disconnectSessionPeripheral:(CBPeripheral*)peripheral
+{
+    if (peripheral && [sessionConnectionHandlers objectForKey:peripheral.identifier])
+    {
+        [centralManager cancelPeripheralConnection:peripheral];
+    }
+}
+
+/*!
+ *  @method bootloaderPeripherals
+ *
+ *  @discussion	 Returns the discovered peripherals, other than myPeripheral, that advertise the bootloader service
+ *
+ */
+- (NSArray *) bootloaderPeripherals
+{
+    NSMutableArray *peripherals = [NSMutableArray new];
+    for (CBPeripheralExt *device in scanRegistry.devices)
+    {
+        NSArray *serviceUUIDs = [device.mAdvertisementData objectForKey:CBAdvertisementDataServiceUUIDsKey];
+        if ([serviceUUIDs containsObject:CUSTOM_BOOT_LOADER_SERVICE_UUID] && ![device.identifier isEqual:myPeripheral.identifier])
+        {
+            [peripherals addObject:device.mPeripheral];
+        }
+    }
+    return peripherals;
+}
+
+/*!
+ *  @method upgradePeripherals:firmwareImage:header:securityKey:completionHandler:
+ *
+ *  @discussion	 Upgrades the peripherals with a CYACD image at once.
+ *
+ */
+- (void) upgradePeripherals:(NSArray *)peripherals firmwareImage:(OTAFirmwareImage *)image header:(NSDictionary *)header securityKey:(NSData *)securityKey completionHandler:(void (^)(NSUInteger upgradedCount, NSUInteger failedCount))completionHandler
+{
+    [self cancelPeripheralUpgrades];
+    
+    NSUInteger peripheralCount = peripherals.count;
+    if (peripheralCount == 0)
+    {
+        if (completionHandler)
+        {
+            completionHandler(0, 0);
+        }
+        return;
+    }
+    
+    OTAUpgradeScheduler *scheduler = [[OTAUpgradeScheduler alloc] initWithFirmwareImage:image header:header securityKey:securityKey maxConnections:MULTI_DEVICE_OTA_MAX_CONNECTIONS bytesPerSecond:MULTI_DEVICE_OTA_BYTES_PER_SECOND];
+    upgradeScheduler = scheduler;
+    
+    __block NSUInteger upgradedCount = 0;
+    __block NSUInteger failedCount = 0;
+    __weak CyCBManager *weakSelf = self;
+    __weak OTAUpgradeScheduler *weakScheduler = scheduler;
+    [scheduler upgradePeripherals:peripherals progressHandler:nil completionHandler:^(CBPeripheral *peripheral, NSError *error) {
+        if (error)
+        {
+            failedCount++;
+            [[LoggerHandler logManager] addLogData:[NSString stringWithFormat:@"[%@] %@", peripheral.name, error.localizedDescription]];
+        }
+        else
+        {
+            upgradedCount++;
+            [[LoggerHandler logManager] addLogData:[NSString stringWithFormat:@"[%@] %@", peripheral.name, LOCALIZEDSTRING(@"OTAUpgradeCompletedMessage")]];
+        }
+        
+        if (upgradedCount + failedCount == peripheralCount)
+        {
+            CyCBManager *strongSelf = weakSelf;
+            if (strongSelf && strongSelf->upgradeScheduler == weakScheduler)
+            {
+                strongSelf->upgradeScheduler = nil;
+            }
+            if (completionHandler)
+            {
+                completionHandler(upgradedCount, failedCount);
+            }
+        }
+    }];
+}
+
+/*!
+ *  @method cancelPeripheralUpgrades
+ *
+ *  @discussion	 Disconnects every peripheral of a multi-device upgrade still in progress
+ *
+ */
+- (void) cancelPeripheralUpgrades
+{
+    [upgradeScheduler cancel];
+    upgradeScheduler = nil;
+}
+
 /*!
  *  @method centralManager:didConnectPeripheral:
  *
@@ -242,6 +423,14 @@
 - (void) centralManager:(CBCentralManager *)central didConnectPeripheral:(CBPeripheral *)peripheral
 {
   NSLog(@"Cypress: didConnectPeripheral ");
+    void (^sessionHandler)(BOOL connected, NSError *error) = [sessionConnectionHandlers objectForKey:peripheral.identifier];
+    if (sessionHandler)
+    {
+        [[LoggerHandler logManager] addLogData:[NSString stringWithFormat:@"[%@] %@", peripheral.name, CONNECTION_ESTABLISH]];
+        sessionHandler(YES, nil);
+        return;
+    }
+    
     myPeripheral =  nil;
     myPeripheral = [peripheral copy];
     myPeripheral.delegate = self ;
@@ -262,6 +451,14 @@
 - (void) centralManager:(CBCentralManager *)central didFailToConnectPeripheral:(CBPeripheral *)peripheral error:(NSError *)error
 {
   NSLog(@"Cypress: didFailToConnectPeripheral ");
+    void (^sessionHandler)(BOOL connected, NSError *error) = [sessionConnectionHandlers objectForKey:peripheral.identifier];
+    if (sessionHandler)
+    {
+        [sessionConnectionHandlers removeObjectForKey:peripheral.identifier];
+        sessionHandler(NO, error);
+        return;
+    }
+    
      [self cancelTimeOutAlert];
      cbCommunicationHandler(NO,error);
 }
@@ -275,6 +472,16 @@
 - (void) centralManager:(CBCentralManager *)central didDisconnectPeripheral:(CBPeripheral *)peripheral error:(NSError *)error
 {
   NSLog(@"Cypress: didDisconnectPeripheral ");
+    void (^sessionHandler)(BOOL connected, NSError *error) = [sessionConnectionHandlers objectForKey:peripheral.identifier];
+    if (sessionHandler)
+    {
+        // Peripherals of a multi-device upgrade do not affect the connection of myPeripheral
+        [sessionConnectionHandlers removeObjectForKey:peripheral.identifier];
+        [[LoggerHandler logManager] addLogData:[NSString stringWithFormat:@"[%@] %@",peripheral.name,DISCONNECTED]];
+        sessionHandler(NO, error);
+        return;
+    }
+    
     [self cancelTimeOutAlert];
 
     /*  Check whether the disconnection is done by the device */
@@ -378,6 +585,11 @@
 - (void)peripheral:(CBPeripheral *)peripheral didDiscoverCharacteristicsForService:(CBService *)service error:(NSError *)error
 {
     NSLog(@"Cypress: didDiscoverCharacteristicsForService: %@ ", service.UUID);
+    if (error == nil)
+    {
+        [characteristicRouter resolveCharacteristicsOfService:service];
+    }
+    
     if([cbCharacteristicDelegate isKindOfClass:[CyCBManager class]] || cbCharacteristicDelegate == nil)
     {
         cbCommunicationHandler(YES,nil);
@@ -399,10 +611,15 @@
     {
         if (!characteristic.isNotifying)
         {
-            [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@- %@%@",READ_RESPONSE,READ_ERROR,[error.userInfo objectForKey:NSLocalizedDescriptionKey]]];
+            [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_READ_RESPONSE data:nil error:error];
         }
     }
     
+    if ([characteristicRouter dispatchValueOfCharacteristic:characteristic error:error])
+    {
+        return;
+    }
+    
     if([cbCharacteristicDelegate respondsToSelector:@selector(peripheral:didUpdateValueForCharacteristic:error:)])
     {
         [cbCharacteristicDelegate peripheral:peripheral didUpdateValueForCharacteristic:characteristic error:error];
@@ -442,7 +659,7 @@
   NSLog(@"Cypress: didUpdateValueForDescriptor: %@ ", descriptor.UUID);
     if (error)
     {
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:descriptor.characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:descriptor.characteristic.UUID] descriptor:[Utilities getDiscriptorNameForUUID:descriptor.UUID] operation:[NSString stringWithFormat:@"%@- %@%@",READ_RESPONSE,READ_ERROR,[error.userInfo objectForKey:NSLocalizedDescriptionKey]]];
+        [Utilities logTraceWithService:descriptor.characteristic.service.UUID characteristic:descriptor.characteristic.UUID descriptor:descriptor.UUID operation:GATT_TRACE_READ_RESPONSE data:nil error:error];
     }
     [cbCharacteristicDelegate peripheral:peripheral didUpdateValueForDescriptor:descriptor error:error];
 }
@@ -470,9 +687,9 @@
  */
 - (void) clearDevices
 {
-    [peripheralArray removeAllObjects];
-    [foundPeripherals removeAllObjects];
+    [scanRegistry removeAllDevices];
     [foundServices removeAllObjects];
+    [characteristicRouter removeResolvedCharacteristics];
 }
 
 /*
@@ -488,6 +705,7 @@
     {
         case CBCentralManagerStatePoweredOff:
         {
+            [scanEngine stop];
             [self clearDevices];
             /* Tell user to power ON BT for functionality, but not on first run - the Framework will alert in that instance. */
             //Show Alert
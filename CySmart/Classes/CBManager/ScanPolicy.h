@@ -0,0 +1,192 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import <CoreBluetooth/CoreBluetooth.h>
+#import "ScanRegistry.h"
+#import "ScanSearchIndex.h"
+
+/*!
+ *  @class ScanPolicy
+ *
+ *  @discussion What is scanned for and how long peripherals are kept: the services requested from CoreBluetooth, the
+ *  filter new peripherals must pass, how often a peripheral is updated, when it ages out and the scan duty cycle.
+ *
+ */
+@interface ScanPolicy : NSObject <NSCopying>
+
+/*!
+ *  @property serviceUUIDs
+ *
+ *  @discussion CBUUIDs of the services scanned for, nil to scan for every peripheral
+ *
+ */
+@property (nonatomic, copy) NSArray *serviceUUIDs;
+
+/*!
+ *  @property filter
+ *
+ *  @discussion Filter a peripheral must pass to be added to the scan list, nil to add every peripheral. Once added, a
+ *  peripheral is updated until it ages out.
+ *
+ */
+@property (nonatomic, copy) ScanFilter *filter;
+
+/*!
+ *  @property reportsDuplicates
+ *
+ *  @discussion YES to receive every advertisement of a peripheral, NO to receive it once. Aging relies on repeated
+ *  advertisements, so staleInterval should be 0 when this is NO.
+ *
+ */
+@property (nonatomic) BOOL reportsDuplicates;
+
+/*!
+ *  @property minimumUpdateInterval
+ *
+ *  @discussion Shortest time between two advertisements of a peripheral that update its RSSI and advertisement data
+ *
+ */
+@property (nonatomic) NSTimeInterval minimumUpdateInterval;
+
+/*!
+ *  @property staleInterval
+ *
+ *  @discussion Scanning time without advertisements after which a peripheral is removed, 0 to keep peripherals until
+ *  the list is cleared
+ *
+ */
+@property (nonatomic) NSTimeInterval staleInterval;
+
+/*!
+ *  @property scanWindow
+ *
+ *  @discussion Time scanned in every scan interval. The scan is continuous unless it is shorter than scanInterval.
+ *
+ */
+@property (nonatomic) NSTimeInterval scanWindow;
+
+/*!
+ *  @property scanInterval
+ *
+ *  @discussion Time from the start of one scan window to the start of the next
+ *
+ */
+@property (nonatomic) NSTimeInterval scanInterval;
+
+/*!
+ *  @method defaultPolicy
+ *
+ *  @discussion Returns the policy used unless set: a continuous scan for the upgrade service
+ *
+ */
++(instancetype)defaultPolicy;
+
+/*!
+ *  @method isDutyCycled
+ *
+ *  @discussion Returns YES if the scan pauses between scan windows
+ *
+ */
+-(BOOL)isDutyCycled;
+
+@end
+
+/*!
+ *  @class ScanPolicyEngine
+ *
+ *  @discussion Runs the scan of a central manager by a policy: starts and stops the scan windows, admits the
+ *  advertisements that pass the filter into the scan registry and configures the registry's rate limit and aging.
+ *  Time the scan is paused between windows does not count toward aging. Used on the main queue only.
+ *
+ */
+@interface ScanPolicyEngine : NSObject
+
+/*!
+ *  @property policy
+ *
+ *  @discussion Policy of the scan. Setting it while the scan is started restarts the scan with the new policy;
+ *  peripherals already found are kept until they age out.
+ *
+ */
+@property (nonatomic, copy) ScanPolicy *policy;
+
+/*!
+ *  @property started
+ *
+ *  @discussion YES between start and stop
+ *
+ */
+@property (nonatomic, readonly, getter=isStarted) BOOL started;
+
+/*!
+ *  @property scanning
+ *
+ *  @discussion YES while a scan window is open
+ *
+ */
+@property (nonatomic, readonly, getter=isScanning) BOOL scanning;
+
+/*!
+ *  @method initWithCentralManager:registry:
+ *
+ *  @discussion Creates an engine with the default policy. The central manager is not retained.
+ *
+ */
+-(instancetype)initWithCentralManager:(CBCentralManager *)centralManager registry:(ScanRegistry *)registry;
+
+/*!
+ *  @method start
+ *
+ *  @discussion Opens the first scan window and publishes the registry until stop. Restarts the scan if it is started.
+ *
+ */
+-(void)start;
+
+/*!
+ *  @method stop
+ *
+ *  @discussion Stops the scan and the scan windows
+ *
+ */
+-(void)stop;
+
+/*!
+ *  @method handleAdvertisementOfPeripheral:identifier:advertisementData:RSSI:time:
+ *
+ *  @discussion Records an advertisement in the registry if the peripheral is in it already or passes the filter.
+ *  Returns YES if it was recorded.
+ *
+ */
+-(BOOL)handleAdvertisementOfPeripheral:(CBPeripheral *)peripheral identifier:(NSUUID *)identifier advertisementData:(NSDictionary *)advertisementData RSSI:(NSNumber *)RSSI time:(NSTimeInterval)time;
+
+@end
@@ -0,0 +1,244 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import "ScanPolicy.h"
+#import <QuartzCore/QuartzCore.h>
+
+// Service of the upgrade firmware, scanned for unless the policy is set
+#define SCAN_UPGRADE_SERVICE_UUID       @"00060000-f8ce-11e4-abf4-0002a5d5c51b"
+
+// Shortest time between two applied advertisements of a peripheral in the default policy
+#define SCAN_MINIMUM_UPDATE_INTERVAL    0.1
+
+@implementation ScanPolicy
+
+@synthesize serviceUUIDs;
+@synthesize filter;
+@synthesize reportsDuplicates;
+@synthesize minimumUpdateInterval;
+@synthesize staleInterval;
+@synthesize scanWindow;
+@synthesize scanInterval;
+
++(instancetype)defaultPolicy {
+    ScanPolicy *policy = [[ScanPolicy alloc] init];
+    policy.serviceUUIDs = @[[CBUUID UUIDWithString:SCAN_UPGRADE_SERVICE_UUID]];
+    policy.reportsDuplicates = YES;
+    policy.minimumUpdateInterval = SCAN_MINIMUM_UPDATE_INTERVAL;
+    policy.staleInterval = SCAN_STALE_INTERVAL;
+    return policy;
+}
+
+-(BOOL)isDutyCycled {
+    return scanWindow > 0 && scanWindow < scanInterval;
+}
+
+-(id)copyWithZone:(NSZone *)zone {
+    ScanPolicy *copy = [[ScanPolicy allocWithZone:zone] init];
+    copy.serviceUUIDs = serviceUUIDs;
+    copy.filter = filter;
+    copy.reportsDuplicates = reportsDuplicates;
+    copy.minimumUpdateInterval = minimumUpdateInterval;
+    copy.staleInterval = staleInterval;
+    copy.scanWindow = scanWindow;
+    copy.scanInterval = scanInterval;
+    return copy;
+}
+
+@end
+
+/*!
+ *  @class ScanPolicyEngine
+ *
+ *  @discussion Scans by a policy and admits the peripherals found into the scan registry
+ *
+ */
+@interface ScanPolicyEngine ()
+{
+    __weak CBCentralManager *centralManager;
+    ScanRegistry *registry;
+    NSTimer *windowTimer;               // Closes the open scan window, or opens the next one
+}
+
+@end
+
+@implementation ScanPolicyEngine
+
+@synthesize policy;
+@synthesize started;
+@synthesize scanning;
+
+-(instancetype)initWithCentralManager:(CBCentralManager *)manager registry:(ScanRegistry *)scanRegistry {
+    if (self = [super init])
+    {
+        centralManager = manager;
+        registry = scanRegistry;
+        self.policy = [ScanPolicy defaultPolicy];
+    }
+    return self;
+}
+
+-(void)dealloc {
+    [windowTimer invalidate];
+}
+
+-(void)setPolicy:(ScanPolicy *)newPolicy {
+    policy = [newPolicy copy];
+    registry.staleInterval = policy.staleInterval;
+    registry.minimumUpdateInterval = policy.minimumUpdateInterval;
+    if (started)
+    {
+        [self start];
+    }
+}
+
+-(void)start {
+    [self cancelWindowTimer];
+    if (scanning)
+    {
+        [centralManager stopScan];
+        scanning = NO;
+    }
+    started = YES;
+    [self openScanWindow];
+}
+
+-(void)stop {
+    if (!started)
+    {
+        return;
+    }
+    started = NO;
+    [self cancelWindowTimer];
+    [self closeScanWindow];
+}
+
+-(void)cancelWindowTimer {
+    [windowTimer invalidate];
+    windowTimer = nil;
+}
+
+/*!
+ *  @method scheduleWindowTimer:afterInterval:
+ *
+ *  @discussion Replaces the window timer with a timer that performs the selector after the interval
+ *
+ */
+-(void)scheduleWindowTimer:(SEL)selector afterInterval:(NSTimeInterval)interval {
+    [self cancelWindowTimer];
+    // Common modes keep the duty cycle running while the list is scrolled
+    windowTimer = [NSTimer timerWithTimeInterval:interval target:self selector:selector userInfo:nil repeats:NO];
+    [[NSRunLoop mainRunLoop] addTimer:windowTimer forMode:NSRunLoopCommonModes];
+}
+
+/*!
+ *  @method openScanWindow
+ *
+ *  @discussion Starts scanning and, if the scan is duty cycled, schedules the end of the window
+ *
+ */
+-(void)openScanWindow {
+    if ((NSInteger)[centralManager state] == CBCentralManagerStatePoweredOn)
+    {
+        NSDictionary *options = [NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithBool:policy.reportsDuplicates], CBCentralManagerScanOptionAllowDuplicatesKey, nil];
+        [centralManager scanForPeripheralsWithServices:policy.serviceUUIDs options:options];
+    }
+    scanning = YES;
+    [registry startPublishingAtTime:CACurrentMediaTime()];
+    if ([policy isDutyCycled])
+    {
+        [self scheduleWindowTimer:@selector(scanWindowDidEnd:) afterInterval:policy.scanWindow];
+    }
+}
+
+/*!
+ *  @method closeScanWindow
+ *
+ *  @discussion Stops scanning and publishing
+ *
+ */
+-(void)closeScanWindow {
+    if (scanning)
+    {
+        [centralManager stopScan];
+        scanning = NO;
+    }
+    [registry stopPublishingAtTime:CACurrentMediaTime()];
+}
+
+-(void)scanWindowDidEnd:(NSTimer *)timer {
+    windowTimer = nil;
+    [self closeScanWindow];
+    [self scheduleWindowTimer:@selector(scanPauseDidEnd:) afterInterval:policy.scanInterval - policy.scanWindow];
+}
+
+-(void)scanPauseDidEnd:(NSTimer *)timer {
+    windowTimer = nil;
+    [self openScanWindow];
+}
+
+/*!
+ *  @method admitsPeripheral:advertisementData:RSSI:
+ *
+ *  @discussion Returns YES if a peripheral not in the registry passes the filter of the policy
+ *
+ */
+-(BOOL)admitsPeripheral:(CBPeripheral *)peripheral advertisementData:(NSDictionary *)advertisementData RSSI:(NSNumber *)RSSI {
+    ScanFilter *filter = policy.filter;
+    if (filter == nil)
+    {
+        return YES;
+    }
+    
+    NSString *name = nil;
+    if (filter.foldedNameText.length > 0)
+    {
+        name = [advertisementData objectForKey:CBAdvertisementDataLocalNameKey];
+        if (name.length == 0)
+        {
+            name = peripheral.name;
+        }
+        name = name ? [ScanFilter foldName:name] : nil;
+    }
+    return [filter matchesFoldedName:name advertisementData:advertisementData RSSI:RSSI ? RSSI.doubleValue : RSSI_UNDEFINED_VALUE];
+}
+
+-(BOOL)handleAdvertisementOfPeripheral:(CBPeripheral *)peripheral identifier:(NSUUID *)identifier advertisementData:(NSDictionary *)advertisementData RSSI:(NSNumber *)RSSI time:(NSTimeInterval)time {
+    if ([registry deviceWithIdentifier:identifier] == nil && ![self admitsPeripheral:peripheral advertisementData:advertisementData RSSI:RSSI])
+    {
+        return NO;
+    }
+    [registry updateWithPeripheral:peripheral identifier:identifier advertisementData:advertisementData RSSI:RSSI time:time];
+    return YES;
+}
+
+@end
@@ -0,0 +1,181 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import <CoreBluetooth/CoreBluetooth.h>
+#import "CBPeripheralExt.h"
+
+/*!
+ *  @discussion Time without advertisements after which a peripheral is removed, unless set
+ *
+ */
+#define SCAN_STALE_INTERVAL     10.0
+
+/*!
+ *  @class ScanRegistryDiff
+ *
+ *  @discussion Changes of the scan list between two publications
+ *
+ */
+@interface ScanRegistryDiff : NSObject
+
+/*!
+ *  @property removedIndexes
+ *
+ *  @discussion Positions of the removed peripherals in the list before the change
+ *
+ */
+@property (nonatomic, readonly) NSIndexSet *removedIndexes;
+
+/*!
+ *  @property insertedIndexes
+ *
+ *  @discussion Positions of the new peripherals in the list after the change
+ *
+ */
+@property (nonatomic, readonly) NSIndexSet *insertedIndexes;
+
+/*!
+ *  @property updatedIndexes
+ *
+ *  @discussion Positions, in the list after the change, of the peripherals whose RSSI or advertisement data changed
+ *
+ */
+@property (nonatomic, readonly) NSIndexSet *updatedIndexes;
+
+@end
+
+/*!
+ *  @class ScanRegistry
+ *
+ *  @discussion Peripherals found while scanning, keyed by identifier. Every advertisement updates its peripheral in
+ *  place in constant time; the changes are collected and published as one diff per publish interval, so the device
+ *  list is redrawn at a fixed rate however many peripherals advertise. Peripherals not heard from for staleInterval
+ *  are removed. Used on the main queue only.
+ *
+ */
+@interface ScanRegistry : NSObject
+
+/*!
+ *  @property devices
+ *
+ *  @discussion CBPeripheralExt of every published peripheral, in the order they were found. Changes only when a diff
+ *  is published.
+ *
+ */
+@property (nonatomic, readonly) NSArray *devices;
+
+/*!
+ *  @property staleInterval
+ *
+ *  @discussion Time without advertisements after which a peripheral is removed, 0 to keep every peripheral
+ *
+ */
+@property (nonatomic) NSTimeInterval staleInterval;
+
+/*!
+ *  @property minimumUpdateInterval
+ *
+ *  @discussion Shortest time between two advertisements of a peripheral that are applied. Advertisements received
+ *  sooner only mark the peripheral as seen. 0 applies every advertisement.
+ *
+ */
+@property (nonatomic) NSTimeInterval minimumUpdateInterval;
+
+/*!
+ *  @property publishHandler
+ *
+ *  @discussion Invoked with every diff published
+ *
+ */
+@property (nonatomic, copy) void (^publishHandler)(ScanRegistryDiff *diff);
+
+/*!
+ *  @method initWithPublishInterval:
+ *
+ *  @discussion Creates a registry that publishes at most once per interval while publishing is started
+ *
+ */
+-(instancetype)initWithPublishInterval:(NSTimeInterval)interval;
+
+/*!
+ *  @method updateWithPeripheral:identifier:advertisementData:RSSI:time:
+ *
+ *  @discussion Records an advertisement. Advertisement data is merged into what the peripheral advertised before, so
+ *  that scan responses add to it. time is on the CACurrentMediaTime clock.
+ *
+ */
+-(void)updateWithPeripheral:(CBPeripheral *)peripheral identifier:(NSUUID *)identifier advertisementData:(NSDictionary *)advertisementData RSSI:(NSNumber *)RSSI time:(NSTimeInterval)time;
+
+/*!
+ *  @method deviceWithIdentifier:
+ *
+ *  @discussion Returns the peripheral of the identifier, published or not, nil if it was not found
+ *
+ */
+-(CBPeripheralExt *)deviceWithIdentifier:(NSUUID *)identifier;
+
+/*!
+ *  @method publishChangesAtTime:
+ *
+ *  @discussion Removes the stale peripherals and publishes the changes collected since the last diff. Returns the
+ *  diff, nil if nothing changed.
+ *
+ */
+-(ScanRegistryDiff *)publishChangesAtTime:(NSTimeInterval)time;
+
+/*!
+ *  @method startPublishingAtTime:
+ *
+ *  @discussion Publishes the changes once per publish interval until stopPublishingAtTime:. The time spent stopped
+ *  does not count toward the staleness of the peripherals, so that pausing the scan does not remove them.
+ *
+ */
+-(void)startPublishingAtTime:(NSTimeInterval)time;
+
+/*!
+ *  @method stopPublishingAtTime:
+ *
+ *  @discussion Stops the periodic publication
+ *
+ */
+-(void)stopPublishingAtTime:(NSTimeInterval)time;
+
+/*!
+ *  @method removeAllDevices
+ *
+ *  @discussion Removes every peripheral and publishes their removal at once
+ *
+ */
+-(void)removeAllDevices;
+
+@end
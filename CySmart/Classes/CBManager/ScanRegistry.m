@@ -0,0 +1,306 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import "ScanRegistry.h"
+#import <QuartzCore/QuartzCore.h>
+
+// Weight of a new reading in the moving average of the RSSI
+#define SCAN_RSSI_SMOOTHING     0.25
+
+@interface ScanRegistryDiff ()
+
+@property (nonatomic, readwrite) NSIndexSet *removedIndexes;
+@property (nonatomic, readwrite) NSIndexSet *insertedIndexes;
+@property (nonatomic, readwrite) NSIndexSet *updatedIndexes;
+
+@end
+
+@implementation ScanRegistryDiff
+
+@end
+
+/*!
+ *  @class ScanRegistry
+ *
+ *  @discussion Collects the peripherals found while scanning and publishes their changes
+ *
+ */
+@interface ScanRegistry ()
+{
+    NSTimeInterval publishInterval;
+    NSMutableDictionary *devicesByIdentifier;   // Every peripheral, published or not
+    NSArray *publishedDevices;
+    NSMutableArray *pendingDevices;             // Found since the last diff
+    NSMutableSet *updatedDevices;               // Published peripherals changed since the last diff
+    NSTimer *publishTimer;
+    NSTimeInterval stoppedTime;                 // When publishing stopped, negative if it never started
+}
+
+@end
+
+@implementation ScanRegistry
+
+@synthesize staleInterval;
+@synthesize minimumUpdateInterval;
+@synthesize publishHandler;
+
+-(instancetype)initWithPublishInterval:(NSTimeInterval)interval {
+    if (self = [super init])
+    {
+        publishInterval = interval;
+        staleInterval = SCAN_STALE_INTERVAL;
+        devicesByIdentifier = [NSMutableDictionary dictionary];
+        publishedDevices = [NSArray array];
+        pendingDevices = [NSMutableArray array];
+        updatedDevices = [NSMutableSet set];
+        stoppedTime = -1;
+    }
+    return self;
+}
+
+-(void)dealloc {
+    [publishTimer invalidate];
+}
+
+-(NSArray *)devices {
+    return publishedDevices;
+}
+
+-(CBPeripheralExt *)deviceWithIdentifier:(NSUUID *)identifier {
+    return [devicesByIdentifier objectForKey:identifier];
+}
+
+/*!
+ *  @method updateRSSIOfDevice:withValue:
+ *
+ *  @discussion Adds a reading to the moving average. Returns YES if the value shown, in whole dBm, changed.
+ *
+ */
+-(BOOL)updateRSSIOfDevice:(CBPeripheralExt *)device withValue:(NSNumber *)RSSI {
+    if (RSSI == nil)
+    {
+        return NO;
+    }
+    device.mRSSI = RSSI;
+    
+    double value = RSSI.doubleValue;
+    if (value >= RSSI_UNDEFINED_VALUE)
+    {
+        return NO;
+    }
+    long shown = lround(device.smoothedRSSI);
+    if (device.smoothedRSSI >= RSSI_UNDEFINED_VALUE)
+    {
+        device.smoothedRSSI = value;
+    }
+    else
+    {
+        device.smoothedRSSI += SCAN_RSSI_SMOOTHING * (value - device.smoothedRSSI);
+    }
+    return lround(device.smoothedRSSI) != shown;
+}
+
+/*!
+ *  @method advertisementData:mergedWith:
+ *
+ *  @discussion Returns the current advertisement data with the received entries added, nil if they add nothing new
+ *
+ */
+-(NSDictionary *)advertisementData:(NSDictionary *)current mergedWith:(NSDictionary *)received {
+    __block NSMutableDictionary *merged = nil;
+    [received enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+        if (![[current objectForKey:key] isEqual:value])
+        {
+            if (merged == nil)
+            {
+                merged = current ? [current mutableCopy] : [NSMutableDictionary dictionary];
+            }
+            [merged setObject:value forKey:key];
+        }
+    }];
+    return merged;
+}
+
+-(void)updateWithPeripheral:(CBPeripheral *)peripheral identifier:(NSUUID *)identifier advertisementData:(NSDictionary *)advertisementData RSSI:(NSNumber *)RSSI time:(NSTimeInterval)time {
+    CBPeripheralExt *device = [devicesByIdentifier objectForKey:identifier];
+    if (device == nil)
+    {
+        device = [[CBPeripheralExt alloc] init];
+        device.identifier = identifier;
+        device.mPeripheral = peripheral;
+        device.mAdvertisementData = [advertisementData copy];
+        device.lastSeenTime = time;
+        device.lastUpdateTime = time;
+        [self updateRSSIOfDevice:device withValue:RSSI];
+        [devicesByIdentifier setObject:device forKey:identifier];
+        [pendingDevices addObject:device];
+        return;
+    }
+    
+    device.lastSeenTime = time;
+    if (time - device.lastUpdateTime < minimumUpdateInterval)
+    {
+        return;
+    }
+    device.lastUpdateTime = time;
+    if (peripheral != nil)
+    {
+        device.mPeripheral = peripheral;
+    }
+    BOOL changed = [self updateRSSIOfDevice:device withValue:RSSI];
+    NSDictionary *merged = [self advertisementData:device.mAdvertisementData mergedWith:advertisementData];
+    if (merged != nil)
+    {
+        device.mAdvertisementData = merged;
+        changed = YES;
+    }
+    
+    // Peripherals not published yet are shown as they are when they are inserted
+    if (changed && device.scanIndex != NSNotFound)
+    {
+        [updatedDevices addObject:device];
+    }
+}
+
+-(ScanRegistryDiff *)publishChangesAtTime:(NSTimeInterval)time {
+    NSMutableIndexSet *removed = [NSMutableIndexSet indexSet];
+    for (CBPeripheralExt *device in publishedDevices)
+    {
+        if (staleInterval > 0 && time - device.lastSeenTime > staleInterval)
+        {
+            [removed addIndex:device.scanIndex];
+        }
+    }
+    if (removed.count == 0 && pendingDevices.count == 0 && updatedDevices.count == 0)
+    {
+        return nil;
+    }
+    
+    NSMutableArray *devices = [NSMutableArray arrayWithCapacity:publishedDevices.count - removed.count + pendingDevices.count];
+    for (CBPeripheralExt *device in publishedDevices)
+    {
+        if ([removed containsIndex:device.scanIndex])
+        {
+            [devicesByIdentifier removeObjectForKey:device.identifier];
+            [updatedDevices removeObject:device];
+            device.scanIndex = NSNotFound;
+            continue;
+        }
+        device.scanIndex = devices.count;
+        [devices addObject:device];
+    }
+    
+    NSMutableIndexSet *inserted = [NSMutableIndexSet indexSet];
+    for (CBPeripheralExt *device in pendingDevices)
+    {
+        device.scanIndex = devices.count;
+        [inserted addIndex:devices.count];
+        [devices addObject:device];
+    }
+    
+    NSMutableIndexSet *updated = [NSMutableIndexSet indexSet];
+    for (CBPeripheralExt *device in updatedDevices)
+    {
+        [updated addIndex:device.scanIndex];
+    }
+    
+    [pendingDevices removeAllObjects];
+    [updatedDevices removeAllObjects];
+    publishedDevices = devices;
+    
+    ScanRegistryDiff *diff = [[ScanRegistryDiff alloc] init];
+    diff.removedIndexes = removed;
+    diff.insertedIndexes = inserted;
+    diff.updatedIndexes = updated;
+    if (publishHandler)
+    {
+        publishHandler(diff);
+    }
+    return diff;
+}
+
+-(void)startPublishingAtTime:(NSTimeInterval)time {
+    if (stoppedTime >= 0 && time > stoppedTime)
+    {
+        NSTimeInterval paused = time - stoppedTime;
+        for (CBPeripheralExt *device in devicesByIdentifier.allValues)
+        {
+            device.lastSeenTime += paused;
+        }
+    }
+    stoppedTime = -1;
+    if (publishTimer == nil)
+    {
+        // Common modes keep the list updating while it is scrolled
+        publishTimer = [NSTimer timerWithTimeInterval:publishInterval target:self selector:@selector(publishTimerFired:) userInfo:nil repeats:YES];
+        [[NSRunLoop mainRunLoop] addTimer:publishTimer forMode:NSRunLoopCommonModes];
+    }
+}
+
+-(void)publishTimerFired:(NSTimer *)timer {
+    [self publishChangesAtTime:CACurrentMediaTime()];
+}
+
+-(void)stopPublishingAtTime:(NSTimeInterval)time {
+    [publishTimer invalidate];
+    publishTimer = nil;
+    if (stoppedTime < 0)
+    {
+        stoppedTime = time;
+    }
+}
+
+-(void)removeAllDevices {
+    NSIndexSet *removed = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, publishedDevices.count)];
+    for (CBPeripheralExt *device in publishedDevices)
+    {
+        device.scanIndex = NSNotFound;
+    }
+    [devicesByIdentifier removeAllObjects];
+    [pendingDevices removeAllObjects];
+    [updatedDevices removeAllObjects];
+    publishedDevices = [NSArray array];
+    
+    if (removed.count > 0)
+    {
+        ScanRegistryDiff *diff = [[ScanRegistryDiff alloc] init];
+        diff.removedIndexes = removed;
+        diff.insertedIndexes = [NSIndexSet indexSet];
+        diff.updatedIndexes = [NSIndexSet indexSet];
+        if (publishHandler)
+        {
+            publishHandler(diff);
+        }
+    }
+}
+
+@end
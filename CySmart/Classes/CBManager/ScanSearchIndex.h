@@ -0,0 +1,164 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import <CoreBluetooth/CoreBluetooth.h>
+#import "ScanRegistry.h"
+
+/*!
+ *  @class ScanFilter
+ *
+ *  @discussion Criteria of a scan list search, or of the peripherals a scan policy admits. A peripheral matches when
+ *  it passes every criterion that is set.
+ *
+ */
+@interface ScanFilter : NSObject <NSCopying>
+
+/*!
+ *  @property nameText
+ *
+ *  @discussion Text looked for in the name shown for the peripheral, ignoring case and diacritics
+ *
+ */
+@property (nonatomic, copy) NSString *nameText;
+
+/*!
+ *  @property matchesNamePrefix
+ *
+ *  @discussion YES if the name must start with nameText, NO if it may contain it anywhere
+ *
+ */
+@property (nonatomic) BOOL matchesNamePrefix;
+
+/*!
+ *  @property serviceUUIDs
+ *
+ *  @discussion CBUUIDs of which the peripheral must advertise at least one
+ *
+ */
+@property (nonatomic, copy) NSArray *serviceUUIDs;
+
+/*!
+ *  @property manufacturerDataPrefix
+ *
+ *  @discussion Bytes the advertised manufacturer data must start with, e.g. the company identifier
+ *
+ */
+@property (nonatomic, copy) NSData *manufacturerDataPrefix;
+
+/*!
+ *  @property minimumRSSI
+ *
+ *  @discussion Lowest smoothed RSSI in dBm
+ *
+ */
+@property (nonatomic, strong) NSNumber *minimumRSSI;
+
+/*!
+ *  @property foldedNameText
+ *
+ *  @discussion nameText trimmed and folded the way names are compared
+ *
+ */
+@property (nonatomic, readonly) NSString *foldedNameText;
+
+/*!
+ *  @method foldName:
+ *
+ *  @discussion Returns the name folded for comparison: without case and diacritics
+ *
+ */
++(NSString *)foldName:(NSString *)name;
+
+/*!
+ *  @method matchesFoldedName:advertisementData:RSSI:
+ *
+ *  @discussion Applies every criterion to a peripheral. foldedName is only needed when nameText is set; RSSI is in
+ *  dBm, RSSI_UNDEFINED_VALUE if unknown.
+ *
+ */
+-(BOOL)matchesFoldedName:(NSString *)foldedName advertisementData:(NSDictionary *)advertisementData RSSI:(double)RSSI;
+
+@end
+
+/*!
+ *  @class ScanSearchIndex
+ *
+ *  @discussion Search over the peripherals of a scan registry. Names are folded once per peripheral and cached. A
+ *  filter that narrows the previous one, as typing more of a name does, is applied to the previous matches only, and
+ *  diffs of the registry update the matches without searching again. Used on the main queue only.
+ *
+ */
+@interface ScanSearchIndex : NSObject
+
+/*!
+ *  @property filter
+ *
+ *  @discussion Current criteria; nil matches every peripheral
+ *
+ */
+@property (nonatomic, copy) ScanFilter *filter;
+
+/*!
+ *  @property matchingIndexes
+ *
+ *  @discussion Positions in the device list of the registry of the peripherals that match the filter
+ *
+ */
+@property (nonatomic, readonly) NSIndexSet *matchingIndexes;
+
+/*!
+ *  @method initWithRegistry:
+ *
+ *  @discussion Creates an index over the published peripherals of the registry
+ *
+ */
+-(instancetype)initWithRegistry:(ScanRegistry *)registry;
+
+/*!
+ *  @method matchingDevices
+ *
+ *  @discussion Returns the CBPeripheralExt that match the filter, in the order of the device list
+ *
+ */
+-(NSArray *)matchingDevices;
+
+/*!
+ *  @method applyDiff:
+ *
+ *  @discussion Brings the matches up to date with a diff published by the registry. Every diff must be applied, in
+ *  order.
+ *
+ */
+-(void)applyDiff:(ScanRegistryDiff *)diff;
+
+@end
@@ -0,0 +1,268 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import "ScanSearchIndex.h"
+
+@implementation ScanFilter
+
+@synthesize nameText;
+@synthesize matchesNamePrefix;
+@synthesize serviceUUIDs;
+@synthesize manufacturerDataPrefix;
+@synthesize minimumRSSI;
+@synthesize foldedNameText;
+
++(NSString *)foldName:(NSString *)name {
+    return [name stringByFoldingWithOptions:NSCaseInsensitiveSearch | NSDiacriticInsensitiveSearch locale:nil];
+}
+
++(BOOL)data:(NSData *)data hasPrefix:(NSData *)prefix {
+    return data.length >= prefix.length && memcmp(data.bytes, prefix.bytes, prefix.length) == 0;
+}
+
+-(void)setNameText:(NSString *)text {
+    nameText = [text copy];
+    NSString *trimmed = [text stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+    foldedNameText = trimmed ? [ScanFilter foldName:trimmed] : nil;
+}
+
+-(BOOL)matchesFoldedName:(NSString *)foldedName advertisementData:(NSDictionary *)advertisementData RSSI:(double)RSSI {
+    if (foldedNameText.length > 0)
+    {
+        BOOL found = matchesNamePrefix ? [foldedName hasPrefix:foldedNameText] : [foldedName rangeOfString:foldedNameText options:NSLiteralSearch].location != NSNotFound;
+        if (!found)
+        {
+            return NO;
+        }
+    }
+    
+    if (minimumRSSI && (RSSI >= RSSI_UNDEFINED_VALUE || RSSI < minimumRSSI.doubleValue))
+    {
+        return NO;
+    }
+    
+    if (serviceUUIDs.count > 0)
+    {
+        NSArray *advertisedUUIDs = [advertisementData objectForKey:CBAdvertisementDataServiceUUIDsKey];
+        BOOL found = NO;
+        for (CBUUID *UUID in serviceUUIDs)
+        {
+            if ([advertisedUUIDs containsObject:UUID])
+            {
+                found = YES;
+                break;
+            }
+        }
+        if (!found)
+        {
+            return NO;
+        }
+    }
+    
+    if (manufacturerDataPrefix.length > 0
+        && ![ScanFilter data:[advertisementData objectForKey:CBAdvertisementDataManufacturerDataKey] hasPrefix:manufacturerDataPrefix])
+    {
+        return NO;
+    }
+    return YES;
+}
+
+-(id)copyWithZone:(NSZone *)zone {
+    ScanFilter *copy = [[ScanFilter allocWithZone:zone] init];
+    copy.nameText = nameText;
+    copy.matchesNamePrefix = matchesNamePrefix;
+    copy.serviceUUIDs = serviceUUIDs;
+    copy.manufacturerDataPrefix = manufacturerDataPrefix;
+    copy.minimumRSSI = minimumRSSI;
+    return copy;
+}
+
+@end
+
+/*!
+ *  @class ScanSearchIndex
+ *
+ *  @discussion Keeps the peripherals of the scan list that match a filter
+ *
+ */
+@interface ScanSearchIndex ()
+{
+    ScanRegistry *scanRegistry;
+    NSMapTable *foldedNames;                // CBPeripheralExt to its folded display name
+    NSMutableIndexSet *matches;
+}
+
+@end
+
+@implementation ScanSearchIndex
+
+@synthesize filter;
+
+-(instancetype)initWithRegistry:(ScanRegistry *)registry {
+    if (self = [super init])
+    {
+        scanRegistry = registry;
+        foldedNames = [NSMapTable weakToStrongObjectsMapTable];
+        matches = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(0, registry.devices.count)];
+    }
+    return self;
+}
+
+-(NSIndexSet *)matchingIndexes {
+    return [matches copy];
+}
+
+-(NSArray *)matchingDevices {
+    return [scanRegistry.devices objectsAtIndexes:matches];
+}
+
+/*!
+ *  @method foldedNameOfDevice:
+ *
+ *  @discussion Returns the display name of the peripheral folded for comparison, folding it only once
+ *
+ */
+-(NSString *)foldedNameOfDevice:(CBPeripheralExt *)device {
+    NSString *name = [foldedNames objectForKey:device];
+    if (name == nil)
+    {
+        name = [ScanFilter foldName:[device displayName]];
+        [foldedNames setObject:name forKey:device];
+    }
+    return name;
+}
+
+/*!
+ *  @method deviceMatches:
+ *
+ *  @discussion Applies every criterion of the filter to the peripheral
+ *
+ */
+-(BOOL)deviceMatches:(CBPeripheralExt *)device {
+    if (filter == nil)
+    {
+        return YES;
+    }
+    NSString *name = filter.foldedNameText.length > 0 ? [self foldedNameOfDevice:device] : nil;
+    return [filter matchesFoldedName:name advertisementData:device.mAdvertisementData RSSI:device.smoothedRSSI];
+}
+
+/*!
+ *  @method filterNarrows:
+ *
+ *  @discussion Returns YES if every peripheral that matches the new filter also matches the current one, so that
+ *  only the current matches need testing
+ *
+ */
+-(BOOL)filterNarrows:(ScanFilter *)newFilter {
+    if (filter == nil)
+    {
+        return YES;
+    }
+    if (newFilter == nil)
+    {
+        return NO;
+    }
+    
+    NSString *foldedText = filter.foldedNameText;
+    NSString *newText = newFilter.foldedNameText;
+    if (foldedText.length > 0)
+    {
+        // A name containing the new text contains any part of it; a name starting with it starts with its prefixes
+        if (filter.matchesNamePrefix && (!newFilter.matchesNamePrefix || ![newText hasPrefix:foldedText]))
+        {
+            return NO;
+        }
+        if (!filter.matchesNamePrefix && [newText rangeOfString:foldedText options:NSLiteralSearch].location == NSNotFound)
+        {
+            return NO;
+        }
+    }
+    if (filter.minimumRSSI && (!newFilter.minimumRSSI || newFilter.minimumRSSI.doubleValue < filter.minimumRSSI.doubleValue))
+    {
+        return NO;
+    }
+    if (filter.serviceUUIDs.count > 0
+        && (newFilter.serviceUUIDs.count == 0 || ![[NSSet setWithArray:newFilter.serviceUUIDs] isSubsetOfSet:[NSSet setWithArray:filter.serviceUUIDs]]))
+    {
+        return NO;
+    }
+    if (filter.manufacturerDataPrefix.length > 0 && ![ScanFilter data:newFilter.manufacturerDataPrefix hasPrefix:filter.manufacturerDataPrefix])
+    {
+        return NO;
+    }
+    return YES;
+}
+
+-(void)setFilter:(ScanFilter *)newFilter {
+    ScanFilter *copy = [newFilter copy];
+    BOOL narrows = [self filterNarrows:copy];
+    filter = copy;
+    
+    NSArray *devices = scanRegistry.devices;
+    NSIndexSet *candidates = narrows ? matches : [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, devices.count)];
+    matches = [[candidates indexesPassingTest:^BOOL(NSUInteger index, BOOL *stop) {
+        return [self deviceMatches:[devices objectAtIndex:index]];
+    }] mutableCopy];
+}
+
+-(void)applyDiff:(ScanRegistryDiff *)diff {
+    NSArray *devices = scanRegistry.devices;
+    
+    // Removed positions refer to the list before the diff; dropping them from the last one keeps the others valid
+    [diff.removedIndexes enumerateIndexesWithOptions:NSEnumerationReverse usingBlock:^(NSUInteger index, BOOL *stop) {
+        [matches shiftIndexesStartingAtIndex:index + 1 by:-1];
+    }];
+    [diff.insertedIndexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        [matches shiftIndexesStartingAtIndex:index by:1];
+        if ([self deviceMatches:[devices objectAtIndex:index]])
+        {
+            [matches addIndex:index];
+        }
+    }];
+    [diff.updatedIndexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        CBPeripheralExt *device = [devices objectAtIndex:index];
+        
+        // The advertised name may have changed
+        [foldedNames removeObjectForKey:device];
+        if ([self deviceMatches:device])
+        {
+            [matches addIndex:index];
+        }
+        else
+        {
+            [matches removeIndex:index];
+        }
+    }];
+}
+
+@end
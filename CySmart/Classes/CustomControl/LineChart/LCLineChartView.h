@@ -18,6 +18,7 @@
 @class LCLineChartData;
 
 typedef LCLineChartDataItem *(^LCLineChartDataGetter)(NSUInteger item);
+typedef NSUInteger(^LCLineChartDecimatedDataGetter)(double xMin, double xMax, NSUInteger columns, CGPoint *points);
 typedef void(^LCLineChartSelectedItem)(LCLineChartData * data, NSUInteger item, CGPoint positionInChart);
 typedef void(^LCLineChartDeselectedItem)();
 
@@ -46,6 +47,10 @@ typedef void(^LCLineChartDeselectedItem)();
 @property double xMax;
 
 @property (copy) LCLineChartDataGetter getData;
+/// Optional. Fills points, which has room for 2 * columns, with x/y values that draw like every item in [xMin, xMax)
+/// split into columns, and returns their number. Used instead of getData to draw, so the cost of a frame depends on
+/// the width of the chart and not on itemCount.
+@property (copy) LCLineChartDecimatedDataGetter getDecimatedData;
 
 @end
 
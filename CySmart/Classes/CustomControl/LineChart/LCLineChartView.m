@@ -73,6 +73,8 @@
 @property LCLineChartData *selectedData;
 @property NSUInteger selectedIdx;
 
+@property NSMutableData *pointBuffer; // CGPoints of the data being drawn
+
 @end
 
 
@@ -308,19 +310,24 @@
     CGFloat yRangeLen = self.yMax - self.yMin;
     if(yRangeLen == 0) yRangeLen = 1;
     for(LCLineChartData *data in self.data) {
+        double xRangeLen = data.xMax - data.xMin;
+        if(xRangeLen == 0) xRangeLen = 1;
+        NSUInteger pointCount = 0;
+        CGPoint *points = [self pointsOfData:data inWidth:availableWidth count:&pointCount];
+        for(NSUInteger i = 0; i < pointCount; ++i) {
+            points[i].x = xStart + round(((points[i].x - data.xMin) / xRangeLen) * availableWidth);
+            points[i].y = yStart + round((1.0 - (points[i].y - self.yMin) / yRangeLen) * availableHeight);
+        }
+
         if (self.drawsDataLines) {
-            double xRangeLen = data.xMax - data.xMin;
-            if(xRangeLen == 0) xRangeLen = 1;
-            if(data.itemCount >= 2) {
-                LCLineChartDataItem *datItem = data.getData(0);
+            if(pointCount >= 2) {
                 CGMutablePathRef path = CGPathCreateMutable();
-                CGFloat prevX = xStart + round(((datItem.x - data.xMin) / xRangeLen) * availableWidth);
-                CGFloat prevY = yStart + round((1.0 - (datItem.y - self.yMin) / yRangeLen) * availableHeight);
+                CGFloat prevX = points[0].x;
+                CGFloat prevY = points[0].y;
                 CGPathMoveToPoint(path, NULL, prevX, prevY);
-                for(NSUInteger i = 1; i < data.itemCount; ++i) {
-                    LCLineChartDataItem *datItem = data.getData(i);
-                    CGFloat x = xStart + round(((datItem.x - data.xMin) / xRangeLen) * availableWidth);
-                    CGFloat y = yStart + round((1.0 - (datItem.y - self.yMin) / yRangeLen) * availableHeight);
+                for(NSUInteger i = 1; i < pointCount; ++i) {
+                    CGFloat x = points[i].x;
+                    CGFloat y = points[i].y;
                     CGFloat xDiff = x - prevX;
                     CGFloat yDiff = y - prevY;
 
@@ -355,15 +362,12 @@
                 CGPathRelease(path);
             }
         } // draw actual chart data
-        if (self.drawsDataPoints) {
+        // Points are only marked while every item is drawn
+        if (self.drawsDataPoints && pointCount == data.itemCount) {
           if (data.drawsDataPoints) {
-            double xRangeLen = data.xMax - data.xMin;
-             
-            if(xRangeLen == 0) xRangeLen = 1;
-            for(NSUInteger i = 0; i < data.itemCount; ++i) {
-                LCLineChartDataItem *datItem = data.getData(i);
-                CGFloat xVal = xStart + round((xRangeLen == 0 ? 0.5 : ((datItem.x - data.xMin) / xRangeLen)) * availableWidth);
-                CGFloat yVal = yStart + round((1.0 - (datItem.y - self.yMin) / yRangeLen) * availableHeight);
+            for(NSUInteger i = 0; i < pointCount; ++i) {
+                CGFloat xVal = points[i].x;
+                CGFloat yVal = points[i].y;
                 [self.backgroundColor setFill];
                 CGContextFillEllipseInRect(c, CGRectMake(xVal - 5.5, yVal - 5.5, 11, 11));
                 [data.color setFill];
@@ -509,6 +513,32 @@
 
 #pragma mark Helper methods
 
+/// x/y values of the data to draw in the width, at most two per point of width when the data can be decimated.
+/// The buffer returned is reused by the next call.
+- (CGPoint *)pointsOfData:(LCLineChartData *)data inWidth:(CGFloat)width count:(NSUInteger *)count {
+    NSUInteger columns = MAX(1, (NSUInteger)ceil(width));
+    NSUInteger capacity = data.getDecimatedData ? 2 * columns : data.itemCount;
+    if(self.pointBuffer == nil) {
+        self.pointBuffer = [NSMutableData data];
+    }
+    if(self.pointBuffer.length < capacity * sizeof(CGPoint)) {
+        self.pointBuffer.length = capacity * sizeof(CGPoint);
+    }
+    CGPoint *points = self.pointBuffer.mutableBytes;
+
+    if(data.getDecimatedData) {
+        // The range is closed at xMax, so that the newest item is drawn
+        *count = MIN(capacity, data.getDecimatedData(data.xMin, nextafter(data.xMax, INFINITY), columns, points));
+        return points;
+    }
+    for(NSUInteger i = 0; i < data.itemCount; ++i) {
+        LCLineChartDataItem *datItem = data.getData(i);
+        points[i] = CGPointMake(datItem.x, datItem.y);
+    }
+    *count = data.itemCount;
+    return points;
+}
+
 - (BOOL)drawsAnyData {
     return self.drawsDataPoints || self.drawsDataLines;
 }
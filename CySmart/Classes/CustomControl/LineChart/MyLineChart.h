@@ -33,6 +33,7 @@
 #import <UIKit/UIKit.h>
 #import "LineChart.h"
 #import "KLCPopup.h"
+#import "TimeSeries.h"
 
 
 @protocol lineChartDelegate <NSObject>
@@ -94,13 +95,14 @@
 -(void) addXLabel:(NSString *)xLabelText yLabel:(NSString *)yLabelText;
 
 /*!
- *  @method updateLineGraph: Y:
+ *  @method updateLineGraphWithSeries:
  *
- *  @discussion Method to update the values in the graph
+ *  @discussion Method to update the values in the graph. The samples are read from the series when the graph is
+ *  drawn; no copy is made.
  *
  */
 
--(void) updateLineGraph:(NSMutableArray *)xValues Y:(NSMutableArray *)yValues;
+-(void) updateLineGraphWithSeries:(TimeSeries *)series;
 
 /*!
  *  @method setXaxisScaleWithValue
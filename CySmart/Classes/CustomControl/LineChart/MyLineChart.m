@@ -34,6 +34,7 @@
 #import "Constants.h"
 
 #define Y_AXIS_POINT_COUNT      10
+#define MAX_GRAPH_WIDTH_MULTIPLIER  20   // Widest graph, in screen widths; longer series are decimated to fit
 #define AXIS_LABEL_WIDTH        90
 #define AXIS_LABEL_HEIGHT       20
 #define GRAPH_TITLE_WIDTH       150
@@ -63,6 +64,8 @@
     UIScrollView *bgScrollView;
     BOOL isPauseState;
     UILabel *xLabel, *yLabel;
+    float sampleScale;
+    NSMutableData *decimatedPoints;
 }
 
 @end
@@ -146,6 +149,8 @@
     _chartView.yMin = 0;
     _chartView.yMax = -100;
     _chartView.xAxisScaleValue = 1.0;
+    sampleScale = 1.0;
+    decimatedPoints = [NSMutableData data];
     _chartView.axisLabelColor = [UIColor blueColor];
 
     xLabel = [[UILabel alloc] initWithFrame:CGRectMake(bounds.size.width-AXIS_LABEL_WIDTH,bounds.size.height-PAUSE_BUTTON_HEIGHT- AXIS_LABEL_HEIGHT, AXIS_LABEL_WIDTH, AXIS_LABEL_HEIGHT)];
@@ -208,65 +213,87 @@
  */
 -(void) setXaxisScaleWithValue:(float)scale
 {
-    _chartView.xAxisScaleValue = scale;
+    sampleScale = scale;
+    LCLineChartData *data = [_chartView.data firstObject];
+    _chartView.xAxisScaleValue = scale * [self samplesPerStep:data.itemCount];
 }
 
 /*!
- *  @method updateLineGraph: Y:
+ *  @method samplesPerStep:
+ *
+ *  @discussion Number of samples between two x axis steps. One until the graph is as wide as it gets.
+ *
+ */
+-(NSUInteger) samplesPerStep:(NSUInteger)itemCount
+{
+    NSUInteger maximumSteps = Y_AXIS_POINT_COUNT * MAX_GRAPH_WIDTH_MULTIPLIER;
+    return MAX(1, (itemCount + maximumSteps - 1) / maximumSteps);
+}
+
+/*!
+ *  @method updateLineGraphWithSeries:
  *
  *  @discussion Method to update the values in the graph
  *
  */
 
--(void)updateLineGraph:(NSMutableArray *)xValues Y:(NSMutableArray *)yValues 
+-(void)updateLineGraphWithSeries:(TimeSeries *)series
 {
-    if(isPauseState)
+    NSUInteger itemCount = series.count;
+    if(isPauseState || itemCount == 0)
     {
         return;
     }
     LCLineChartData *dataTwo = [LCLineChartData new];
-    dataTwo.xMin = [[xValues objectAtIndex:0] floatValue];
-    dataTwo.xMax = [[xValues objectAtIndex:0] floatValue];
+    // Sample times never decrease, the oldest and newest sample bound the x range
+    dataTwo.xMin = [series timeAtIndex:0];
+    dataTwo.xMax = [series timeAtIndex:itemCount - 1];
     dataTwo.title = chartTitle;
     dataTwo.color = [UIColor darkGrayColor];
-    dataTwo.itemCount = [xValues count];
-    
-    for(NSString *axisVal in xValues)
-    {
-        if([axisVal floatValue] < dataTwo.xMin)
-        {
-            dataTwo.xMin = [axisVal floatValue];
-        }
-        if([axisVal floatValue] > dataTwo.xMax)
-        {
-            dataTwo.xMax = [axisVal floatValue];
-        }
-    }
+    dataTwo.itemCount = itemCount;
     
+    // Once samples are dropped the x axis starts at the oldest one left
+    _chartView.setXmin = series.droppedCount > 0;
     if (_chartView.setXmin) {
-        _chartView.xMin = [[xValues objectAtIndex:0] floatValue];
+        _chartView.xMin = dataTwo.xMin;
     }
     
+    // The series only grows up to its capacity, so the items stay in range as samples are appended
     dataTwo.getData = ^(NSUInteger item) {
-        float x = [xValues[item] floatValue];
-        float y = [yValues[item] floatValue];//powf(2, x / 7);
-        NSString *label1 = [NSString stringWithFormat:@"%@", xValues[item]];
-        NSString *label2 = [NSString stringWithFormat:@"%@", yValues[item]];
+        double x = [series timeAtIndex:item];
+        float y = [series valueAtIndex:item];
+        NSString *label1 = [NSString stringWithFormat:@"%@", @(x)];
+        NSString *label2 = [NSString stringWithFormat:@"%@", @(y)];
         return [LCLineChartDataItem dataItemWithX:x y:y xLabel:label1 dataLabel:label2];
     };
     
+    // Drawing reads the cached min/max summaries of the series, not every sample
+    NSMutableData *scratch = decimatedPoints;
+    dataTwo.getDecimatedData = ^NSUInteger(double xMin, double xMax, NSUInteger columns, CGPoint *points) {
+        if (scratch.length < 2 * columns * sizeof(time_series_point)) {
+            scratch.length = 2 * columns * sizeof(time_series_point);
+        }
+        time_series_point *samples = scratch.mutableBytes;
+        NSUInteger count = [series getDecimatedPoints:samples columns:columns fromTime:xMin toTime:xMax];
+        for (NSUInteger index = 0; index < count; index++) {
+            points[index] = CGPointMake(samples[index].time, samples[index].value);
+        }
+        return count;
+    };
+    
         
     // "Y" Axis Handling
     
-    for(NSString *axisVal in yValues)
+    float minimumValue, maximumValue;
+    if([series getMinimumValue:&minimumValue maximumValue:&maximumValue])
     {
-        if([axisVal floatValue] < _chartView.yMin)
+        if(minimumValue < _chartView.yMin)
         {
-            _chartView.yMin = [axisVal floatValue];
+            _chartView.yMin = minimumValue;
         }
-        if([axisVal floatValue] > _chartView.yMax)
+        if(maximumValue > _chartView.yMax)
         {
-            _chartView.yMax = [axisVal floatValue];
+            _chartView.yMax = maximumValue;
         }
     }
     
@@ -286,7 +313,7 @@
     {
         if (_chartView.yMax < 0)
         {
-            if (yValues.count == 1)
+            if (itemCount == 1)
             {
                 valDiff = -1 * _chartView.yMin;
             }
@@ -301,7 +328,7 @@
             float valDiff = _chartView.yMax  - _chartView.yMin ;
             valDiff = valDiff /( Y_AXIS_POINT_COUNT - 1);
 
-            if (yValues.count == 1)
+            if (itemCount == 1)
             {
                 valDiff = -1 * _chartView.yMin;
             }
@@ -315,9 +342,9 @@
    
     _chartView.ySteps = yAxisPlots;
     
-    if ([xValues count]>Y_AXIS_POINT_COUNT)
+    if (itemCount>Y_AXIS_POINT_COUNT)
     {
-        int widthCounter = (int) [xValues count]/Y_AXIS_POINT_COUNT ;
+        int widthCounter = (int) MIN(itemCount/Y_AXIS_POINT_COUNT, MAX_GRAPH_WIDTH_MULTIPLIER - 1);
         if(widthCounter > widthOffset)
         {
             widthOffset = widthCounter + 1 ;
@@ -332,7 +359,10 @@
         
     }
     _chartView.data =  @[dataTwo];
-    _chartView.xStepsCount = [xValues count];
+    // One step per sample would draw a label per sample, so the steps are spread once the graph stops widening
+    NSUInteger samplesPerStep = [self samplesPerStep:itemCount];
+    _chartView.xStepsCount = (itemCount + samplesPerStep - 1) / samplesPerStep;
+    _chartView.xAxisScaleValue = sampleScale * samplesPerStep;
 }
 
 /*!
@@ -70,7 +70,7 @@ enum alertOptions
 #define KEYBOARD_HEIGHT     305.0f
 #define STATUS_BAR_HEIGHT   20.0f
 #define NAV_BAR_HEIGHT      44.0f
-#define MAX_GRAPH_POINTS    200
+#define MAX_GRAPH_POINTS    14400   // Samples kept per live chart, 4 hours at one per second
 
 #define DEFAULT_SIZE_NORMALISATION_CONSTANT_FOR_IPAD     75.0f
 
@@ -250,8 +250,6 @@ enum alertOptions
 
 #define CHECKSUM_TYPE_SUMMATION     0
 #define CHECKSUM_TYPE_CRC           1
-#define CHECK_SUM                   @"checkSum"
-#define CRC_16                      @"crc_16"
 #define ROW_DATA                    @"rowData"
 #define ACTIVE_APP                  @"activeApp"
 #define SECURITY_KEY                @"securityKey"
@@ -35,14 +35,6 @@
 
 @interface CoreDataHandler : NSObject
 
-/*!
- *  @method addLogEvent:date:
- *
- *  @discussion Write log event
- *
- */
--(void) addLogEvent:(NSString *)event date:(NSString *)date;
-
 /*!
  *  @method getLogEventsForDate:
  *
@@ -41,27 +41,12 @@
 /*!
  *  @class CoreDataHandler
  *
- *  @discussion Class that handles the operations related to coredata
+ *  @discussion Class that handles the operations related to coredata. Log events are stored in log segments now;
+ *  this class only reads and deletes the events of earlier versions.
  *
  */
 @implementation CoreDataHandler
 
-/*!
- *  @method addLogEvent:date:
- *
- *  @discussion Write log event
- *
- */
--(void) addLogEvent:(NSString *)event date:(NSString *)date {
-    AppDelegate *appDelegate= (AppDelegate *)[[UIApplication sharedApplication] delegate];
-    Logger *entity = [NSEntityDescription insertNewObjectForEntityForName:LOGGER_ENTITY inManagedObjectContext:appDelegate.managedObjectContext];
-    entity.date = date;
-    entity.event = event;
-    
-    NSError *error;
-    [appDelegate.managedObjectContext save:&error];
-}
-
 /*!
  *  @method getLogEventsForDate:
  *
@@ -0,0 +1,206 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#include "CyChecksum.h"
+
+#include <pthread.h>
+#include <string.h>
+
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#define CY_CRC32C_HW    1
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define CY_CRC32C_HW    1
+#endif
+
+#define CRC32C_POLYNOMIAL   0x82F63B78  // Reflected
+#define CRC16_POLYNOMIAL    0x8408      // Reflected CCITT
+
+static uint32_t crc32c_table[8][256];
+static uint16_t crc16_table[256];
+static pthread_once_t cy_checksum_once = PTHREAD_ONCE_INIT;
+
+static void cy_checksum_init_tables(void)
+{
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint32_t crc = i;
+        uint16_t crc16 = (uint16_t)i;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLYNOMIAL : crc >> 1;
+            crc16 = (crc16 & 1) ? (uint16_t)((crc16 >> 1) ^ CRC16_POLYNOMIAL) : (uint16_t)(crc16 >> 1);
+        }
+        crc32c_table[0][i] = crc;
+        crc16_table[i] = crc16;
+    }
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        for (int slice = 1; slice < 8; slice++)
+        {
+            uint32_t prev = crc32c_table[slice - 1][i];
+            crc32c_table[slice][i] = (prev >> 8) ^ crc32c_table[0][prev & 0xFF];
+        }
+    }
+}
+
+uint32_t cy_crc32c_sw(uint32_t crc, const void *data, size_t length)
+{
+    pthread_once(&cy_checksum_once, cy_checksum_init_tables);
+    
+    const uint8_t *p = (const uint8_t *)data;
+    crc = ~crc;
+    
+    // Bytes up to 8-byte alignment
+    while (length && ((uintptr_t)p & 7))
+    {
+        crc = (crc >> 8) ^ crc32c_table[0][(crc ^ *p++) & 0xFF];
+        length--;
+    }
+    
+    while (length >= 8)
+    {
+        uint32_t lo = crc ^ ((uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24));
+        uint32_t hi = (uint32_t)p[4] | ((uint32_t)p[5] << 8) | ((uint32_t)p[6] << 16) | ((uint32_t)p[7] << 24);
+        crc = crc32c_table[7][lo & 0xFF] ^
+              crc32c_table[6][(lo >> 8) & 0xFF] ^
+              crc32c_table[5][(lo >> 16) & 0xFF] ^
+              crc32c_table[4][lo >> 24] ^
+              crc32c_table[3][hi & 0xFF] ^
+              crc32c_table[2][(hi >> 8) & 0xFF] ^
+              crc32c_table[1][(hi >> 16) & 0xFF] ^
+              crc32c_table[0][hi >> 24];
+        p += 8;
+        length -= 8;
+    }
+    
+    while (length--)
+    {
+        crc = (crc >> 8) ^ crc32c_table[0][(crc ^ *p++) & 0xFF];
+    }
+    return ~crc;
+}
+
+#ifdef CY_CRC32C_HW
+static uint32_t cy_crc32c_hw(uint32_t crc, const void *data, size_t length)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    crc = ~crc;
+    
+    while (length && ((uintptr_t)p & 7))
+    {
+#if defined(__SSE4_2__)
+        crc = _mm_crc32_u8(crc, *p++);
+#else
+        crc = __crc32cb(crc, *p++);
+#endif
+        length--;
+    }
+    
+    while (length >= 8)
+    {
+        uint64_t word;
+        memcpy(&word, p, sizeof(word));
+#if defined(__SSE4_2__) && defined(__x86_64__)
+        crc = (uint32_t)_mm_crc32_u64(crc, word);
+#elif defined(__SSE4_2__)
+        crc = _mm_crc32_u32(crc, (uint32_t)word);
+        crc = _mm_crc32_u32(crc, (uint32_t)(word >> 32));
+#else
+        crc = __crc32cd(crc, word);
+#endif
+        p += 8;
+        length -= 8;
+    }
+    
+    while (length--)
+    {
+#if defined(__SSE4_2__)
+        crc = _mm_crc32_u8(crc, *p++);
+#else
+        crc = __crc32cb(crc, *p++);
+#endif
+    }
+    return ~crc;
+}
+#endif
+
+uint32_t cy_crc32c_update(uint32_t crc, const void *data, size_t length)
+{
+#ifdef CY_CRC32C_HW
+    return cy_crc32c_hw(crc, data, length);
+#else
+    return cy_crc32c_sw(crc, data, length);
+#endif
+}
+
+uint32_t cy_crc32c(const void *data, size_t length)
+{
+    return cy_crc32c_update(0, data, length);
+}
+
+uint16_t cy_crc16(const void *data, size_t length)
+{
+    pthread_once(&cy_checksum_once, cy_checksum_init_tables);
+    
+    const uint8_t *p = (const uint8_t *)data;
+    uint16_t crc = 0xFFFF;
+    while (length--)
+    {
+        crc = (uint16_t)((crc >> 8) ^ crc16_table[(crc ^ *p++) & 0xFF]);
+    }
+    crc = (uint16_t)~crc;
+    
+    // Bootloader expects the CRC byte swapped
+    return (uint16_t)((crc << 8) | (crc >> 8));
+}
+
+uint16_t cy_sum16(const void *data, size_t length)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    uint16_t sum = 0;
+    while (length--)
+    {
+        sum = (uint16_t)(sum + *p++);
+    }
+    return (uint16_t)(~sum + 1);
+}
+
+uint16_t cy_packet_checksum(cy_checksum_type type, const void *data, size_t length)
+{
+    if (CY_CHECKSUM_CRC16 == type)
+    {
+        return cy_crc16(data, length);
+    }
+    return cy_sum16(data, length);
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#ifndef CyChecksum_h
+#define CyChecksum_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ *  @discussion Checksum appended to the bootloader command packets. Values match the checksum type byte of the firmware file header.
+ *
+ */
+typedef enum
+{
+    CY_CHECKSUM_SUM = 0,        // 2's complement of the 16-bit sum of the bytes
+    CY_CHECKSUM_CRC16 = 1       // CRC-16-CCITT, reflected, byte swapped
+} cy_checksum_type;
+
+/*!
+ *  @function cy_crc32c
+ *
+ *  @discussion Computes CRC-32C (Castagnoli) of the bytes. Uses the CRC32 instructions of the target when the compiler
+ *  enables them (SSE4.2, ARMv8 CRC extension), slice-by-8 tables otherwise.
+ *
+ */
+uint32_t cy_crc32c(const void *data, size_t length);
+
+/*!
+ *  @function cy_crc32c_update
+ *
+ *  @discussion Continues CRC-32C computation over more bytes. Start with crc 0.
+ *
+ */
+uint32_t cy_crc32c_update(uint32_t crc, const void *data, size_t length);
+
+/*!
+ *  @function cy_crc32c_sw
+ *
+ *  @discussion Slice-by-8 software CRC-32C, regardless of the instructions available
+ *
+ */
+uint32_t cy_crc32c_sw(uint32_t crc, const void *data, size_t length);
+
+/*!
+ *  @function cy_crc16
+ *
+ *  @discussion Computes the bootloader CRC-16 of the bytes using a 256-entry table
+ *
+ */
+uint16_t cy_crc16(const void *data, size_t length);
+
+/*!
+ *  @function cy_sum16
+ *
+ *  @discussion Computes the bootloader sum checksum of the bytes
+ *
+ */
+uint16_t cy_sum16(const void *data, size_t length);
+
+/*!
+ *  @function cy_packet_checksum
+ *
+ *  @discussion Computes the checksum of a bootloader command packet
+ *
+ */
+uint16_t cy_packet_checksum(cy_checksum_type type, const void *data, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CyChecksum_h */
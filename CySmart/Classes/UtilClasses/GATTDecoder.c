@@ -0,0 +1,182 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#include "GATTDecoder.h"
+
+#include <math.h>
+#include <string.h>
+
+// Exactly representable powers of ten, the exponents of most medical values
+static const double powers_of_ten[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+
+/*!
+ *  @function scale_by_power_of_ten
+ *
+ *  @discussion mantissa * 10^exponent, without pow for the common exponents
+ *
+ */
+static float scale_by_power_of_ten(int32_t mantissa, int32_t exponent)
+{
+    if (exponent >= 0 && exponent < 16)
+    {
+        return (float)(mantissa * powers_of_ten[exponent]);
+    }
+    if (exponent < 0 && exponent > -16)
+    {
+        return (float)(mantissa / powers_of_ten[-exponent]);
+    }
+    return (float)(mantissa * pow(10, exponent));
+}
+
+float gatt_sfloat_value(uint16_t raw)
+{
+    int32_t mantissa = raw & 0x0FFF;
+    int32_t exponent = raw >> 12;
+    switch (mantissa)
+    {
+        case 0x07FE: if (exponent == 0) return INFINITY; break;
+        case 0x0802: if (exponent == 0) return -INFINITY; break;
+        case 0x07FF:
+        case 0x0800:
+        case 0x0801: if (exponent == 0) return NAN; break;
+    }
+    if (mantissa >= 0x0800)
+    {
+        mantissa -= 0x1000;
+    }
+    if (exponent >= 0x08)
+    {
+        exponent -= 0x10;
+    }
+    return scale_by_power_of_ten(mantissa, exponent);
+}
+
+float gatt_float_value(uint32_t raw)
+{
+    int32_t mantissa = raw & 0x00FFFFFF;
+    int32_t exponent = raw >> 24;
+    switch (mantissa)
+    {
+        case 0x007FFFFE: if (exponent == 0) return INFINITY; break;
+        case 0x00800002: if (exponent == 0) return -INFINITY; break;
+        case 0x007FFFFF:
+        case 0x00800000:
+        case 0x00800001: if (exponent == 0) return NAN; break;
+    }
+    if (mantissa >= 0x00800000)
+    {
+        mantissa -= 0x01000000;
+    }
+    if (exponent >= 0x80)
+    {
+        exponent -= 0x100;
+    }
+    return scale_by_power_of_ten(mantissa, exponent);
+}
+
+/*!
+ *  @function decode_list
+ *
+ *  @discussion Reads uint16 values up to the end of the value, keeping the first capacity of them
+ *
+ */
+static void decode_list(gatt_cursor *cursor, const gatt_field *field, uint8_t *result)
+{
+    uint32_t available = gatt_cursor_remaining(cursor) / 2;
+    uint32_t count = available < field->capacity ? available : field->capacity;
+    uint16_t *values = (uint16_t *)(result + field->offset);
+    for (uint32_t index = 0; index < available; index++)
+    {
+        uint16_t value = gatt_read_u16(cursor);
+        if (index < count)
+        {
+            values[index] = value;
+        }
+    }
+    memcpy(result + field->count_offset, &count, sizeof(count));
+}
+
+uint32_t gatt_decode(const gatt_layout *layout, const uint8_t *bytes, uint32_t length, void *result)
+{
+    uint8_t *output = result;
+    memset(output, 0, layout->result_size);
+    gatt_cursor cursor = gatt_cursor_make(bytes, length);
+    uint8_t flags = gatt_read_u8(&cursor);
+    uint32_t present = 0;
+
+    for (uint32_t index = 0; index < layout->field_count && !cursor.failed; index++)
+    {
+        const gatt_field *field = &layout->fields[index];
+        if ((flags & field->flags_mask) != field->flags_value)
+        {
+            continue;
+        }
+        void *target = output + field->offset;
+        switch (field->type)
+        {
+            case GATT_FIELD_U8:         *(uint32_t *)target = gatt_read_u8(&cursor); break;
+            case GATT_FIELD_U16:        *(uint32_t *)target = gatt_read_u16(&cursor); break;
+            case GATT_FIELD_U24:        *(uint32_t *)target = gatt_read_u24(&cursor); break;
+            case GATT_FIELD_U32:        *(uint32_t *)target = gatt_read_u32(&cursor); break;
+            case GATT_FIELD_S16:        *(int32_t *)target = (int16_t)gatt_read_u16(&cursor); break;
+            case GATT_FIELD_SFLOAT:     *(float *)target = gatt_read_sfloat(&cursor); break;
+            case GATT_FIELD_FLOAT:      *(float *)target = gatt_read_float(&cursor); break;
+            case GATT_FIELD_DATE_TIME:  *(gatt_date_time *)target = gatt_read_date_time(&cursor); break;
+            case GATT_FIELD_U16_LIST:   decode_list(&cursor, field, output); break;
+            default:                    cursor.failed = 1; break;
+        }
+        present |= 1u << index;
+    }
+
+    if (cursor.failed)
+    {
+        memset(output, 0, layout->result_size);
+        return 0;
+    }
+    gatt_result_header header = {present | GATT_DECODED, flags};
+    memcpy(output, &header, sizeof(header));
+    return cursor.offset;
+}
+
+uint32_t gatt_decode_batch(const gatt_layout *layout, const gatt_value *values, uint32_t count, void *results)
+{
+    uint8_t *output = results;
+    uint32_t decoded = 0;
+    for (uint32_t index = 0; index < count; index++, output += layout->result_size)
+    {
+        if (gatt_decode(layout, values[index].bytes, values[index].length, output) != 0)
+        {
+            decoded++;
+        }
+    }
+    return decoded;
+}
@@ -0,0 +1,288 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#ifndef GATTDecoder_h
+#define GATTDecoder_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma mark - Cursor
+
+/*!
+ *  @struct gatt_cursor
+ *
+ *  @discussion Reads little endian values from a characteristic value. A read past the end returns 0 and marks the
+ *  cursor failed; the offset does not move, so a sequence of reads can be checked once at its end.
+ *
+ */
+typedef struct
+{
+    const uint8_t *bytes;
+    uint32_t length;
+    uint32_t offset;
+    int failed;
+} gatt_cursor;
+
+/*!
+ *  @struct gatt_date_time
+ *
+ *  @discussion Date Time characteristic value, as in the time stamps of measurements
+ *
+ */
+typedef struct
+{
+    uint16_t year;
+    uint8_t month;
+    uint8_t day;
+    uint8_t hours;
+    uint8_t minutes;
+    uint8_t seconds;
+} gatt_date_time;
+
+static inline gatt_cursor gatt_cursor_make(const uint8_t *bytes, uint32_t length)
+{
+    gatt_cursor cursor = {bytes, length, 0, 0};
+    return cursor;
+}
+
+static inline uint32_t gatt_cursor_remaining(const gatt_cursor *cursor)
+{
+    return cursor->length - cursor->offset;
+}
+
+/*!
+ *  @function gatt_cursor_take
+ *
+ *  @discussion Returns the next count bytes and moves past them, NULL if fewer are left
+ *
+ */
+static inline const uint8_t *gatt_cursor_take(gatt_cursor *cursor, uint32_t count)
+{
+    if (cursor->failed || gatt_cursor_remaining(cursor) < count)
+    {
+        cursor->failed = 1;
+        return NULL;
+    }
+    const uint8_t *bytes = cursor->bytes + cursor->offset;
+    cursor->offset += count;
+    return bytes;
+}
+
+static inline uint8_t gatt_read_u8(gatt_cursor *cursor)
+{
+    const uint8_t *bytes = gatt_cursor_take(cursor, 1);
+    return bytes ? bytes[0] : 0;
+}
+
+static inline uint16_t gatt_read_u16(gatt_cursor *cursor)
+{
+    const uint8_t *bytes = gatt_cursor_take(cursor, 2);
+    return bytes ? (uint16_t)(bytes[0] | (bytes[1] << 8)) : 0;
+}
+
+static inline uint32_t gatt_read_u24(gatt_cursor *cursor)
+{
+    const uint8_t *bytes = gatt_cursor_take(cursor, 3);
+    return bytes ? (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) : 0;
+}
+
+static inline uint32_t gatt_read_u32(gatt_cursor *cursor)
+{
+    const uint8_t *bytes = gatt_cursor_take(cursor, 4);
+    return bytes ? (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24) : 0;
+}
+
+/*!
+ *  @function gatt_sfloat_value
+ *
+ *  @discussion Value of an IEEE 11073 16 bit SFLOAT: 4 bit exponent, 12 bit mantissa. NaN, NRes and the reserved
+ *  value are NAN, the infinities are INFINITY.
+ *
+ */
+float gatt_sfloat_value(uint16_t raw);
+
+/*!
+ *  @function gatt_float_value
+ *
+ *  @discussion Value of an IEEE 11073 32 bit FLOAT: 8 bit exponent, 24 bit mantissa, special values as SFLOAT
+ *
+ */
+float gatt_float_value(uint32_t raw);
+
+static inline float gatt_read_sfloat(gatt_cursor *cursor)
+{
+    return gatt_sfloat_value(gatt_read_u16(cursor));
+}
+
+static inline float gatt_read_float(gatt_cursor *cursor)
+{
+    return gatt_float_value(gatt_read_u32(cursor));
+}
+
+static inline gatt_date_time gatt_read_date_time(gatt_cursor *cursor)
+{
+    gatt_date_time date_time = {0, 0, 0, 0, 0, 0};
+    const uint8_t *bytes = gatt_cursor_take(cursor, 7);
+    if (bytes)
+    {
+        date_time.year = (uint16_t)(bytes[0] | (bytes[1] << 8));
+        date_time.month = bytes[2];
+        date_time.day = bytes[3];
+        date_time.hours = bytes[4];
+        date_time.minutes = bytes[5];
+        date_time.seconds = bytes[6];
+    }
+    return date_time;
+}
+
+#pragma mark - Layouts
+
+/*!
+ *  @discussion Encodings of the fields of a characteristic value, with the type they are decoded into
+ *
+ */
+typedef enum
+{
+    GATT_FIELD_U8 = 1,          // uint32_t
+    GATT_FIELD_U16,             // uint32_t
+    GATT_FIELD_U24,             // uint32_t
+    GATT_FIELD_U32,             // uint32_t
+    GATT_FIELD_S16,             // int32_t
+    GATT_FIELD_SFLOAT,          // float
+    GATT_FIELD_FLOAT,           // float
+    GATT_FIELD_DATE_TIME,       // gatt_date_time
+    GATT_FIELD_U16_LIST         // uint16_t[capacity] and a uint32_t count; takes the rest of the value
+} gatt_field_type;
+
+/*!
+ *  @struct gatt_field
+ *
+ *  @discussion One field of a characteristic value. The field is in the value when the flags, the first byte, masked
+ *  with flags_mask equal flags_value, so a field with a mask of 0 is always there. offset is where the decoded value
+ *  goes in the result. A list keeps its first capacity values and their number at count_offset; the values after
+ *  those are skipped.
+ *
+ */
+typedef struct
+{
+    uint8_t type;
+    uint8_t flags_mask;
+    uint8_t flags_value;
+    uint8_t capacity;
+    uint16_t offset;
+    uint16_t count_offset;
+} gatt_field;
+
+/*!
+ *  @struct gatt_layout
+ *
+ *  @discussion Fields of a characteristic value in the order they are encoded, after the flags; 31 at most. Results
+ *  start with a gatt_result_header.
+ *
+ */
+typedef struct
+{
+    const gatt_field *fields;
+    uint32_t field_count;
+    uint32_t result_size;
+} gatt_layout;
+
+/*!
+ *  @discussion Bit of gatt_result_header present set for every value decoded
+ *
+ */
+#define GATT_DECODED    (1u << 31)
+
+/*!
+ *  @struct gatt_result_header
+ *
+ *  @discussion Start of every result: the flags, and in present GATT_DECODED and a bit for every field in the value,
+ *  bit 0 for the first of the layout. present is 0 when the value could not be decoded.
+ *
+ */
+typedef struct
+{
+    uint32_t present;
+    uint32_t flags;
+} gatt_result_header;
+
+/*!
+ *  @struct gatt_value
+ *
+ *  @discussion Characteristic value to decode, one notification of a batch
+ *
+ */
+typedef struct
+{
+    const uint8_t *bytes;
+    uint32_t length;
+} gatt_value;
+
+#define GATT_FIELD(type, mask, value, result, member) \
+    {(type), (mask), (value), 0, (uint16_t)offsetof(result, member), 0}
+
+#define GATT_LIST_FIELD(mask, value, result, member, count) \
+    {GATT_FIELD_U16_LIST, (mask), (value), (uint8_t)(sizeof(((result *)0)->member) / sizeof(uint16_t)), \
+     (uint16_t)offsetof(result, member), (uint16_t)offsetof(result, count)}
+
+#define GATT_LAYOUT(fields, result) \
+    {(fields), sizeof(fields) / sizeof((fields)[0]), sizeof(result)}
+
+/*!
+ *  @function gatt_decode
+ *
+ *  @discussion Decodes the value into result, a structure of layout->result_size bytes that starts with a
+ *  gatt_result_header. Fields the flags leave out are 0. Returns the number of bytes decoded, 0 if the value is
+ *  shorter than its flags say, in which case the result is all 0. Bytes after the last field are ignored.
+ *
+ */
+uint32_t gatt_decode(const gatt_layout *layout, const uint8_t *bytes, uint32_t length, void *result);
+
+/*!
+ *  @function gatt_decode_batch
+ *
+ *  @discussion Decodes count values into the array of results, layout->result_size bytes apart. Returns the number of
+ *  values decoded; the present bits of the others are 0.
+ *
+ */
+uint32_t gatt_decode_batch(const gatt_layout *layout, const gatt_value *values, uint32_t count, void *results);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GATTDecoder_h */
@@ -0,0 +1,121 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#include "GATTMeasurements.h"
+
+#pragma mark - Heart Rate Measurement
+
+static const gatt_field heart_rate_fields[] = {
+    GATT_FIELD(GATT_FIELD_U8, GATT_HEART_RATE_16_BIT, 0, gatt_heart_rate_measurement, heart_rate),
+    GATT_FIELD(GATT_FIELD_U16, GATT_HEART_RATE_16_BIT, GATT_HEART_RATE_16_BIT, gatt_heart_rate_measurement, heart_rate),
+    GATT_FIELD(GATT_FIELD_U16, GATT_HEART_RATE_ENERGY_EXPENDED, GATT_HEART_RATE_ENERGY_EXPENDED, gatt_heart_rate_measurement, energy_expended),
+    GATT_LIST_FIELD(GATT_HEART_RATE_RR_INTERVALS, GATT_HEART_RATE_RR_INTERVALS, gatt_heart_rate_measurement, rr_intervals, rr_interval_count),
+};
+
+const gatt_layout gatt_heart_rate_measurement_layout = GATT_LAYOUT(heart_rate_fields, gatt_heart_rate_measurement);
+
+#pragma mark - CSC Measurement
+
+static const gatt_field csc_fields[] = {
+    GATT_FIELD(GATT_FIELD_U32, GATT_CSC_WHEEL_REVOLUTIONS, GATT_CSC_WHEEL_REVOLUTIONS, gatt_csc_measurement, wheel_revolutions),
+    GATT_FIELD(GATT_FIELD_U16, GATT_CSC_WHEEL_REVOLUTIONS, GATT_CSC_WHEEL_REVOLUTIONS, gatt_csc_measurement, last_wheel_event_time),
+    GATT_FIELD(GATT_FIELD_U16, GATT_CSC_CRANK_REVOLUTIONS, GATT_CSC_CRANK_REVOLUTIONS, gatt_csc_measurement, crank_revolutions),
+    GATT_FIELD(GATT_FIELD_U16, GATT_CSC_CRANK_REVOLUTIONS, GATT_CSC_CRANK_REVOLUTIONS, gatt_csc_measurement, last_crank_event_time),
+};
+
+const gatt_layout gatt_csc_measurement_layout = GATT_LAYOUT(csc_fields, gatt_csc_measurement);
+
+#pragma mark - RSC Measurement
+
+static const gatt_field rsc_fields[] = {
+    GATT_FIELD(GATT_FIELD_U16, 0, 0, gatt_rsc_measurement, speed),
+    GATT_FIELD(GATT_FIELD_U8, 0, 0, gatt_rsc_measurement, cadence),
+    GATT_FIELD(GATT_FIELD_U16, GATT_RSC_STRIDE_LENGTH, GATT_RSC_STRIDE_LENGTH, gatt_rsc_measurement, stride_length),
+    GATT_FIELD(GATT_FIELD_U32, GATT_RSC_TOTAL_DISTANCE, GATT_RSC_TOTAL_DISTANCE, gatt_rsc_measurement, total_distance),
+};
+
+const gatt_layout gatt_rsc_measurement_layout = GATT_LAYOUT(rsc_fields, gatt_rsc_measurement);
+
+#pragma mark - Temperature Measurement
+
+static const gatt_field temperature_fields[] = {
+    GATT_FIELD(GATT_FIELD_FLOAT, 0, 0, gatt_temperature_measurement, temperature),
+    GATT_FIELD(GATT_FIELD_DATE_TIME, GATT_TEMPERATURE_TIME_STAMP, GATT_TEMPERATURE_TIME_STAMP, gatt_temperature_measurement, time_stamp),
+    GATT_FIELD(GATT_FIELD_U8, GATT_TEMPERATURE_TYPE, GATT_TEMPERATURE_TYPE, gatt_temperature_measurement, temperature_type),
+};
+
+const gatt_layout gatt_temperature_measurement_layout = GATT_LAYOUT(temperature_fields, gatt_temperature_measurement);
+
+#pragma mark - Blood Pressure Measurement
+
+static const gatt_field blood_pressure_fields[] = {
+    GATT_FIELD(GATT_FIELD_SFLOAT, 0, 0, gatt_blood_pressure_measurement, systolic),
+    GATT_FIELD(GATT_FIELD_SFLOAT, 0, 0, gatt_blood_pressure_measurement, diastolic),
+    GATT_FIELD(GATT_FIELD_SFLOAT, 0, 0, gatt_blood_pressure_measurement, mean_arterial_pressure),
+    GATT_FIELD(GATT_FIELD_DATE_TIME, GATT_BLOOD_PRESSURE_TIME_STAMP, GATT_BLOOD_PRESSURE_TIME_STAMP, gatt_blood_pressure_measurement, time_stamp),
+    GATT_FIELD(GATT_FIELD_SFLOAT, GATT_BLOOD_PRESSURE_PULSE_RATE, GATT_BLOOD_PRESSURE_PULSE_RATE, gatt_blood_pressure_measurement, pulse_rate),
+    GATT_FIELD(GATT_FIELD_U8, GATT_BLOOD_PRESSURE_USER_ID, GATT_BLOOD_PRESSURE_USER_ID, gatt_blood_pressure_measurement, user_id),
+    GATT_FIELD(GATT_FIELD_U16, GATT_BLOOD_PRESSURE_STATUS, GATT_BLOOD_PRESSURE_STATUS, gatt_blood_pressure_measurement, measurement_status),
+};
+
+const gatt_layout gatt_blood_pressure_measurement_layout = GATT_LAYOUT(blood_pressure_fields, gatt_blood_pressure_measurement);
+
+#pragma mark - Glucose Measurement
+
+static const gatt_field glucose_fields[] = {
+    GATT_FIELD(GATT_FIELD_U16, 0, 0, gatt_glucose_measurement, sequence_number),
+    GATT_FIELD(GATT_FIELD_DATE_TIME, 0, 0, gatt_glucose_measurement, base_time),
+    GATT_FIELD(GATT_FIELD_S16, GATT_GLUCOSE_TIME_OFFSET, GATT_GLUCOSE_TIME_OFFSET, gatt_glucose_measurement, time_offset),
+    GATT_FIELD(GATT_FIELD_SFLOAT, GATT_GLUCOSE_CONCENTRATION, GATT_GLUCOSE_CONCENTRATION, gatt_glucose_measurement, concentration),
+    GATT_FIELD(GATT_FIELD_U8, GATT_GLUCOSE_CONCENTRATION, GATT_GLUCOSE_CONCENTRATION, gatt_glucose_measurement, type_and_location),
+    GATT_FIELD(GATT_FIELD_U16, GATT_GLUCOSE_SENSOR_STATUS, GATT_GLUCOSE_SENSOR_STATUS, gatt_glucose_measurement, sensor_status),
+};
+
+const gatt_layout gatt_glucose_measurement_layout = GATT_LAYOUT(glucose_fields, gatt_glucose_measurement);
+
+#pragma mark - Glucose Measurement Context
+
+static const gatt_field glucose_context_fields[] = {
+    GATT_FIELD(GATT_FIELD_U16, 0, 0, gatt_glucose_context, sequence_number),
+    GATT_FIELD(GATT_FIELD_U8, GATT_GLUCOSE_CONTEXT_EXTENDED_FLAGS, GATT_GLUCOSE_CONTEXT_EXTENDED_FLAGS, gatt_glucose_context, extended_flags),
+    GATT_FIELD(GATT_FIELD_U8, GATT_GLUCOSE_CONTEXT_CARBOHYDRATE, GATT_GLUCOSE_CONTEXT_CARBOHYDRATE, gatt_glucose_context, carbohydrate_id),
+    GATT_FIELD(GATT_FIELD_SFLOAT, GATT_GLUCOSE_CONTEXT_CARBOHYDRATE, GATT_GLUCOSE_CONTEXT_CARBOHYDRATE, gatt_glucose_context, carbohydrate),
+    GATT_FIELD(GATT_FIELD_U8, GATT_GLUCOSE_CONTEXT_MEAL, GATT_GLUCOSE_CONTEXT_MEAL, gatt_glucose_context, meal),
+    GATT_FIELD(GATT_FIELD_U8, GATT_GLUCOSE_CONTEXT_TESTER_HEALTH, GATT_GLUCOSE_CONTEXT_TESTER_HEALTH, gatt_glucose_context, tester_and_health),
+    GATT_FIELD(GATT_FIELD_U16, GATT_GLUCOSE_CONTEXT_EXERCISE, GATT_GLUCOSE_CONTEXT_EXERCISE, gatt_glucose_context, exercise_duration),
+    GATT_FIELD(GATT_FIELD_U8, GATT_GLUCOSE_CONTEXT_EXERCISE, GATT_GLUCOSE_CONTEXT_EXERCISE, gatt_glucose_context, exercise_intensity),
+    GATT_FIELD(GATT_FIELD_U8, GATT_GLUCOSE_CONTEXT_MEDICATION, GATT_GLUCOSE_CONTEXT_MEDICATION, gatt_glucose_context, medication_id),
+    GATT_FIELD(GATT_FIELD_SFLOAT, GATT_GLUCOSE_CONTEXT_MEDICATION, GATT_GLUCOSE_CONTEXT_MEDICATION, gatt_glucose_context, medication),
+    GATT_FIELD(GATT_FIELD_SFLOAT, GATT_GLUCOSE_CONTEXT_HBA1C, GATT_GLUCOSE_CONTEXT_HBA1C, gatt_glucose_context, hba1c),
+};
+
+const gatt_layout gatt_glucose_context_layout = GATT_LAYOUT(glucose_context_fields, gatt_glucose_context);
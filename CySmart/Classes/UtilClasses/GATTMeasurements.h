@@ -0,0 +1,272 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#ifndef GATTMeasurements_h
+#define GATTMeasurements_h
+
+#include "GATTDecoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma mark - Heart Rate Measurement
+
+#define GATT_HEART_RATE_16_BIT              0x01
+#define GATT_HEART_RATE_CONTACT_MASK        0x06
+#define GATT_HEART_RATE_CONTACT_DETECTED    0x06
+#define GATT_HEART_RATE_CONTACT_NOT_DETECTED 0x04
+#define GATT_HEART_RATE_ENERGY_EXPENDED     0x08
+#define GATT_HEART_RATE_RR_INTERVALS        0x10
+
+// As many as fit a notification of the default ATT MTU
+#define GATT_MAX_RR_INTERVALS               9
+
+/*!
+ *  @struct gatt_heart_rate_measurement
+ *
+ *  @discussion Heart Rate Measurement characteristic. Energy expended is in kJ, RR intervals in 1/1024 s.
+ *
+ */
+typedef struct
+{
+    gatt_result_header header;
+    uint32_t heart_rate;
+    uint32_t energy_expended;
+    uint32_t rr_interval_count;
+    uint16_t rr_intervals[GATT_MAX_RR_INTERVALS];
+} gatt_heart_rate_measurement;
+
+extern const gatt_layout gatt_heart_rate_measurement_layout;
+
+static inline uint32_t gatt_decode_heart_rate_measurement(const uint8_t *bytes, uint32_t length, gatt_heart_rate_measurement *result)
+{
+    return gatt_decode(&gatt_heart_rate_measurement_layout, bytes, length, result);
+}
+
+#pragma mark - CSC Measurement
+
+#define GATT_CSC_WHEEL_REVOLUTIONS          0x01
+#define GATT_CSC_CRANK_REVOLUTIONS          0x02
+
+/*!
+ *  @struct gatt_csc_measurement
+ *
+ *  @discussion Cycling Speed and Cadence Measurement characteristic. Event times are in 1/1024 s.
+ *
+ */
+typedef struct
+{
+    gatt_result_header header;
+    uint32_t wheel_revolutions;
+    uint32_t last_wheel_event_time;
+    uint32_t crank_revolutions;
+    uint32_t last_crank_event_time;
+} gatt_csc_measurement;
+
+extern const gatt_layout gatt_csc_measurement_layout;
+
+static inline uint32_t gatt_decode_csc_measurement(const uint8_t *bytes, uint32_t length, gatt_csc_measurement *result)
+{
+    return gatt_decode(&gatt_csc_measurement_layout, bytes, length, result);
+}
+
+#pragma mark - RSC Measurement
+
+#define GATT_RSC_STRIDE_LENGTH              0x01
+#define GATT_RSC_TOTAL_DISTANCE             0x02
+#define GATT_RSC_RUNNING                    0x04
+
+/*!
+ *  @struct gatt_rsc_measurement
+ *
+ *  @discussion Running Speed and Cadence Measurement characteristic. Speed is in 1/256 m/s, cadence in steps per
+ *  minute, stride length in cm and total distance in dm.
+ *
+ */
+typedef struct
+{
+    gatt_result_header header;
+    uint32_t speed;
+    uint32_t cadence;
+    uint32_t stride_length;
+    uint32_t total_distance;
+} gatt_rsc_measurement;
+
+extern const gatt_layout gatt_rsc_measurement_layout;
+
+static inline uint32_t gatt_decode_rsc_measurement(const uint8_t *bytes, uint32_t length, gatt_rsc_measurement *result)
+{
+    return gatt_decode(&gatt_rsc_measurement_layout, bytes, length, result);
+}
+
+#pragma mark - Temperature Measurement
+
+#define GATT_TEMPERATURE_FAHRENHEIT         0x01
+#define GATT_TEMPERATURE_TIME_STAMP         0x02
+#define GATT_TEMPERATURE_TYPE               0x04
+
+/*!
+ *  @struct gatt_temperature_measurement
+ *
+ *  @discussion Health Thermometer Temperature Measurement characteristic
+ *
+ */
+typedef struct
+{
+    gatt_result_header header;
+    float temperature;
+    gatt_date_time time_stamp;
+    uint32_t temperature_type;
+} gatt_temperature_measurement;
+
+extern const gatt_layout gatt_temperature_measurement_layout;
+
+static inline uint32_t gatt_decode_temperature_measurement(const uint8_t *bytes, uint32_t length, gatt_temperature_measurement *result)
+{
+    return gatt_decode(&gatt_temperature_measurement_layout, bytes, length, result);
+}
+
+#pragma mark - Blood Pressure Measurement
+
+#define GATT_BLOOD_PRESSURE_KPA             0x01
+#define GATT_BLOOD_PRESSURE_TIME_STAMP      0x02
+#define GATT_BLOOD_PRESSURE_PULSE_RATE      0x04
+#define GATT_BLOOD_PRESSURE_USER_ID         0x08
+#define GATT_BLOOD_PRESSURE_STATUS          0x10
+
+/*!
+ *  @struct gatt_blood_pressure_measurement
+ *
+ *  @discussion Blood Pressure Measurement characteristic. Pressures are in mmHg, or kPa with GATT_BLOOD_PRESSURE_KPA.
+ *
+ */
+typedef struct
+{
+    gatt_result_header header;
+    float systolic;
+    float diastolic;
+    float mean_arterial_pressure;
+    gatt_date_time time_stamp;
+    float pulse_rate;
+    uint32_t user_id;
+    uint32_t measurement_status;
+} gatt_blood_pressure_measurement;
+
+extern const gatt_layout gatt_blood_pressure_measurement_layout;
+
+static inline uint32_t gatt_decode_blood_pressure_measurement(const uint8_t *bytes, uint32_t length, gatt_blood_pressure_measurement *result)
+{
+    return gatt_decode(&gatt_blood_pressure_measurement_layout, bytes, length, result);
+}
+
+#pragma mark - Glucose Measurement
+
+#define GATT_GLUCOSE_TIME_OFFSET            0x01
+#define GATT_GLUCOSE_CONCENTRATION          0x02
+#define GATT_GLUCOSE_MOL_PER_LITRE          0x04
+#define GATT_GLUCOSE_SENSOR_STATUS          0x08
+#define GATT_GLUCOSE_CONTEXT_FOLLOWS        0x10
+
+/*!
+ *  @struct gatt_glucose_measurement
+ *
+ *  @discussion Glucose Measurement characteristic. The time offset is in minutes; the concentration is in kg/L, or
+ *  mol/L with GATT_GLUCOSE_MOL_PER_LITRE. The type is in the low nibble of type_and_location, the sample location in
+ *  the high nibble.
+ *
+ */
+typedef struct
+{
+    gatt_result_header header;
+    uint32_t sequence_number;
+    gatt_date_time base_time;
+    int32_t time_offset;
+    float concentration;
+    uint32_t type_and_location;
+    uint32_t sensor_status;
+} gatt_glucose_measurement;
+
+extern const gatt_layout gatt_glucose_measurement_layout;
+
+static inline uint32_t gatt_decode_glucose_measurement(const uint8_t *bytes, uint32_t length, gatt_glucose_measurement *result)
+{
+    return gatt_decode(&gatt_glucose_measurement_layout, bytes, length, result);
+}
+
+#pragma mark - Glucose Measurement Context
+
+#define GATT_GLUCOSE_CONTEXT_CARBOHYDRATE   0x01
+#define GATT_GLUCOSE_CONTEXT_MEAL           0x02
+#define GATT_GLUCOSE_CONTEXT_TESTER_HEALTH  0x04
+#define GATT_GLUCOSE_CONTEXT_EXERCISE       0x08
+#define GATT_GLUCOSE_CONTEXT_MEDICATION     0x10
+#define GATT_GLUCOSE_CONTEXT_MEDICATION_LITRE 0x20
+#define GATT_GLUCOSE_CONTEXT_HBA1C          0x40
+#define GATT_GLUCOSE_CONTEXT_EXTENDED_FLAGS 0x80
+
+/*!
+ *  @struct gatt_glucose_context
+ *
+ *  @discussion Glucose Measurement Context characteristic. Carbohydrate is in kg, the exercise duration in seconds,
+ *  the medication in kg, or litres with GATT_GLUCOSE_CONTEXT_MEDICATION_LITRE, and HbA1c in percent. The tester is in
+ *  the low nibble of tester_and_health, the health in the high nibble.
+ *
+ */
+typedef struct
+{
+    gatt_result_header header;
+    uint32_t sequence_number;
+    uint32_t extended_flags;
+    uint32_t carbohydrate_id;
+    float carbohydrate;
+    uint32_t meal;
+    uint32_t tester_and_health;
+    uint32_t exercise_duration;
+    uint32_t exercise_intensity;
+    uint32_t medication_id;
+    float medication;
+    float hba1c;
+} gatt_glucose_context;
+
+extern const gatt_layout gatt_glucose_context_layout;
+
+static inline uint32_t gatt_decode_glucose_context(const uint8_t *bytes, uint32_t length, gatt_glucose_context *result)
+{
+    return gatt_decode(&gatt_glucose_context_layout, bytes, length, result);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GATTMeasurements_h */
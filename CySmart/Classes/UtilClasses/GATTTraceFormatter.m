@@ -0,0 +1,179 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import "GATTTraceFormatter.h"
+#import <CoreBluetooth/CoreBluetooth.h>
+#import "ResourceHandler.h"
+#import "Utilities.h"
+
+/*!
+ *  @class GATTTraceFormatter
+ *
+ *  @discussion Renders trace records in the text form of the log
+ *
+ */
+@interface GATTTraceFormatter ()
+{
+    NSMutableDictionary *serviceNames;
+    NSMutableDictionary *characteristicNames;
+    NSMutableDictionary *descriptorNames;
+    NSMutableData *hexBuffer;
+}
+
+@end
+
+@implementation GATTTraceFormatter
+
+- (id)init {
+    if (self = [super init])
+    {
+        serviceNames = [NSMutableDictionary dictionary];
+        characteristicNames = [NSMutableDictionary dictionary];
+        descriptorNames = [NSMutableDictionary dictionary];
+        hexBuffer = [NSMutableData data];
+    }
+    return self;
+}
+
+/*!
+ *  @method nameForUUID:cache:lookup:
+ *
+ *  @discussion Returns the name of the UUID from the cache, looking it up the first time
+ *
+ */
+-(NSString *) nameForUUID:(const gatt_trace_uuid *)uuid cache:(NSMutableDictionary *)cache lookup:(NSString *(^)(CBUUID *UUID))lookup
+{
+    if (uuid->length == 0)
+    {
+        return @"";
+    }
+    
+    NSData *key = [NSData dataWithBytes:uuid->bytes length:uuid->length];
+    NSString *name = [cache objectForKey:key];
+    if (name == nil)
+    {
+        name = lookup([CBUUID UUIDWithData:key]);
+        [cache setObject:name forKey:key];
+    }
+    return name;
+}
+
+/*!
+ *  @method valueForRecord:
+ *
+ *  @discussion Returns the payload as "[01 02]" like convertDataToLoggerFormat:
+ *
+ */
+-(NSString *) valueForRecord:(const gatt_trace_record *)record
+{
+    if (record->payload_length == 0)
+    {
+        return @"[ ]";
+    }
+    
+    size_t capacity = 3 * (size_t)record->payload_length + 2;
+    if (hexBuffer.length < capacity)
+    {
+        hexBuffer.length = capacity;
+    }
+    char *hex = hexBuffer.mutableBytes;
+    hex[0] = '[';
+    size_t length = gatt_trace_format_hex(record->payload, record->payload_length, hex + 1);
+    hex[length + 1] = ']';
+    return [[NSString alloc] initWithBytes:hex length:length + 2 encoding:NSASCIIStringEncoding];
+}
+
+/*!
+ *  @method operationForRecord:
+ *
+ *  @discussion Returns the operation part of the log text
+ *
+ */
+-(NSString *) operationForRecord:(const gatt_trace_record *)record
+{
+    NSString *operation;
+    switch (record->opcode)
+    {
+        case GATT_TRACE_WRITE_REQUEST:      operation = WRITE_REQUEST; break;
+        case GATT_TRACE_WRITE_RESPONSE:     operation = WRITE_REQUEST_STATUS; break;
+        case GATT_TRACE_READ_REQUEST:       return READ_REQUEST;
+        case GATT_TRACE_READ_RESPONSE:      operation = READ_RESPONSE; break;
+        case GATT_TRACE_NOTIFY_RESPONSE:    operation = NOTIFY_RESPONSE; break;
+        case GATT_TRACE_INDICATE_RESPONSE:  operation = INDICATE_RESPONSE; break;
+        case GATT_TRACE_START_NOTIFY:       return START_NOTIFY;
+        case GATT_TRACE_STOP_NOTIFY:        return STOP_NOTIFY;
+        case GATT_TRACE_START_INDICATE:     return START_INDICATE;
+        case GATT_TRACE_STOP_INDICATE:      return STOP_INDICATE;
+        default:                            return @"";
+    }
+    
+    if (record->status != 0)
+    {
+        // The payload of a failed operation is the error description
+        NSString *description = [[NSString alloc] initWithBytes:record->payload length:record->payload_length encoding:NSUTF8StringEncoding];
+        NSString *prefix = record->opcode == GATT_TRACE_WRITE_RESPONSE || record->opcode == GATT_TRACE_WRITE_REQUEST ? WRITE_ERROR : READ_ERROR;
+        return [NSString stringWithFormat:@"%@- %@%@", operation, prefix, description ?: @""];
+    }
+    if (record->opcode == GATT_TRACE_WRITE_RESPONSE)
+    {
+        return [NSString stringWithFormat:@"%@- %@", operation, WRITE_SUCCESS];
+    }
+    return [NSString stringWithFormat:@"%@%@ %@", operation, DATA_SEPERATOR, [self valueForRecord:record]];
+}
+
+/*!
+ *  @method eventForRecord:
+ *
+ *  @discussion Returns the log text of the record, as "[service|characteristic|descriptor] operation"
+ *
+ */
+-(NSString *) eventForRecord:(const gatt_trace_record *)record
+{
+    NSString *service = [self nameForUUID:&record->service cache:serviceNames lookup:^NSString *(CBUUID *UUID) {
+        return [ResourceHandler getServiceNameForUUID:UUID];
+    }];
+    NSString *characteristic = [self nameForUUID:&record->characteristic cache:characteristicNames lookup:^NSString *(CBUUID *UUID) {
+        return [ResourceHandler getCharacteristicNameForUUID:UUID];
+    }];
+    NSString *operation = [self operationForRecord:record];
+    
+    if (record->descriptor.length != 0)
+    {
+        NSString *descriptor = [self nameForUUID:&record->descriptor cache:descriptorNames lookup:^NSString *(CBUUID *UUID) {
+            return [Utilities getDiscriptorNameForUUID:UUID] ?: UUID.UUIDString;
+        }];
+        return [NSString stringWithFormat:@"[%@|%@|%@] %@", service, characteristic, descriptor, operation];
+    }
+    return [NSString stringWithFormat:@"[%@|%@] %@", service, characteristic, operation];
+}
+
+@end
@@ -0,0 +1,152 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#include "GATTTraceRecord.h"
+
+#include <string.h>
+
+#define GATT_TRACE_MAX_UUID_LENGTH  16
+
+/*!
+ *  @function gatt_trace_uuid_valid
+ *
+ *  @discussion Returns 1 if the UUID has one of the lengths CoreBluetooth uses
+ *
+ */
+static int gatt_trace_uuid_valid(uint8_t length)
+{
+    return length == 0 || length == 2 || length == 4 || length == GATT_TRACE_MAX_UUID_LENGTH;
+}
+
+static uint8_t *gatt_trace_put_uuid(uint8_t *bytes, const gatt_trace_uuid *uuid)
+{
+    uint8_t length = gatt_trace_uuid_valid(uuid->length) ? uuid->length : 0;
+    *bytes++ = length;
+    memcpy(bytes, uuid->bytes, length);
+    return bytes + length;
+}
+
+static const uint8_t *gatt_trace_get_uuid(const uint8_t *bytes, const uint8_t *end, gatt_trace_uuid *uuid)
+{
+    if (bytes >= end || !gatt_trace_uuid_valid(*bytes) || *bytes > end - bytes - 1)
+    {
+        return NULL;
+    }
+    uuid->length = *bytes++;
+    memset(uuid->bytes, 0, sizeof(uuid->bytes));
+    memcpy(uuid->bytes, bytes, uuid->length);
+    return bytes + uuid->length;
+}
+
+size_t gatt_trace_record_size(const gatt_trace_record *record)
+{
+    size_t size = GATT_TRACE_HEADER_SIZE + 3 + record->payload_length;
+    size += gatt_trace_uuid_valid(record->service.length) ? record->service.length : 0;
+    size += gatt_trace_uuid_valid(record->characteristic.length) ? record->characteristic.length : 0;
+    size += gatt_trace_uuid_valid(record->descriptor.length) ? record->descriptor.length : 0;
+    return size;
+}
+
+size_t gatt_trace_record_encode(const gatt_trace_record *record, uint8_t *buffer)
+{
+    uint32_t status = (uint32_t)record->status;
+
+    buffer[0] = record->opcode;
+    buffer[1] = 0;
+    buffer[2] = (uint8_t)record->payload_length;
+    buffer[3] = (uint8_t)(record->payload_length >> 8);
+    buffer[4] = (uint8_t)status;
+    buffer[5] = (uint8_t)(status >> 8);
+    buffer[6] = (uint8_t)(status >> 16);
+    buffer[7] = (uint8_t)(status >> 24);
+    memcpy(buffer + 8, record->peripheral, sizeof(record->peripheral));
+
+    uint8_t *bytes = buffer + GATT_TRACE_HEADER_SIZE;
+    bytes = gatt_trace_put_uuid(bytes, &record->service);
+    bytes = gatt_trace_put_uuid(bytes, &record->characteristic);
+    bytes = gatt_trace_put_uuid(bytes, &record->descriptor);
+    if (record->payload_length > 0)
+    {
+        memcpy(bytes, record->payload, record->payload_length);
+    }
+    return (size_t)(bytes - buffer) + record->payload_length;
+}
+
+int gatt_trace_record_decode(const uint8_t *bytes, size_t length, gatt_trace_record *record)
+{
+    if (length < GATT_TRACE_HEADER_SIZE)
+    {
+        return 0;
+    }
+
+    const uint8_t *end = bytes + length;
+    record->opcode = bytes[0];
+    record->payload_length = (uint16_t)(bytes[2] | (bytes[3] << 8));
+    record->status = (int32_t)((uint32_t)bytes[4] | ((uint32_t)bytes[5] << 8) | ((uint32_t)bytes[6] << 16)
+                               | ((uint32_t)bytes[7] << 24));
+    memcpy(record->peripheral, bytes + 8, sizeof(record->peripheral));
+
+    const uint8_t *position = bytes + GATT_TRACE_HEADER_SIZE;
+    position = gatt_trace_get_uuid(position, end, &record->service);
+    if (position != NULL)
+    {
+        position = gatt_trace_get_uuid(position, end, &record->characteristic);
+    }
+    if (position != NULL)
+    {
+        position = gatt_trace_get_uuid(position, end, &record->descriptor);
+    }
+    if (position == NULL || (size_t)(end - position) != record->payload_length)
+    {
+        return 0;
+    }
+    record->payload = position;
+    return 1;
+}
+
+size_t gatt_trace_format_hex(const uint8_t *bytes, size_t length, char *output)
+{
+    static const char digits[] = "0123456789ABCDEF";
+    char *position = output;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        if (i > 0)
+        {
+            *position++ = ' ';
+        }
+        *position++ = digits[bytes[i] >> 4];
+        *position++ = digits[bytes[i] & 0x0F];
+    }
+    *position = '\0';
+    return (size_t)(position - output);
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+#ifndef GATTTraceRecord_h
+#define GATTTraceRecord_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ *  @discussion Size of the fixed part of an encoded trace record
+ *
+ */
+#define GATT_TRACE_HEADER_SIZE      24
+
+/*!
+ *  @discussion Largest encoded size of a trace record without its payload
+ *
+ */
+#define GATT_TRACE_MAX_HEADER_SIZE  (GATT_TRACE_HEADER_SIZE + 3 * 17)
+
+/*!
+ *  @discussion Operations recorded in a trace
+ *
+ */
+typedef enum
+{
+    GATT_TRACE_WRITE_REQUEST = 1,
+    GATT_TRACE_WRITE_RESPONSE,
+    GATT_TRACE_READ_REQUEST,
+    GATT_TRACE_READ_RESPONSE,
+    GATT_TRACE_NOTIFY_RESPONSE,
+    GATT_TRACE_INDICATE_RESPONSE,
+    GATT_TRACE_START_NOTIFY,
+    GATT_TRACE_STOP_NOTIFY,
+    GATT_TRACE_START_INDICATE,
+    GATT_TRACE_STOP_INDICATE
+} gatt_trace_opcode;
+
+/*!
+ *  @struct gatt_trace_uuid
+ *
+ *  @discussion Attribute UUID in its shortest form: 2, 4 or 16 bytes, as CBUUID data. length is 0 if absent.
+ *
+ */
+typedef struct
+{
+    uint8_t length;
+    uint8_t bytes[16];
+} gatt_trace_uuid;
+
+/*!
+ *  @struct gatt_trace_record
+ *
+ *  @discussion One GATT operation as it is logged. status is 0 on success, otherwise the error code, and the payload
+ *  then holds the UTF-8 error description instead of the attribute value.
+ *
+ *  Encoded, the record starts with a GATT_TRACE_HEADER_SIZE header: the opcode (8 bits), a reserved byte, the payload
+ *  length (16 bits), the status (32 bits) and the peripheral identifier (16 bytes). The service, characteristic and
+ *  descriptor UUIDs follow, each as a length byte and its bytes, then the payload.
+ *
+ */
+typedef struct
+{
+    uint8_t opcode;
+    int32_t status;
+    uint8_t peripheral[16];
+    gatt_trace_uuid service;
+    gatt_trace_uuid characteristic;
+    gatt_trace_uuid descriptor;
+    const uint8_t *payload;
+    uint16_t payload_length;
+} gatt_trace_record;
+
+/*!
+ *  @function gatt_trace_record_size
+ *
+ *  @discussion Returns the encoded size of the record
+ *
+ */
+size_t gatt_trace_record_size(const gatt_trace_record *record);
+
+/*!
+ *  @function gatt_trace_record_encode
+ *
+ *  @discussion Writes the record into buffer, which holds gatt_trace_record_size bytes. Returns the bytes written.
+ *
+ */
+size_t gatt_trace_record_encode(const gatt_trace_record *record, uint8_t *buffer);
+
+/*!
+ *  @function gatt_trace_record_decode
+ *
+ *  @discussion Reads an encoded record. The payload of the record points into bytes. Returns 0 if the bytes are not a
+ *  complete record.
+ *
+ */
+int gatt_trace_record_decode(const uint8_t *bytes, size_t length, gatt_trace_record *record);
+
+/*!
+ *  @function gatt_trace_format_hex
+ *
+ *  @discussion Writes the bytes as space separated hex pairs ("01 AB") into output, which holds 3 * length bytes (1 if
+ *  length is 0), and terminates it. Returns the string length.
+ *
+ */
+size_t gatt_trace_format_hex(const uint8_t *bytes, size_t length, char *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GATTTraceRecord_h */
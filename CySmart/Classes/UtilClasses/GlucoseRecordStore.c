@@ -0,0 +1,262 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#include "GlucoseRecordStore.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define INITIAL_SLOT_COUNT      64
+#define INITIAL_CAPACITY        16
+
+int64_t glucose_calendar_seconds(const gatt_date_time *date_time)
+{
+    // Days from civil, counting years from March so that the leap day is the last of the year
+    int64_t year = date_time->year - (date_time->month <= 2);
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t year_of_era = year - era * 400;
+    int64_t month = date_time->month;
+    int64_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + date_time->day - 1;
+    int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    int64_t days = era * 146097 + day_of_era - 719468;
+    return days * 86400 + date_time->hours * 3600 + date_time->minutes * 60 + date_time->seconds;
+}
+
+/*!
+ *  @function slot_of
+ *
+ *  @discussion First slot to probe for the sequence number
+ *
+ */
+static uint32_t slot_of(uint16_t sequence_number, uint32_t slot_count)
+{
+    return (uint32_t)(sequence_number * 40503u) & (slot_count - 1);
+}
+
+/*!
+ *  @function find_slot
+ *
+ *  @discussion Returns the slot of the sequence number, or the empty slot where it goes
+ *
+ */
+static uint32_t find_slot(const int32_t *slots, uint32_t slot_count, uint16_t sequence_number, uint16_t (*sequence_at)(const glucose_record_store *, int32_t), const glucose_record_store *store)
+{
+    uint32_t slot = slot_of(sequence_number, slot_count);
+    while (slots[slot] != GLUCOSE_NO_RECORD && sequence_at(store, slots[slot]) != sequence_number)
+    {
+        slot = (slot + 1) & (slot_count - 1);
+    }
+    return slot;
+}
+
+static uint16_t record_sequence(const glucose_record_store *store, int32_t index)
+{
+    return (uint16_t)store->records[index].measurement.sequence_number;
+}
+
+static uint16_t context_sequence(const glucose_record_store *store, int32_t index)
+{
+    return (uint16_t)store->contexts[index].sequence_number;
+}
+
+static int32_t *allocate_slots(uint32_t slot_count)
+{
+    int32_t *slots = malloc(slot_count * sizeof(int32_t));
+    if (slots != NULL)
+    {
+        memset(slots, 0xFF, slot_count * sizeof(int32_t));
+    }
+    return slots;
+}
+
+/*!
+ *  @function grow_slots
+ *
+ *  @discussion Doubles the tables once records or contexts fill half of them
+ *
+ */
+static int grow_slots(glucose_record_store *store)
+{
+    uint32_t used = store->record_count > store->context_count ? store->record_count : store->context_count;
+    if ((used + 1) * 2 <= store->slot_count)
+    {
+        return 1;
+    }
+    uint32_t slot_count = store->slot_count * 2;
+    int32_t *record_slots = allocate_slots(slot_count);
+    int32_t *context_slots = allocate_slots(slot_count);
+    if (record_slots == NULL || context_slots == NULL)
+    {
+        free(record_slots);
+        free(context_slots);
+        return 0;
+    }
+    for (uint32_t index = 0; index < store->record_count; index++)
+    {
+        record_slots[find_slot(record_slots, slot_count, record_sequence(store, index), record_sequence, store)] = index;
+    }
+    for (uint32_t index = 0; index < store->context_count; index++)
+    {
+        context_slots[find_slot(context_slots, slot_count, context_sequence(store, index), context_sequence, store)] = index;
+    }
+    free(store->record_slots);
+    free(store->context_slots);
+    store->record_slots = record_slots;
+    store->context_slots = context_slots;
+    store->slot_count = slot_count;
+    return 1;
+}
+
+static int reserve(void **items, uint32_t *capacity, uint32_t count, size_t size)
+{
+    if (count < *capacity)
+    {
+        return 1;
+    }
+    uint32_t grown = *capacity * 2;
+    void *resized = realloc(*items, grown * size);
+    if (resized == NULL)
+    {
+        return 0;
+    }
+    *items = resized;
+    *capacity = grown;
+    return 1;
+}
+
+int glucose_store_init(glucose_record_store *store)
+{
+    memset(store, 0, sizeof(*store));
+    store->records = malloc(INITIAL_CAPACITY * sizeof(glucose_record));
+    store->contexts = malloc(INITIAL_CAPACITY * sizeof(gatt_glucose_context));
+    store->record_slots = allocate_slots(INITIAL_SLOT_COUNT);
+    store->context_slots = allocate_slots(INITIAL_SLOT_COUNT);
+    store->latest = GLUCOSE_NO_RECORD;
+    if (store->records == NULL || store->contexts == NULL || store->record_slots == NULL || store->context_slots == NULL)
+    {
+        glucose_store_free(store);
+        return 0;
+    }
+    store->record_capacity = INITIAL_CAPACITY;
+    store->context_capacity = INITIAL_CAPACITY;
+    store->slot_count = INITIAL_SLOT_COUNT;
+    return 1;
+}
+
+void glucose_store_free(glucose_record_store *store)
+{
+    free(store->records);
+    free(store->contexts);
+    free(store->record_slots);
+    free(store->context_slots);
+    memset(store, 0, sizeof(*store));
+    store->latest = GLUCOSE_NO_RECORD;
+}
+
+void glucose_store_clear(glucose_record_store *store)
+{
+    store->record_count = 0;
+    store->context_count = 0;
+    store->latest = GLUCOSE_NO_RECORD;
+    memset(store->record_slots, 0xFF, store->slot_count * sizeof(int32_t));
+    memset(store->context_slots, 0xFF, store->slot_count * sizeof(int32_t));
+}
+
+int32_t glucose_store_add_measurement(glucose_record_store *store, const gatt_glucose_measurement *measurement)
+{
+    if (store->slot_count == 0 || !grow_slots(store) ||
+        !reserve((void **)&store->records, &store->record_capacity, store->record_count, sizeof(glucose_record)))
+    {
+        return GLUCOSE_NO_RECORD;
+    }
+
+    uint16_t sequence_number = (uint16_t)measurement->sequence_number;
+    uint32_t slot = find_slot(store->record_slots, store->slot_count, sequence_number, record_sequence, store);
+    int32_t index = store->record_slots[slot];
+    if (index == GLUCOSE_NO_RECORD)
+    {
+        index = (int32_t)store->record_count++;
+        store->record_slots[slot] = index;
+    }
+
+    glucose_record *record = &store->records[index];
+    record->measurement = *measurement;
+    record->time = glucose_calendar_seconds(&measurement->base_time) + (int64_t)measurement->time_offset * 60;
+    uint32_t context_slot = find_slot(store->context_slots, store->slot_count, sequence_number, context_sequence, store);
+    record->context = store->context_slots[context_slot];
+    store->latest = index;
+    return index;
+}
+
+int32_t glucose_store_add_context(glucose_record_store *store, const gatt_glucose_context *context)
+{
+    if (store->slot_count == 0 || !grow_slots(store) ||
+        !reserve((void **)&store->contexts, &store->context_capacity, store->context_count, sizeof(gatt_glucose_context)))
+    {
+        return GLUCOSE_NO_RECORD;
+    }
+
+    uint16_t sequence_number = (uint16_t)context->sequence_number;
+    uint32_t slot = find_slot(store->context_slots, store->slot_count, sequence_number, context_sequence, store);
+    int32_t index = store->context_slots[slot];
+    if (index == GLUCOSE_NO_RECORD)
+    {
+        index = (int32_t)store->context_count++;
+        store->context_slots[slot] = index;
+    }
+    store->contexts[index] = *context;
+
+    int32_t record = glucose_store_find(store, sequence_number);
+    if (record != GLUCOSE_NO_RECORD)
+    {
+        store->records[record].context = index;
+    }
+    return index;
+}
+
+int32_t glucose_store_find(const glucose_record_store *store, uint16_t sequence_number)
+{
+    if (store->slot_count == 0)
+    {
+        return GLUCOSE_NO_RECORD;
+    }
+    return store->record_slots[find_slot(store->record_slots, store->slot_count, sequence_number, record_sequence, store)];
+}
+
+const gatt_glucose_context *glucose_store_context_of(const glucose_record_store *store, uint32_t index)
+{
+    if (index >= store->record_count || store->records[index].context == GLUCOSE_NO_RECORD)
+    {
+        return NULL;
+    }
+    return &store->contexts[store->records[index].context];
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#ifndef GlucoseRecordStore_h
+#define GlucoseRecordStore_h
+
+#include <stdint.h>
+#include "GATTMeasurements.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GLUCOSE_NO_RECORD   (-1)
+
+/*!
+ *  @struct glucose_record
+ *
+ *  @discussion A glucose measurement with its time as seconds of the meter's calendar, base time plus time offset,
+ *  since 1970-01-01 00:00:00 of that calendar. context is the index of the matching context, GLUCOSE_NO_RECORD until
+ *  one is received.
+ *
+ */
+typedef struct
+{
+    gatt_glucose_measurement measurement;
+    int64_t time;
+    int32_t context;
+} glucose_record;
+
+/*!
+ *  @struct glucose_record_store
+ *
+ *  @discussion Glucose measurements and contexts in the order they were first received, each indexed by sequence
+ *  number in an open addressing table, so adding and matching are constant time. A record received again replaces
+ *  the earlier one in place. latest is the index of the record received last.
+ *
+ */
+typedef struct
+{
+    glucose_record *records;
+    uint32_t record_count;
+    uint32_t record_capacity;
+    gatt_glucose_context *contexts;
+    uint32_t context_count;
+    uint32_t context_capacity;
+    int32_t *record_slots;          // Record index per slot, GLUCOSE_NO_RECORD if empty
+    int32_t *context_slots;
+    uint32_t slot_count;            // Power of two, at least twice the number of records and contexts
+    int32_t latest;
+} glucose_record_store;
+
+/*!
+ *  @function glucose_calendar_seconds
+ *
+ *  @discussion Seconds since 1970-01-01 00:00:00 of the date, in the proleptic Gregorian calendar without time zone
+ *
+ */
+int64_t glucose_calendar_seconds(const gatt_date_time *date_time);
+
+int glucose_store_init(glucose_record_store *store);
+void glucose_store_free(glucose_record_store *store);
+
+/*!
+ *  @function glucose_store_clear
+ *
+ *  @discussion Removes every record and context, keeping the memory
+ *
+ */
+void glucose_store_clear(glucose_record_store *store);
+
+/*!
+ *  @function glucose_store_add_measurement
+ *
+ *  @discussion Adds the measurement, or replaces the record of the same sequence number, and matches it with its
+ *  context. Returns the index of the record, GLUCOSE_NO_RECORD if memory ran out.
+ *
+ */
+int32_t glucose_store_add_measurement(glucose_record_store *store, const gatt_glucose_measurement *measurement);
+
+/*!
+ *  @function glucose_store_add_context
+ *
+ *  @discussion Adds the context, or replaces the one of the same sequence number, and matches it with its record.
+ *  Returns the index of the context, GLUCOSE_NO_RECORD if memory ran out.
+ *
+ */
+int32_t glucose_store_add_context(glucose_record_store *store, const gatt_glucose_context *context);
+
+/*!
+ *  @function glucose_store_find
+ *
+ *  @discussion Returns the index of the record of the sequence number, GLUCOSE_NO_RECORD if there is none
+ *
+ */
+int32_t glucose_store_find(const glucose_record_store *store, uint16_t sequence_number);
+
+/*!
+ *  @function glucose_store_context_of
+ *
+ *  @discussion Returns the context of the record at index, NULL if it has none
+ *
+ */
+const gatt_glucose_context *glucose_store_context_of(const glucose_record_store *store, uint32_t index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GlucoseRecordStore_h */
@@ -0,0 +1,325 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#include "LogExport.h"
+
+#include <string.h>
+#include <time.h>
+
+#define LOG_EXPORT_PCAP_MAGIC       0xA1B2C3D4u
+#define LOG_EXPORT_PCAP_SNAPLEN     262144
+
+static const char *const log_export_operations[] =
+{
+    [GATT_TRACE_WRITE_REQUEST] = "write_request",
+    [GATT_TRACE_WRITE_RESPONSE] = "write_response",
+    [GATT_TRACE_READ_REQUEST] = "read_request",
+    [GATT_TRACE_READ_RESPONSE] = "read_response",
+    [GATT_TRACE_NOTIFY_RESPONSE] = "notify_response",
+    [GATT_TRACE_INDICATE_RESPONSE] = "indicate_response",
+    [GATT_TRACE_START_NOTIFY] = "start_notify",
+    [GATT_TRACE_STOP_NOTIFY] = "stop_notify",
+    [GATT_TRACE_START_INDICATE] = "start_indicate",
+    [GATT_TRACE_STOP_INDICATE] = "stop_indicate"
+};
+
+#pragma mark - Fields
+
+static const char *log_export_operation(uint8_t opcode)
+{
+    size_t count = sizeof(log_export_operations) / sizeof(log_export_operations[0]);
+    return opcode < count && log_export_operations[opcode] != NULL ? log_export_operations[opcode] : "unknown";
+}
+
+/*!
+ *  @function log_export_time
+ *
+ *  @discussion Formats the timestamp as ISO 8601 in UTC with microseconds
+ *
+ */
+static void log_export_time(int64_t timestamp_us, char *output, size_t capacity)
+{
+    int64_t seconds = timestamp_us / 1000000;
+    int64_t micros = timestamp_us % 1000000;
+    if (micros < 0)
+    {
+        seconds--;
+        micros += 1000000;
+    }
+
+    time_t time = (time_t)seconds;
+    struct tm fields;
+    if (gmtime_r(&time, &fields) == NULL)
+    {
+        memset(&fields, 0, sizeof(fields));
+    }
+
+    // Years past 9999 do not fit the format; the other fields are always in range, the modulo only makes their width
+    // explicit so that the text always fits the output
+    int year = fields.tm_year + 1900;
+    year = year < 0 ? 0 : (year > 9999 ? 9999 : year);
+    snprintf(output, capacity, "%04u-%02u-%02uT%02u:%02u:%02u.%06uZ", (unsigned)year, (unsigned)(fields.tm_mon + 1) % 100u,
+             (unsigned)fields.tm_mday % 100u, (unsigned)fields.tm_hour % 100u, (unsigned)fields.tm_min % 100u,
+             (unsigned)fields.tm_sec % 100u, (unsigned)micros % 1000000u);
+}
+
+/*!
+ *  @function log_export_uuid
+ *
+ *  @discussion Formats a UUID as CBUUID does: 16 byte UUIDs in the dashed form, shorter ones as plain hex
+ *
+ */
+static void log_export_uuid(const uint8_t *bytes, uint8_t length, char *output)
+{
+    static const char digits[] = "0123456789ABCDEF";
+    for (uint8_t i = 0; i < length; i++)
+    {
+        if (length == 16 && (i == 4 || i == 6 || i == 8 || i == 10))
+        {
+            *output++ = '-';
+        }
+        *output++ = digits[bytes[i] >> 4];
+        *output++ = digits[bytes[i] & 15];
+    }
+    *output = '\0';
+}
+
+static void log_export_hex(FILE *file, const uint8_t *bytes, size_t length)
+{
+    static const char digits[] = "0123456789ABCDEF";
+    for (size_t i = 0; i < length; i++)
+    {
+        if (i > 0)
+        {
+            putc(' ', file);
+        }
+        putc(digits[bytes[i] >> 4], file);
+        putc(digits[bytes[i] & 15], file);
+    }
+}
+
+static void log_export_csv_text(FILE *file, const uint8_t *text, size_t length)
+{
+    int quote = 0;
+    for (size_t i = 0; i < length && !quote; i++)
+    {
+        quote = text[i] == ',' || text[i] == '"' || text[i] == '\n' || text[i] == '\r';
+    }
+    if (!quote)
+    {
+        fwrite(text, 1, length, file);
+        return;
+    }
+
+    putc('"', file);
+    for (size_t i = 0; i < length; i++)
+    {
+        if (text[i] == '"')
+        {
+            putc('"', file);
+        }
+        putc(text[i], file);
+    }
+    putc('"', file);
+}
+
+static void log_export_json_text(FILE *file, const uint8_t *text, size_t length)
+{
+    putc('"', file);
+    for (size_t i = 0; i < length; i++)
+    {
+        uint8_t c = text[i];
+        switch (c)
+        {
+            case '"': fputs("\\\"", file); break;
+            case '\\': fputs("\\\\", file); break;
+            case '\n': fputs("\\n", file); break;
+            case '\r': fputs("\\r", file); break;
+            case '\t': fputs("\\t", file); break;
+            default:
+                if (c < 0x20)
+                {
+                    fprintf(file, "\\u%04X", c);
+                }
+                else
+                {
+                    putc(c, file);
+                }
+                break;
+        }
+    }
+    putc('"', file);
+}
+
+static void log_export_put32(FILE *file, uint32_t value)
+{
+    uint8_t bytes[4] = { (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24) };
+    fwrite(bytes, 1, sizeof(bytes), file);
+}
+
+#pragma mark - Formats
+
+static void log_export_csv(FILE *file, const log_query_match *match, const char *time)
+{
+    const gatt_trace_record *trace = &match->trace;
+    if (match->type != LOG_SEGMENT_TRACE_RECORD)
+    {
+        fprintf(file, "%s,,,,,,,,", time);
+        log_export_csv_text(file, match->payload, match->length);
+        putc('\n', file);
+        return;
+    }
+
+    char peripheral[40], service[40], characteristic[40], descriptor[40];
+    log_export_uuid(trace->peripheral, sizeof(trace->peripheral), peripheral);
+    log_export_uuid(trace->service.bytes, trace->service.length, service);
+    log_export_uuid(trace->characteristic.bytes, trace->characteristic.length, characteristic);
+    log_export_uuid(trace->descriptor.bytes, trace->descriptor.length, descriptor);
+    fprintf(file, "%s,%s,%s,%s,%s,%s,%d,", time, peripheral, service, characteristic, descriptor,
+            log_export_operation(trace->opcode), (int)trace->status);
+
+    // A failed operation carries its error description instead of a value
+    if (trace->status == 0)
+    {
+        log_export_hex(file, trace->payload, trace->payload_length);
+        putc(',', file);
+    }
+    else
+    {
+        putc(',', file);
+        log_export_csv_text(file, trace->payload, trace->payload_length);
+    }
+    putc('\n', file);
+}
+
+static void log_export_json(FILE *file, const log_query_match *match, const char *time)
+{
+    const gatt_trace_record *trace = &match->trace;
+    fprintf(file, "{\"time\":\"%s\"", time);
+    if (match->type != LOG_SEGMENT_TRACE_RECORD)
+    {
+        fputs(",\"text\":", file);
+        log_export_json_text(file, match->payload, match->length);
+        fputs("}\n", file);
+        return;
+    }
+
+    char uuid[40];
+    log_export_uuid(trace->peripheral, sizeof(trace->peripheral), uuid);
+    fprintf(file, ",\"peripheral\":\"%s\"", uuid);
+    log_export_uuid(trace->service.bytes, trace->service.length, uuid);
+    fprintf(file, ",\"service\":\"%s\"", uuid);
+    log_export_uuid(trace->characteristic.bytes, trace->characteristic.length, uuid);
+    fprintf(file, ",\"characteristic\":\"%s\"", uuid);
+    if (trace->descriptor.length > 0)
+    {
+        log_export_uuid(trace->descriptor.bytes, trace->descriptor.length, uuid);
+        fprintf(file, ",\"descriptor\":\"%s\"", uuid);
+    }
+    fprintf(file, ",\"operation\":\"%s\",\"status\":%d", log_export_operation(trace->opcode), (int)trace->status);
+
+    if (trace->status == 0)
+    {
+        fputs(",\"value\":\"", file);
+        log_export_hex(file, trace->payload, trace->payload_length);
+        putc('"', file);
+    }
+    else
+    {
+        fputs(",\"error\":", file);
+        log_export_json_text(file, trace->payload, trace->payload_length);
+    }
+    fputs("}\n", file);
+}
+
+static void log_export_pcap(FILE *file, const log_query_match *match)
+{
+    if (match->type != LOG_SEGMENT_TRACE_RECORD)
+    {
+        return;
+    }
+
+    int64_t seconds = match->timestamp_us / 1000000;
+    int64_t micros = match->timestamp_us % 1000000;
+    if (micros < 0)
+    {
+        seconds--;
+        micros += 1000000;
+    }
+    uint32_t length = match->length < LOG_EXPORT_PCAP_SNAPLEN ? match->length : LOG_EXPORT_PCAP_SNAPLEN;
+    log_export_put32(file, (uint32_t)seconds);
+    log_export_put32(file, (uint32_t)micros);
+    log_export_put32(file, length);
+    log_export_put32(file, match->length);
+    fwrite(match->payload, 1, length, file);
+}
+
+int log_export_begin(FILE *file, log_export_format format)
+{
+    switch (format)
+    {
+        case LOG_EXPORT_CSV:
+            fputs("time,peripheral,service,characteristic,descriptor,operation,status,value,text\n", file);
+            break;
+        case LOG_EXPORT_PCAP:
+            log_export_put32(file, LOG_EXPORT_PCAP_MAGIC);
+            log_export_put32(file, 2 | (4u << 16));     // Version 2.4
+            log_export_put32(file, 0);                  // GMT offset
+            log_export_put32(file, 0);                  // Timestamp accuracy
+            log_export_put32(file, LOG_EXPORT_PCAP_SNAPLEN);
+            log_export_put32(file, LOG_EXPORT_PCAP_LINKTYPE);
+            break;
+        default:
+            break;
+    }
+    return !ferror(file);
+}
+
+int log_export_match(FILE *file, log_export_format format, const log_query_match *match)
+{
+    char time[40];
+    switch (format)
+    {
+        case LOG_EXPORT_CSV:
+            log_export_time(match->timestamp_us, time, sizeof(time));
+            log_export_csv(file, match, time);
+            break;
+        case LOG_EXPORT_JSON_LINES:
+            log_export_time(match->timestamp_us, time, sizeof(time));
+            log_export_json(file, match, time);
+            break;
+        case LOG_EXPORT_PCAP:
+            log_export_pcap(file, match);
+            break;
+    }
+    return !ferror(file);
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#ifndef LogExport_h
+#define LogExport_h
+
+#include <stdio.h>
+
+#include "LogQueryIndex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ *  @discussion Link type of the packets in a pcap export. Each packet is an encoded gatt_trace_record.
+ *
+ */
+#define LOG_EXPORT_PCAP_LINKTYPE    147     // LINKTYPE_USER0
+
+/*!
+ *  @discussion Formats of an export
+ *
+ */
+typedef enum
+{
+    LOG_EXPORT_CSV = 0,                 // Header row, then one row per record
+    LOG_EXPORT_JSON_LINES,              // One JSON object per line
+    LOG_EXPORT_PCAP                     // pcap capture of the trace records; text records are left out
+} log_export_format;
+
+/*!
+ *  @function log_export_begin
+ *
+ *  @discussion Writes what precedes the records: the CSV header row or the pcap file header. Returns 0 on a write
+ *  error.
+ *
+ */
+int log_export_begin(FILE *file, log_export_format format);
+
+/*!
+ *  @function log_export_match
+ *
+ *  @discussion Writes one record found by a query. Times are written in UTC, UUIDs and values in hex. Returns 0 on a
+ *  write error.
+ *
+ */
+int log_export_match(FILE *file, log_export_format format, const log_query_match *match);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LogExport_h */
@@ -0,0 +1,89 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import <Foundation/Foundation.h>
+
+/*!
+ *  @class LogPageReader
+ *
+ *  @discussion Random access to the log records of one day. The segment is memory-mapped and indexed once; records
+ *  are decoded and formatted only for the range asked for, so a day of any size can be paged through with constant
+ *  memory. Not thread safe, use one reader per queue.
+ *
+ */
+@interface LogPageReader : NSObject
+
+/*!
+ *  @property count
+ *
+ *  @discussion Number of records indexed so far
+ *
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/*!
+ *  @method initWithDirectory:day:
+ *
+ *  @discussion Opens the segment of the day, a YYYYMMDD key, in the log directory. Returns nil if the segment cannot
+ *  be read; a day without records opens as empty.
+ *
+ */
+-(instancetype)initWithDirectory:(NSString *)directory day:(uint32_t)day;
+
+/*!
+ *  @method eventsInRange:
+ *
+ *  @discussion Returns the records in range as "[date|time]::data" strings, an empty string for a corrupt record.
+ *  The range is clipped to count.
+ *
+ */
+-(NSArray *)eventsInRange:(NSRange)range;
+
+/*!
+ *  @method refresh
+ *
+ *  @discussion Indexes the records written since the reader was opened or last refreshed. Returns the number of new
+ *  records.
+ *
+ */
+-(NSUInteger)refresh;
+
+/*!
+ *  @method indexesOfEventsContainingString:fromIndex:cancelled:
+ *
+ *  @discussion Returns the indexes of the records from index on whose text contains the string, ignoring case.
+ *  cancelled is checked between pages; the scan stops early and returns nil once it returns YES.
+ *
+ */
+-(NSIndexSet *)indexesOfEventsContainingString:(NSString *)string fromIndex:(NSUInteger)index cancelled:(BOOL (^)(void))cancelled;
+
+@end
@@ -0,0 +1,179 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import "LogPageReader.h"
+#import "LogSegmentStore.h"
+#import "GATTTraceFormatter.h"
+#import "LoggerHandler.h"
+#import "Constants.h"
+
+// Records formatted per step of a search
+#define LOG_SEARCH_PAGE_SIZE    512
+
+/*!
+ *  @class LogPageReader
+ *
+ *  @discussion Random access to the log records of one day
+ *
+ */
+@interface LogPageReader ()
+{
+    log_segment_reader reader;
+    BOOL isOpen;
+    NSMutableData *buffer;
+    GATTTraceFormatter *traceFormatter;
+    NSDateFormatter *dateTimeFormatter;
+    NSString *timeString;
+    int64_t timeSecond;
+}
+
+@end
+
+@implementation LogPageReader
+
+-(instancetype)initWithDirectory:(NSString *)directory day:(uint32_t)day {
+    if (self = [super init])
+    {
+        if (!log_segment_reader_open(&reader, directory.fileSystemRepresentation, day))
+        {
+            return nil;
+        }
+        isOpen = YES;
+        buffer = [NSMutableData data];
+        traceFormatter = [[GATTTraceFormatter alloc] init];
+        dateTimeFormatter = [[NSDateFormatter alloc] init];
+        dateTimeFormatter.dateFormat = [NSString stringWithFormat:@"%@|%@", DATE_FORMAT, TIME_FORMAT];
+        timeSecond = -1;
+    }
+    return self;
+}
+
+-(void)dealloc {
+    if (isOpen)
+    {
+        log_segment_reader_close(&reader);
+    }
+}
+
+-(NSUInteger)count {
+    return reader.count;
+}
+
+-(NSUInteger)refresh {
+    uint32_t count = reader.count;
+    log_segment_reader_refresh(&reader);
+    return reader.count > count ? reader.count - count : 0;
+}
+
+/*!
+ *  @method eventAtIndex:
+ *
+ *  @discussion Decodes and formats one record, nil if it is corrupt
+ *
+ */
+-(NSString *)eventAtIndex:(uint32_t)index {
+    log_segment_entry entry;
+    if (!log_segment_reader_entry(&reader, index, &entry))
+    {
+        return nil;
+    }
+    if (buffer.length < entry.length)
+    {
+        buffer.length = entry.length;
+    }
+    if (!log_segment_entry_decode(&entry, buffer.mutableBytes))
+    {
+        return nil;
+    }
+    
+    // The time string has a resolution of one second, so format it once per second rather than per record
+    int64_t second = entry.timestamp_us / 1000000;
+    if (second != timeSecond)
+    {
+        timeString = [dateTimeFormatter stringFromDate:[NSDate dateWithTimeIntervalSince1970:second]];
+        timeSecond = second;
+    }
+    
+    NSString *data;
+    if (entry.type == LOG_SEGMENT_TRACE_RECORD)
+    {
+        gatt_trace_record trace;
+        data = gatt_trace_record_decode(buffer.bytes, entry.length, &trace) ? [traceFormatter eventForRecord:&trace] : nil;
+    }
+    else
+    {
+        data = [[NSString alloc] initWithBytes:buffer.bytes length:entry.length encoding:NSUTF8StringEncoding];
+    }
+    return [NSString stringWithFormat:@"[%@]%@%@", timeString, DATE_SEPARATOR, data ?: @""];
+}
+
+-(NSArray *)eventsInRange:(NSRange)range {
+    NSUInteger start = MIN(range.location, reader.count);
+    NSUInteger end = MIN(NSMaxRange(range), reader.count);
+    NSMutableArray *events = [NSMutableArray arrayWithCapacity:end - start];
+    
+    for (NSUInteger i = start; i < end; i++)
+    {
+        @autoreleasepool {
+            // A corrupt record keeps its place so that indexes stay aligned
+            [events addObject:[self eventAtIndex:(uint32_t)i] ?: @""];
+        }
+    }
+    return events;
+}
+
+-(NSIndexSet *)indexesOfEventsContainingString:(NSString *)string fromIndex:(NSUInteger)index cancelled:(BOOL (^)(void))cancelled {
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+    NSUInteger count = reader.count;
+    
+    for (NSUInteger page = index; page < count; page += LOG_SEARCH_PAGE_SIZE)
+    {
+        if (cancelled && cancelled())
+        {
+            return nil;
+        }
+        @autoreleasepool {
+            NSUInteger end = MIN(page + LOG_SEARCH_PAGE_SIZE, count);
+            for (NSUInteger i = page; i < end; i++)
+            {
+                NSString *event = [self eventAtIndex:(uint32_t)i];
+                if (event && [event rangeOfString:string options:NSCaseInsensitiveSearch].location != NSNotFound)
+                {
+                    [indexes addIndex:i];
+                }
+            }
+        }
+    }
+    return indexes;
+}
+
+@end
@@ -0,0 +1,141 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import <CoreBluetooth/CoreBluetooth.h>
+#import "LogQueryIndex.h"
+#import "LogExport.h"
+
+/*!
+ *  @class LogQuery
+ *
+ *  @discussion Filter of a log query. Every property that is set narrows the result; setting the peripheral, the
+ *  characteristic or the operations leaves out text records.
+ *
+ */
+@interface LogQuery : NSObject
+
+/*!
+ *  @property startDate
+ *
+ *  @discussion Time of the first record, nil for no lower bound
+ *
+ */
+@property (nonatomic, strong) NSDate *startDate;
+
+/*!
+ *  @property endDate
+ *
+ *  @discussion Time after the last record, nil for no upper bound
+ *
+ */
+@property (nonatomic, strong) NSDate *endDate;
+
+/*!
+ *  @property peripheralIdentifier
+ *
+ *  @discussion Identifier of the peripheral of the GATT operations
+ *
+ */
+@property (nonatomic, strong) NSUUID *peripheralIdentifier;
+
+/*!
+ *  @property characteristicUUID
+ *
+ *  @discussion Characteristic of the GATT operations
+ *
+ */
+@property (nonatomic, strong) CBUUID *characteristicUUID;
+
+/*!
+ *  @property operations
+ *
+ *  @discussion LOG_QUERY_OPERATION bits of the GATT operations, 0 for any operation
+ *
+ */
+@property (nonatomic) uint32_t operations;
+
+/*!
+ *  @property searchText
+ *
+ *  @discussion Text searched for in text records and error descriptions, ignoring case
+ *
+ */
+@property (nonatomic, strong) NSString *searchText;
+
+/*!
+ *  @property valuePattern
+ *
+ *  @discussion Bytes searched for in the values of GATT operations. Takes precedence over searchText.
+ *
+ */
+@property (nonatomic, strong) NSData *valuePattern;
+
+@end
+
+/*!
+ *  @class LogQueryEngine
+ *
+ *  @discussion Runs queries over the log segments of every day. The per-day indexes are built on first use and kept;
+ *  each query only indexes the records written since the previous one. Results are streamed, never collected. Not
+ *  thread safe, use one engine per queue.
+ *
+ */
+@interface LogQueryEngine : NSObject
+
+/*!
+ *  @method initWithDirectory:
+ *
+ *  @discussion Creates an engine over the log segments in the directory
+ *
+ */
+-(instancetype)initWithDirectory:(NSString *)directory;
+
+/*!
+ *  @method enumerateRecordsMatchingQuery:usingBlock:
+ *
+ *  @discussion Calls the block for every matching record in time order until it sets stop. The match is valid during
+ *  the call only. Returns the number of records passed to the block.
+ *
+ */
+-(NSUInteger)enumerateRecordsMatchingQuery:(LogQuery *)query usingBlock:(void (^)(const log_query_match *match, BOOL *stop))block;
+
+/*!
+ *  @method exportRecordsMatchingQuery:format:toURL:
+ *
+ *  @discussion Writes the matching records to the file URL as they are found. Returns NO if the file cannot be
+ *  written.
+ *
+ */
+-(BOOL)exportRecordsMatchingQuery:(LogQuery *)query format:(log_export_format)format toURL:(NSURL *)url;
+
+@end
@@ -0,0 +1,259 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import "LogQueryEngine.h"
+#import "LoggerHandler.h"
+#import "Utilities.h"
+
+@implementation LogQuery
+
+@end
+
+/*!
+ *  @class LogDayIndex
+ *
+ *  @discussion Query index of the log segment of one day
+ *
+ */
+@interface LogDayIndex : NSObject
+{
+    @public
+    log_query_index index;
+}
+
+@end
+
+@implementation LogDayIndex
+
+-(instancetype)initWithDirectory:(NSString *)directory day:(uint32_t)day {
+    if (self = [super init])
+    {
+        if (!log_query_index_open(&index, directory.fileSystemRepresentation, day))
+        {
+            return nil;
+        }
+    }
+    return self;
+}
+
+-(void)dealloc {
+    log_query_index_close(&index);
+}
+
+@end
+
+/*!
+ *  @class LogQueryEngine
+ *
+ *  @discussion Class that runs queries over the log segments
+ *
+ */
+@interface LogQueryEngine ()
+{
+    NSString *logDirectory;
+    NSCalendar *calendar;
+    NSMutableDictionary *dayIndexes;        // Day key to LogDayIndex
+}
+
+@end
+
+@implementation LogQueryEngine
+
+-(instancetype)initWithDirectory:(NSString *)directory {
+    if (self = [super init])
+    {
+        logDirectory = directory;
+        calendar = [NSCalendar currentCalendar];
+        dayIndexes = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+/*!
+ *  @method daysForQuery:
+ *
+ *  @discussion Returns the days with a segment that may hold records of the query, oldest first, and drops the
+ *  indexes of days that were deleted
+ *
+ */
+-(NSArray *)daysForQuery:(LogQuery *)query {
+    uint32_t probe;
+    size_t count = log_segment_list_days(logDirectory.fileSystemRepresentation, &probe, 0);
+    NSMutableData *days = [NSMutableData dataWithLength:count * sizeof(uint32_t)];
+    count = MIN(count, log_segment_list_days(logDirectory.fileSystemRepresentation, days.mutableBytes, count));
+    
+    // Records are filed under the local day they were written on
+    uint32_t firstDay = query.startDate ? [LoggerHandler dayForDate:query.startDate calendar:calendar] : 0;
+    uint32_t lastDay = query.endDate ? [LoggerHandler dayForDate:query.endDate calendar:calendar] : UINT32_MAX;
+    
+    NSMutableArray *queryDays = [NSMutableArray array];
+    NSMutableSet *existingDays = [NSMutableSet setWithCapacity:count];
+    const uint32_t *dayKeys = days.bytes;
+    for (size_t i = 0; i < count; i++)
+    {
+        [existingDays addObject:@(dayKeys[i])];
+        if (dayKeys[i] >= firstDay && dayKeys[i] <= lastDay)
+        {
+            [queryDays addObject:@(dayKeys[i])];
+        }
+    }
+    
+    for (NSNumber *day in dayIndexes.allKeys)
+    {
+        if (![existingDays containsObject:day])
+        {
+            [dayIndexes removeObjectForKey:day];
+        }
+    }
+    return queryDays;
+}
+
+/*!
+ *  @method indexForDay:
+ *
+ *  @discussion Returns the index of the day, brought up to date with its segment
+ *
+ */
+-(LogDayIndex *)indexForDay:(NSNumber *)day {
+    LogDayIndex *dayIndex = [dayIndexes objectForKey:day];
+    if (dayIndex == nil)
+    {
+        dayIndex = [[LogDayIndex alloc] initWithDirectory:logDirectory day:day.unsignedIntValue];
+        if (dayIndex != nil)
+        {
+            [dayIndexes setObject:dayIndex forKey:day];
+        }
+    }
+    else if (!log_query_index_refresh(&dayIndex->index))
+    {
+        [dayIndexes removeObjectForKey:day];
+        return nil;
+    }
+    return dayIndex;
+}
+
+/*!
+ *  @method getFilter:fromQuery:
+ *
+ *  @discussion Fills the C filter of the query. Returns the pattern bytes, which must be kept while the filter is used.
+ *
+ */
+-(NSData *)getFilter:(log_query *)filter fromQuery:(LogQuery *)query {
+    memset(filter, 0, sizeof(*filter));
+    filter->from_us = query.startDate ? (int64_t)llround(query.startDate.timeIntervalSince1970 * 1e6) : INT64_MIN;
+    filter->to_us = query.endDate ? (int64_t)llround(query.endDate.timeIntervalSince1970 * 1e6) : INT64_MAX;
+    
+    if (query.peripheralIdentifier)
+    {
+        filter->match_peripheral = 1;
+        [query.peripheralIdentifier getUUIDBytes:filter->peripheral];
+    }
+    if (query.characteristicUUID)
+    {
+        [Utilities getTraceUUID:&filter->characteristic fromUUID:query.characteristicUUID];
+    }
+    filter->operations = query.operations;
+    
+    NSData *pattern = nil;
+    if (query.valuePattern)
+    {
+        pattern = query.valuePattern;
+        filter->pattern_type = LOG_QUERY_BYTE_PATTERN;
+    }
+    else if (query.searchText.length > 0)
+    {
+        pattern = [query.searchText dataUsingEncoding:NSUTF8StringEncoding];
+        filter->pattern_type = LOG_QUERY_TEXT_PATTERN;
+    }
+    filter->pattern = pattern.bytes;
+    filter->pattern_length = (uint32_t)pattern.length;
+    return pattern;
+}
+
+-(NSUInteger)enumerateRecordsMatchingQuery:(LogQuery *)query usingBlock:(void (^)(const log_query_match *, BOOL *))block {
+    log_query filter;
+    NS_VALID_UNTIL_END_OF_SCOPE NSData *pattern = [self getFilter:&filter fromQuery:query];
+    NSUInteger count = 0;
+    BOOL stop = NO;
+    
+    for (NSNumber *day in [self daysForQuery:query])
+    {
+        LogDayIndex *dayIndex = [self indexForDay:day];
+        if (dayIndex == nil)
+        {
+            continue;
+        }
+        
+        log_query_cursor cursor;
+        log_query_cursor_open(&cursor, &dayIndex->index, &filter);
+        log_query_match match;
+        while (!stop && log_query_cursor_next(&cursor, &match))
+        {
+            @autoreleasepool {
+                block(&match, &stop);
+            }
+            count++;
+        }
+        if (stop)
+        {
+            break;
+        }
+    }
+    return count;
+}
+
+-(BOOL)exportRecordsMatchingQuery:(LogQuery *)query format:(log_export_format)format toURL:(NSURL *)url {
+    FILE *file = fopen(url.fileSystemRepresentation, "wb");
+    if (file == NULL)
+    {
+        return NO;
+    }
+    
+    __block BOOL written = log_export_begin(file, format);
+    if (written)
+    {
+        [self enumerateRecordsMatchingQuery:query usingBlock:^(const log_query_match *match, BOOL *stop) {
+            if (!log_export_match(file, format, match))
+            {
+                written = NO;
+                *stop = YES;
+            }
+        }];
+    }
+    if (fclose(file) != 0)
+    {
+        written = NO;
+    }
+    return written;
+}
+
+@end
@@ -0,0 +1,538 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#include "LogQueryIndex.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define LOG_QUERY_TABLE_MIN_CAPACITY    16
+#define LOG_QUERY_POSTING_MIN_CAPACITY  64
+
+#pragma mark - Postings
+
+static uint32_t log_query_hash(const uint8_t *key)
+{
+    // FNV-1a over the length byte and the key
+    uint32_t hash = 2166136261u;
+    for (uint32_t i = 0; i <= key[0]; i++)
+    {
+        hash = (hash ^ key[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static void log_query_make_key(uint8_t *key, const uint8_t *bytes, uint8_t length)
+{
+    memset(key, 0, 17);
+    key[0] = length;
+    memcpy(key + 1, bytes, length);
+}
+
+static log_query_posting *log_query_table_slot(const log_query_table *table, const uint8_t *key)
+{
+    uint32_t mask = table->capacity - 1;
+    for (uint32_t slot = log_query_hash(key) & mask;; slot = (slot + 1) & mask)
+    {
+        log_query_posting *posting = table->slots + slot;
+        if (posting->key[0] == 0 || memcmp(posting->key, key, 17) == 0)
+        {
+            return posting;
+        }
+    }
+}
+
+static const log_query_posting *log_query_table_find(const log_query_table *table, const uint8_t *key)
+{
+    if (table->capacity == 0)
+    {
+        return NULL;
+    }
+    const log_query_posting *posting = log_query_table_slot(table, key);
+    return posting->key[0] != 0 ? posting : NULL;
+}
+
+static int log_query_table_grow(log_query_table *table)
+{
+    uint32_t capacity = table->capacity > 0 ? table->capacity * 2 : LOG_QUERY_TABLE_MIN_CAPACITY;
+    log_query_posting *slots = calloc(capacity, sizeof(log_query_posting));
+    if (slots == NULL)
+    {
+        return 0;
+    }
+
+    log_query_table grown = { slots, table->used, capacity };
+    for (uint32_t i = 0; i < table->capacity; i++)
+    {
+        if (table->slots[i].key[0] != 0)
+        {
+            *log_query_table_slot(&grown, table->slots[i].key) = table->slots[i];
+        }
+    }
+    free(table->slots);
+    *table = grown;
+    return 1;
+}
+
+/*!
+ *  @function log_query_table_add
+ *
+ *  @discussion Appends record to the posting of key. Adding the last record again is a no-op, so a refresh that
+ *  failed halfway can be repeated.
+ *
+ */
+static int log_query_table_add(log_query_table *table, const uint8_t *key, uint32_t record)
+{
+    // Keep the load under 3/4 so that probes stay short
+    if ((table->used + 1) * 4 > table->capacity * 3 && !log_query_table_grow(table))
+    {
+        return 0;
+    }
+
+    log_query_posting *posting = log_query_table_slot(table, key);
+    if (posting->key[0] == 0)
+    {
+        memcpy(posting->key, key, 17);
+        table->used++;
+    }
+    if (posting->count > 0 && posting->records[posting->count - 1] == record)
+    {
+        return 1;
+    }
+    if (posting->count == posting->capacity)
+    {
+        uint32_t capacity = posting->capacity > 0 ? posting->capacity * 2 : LOG_QUERY_POSTING_MIN_CAPACITY;
+        uint32_t *records = realloc(posting->records, capacity * sizeof(uint32_t));
+        if (records == NULL)
+        {
+            return 0;
+        }
+        posting->records = records;
+        posting->capacity = capacity;
+    }
+    posting->records[posting->count++] = record;
+    return 1;
+}
+
+static void log_query_table_free(log_query_table *table)
+{
+    for (uint32_t i = 0; i < table->capacity; i++)
+    {
+        free(table->slots[i].records);
+    }
+    free(table->slots);
+    memset(table, 0, sizeof(*table));
+}
+
+/*!
+ *  @function log_query_posting_lower_bound
+ *
+ *  @discussion Returns the position of the first record not below record, searching from position start
+ *
+ */
+static uint32_t log_query_posting_lower_bound(const log_query_posting *posting, uint32_t start, uint32_t record)
+{
+    uint32_t low = start;
+    uint32_t high = posting->count;
+    while (low < high)
+    {
+        uint32_t middle = low + (high - low) / 2;
+        if (posting->records[middle] < record)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+#pragma mark - Index
+
+/*!
+ *  @function log_query_index_decode
+ *
+ *  @discussion Decodes the payload of the entry into the buffer of the index
+ *
+ */
+static int log_query_index_decode(log_query_index *index, const log_segment_entry *entry)
+{
+    if (entry->length > index->buffer_capacity)
+    {
+        uint32_t capacity = index->buffer_capacity > 0 ? index->buffer_capacity : 256;
+        while (capacity < entry->length)
+        {
+            capacity *= 2;
+        }
+        uint8_t *buffer = realloc(index->buffer, capacity);
+        if (buffer == NULL)
+        {
+            return 0;
+        }
+        index->buffer = buffer;
+        index->buffer_capacity = capacity;
+    }
+    return log_segment_entry_decode(entry, index->buffer);
+}
+
+static void log_query_index_reset(log_query_index *index)
+{
+    log_query_table_free(&index->peripherals);
+    log_query_table_free(&index->characteristics);
+    index->indexed = 0;
+    index->last_timestamp_us = INT64_MIN;
+    index->ordered = 1;
+}
+
+int log_query_index_open(log_query_index *index, const char *directory, uint32_t day)
+{
+    memset(index, 0, sizeof(*index));
+    if (!log_segment_reader_open(&index->reader, directory, day))
+    {
+        return 0;
+    }
+    log_query_index_reset(index);
+    if (!log_query_index_refresh(index))
+    {
+        log_query_index_close(index);
+        return 0;
+    }
+    return 1;
+}
+
+int log_query_index_refresh(log_query_index *index)
+{
+    if (!log_segment_reader_refresh(&index->reader))
+    {
+        return 0;
+    }
+    if (index->reader.count < index->indexed)
+    {
+        log_query_index_reset(index);
+    }
+
+    uint8_t key[17];
+    for (uint32_t i = index->indexed; i < index->reader.count; i++)
+    {
+        log_segment_entry entry;
+        log_segment_reader_entry(&index->reader, i, &entry);
+        int64_t timestamp_us = entry.timestamp_us;
+
+        gatt_trace_record trace;
+        if (entry.type == LOG_SEGMENT_TRACE_RECORD && log_query_index_decode(index, &entry)
+            && gatt_trace_record_decode(index->buffer, entry.length, &trace))
+        {
+            log_query_make_key(key, trace.peripheral, sizeof(trace.peripheral));
+            if (!log_query_table_add(&index->peripherals, key, i))
+            {
+                return 0;
+            }
+            if (trace.characteristic.length > 0)
+            {
+                log_query_make_key(key, trace.characteristic.bytes, trace.characteristic.length);
+                if (!log_query_table_add(&index->characteristics, key, i))
+                {
+                    return 0;
+                }
+            }
+        }
+
+        if (timestamp_us < index->last_timestamp_us)
+        {
+            index->ordered = 0;
+        }
+        index->last_timestamp_us = timestamp_us;
+        index->indexed = i + 1;
+    }
+    return 1;
+}
+
+void log_query_index_close(log_query_index *index)
+{
+    log_segment_reader_close(&index->reader);
+    log_query_table_free(&index->peripherals);
+    log_query_table_free(&index->characteristics);
+    free(index->buffer);
+    memset(index, 0, sizeof(*index));
+}
+
+#pragma mark - Queries
+
+/*!
+ *  @function log_query_time_lower_bound
+ *
+ *  @discussion Returns the first indexed record whose timestamp is not below timestamp_us. Valid only while the
+ *  index is ordered.
+ *
+ */
+static uint32_t log_query_time_lower_bound(const log_query_index *index, int64_t timestamp_us)
+{
+    uint32_t low = 0;
+    uint32_t high = index->indexed;
+    while (low < high)
+    {
+        uint32_t middle = low + (high - low) / 2;
+        log_segment_entry entry;
+        log_segment_reader_entry(&index->reader, middle, &entry);
+        if (entry.timestamp_us < timestamp_us)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static int log_query_contains(const uint8_t *bytes, uint32_t length, const uint8_t *pattern, uint32_t pattern_length,
+                              int ignore_case)
+{
+    if (pattern_length > length)
+    {
+        return 0;
+    }
+    for (uint32_t start = 0; start <= length - pattern_length; start++)
+    {
+        uint32_t i = 0;
+        while (i < pattern_length)
+        {
+            uint8_t a = bytes[start + i];
+            uint8_t b = pattern[i];
+            if (ignore_case)
+            {
+                a = (a >= 'A' && a <= 'Z') ? (uint8_t)(a + 32) : a;
+                b = (b >= 'A' && b <= 'Z') ? (uint8_t)(b + 32) : b;
+            }
+            if (a != b)
+            {
+                break;
+            }
+            i++;
+        }
+        if (i == pattern_length)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void log_query_cursor_open(log_query_cursor *cursor, log_query_index *index, const log_query *query)
+{
+    memset(cursor, 0, sizeof(*cursor));
+    cursor->index = index;
+    cursor->query = query;
+
+    if (query->from_us >= query->to_us)
+    {
+        return;
+    }
+    if (index->ordered)
+    {
+        cursor->next = log_query_time_lower_bound(index, query->from_us);
+        cursor->end = log_query_time_lower_bound(index, query->to_us);
+    }
+    else
+    {
+        cursor->end = index->indexed;
+    }
+
+    uint8_t key[17];
+    if (query->match_peripheral)
+    {
+        log_query_make_key(key, query->peripheral, sizeof(query->peripheral));
+        cursor->postings[cursor->posting_count++] = log_query_table_find(&index->peripherals, key);
+    }
+    if (query->characteristic.length > 0)
+    {
+        log_query_make_key(key, query->characteristic.bytes, query->characteristic.length);
+        cursor->postings[cursor->posting_count++] = log_query_table_find(&index->characteristics, key);
+    }
+
+    for (uint32_t i = 0; i < cursor->posting_count; i++)
+    {
+        if (cursor->postings[i] == NULL)
+        {
+            // Nothing carries the key
+            cursor->end = cursor->next;
+            cursor->posting_count = 0;
+            return;
+        }
+    }
+    if (cursor->posting_count == 2 && cursor->postings[1]->count < cursor->postings[0]->count)
+    {
+        const log_query_posting *shortest = cursor->postings[1];
+        cursor->postings[1] = cursor->postings[0];
+        cursor->postings[0] = shortest;
+    }
+    for (uint32_t i = 0; i < cursor->posting_count; i++)
+    {
+        cursor->positions[i] = log_query_posting_lower_bound(cursor->postings[i], 0, cursor->next);
+    }
+}
+
+/*!
+ *  @function log_query_cursor_candidate
+ *
+ *  @discussion Returns the next record in the time range that carries every key of the query, in *record. Walks the
+ *  shortest posting and looks its records up in the other one.
+ *
+ */
+static int log_query_cursor_candidate(log_query_cursor *cursor, uint32_t *record)
+{
+    if (cursor->posting_count == 0)
+    {
+        if (cursor->next >= cursor->end)
+        {
+            return 0;
+        }
+        *record = cursor->next++;
+        return 1;
+    }
+
+    const log_query_posting *driver = cursor->postings[0];
+    while (cursor->positions[0] < driver->count)
+    {
+        uint32_t candidate = driver->records[cursor->positions[0]++];
+        if (candidate >= cursor->end)
+        {
+            return 0;
+        }
+        if (cursor->posting_count == 2)
+        {
+            const log_query_posting *other = cursor->postings[1];
+            cursor->positions[1] = log_query_posting_lower_bound(other, cursor->positions[1], candidate);
+            if (cursor->positions[1] == other->count)
+            {
+                return 0;
+            }
+            if (other->records[cursor->positions[1]] != candidate)
+            {
+                continue;
+            }
+        }
+        *record = candidate;
+        return 1;
+    }
+    return 0;
+}
+
+/*!
+ *  @function log_query_cursor_check
+ *
+ *  @discussion Decodes the record and applies every filter of the query to it
+ *
+ */
+static int log_query_cursor_check(log_query_cursor *cursor, uint32_t record, log_query_match *match)
+{
+    log_query_index *index = cursor->index;
+    const log_query *query = cursor->query;
+
+    log_segment_entry entry;
+    if (!log_segment_reader_entry(&index->reader, record, &entry)
+        || entry.timestamp_us < query->from_us || entry.timestamp_us >= query->to_us)
+    {
+        return 0;
+    }
+
+    int trace_filter = query->match_peripheral || query->characteristic.length > 0 || query->operations != 0;
+    if (entry.type == LOG_SEGMENT_TEXT_RECORD && (trace_filter || query->pattern_type == LOG_QUERY_BYTE_PATTERN))
+    {
+        return 0;
+    }
+    if (!log_query_index_decode(index, &entry))
+    {
+        return 0;
+    }
+
+    memset(match, 0, sizeof(*match));
+    match->index = record;
+    match->timestamp_us = entry.timestamp_us;
+    match->type = entry.type;
+    match->payload = index->buffer;
+    match->length = entry.length;
+
+    if (entry.type == LOG_SEGMENT_TEXT_RECORD)
+    {
+        return query->pattern_type != LOG_QUERY_TEXT_PATTERN
+            || log_query_contains(match->payload, match->length, query->pattern, query->pattern_length, 1);
+    }
+
+    gatt_trace_record *trace = &match->trace;
+    if (!gatt_trace_record_decode(match->payload, match->length, trace))
+    {
+        return 0;
+    }
+    if (query->match_peripheral && memcmp(trace->peripheral, query->peripheral, sizeof(trace->peripheral)) != 0)
+    {
+        return 0;
+    }
+    if (query->characteristic.length > 0
+        && (trace->characteristic.length != query->characteristic.length
+            || memcmp(trace->characteristic.bytes, query->characteristic.bytes, query->characteristic.length) != 0))
+    {
+        return 0;
+    }
+    if (query->operations != 0 && (trace->opcode >= 32 || !(query->operations & LOG_QUERY_OPERATION(trace->opcode))))
+    {
+        return 0;
+    }
+
+    switch (query->pattern_type)
+    {
+        case LOG_QUERY_TEXT_PATTERN:
+            return trace->status != 0
+                && log_query_contains(trace->payload, trace->payload_length, query->pattern, query->pattern_length, 1);
+        case LOG_QUERY_BYTE_PATTERN:
+            return trace->status == 0
+                && log_query_contains(trace->payload, trace->payload_length, query->pattern, query->pattern_length, 0);
+        default:
+            return 1;
+    }
+}
+
+int log_query_cursor_next(log_query_cursor *cursor, log_query_match *match)
+{
+    uint32_t record;
+    while (log_query_cursor_candidate(cursor, &record))
+    {
+        if (log_query_cursor_check(cursor, record, match))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
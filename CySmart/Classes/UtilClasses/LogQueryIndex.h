@@ -0,0 +1,211 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#ifndef LogQueryIndex_h
+#define LogQueryIndex_h
+
+#include <stdint.h>
+
+#include "GATTTraceRecord.h"
+#include "LogSegmentStore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ *  @discussion Bit of an operation in log_query.operations
+ *
+ */
+#define LOG_QUERY_OPERATION(opcode)     (1u << (opcode))
+
+/*!
+ *  @discussion How log_query.pattern is matched
+ *
+ */
+typedef enum
+{
+    LOG_QUERY_NO_PATTERN = 0,
+    LOG_QUERY_TEXT_PATTERN,             // Case-insensitive text in text records and error descriptions
+    LOG_QUERY_BYTE_PATTERN              // Byte sequence in the values of successful GATT operations
+} log_query_pattern_type;
+
+/*!
+ *  @struct log_query
+ *
+ *  @discussion Filter of a query. Records match when their timestamp lies in [from_us, to_us) and they pass every
+ *  filter that is set. Setting the peripheral, the characteristic or the operations leaves out text records.
+ *
+ */
+typedef struct
+{
+    int64_t from_us;
+    int64_t to_us;
+    int match_peripheral;
+    uint8_t peripheral[16];
+    gatt_trace_uuid characteristic;     // length 0 matches any characteristic
+    uint32_t operations;                // LOG_QUERY_OPERATION bits, 0 matches any operation
+    log_query_pattern_type pattern_type;
+    const uint8_t *pattern;
+    uint32_t pattern_length;
+} log_query;
+
+/*!
+ *  @struct log_query_posting
+ *
+ *  @discussion Ascending indexes of the records that carry a key. key[0] is the key length.
+ *
+ */
+typedef struct
+{
+    uint8_t key[17];
+    uint32_t *records;
+    uint32_t count;
+    uint32_t capacity;
+} log_query_posting;
+
+/*!
+ *  @struct log_query_table
+ *
+ *  @discussion Open-addressed hash table of postings
+ *
+ */
+typedef struct
+{
+    log_query_posting *slots;
+    uint32_t used;
+    uint32_t capacity;
+} log_query_table;
+
+/*!
+ *  @struct log_query_index
+ *
+ *  @discussion Segment reader with per-peripheral and per-characteristic indexes of its trace records. Records are
+ *  looked up by time with a binary search as long as their timestamps never decrease, which holds unless the clock
+ *  was set back while logging.
+ *
+ */
+typedef struct
+{
+    log_segment_reader reader;
+    log_query_table peripherals;
+    log_query_table characteristics;
+    uint32_t indexed;                   // Records added to the tables
+    int64_t last_timestamp_us;
+    int ordered;                        // Timestamps of the indexed records never decrease
+    uint8_t *buffer;                    // Decoded payload
+    uint32_t buffer_capacity;
+} log_query_index;
+
+/*!
+ *  @struct log_query_match
+ *
+ *  @discussion Record found by a query. payload holds the decoded payload and, for trace records, trace points into
+ *  it; both stay valid until the next call on the cursor.
+ *
+ */
+typedef struct
+{
+    uint32_t index;
+    int64_t timestamp_us;
+    log_segment_record_type type;
+    const uint8_t *payload;
+    uint32_t length;
+    gatt_trace_record trace;
+} log_query_match;
+
+/*!
+ *  @struct log_query_cursor
+ *
+ *  @discussion Walks the records of an index that match a query, one at a time. The index must not be refreshed
+ *  while a cursor is open on it.
+ *
+ */
+typedef struct
+{
+    log_query_index *index;
+    const log_query *query;
+    const log_query_posting *postings[2];   // Shortest first
+    uint32_t posting_count;
+    uint32_t positions[2];
+    uint32_t next;                      // Next record in the time range
+    uint32_t end;                       // End of the time range
+} log_query_cursor;
+
+/*!
+ *  @function log_query_index_open
+ *
+ *  @discussion Opens the segment of the day and indexes its records. Returns 0 on failure.
+ *
+ */
+int log_query_index_open(log_query_index *index, const char *directory, uint32_t day);
+
+/*!
+ *  @function log_query_index_refresh
+ *
+ *  @discussion Picks up the records appended to the segment and indexes only those. A segment that was removed and
+ *  started again is indexed from the start. Returns 0 on failure.
+ *
+ */
+int log_query_index_refresh(log_query_index *index);
+
+/*!
+ *  @function log_query_index_close
+ *
+ *  @discussion Closes the segment and releases the indexes
+ *
+ */
+void log_query_index_close(log_query_index *index);
+
+/*!
+ *  @function log_query_cursor_open
+ *
+ *  @discussion Prepares a cursor over the records of the index that match the query. The query must outlive the
+ *  cursor. Needs no cleanup.
+ *
+ */
+void log_query_cursor_open(log_query_cursor *cursor, log_query_index *index, const log_query *query);
+
+/*!
+ *  @function log_query_cursor_next
+ *
+ *  @discussion Fills match with the next matching record. Returns 0 when there are no more. Corrupt records are
+ *  skipped.
+ *
+ */
+int log_query_cursor_next(log_query_cursor *cursor, log_query_match *match);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LogQueryIndex_h */
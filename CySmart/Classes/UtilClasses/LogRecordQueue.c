@@ -0,0 +1,154 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#include "LogRecordQueue.h"
+
+#include <stdlib.h>
+
+int log_record_queue_init(log_record_queue *queue, size_t capacity)
+{
+    size_t size = 2;
+    while (size < capacity)
+    {
+        size <<= 1;
+    }
+
+    queue->slots = malloc(size * sizeof(log_record_slot));
+    if (queue->slots == NULL)
+    {
+        return 0;
+    }
+
+    for (size_t i = 0; i < size; i++)
+    {
+        atomic_init(&queue->slots[i].sequence, i);
+    }
+    queue->mask = size - 1;
+    atomic_init(&queue->enqueue_position, 0);
+    atomic_init(&queue->dequeue_position, 0);
+    atomic_init(&queue->dropped, 0);
+    atomic_init(&queue->high_water, 0);
+    return 1;
+}
+
+void log_record_queue_free(log_record_queue *queue)
+{
+    free(queue->slots);
+    queue->slots = NULL;
+}
+
+int log_record_queue_push(log_record_queue *queue, double timestamp, void *payload, size_t *depth)
+{
+    size_t position = atomic_load_explicit(&queue->enqueue_position, memory_order_relaxed);
+    log_record_slot *slot;
+
+    for (;;)
+    {
+        slot = &queue->slots[position & queue->mask];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+        if (difference == 0)
+        {
+            // The slot is free for this position; claim it unless another producer got there first
+            if (atomic_compare_exchange_weak_explicit(&queue->enqueue_position, &position, position + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            // The consumer has not freed the slot of the previous lap yet: full
+            atomic_fetch_add_explicit(&queue->dropped, 1, memory_order_relaxed);
+            return 0;
+        }
+        else
+        {
+            position = atomic_load_explicit(&queue->enqueue_position, memory_order_relaxed);
+        }
+    }
+
+    // Read before the slot is published: the consumer cannot pass an unpublished slot, so the depth is at least 1
+    size_t record_depth = position + 1 - atomic_load_explicit(&queue->dequeue_position, memory_order_relaxed);
+    size_t high_water = atomic_load_explicit(&queue->high_water, memory_order_relaxed);
+    while (record_depth > high_water
+           && !atomic_compare_exchange_weak_explicit(&queue->high_water, &high_water, record_depth,
+                                                     memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+
+    slot->record.timestamp = timestamp;
+    slot->record.payload = payload;
+    atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+
+    if (depth != NULL)
+    {
+        *depth = record_depth;
+    }
+    return 1;
+}
+
+int log_record_queue_pop(log_record_queue *queue, log_record *record)
+{
+    size_t position = atomic_load_explicit(&queue->dequeue_position, memory_order_relaxed);
+    log_record_slot *slot = &queue->slots[position & queue->mask];
+    size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+
+    // Empty, or the producer of this position has claimed the slot but not filled it yet
+    if ((intptr_t)sequence - (intptr_t)(position + 1) < 0)
+    {
+        return 0;
+    }
+
+    *record = slot->record;
+    atomic_store_explicit(&queue->dequeue_position, position + 1, memory_order_relaxed);
+    atomic_store_explicit(&slot->sequence, position + queue->mask + 1, memory_order_release);
+    return 1;
+}
+
+size_t log_record_queue_depth(log_record_queue *queue)
+{
+    size_t dequeue = atomic_load_explicit(&queue->dequeue_position, memory_order_relaxed);
+    size_t enqueue = atomic_load_explicit(&queue->enqueue_position, memory_order_relaxed);
+    return enqueue > dequeue ? enqueue - dequeue : 0;
+}
+
+uint64_t log_record_queue_dropped(log_record_queue *queue)
+{
+    return atomic_load_explicit(&queue->dropped, memory_order_relaxed);
+}
+
+size_t log_record_queue_high_water(log_record_queue *queue)
+{
+    return atomic_load_explicit(&queue->high_water, memory_order_relaxed);
+}
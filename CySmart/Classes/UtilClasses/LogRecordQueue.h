@@ -0,0 +1,144 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#ifndef LogRecordQueue_h
+#define LogRecordQueue_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ *  @struct log_record
+ *
+ *  @discussion Log record waiting to be written. The payload is owned by the queue while the record is queued.
+ *
+ */
+typedef struct
+{
+    double timestamp;
+    void *payload;
+} log_record;
+
+typedef struct
+{
+    _Atomic size_t sequence;
+    log_record record;
+} log_record_slot;
+
+/*!
+ *  @struct log_record_queue
+ *
+ *  @discussion Bounded lock-free queue of log records. Any number of threads push; a single writer pops. Each slot
+ *  carries a sequence number telling whether it is free for the producer of that position or filled for the consumer,
+ *  so neither side ever takes a lock or waits. A push into a full queue drops the record and counts it instead of
+ *  blocking the caller, which is usually a CoreBluetooth callback.
+ *
+ */
+typedef struct
+{
+    log_record_slot *slots;
+    size_t mask;                        // Capacity - 1, the capacity is a power of two
+    _Atomic size_t enqueue_position;
+    char padding[64];                   // Keeps the producer and consumer positions on separate cache lines
+    _Atomic size_t dequeue_position;
+    _Atomic uint64_t dropped;
+    _Atomic size_t high_water;
+} log_record_queue;
+
+/*!
+ *  @function log_record_queue_init
+ *
+ *  @discussion Initializes the queue with capacity rounded up to a power of two. Returns 0 if the slots cannot be
+ *  allocated.
+ *
+ */
+int log_record_queue_init(log_record_queue *queue, size_t capacity);
+
+/*!
+ *  @function log_record_queue_free
+ *
+ *  @discussion Releases the slots. Pop every record first, the queue does not know how to release payloads.
+ *
+ */
+void log_record_queue_free(log_record_queue *queue);
+
+/*!
+ *  @function log_record_queue_push
+ *
+ *  @discussion Appends a record. Returns 0 if the queue was full and the record was dropped; the caller keeps ownership
+ *  of the payload in that case. On success depth, if not NULL, receives the queue depth including the record.
+ *
+ */
+int log_record_queue_push(log_record_queue *queue, double timestamp, void *payload, size_t *depth);
+
+/*!
+ *  @function log_record_queue_pop
+ *
+ *  @discussion Removes the oldest record. Returns 0 if the queue is empty. Only one thread may pop at a time.
+ *
+ */
+int log_record_queue_pop(log_record_queue *queue, log_record *record);
+
+/*!
+ *  @function log_record_queue_depth
+ *
+ *  @discussion Returns the number of queued records. The value is a snapshot while producers are active.
+ *
+ */
+size_t log_record_queue_depth(log_record_queue *queue);
+
+/*!
+ *  @function log_record_queue_dropped
+ *
+ *  @discussion Returns the number of records dropped because the queue was full
+ *
+ */
+uint64_t log_record_queue_dropped(log_record_queue *queue);
+
+/*!
+ *  @function log_record_queue_high_water
+ *
+ *  @discussion Returns the largest depth the queue reached
+ *
+ */
+size_t log_record_queue_high_water(log_record_queue *queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LogRecordQueue_h */
@@ -0,0 +1,797 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#include "LogSegmentStore.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define LOG_SEGMENT_MAGIC               "CYLG"
+#define LOG_SEGMENT_VERSION             1
+#define LOG_SEGMENT_EXTENSION           ".cylog"
+#define LOG_SEGMENT_UNREADABLE_SUFFIX   ".unreadable"
+#define LOG_SEGMENT_COMPRESSED_FLAG     0x80000000u
+#define LOG_SEGMENT_TRACE_FLAG          0x40000000u
+#define LOG_SEGMENT_MAX_STORED_LENGTH   0x3FFFFFFFu
+#define LOG_SEGMENT_FLUSH_THRESHOLD     (64 * 1024)
+
+#define LOG_LZ_HASH_BITS                12
+#define LOG_LZ_MIN_MATCH                4
+#define LOG_LZ_LAST_LITERALS            5   // The block format ends with at least 5 literals
+#define LOG_LZ_MATCH_LIMIT              12  // No match starts in the last 12 bytes
+#define LOG_LZ_MAX_OFFSET               65535
+
+#pragma mark - Byte order
+
+static void log_segment_put32(uint8_t *bytes, uint32_t value)
+{
+    bytes[0] = (uint8_t)value;
+    bytes[1] = (uint8_t)(value >> 8);
+    bytes[2] = (uint8_t)(value >> 16);
+    bytes[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t log_segment_get32(const uint8_t *bytes)
+{
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+#pragma mark - LZ4 block codec
+
+static uint32_t log_lz_read32(const uint8_t *bytes)
+{
+    uint32_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+static uint32_t log_lz_hash(uint32_t value)
+{
+    return (value * 2654435761u) >> (32 - LOG_LZ_HASH_BITS);
+}
+
+static uint8_t *log_lz_put_length(uint8_t *output, size_t length)
+{
+    while (length >= 255)
+    {
+        *output++ = 255;
+        length -= 255;
+    }
+    *output++ = (uint8_t)length;
+    return output;
+}
+
+/*!
+ *  @function log_lz_compress
+ *
+ *  @discussion Greedy single-pass LZ4 block compressor. Returns the compressed size, 0 if it does not fit in capacity.
+ *
+ */
+static size_t log_lz_compress(const uint8_t *input, size_t length, uint8_t *output, size_t capacity)
+{
+    uint32_t table[1 << LOG_LZ_HASH_BITS];
+    const uint8_t *ip = input;
+    const uint8_t *anchor = input;
+    const uint8_t *end = input + length;
+    uint8_t *op = output;
+    uint8_t *output_end = output + capacity;
+
+    memset(table, 0, sizeof(table));
+
+    if (length > LOG_LZ_MATCH_LIMIT)
+    {
+        const uint8_t *match_limit = end - LOG_LZ_MATCH_LIMIT;
+        const uint8_t *extend_limit = end - LOG_LZ_LAST_LITERALS;
+
+        while (ip < match_limit)
+        {
+            uint32_t sequence = log_lz_read32(ip);
+            uint32_t hash = log_lz_hash(sequence);
+            const uint8_t *reference = input + table[hash];
+            table[hash] = (uint32_t)(ip - input);
+
+            if (reference >= ip || ip - reference > LOG_LZ_MAX_OFFSET || log_lz_read32(reference) != sequence)
+            {
+                ip++;
+                continue;
+            }
+
+            const uint8_t *match_end = ip + LOG_LZ_MIN_MATCH;
+            const uint8_t *reference_end = reference + LOG_LZ_MIN_MATCH;
+            while (match_end < extend_limit && *match_end == *reference_end)
+            {
+                match_end++;
+                reference_end++;
+            }
+
+            size_t literals = (size_t)(ip - anchor);
+            size_t match_length = (size_t)(match_end - ip) - LOG_LZ_MIN_MATCH;
+            if ((size_t)(output_end - op) < 1 + literals + literals / 255 + 1 + 2 + match_length / 255 + 1)
+            {
+                return 0;
+            }
+
+            uint8_t *token = op++;
+            *token = (uint8_t)((literals >= 15 ? 15 : literals) << 4);
+            if (literals >= 15)
+            {
+                op = log_lz_put_length(op, literals - 15);
+            }
+            memcpy(op, anchor, literals);
+            op += literals;
+
+            uint16_t offset = (uint16_t)(ip - reference);
+            *op++ = (uint8_t)offset;
+            *op++ = (uint8_t)(offset >> 8);
+
+            *token |= (uint8_t)(match_length >= 15 ? 15 : match_length);
+            if (match_length >= 15)
+            {
+                op = log_lz_put_length(op, match_length - 15);
+            }
+
+            ip = match_end;
+            anchor = ip;
+        }
+    }
+
+    size_t literals = (size_t)(end - anchor);
+    if ((size_t)(output_end - op) < 1 + literals + literals / 255 + 1)
+    {
+        return 0;
+    }
+    uint8_t *token = op++;
+    *token = (uint8_t)((literals >= 15 ? 15 : literals) << 4);
+    if (literals >= 15)
+    {
+        op = log_lz_put_length(op, literals - 15);
+    }
+    memcpy(op, anchor, literals);
+    op += literals;
+    return (size_t)(op - output);
+}
+
+/*!
+ *  @function log_lz_decompress
+ *
+ *  @discussion Decodes an LZ4 block. Returns 1 only if the block decodes to exactly length bytes without reading or
+ *  writing out of bounds.
+ *
+ */
+static int log_lz_decompress(const uint8_t *input, size_t input_length, uint8_t *output, size_t length)
+{
+    const uint8_t *ip = input;
+    const uint8_t *input_end = input + input_length;
+    uint8_t *op = output;
+    uint8_t *output_end = output + length;
+
+    while (ip < input_end)
+    {
+        uint8_t token = *ip++;
+        size_t literals = token >> 4;
+        if (literals == 15)
+        {
+            uint8_t extra;
+            do
+            {
+                if (ip == input_end)
+                {
+                    return 0;
+                }
+                extra = *ip++;
+                literals += extra;
+            } while (extra == 255);
+        }
+        if (literals > (size_t)(input_end - ip) || literals > (size_t)(output_end - op))
+        {
+            return 0;
+        }
+        memcpy(op, ip, literals);
+        ip += literals;
+        op += literals;
+
+        if (ip == input_end)
+        {
+            break;
+        }
+
+        if (input_end - ip < 2)
+        {
+            return 0;
+        }
+        size_t offset = ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - output))
+        {
+            return 0;
+        }
+
+        size_t match_length = token & 15;
+        if (match_length == 15)
+        {
+            uint8_t extra;
+            do
+            {
+                if (ip == input_end)
+                {
+                    return 0;
+                }
+                extra = *ip++;
+                match_length += extra;
+            } while (extra == 255);
+        }
+        match_length += LOG_LZ_MIN_MATCH;
+        if (match_length > (size_t)(output_end - op))
+        {
+            return 0;
+        }
+
+        // Matches may overlap their own output, so copy forward byte by byte
+        const uint8_t *match = op - offset;
+        for (size_t i = 0; i < match_length; i++)
+        {
+            op[i] = match[i];
+        }
+        op += match_length;
+    }
+    return op == output_end;
+}
+
+#pragma mark - Segment files
+
+static char *log_segment_path(const char *directory, uint32_t day)
+{
+    size_t length = strlen(directory) + 32;
+    char *path = malloc(length);
+    if (path != NULL)
+    {
+        snprintf(path, length, "%s/%08u%s", directory, day, LOG_SEGMENT_EXTENSION);
+    }
+    return path;
+}
+
+/*!
+ *  @function log_segment_unreadable_path
+ *
+ *  @discussion Returns the path an unreadable segment is moved to, next to the segment path
+ *
+ */
+static char *log_segment_unreadable_path(const char *path)
+{
+    size_t length = strlen(path) + sizeof(LOG_SEGMENT_UNREADABLE_SUFFIX);
+    char *unreadable_path = malloc(length);
+    if (unreadable_path != NULL)
+    {
+        snprintf(unreadable_path, length, "%s%s", path, LOG_SEGMENT_UNREADABLE_SUFFIX);
+    }
+    return unreadable_path;
+}
+
+/*!
+ *  @function log_segment_set_aside
+ *
+ *  @discussion Moves an unreadable segment out of the way of the writer. Fails rather than replace a segment set aside
+ *  before, so the only copy of a log is never lost.
+ *
+ */
+static int log_segment_set_aside(const char *path)
+{
+    char *unreadable_path = log_segment_unreadable_path(path);
+    if (unreadable_path == NULL)
+    {
+        return 0;
+    }
+    int moved = link(path, unreadable_path) == 0 && unlink(path) == 0;
+    free(unreadable_path);
+    return moved;
+}
+
+static int log_segment_valid_header(const uint8_t *bytes, size_t length, uint32_t day)
+{
+    return length >= LOG_SEGMENT_FILE_HEADER_SIZE
+        && memcmp(bytes, LOG_SEGMENT_MAGIC, 4) == 0
+        && (bytes[4] | (bytes[5] << 8)) == LOG_SEGMENT_VERSION
+        && (bytes[6] | (bytes[7] << 8)) == LOG_SEGMENT_FILE_HEADER_SIZE
+        && log_segment_get32(bytes + 8) == day
+        && log_segment_get32(bytes + 12) == LOG_SEGMENT_RECORD_HEADER_SIZE;
+}
+
+/*!
+ *  @function log_segment_walk
+ *
+ *  @discussion Follows the record chain of a mapped segment from the record at offset. Stores the record offsets if
+ *  offsets is not NULL and returns the number of complete records; *valid_length receives the end of the last one.
+ *
+ */
+static uint32_t log_segment_walk(const uint8_t *map, size_t length, size_t offset, uint32_t *offsets,
+                                 size_t *valid_length)
+{
+    uint32_t count = 0;
+
+    while (length - offset >= LOG_SEGMENT_RECORD_HEADER_SIZE)
+    {
+        uint32_t stored = log_segment_get32(map + offset + 12) & LOG_SEGMENT_MAX_STORED_LENGTH;
+        if (stored > length - offset - LOG_SEGMENT_RECORD_HEADER_SIZE)
+        {
+            break;
+        }
+        if (offsets != NULL)
+        {
+            offsets[count] = (uint32_t)offset;
+        }
+        count++;
+        offset += LOG_SEGMENT_RECORD_HEADER_SIZE + stored;
+    }
+
+    *valid_length = offset;
+    return count;
+}
+
+/*!
+ *  @function log_segment_writer_open_day
+ *
+ *  @discussion Opens the segment of the day for appending, creating it or cutting off a partial last record. A file
+ *  without a valid header is set aside, and the day starts over in a new segment.
+ *
+ */
+static int log_segment_writer_open_day(log_segment_writer *writer, uint32_t day)
+{
+    char *path = log_segment_path(writer->directory, day);
+    if (path == NULL)
+    {
+        return 0;
+    }
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+    {
+        free(path);
+        return 0;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        free(path);
+        return 0;
+    }
+
+    size_t length = (size_t)info.st_size;
+    size_t valid_length = 0;
+    if (length > 0)
+    {
+        uint8_t *map = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED)
+        {
+            // A segment that cannot be checked is left alone
+            close(fd);
+            free(path);
+            return 0;
+        }
+        if (log_segment_valid_header(map, length, day))
+        {
+            log_segment_walk(map, length, LOG_SEGMENT_FILE_HEADER_SIZE, NULL, &valid_length);
+        }
+        munmap(map, length);
+
+        if (valid_length == 0)
+        {
+            // Keep the unreadable file for inspection instead of writing over it
+            close(fd);
+            fd = log_segment_set_aside(path) ? open(path, O_RDWR | O_CREAT | O_EXCL, 0644) : -1;
+            if (fd < 0)
+            {
+                free(path);
+                return 0;
+            }
+        }
+    }
+    free(path);
+
+    if (valid_length == 0)
+    {
+        // The segment is empty here: new, or the unreadable one was set aside
+        uint8_t header[LOG_SEGMENT_FILE_HEADER_SIZE] = { 'C', 'Y', 'L', 'G', LOG_SEGMENT_VERSION, 0, LOG_SEGMENT_FILE_HEADER_SIZE, 0 };
+        log_segment_put32(header + 8, day);
+        log_segment_put32(header + 12, LOG_SEGMENT_RECORD_HEADER_SIZE);
+        if (pwrite(fd, header, sizeof(header), 0) != (ssize_t)sizeof(header))
+        {
+            close(fd);
+            return 0;
+        }
+        valid_length = sizeof(header);
+    }
+    else if (valid_length < length && ftruncate(fd, (off_t)valid_length) != 0)
+    {
+        close(fd);
+        return 0;
+    }
+
+    if (lseek(fd, (off_t)valid_length, SEEK_SET) < 0)
+    {
+        close(fd);
+        return 0;
+    }
+
+    writer->fd = fd;
+    writer->day = day;
+    return 1;
+}
+
+static void log_segment_writer_close_day(log_segment_writer *writer)
+{
+    log_segment_writer_flush(writer);
+    if (writer->fd >= 0)
+    {
+        close(writer->fd);
+    }
+    writer->fd = -1;
+    writer->day = 0;
+}
+
+static int log_segment_writer_reserve(uint8_t **buffer, size_t *capacity, size_t needed)
+{
+    if (needed <= *capacity)
+    {
+        return 1;
+    }
+    size_t size = *capacity > 0 ? *capacity : 4096;
+    while (size < needed)
+    {
+        size *= 2;
+    }
+    uint8_t *grown = realloc(*buffer, size);
+    if (grown == NULL)
+    {
+        return 0;
+    }
+    *buffer = grown;
+    *capacity = size;
+    return 1;
+}
+
+int log_segment_writer_open(log_segment_writer *writer, const char *directory, int compress)
+{
+    memset(writer, 0, sizeof(*writer));
+    writer->fd = -1;
+    writer->compress = compress;
+    writer->directory = strdup(directory);
+    return writer->directory != NULL;
+}
+
+int log_segment_writer_append(log_segment_writer *writer, uint32_t day, int64_t timestamp_us,
+                              log_segment_record_type type, const void *payload, uint32_t length)
+{
+    if (length > LOG_SEGMENT_MAX_STORED_LENGTH)
+    {
+        return 0;
+    }
+    if (day != writer->day)
+    {
+        log_segment_writer_close_day(writer);
+        if (!log_segment_writer_open_day(writer, day))
+        {
+            return 0;
+        }
+    }
+
+    const uint8_t *stored = payload;
+    uint32_t stored_length = length;
+    uint32_t flags = type == LOG_SEGMENT_TRACE_RECORD ? LOG_SEGMENT_TRACE_FLAG : 0;
+
+    if (writer->compress && length >= LOG_SEGMENT_MIN_COMPRESS_LENGTH
+        && log_segment_writer_reserve(&writer->scratch, &writer->scratch_capacity, length))
+    {
+        // Keep the compressed form only if it is smaller
+        size_t compressed = log_lz_compress(payload, length, writer->scratch, length - 1);
+        if (compressed > 0)
+        {
+            stored = writer->scratch;
+            stored_length = (uint32_t)compressed;
+            flags |= LOG_SEGMENT_COMPRESSED_FLAG;
+        }
+    }
+
+    size_t record_length = LOG_SEGMENT_RECORD_HEADER_SIZE + stored_length;
+    if (!log_segment_writer_reserve(&writer->buffer, &writer->capacity, writer->buffered + record_length))
+    {
+        return 0;
+    }
+
+    uint8_t *header = writer->buffer + writer->buffered;
+    log_segment_put32(header, (uint32_t)(uint64_t)timestamp_us);
+    log_segment_put32(header + 4, (uint32_t)((uint64_t)timestamp_us >> 32));
+    log_segment_put32(header + 8, length);
+    log_segment_put32(header + 12, stored_length | flags);
+    memcpy(header + LOG_SEGMENT_RECORD_HEADER_SIZE, stored, stored_length);
+    writer->buffered += record_length;
+
+    if (writer->buffered >= LOG_SEGMENT_FLUSH_THRESHOLD)
+    {
+        return log_segment_writer_flush(writer);
+    }
+    return 1;
+}
+
+int log_segment_writer_flush(log_segment_writer *writer)
+{
+    size_t written = 0;
+    while (writer->fd >= 0 && written < writer->buffered)
+    {
+        ssize_t result = write(writer->fd, writer->buffer + written, writer->buffered - written);
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            writer->buffered = 0;
+            return 0;
+        }
+        written += (size_t)result;
+    }
+    writer->buffered = 0;
+    return 1;
+}
+
+int log_segment_writer_remove_day(log_segment_writer *writer, uint32_t day)
+{
+    if (day == writer->day)
+    {
+        writer->buffered = 0;
+        log_segment_writer_close_day(writer);
+    }
+
+    char *path = log_segment_path(writer->directory, day);
+    if (path == NULL)
+    {
+        return 0;
+    }
+    int removed = unlink(path) == 0 || errno == ENOENT;
+    char *unreadable_path = log_segment_unreadable_path(path);
+    if (unreadable_path != NULL)
+    {
+        removed = (unlink(unreadable_path) == 0 || errno == ENOENT) && removed;
+        free(unreadable_path);
+    }
+    free(path);
+    return removed;
+}
+
+void log_segment_writer_close(log_segment_writer *writer)
+{
+    log_segment_writer_close_day(writer);
+    free(writer->directory);
+    free(writer->buffer);
+    free(writer->scratch);
+    memset(writer, 0, sizeof(*writer));
+    writer->fd = -1;
+}
+
+static int log_segment_compare_days(const void *first, const void *second)
+{
+    uint32_t a = *(const uint32_t *)first;
+    uint32_t b = *(const uint32_t *)second;
+    return (a > b) - (a < b);
+}
+
+size_t log_segment_list_days(const char *directory, uint32_t *days, size_t max_days)
+{
+    DIR *dir = opendir(directory);
+    if (dir == NULL)
+    {
+        return 0;
+    }
+
+    size_t count = 0;
+    size_t extension_length = strlen(LOG_SEGMENT_EXTENSION);
+    struct dirent *item;
+    while ((item = readdir(dir)) != NULL)
+    {
+        const char *name = item->d_name;
+        if (strlen(name) != 8 + extension_length || strcmp(name + 8, LOG_SEGMENT_EXTENSION) != 0)
+        {
+            continue;
+        }
+
+        uint32_t day = 0;
+        int digits = 1;
+        for (int i = 0; i < 8; i++)
+        {
+            if (name[i] < '0' || name[i] > '9')
+            {
+                digits = 0;
+                break;
+            }
+            day = day * 10 + (uint32_t)(name[i] - '0');
+        }
+        if (!digits || day == 0)
+        {
+            continue;
+        }
+
+        if (count < max_days)
+        {
+            days[count] = day;
+        }
+        count++;
+    }
+    closedir(dir);
+
+    qsort(days, count < max_days ? count : max_days, sizeof(uint32_t), log_segment_compare_days);
+    return count;
+}
+
+#pragma mark - Reading
+
+int log_segment_reader_open(log_segment_reader *reader, const char *directory, uint32_t day)
+{
+    memset(reader, 0, sizeof(*reader));
+
+    reader->path = log_segment_path(directory, day);
+    reader->day = day;
+    if (reader->path == NULL)
+    {
+        return 0;
+    }
+    if (!log_segment_reader_refresh(reader))
+    {
+        log_segment_reader_close(reader);
+        return 0;
+    }
+    return 1;
+}
+
+int log_segment_reader_refresh(log_segment_reader *reader)
+{
+    int fd = open(reader->path, O_RDONLY);
+    if (fd < 0)
+    {
+        return errno == ENOENT;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (uint64_t)info.st_size > UINT32_MAX)
+    {
+        close(fd);
+        return 0;
+    }
+
+    size_t length = (size_t)info.st_size;
+    if (length < LOG_SEGMENT_FILE_HEADER_SIZE || length == reader->map_length)
+    {
+        // No header written yet, or nothing appended
+        close(fd);
+        return 1;
+    }
+
+    uint8_t *map = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        return 0;
+    }
+
+    size_t start = reader->indexed_length;
+    uint32_t count = reader->count;
+    if (length < reader->map_length || start == 0)
+    {
+        if (!log_segment_valid_header(map, length, reader->day))
+        {
+            munmap(map, length);
+            return 0;
+        }
+        start = LOG_SEGMENT_FILE_HEADER_SIZE;
+        count = 0;
+    }
+
+    // Count the new records first, then walk the chain again to fill the index
+    size_t valid_length;
+    uint32_t added = log_segment_walk(map, length, start, NULL, &valid_length);
+    if (count + added > reader->capacity || reader->offsets == NULL)
+    {
+        uint32_t capacity = reader->capacity > 0 ? reader->capacity : 256;
+        while (capacity < count + added)
+        {
+            capacity *= 2;
+        }
+        uint32_t *offsets = realloc(reader->offsets, capacity * sizeof(uint32_t));
+        if (offsets == NULL)
+        {
+            munmap(map, length);
+            return 0;
+        }
+        reader->offsets = offsets;
+        reader->capacity = capacity;
+    }
+    log_segment_walk(map, length, start, reader->offsets + count, &valid_length);
+
+    if (reader->map != NULL)
+    {
+        munmap(reader->map, reader->map_length);
+    }
+    reader->map = map;
+    reader->map_length = length;
+    reader->indexed_length = valid_length;
+    reader->count = count + added;
+    return 1;
+}
+
+int log_segment_reader_entry(const log_segment_reader *reader, uint32_t index, log_segment_entry *entry)
+{
+    if (index >= reader->count)
+    {
+        return 0;
+    }
+
+    const uint8_t *header = reader->map + reader->offsets[index];
+    uint32_t stored = log_segment_get32(header + 12);
+    entry->timestamp_us = (int64_t)((uint64_t)log_segment_get32(header) | ((uint64_t)log_segment_get32(header + 4) << 32));
+    entry->length = log_segment_get32(header + 8);
+    entry->stored_length = stored & LOG_SEGMENT_MAX_STORED_LENGTH;
+    entry->compressed = (stored & LOG_SEGMENT_COMPRESSED_FLAG) != 0;
+    entry->type = (stored & LOG_SEGMENT_TRACE_FLAG) ? LOG_SEGMENT_TRACE_RECORD : LOG_SEGMENT_TEXT_RECORD;
+    entry->payload = header + LOG_SEGMENT_RECORD_HEADER_SIZE;
+    return 1;
+}
+
+int log_segment_entry_decode(const log_segment_entry *entry, uint8_t *buffer)
+{
+    if (!entry->compressed)
+    {
+        if (entry->stored_length != entry->length)
+        {
+            return 0;
+        }
+        memcpy(buffer, entry->payload, entry->length);
+        return 1;
+    }
+    return log_lz_decompress(entry->payload, entry->stored_length, buffer, entry->length);
+}
+
+void log_segment_reader_close(log_segment_reader *reader)
+{
+    if (reader->map != NULL)
+    {
+        munmap(reader->map, reader->map_length);
+    }
+    free(reader->offsets);
+    free(reader->path);
+    memset(reader, 0, sizeof(*reader));
+}
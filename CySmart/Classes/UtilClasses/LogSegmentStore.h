@@ -0,0 +1,235 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#ifndef LogSegmentStore_h
+#define LogSegmentStore_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ *  @discussion Size of the header at the start of every segment file
+ *
+ */
+#define LOG_SEGMENT_FILE_HEADER_SIZE    16
+
+/*!
+ *  @discussion Size of the header in front of every record payload
+ *
+ */
+#define LOG_SEGMENT_RECORD_HEADER_SIZE  16
+
+/*!
+ *  @discussion Payloads shorter than this are never compressed
+ *
+ */
+#define LOG_SEGMENT_MIN_COMPRESS_LENGTH 32
+
+/*!
+ *  @discussion Kinds of record payload
+ *
+ */
+typedef enum
+{
+    LOG_SEGMENT_TEXT_RECORD = 0,        // UTF-8 text
+    LOG_SEGMENT_TRACE_RECORD            // Encoded gatt_trace_record
+} log_segment_record_type;
+
+/*!
+ *  @struct log_segment_writer
+ *
+ *  @discussion Appends log records to one segment file per day in a directory. Days are keys of the form YYYYMMDD
+ *  chosen by the caller; a segment is named after its day, so dropping a day removes one file.
+ *
+ *  A segment file starts with a LOG_SEGMENT_FILE_HEADER_SIZE header: the magic "CYLG", the format version (16 bits),
+ *  the header size (16 bits), the day (32 bits) and the record header size (32 bits). Every record follows as a
+ *  LOG_SEGMENT_RECORD_HEADER_SIZE header and the payload: the timestamp in microseconds since 1970 (64 bits), the
+ *  payload length (32 bits) and the stored length (30 bits) with the compressed flag in the top bit and the trace
+ *  record flag below it. Integers are little endian. Compressed payloads use the LZ4 block format.
+ *
+ *  Records are buffered until log_segment_writer_flush. A record cut short by a crash is removed when the segment is
+ *  opened again.
+ *
+ */
+typedef struct
+{
+    char *directory;
+    int compress;
+    uint32_t day;                       // Day of the open segment, 0 if none
+    int fd;
+    uint8_t *buffer;
+    size_t buffered;
+    size_t capacity;
+    uint8_t *scratch;                   // Compression output
+    size_t scratch_capacity;
+} log_segment_writer;
+
+/*!
+ *  @struct log_segment_reader
+ *
+ *  @discussion Read-only view of a segment. The file is memory-mapped and indexed when opened; records appended later
+ *  become visible with log_segment_reader_refresh, which only indexes the new part of the file.
+ *
+ */
+typedef struct
+{
+    char *path;
+    uint32_t day;
+    uint8_t *map;
+    size_t map_length;
+    size_t indexed_length;              // End of the last indexed record
+    uint32_t *offsets;                  // File offset of every record header
+    uint32_t count;
+    uint32_t capacity;                  // Entries allocated in offsets
+} log_segment_reader;
+
+/*!
+ *  @struct log_segment_entry
+ *
+ *  @discussion Record of a segment. payload points into the mapping of the reader and holds stored_length bytes.
+ *
+ */
+typedef struct
+{
+    int64_t timestamp_us;
+    uint32_t length;
+    uint32_t stored_length;
+    int compressed;
+    log_segment_record_type type;
+    const uint8_t *payload;
+} log_segment_entry;
+
+/*!
+ *  @function log_segment_writer_open
+ *
+ *  @discussion Initializes the writer for the directory, which must exist. compress enables payload compression.
+ *  Returns 0 on failure.
+ *
+ */
+int log_segment_writer_open(log_segment_writer *writer, const char *directory, int compress);
+
+/*!
+ *  @function log_segment_writer_append
+ *
+ *  @discussion Buffers a record for the segment of the day. Switching to another day flushes the open segment first.
+ *  A segment file without a valid header is renamed with an ".unreadable" suffix and the day starts in a new file.
+ *  Returns 0 if the segment cannot be opened or written, or if an unreadable file of the day is already set aside.
+ *
+ */
+int log_segment_writer_append(log_segment_writer *writer, uint32_t day, int64_t timestamp_us,
+                              log_segment_record_type type, const void *payload, uint32_t length);
+
+/*!
+ *  @function log_segment_writer_flush
+ *
+ *  @discussion Writes the buffered records to the open segment. Returns 0 on a write error.
+ *
+ */
+int log_segment_writer_flush(log_segment_writer *writer);
+
+/*!
+ *  @function log_segment_writer_remove_day
+ *
+ *  @discussion Deletes the segment of the day and any unreadable file set aside for it, closing the segment first if it
+ *  is open
+ *
+ */
+int log_segment_writer_remove_day(log_segment_writer *writer, uint32_t day);
+
+/*!
+ *  @function log_segment_writer_close
+ *
+ *  @discussion Flushes and closes the open segment and releases the writer
+ *
+ */
+void log_segment_writer_close(log_segment_writer *writer);
+
+/*!
+ *  @function log_segment_list_days
+ *
+ *  @discussion Stores the days that have a segment in the directory into days, oldest first. Returns the number of
+ *  days found, which may exceed max_days.
+ *
+ */
+size_t log_segment_list_days(const char *directory, uint32_t *days, size_t max_days);
+
+/*!
+ *  @function log_segment_reader_open
+ *
+ *  @discussion Maps and indexes the segment of the day. A missing segment opens as empty. Returns 0 on failure.
+ *
+ */
+int log_segment_reader_open(log_segment_reader *reader, const char *directory, uint32_t day);
+
+/*!
+ *  @function log_segment_reader_refresh
+ *
+ *  @discussion Maps the records appended since the segment was opened or last refreshed. A segment that shrank, i.e.
+ *  was removed and started again, is indexed from the start. Returns 0 on failure, leaving the reader unchanged.
+ *
+ */
+int log_segment_reader_refresh(log_segment_reader *reader);
+
+/*!
+ *  @function log_segment_reader_entry
+ *
+ *  @discussion Fills entry with the record at index. Returns 0 if index is out of range.
+ *
+ */
+int log_segment_reader_entry(const log_segment_reader *reader, uint32_t index, log_segment_entry *entry);
+
+/*!
+ *  @function log_segment_entry_decode
+ *
+ *  @discussion Copies the payload of the entry into buffer, which holds entry->length bytes, decompressing it if
+ *  needed. Returns 0 if the stored payload is corrupt.
+ *
+ */
+int log_segment_entry_decode(const log_segment_entry *entry, uint8_t *buffer);
+
+/*!
+ *  @function log_segment_reader_close
+ *
+ *  @discussion Unmaps the segment and releases the index
+ *
+ */
+void log_segment_reader_close(log_segment_reader *reader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LogSegmentStore_h */
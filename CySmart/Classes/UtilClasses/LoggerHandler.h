@@ -32,6 +32,9 @@
 #define DATE_SEPARATOR @"::"
 
 #import <Foundation/Foundation.h>
+#import "GATTTraceRecord.h"
+#import "LogPageReader.h"
+#import "LogQueryEngine.h"
 
 @interface LoggerHandler : NSObject
 
@@ -43,16 +46,66 @@
  */
 @property (nonatomic,retain)NSMutableArray *Logger;
 
+/*!
+ *  @property pendingRecordCount
+ *
+ *  @discussion Number of log records queued and not yet written
+ *
+ */
+@property (nonatomic, readonly) NSUInteger pendingRecordCount;
+
+/*!
+ *  @property peakPendingRecordCount
+ *
+ *  @discussion Largest number of log records that were queued at once
+ *
+ */
+@property (nonatomic, readonly) NSUInteger peakPendingRecordCount;
+
+/*!
+ *  @property droppedRecordCount
+ *
+ *  @discussion Number of log records dropped because the queue was full
+ *
+ */
+@property (nonatomic, readonly) uint64_t droppedRecordCount;
+
 + (id)logManager;
 
+/*!
+ *  @method dayForDate:calendar:
+ *
+ *  @discussion Returns the YYYYMMDD key of the local day of the date, the day a record of that time is filed under
+ *
+ */
++(uint32_t)dayForDate:(NSDate *)date calendar:(NSCalendar *)calendar;
+
 /*!
  *  @method addLogData:
  *
- *  @discussion Add log data
+ *  @discussion Queue log data. Returns immediately; the records are formatted and written in batches on a background
+ *  queue.
  *
  */
 -(void)addLogData:(NSString*)data;
 
+/*!
+ *  @method addTraceRecord:
+ *
+ *  @discussion Queue a GATT trace record. The record is copied in its binary form; its text is rendered only when the
+ *  log is read.
+ *
+ */
+-(void)addTraceRecord:(const gatt_trace_record *)record;
+
+/*!
+ *  @method flush
+ *
+ *  @discussion Write every queued log record and wait until they are stored
+ *
+ */
+-(void)flush;
+
 /*!
  *  @method getTodayLogData
  *
@@ -61,6 +114,64 @@
  */
 -(NSArray *)getTodayLogData;
 
+/*!
+ *  @method getTodayLogEventCount
+ *
+ *  @discussion Return the number of log records of today
+ *
+ */
+-(NSUInteger)getTodayLogEventCount;
+
+/*!
+ *  @method getLogDates
+ *
+ *  @discussion Return the dates that have log data, oldest first
+ *
+ */
+-(NSArray *)getLogDates;
+
+/*!
+ *  @method pageReaderForDate:
+ *
+ *  @discussion Return a reader that pages through the log records for particular date, nil if the date is invalid.
+ *  Records queued before the call are included; later ones become visible with refresh.
+ *
+ */
+-(LogPageReader *)pageReaderForDate:(NSString *)date;
+
+/*!
+ *  @method queryEngine
+ *
+ *  @discussion Return a query engine over the log records of every day. Records queued before the call are included;
+ *  later ones are included once written, or after flush.
+ *
+ */
+-(LogQueryEngine *)queryEngine;
+
+/*!
+ *  @method getLogEventsForDate:
+ *
+ *  @discussion Return log records for particular date
+ *
+ */
+-(NSArray *)getLogEventsForDate:(NSString *)date;
+
+/*!
+ *  @method getLogEventCountForDate:
+ *
+ *  @discussion Return the number of log records for particular date without reading them
+ *
+ */
+-(NSUInteger)getLogEventCountForDate:(NSString *)date;
+
+/*!
+ *  @method deleteLogEventsForDate:
+ *
+ *  @discussion Delete log records for particular date
+ *
+ */
+-(void)deleteLogEventsForDate:(NSString *)date;
+
 /*!
  *  @method deleteOldLogData
  *
@@ -34,8 +34,28 @@
 #define LOGGER_KEY @"Logger_Data"
 #define DATE_DATA_KEY @"Date_Log"
 
+// Records held in memory before new ones are dropped
+#define LOG_QUEUE_CAPACITY      8192
+
+// Queued records that trigger an immediate write
+#define LOG_BATCH_SIZE          256
+
+// Longest time a record waits to be written
+#define LOG_FLUSH_INTERVAL_MS   500
+
+// Directory of the log segments under Application Support
+#define LOG_DIRECTORY           @"Logs"
+
+// Compress log payloads in the segments
+#define LOG_COMPRESS_PAYLOADS   1
+
+// Largest number of days listed
+#define LOG_MAX_DAYS            64
+
 #import "LoggerHandler.h"
 #import "CoreDataHandler.h"
+#import "LogRecordQueue.h"
+#import "LogSegmentStore.h"
 #import "Utilities.h"
 
 
@@ -48,7 +68,14 @@
 @interface LoggerHandler ()
 {
     NSMutableArray *DateLogArray;
-    CoreDataHandler *loggerDataHandler;
+    log_record_queue recordQueue;
+    dispatch_queue_t writerQueue;
+    NSString *logDirectory;
+    log_segment_writer segmentWriter;       // Used on writerQueue only
+    NSCalendar *writerCalendar;             // Used on writerQueue only
+    NSTimeInterval writerDayStart;          // Day of the last record written, as a time range
+    NSTimeInterval writerDayEnd;
+    uint32_t writerDay;
 }
 
 @end
@@ -68,10 +95,19 @@
 - (id)init {
     if (self = [super init])
     {
-        if (!loggerDataHandler)
-        {
-            loggerDataHandler = [[CoreDataHandler alloc] init];
-        }
+        log_record_queue_init(&recordQueue, LOG_QUEUE_CAPACITY);
+        writerQueue = dispatch_queue_create("com.cypress.cysmart.logger", DISPATCH_QUEUE_SERIAL);
+        writerCalendar = [NSCalendar currentCalendar];
+        
+        NSURL *supportURL = [[[NSFileManager defaultManager] URLsForDirectory:NSApplicationSupportDirectory inDomains:NSUserDomainMask] firstObject];
+        logDirectory = [supportURL.path stringByAppendingPathComponent:LOG_DIRECTORY];
+        [[NSFileManager defaultManager] createDirectoryAtPath:logDirectory withIntermediateDirectories:YES attributes:nil error:nil];
+        log_segment_writer_open(&segmentWriter, logDirectory.fileSystemRepresentation, LOG_COMPRESS_PAYLOADS);
+        
+        // Core Data is confined to the main thread
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self importCoreDataLogs];
+        });
     }
     return self;
 }
@@ -79,15 +115,270 @@
 /*!
  *  @method addLogData:
  *
- *  @discussion Add log data
+ *  @discussion Queue log data. The caller only pays for the copy of the string and a lock-free push; formatting and
+ *  storing happen on writerQueue.
  *
  */
 -(void)addLogData:(NSString*)data {
-    NSString *event = [NSString stringWithFormat:@"[%@]%@%@", [self formatDate:[NSDate date]], DATE_SEPARATOR, data];
-    [loggerDataHandler addLogEvent:event date:[Utilities getTodayDateString]];
+    [self pushRecord:(__bridge_retained void *)[data copy]];
+}
+
+/*!
+ *  @method addTraceRecord:
+ *
+ *  @discussion Queue a GATT trace record. Encoding is a copy of the fields and the payload bytes into one buffer.
+ *
+ */
+-(void)addTraceRecord:(const gatt_trace_record *)record {
+    NSMutableData *data = [NSMutableData dataWithLength:gatt_trace_record_size(record)];
+    gatt_trace_record_encode(record, data.mutableBytes);
+    [self pushRecord:(__bridge_retained void *)data];
+}
+
+/*!
+ *  @method pushRecord:
+ *
+ *  @discussion Queues a retained NSString or encoded trace record and schedules the write of the batch
+ *
+ */
+-(void)pushRecord:(void *)payload {
+    size_t depth = 0;
+    if (!log_record_queue_push(&recordQueue, [NSDate timeIntervalSinceReferenceDate], payload, &depth))
+    {
+        // Queue full: the record was not taken, so the payload is still ours
+        CFRelease(payload);
+    }
+    else if (depth == 1)
+    {
+        // First record of a batch: make sure it does not wait longer than the flush interval
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, LOG_FLUSH_INTERVAL_MS * NSEC_PER_MSEC), writerQueue, ^{
+            [self writePendingRecords];
+        });
+    }
+    else if (depth == LOG_BATCH_SIZE)
+    {
+        dispatch_async(writerQueue, ^{
+            [self writePendingRecords];
+        });
+    }
+}
+
+/*!
+ *  @method dayForDate:calendar:
+ *
+ *  @discussion Returns the YYYYMMDD key of the local day of the date
+ *
+ */
++(uint32_t)dayForDate:(NSDate *)date calendar:(NSCalendar *)calendar {
+    NSDateComponents *components = [calendar components:NSCalendarUnitYear | NSCalendarUnitMonth | NSCalendarUnitDay fromDate:date];
+    return (uint32_t)(components.year * 10000 + components.month * 100 + components.day);
+}
+
+/*!
+ *  @method appendRecordWithTimestamp:type:bytes:length:
+ *
+ *  @discussion Appends a record to the segment of its day. Runs on writerQueue.
+ *
+ */
+-(void)appendRecordWithTimestamp:(NSTimeInterval)timestamp type:(log_segment_record_type)type bytes:(const void *)bytes length:(uint32_t)length {
+    // Records arrive in time order, so the day only needs working out again when one falls outside the cached range
+    if (writerDay == 0 || timestamp < writerDayStart || timestamp >= writerDayEnd)
+    {
+        NSDate *date = [NSDate dateWithTimeIntervalSinceReferenceDate:timestamp];
+        NSDate *dayStart;
+        NSTimeInterval dayLength;
+        [writerCalendar rangeOfUnit:NSCalendarUnitDay startDate:&dayStart interval:&dayLength forDate:date];
+        writerDayStart = dayStart.timeIntervalSinceReferenceDate;
+        writerDayEnd = writerDayStart + dayLength;
+        writerDay = [LoggerHandler dayForDate:date calendar:writerCalendar];
+    }
+    
+    int64_t timestampUs = (int64_t)llround((timestamp + NSTimeIntervalSince1970) * 1e6);
+    log_segment_writer_append(&segmentWriter, writerDay, timestampUs, type, bytes, length);
+}
+
+/*!
+ *  @method appendRecordWithTimestamp:data:
+ *
+ *  @discussion Appends a text record. Runs on writerQueue.
+ *
+ */
+-(void)appendRecordWithTimestamp:(NSTimeInterval)timestamp data:(NSString *)data {
+    const char *bytes = data.UTF8String;
+    [self appendRecordWithTimestamp:timestamp type:LOG_SEGMENT_TEXT_RECORD bytes:bytes length:(uint32_t)strlen(bytes)];
+}
+
+/*!
+ *  @method writePendingRecords
+ *
+ *  @discussion Appends the queued records to the log segments with one write per batch. Runs on writerQueue.
+ *
+ */
+-(void)writePendingRecords {
+    log_record record;
+    NSUInteger count = 0;
+    
+    while (log_record_queue_pop(&recordQueue, &record))
+    {
+        @autoreleasepool {
+            id data = (__bridge_transfer id)record.payload;
+            if ([data isKindOfClass:[NSData class]])
+            {
+                NSData *trace = data;
+                [self appendRecordWithTimestamp:record.timestamp type:LOG_SEGMENT_TRACE_RECORD bytes:trace.bytes length:(uint32_t)trace.length];
+            }
+            else
+            {
+                [self appendRecordWithTimestamp:record.timestamp data:data];
+            }
+        }
+        if (++count % LOG_BATCH_SIZE == 0)
+        {
+            log_segment_writer_flush(&segmentWriter);
+        }
+    }
+    log_segment_writer_flush(&segmentWriter);
+}
+
+/*!
+ *  @method flush
+ *
+ *  @discussion Write every queued log record and wait until they are stored
+ *
+ */
+-(void)flush {
+    dispatch_sync(writerQueue, ^{
+        [self writePendingRecords];
+    });
+}
+
+-(NSUInteger)pendingRecordCount {
+    return log_record_queue_depth(&recordQueue);
+}
+
+-(NSUInteger)peakPendingRecordCount {
+    return log_record_queue_high_water(&recordQueue);
+}
+
+-(uint64_t)droppedRecordCount {
+    return log_record_queue_dropped(&recordQueue);
 }
 
 /*!
+ *  @method dayForDateString:
+ *
+ *  @discussion Returns the day key of a DATE_FORMAT string, 0 if it does not parse
+ *
+ */
+-(uint32_t)dayForDateString:(NSString *)dateString {
+    NSDateFormatter *dateFormatter = [[NSDateFormatter alloc] init];
+    dateFormatter.dateFormat = DATE_FORMAT;
+    NSDate *date = [dateFormatter dateFromString:dateString];
+    return date ? [LoggerHandler dayForDate:date calendar:[NSCalendar currentCalendar]] : 0;
+}
+
+/*!
+ *  @method getLogDates
+ *
+ *  @discussion Return the dates that have log data, oldest first
+ *
+ */
+-(NSArray *)getLogDates {
+    [self flush];
+    
+    uint32_t days[LOG_MAX_DAYS];
+    size_t count = log_segment_list_days(logDirectory.fileSystemRepresentation, days, LOG_MAX_DAYS);
+    if (count > LOG_MAX_DAYS)
+    {
+        count = LOG_MAX_DAYS;
+    }
+    
+    NSDateFormatter *dateFormatter = [[NSDateFormatter alloc] init];
+    dateFormatter.dateFormat = DATE_FORMAT;
+    NSCalendar *calendar = [NSCalendar currentCalendar];
+    NSMutableArray *dates = [NSMutableArray arrayWithCapacity:count];
+    
+    for (size_t i = 0; i < count; i++)
+    {
+        NSDateComponents *components = [[NSDateComponents alloc] init];
+        components.year = days[i] / 10000;
+        components.month = days[i] / 100 % 100;
+        components.day = days[i] % 100;
+        NSDate *date = [calendar dateFromComponents:components];
+        if (date)
+        {
+            [dates addObject:[dateFormatter stringFromDate:date]];
+        }
+    }
+    return dates;
+}
+
+/*!
+ *  @method pageReaderForDate:
+ *
+ *  @discussion Return a reader over the log records for particular date, including the queued ones
+ *
+ */
+-(LogPageReader *)pageReaderForDate:(NSString *)date {
+    uint32_t day = [self dayForDateString:date];
+    if (day == 0)
+    {
+        return nil;
+    }
+    [self flush];
+    return [[LogPageReader alloc] initWithDirectory:logDirectory day:day];
+}
+
+/*!
+ *  @method queryEngine
+ *
+ *  @discussion Return a query engine over the log records of every day, including the queued ones
+ *
+ */
+-(LogQueryEngine *)queryEngine {
+    [self flush];
+    return [[LogQueryEngine alloc] initWithDirectory:logDirectory];
+}
+
+/*!
+ *  @method getLogEventsForDate:
+ *
+ *  @discussion Return log records for particular date
+ *
+ */
+-(NSArray *)getLogEventsForDate:(NSString *)date {
+    LogPageReader *reader = [self pageReaderForDate:date];
+    return reader ? [reader eventsInRange:NSMakeRange(0, reader.count)] : @[];
+}
+
+/*!
+ *  @method getLogEventCountForDate:
+ *
+ *  @discussion Return the number of log records for particular date without reading them
+ *
+ */
+-(NSUInteger)getLogEventCountForDate:(NSString *)date {
+    return [[self pageReaderForDate:date] count];
+}
+
+/*!
+ *  @method deleteLogEventsForDate:
+ *
+ *  @discussion Delete log records for particular date
+ *
+ */
+-(void)deleteLogEventsForDate:(NSString *)date {
+    uint32_t day = [self dayForDateString:date];
+    if (day == 0)
+    {
+        return;
+    }
+    dispatch_sync(writerQueue, ^{
+        log_segment_writer_remove_day(&segmentWriter, day);
+    });
+}
+
+/*!
  *  @method getTodayLogData
  *
  *  @discussion Return today log data
@@ -95,35 +386,68 @@
  */
 -(NSArray *) getTodayLogData
 {
-    return [loggerDataHandler getLogEventsForDate:[Utilities getTodayDateString]];
-}
-
+    return [self getLogEventsForDate:[Utilities getTodayDateString]];
+}
+
 /*!
- *  @method formatDate:
+ *  @method getTodayLogEventCount
  *
- *  @discussion Format date as date-time string
+ *  @discussion Return the number of log records of today
  *
  */
--(NSString *)formatDate:(NSDate *)date {
-    NSDateFormatter *dateTimeFormatter = [[NSDateFormatter alloc] init];
-    dateTimeFormatter.dateFormat = [NSString stringWithFormat:@"%@|%@", DATE_FORMAT, TIME_FORMAT];
-    
-    NSString *dateTimeString = [dateTimeFormatter stringFromDate:date];
-    return dateTimeString;
+-(NSUInteger) getTodayLogEventCount
+{
+    return [self getLogEventCountForDate:[Utilities getTodayDateString]];
 }
 
 /*!
- *  @method parseDate:
+ *  @method importCoreDataLogs
  *
- *  @discussion Parse date from date-time string
+ *  @discussion Moves the log records of earlier versions from Core Data into the log segments. Runs on the main
+ *  thread, where the Core Data context lives.
  *
  */
--(NSDate*)parseDate:(NSString *)dateTimeString {
-    NSDateFormatter *dateTimeFormatter = [[NSDateFormatter alloc] init];
-    dateTimeFormatter.dateFormat = [NSString stringWithFormat:@"%@|%@", DATE_FORMAT, TIME_FORMAT];
-    
-    NSDate *date = [dateTimeFormatter dateFromString:dateTimeString];
-    return date;
+-(void)importCoreDataLogs {
+    CoreDataHandler *coreDataHandler = [[CoreDataHandler alloc] init];
+    NSArray *dates = [coreDataHandler getLogDates];
+    if (dates.count == 0)
+    {
+        return;
+    }
+    
+    NSDateFormatter *dateTimeFormatter = [[NSDateFormatter alloc] init];
+    dateTimeFormatter.dateFormat = [NSString stringWithFormat:@"%@|%@", DATE_FORMAT, TIME_FORMAT];
+    
+    for (NSString *date in dates)
+    {
+        NSMutableArray *timestamps = [NSMutableArray array];
+        NSMutableArray *events = [NSMutableArray array];
+        
+        // Events were stored as "[date|time]::data"
+        for (NSString *event in [coreDataHandler getLogEventsForDate:date])
+        {
+            NSRange separator = [event rangeOfString:DATE_SEPARATOR];
+            if (separator.location == NSNotFound || separator.location < 2)
+            {
+                continue;
+            }
+            NSDate *time = [dateTimeFormatter dateFromString:[event substringWithRange:NSMakeRange(1, separator.location - 2)]];
+            if (time)
+            {
+                [timestamps addObject:@(time.timeIntervalSinceReferenceDate)];
+                [events addObject:[event substringFromIndex:NSMaxRange(separator)]];
+            }
+        }
+        
+        dispatch_sync(writerQueue, ^{
+            for (NSUInteger i = 0; i < events.count; i++)
+            {
+                [self appendRecordWithTimestamp:[timestamps[i] doubleValue] data:events[i]];
+            }
+            log_segment_writer_flush(&segmentWriter);
+        });
+        [coreDataHandler deleteLogEventsForDate:date];
+    }
 }
 
 /*!
@@ -133,7 +457,7 @@
  *
  */
 -(void)deleteOldLogData {
-    NSArray *dates = [loggerDataHandler getLogDates];
+    NSArray *dates = [self getLogDates];
     if(dates && [dates count]) {
         NSDateFormatter *dateFormatter = [[NSDateFormatter alloc] init];
         dateFormatter.dateFormat = DATE_FORMAT;
@@ -165,11 +489,11 @@
             return [date2 compare:date1];
         }];
         
-        // Leave the first 7 records (including today) and delete the rest.
+        // Leave the first 7 records (including today) and delete the rest. Each day is a single file.
         int count = 0;
         for (NSString *dateString in keys) {
             if (++count > 6) { // 7 = 6 + today
-                [loggerDataHandler deleteLogEventsForDate:dateString];
+                [self deleteLogEventsForDate:dateString];
             }
         }
     }
@@ -46,7 +46,8 @@
 /*!
  *  @method getServiceNameForUUID:
  *
- *  @discussion Method that returns service name for a given UUID
+ *  @discussion Method that returns service name for a given UUID. Names are looked up in the table compiled from
+ *  serviceAndCharacteristicNames.plist, after the user defined names; the plist is not read.
  *
  */
 
@@ -60,4 +61,32 @@
  */
 
 +(NSString *) getCharacteristicNameForUUID:(CBUUID *)UUID;
+
+/*!
+ *  @method setUserDefinedName:forUUID:
+ *
+ *  @discussion Names the UUID in place of its name in the plist, nil removes the user defined name
+ *
+ */
+
++(void) setUserDefinedName:(NSString *)name forUUID:(CBUUID *)UUID;
+
+/*!
+ *  @method mergeUserDefinedNames:
+ *
+ *  @discussion Adds the names of a dictionary keyed by CBUUID to the user defined names, replacing the names of the
+ *  same UUIDs
+ *
+ */
+
++(void) mergeUserDefinedNames:(NSDictionary *)names;
+
+/*!
+ *  @method removeAllUserDefinedNames
+ *
+ *  @discussion Goes back to the names in the plist only
+ *
+ */
+
++(void) removeAllUserDefinedNames;
 @end
@@ -30,9 +30,8 @@
  *
  */
 #import "ResourceHandler.h"
+#import "UUIDNameRegistry.h"
 
-#define SERVICE_AND_CHARACTERISTIC_NAMES_PLIST      @"serviceAndCharacteristicNames"
-#define PLIST                                       @"plist"
 #define UNKNOWN_SERVICE                             @"Unknown Service"
 #define UNKNOWN_CHARACTERISTIC                      @"Unknown Characteristic"
 
@@ -43,6 +42,8 @@
  *
  */
 
+static NSMutableDictionary *userDefinedNames;
+
 @implementation ResourceHandler
 
 /*!
@@ -66,9 +67,7 @@
  */
 +(NSString *) getServiceNameForUUID:(CBUUID *)UUID
 {
-    NSDictionary *allServicesAndCharacteristicsDict = [NSDictionary dictionaryWithContentsOfFile:[[NSBundle mainBundle] pathForResource:SERVICE_AND_CHARACTERISTIC_NAMES_PLIST ofType:PLIST]];
-    
-    NSString *serviceName = [allServicesAndCharacteristicsDict objectForKey:UUID.UUIDString];
+    NSString *serviceName = [self nameForUUID:UUID];
     
     if (serviceName.length < 1)
     {
@@ -86,9 +85,7 @@
 
 +(NSString *) getCharacteristicNameForUUID:(CBUUID *)UUID
 {
-    NSDictionary *allServicesAndCharacteristicsDict = [NSDictionary dictionaryWithContentsOfFile:[[NSBundle mainBundle] pathForResource:SERVICE_AND_CHARACTERISTIC_NAMES_PLIST ofType:PLIST]];
-    
-    NSString *characteristicName = [allServicesAndCharacteristicsDict objectForKey:UUID.UUIDString];
+    NSString *characteristicName = [self nameForUUID:UUID];
     
     if (characteristicName.length < 1)
     {
@@ -97,6 +94,121 @@
     return characteristicName;
 }
 
+/*!
+ *  @method compiledNames
+ *
+ *  @discussion Names of the slots of the compiled table, NSNull for the empty slots. Created once, so that a lookup
+ *  returns a name without creating a string.
+ *
+ */
++(NSArray *) compiledNames
+{
+    static NSArray *names;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        uint32_t size = uuid_name_table_size();
+        NSMutableArray *slots = [NSMutableArray arrayWithCapacity:size];
+        for (uint32_t slot = 0; slot < size; slot++)
+        {
+            const char *name = uuid_name_at(slot, NULL, NULL);
+            [slots addObject:name ? @(name) : [NSNull null]];
+        }
+        names = [slots copy];
+    });
+    return names;
+}
+
+/*!
+ *  @method nameForUUID:
+ *
+ *  @discussion Returns the user defined name of the UUID, else its name in the compiled table, nil if it has none
+ *
+ */
++(NSString *) nameForUUID:(CBUUID *)UUID
+{
+    @synchronized (self)
+    {
+        NSString *name = [userDefinedNames objectForKey:UUID];
+        if (name != nil)
+        {
+            return name;
+        }
+    }
+    
+    NSData *data = UUID.data;
+    uint32_t slot = uuid_name_lookup(data.bytes, (uint32_t)data.length);
+    if (slot == UUID_NAME_NOT_FOUND)
+    {
+        return nil;
+    }
+    return [[self compiledNames] objectAtIndex:slot];
+}
+
+/*!
+ *  @method setUserDefinedName:forUUID:
+ *
+ *  @discussion Names the UUID in place of its name in the plist, nil removes the user defined name
+ *
+ */
++(void) setUserDefinedName:(NSString *)name forUUID:(CBUUID *)UUID
+{
+    if (UUID == nil)
+    {
+        return;
+    }
+    @synchronized (self)
+    {
+        if (userDefinedNames == nil)
+        {
+            userDefinedNames = [NSMutableDictionary dictionary];
+        }
+        if (name != nil)
+        {
+            [userDefinedNames setObject:[name copy] forKey:UUID];
+        }
+        else
+        {
+            [userDefinedNames removeObjectForKey:UUID];
+        }
+    }
+}
+
+/*!
+ *  @method mergeUserDefinedNames:
+ *
+ *  @discussion Adds the names of a dictionary keyed by CBUUID to the user defined names
+ *
+ */
++(void) mergeUserDefinedNames:(NSDictionary *)names
+{
+    @synchronized (self)
+    {
+        if (userDefinedNames == nil)
+        {
+            userDefinedNames = [NSMutableDictionary dictionary];
+        }
+        [names enumerateKeysAndObjectsUsingBlock:^(id UUID, id name, BOOL *stop) {
+            if ([UUID isKindOfClass:[CBUUID class]] && [name isKindOfClass:[NSString class]])
+            {
+                [userDefinedNames setObject:[name copy] forKey:UUID];
+            }
+        }];
+    }
+}
+
+/*!
+ *  @method removeAllUserDefinedNames
+ *
+ *  @discussion Goes back to the names in the plist only
+ *
+ */
++(void) removeAllUserDefinedNames
+{
+    @synchronized (self)
+    {
+        userDefinedNames = nil;
+    }
+}
 
 
 
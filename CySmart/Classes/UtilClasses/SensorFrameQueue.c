@@ -0,0 +1,173 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#include "SensorFrameQueue.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#pragma mark - Queue
+
+int sensor_frame_queue_init(sensor_frame_queue *queue, uint32_t capacity)
+{
+    uint32_t size = 2;
+    while (size < capacity)
+    {
+        size <<= 1;
+    }
+
+    queue->slots = calloc(size, sizeof(sensor_frame_slot));
+    if (queue->slots == NULL)
+    {
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < size; i++)
+    {
+        atomic_init(&queue->slots[i].sequence, 0);
+    }
+    queue->mask = size - 1;
+    atomic_init(&queue->published, 0);
+    return 1;
+}
+
+void sensor_frame_queue_free(sensor_frame_queue *queue)
+{
+    free(queue->slots);
+    queue->slots = NULL;
+}
+
+void sensor_frame_queue_publish(sensor_frame_queue *queue, const sensor_frame *frame)
+{
+    uint64_t position = atomic_load_explicit(&queue->published, memory_order_relaxed);
+    sensor_frame_slot *slot = &queue->slots[position & queue->mask];
+
+    // Readers copying the previous frame of the slot see the odd sequence and drop their copy
+    atomic_store_explicit(&slot->sequence, 2 * position + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot->frame = *frame;
+    atomic_store_explicit(&slot->sequence, 2 * position + 2, memory_order_release);
+    atomic_store_explicit(&queue->published, position + 1, memory_order_release);
+}
+
+uint64_t sensor_frame_queue_published(sensor_frame_queue *queue)
+{
+    return atomic_load_explicit(&queue->published, memory_order_acquire);
+}
+
+void sensor_frame_reader_init(sensor_frame_reader *reader, sensor_frame_queue *queue)
+{
+    reader->queue = queue;
+    reader->position = sensor_frame_queue_published(queue);
+    reader->overrun = 0;
+}
+
+uint32_t sensor_frame_reader_read(sensor_frame_reader *reader, sensor_frame *frames, uint32_t count)
+{
+    sensor_frame_queue *queue = reader->queue;
+    uint64_t published = sensor_frame_queue_published(queue);
+    uint64_t capacity = (uint64_t)queue->mask + 1;
+
+    if (published - reader->position > capacity)
+    {
+        reader->overrun += published - capacity - reader->position;
+        reader->position = published - capacity;
+    }
+
+    uint32_t copied = 0;
+    while (copied < count && reader->position < published)
+    {
+        sensor_frame_slot *slot = &queue->slots[reader->position & queue->mask];
+        uint64_t expected = 2 * reader->position + 2;
+        if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != expected)
+        {
+            // The producer has lapped this reader; the next read starts at the oldest frame still there
+            break;
+        }
+        frames[copied] = slot->frame;
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&slot->sequence, memory_order_relaxed) != expected)
+        {
+            break;
+        }
+        copied++;
+        reader->position++;
+    }
+    return copied;
+}
+
+#pragma mark - Assembler
+
+void sensor_frame_assembler_init(sensor_frame_assembler *assembler, uint32_t complete_channels, double window)
+{
+    memset(assembler, 0, sizeof(*assembler));
+    assembler->complete_channels = complete_channels;
+    assembler->window = window;
+}
+
+uint32_t sensor_frame_assembler_flush(sensor_frame_assembler *assembler, sensor_frame_queue *queue)
+{
+    if (assembler->frame.fresh == 0)
+    {
+        return 0;
+    }
+    sensor_frame_queue_publish(queue, &assembler->frame);
+    assembler->frame.fresh = 0;
+    return 1;
+}
+
+uint32_t sensor_frame_assembler_add(sensor_frame_assembler *assembler, sensor_frame_queue *queue, sensor_channel channel,
+                                    float value, double timestamp)
+{
+    sensor_frame *frame = &assembler->frame;
+    uint32_t bit = SENSOR_CHANNEL_BIT(channel);
+    uint32_t published = 0;
+
+    if ((frame->fresh & bit) || (frame->fresh != 0 && timestamp - frame->timestamp > assembler->window))
+    {
+        published += sensor_frame_assembler_flush(assembler, queue);
+    }
+
+    if (frame->fresh == 0)
+    {
+        frame->timestamp = timestamp;
+    }
+    frame->values[channel] = value;
+    frame->fresh |= bit;
+    frame->valid |= bit;
+
+    if ((frame->fresh & assembler->complete_channels) == assembler->complete_channels)
+    {
+        published += sensor_frame_assembler_flush(assembler, queue);
+    }
+    return published;
+}
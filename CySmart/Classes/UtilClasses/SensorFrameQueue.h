@@ -0,0 +1,193 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#ifndef SensorFrameQueue_h
+#define SensorFrameQueue_h
+
+#include <stdint.h>
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum
+{
+    SENSOR_CHANNEL_X,
+    SENSOR_CHANNEL_Y,
+    SENSOR_CHANNEL_Z,
+    SENSOR_CHANNEL_PRESSURE,
+    SENSOR_CHANNEL_TEMPERATURE,
+    SENSOR_CHANNEL_COUNT
+} sensor_channel;
+
+#define SENSOR_CHANNEL_BIT(channel)         (1u << (channel))
+#define SENSOR_ACCELEROMETER_CHANNELS       (SENSOR_CHANNEL_BIT(SENSOR_CHANNEL_X) | SENSOR_CHANNEL_BIT(SENSOR_CHANNEL_Y) | \
+                                             SENSOR_CHANNEL_BIT(SENSOR_CHANNEL_Z))
+
+/*!
+ *  @struct sensor_frame
+ *
+ *  @discussion Samples of every channel aligned to one time, the time of the first sample in the frame. fresh has the
+ *  channels sampled in this frame; the other channels of valid hold their last sample.
+ *
+ */
+typedef struct
+{
+    double timestamp;
+    float values[SENSOR_CHANNEL_COUNT];
+    uint32_t fresh;
+    uint32_t valid;
+} sensor_frame;
+
+typedef struct
+{
+    _Atomic uint64_t sequence;          // Odd while the frame is written, 2 * (position + 1) once it is published
+    sensor_frame frame;
+} sensor_frame_slot;
+
+#pragma mark - Queue
+
+/*!
+ *  @struct sensor_frame_queue
+ *
+ *  @discussion Ring of the latest frames, published by a single producer and read by any number of readers. Every
+ *  reader sees every frame. The producer never waits for readers: a reader that falls more than the capacity behind
+ *  skips the frames it missed and counts them as overrun.
+ *
+ */
+typedef struct
+{
+    sensor_frame_slot *slots;
+    uint32_t mask;                      // Capacity - 1, the capacity is a power of two
+    char padding[64];                   // Keeps the published position away from the slot pointer readers share
+    _Atomic uint64_t published;
+} sensor_frame_queue;
+
+/*!
+ *  @struct sensor_frame_reader
+ *
+ *  @discussion Position of one reader in the queue. Each reader belongs to a single thread.
+ *
+ */
+typedef struct
+{
+    sensor_frame_queue *queue;
+    uint64_t position;
+    uint64_t overrun;
+} sensor_frame_reader;
+
+/*!
+ *  @function sensor_frame_queue_init
+ *
+ *  @discussion Initializes the queue with capacity rounded up to a power of two. Returns 0 if the slots cannot be
+ *  allocated.
+ *
+ */
+int sensor_frame_queue_init(sensor_frame_queue *queue, uint32_t capacity);
+
+void sensor_frame_queue_free(sensor_frame_queue *queue);
+
+/*!
+ *  @function sensor_frame_queue_publish
+ *
+ *  @discussion Appends a frame, overwriting the oldest once the queue is full. Only one thread may publish.
+ *
+ */
+void sensor_frame_queue_publish(sensor_frame_queue *queue, const sensor_frame *frame);
+
+/*!
+ *  @function sensor_frame_queue_published
+ *
+ *  @discussion Returns the number of frames published since the queue was initialized
+ *
+ */
+uint64_t sensor_frame_queue_published(sensor_frame_queue *queue);
+
+/*!
+ *  @function sensor_frame_reader_init
+ *
+ *  @discussion Attaches a reader to the queue. It reads the frames published from now on.
+ *
+ */
+void sensor_frame_reader_init(sensor_frame_reader *reader, sensor_frame_queue *queue);
+
+/*!
+ *  @function sensor_frame_reader_read
+ *
+ *  @discussion Copies up to count of the frames published since the last read, oldest first. Returns the number of
+ *  frames copied.
+ *
+ */
+uint32_t sensor_frame_reader_read(sensor_frame_reader *reader, sensor_frame *frames, uint32_t count);
+
+#pragma mark - Assembler
+
+/*!
+ *  @struct sensor_frame_assembler
+ *
+ *  @discussion Collects samples into the frame being assembled. The frame is published once every channel of
+ *  complete_channels is sampled, or before a channel is sampled twice or a sample arrives more than window seconds
+ *  after the first one.
+ *
+ */
+typedef struct
+{
+    sensor_frame frame;
+    uint32_t complete_channels;
+    double window;
+} sensor_frame_assembler;
+
+void sensor_frame_assembler_init(sensor_frame_assembler *assembler, uint32_t complete_channels, double window);
+
+/*!
+ *  @function sensor_frame_assembler_add
+ *
+ *  @discussion Adds the sample taken at timestamp. Returns the number of frames it published to the queue.
+ *
+ */
+uint32_t sensor_frame_assembler_add(sensor_frame_assembler *assembler, sensor_frame_queue *queue, sensor_channel channel,
+                                    float value, double timestamp);
+
+/*!
+ *  @function sensor_frame_assembler_flush
+ *
+ *  @discussion Publishes the frame being assembled, if it has any sample. Returns the number of frames published.
+ *
+ */
+uint32_t sensor_frame_assembler_flush(sensor_frame_assembler *assembler, sensor_frame_queue *queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SensorFrameQueue_h */
@@ -0,0 +1,137 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import "TimeSeriesBuffer.h"
+#import "TimeSeriesLevels.h"
+
+/*!
+ *  @class TimeSeries
+ *
+ *  @discussion Samples of a live chart: the latest capacity values with the time they were received. Appending and
+ *  the value range are constant time and the memory is fixed however long the samples keep coming. Min/max summaries
+ *  are cached for decimation, so drawing any span of the series costs the same. Used on the main queue only.
+ *
+ */
+@interface TimeSeries : NSObject
+
+/*!
+ *  @property count
+ *
+ *  @discussion Number of samples, at most capacity
+ *
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/*!
+ *  @property capacity
+ *
+ *  @discussion Number of samples kept
+ *
+ */
+@property (nonatomic, readonly) NSUInteger capacity;
+
+/*!
+ *  @property droppedCount
+ *
+ *  @discussion Number of samples overwritten by newer ones
+ *
+ */
+@property (nonatomic, readonly) uint64_t droppedCount;
+
+/*!
+ *  @method initWithCapacity:
+ *
+ *  @discussion Creates a series that keeps the latest capacity samples. Returns nil if capacity is 0.
+ *
+ */
+-(instancetype)initWithCapacity:(NSUInteger)capacity;
+
+/*!
+ *  @method appendValue:atTime:
+ *
+ *  @discussion Appends a sample, dropping the oldest one if the series is full. Times should not decrease.
+ *
+ */
+-(void)appendValue:(float)value atTime:(NSTimeInterval)time;
+
+/*!
+ *  @method removeAllSamples
+ *
+ *  @discussion Removes every sample
+ *
+ */
+-(void)removeAllSamples;
+
+/*!
+ *  @method timeAtIndex:
+ *
+ *  @discussion Returns the time of a sample, index 0 being the oldest. The index must be below count.
+ *
+ */
+-(NSTimeInterval)timeAtIndex:(NSUInteger)index;
+
+/*!
+ *  @method valueAtIndex:
+ *
+ *  @discussion Returns the value of a sample, index 0 being the oldest. The index must be below count.
+ *
+ */
+-(float)valueAtIndex:(NSUInteger)index;
+
+/*!
+ *  @method getMinimumValue:maximumValue:
+ *
+ *  @discussion Gets the range of the values in the series. Returns NO if it has no value but NaN.
+ *
+ */
+-(BOOL)getMinimumValue:(float *)minimum maximumValue:(float *)maximum;
+
+/*!
+ *  @method windowInRange:
+ *
+ *  @discussion Returns the samples in range, clipped to count, as arrays inside the series. They stay valid until the
+ *  next sample is appended.
+ *
+ */
+-(time_series_window)windowInRange:(NSRange)range;
+
+/*!
+ *  @method getDecimatedPoints:columns:fromTime:toTime:
+ *
+ *  @discussion Gets the smallest and largest sample of each of columns equal parts of [fromTime, toTime), in time
+ *  order. points must have room for 2 * columns points. Returns the number of points.
+ *
+ */
+-(NSUInteger)getDecimatedPoints:(time_series_point *)points columns:(NSUInteger)columns fromTime:(NSTimeInterval)fromTime toTime:(NSTimeInterval)toTime;
+
+@end
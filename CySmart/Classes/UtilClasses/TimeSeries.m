@@ -0,0 +1,117 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import "TimeSeries.h"
+
+/*!
+ *  @class TimeSeries
+ *
+ *  @discussion Ring buffer of chart samples
+ *
+ */
+@interface TimeSeries ()
+{
+    time_series_buffer buffer;
+    time_series_levels levels;
+}
+
+@end
+
+@implementation TimeSeries
+
+-(instancetype)initWithCapacity:(NSUInteger)capacity {
+    if (self = [super init])
+    {
+        if (capacity > UINT32_MAX || !time_series_init(&buffer, (uint32_t)capacity))
+        {
+            return nil;
+        }
+        if (!time_series_levels_init(&levels, (uint32_t)capacity))
+        {
+            time_series_free(&buffer);
+            return nil;
+        }
+    }
+    return self;
+}
+
+-(void)dealloc {
+    time_series_levels_free(&levels);
+    time_series_free(&buffer);
+}
+
+-(NSUInteger)count {
+    return time_series_count(&buffer);
+}
+
+-(NSUInteger)capacity {
+    return buffer.capacity;
+}
+
+-(uint64_t)droppedCount {
+    return buffer.first;
+}
+
+-(void)appendValue:(float)value atTime:(NSTimeInterval)time {
+    time_series_append(&buffer, time, value);
+}
+
+-(void)removeAllSamples {
+    time_series_clear(&buffer);
+    time_series_levels_reset(&levels);
+}
+
+-(NSTimeInterval)timeAtIndex:(NSUInteger)index {
+    return time_series_time_at(&buffer, (uint32_t)index);
+}
+
+-(float)valueAtIndex:(NSUInteger)index {
+    return time_series_value_at(&buffer, (uint32_t)index);
+}
+
+-(BOOL)getMinimumValue:(float *)minimum maximumValue:(float *)maximum {
+    return time_series_min_max(&buffer, minimum, maximum) != 0;
+}
+
+-(time_series_window)windowInRange:(NSRange)range {
+    time_series_window window;
+    NSUInteger start = MIN(range.location, (NSUInteger)UINT32_MAX);
+    NSUInteger length = MIN(range.length, (NSUInteger)UINT32_MAX);
+    time_series_get_window(&buffer, (uint32_t)start, (uint32_t)length, &window);
+    return window;
+}
+
+-(NSUInteger)getDecimatedPoints:(time_series_point *)points columns:(NSUInteger)columns fromTime:(NSTimeInterval)fromTime toTime:(NSTimeInterval)toTime {
+    return time_series_decimate(&levels, &buffer, fromTime, toTime, (uint32_t)MIN(columns, (NSUInteger)UINT32_MAX / 2), points);
+}
+
+@end
@@ -0,0 +1,183 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#include "TimeSeriesBuffer.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+int time_series_init(time_series_buffer *buffer, uint32_t capacity)
+{
+    memset(buffer, 0, sizeof(*buffer));
+    if (capacity == 0)
+    {
+        return 0;
+    }
+
+    buffer->times = malloc(capacity * sizeof(double));
+    buffer->values = malloc(capacity * sizeof(float));
+    buffer->minima.sequences = malloc(capacity * sizeof(uint64_t));
+    buffer->maxima.sequences = malloc(capacity * sizeof(uint64_t));
+    if (buffer->times == NULL || buffer->values == NULL || buffer->minima.sequences == NULL || buffer->maxima.sequences == NULL)
+    {
+        time_series_free(buffer);
+        return 0;
+    }
+    buffer->capacity = capacity;
+    return 1;
+}
+
+void time_series_free(time_series_buffer *buffer)
+{
+    free(buffer->times);
+    free(buffer->values);
+    free(buffer->minima.sequences);
+    free(buffer->maxima.sequences);
+    memset(buffer, 0, sizeof(*buffer));
+}
+
+void time_series_clear(time_series_buffer *buffer)
+{
+    buffer->first = 0;
+    buffer->next = 0;
+    buffer->minima.head = buffer->minima.count = 0;
+    buffer->maxima.head = buffer->maxima.count = 0;
+}
+
+#pragma mark - Monotonic deques
+
+static inline uint64_t deque_front(const time_series_deque *deque)
+{
+    return deque->sequences[deque->head];
+}
+
+static inline uint64_t deque_back(const time_series_deque *deque, uint32_t capacity)
+{
+    return deque->sequences[(deque->head + deque->count - 1) % capacity];
+}
+
+static inline void deque_pop_front(time_series_deque *deque, uint32_t capacity)
+{
+    deque->head = (deque->head + 1) % capacity;
+    deque->count--;
+}
+
+static inline void deque_push_back(time_series_deque *deque, uint32_t capacity, uint64_t sequence)
+{
+    deque->sequences[(deque->head + deque->count) % capacity] = sequence;
+    deque->count++;
+}
+
+#pragma mark - Samples
+
+void time_series_append(time_series_buffer *buffer, double time, float value)
+{
+    uint32_t capacity = buffer->capacity;
+
+    if (buffer->next - buffer->first == capacity)
+    {
+        // The oldest sample leaves the buffer, and the deques if it is at their front
+        if (buffer->minima.count > 0 && deque_front(&buffer->minima) == buffer->first)
+        {
+            deque_pop_front(&buffer->minima, capacity);
+        }
+        if (buffer->maxima.count > 0 && deque_front(&buffer->maxima) == buffer->first)
+        {
+            deque_pop_front(&buffer->maxima, capacity);
+        }
+        buffer->first++;
+    }
+
+    uint64_t sequence = buffer->next++;
+    uint32_t position = (uint32_t)(sequence % capacity);
+    buffer->times[position] = time;
+    buffer->values[position] = value;
+
+    if (value != value)
+    {
+        return;
+    }
+
+    // Samples that are not below the new one can never be the minimum again while it is in the buffer
+    while (buffer->minima.count > 0 && buffer->values[deque_back(&buffer->minima, capacity) % capacity] >= value)
+    {
+        buffer->minima.count--;
+    }
+    deque_push_back(&buffer->minima, capacity, sequence);
+
+    while (buffer->maxima.count > 0 && buffer->values[deque_back(&buffer->maxima, capacity) % capacity] <= value)
+    {
+        buffer->maxima.count--;
+    }
+    deque_push_back(&buffer->maxima, capacity, sequence);
+}
+
+int time_series_min_max(const time_series_buffer *buffer, float *minimum, float *maximum)
+{
+    if (buffer->minima.count == 0)
+    {
+        return 0;
+    }
+    *minimum = buffer->values[deque_front(&buffer->minima) % buffer->capacity];
+    *maximum = buffer->values[deque_front(&buffer->maxima) % buffer->capacity];
+    return 1;
+}
+
+void time_series_get_window(const time_series_buffer *buffer, uint32_t start, uint32_t count, time_series_window *window)
+{
+    memset(window, 0, sizeof(*window));
+    uint32_t available = time_series_count(buffer);
+    if (start >= available)
+    {
+        return;
+    }
+    if (count > available - start)
+    {
+        count = available - start;
+    }
+
+    uint32_t position = (uint32_t)((buffer->first + start) % buffer->capacity);
+    uint32_t first_length = buffer->capacity - position;
+    if (first_length > count)
+    {
+        first_length = count;
+    }
+    window->times[0] = buffer->times + position;
+    window->values[0] = buffer->values + position;
+    window->length[0] = first_length;
+    if (count > first_length)
+    {
+        window->times[1] = buffer->times;
+        window->values[1] = buffer->values;
+        window->length[1] = count - first_length;
+    }
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#ifndef TimeSeriesBuffer_h
+#define TimeSeriesBuffer_h
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ *  @struct time_series_deque
+ *
+ *  @discussion Sequence numbers of the samples that can still become the minimum (or maximum) of the buffer, oldest
+ *  first, their values strictly increasing (or decreasing) from the front
+ *
+ */
+typedef struct
+{
+    uint64_t *sequences;
+    uint32_t head;
+    uint32_t count;
+} time_series_deque;
+
+/*!
+ *  @struct time_series_buffer
+ *
+ *  @discussion Fixed-capacity ring of samples kept as separate time and value arrays. Appending overwrites the
+ *  oldest sample once the buffer is full. The minimum and maximum value are kept in monotonic deques, so appending
+ *  and querying them are constant time; NaN values are stored but left out of both. Times are expected not to
+ *  decrease.
+ *
+ */
+typedef struct
+{
+    double *times;
+    float *values;
+    uint32_t capacity;
+    uint64_t first;                     // Sequence number of the oldest sample, the number of samples overwritten
+    uint64_t next;                      // Sequence number of the next sample
+    time_series_deque minima;
+    time_series_deque maxima;
+} time_series_buffer;
+
+/*!
+ *  @struct time_series_window
+ *
+ *  @discussion Samples of a range of the buffer, read in place. A range that wraps around the end of the ring is
+ *  split in two parts; length[1] is 0 otherwise. The pointers stay valid until the next append.
+ *
+ */
+typedef struct
+{
+    const double *times[2];
+    const float *values[2];
+    uint32_t length[2];
+} time_series_window;
+
+/*!
+ *  @function time_series_init
+ *
+ *  @discussion Allocates a buffer for capacity samples. Returns 0 if the capacity is 0 or the arrays cannot be
+ *  allocated.
+ *
+ */
+int time_series_init(time_series_buffer *buffer, uint32_t capacity);
+
+/*!
+ *  @function time_series_free
+ *
+ *  @discussion Releases the arrays of the buffer
+ *
+ */
+void time_series_free(time_series_buffer *buffer);
+
+/*!
+ *  @function time_series_clear
+ *
+ *  @discussion Removes every sample
+ *
+ */
+void time_series_clear(time_series_buffer *buffer);
+
+/*!
+ *  @function time_series_append
+ *
+ *  @discussion Appends a sample, overwriting the oldest one if the buffer is full
+ *
+ */
+void time_series_append(time_series_buffer *buffer, double time, float value);
+
+/*!
+ *  @function time_series_count
+ *
+ *  @discussion Returns the number of samples in the buffer
+ *
+ */
+static inline uint32_t time_series_count(const time_series_buffer *buffer)
+{
+    return (uint32_t)(buffer->next - buffer->first);
+}
+
+/*!
+ *  @function time_series_time_at
+ *
+ *  @discussion Returns the time of a sample, index 0 being the oldest. The index must be below the count.
+ *
+ */
+static inline double time_series_time_at(const time_series_buffer *buffer, uint32_t index)
+{
+    return buffer->times[(buffer->first + index) % buffer->capacity];
+}
+
+/*!
+ *  @function time_series_value_at
+ *
+ *  @discussion Returns the value of a sample, index 0 being the oldest. The index must be below the count.
+ *
+ */
+static inline float time_series_value_at(const time_series_buffer *buffer, uint32_t index)
+{
+    return buffer->values[(buffer->first + index) % buffer->capacity];
+}
+
+/*!
+ *  @function time_series_min_max
+ *
+ *  @discussion Gets the smallest and largest value in the buffer. Returns 0 if there is no value but NaN.
+ *
+ */
+int time_series_min_max(const time_series_buffer *buffer, float *minimum, float *maximum);
+
+/*!
+ *  @function time_series_get_window
+ *
+ *  @discussion Gets count samples from index start, index 0 being the oldest, without copying them. The range is
+ *  clipped to the samples in the buffer.
+ *
+ */
+void time_series_get_window(const time_series_buffer *buffer, uint32_t start, uint32_t count, time_series_window *window);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TimeSeriesBuffer_h */
@@ -0,0 +1,242 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#include "TimeSeriesLevels.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NO_SEQUENCE     UINT64_MAX
+
+int time_series_levels_init(time_series_levels *levels, uint32_t capacity)
+{
+    memset(levels, 0, sizeof(*levels));
+
+    // Levels whose blocks are smaller than the buffer; a range never needs a larger one
+    uint64_t block_size = TIME_SERIES_LEVEL_FACTOR;
+    while (block_size <= capacity && levels->level_count < TIME_SERIES_MAX_LEVELS)
+    {
+        time_series_level *level = &levels->levels[levels->level_count];
+        level->block_size = block_size;
+        level->capacity = (uint32_t)(capacity / block_size) + 2;
+        level->summaries = malloc(level->capacity * sizeof(time_series_summary));
+        if (level->summaries == NULL)
+        {
+            time_series_levels_free(levels);
+            return 0;
+        }
+        levels->level_count++;
+        block_size *= TIME_SERIES_LEVEL_FACTOR;
+    }
+    return 1;
+}
+
+void time_series_levels_free(time_series_levels *levels)
+{
+    for (uint32_t i = 0; i < levels->level_count; i++)
+    {
+        free(levels->levels[i].summaries);
+    }
+    memset(levels, 0, sizeof(*levels));
+}
+
+void time_series_levels_reset(time_series_levels *levels)
+{
+    levels->start = 0;
+    levels->next = 0;
+}
+
+#pragma mark - Summaries
+
+static inline void summary_clear(time_series_summary *summary)
+{
+    summary->minimum = INFINITY;
+    summary->maximum = -INFINITY;
+    summary->minimum_sequence = NO_SEQUENCE;
+    summary->maximum_sequence = NO_SEQUENCE;
+}
+
+static inline void summary_add(time_series_summary *summary, const time_series_summary *other)
+{
+    if (other->minimum_sequence != NO_SEQUENCE && (summary->minimum_sequence == NO_SEQUENCE || other->minimum < summary->minimum))
+    {
+        summary->minimum = other->minimum;
+        summary->minimum_sequence = other->minimum_sequence;
+    }
+    if (other->maximum_sequence != NO_SEQUENCE && (summary->maximum_sequence == NO_SEQUENCE || other->maximum > summary->maximum))
+    {
+        summary->maximum = other->maximum;
+        summary->maximum_sequence = other->maximum_sequence;
+    }
+}
+
+static inline void summary_add_sample(time_series_summary *summary, float value, uint64_t sequence)
+{
+    if (value != value)
+    {
+        return;
+    }
+    time_series_summary sample = {value, value, sequence, sequence};
+    summary_add(summary, &sample);
+}
+
+void time_series_levels_sync(time_series_levels *levels, const time_series_buffer *buffer)
+{
+    if (levels->next > buffer->next || levels->next < buffer->first)
+    {
+        // The buffer was cleared, or moved on past samples never summarized
+        levels->start = buffer->first;
+        levels->next = buffer->first;
+    }
+
+    for (uint64_t sequence = levels->next; sequence < buffer->next; sequence++)
+    {
+        float value = buffer->values[sequence % buffer->capacity];
+        for (uint32_t i = 0; i < levels->level_count; i++)
+        {
+            time_series_level *level = &levels->levels[i];
+            time_series_summary *summary = &level->summaries[(sequence / level->block_size) % level->capacity];
+            if (sequence % level->block_size == 0)
+            {
+                summary_clear(summary);
+            }
+            summary_add_sample(summary, value, sequence);
+        }
+    }
+    levels->next = buffer->next;
+}
+
+int time_series_range_min_max(const time_series_levels *levels, const time_series_buffer *buffer, uint32_t start, uint32_t end, time_series_summary *summary)
+{
+    summary_clear(summary);
+
+    // Whole blocks summarized since the reset are taken from the largest level that fits, the rest sample by sample
+    uint64_t sequence = buffer->first + start;
+    uint64_t last = buffer->first + end;
+    while (sequence < last)
+    {
+        const time_series_level *block = NULL;
+        for (uint32_t i = levels->level_count; i > 0; i--)
+        {
+            const time_series_level *level = &levels->levels[i - 1];
+            if (sequence % level->block_size == 0 && sequence >= levels->start
+                && sequence + level->block_size <= last && sequence + level->block_size <= levels->next)
+            {
+                block = level;
+                break;
+            }
+        }
+
+        if (block != NULL)
+        {
+            summary_add(summary, &block->summaries[(sequence / block->block_size) % block->capacity]);
+            sequence += block->block_size;
+        }
+        else
+        {
+            summary_add_sample(summary, buffer->values[sequence % buffer->capacity], sequence);
+            sequence++;
+        }
+    }
+    return summary->minimum_sequence != NO_SEQUENCE;
+}
+
+#pragma mark - Decimation
+
+/*!
+ *  @function lower_bound
+ *
+ *  @discussion Returns the index of the first sample at or after the time
+ *
+ */
+static uint32_t lower_bound(const time_series_buffer *buffer, double time)
+{
+    uint32_t low = 0;
+    uint32_t high = time_series_count(buffer);
+    while (low < high)
+    {
+        uint32_t middle = low + (high - low) / 2;
+        if (time_series_time_at(buffer, middle) < time)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static inline time_series_point point_of_sequence(const time_series_buffer *buffer, uint64_t sequence)
+{
+    uint32_t position = (uint32_t)(sequence % buffer->capacity);
+    time_series_point point = {buffer->times[position], buffer->values[position]};
+    return point;
+}
+
+uint32_t time_series_decimate(time_series_levels *levels, const time_series_buffer *buffer, double from_time, double to_time, uint32_t columns, time_series_point *points)
+{
+    if (columns == 0 || !(to_time > from_time))
+    {
+        return 0;
+    }
+    time_series_levels_sync(levels, buffer);
+
+    uint32_t count = 0;
+    double column_duration = (to_time - from_time) / columns;
+    uint32_t start = lower_bound(buffer, from_time);
+    for (uint32_t column = 0; column < columns; column++)
+    {
+        // The last column ends at to_time exactly, whatever the rounding of the others
+        uint32_t end = column + 1 == columns ? lower_bound(buffer, to_time) : lower_bound(buffer, from_time + (column + 1) * column_duration);
+        if (end <= start)
+        {
+            continue;
+        }
+
+        time_series_summary summary;
+        if (time_series_range_min_max(levels, buffer, start, end, &summary))
+        {
+            uint64_t first = summary.minimum_sequence < summary.maximum_sequence ? summary.minimum_sequence : summary.maximum_sequence;
+            uint64_t second = summary.minimum_sequence < summary.maximum_sequence ? summary.maximum_sequence : summary.minimum_sequence;
+            points[count++] = point_of_sequence(buffer, first);
+            if (second != first)
+            {
+                points[count++] = point_of_sequence(buffer, second);
+            }
+        }
+        start = end;
+    }
+    return count;
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#ifndef TimeSeriesLevels_h
+#define TimeSeriesLevels_h
+
+#include <stdint.h>
+
+#include "TimeSeriesBuffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ *  @discussion Samples summarized by one entry of a level, relative to the level below
+ *
+ */
+#define TIME_SERIES_LEVEL_FACTOR    8
+
+#define TIME_SERIES_MAX_LEVELS      10
+
+/*!
+ *  @struct time_series_summary
+ *
+ *  @discussion Smallest and largest value of a block of samples and the sequence numbers of the samples holding them,
+ *  UINT64_MAX if the block has no value but NaN
+ *
+ */
+typedef struct
+{
+    float minimum;
+    float maximum;
+    uint64_t minimum_sequence;
+    uint64_t maximum_sequence;
+} time_series_summary;
+
+/*!
+ *  @struct time_series_level
+ *
+ *  @discussion Summaries of the blocks of block_size samples, block n in slot n % capacity
+ *
+ */
+typedef struct
+{
+    time_series_summary *summaries;
+    uint64_t block_size;
+    uint32_t capacity;
+} time_series_level;
+
+/*!
+ *  @struct time_series_levels
+ *
+ *  @discussion Cached min/max summaries of a time series buffer at block sizes growing by TIME_SERIES_LEVEL_FACTOR,
+ *  so that the range of any run of samples is found from O(log n) summaries instead of the samples themselves. The
+ *  levels catch up with the samples appended since the last call when they are queried.
+ *
+ */
+typedef struct
+{
+    time_series_level levels[TIME_SERIES_MAX_LEVELS];
+    uint32_t level_count;
+    uint64_t start;                     // First sample summarized since the levels were reset
+    uint64_t next;                      // Next sample to summarize
+} time_series_levels;
+
+/*!
+ *  @struct time_series_point
+ *
+ *  @discussion Sample kept by decimation
+ *
+ */
+typedef struct
+{
+    double time;
+    float value;
+} time_series_point;
+
+/*!
+ *  @function time_series_levels_init
+ *
+ *  @discussion Allocates the levels for a buffer of the capacity. Returns 0 if they cannot be allocated.
+ *
+ */
+int time_series_levels_init(time_series_levels *levels, uint32_t capacity);
+
+/*!
+ *  @function time_series_levels_free
+ *
+ *  @discussion Releases the levels
+ *
+ */
+void time_series_levels_free(time_series_levels *levels);
+
+/*!
+ *  @function time_series_levels_reset
+ *
+ *  @discussion Forgets every summary, for a buffer that was cleared
+ *
+ */
+void time_series_levels_reset(time_series_levels *levels);
+
+/*!
+ *  @function time_series_levels_sync
+ *
+ *  @discussion Summarizes the samples appended to the buffer since the last call
+ *
+ */
+void time_series_levels_sync(time_series_levels *levels, const time_series_buffer *buffer);
+
+/*!
+ *  @function time_series_range_min_max
+ *
+ *  @discussion Gets the summary of the samples from index start, index 0 being the oldest, to index end exclusive.
+ *  Returns 0 if the range has no value but NaN. The levels must be in sync with the buffer.
+ *
+ */
+int time_series_range_min_max(const time_series_levels *levels, const time_series_buffer *buffer, uint32_t start, uint32_t end, time_series_summary *summary);
+
+/*!
+ *  @function time_series_decimate
+ *
+ *  @discussion Splits [from_time, to_time) into columns of equal duration and keeps the smallest and largest value of
+ *  each column in time order, so that a line through the points covers the same pixels as one through every sample.
+ *  points must have room for 2 * columns points. Returns the number of points, which is the number of samples in the
+ *  range when no column holds more than two. Costs O(columns * log n) whatever the number of samples in the range.
+ *
+ */
+uint32_t time_series_decimate(time_series_levels *levels, const time_series_buffer *buffer, double from_time, double to_time, uint32_t columns, time_series_point *points);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TimeSeriesLevels_h */
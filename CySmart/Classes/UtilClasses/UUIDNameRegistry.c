@@ -0,0 +1,123 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#include "UUIDNameRegistry.h"
+
+#include <string.h>
+
+#include "UUIDNameTable.h"
+
+// Bytes 4 to 15 of the Bluetooth base UUID, 0000xxxx-0000-1000-8000-00805F9B34FB
+static const uint8_t base_uuid_suffix[12] = {0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x34, 0xFB};
+
+/*!
+ *  @function uuid_name_hash
+ *
+ *  @discussion FNV-1a of the length and bytes, finished with a multiply-shift mix. Scripts/generate_uuid_name_table.py
+ *  computes the same hash to place the UUIDs.
+ *
+ */
+static uint32_t uuid_name_hash(const uint8_t *bytes, uint32_t length, uint32_t seed)
+{
+    uint32_t hash = (2166136261u ^ seed);
+    hash = (hash ^ length) * 16777619u;
+    for (uint32_t index = 0; index < length; index++)
+    {
+        hash = (hash ^ bytes[index]) * 16777619u;
+    }
+    hash ^= hash >> 15;
+    hash *= 0x2C1B3C6Du;
+    hash ^= hash >> 12;
+    return hash;
+}
+
+uint32_t uuid_name_canonicalize(const uint8_t *bytes, uint32_t length, uint8_t canonical[16])
+{
+    if (length != 2 && length != 4 && length != 16)
+    {
+        return 0;
+    }
+    if (length == 16 && memcmp(bytes + 4, base_uuid_suffix, sizeof(base_uuid_suffix)) == 0)
+    {
+        length = 4;
+    }
+    if (length == 4 && bytes[0] == 0 && bytes[1] == 0)
+    {
+        bytes += 2;
+        length = 2;
+    }
+    memcpy(canonical, bytes, length);
+    return length;
+}
+
+uint32_t uuid_name_lookup(const uint8_t *bytes, uint32_t length)
+{
+    uint8_t canonical[16];
+    length = uuid_name_canonicalize(bytes, length, canonical);
+    if (length == 0)
+    {
+        return UUID_NAME_NOT_FOUND;
+    }
+
+    // Two level perfect hash: the first hash picks the seed that places the bucket's UUIDs without collisions
+    uint32_t bucket = uuid_name_hash(canonical, length, 0) & (UUID_NAME_BUCKET_COUNT - 1);
+    uint32_t slot = uuid_name_hash(canonical, length, uuid_name_seeds[bucket]) & (UUID_NAME_TABLE_SIZE - 1);
+    const uuid_name_entry *entry = &uuid_name_entries[slot];
+    if (entry->length != length || memcmp(entry->bytes, canonical, length) != 0)
+    {
+        return UUID_NAME_NOT_FOUND;
+    }
+    return slot;
+}
+
+uint32_t uuid_name_table_size(void)
+{
+    return UUID_NAME_TABLE_SIZE;
+}
+
+const char *uuid_name_at(uint32_t slot, uint8_t bytes[16], uint32_t *length)
+{
+    if (slot >= UUID_NAME_TABLE_SIZE || uuid_name_entries[slot].length == 0)
+    {
+        return NULL;
+    }
+    const uuid_name_entry *entry = &uuid_name_entries[slot];
+    if (bytes != NULL)
+    {
+        memcpy(bytes, entry->bytes, entry->length);
+    }
+    if (length != NULL)
+    {
+        *length = entry->length;
+    }
+    return uuid_name_strings + entry->name_offset;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#ifndef UUIDNameRegistry_h
+#define UUIDNameRegistry_h
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UUID_NAME_NOT_FOUND     UINT32_MAX
+
+/*!
+ *  @struct uuid_name_entry
+ *
+ *  @discussion Slot of the compiled name table: a UUID in its shortest form, big endian like CBUUID data, and the
+ *  offset of its name in the interned names. Empty slots have length 0.
+ *
+ */
+typedef struct
+{
+    uint8_t length;
+    uint8_t bytes[16];
+    uint16_t name_offset;
+} uuid_name_entry;
+
+/*!
+ *  @function uuid_name_canonicalize
+ *
+ *  @discussion Reduces a 16, 32 or 128 bit UUID to its shortest form, the one CBUUID reports: a 128 bit UUID on the
+ *  Bluetooth base UUID becomes 32 bit, and a 32 bit UUID below 0x10000 becomes 16 bit. Returns the length of the
+ *  bytes written to canonical, 0 if length is not 2, 4 or 16.
+ *
+ */
+uint32_t uuid_name_canonicalize(const uint8_t *bytes, uint32_t length, uint8_t canonical[16]);
+
+/*!
+ *  @function uuid_name_lookup
+ *
+ *  @discussion Finds the UUID in the table compiled from serviceAndCharacteristicNames.plist. Returns the slot of
+ *  its name, below uuid_name_table_size(), or UUID_NAME_NOT_FOUND. Constant time and does not allocate.
+ *
+ */
+uint32_t uuid_name_lookup(const uint8_t *bytes, uint32_t length);
+
+/*!
+ *  @function uuid_name_table_size
+ *
+ *  @discussion Number of slots of the table, some of them empty
+ *
+ */
+uint32_t uuid_name_table_size(void);
+
+/*!
+ *  @function uuid_name_at
+ *
+ *  @discussion Name in the slot, NULL for an empty slot. The UUID of the slot is copied to bytes when bytes is not
+ *  NULL and its length written to length.
+ *
+ */
+const char *uuid_name_at(uint32_t slot, uint8_t bytes[16], uint32_t *length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UUIDNameRegistry_h */
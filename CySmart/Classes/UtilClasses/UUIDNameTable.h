@@ -0,0 +1,427 @@
+/*
+ * Generated by Scripts/generate_uuid_name_table.py from serviceAndCharacteristicNames.plist.
+ * Do not edit.
+ */
+
+#define UUID_NAME_COUNT             159
+#define UUID_NAME_TABLE_SIZE        256
+#define UUID_NAME_BUCKET_COUNT      64
+
+static const uint16_t uuid_name_seeds[UUID_NAME_BUCKET_COUNT] = {
+    1, 2, 0, 3, 1, 4, 2, 1, 1, 2, 2, 1, 2, 5, 6, 5,
+    2, 1, 1, 1, 2, 1, 9, 0, 4, 0, 2, 0, 2, 2, 1, 1,
+    3, 1, 3, 2, 2, 1, 2, 2, 1, 1, 4, 1, 1, 4, 3, 3,
+    1, 1, 10, 2, 12, 2, 2, 4, 0, 0, 2, 3, 2, 15, 9, 5,
+};
+
+static const uuid_name_entry uuid_name_entries[UUID_NAME_TABLE_SIZE] = {
+    {2, {0x2A, 0x94}, 3193},    /* Three Zone Heart Rate Limits */
+    {2, {0x2A, 0x81}, 402},    /* Anaerobic Heart Rate Lower Limit */
+    {2, {0xCA, 0xB6}, 970},    /* CapSense Service */
+    {0, {0}, 0},
+    {2, {0x2A, 0x41}, 2679},    /* Ringer Setting */
+    {2, {0x2A, 0x44}, 329},    /* Alert Notification Control Point */
+    {0, {0}, 0},
+    {2, {0x2A, 0x80}, 268},    /* Age */
+    {0, {0}, 0},
+    {2, {0x2A, 0x7E}, 188},    /* Aerobic Heart Rate Lower Limit */
+    {0, {0}, 0},
+    {2, {0x2A, 0x02}, 2378},    /* Peripheral Privacy Flag */
+    {2, {0x2A, 0x49}, 711},    /* Blood Pressure Feature */
+    {2, {0xCA, 0xA3}, 934},    /* CapSense Buttons */
+    {2, {0x2A, 0x85}, 1309},    /* Date of Birth */
+    {2, {0x2A, 0x34}, 1659},    /* Glucose Measurement Context */
+    {2, {0x2A, 0x8C}, 1574},    /* Gender */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {2, {0x2A, 0x38}, 784},    /* Body Sensor Location */
+    {2, {0x2A, 0x4E}, 2453},    /* Protocol Mode */
+    {16, {0x00, 0x04, 0x00, 0x31, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 3097},    /* Temperature Analog Sensor */
+    {2, {0x2A, 0x48}, 3055},    /* Supported Unread Alert Category */
+    {2, {0x2A, 0x54}, 2694},    /* Running Speed and Cadence Feature */
+    {2, {0x2A, 0x42}, 290},    /* Alert Category ID Bit Mask */
+    {0, {0}, 0},
+    {2, {0x2A, 0x4D}, 2621},    /* Report */
+    {0, {0}, 0},
+    {2, {0x18, 0x0C}, 1614},    /* Glucose  */
+    {0, {0}, 0},
+    {16, {0x00, 0x06, 0x00, 0x01, 0xF8, 0xCE, 0x11, 0xE4, 0xAB, 0xF4, 0x00, 0x02, 0xA5, 0xD5, 0xC5, 0x1B}, 884},    /* BootLoader Data Characteristic */
+    {0, {0}, 0},
+    {2, {0x2A, 0x12}, 3222},    /* Time Accuracy */
+    {0, {0}, 0},
+    {2, {0x2A, 0x01}, 515},    /* Appearance */
+    {2, {0x2A, 0x82}, 435},    /* Anaerobic Heart Rate Upper Limit */
+    {0, {0}, 0},
+    {2, {0x2A, 0x55}, 2912},    /* Speed and Cadence Control Point */
+    {0, {0}, 0},
+    {2, {0x2A, 0xA2}, 2098},    /* Language */
+    {16, {0x00, 0x04, 0x00, 0x01, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 628},    /* Barometer Service */
+    {2, {0x2A, 0x36}, 2018},    /* Intermediate Cuff Pressure */
+    {2, {0x2A, 0x0C}, 1431},    /* Exact Time 256 */
+    {2, {0x18, 0x0D}, 1883},    /* Heart Rate Service */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {2, {0x2A, 0x4F}, 2800},    /* Scan Interval Window */
+    {2, {0x18, 0x12}, 1927},    /* Human Interface Device */
+    {2, {0x2A, 0x24}, 2270},    /* Model Number String */
+    {2, {0x2A, 0x2A}, 1950},    /* IEEE 11073-20601 Regulatory Certification Data List */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {2, {0x2A, 0x1D}, 3176},    /* Temperature Type */
+    {0, {0}, 0},
+    {2, {0x18, 0x16}, 1228},    /* Cycling Speed and Cadence Service */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {16, {0x00, 0x04, 0x00, 0x2D, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 141},    /* Accelerometer Z Reading */
+    {2, {0x2A, 0x51}, 1623},    /* Glucose Feature */
+    {0, {0}, 0},
+    {2, {0xCA, 0xB5}, 970},    /* CapSense Service */
+    {0, {0}, 0},
+    {16, {0x00, 0x04, 0x00, 0x2B, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 117},    /* Accelerometer Y Reading */
+    {2, {0x18, 0x03}, 2117},    /* Link Loss */
+    {16, {0x00, 0x03, 0xCA, 0xA2, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 987},    /* CapSense Slider */
+    {2, {0x2A, 0x22}, 805},    /* Boot Keyboard Input Report */
+    {0, {0}, 0},
+    {2, {0x2A, 0x84}, 219},    /* Aerobic Heart Rate Upper Limit */
+    {0, {0}, 0},
+    {2, {0x2A, 0x88}, 1446},    /* Fat Burn Heart Rate Lower Limit */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {2, {0x2A, 0x18}, 1639},    /* Glucose Measurement */
+    {0, {0}, 0},
+    {16, {0x00, 0x04, 0x00, 0x20, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 95},    /* Accelerometer Service */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {2, {0x2A, 0x8F}, 1909},    /* Hip Circumference */
+    {16, {0x00, 0x06, 0x00, 0x00, 0xF8, 0xCE, 0x11, 0xE4, 0xAB, 0xF4, 0x00, 0x02, 0xA5, 0xD5, 0xC5, 0x1B}, 915},    /* BootLoader Service */
+    {2, {0x2A, 0x08}, 1299},    /* Date Time */
+    {2, {0x2A, 0x87}, 1417},    /* Email Address */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {2, {0x18, 0x0E}, 2402},    /* Phone Alert Status Service */
+    {2, {0x18, 0x10}, 761},    /* Blood Pressure Service */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {16, {0x00, 0x03, 0xCB, 0xB1, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 2467},    /* RGB LED Control */
+    {2, {0x18, 0x02}, 2002},    /* Immediate Alert */
+    {2, {0x2A, 0x40}, 2658},    /* Ringer Control Point */
+    {0, {0}, 0},
+    {2, {0x2A, 0x28}, 2887},    /* Software Revision String */
+    {2, {0x2A, 0x37}, 1860},    /* Heart Rate Measurement */
+    {0, {0}, 0},
+    {2, {0x2A, 0x66}, 1037},    /* Cycling Power Control Point */
+    {2, {0x2A, 0x86}, 1323},    /* Date of Threshold Assessment */
+    {0, {0}, 0},
+    {2, {0x2A, 0x00}, 1405},    /* Device Name */
+    {0, {0}, 0},
+    {2, {0x2A, 0x68}, 2290},    /* Navigation */
+    {2, {0x2A, 0x93}, 2978},    /* Sport Type for Aerobic and Anaerobic Thresholds */
+    {2, {0x2A, 0x14}, 2564},    /* Reference Time Information */
+    {16, {0x00, 0x04, 0x00, 0x23, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 60},    /* Accelerometer Sensor Scan Interval */
+    {2, {0x2A, 0x35}, 734},    /* Blood Pressure Measurement */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {2, {0x2A, 0x32}, 832},    /* Boot Keyboard Output Report */
+    {2, {0x18, 0x13}, 2821},    /* Scan Parameters */
+    {16, {0x00, 0x04, 0x00, 0x07, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 526},    /* Barometer Data Accumulation */
+    {0, {0}, 0},
+    {16, {0x00, 0x04, 0x00, 0x02, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 554},    /* Barometer Digital Sensor */
+    {2, {0x2A, 0x4B}, 2628},    /* Report Map */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {2, {0x2A, 0x1E}, 2045},    /* Intermediate Temperature */
+    {2, {0x2A, 0x90}, 2107},    /* Last Name */
+    {2, {0x18, 0x14}, 2766},    /* Running Speed and Cadence Service */
+    {2, {0x2A, 0x29}, 2193},    /* Manufacturer Name String */
+    {2, {0x2A, 0x4A}, 1721},    /* HID Information */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {2, {0x18, 0x1C}, 3272},    /* User Data */
+    {0, {0}, 0},
+    {2, {0x2A, 0x26}, 1510},    /* Firmware Revision String */
+    {2, {0x2A, 0x65}, 1065},    /* Cycling Power Feature */
+    {0, {0}, 0},
+    {2, {0x18, 0x07}, 2311},    /* Next DST Change Service */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {16, {0x00, 0x04, 0x00, 0x32, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 3143},    /* Temperature Sensor Scan Interval */
+    {2, {0x2A, 0x46}, 2301},    /* New Alert */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {2, {0x2A, 0x0F}, 2127},    /* Local Time Information */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {2, {0xCA, 0xA1}, 951},    /* CapSense Proximity */
+    {2, {0x2A, 0x19}, 681},    /* Battery Level */
+    {2, {0x2A, 0x67}, 2174},    /* Location and Speed */
+    {0, {0}, 0},
+    {2, {0x2A, 0x21}, 2249},    /* Measurement Interval */
+    {2, {0x2A, 0x1C}, 1762},    /* Health Thermometer Measurement */
+    {2, {0x2A, 0x8D}, 1845},    /* Heart Rate Max */
+    {0, {0}, 0},
+    {16, {0x00, 0x03, 0xCA, 0xA3, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 934},    /* CapSense Buttons */
+    {2, {0x2A, 0x53}, 2728},    /* Running Speed and Cadence Measurement */
+    {0, {0}, 0},
+    {16, {0x00, 0x04, 0x00, 0x26, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 28},    /* Accelerometer Data Accumulation */
+    {0, {0}, 0},
+    {2, {0x2A, 0x23}, 3087},    /* System ID */
+    {2, {0x2A, 0x92}, 2639},    /* Resting Heart Rate */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {2, {0x2A, 0x50}, 2429},    /* PnP ID */
+    {2, {0x2A, 0x69}, 2436},    /* Position Quality */
+    {2, {0x2A, 0x47}, 3026},    /* Supported New Alert Category */
+    {2, {0x18, 0x11}, 362},    /* Alert Notification Service */
+    {2, {0x2A, 0x07}, 3257},    /* Tx Power Level */
+    {2, {0x18, 0x18}, 1113},    /* Cycling Power Service */
+    {2, {0x18, 0x00}, 1581},    /* Generic Access */
+    {2, {0x2A, 0x0A}, 1352},    /* Day Date Time */
+    {0, {0}, 0},
+    {2, {0x2A, 0x31}, 2837},    /* Scan Refresh */
+    {0, {0}, 0},
+    {2, {0x2A, 0x05}, 2871},    /* Service Changed */
+    {2, {0x2A, 0x5B}, 1190},    /* Cycling Speed and Cadence Measurement */
+    {16, {0x00, 0x04, 0x00, 0x21, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 0},    /* Accelerometer Analog Sensor */
+    {2, {0x2A, 0x8B}, 1546},    /* Five Zone Heart Rate Limits */
+    {16, {0x00, 0x04, 0x00, 0x33, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 3123},    /* Temperature Reading */
+    {0, {0}, 0},
+    {2, {0x18, 0x04}, 3248},    /* Tx Power */
+    {2, {0x2A, 0x6B}, 2070},    /* LN Control Point */
+    {2, {0x2A, 0x27}, 1737},    /* Hardware Revision String */
+    {2, {0x2A, 0x25}, 2850},    /* Serial Number String */
+    {16, {0x00, 0x03, 0xCA, 0xA1, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 951},    /* CapSense Proximity */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {2, {0x2A, 0x63}, 1087},    /* Cycling Power Measurement */
+    {16, {0x00, 0x04, 0x00, 0x30, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 488},    /* Analog Temperature Service */
+    {4, {0x00, 0x06, 0x00, 0x00}, 915},    /* BootLoader Service */
+    {0, {0}, 0},
+    {2, {0x18, 0x19}, 2150},    /* Location and Navigation */
+    {0, {0}, 0},
+    {2, {0x2A, 0x89}, 1478},    /* Fat Burn Heart Rate Upper Limit */
+    {2, {0x2A, 0x52}, 2536},    /* Record Access Control Point */
+    {0, {0}, 0},
+    {2, {0x18, 0x01}, 1596},    /* Generic Attribute */
+    {2, {0x2A, 0x13}, 3236},    /* Time Source */
+    {2, {0xCB, 0xB1}, 2467},    /* RGB LED Control */
+    {0, {0}, 0},
+    {2, {0x2A, 0x7F}, 250},    /* Aerobic Threshold */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {2, {0x2A, 0x5C}, 1156},    /* Cycling Speed and Cadence Feature */
+    {0, {0}, 0},
+    {2, {0x2A, 0x43}, 272},    /* Alert Category ID */
+    {0, {0}, 0},
+    {2, {0xCB, 0xBB}, 2499},    /* RGB LED service */
+    {2, {0x2A, 0x8A}, 1535},    /* First Name */
+    {16, {0x00, 0x04, 0x00, 0x09, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 579},    /* Barometer Reading */
+    {0, {0}, 0},
+    {2, {0x18, 0x0A}, 1378},    /* Device Information Service */
+    {4, {0x00, 0x06, 0x00, 0x01}, 884},    /* BootLoader Data Characteristic */
+    {2, {0x2A, 0x33}, 860},    /* Boot Mouse Input Report */
+    {0, {0}, 0},
+    {16, {0x00, 0x04, 0x00, 0x04, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 597},    /* Barometer Sensor Scan Interval */
+    {2, {0x2A, 0x39}, 1820},    /* Heart Rate Control Point */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {2, {0x2A, 0x06}, 317},    /* Alert Level */
+    {2, {0x18, 0x06}, 2591},    /* Reference Time Update Service */
+    {2, {0x2A, 0x6A}, 2087},    /* LN Feature */
+    {2, {0x2A, 0x09}, 1366},    /* Day of Week */
+    {16, {0x00, 0x04, 0x00, 0x0D, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 646},    /* Barometer Threshold For Indication */
+    {2, {0x18, 0x0F}, 695},    /* Battery Service */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {2, {0x2A, 0x3F}, 389},    /* Alert Status */
+    {16, {0x00, 0x03, 0xCB, 0xBB, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 2483},    /* RGB LED Service */
+    {16, {0x00, 0x03, 0xCA, 0xB5, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 970},    /* CapSense Service */
+    {2, {0x2A, 0x2B}, 1003},    /* Current Time */
+    {16, {0x00, 0x04, 0x00, 0x28, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x01, 0x31}, 165},    /* Accelrometer X Reading */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {2, {0x2A, 0x99}, 1273},    /* Database Change Increment */
+    {2, {0x2A, 0x03}, 2515},    /* Reconnection Address */
+    {2, {0x2A, 0x4C}, 1703},    /* HID Control Point */
+    {2, {0x18, 0x09}, 1793},    /* Health Thermometer Service */
+    {2, {0x18, 0x05}, 1016},    /* Current Time Service */
+    {2, {0x18, 0x08}, 1687},    /* Glucose Service */
+    {2, {0xCA, 0xA2}, 987},    /* CapSense Slider */
+    {2, {0x2A, 0x83}, 468},    /* Anaerobic Threshold */
+    {0, {0}, 0},
+    {2, {0x2A, 0x64}, 1135},    /* Cycling Power Vector */
+    {2, {0x2A, 0x0D}, 1262},    /* DST Offset */
+    {0, {0}, 0},
+    {2, {0x2A, 0x5D}, 2944},    /* Speed and Cadence Sensor Location */
+    {2, {0x2A, 0x8E}, 1902},    /* Height */
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {0, {0}, 0},
+    {2, {0x2A, 0x04}, 2335},    /* Peripheral Preferred Connection Parameters */
+    {2, {0x2A, 0x91}, 2218},    /* Maximum Recommended Heart Rate */
+    {0, {0}, 0},
+};
+
+static const char uuid_name_strings[] =
+    "Accelerometer Analog Sensor\0"
+    "Accelerometer Data Accumulation\0"
+    "Accelerometer Sensor Scan Interval\0"
+    "Accelerometer Service\0"
+    "Accelerometer Y Reading\0"
+    "Accelerometer Z Reading\0"
+    "Accelrometer X Reading\0"
+    "Aerobic Heart Rate Lower Limit\0"
+    "Aerobic Heart Rate Upper Limit\0"
+    "Aerobic Threshold\0"
+    "Age\0"
+    "Alert Category ID\0"
+    "Alert Category ID Bit Mask\0"
+    "Alert Level\0"
+    "Alert Notification Control Point\0"
+    "Alert Notification Service\0"
+    "Alert Status\0"
+    "Anaerobic Heart Rate Lower Limit\0"
+    "Anaerobic Heart Rate Upper Limit\0"
+    "Anaerobic Threshold\0"
+    "Analog Temperature Service\0"
+    "Appearance\0"
+    "Barometer Data Accumulation\0"
+    "Barometer Digital Sensor\0"
+    "Barometer Reading\0"
+    "Barometer Sensor Scan Interval\0"
+    "Barometer Service\0"
+    "Barometer Threshold For Indication\0"
+    "Battery Level\0"
+    "Battery Service\0"
+    "Blood Pressure Feature\0"
+    "Blood Pressure Measurement\0"
+    "Blood Pressure Service\0"
+    "Body Sensor Location\0"
+    "Boot Keyboard Input Report\0"
+    "Boot Keyboard Output Report\0"
+    "Boot Mouse Input Report\0"
+    "BootLoader Data Characteristic\0"
+    "BootLoader Service\0"
+    "CapSense Buttons\0"
+    "CapSense Proximity\0"
+    "CapSense Service\0"
+    "CapSense Slider\0"
+    "Current Time\0"
+    "Current Time Service\0"
+    "Cycling Power Control Point\0"
+    "Cycling Power Feature\0"
+    "Cycling Power Measurement\0"
+    "Cycling Power Service\0"
+    "Cycling Power Vector\0"
+    "Cycling Speed and Cadence Feature\0"
+    "Cycling Speed and Cadence Measurement\0"
+    "Cycling Speed and Cadence Service\0"
+    "DST Offset\0"
+    "Database Change Increment\0"
+    "Date Time\0"
+    "Date of Birth\0"
+    "Date of Threshold Assessment\0"
+    "Day Date Time\0"
+    "Day of Week\0"
+    "Device Information Service\0"
+    "Device Name\0"
+    "Email Address\0"
+    "Exact Time 256\0"
+    "Fat Burn Heart Rate Lower Limit\0"
+    "Fat Burn Heart Rate Upper Limit\0"
+    "Firmware Revision String\0"
+    "First Name\0"
+    "Five Zone Heart Rate Limits\0"
+    "Gender\0"
+    "Generic Access\0"
+    "Generic Attribute\0"
+    "Glucose \0"
+    "Glucose Feature\0"
+    "Glucose Measurement\0"
+    "Glucose Measurement Context\0"
+    "Glucose Service\0"
+    "HID Control Point\0"
+    "HID Information\0"
+    "Hardware Revision String\0"
+    "Health Thermometer Measurement\0"
+    "Health Thermometer Service\0"
+    "Heart Rate Control Point\0"
+    "Heart Rate Max\0"
+    "Heart Rate Measurement\0"
+    "Heart Rate Service\0"
+    "Height\0"
+    "Hip Circumference\0"
+    "Human Interface Device\0"
+    "IEEE 11073-20601 Regulatory Certification Data List\0"
+    "Immediate Alert\0"
+    "Intermediate Cuff Pressure\0"
+    "Intermediate Temperature\0"
+    "LN Control Point\0"
+    "LN Feature\0"
+    "Language\0"
+    "Last Name\0"
+    "Link Loss\0"
+    "Local Time Information\0"
+    "Location and Navigation\0"
+    "Location and Speed\0"
+    "Manufacturer Name String\0"
+    "Maximum Recommended Heart Rate\0"
+    "Measurement Interval\0"
+    "Model Number String\0"
+    "Navigation\0"
+    "New Alert\0"
+    "Next DST Change Service\0"
+    "Peripheral Preferred Connection Parameters\0"
+    "Peripheral Privacy Flag\0"
+    "Phone Alert Status Service\0"
+    "PnP ID\0"
+    "Position Quality\0"
+    "Protocol Mode\0"
+    "RGB LED Control\0"
+    "RGB LED Service\0"
+    "RGB LED service\0"
+    "Reconnection Address\0"
+    "Record Access Control Point\0"
+    "Reference Time Information\0"
+    "Reference Time Update Service\0"
+    "Report\0"
+    "Report Map\0"
+    "Resting Heart Rate\0"
+    "Ringer Control Point\0"
+    "Ringer Setting\0"
+    "Running Speed and Cadence Feature\0"
+    "Running Speed and Cadence Measurement\0"
+    "Running Speed and Cadence Service\0"
+    "Scan Interval Window\0"
+    "Scan Parameters\0"
+    "Scan Refresh\0"
+    "Serial Number String\0"
+    "Service Changed\0"
+    "Software Revision String\0"
+    "Speed and Cadence Control Point\0"
+    "Speed and Cadence Sensor Location\0"
+    "Sport Type for Aerobic and Anaerobic Thresholds\0"
+    "Supported New Alert Category\0"
+    "Supported Unread Alert Category\0"
+    "System ID\0"
+    "Temperature Analog Sensor\0"
+    "Temperature Reading\0"
+    "Temperature Sensor Scan Interval\0"
+    "Temperature Type\0"
+    "Three Zone Heart Rate Limits\0"
+    "Time Accuracy\0"
+    "Time Source\0"
+    "Tx Power\0"
+    "Tx Power Level\0"
+    "User Data\0";
@@ -33,6 +33,7 @@
 #import <Foundation/Foundation.h>
 #import <CoreBluetooth/CoreBluetooth.h>
 #import "Constants.h"
+#import "GATTTraceRecord.h"
 #import <UIKit/UIKit.h>
 
 
@@ -179,6 +180,25 @@
 
 +(void) logDataWithService:(NSString *)serviceName characteristic:(NSString *)characteristicName descriptor:(NSString *)descriptorName operation:(NSString *)operationInfo;
 
+/*!
+ *  @method getTraceUUID: fromUUID:
+ *
+ *  @discussion Method that copies the bytes of a UUID into a trace record
+ *
+ */
+
++(void) getTraceUUID:(gatt_trace_uuid *)traceUUID fromUUID:(CBUUID *)UUID;
+
+/*!
+ *  @method logTraceWithService: characteristic: descriptor: operation: data: error:
+ *
+ *  @discussion Method to log a GATT operation as a trace record. Only the UUIDs and the value bytes are captured; the
+ *  names and text are rendered when the log is read. data is ignored when error is set.
+ *
+ */
+
++(void) logTraceWithService:(CBUUID *)serviceUUID characteristic:(CBUUID *)characteristicUUID descriptor:(CBUUID *)descriptorUUID operation:(gatt_trace_opcode)operation data:(NSData *)data error:(NSError *)error;
+
 /*!
  *  @method convertSFLOATFromData:
  *
@@ -32,7 +32,9 @@
 
 #import "Utilities.h"
 #import "LoggerHandler.h"
+#import "CyCBManager.h"
 #import "NSString+hex.h"
+#import "CyChecksum.h"
 
 /*!
  *  @class Utilities
@@ -400,30 +402,17 @@
 
 +(NSString *) convertDataToLoggerFormat:(NSData *)data
 {
-    NSString *dataString = [NSString stringWithFormat:@"%@",data];
-    dataString = [[[dataString stringByReplacingOccurrencesOfString:@"<" withString:@""] stringByReplacingOccurrencesOfString:@">" withString:@""] stringByReplacingOccurrencesOfString:@" " withString:@""];
-    NSString *tempString = @"";
-    
-    if (dataString.length != 0)
+    if (data.length == 0)
     {
-        int i = 0;
-        for (; i < dataString.length-1; i++)
-        {
-            if ((i%2) != 0)
-            {
-                tempString = [tempString stringByAppendingString:[NSString stringWithFormat:@"%c ",[dataString characterAtIndex:i]]];
-            }
-            else
-                tempString = [tempString stringByAppendingString:[NSString stringWithFormat:@"%c",[dataString characterAtIndex:i]]];
-        }
-        tempString = [tempString stringByAppendingString:[NSString stringWithFormat:@"%c",[dataString characterAtIndex:i]]];
-
+        return @"[ ]";
     }
-    else
-        tempString = @" ";
     
-    NSString *logString = [NSString stringWithFormat:@"[%@]",tempString];
-    return logString;
+    NSMutableData *hexData = [NSMutableData dataWithLength:3 * data.length + 2];
+    char *hex = hexData.mutableBytes;
+    hex[0] = '[';
+    size_t length = gatt_trace_format_hex(data.bytes, data.length, hex + 1);
+    hex[length + 1] = ']';
+    return [[NSString alloc] initWithBytes:hex length:length + 2 encoding:NSASCIIStringEncoding];
 }
 
 /*!
@@ -445,6 +434,51 @@
     }
 }
 
+/*!
+ *  @method getTraceUUID: fromUUID:
+ *
+ *  @discussion Method that copies the bytes of a UUID into a trace record
+ *
+ */
+
++(void) getTraceUUID:(gatt_trace_uuid *)traceUUID fromUUID:(CBUUID *)UUID
+{
+    NSData *UUIDData = UUID.data;
+    if (UUIDData.length <= sizeof(traceUUID->bytes))
+    {
+        traceUUID->length = (uint8_t)UUIDData.length;
+        [UUIDData getBytes:traceUUID->bytes length:UUIDData.length];
+    }
+}
+
+/*!
+ *  @method logTraceWithService: characteristic: descriptor: operation: data: error:
+ *
+ *  @discussion Method to log a GATT operation as a trace record
+ *
+ */
+
++(void) logTraceWithService:(CBUUID *)serviceUUID characteristic:(CBUUID *)characteristicUUID descriptor:(CBUUID *)descriptorUUID operation:(gatt_trace_opcode)operation data:(NSData *)data error:(NSError *)error
+{
+    gatt_trace_record record = {0};
+    record.opcode = operation;
+    [[[[CyCBManager sharedManager] myPeripheral] identifier] getUUIDBytes:record.peripheral];
+    [self getTraceUUID:&record.service fromUUID:serviceUUID];
+    [self getTraceUUID:&record.characteristic fromUUID:characteristicUUID];
+    [self getTraceUUID:&record.descriptor fromUUID:descriptorUUID];
+    
+    NSData *payload = data;
+    if (error != nil)
+    {
+        record.status = (int32_t)(error.code != 0 ? error.code : -1);
+        payload = [[error.userInfo objectForKey:NSLocalizedDescriptionKey] dataUsingEncoding:NSUTF8StringEncoding];
+    }
+    record.payload = payload.bytes;
+    record.payload_length = (uint16_t)MIN(payload.length, UINT16_MAX);
+    
+    [[LoggerHandler logManager] addTraceRecord:&record];
+}
+
 
 /*!
  *  @method convertSFLOATFromData:
@@ -513,34 +547,7 @@
  */
 +(uint32_t) CRC32ForByteArray:(uint8_t *)buf ofSize:(uint32_t)size
 {
-    enum {
-        g0 = 0x82F63B78,
-        g1 = (g0 >> 1) & 0x7fffffff,
-        g2 = (g0 >> 2) & 0x3fffffff,
-        g3 = (g0 >> 3) & 0x1fffffff,
-    };
-    const static uint32_t table[16] =
-    {
-        0,                  (uint32_t)g3,           (uint32_t)g2,           (uint32_t)(g2^g3),
-        (uint32_t)g1,       (uint32_t)(g1^g3),      (uint32_t)(g1^g2),      (uint32_t)(g1^g2^g3),
-        (uint32_t)g0,       (uint32_t)(g0^g3),      (uint32_t)(g0^g2),      (uint32_t)(g0^g2^g3),
-        (uint32_t)(g0^g1),  (uint32_t)(g0^g1^g3),   (uint32_t)(g0^g1^g2),   (uint32_t)(g0^g1^g2^g3),
-    };
-    
-    uint8_t* data = (uint8_t*)buf;
-    uint32_t crc = 0xFFFFFFFF;
-    while (size != 0)
-    {
-        int i;
-        --size;
-        crc = crc ^ (*data);
-        ++data;
-        for (i = 1; i >= 0; i--)
-        {
-            crc = (crc >> 4) ^ table[crc & 0xF];
-        }
-    }
-    return ~crc;
+    return cy_crc32c(buf, size);
 }
 
 @end
@@ -301,8 +301,7 @@ static NSInteger const kNavButtonWidth = 40;
         NSString *filePath = [docsPath stringByAppendingPathComponent:loggerVC.currentLogFileName];
         NSURL *textFileUrl = [NSURL fileURLWithPath:filePath];
         
-        NSError *error;
-        [loggerVC.loggerTextView.text writeToURL:textFileUrl atomically:YES encoding:NSUTF8StringEncoding error:&error];
+        [loggerVC writeCurrentLogToURL:textFileUrl];
         
         NSArray *shareExcludedActivitiesArray = @[UIActivityTypeCopyToPasteboard,UIActivityTypeAssignToContact,UIActivityTypeMessage,UIActivityTypePostToFacebook,UIActivityTypePostToTwitter];
         [self showActivityPopover:textFileUrl Rect:[(UIButton *)sender frame] excludedActivities:shareExcludedActivitiesArray];
@@ -221,7 +221,7 @@
  */
 -(IBAction)readBtnClicked:(UIButton *)sender
 {
-    [self logButtonAction:READ_REQUEST];
+    [self logButtonAction:GATT_TRACE_READ_REQUEST];
     [[[CyCBManager sharedManager] myPeripheral] readValueForDescriptor:self.descriptor];
 }
 
@@ -235,13 +235,13 @@
 {
     if (!sender.selected) {
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:YES forCharacteristic:[[CyCBManager sharedManager] myCharacteristic]];
-        [self logOperation:[NSString stringWithFormat:@"%@%@ [01 00]",WRITE_REQUEST,DATA_SEPERATOR] andData:nil];
-        [self logButtonAction:START_NOTIFY];
+        [self logOperation:GATT_TRACE_WRITE_REQUEST andData:[NSData dataWithBytes:(uint8_t[]){0x01, 0x00} length:2]];
+        [self logButtonAction:GATT_TRACE_START_NOTIFY];
     }
     else {
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:NO forCharacteristic:[[CyCBManager sharedManager] myCharacteristic]];
-        [self logOperation:[NSString stringWithFormat:@"%@%@ [00 00]",WRITE_REQUEST,DATA_SEPERATOR] andData:nil];
-        [self logButtonAction:STOP_NOTIFY];
+        [self logOperation:GATT_TRACE_WRITE_REQUEST andData:[NSData dataWithBytes:(uint8_t[]){0x00, 0x00} length:2]];
+        [self logButtonAction:GATT_TRACE_STOP_NOTIFY];
     }
 
     [sender setSelected:sender.selected ? NO : YES];
@@ -254,13 +254,13 @@
 {
     if (!sender.selected) {
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:YES forCharacteristic:[[CyCBManager sharedManager] myCharacteristic]];
-        [self logOperation:[NSString stringWithFormat:@"%@%@ [02 00]",WRITE_REQUEST,DATA_SEPERATOR] andData:nil];
-        [self logButtonAction:START_INDICATE];
+        [self logOperation:GATT_TRACE_WRITE_REQUEST andData:[NSData dataWithBytes:(uint8_t[]){0x02, 0x00} length:2]];
+        [self logButtonAction:GATT_TRACE_START_INDICATE];
     }
     else {
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:NO forCharacteristic:[[CyCBManager sharedManager] myCharacteristic]];
-        [self logOperation:[NSString stringWithFormat:@"%@%@ [00 00]",WRITE_REQUEST,DATA_SEPERATOR] andData:nil];
-        [self logButtonAction:STOP_INDICATE];
+        [self logOperation:GATT_TRACE_WRITE_REQUEST andData:[NSData dataWithBytes:(uint8_t[]){0x00, 0x00} length:2]];
+        [self logButtonAction:GATT_TRACE_STOP_INDICATE];
     }
     
     [sender setSelected:sender.selected ? NO : YES];
@@ -285,7 +285,7 @@
         if ([descriptor.UUID.UUIDString isEqual:CBUUIDCharacteristicFormatString])
         {
             [self parseDataForCharacteristicPresentationFormatDescriptor:descriptor];
-            [self logOperation:READ_RESPONSE andData:descriptor.value];
+            [self logOperation:GATT_TRACE_READ_RESPONSE andData:descriptor.value];
         }
         else if ([descriptor.UUID.UUIDString isEqual:CBUUIDCharacteristicUserDescriptionString])
         {
@@ -295,7 +295,7 @@
             descriptorHexValueLabel.text = [NSString stringWithFormat:@"%@",data];
             descriptorValueLabel.text = descriptor.value;
             
-            [self logOperation:READ_RESPONSE andData:data];
+            [self logOperation:GATT_TRACE_READ_RESPONSE andData:data];
 
         }
         else
@@ -313,11 +313,11 @@
 
             if (descriptorHexValueLabel.text.length == 1)
             {
-                [self logOperation:[NSString stringWithFormat:@"%@%@ [0%@ 00]",READ_RESPONSE,DATA_SEPERATOR,descriptorHexValueLabel.text] andData:nil];
+                [self logOperation:GATT_TRACE_READ_RESPONSE andData:[NSData dataWithBytes:(uint8_t[]){(uint8_t)[descriptorHexValueLabel.text integerValue], 0x00} length:2]];
                 descriptorHexValueLabel.text = [NSString stringWithFormat:@"0%@ 00",descriptorHexValueLabel.text];
             }
             else
-                [self logOperation:READ_RESPONSE andData:descriptor.value];
+                [self logOperation:GATT_TRACE_READ_RESPONSE andData:descriptor.value];
         }
     }
 }
@@ -407,9 +407,9 @@
  *  @discussion Method to log details of various operations
  *
  */
--(void) logButtonAction:(NSString *)action
+-(void) logButtonAction:(gatt_trace_opcode)action
 {
-    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:[[CyCBManager sharedManager] myService].UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:[[CyCBManager sharedManager] myCharacteristic].UUID] descriptor:nil operation:action];
+    [Utilities logTraceWithService:[[CyCBManager sharedManager] myService].UUID characteristic:[[CyCBManager sharedManager] myCharacteristic].UUID descriptor:nil operation:action data:nil error:nil];
 }
 
 /*!
@@ -418,17 +418,9 @@
  *  @discussion Method to log characteristic value
  *
  */
--(void) logOperation:(NSString *)operation andData:(NSData *)data
+-(void) logOperation:(gatt_trace_opcode)operation andData:(NSData *)data
 {
-    if (data != nil)
-    {
-         [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:[[CyCBManager sharedManager] myService].UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:[[CyCBManager sharedManager] myCharacteristic].UUID] descriptor:[Utilities getDiscriptorNameForUUID:self.descriptor.UUID] operation:[NSString stringWithFormat:@"%@%@ %@",operation,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:data]]];
-    }
-    else
-    {
-        [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:[[CyCBManager sharedManager] myService].UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:[[CyCBManager sharedManager] myCharacteristic].UUID] descriptor:[Utilities getDiscriptorNameForUUID:self.descriptor.UUID] operation:operation];
-    }
-   
+    [Utilities logTraceWithService:[[CyCBManager sharedManager] myService].UUID characteristic:[[CyCBManager sharedManager] myCharacteristic].UUID descriptor:self.descriptor.UUID operation:operation data:data error:nil];
 }
 
 @end
@@ -232,7 +232,7 @@
 {
     [sender setSelected:YES];
     [[[CyCBManager sharedManager] myPeripheral] readValueForCharacteristic:[[CyCBManager sharedManager] myCharacteristic]];
-    [self logButtonAction:READ_REQUEST]; // Log
+    [self logButtonAction:GATT_TRACE_READ_REQUEST]; // Log
     double delayInSeconds = 0.2;
     dispatch_time_t popTime = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delayInSeconds * NSEC_PER_SEC));
     dispatch_after(popTime, dispatch_get_main_queue(), ^(void){
@@ -318,13 +318,13 @@
     {
         sender.selected = YES;
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:YES forCharacteristic:[[CyCBManager sharedManager] myCharacteristic]];
-        [self logButtonAction:START_NOTIFY];
+        [self logButtonAction:GATT_TRACE_START_NOTIFY];
     }
     else
     {
         sender.selected = NO;
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:NO forCharacteristic:[[CyCBManager sharedManager] myCharacteristic]];
-        [self logButtonAction:STOP_NOTIFY];
+        [self logButtonAction:GATT_TRACE_STOP_NOTIFY];
     }
 }
 
@@ -340,13 +340,13 @@
     {
         sender.selected = YES;
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:YES forCharacteristic:[[CyCBManager sharedManager] myCharacteristic]];
-        [self logButtonAction:START_INDICATE];
+        [self logButtonAction:GATT_TRACE_START_INDICATE];
     }
     else
     {
         sender.selected = NO;
         [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:NO forCharacteristic:[[CyCBManager sharedManager] myCharacteristic]];
-        [self logButtonAction:STOP_INDICATE];
+        [self logButtonAction:GATT_TRACE_STOP_INDICATE];
     }
 }
 
@@ -454,21 +454,21 @@
             {
                 if (_indicateButton.selected)
                 {
-                    [self logOperation:INDICATE_RESPONSE forCharacteristic:characteristic withData:characteristic.value];
+                    [self logOperation:GATT_TRACE_INDICATE_RESPONSE forCharacteristic:characteristic withData:characteristic.value];
                 }
                 else if (_notifyButton.selected)
                 {
-                    [self logOperation:NOTIFY_RESPONSE forCharacteristic:characteristic withData:characteristic.value];
+                    [self logOperation:GATT_TRACE_NOTIFY_RESPONSE forCharacteristic:characteristic withData:characteristic.value];
                 }
             }
             else
             {
-                [self logOperation:READ_RESPONSE forCharacteristic:characteristic withData:characteristic.value];
+                [self logOperation:GATT_TRACE_READ_RESPONSE forCharacteristic:characteristic withData:characteristic.value];
             }
         }
         else {
             if (characteristic.isNotifying) {
-                [self logOperation:NOTIFY_RESPONSE forCharacteristic:characteristic withData:characteristic.value];
+                [self logOperation:GATT_TRACE_NOTIFY_RESPONSE forCharacteristic:characteristic withData:characteristic.value];
             }
         }
     }
@@ -480,12 +480,12 @@
     {
         if (error == nil)
         {
-            [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:[[CyCBManager sharedManager] myService].UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:[[CyCBManager sharedManager] myCharacteristic].UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@- %@",WRITE_REQUEST_STATUS,WRITE_SUCCESS]];
+            [Utilities logTraceWithService:[[CyCBManager sharedManager] myService].UUID characteristic:[[CyCBManager sharedManager] myCharacteristic].UUID descriptor:nil operation:GATT_TRACE_WRITE_RESPONSE data:nil error:nil];
             characteristicWriteCompletionHandler (YES,error);
         }
         else
         {
-            [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:[[CyCBManager sharedManager] myService].UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:[[CyCBManager sharedManager] myCharacteristic].UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@- %@%@",WRITE_REQUEST_STATUS,WRITE_ERROR,[error.userInfo objectForKey:NSLocalizedDescriptionKey]]];
+            [Utilities logTraceWithService:[[CyCBManager sharedManager] myService].UUID characteristic:[[CyCBManager sharedManager] myCharacteristic].UUID descriptor:nil operation:GATT_TRACE_WRITE_RESPONSE data:nil error:error];
             
             characteristicWriteCompletionHandler(NO,error);
         }
@@ -516,7 +516,7 @@
                 NSString *ASCIIString = [Utilities ASCIIStringFromData:writeData];
             
                 // Write data to the device
-                [self logOperation:WRITE_REQUEST forCharacteristic:[[CyCBManager sharedManager] myCharacteristic] withData:writeData];
+                [self logOperation:GATT_TRACE_WRITE_REQUEST forCharacteristic:[[CyCBManager sharedManager] myCharacteristic] withData:writeData];
                 [self writeCharacteristic:[[CyCBManager sharedManager] myCharacteristic] data:writeData completionHandler:^(BOOL success, NSError *error) {
                     
                     if (success) {
@@ -537,7 +537,7 @@
             
             if (writeData.length) {
                 // Write data to the device
-                [self logOperation:WRITE_REQUEST forCharacteristic:[[CyCBManager sharedManager] myCharacteristic] withData:writeData];
+                [self logOperation:GATT_TRACE_WRITE_REQUEST forCharacteristic:[[CyCBManager sharedManager] myCharacteristic] withData:writeData];
                 [self writeCharacteristic:[[CyCBManager sharedManager] myCharacteristic] data:writeData completionHandler:^(BOOL success, NSError *error) {
                     
                     if (success) {
@@ -605,9 +605,9 @@
  *  @discussion Method to log details of various operations
  *
  */
--(void) logButtonAction:(NSString *)action
+-(void) logButtonAction:(gatt_trace_opcode)action
 {
-    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:[[CyCBManager sharedManager] myService].UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:[[CyCBManager sharedManager] myCharacteristic].UUID] descriptor:nil operation:action];
+    [Utilities logTraceWithService:[[CyCBManager sharedManager] myService].UUID characteristic:[[CyCBManager sharedManager] myCharacteristic].UUID descriptor:nil operation:action data:nil error:nil];
 }
 
 /*!
@@ -616,9 +616,9 @@
  *  @discussion Method to log characteristic value
  *
  */
--(void) logOperation:(NSString *)operation forCharacteristic:(CBCharacteristic *)characteristic withData:(NSData *)data
+-(void) logOperation:(gatt_trace_opcode)operation forCharacteristic:(CBCharacteristic *)characteristic withData:(NSData *)data
 {
-    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:[NSString stringWithFormat:@"%@%@ %@",operation,DATA_SEPERATOR,[Utilities convertDataToLoggerFormat:data]]];
+    [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:operation data:data error:nil];
 }
 
 
@@ -175,14 +175,14 @@
                     message = NOTIFY_DISABLED;
                     
                     notificationsDisabled = YES;
-                    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:STOP_NOTIFY];
+                    [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_STOP_NOTIFY data:nil error:nil];
                 }
                 else
                 {
                     message = INDICATE_DISABLED;
                     indicationsDisabled = YES;
                     
-                    [Utilities logDataWithService:[ResourceHandler getServiceNameForUUID:characteristic.service.UUID] characteristic:[ResourceHandler getCharacteristicNameForUUID:characteristic.UUID] descriptor:nil operation:STOP_INDICATE];
+                    [Utilities logTraceWithService:characteristic.service.UUID characteristic:characteristic.UUID descriptor:nil operation:GATT_TRACE_STOP_INDICATE data:nil error:nil];
                 }
                 
                 [[[CyCBManager sharedManager] myPeripheral] setNotifyValue:NO forCharacteristic:characteristic];
@@ -34,6 +34,7 @@
 #import "ScannedPeripheralTableViewCell.h"
 #import "CyCBManager.h"
 #import "CBPeripheralExt.h"
+#import "ScanSearchIndex.h"
 #import "ProgressHandler.h"
 #import "Utilities.h"
 #import "UIView+Toast.h"
@@ -53,6 +54,7 @@
     UIRefreshControl *refreshPeripheralListControl;
     BOOL isBluetoothON, isSearchActive;
     NSArray *searchResults;
+    ScanSearchIndex *searchIndex;
 }
 
 @property (weak, nonatomic) IBOutlet UITableView *scannedPeripheralsTableView;
@@ -66,6 +68,7 @@
     [super viewDidLoad];
     // Do any additional setup after loading the view, typically from a nib.
     [self addRefreshControl];
+    searchIndex = [[ScanSearchIndex alloc] initWithRegistry:[[CyCBManager sharedManager] scanRegistry]];
     if ([[[NSUserDefaults standardUserDefaults] valueForKey:LOCALIZEDSTRING(@"OTAUpgradeStatus")] boolValue]) {
         [[NSUserDefaults standardUserDefaults] setBool:NO forKey:LOCALIZEDSTRING(@"OTAUpgradeStatus")];
 
@@ -119,13 +122,12 @@
     NSString *searchString = text.length == 0 ? [searchBar.text substringToIndex:searchBar.text.length-1] : [NSString stringWithFormat:@"%@%@",searchBar.text, text];
     if (searchString.length == 0) {
         isSearchActive = NO;
+        searchIndex.filter = nil;
         [_scannedPeripheralsTableView reloadData];
     }else{
         isSearchActive = YES;
-        [self searchBLEPeripheralsNamesForSubString:searchString onFinish:^(NSArray *filteredPeripheralList) {
-            searchResults = [[NSArray alloc] initWithArray:filteredPeripheralList];
-            [_scannedPeripheralsTableView reloadData];
-        }];
+        [self searchBLEPeripheralsNamesForSubString:searchString];
+        [_scannedPeripheralsTableView reloadData];
     }
     return YES;
 }
@@ -137,27 +139,18 @@
 
 #pragma mark - Search Filter Method
 
-- (void) searchBLEPeripheralsNamesForSubString:(NSString *)searchString onFinish:(void(^)(NSArray *filteredPeripheralList))finish
+/*!
+ *  @method searchBLEPeripheralsNamesForSubString:
+ *
+ *  @discussion Method to filter the device list by name. Typing more of a name only narrows the previous results.
+ *
+ */
+- (void) searchBLEPeripheralsNamesForSubString:(NSString *)searchString
 {
-    if (searchString) {
-        searchString = [searchString stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
-    }
-    NSMutableArray *filteredPeripheralList = [NSMutableArray new];
-    for (CBPeripheralExt *peripheral in [[CyCBManager sharedManager] foundPeripherals])
-    {
-        if (peripheral.mPeripheral.name.length > 0){
-                if ([[peripheral.mPeripheral.name lowercaseString] rangeOfString:[searchString lowercaseString]].location != NSNotFound) {
-                    [filteredPeripheralList addObject:peripheral];
-            }
-        }
-        else
-        {
-            if ([[LOCALIZEDSTRING(@"unknownPeripheral") lowercaseString] rangeOfString:[searchString lowercaseString]].location != NSNotFound) {
-                [filteredPeripheralList addObject:peripheral];
-            }
-        }
-    }
-    finish((NSArray *)filteredPeripheralList);
+    ScanFilter *filter = [[ScanFilter alloc] init];
+    filter.nameText = searchString;
+    searchIndex.filter = filter;
+    searchResults = [searchIndex matchingDevices];
 }
 
 #pragma mark - RefreshControl
@@ -254,7 +247,8 @@
 {
     if (isBluetoothON) {
         [tableView deselectRowAtIndexPath:indexPath animated:YES];
-        [self connectPeripheral:indexPath.row];
+        NSArray *peripherals = isSearchActive ? searchResults : [[CyCBManager sharedManager] foundPeripherals];
+        [self connectPeripheral:[peripherals objectAtIndex:indexPath.row]];
     }
 }
 #pragma mark -Table Update
@@ -272,6 +266,7 @@
     {
         self.searchBar.text = @""; // Reset filter
         isSearchActive = NO;
+        searchIndex.filter = nil;
         [refreshControl endRefreshing];
         [[CyCBManager sharedManager] refreshPeripherals];
     }
@@ -298,6 +293,68 @@
     [self reloadPeripheralTable];
 }
 
+/*!
+ *  @method discoveryDidUpdateWithDiff:
+ *
+ *  @discussion Method to apply the changes of the device list. Rows are inserted and removed in place and only the
+ *  visible cells of updated devices are redrawn.
+ *
+ */
+
+-(void)discoveryDidUpdateWithDiff:(ScanRegistryDiff *)diff
+{
+    // New and changed devices join the search results without searching again
+    [searchIndex applyDiff:diff];
+    if (isSearchActive)
+    {
+        searchResults = [searchIndex matchingDevices];
+        [_scannedPeripheralsTableView reloadData];
+        return;
+    }
+    
+    NSArray *peripherals = [[CyCBManager sharedManager] foundPeripherals];
+    NSInteger rowCount = [_scannedPeripheralsTableView numberOfRowsInSection:0];
+    if (!isBluetoothON || rowCount + (NSInteger)diff.insertedIndexes.count - (NSInteger)diff.removedIndexes.count != (NSInteger)peripherals.count)
+    {
+        // The table is not showing the list the diff applies to
+        [_scannedPeripheralsTableView reloadData];
+        return;
+    }
+    
+    if (diff.removedIndexes.count > 0 || diff.insertedIndexes.count > 0)
+    {
+        [_scannedPeripheralsTableView beginUpdates];
+        [_scannedPeripheralsTableView deleteRowsAtIndexPaths:[self indexPathsForIndexes:diff.removedIndexes] withRowAnimation:UITableViewRowAnimationFade];
+        [_scannedPeripheralsTableView insertRowsAtIndexPaths:[self indexPathsForIndexes:diff.insertedIndexes] withRowAnimation:UITableViewRowAnimationFade];
+        [_scannedPeripheralsTableView endUpdates];
+    }
+    
+    for (NSIndexPath *indexPath in [_scannedPeripheralsTableView indexPathsForVisibleRows])
+    {
+        if ([diff.updatedIndexes containsIndex:indexPath.row])
+        {
+            ScannedPeripheralTableViewCell *cell = [_scannedPeripheralsTableView cellForRowAtIndexPath:indexPath];
+            [cell setDiscoveredPeripheralDataFromPeripheral:[peripherals objectAtIndex:indexPath.row]];
+        }
+    }
+}
+
+/*!
+ *  @method indexPathsForIndexes:
+ *
+ *  @discussion Method to convert row indexes to index paths of the device section
+ *
+ */
+
+-(NSArray *)indexPathsForIndexes:(NSIndexSet *)indexes
+{
+    NSMutableArray *indexPaths = [NSMutableArray arrayWithCapacity:indexes.count];
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        [indexPaths addObject:[NSIndexPath indexPathForRow:index inSection:0]];
+    }];
+    return indexPaths;
+}
+
 #pragma mark - BlueTooth Turned Off Delegate
 
 /*!
@@ -323,11 +380,10 @@
  *
  */
 
--(void)connectPeripheral:(NSInteger)index
+-(void)connectPeripheral:(CBPeripheralExt *)selectedBLE
 {
     if ([[CyCBManager sharedManager] foundPeripherals].count != 0)
     {
-        CBPeripheralExt *selectedBLE = [[[CyCBManager sharedManager] foundPeripherals] objectAtIndex:index];
         [[ProgressHandler sharedInstance] showWithTitle:LOCALIZEDSTRING(@"connecting") detail:selectedBLE.mPeripheral.name];
         
         [[CyCBManager sharedManager] connectPeripheral:selectedBLE.mPeripheral completionHandler:^(BOOL success, NSError *error)
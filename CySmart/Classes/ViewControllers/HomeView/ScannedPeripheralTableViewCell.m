@@ -59,36 +59,6 @@
     // Configure the view for the selected state
 }
 
-/*!
- *  @method nameForPeripheral:
- *
- *  @discussion Method to get the peripheral name
- *
- */
--(NSString *)nameForPeripheral:(CBPeripheralExt *)ble
-{
-    NSString *bleName ;
-    
-    if ([ble.mAdvertisementData valueForKey:CBAdvertisementDataLocalNameKey] != nil)
-    {
-        bleName = [ble.mAdvertisementData valueForKey:CBAdvertisementDataLocalNameKey];
-    }
-    
-    // If the peripheral name is not found in advertisement data, then check whether it is there in peripheral object. If it's not found then assign it as unknown peripheral
-    
-    if(bleName.length < 1 )
-    {
-        if (ble.mPeripheral.name.length > 0) {
-            bleName = ble.mPeripheral.name;
-        }
-        else
-            bleName = LOCALIZEDSTRING(@"unknownPeripheral");
-    }
-    
-    return bleName;
-}
-
-
 /*!
  *  @method UUIDStringfromPeripheral:
  *
@@ -125,9 +95,6 @@
     return bleService;
 }
 
-#define RSSI_UNDEFINED_VALUE 127
-
-
 /*!
  *  @method RSSIValue:
  *
@@ -136,20 +103,13 @@
  */
 -(NSString *)RSSIValue:(CBPeripheralExt *)ble
 {
-    NSString *deviceRSSI=[ble.mRSSI stringValue];
+    // The moving average keeps the value steady while advertisements keep arriving
+    long deviceRSSI = lround(ble.smoothedRSSI);
     
-    if(deviceRSSI.length < 1 )
-    {
-        if([ble.mPeripheral respondsToSelector:@selector(RSSI)])
-            deviceRSSI = ble.mPeripheral.RSSI.stringValue;
-    }
-    
-    if([deviceRSSI intValue]>=RSSI_UNDEFINED_VALUE)
-        deviceRSSI = LOCALIZEDSTRING(@"undefined");
-    else
-        deviceRSSI=[NSString stringWithFormat:@"%@ dBm",deviceRSSI];
+    if(deviceRSSI>=RSSI_UNDEFINED_VALUE)
+        return LOCALIZEDSTRING(@"undefined");
     
-    return deviceRSSI;
+    return [NSString stringWithFormat:@"%ld dBm",deviceRSSI];
 }
 
 
@@ -161,7 +121,7 @@
  */
 -(void)setDiscoveredPeripheralDataFromPeripheral:(CBPeripheralExt*) discoveredPeripheral
 {
-    peripheralName.text         = [self nameForPeripheral:discoveredPeripheral];
+    peripheralName.text         = [discoveredPeripheral displayName];
     peripheralAdressLabel.text  = [self ServiceCountfromPeripheral:discoveredPeripheral];
     RSSIValueLabel.text         = [self RSSIValue:discoveredPeripheral];
 }
@@ -36,12 +36,12 @@
 @interface LoggerViewController : BaseViewController
 
 /*!
- *  @property loggerTextView
+ *  @property loggerTableView
  *
- *  @discussion Datafield to display the logged data
+ *  @discussion Table that displays the logged data, one record per row
  *
  */
-@property (weak, nonatomic) IBOutlet UITextView *loggerTextView;
+@property (weak, nonatomic) IBOutlet UITableView *loggerTableView;
 
 /*!
  *  @property currentLoggerFileName
@@ -60,4 +60,13 @@
  */
 
 - (IBAction)onHistoryTouched:(id)sender;
+
+/*!
+ *  @method writeCurrentLogToURL:
+ *
+ *  @discussion Method to write the displayed log to a text file
+ *
+ */
+
+-(BOOL)writeCurrentLogToURL:(NSURL *)url;
 @end
@@ -34,23 +34,46 @@
 #import "LoggerHandler.h"
 #import "Constants.h"
 #import "UIView+Toast.h"
-#import "CoreDataHandler.h"
 #import "Utilities.h"
+#include <stdatomic.h>
+
+// Records formatted and cached together
+#define LOG_PAGE_SIZE           256
+
+// Pages kept formatted in memory
+#define LOG_PAGE_CACHE_LIMIT    16
+
+// Interval at which new records of today are picked up
+#define LOG_TAIL_INTERVAL       1.0
+
+#define LOG_CELL_IDENTIFIER     @"logCell"
 
 
 /*!
  *  @class LoggerViewController
  *
- *  @discussion Class to handle the operations related to logger
+ *  @discussion Class to handle the operations related to logger. Only the visible rows are read from the log: the
+ *  day is paged through a LogPageReader and formatted pages are cached.
  *
  */
-@interface LoggerViewController () <UIActionSheetDelegate>
+@interface LoggerViewController () <UIActionSheetDelegate, UITableViewDataSource, UITableViewDelegate, UISearchBarDelegate>
 {
     NSArray *dateHistory;
     UIActionSheet *historyListActionSheet;
     IBOutlet UIButton *historyButton;
     BOOL isActionSheetShown;
-    CoreDataHandler *logDataHandler;
+    
+    NSString *currentDate;
+    LogPageReader *pageReader;
+    NSCache *pageCache;
+    NSTimer *tailTimer;
+    
+    dispatch_queue_t filterQueue;
+    LogPageReader *filterReader;            // Used on filterQueue only
+    NSString *filterString;
+    NSMutableData *filteredIndexes;         // uint32_t record indexes of the rows while filtering
+    NSUInteger filteredCount;               // Records already filtered
+    atomic_uint filterGeneration;           // Bumped on the main thread, read by the filter passes on filterQueue
 }
 
 @property (weak, nonatomic) IBOutlet UILabel *fileNameLabel;
@@ -63,20 +86,19 @@
 -(void)viewDidLoad {
     [super viewDidLoad];
     
-    if (!logDataHandler) {
-        logDataHandler = [[CoreDataHandler alloc] init];
-    }
-    
     [[super navBarTitleLabel] setText:DATA_LOGGER];
-    [self initLoggerTextView:[[LoggerHandler logManager] getTodayLogData]];
+    pageCache = [[NSCache alloc] init];
+    pageCache.countLimit = LOG_PAGE_CACHE_LIMIT;
+    filterQueue = dispatch_queue_create("com.cypress.cysmart.logger.filter", DISPATCH_QUEUE_SERIAL);
+    
+    self.loggerTableView.rowHeight = UITableViewAutomaticDimension;
+    self.loggerTableView.estimatedRowHeight = 44.0;
+    [self.loggerTableView registerClass:[UITableViewCell class] forCellReuseIdentifier:LOG_CELL_IDENTIFIER];
+    
+    [self showLogForDate:[Utilities getTodayDateString]];
     [[LoggerHandler logManager] deleteOldLogData];
     
     [self initHistoryList];
-    
-    if (self.loggerTextView.text.length > 0) {
-        NSRange initialRange = NSMakeRange(0, 1);
-        [self.loggerTextView scrollRangeToVisible:initialRange];
-    }
     [self showToastWithLatestLoggedTime];
 }
 
@@ -84,7 +106,9 @@
 -(void) viewWillAppear:(BOOL)animated
 {
     [super viewWillAppear:animated];
+    [self addSearchButtonToNavBar];
     [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(deviceOrientationDidChange:) name:UIDeviceOrientationDidChangeNotification object:nil];
+    tailTimer = [NSTimer scheduledTimerWithTimeInterval:LOG_TAIL_INTERVAL target:self selector:@selector(tailLog) userInfo:nil repeats:YES];
 }
 
 
@@ -95,8 +119,8 @@
  *
  */
 -(void)initHistoryList {
-    dateHistory = [[[logDataHandler getLogDates] reverseObjectEnumerator] allObjects];
-    if ([[LoggerHandler logManager] getTodayLogData].count > 0) {
+    dateHistory = [[[[LoggerHandler logManager] getLogDates] reverseObjectEnumerator] allObjects];
+    if ([[LoggerHandler logManager] getTodayLogEventCount] > 0) {
         _currentLogFileName = [NSString stringWithFormat:@"%@.txt", [dateHistory objectAtIndex:0]];
     } else {
         _currentLogFileName = [NSString stringWithFormat:@"%@.txt", [Utilities getTodayDateString]];
@@ -105,22 +129,337 @@
 }
 
 /*!
- *  @method initLoggerTextView:
+ *  @method showLogForDate:
  *
  *  @discussion Method to display the data logged in a day
  *
  */
--(void)initLoggerTextView:(NSArray *)logArray
+-(void)showLogForDate:(NSString *)date
+{
+    currentDate = date;
+    pageReader = [[LoggerHandler logManager] pageReaderForDate:date];
+    [pageCache removeAllObjects];
+    [self clearFilter];
+    [self.loggerTableView reloadData];
+    
+    if ([self numberOfRows] > 0) {
+        [self.loggerTableView scrollToRowAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0] atScrollPosition:UITableViewScrollPositionTop animated:NO];
+    }
+}
+
+/*!
+ *  @method displayTextForEvent:
+ *
+ *  @discussion Method that returns the text shown for a log record
+ *
+ */
+-(NSString *)displayTextForEvent:(NSString *)event
+{
+    return [[event stringByReplacingOccurrencesOfString:DATE_SEPARATOR withString:@" , "] stringByReplacingOccurrencesOfString:DATA_SEPERATOR withString:@","];
+}
+
+/*!
+ *  @method eventAtIndex:
+ *
+ *  @discussion Method that returns the display text of a record, formatting its whole page on a cache miss
+ *
+ */
+-(NSString *)eventAtIndex:(NSUInteger)index
+{
+    NSNumber *pageKey = @(index / LOG_PAGE_SIZE);
+    NSArray *page = [pageCache objectForKey:pageKey];
+    
+    if (page == nil || index % LOG_PAGE_SIZE >= page.count)
+    {
+        NSArray *events = [pageReader eventsInRange:NSMakeRange(pageKey.unsignedIntegerValue * LOG_PAGE_SIZE, LOG_PAGE_SIZE)];
+        NSMutableArray *lines = [NSMutableArray arrayWithCapacity:events.count];
+        for (NSString *event in events)
+        {
+            [lines addObject:[self displayTextForEvent:event]];
+        }
+        page = lines;
+        [pageCache setObject:page forKey:pageKey];
+    }
+    return index % LOG_PAGE_SIZE < page.count ? page[index % LOG_PAGE_SIZE] : @"";
+}
+
+/*!
+ *  @method numberOfRows
+ *
+ *  @discussion Method that returns the number of rows shown, the matching records while filtering
+ *
+ */
+-(NSUInteger)numberOfRows
+{
+    return filterString ? filteredIndexes.length / sizeof(uint32_t) : pageReader.count;
+}
+
+/*!
+ *  @method recordIndexForRow:
+ *
+ *  @discussion Method that maps a row to its record
+ *
+ */
+-(NSUInteger)recordIndexForRow:(NSUInteger)row
 {
-    self.loggerTextView.text =[[[[[[[NSString stringWithFormat:@"%@",logArray] stringByReplacingOccurrencesOfString:@"(" withString:@""]stringByReplacingOccurrencesOfString:@")" withString:@""]stringByReplacingOccurrencesOfString:@"\"" withString:@""]stringByReplacingOccurrencesOfString:@"," withString:@""]stringByReplacingOccurrencesOfString:DATE_SEPARATOR withString:@" , "] stringByReplacingOccurrencesOfString:DATA_SEPERATOR withString:@","];
+    return filterString ? ((const uint32_t *)filteredIndexes.bytes)[row] : row;
+}
+
+/*!
+ *  @method isShowingLastRow
+ *
+ *  @discussion Method that tells whether the table is scrolled to the end
+ *
+ */
+-(BOOL)isShowingLastRow
+{
+    NSUInteger rows = [self numberOfRows];
+    NSIndexPath *lastVisible = [[self.loggerTableView indexPathsForVisibleRows] lastObject];
+    return rows == 0 || lastVisible == nil || (NSUInteger)lastVisible.row + 1 >= rows;
+}
+
+/*!
+ *  @method tailLog
+ *
+ *  @discussion Method to pick up the records written since the last call. Only today's log grows.
+ *
+ */
+-(void)tailLog
+{
+    if (pageReader == nil || ![currentDate isEqualToString:[Utilities getTodayDateString]])
+    {
+        return;
+    }
+    
+    NSUInteger oldCount = pageReader.count;
+    if ([pageReader refresh] == 0)
+    {
+        return;
+    }
+    
+    // The last cached page may be partial
+    [pageCache removeObjectForKey:@(oldCount / LOG_PAGE_SIZE)];
+    
+    if (filterString)
+    {
+        [self filterFromIndex:filteredCount];
+        return;
+    }
+    
+    BOOL followTail = [self isShowingLastRow];
+    NSMutableArray *indexPaths = [NSMutableArray array];
+    for (NSUInteger row = oldCount; row < pageReader.count; row++)
+    {
+        [indexPaths addObject:[NSIndexPath indexPathForRow:row inSection:0]];
+    }
+    [self.loggerTableView insertRowsAtIndexPaths:indexPaths withRowAnimation:UITableViewRowAnimationNone];
     
+    if (followTail)
+    {
+        [self scrollTableViewToBottom:NO];
+    }
 }
 
 -(void)viewWillDisappear:(BOOL)animated
 {
     [super viewWillDisappear:animated];
+    [tailTimer invalidate];
+    tailTimer = nil;
     [[NSNotificationCenter defaultCenter] removeObserver:self name:UIDeviceOrientationDidChangeNotification object:nil];
 }
+
+-(void)viewDidDisappear:(BOOL)animated
+{
+    [super viewDidDisappear:animated];
+    [super removeSearchButtonFromNavBar];
+}
+
+/*!
+ *  @method writeCurrentLogToURL:
+ *
+ *  @discussion Method to write the displayed log to a text file a page at a time
+ *
+ */
+-(BOOL)writeCurrentLogToURL:(NSURL *)url
+{
+    LogPageReader *reader = [[LoggerHandler logManager] pageReaderForDate:currentDate];
+    if (![[NSData data] writeToURL:url atomically:YES])
+    {
+        return NO;
+    }
+    NSFileHandle *fileHandle = [NSFileHandle fileHandleForWritingToURL:url error:nil];
+    if (fileHandle == nil)
+    {
+        return NO;
+    }
+    
+    for (NSUInteger start = 0; start < reader.count; start += LOG_PAGE_SIZE)
+    {
+        @autoreleasepool {
+            NSMutableString *text = [NSMutableString string];
+            for (NSString *event in [reader eventsInRange:NSMakeRange(start, LOG_PAGE_SIZE)])
+            {
+                [text appendString:[self displayTextForEvent:event]];
+                [text appendString:@"\n"];
+            }
+            [fileHandle writeData:[text dataUsingEncoding:NSUTF8StringEncoding]];
+        }
+    }
+    [fileHandle closeFile];
+    return YES;
+}
+
+#pragma mark - Filtering
+
+/*!
+ *  @method addSearchButtonToNavBar
+ *
+ *  @discussion Closing the search bar also shows all records again
+ *
+ */
+-(void)addSearchButtonToNavBar
+{
+    [super addSearchButtonToNavBar];
+    if (filterString)
+    {
+        [self clearFilter];
+        [self.loggerTableView reloadData];
+    }
+}
+
+/*!
+ *  @method clearFilter
+ *
+ *  @discussion Method to stop filtering. Running filter passes see the generation change and stop.
+ *
+ */
+-(void)clearFilter
+{
+    atomic_fetch_add_explicit(&filterGeneration, 1, memory_order_relaxed);
+    filterString = nil;
+    filteredIndexes = nil;
+    filteredCount = 0;
+}
+
+/*!
+ *  @method filterLogWithString:
+ *
+ *  @discussion Method to show only the records that contain the string. The records are scanned on filterQueue and
+ *  the rows are filled in as the scan finishes.
+ *
+ */
+-(void)filterLogWithString:(NSString *)string
+{
+    [self clearFilter];
+    if (string.length > 0)
+    {
+        filterString = [string copy];
+        filteredIndexes = [NSMutableData data];
+        [self filterFromIndex:0];
+    }
+    [self.loggerTableView reloadData];
+}
+
+/*!
+ *  @method filterFromIndex:
+ *
+ *  @discussion Method to scan the records from index on for the filter string on filterQueue
+ *
+ */
+-(void)filterFromIndex:(NSUInteger)index
+{
+    unsigned int generation = atomic_load_explicit(&filterGeneration, memory_order_relaxed);
+    NSString *string = filterString;
+    NSString *date = currentDate;
+    NSUInteger end = pageReader.count;
+    __weak LoggerViewController *weakSelf = self;
+    
+    // Records up to end are now covered; a tail while this pass runs continues from there
+    filteredCount = end;
+    
+    dispatch_async(filterQueue, ^{
+        LoggerViewController *strongSelf = weakSelf;
+        if (strongSelf == nil)
+        {
+            return;
+        }
+        BOOL (^cancelled)(void) = ^BOOL{
+            return generation != atomic_load_explicit(&strongSelf->filterGeneration, memory_order_relaxed);
+        };
+        if (cancelled())
+        {
+            return;
+        }
+        
+        // The filter reads through its own reader, the page reader belongs to the main thread
+        if (strongSelf->filterReader == nil || index == 0)
+        {
+            strongSelf->filterReader = [[LoggerHandler logManager] pageReaderForDate:date];
+        }
+        else
+        {
+            [strongSelf->filterReader refresh];
+        }
+        NSIndexSet *matches = [strongSelf->filterReader indexesOfEventsContainingString:string fromIndex:index cancelled:cancelled];
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (matches == nil || cancelled())
+            {
+                return;
+            }
+            NSUInteger oldRows = [strongSelf numberOfRows];
+            [matches enumerateIndexesInRange:NSMakeRange(index, end - index) options:0 usingBlock:^(NSUInteger matchIndex, BOOL *stop) {
+                uint32_t recordIndex = (uint32_t)matchIndex;
+                [strongSelf->filteredIndexes appendBytes:&recordIndex length:sizeof(recordIndex)];
+            }];
+            
+            if (index == 0 || oldRows == 0)
+            {
+                [strongSelf.loggerTableView reloadData];
+            }
+            else if ([strongSelf numberOfRows] > oldRows)
+            {
+                NSMutableArray *indexPaths = [NSMutableArray array];
+                for (NSUInteger row = oldRows; row < [strongSelf numberOfRows]; row++)
+                {
+                    [indexPaths addObject:[NSIndexPath indexPathForRow:row inSection:0]];
+                }
+                [strongSelf.loggerTableView insertRowsAtIndexPaths:indexPaths withRowAnimation:UITableViewRowAnimationNone];
+            }
+        });
+    });
+}
+
+#pragma mark - UISearchBarDelegate
+
+- (void)searchBar:(UISearchBar *)searchBar textDidChange:(NSString *)searchText
+{
+    [self filterLogWithString:searchText];
+}
+
+- (void)searchBarSearchButtonClicked:(UISearchBar *)searchBar
+{
+    [searchBar resignFirstResponder];
+}
+
+#pragma mark - UITableViewDataSource
+
+- (NSInteger)tableView:(UITableView *)tableView numberOfRowsInSection:(NSInteger)section
+{
+    return [self numberOfRows];
+}
+
+- (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    UITableViewCell *cell = [tableView dequeueReusableCellWithIdentifier:LOG_CELL_IDENTIFIER forIndexPath:indexPath];
+    cell.selectionStyle = UITableViewCellSelectionStyleNone;
+    cell.textLabel.numberOfLines = 0;
+    cell.textLabel.font = [UIFont fontWithName:@"HelveticaNeue" size:14.0];
+    cell.textLabel.textColor = [UIColor colorWithRed:0.047 green:0.216 blue:0.482 alpha:1.0];
+    cell.textLabel.text = [self eventAtIndex:[self recordIndexForRow:indexPath.row]];
+    return cell;
+}
+
 #pragma mark - History Listing
 
 /*!
@@ -157,7 +496,7 @@
     
     if ([dateHistory count])
     {
-        if ([[LoggerHandler logManager] getTodayLogData].count == 0)
+        if ([[LoggerHandler logManager] getTodayLogEventCount] == 0)
         {
             [historyListActionSheet addButtonWithTitle:[NSString stringWithFormat:@"%@.txt",[Utilities getTodayDateString]]];
         }
@@ -189,24 +528,24 @@
     {
         if ([dateHistory count])
         {
-            if ([[LoggerHandler logManager] getTodayLogData].count == 0)
+            if ([[LoggerHandler logManager] getTodayLogEventCount] == 0)
             {
                 if (buttonIndex == 1)
                 {
                     _currentLogFileName = [NSString stringWithFormat:@"%@.txt",[Utilities getTodayDateString]];
                     _fileNameLabel.text = _currentLogFileName;
-                    [self initLoggerTextView:[[LoggerHandler logManager] getTodayLogData]];
+                    [self showLogForDate:[Utilities getTodayDateString]];
                 }
                 else
                 {
-                    [self initLoggerTextView:[logDataHandler getLogEventsForDate:[dateHistory objectAtIndex:(buttonIndex-2)]]];
+                    [self showLogForDate:[dateHistory objectAtIndex:(buttonIndex-2)]];
                     _currentLogFileName = [NSString stringWithFormat:@"%@.txt", [dateHistory objectAtIndex:(buttonIndex-2)]];
                     _fileNameLabel.text = _currentLogFileName;
                 }
             }
             else
             {
-                [self initLoggerTextView:[logDataHandler getLogEventsForDate:[dateHistory objectAtIndex:(buttonIndex-1)]]];
+                [self showLogForDate:[dateHistory objectAtIndex:(buttonIndex-1)]];
                 _currentLogFileName = [NSString stringWithFormat:@"%@.txt", [dateHistory objectAtIndex:(buttonIndex-1)]];
                 _fileNameLabel.text = _currentLogFileName;
             }
@@ -232,7 +571,8 @@
 
 -(void) showToastWithLatestLoggedTime
 {
-    NSArray *stringArray = [[[[LoggerHandler logManager] getTodayLogData] lastObject] componentsSeparatedByString:DATE_SEPARATOR];
+    NSString *lastEvent = pageReader.count > 0 ? [[pageReader eventsInRange:NSMakeRange(pageReader.count - 1, 1)] lastObject] : nil;
+    NSArray *stringArray = [lastEvent componentsSeparatedByString:DATE_SEPARATOR];
     if([stringArray count])
     {
         NSString *lastItem = [[stringArray firstObject] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
@@ -254,20 +594,20 @@
  */
 
 - (IBAction)scrollToDownButtonClicked:(UIButton *)sender {
-    [self scrollTextViewToBottom:self.loggerTextView];
+    [self scrollTableViewToBottom:YES];
 }
 
 /*!
- *  @method scrollTextViewToBottom :
+ *  @method scrollTableViewToBottom:
  *
- *  @discussion Method to scroll the text view to the bottom
+ *  @discussion Method to scroll the table view to the last row
  *
  */
 
--(void)scrollTextViewToBottom:(UITextView *)textView {
-    if(textView.text.length > 0 ) {
-        NSRange bottom = NSMakeRange(textView.text.length -1, 1);
-        [textView scrollRangeToVisible:bottom];
+-(void)scrollTableViewToBottom:(BOOL)animated {
+    NSUInteger rows = [self numberOfRows];
+    if (rows > 0) {
+        [self.loggerTableView scrollToRowAtIndexPath:[NSIndexPath indexPathForRow:rows - 1 inSection:0] atScrollPosition:UITableViewScrollPositionBottom animated:animated];
     }
 }
 
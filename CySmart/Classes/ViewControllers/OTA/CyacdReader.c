@@ -0,0 +1,507 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#include "CyacdReader.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define CYACD_HEADER_LENGTH         12  // Hex characters in CYACD header
+#define CYACD2_HEADER_LENGTH        24  // Hex characters in CYACD2 header
+#define CYACD_ROW_MIN_LENGTH        20  // Data rows of CYACD must be longer than this
+#define CYACD_ROW_HEADER_SIZE       5   // Array ID (1 byte) + row number (2 bytes) + data length (2 bytes)
+#define CYACD2_ADDRESS_SIZE         4
+#define CYACD2_FILE_VERSION         1
+
+#define CYACD2_APPINFO_PREFIX       "@APPINFO:0x"
+#define CYACD2_APPINFO_SEPARATOR    ",0x"
+#define CYACD2_EIV_PREFIX           "@EIV:"
+#define CYACD2_DATA_PREFIX          ":"
+
+enum
+{
+    LINE_OK,
+    LINE_EOF,
+    LINE_IO_ERROR,
+    LINE_TOO_LONG
+};
+
+struct cyacd_reader
+{
+    cyacd_format format;
+    cyacd_header header;
+    int fd;                                         // -1 when reading from memory
+    size_t source_size;
+    const char *buffer;                             // Points to read_buffer or to the memory source
+    size_t buffer_pos;
+    size_t buffer_len;
+    size_t line_len;
+    char read_buffer[CYACD_READ_BUFFER_SIZE];
+    char line[CYACD_MAX_LINE_LENGTH];
+    uint8_t row_data[CYACD_MAX_LINE_LENGTH / 2];
+};
+
+/*
+ * Hex digit value plus one, zero for characters that are not hex digits
+ */
+static const uint8_t cyacd_hex_table[256] =
+{
+    ['0'] = 1,  ['1'] = 2,  ['2'] = 3,  ['3'] = 4,  ['4'] = 5,
+    ['5'] = 6,  ['6'] = 7,  ['7'] = 8,  ['8'] = 9,  ['9'] = 10,
+    ['a'] = 11, ['b'] = 12, ['c'] = 13, ['d'] = 14, ['e'] = 15, ['f'] = 16,
+    ['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16,
+};
+
+/*
+ * Characters kept in a line. Data rows start with ':', EIV row starts with '@EIV:', APPINFO row starts with '@APPINFO:'
+ */
+static int cyacd_is_line_char(unsigned char c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '@' || c == ':' || c == ',';
+}
+
+static int cyacd_decode_hex(const char *hex, size_t length, uint8_t *out)
+{
+    if (length % 2)
+    {
+        return -1;
+    }
+    for (size_t i = 0; i < length; i += 2)
+    {
+        uint8_t hi = cyacd_hex_table[(uint8_t)hex[i]];
+        uint8_t lo = cyacd_hex_table[(uint8_t)hex[i + 1]];
+        if (!hi || !lo)
+        {
+            return -1;
+        }
+        *out++ = (uint8_t)(((hi - 1) << 4) | (lo - 1));
+    }
+    return 0;
+}
+
+static int cyacd_parse_hex_number(const char *hex, size_t length, uint32_t *value)
+{
+    if (length == 0 || length > 8)
+    {
+        return -1;
+    }
+    uint32_t result = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        uint8_t nibble = cyacd_hex_table[(uint8_t)hex[i]];
+        if (!nibble)
+        {
+            return -1;
+        }
+        result = (result << 4) | (uint32_t)(nibble - 1);
+    }
+    *value = result;
+    return 0;
+}
+
+static uint32_t cyacd_read_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint32_t cyacd_read_be32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+/*
+ * Refills the read buffer. Returns 1 if data was read, 0 at the end of the source and -1 on error.
+ */
+static int cyacd_fill(cyacd_reader *reader)
+{
+    if (reader->fd < 0)
+    {
+        // The memory source is handed out as a single buffer on open
+        return 0;
+    }
+    
+    ssize_t count;
+    do
+    {
+        count = read(reader->fd, reader->read_buffer, sizeof(reader->read_buffer));
+    }
+    while (count < 0 && errno == EINTR);
+    
+    if (count <= 0)
+    {
+        return count < 0 ? -1 : 0;
+    }
+    reader->buffer_pos = 0;
+    reader->buffer_len = (size_t)count;
+    return 1;
+}
+
+/*
+ * Assembles the next non-empty line with junk characters stripped off
+ */
+static int cyacd_read_line(cyacd_reader *reader)
+{
+    reader->line_len = 0;
+    for (;;)
+    {
+        if (reader->buffer_pos == reader->buffer_len)
+        {
+            int result = cyacd_fill(reader);
+            if (result < 0)
+            {
+                return LINE_IO_ERROR;
+            }
+            if (result == 0)
+            {
+                return reader->line_len > 0 ? LINE_OK : LINE_EOF;
+            }
+        }
+        
+        const char *p = reader->buffer + reader->buffer_pos;
+        const char *end = reader->buffer + reader->buffer_len;
+        while (p < end)
+        {
+            unsigned char c = (unsigned char)*p++;
+            if (c == '\n' || c == '\r')
+            {
+                if (reader->line_len > 0)
+                {
+                    reader->buffer_pos = (size_t)(p - reader->buffer);
+                    return LINE_OK;
+                }
+            }
+            else if (cyacd_is_line_char(c))
+            {
+                if (reader->line_len == CYACD_MAX_LINE_LENGTH)
+                {
+                    return LINE_TOO_LONG;
+                }
+                reader->line[reader->line_len++] = (char)c;
+            }
+        }
+        reader->buffer_pos = reader->buffer_len;
+    }
+}
+
+static cyacd_status cyacd_status_for_line(int line)
+{
+    switch (line)
+    {
+        case LINE_EOF:
+            return CYACD_END;
+        case LINE_TOO_LONG:
+            return CYACD_ERR_LINE_TOO_LONG;
+        case LINE_IO_ERROR:
+            return CYACD_ERR_IO;
+        default:
+            return CYACD_OK;
+    }
+}
+
+static cyacd_status cyacd_parse_header(cyacd_reader *reader)
+{
+    int line = cyacd_read_line(reader);
+    if (line == LINE_EOF)
+    {
+        return CYACD_ERR_EMPTY;
+    }
+    if (line != LINE_OK)
+    {
+        return cyacd_status_for_line(line);
+    }
+    
+    uint8_t bytes[CYACD2_HEADER_LENGTH / 2];
+    cyacd_header *header = &reader->header;
+    memset(header, 0, sizeof(*header));
+    
+    if (CYACD_FORMAT_CYACD == reader->format)
+    {
+        if (reader->line_len < CYACD_HEADER_LENGTH || cyacd_decode_hex(reader->line, CYACD_HEADER_LENGTH, bytes))
+        {
+            return CYACD_ERR_HEADER;
+        }
+        header->file_version = CYACD_FORMAT_CYACD;
+        header->silicon_id = cyacd_read_be32(bytes);
+        header->silicon_rev = bytes[4];
+        header->checksum_type = bytes[5];
+    }
+    else
+    {
+        if (reader->line_len < CYACD2_HEADER_LENGTH || cyacd_decode_hex(reader->line, CYACD2_HEADER_LENGTH, bytes))
+        {
+            return CYACD_ERR_HEADER;
+        }
+        if (CYACD2_FILE_VERSION != bytes[0])
+        {
+            return CYACD_ERR_VERSION;
+        }
+        header->file_version = bytes[0];
+        header->silicon_id = cyacd_read_le32(&bytes[1]);
+        header->silicon_rev = bytes[5];
+        header->checksum_type = bytes[6];
+        header->app_id = bytes[7];
+        header->product_id = cyacd_read_le32(&bytes[8]);
+    }
+    return CYACD_OK;
+}
+
+static cyacd_status cyacd_parse_row(cyacd_reader *reader, cyacd_row *row)
+{
+    // Strip '@' and ':' off
+    size_t length = 0;
+    for (size_t i = 0; i < reader->line_len; i++)
+    {
+        char c = reader->line[i];
+        if (c != '@' && c != ':')
+        {
+            reader->line[length++] = c;
+        }
+    }
+    if (length <= CYACD_ROW_MIN_LENGTH)
+    {
+        return CYACD_ERR_FORMAT;
+    }
+    if (cyacd_decode_hex(reader->line, length, reader->row_data))
+    {
+        return CYACD_ERR_ROW;
+    }
+    
+    const uint8_t *bytes = reader->row_data;
+    size_t count = length / 2;
+    uint16_t dataLength = (uint16_t)((bytes[3] << 8) | bytes[4]);
+    if (dataLength != count - CYACD_ROW_HEADER_SIZE - 1)
+    {
+        return CYACD_ERR_ROW;
+    }
+    
+    row->type = CYACD_ROW_DATA;
+    row->array_id = bytes[0];
+    row->row_number = (uint16_t)((bytes[1] << 8) | bytes[2]);
+    row->data_length = dataLength;
+    row->data = bytes + CYACD_ROW_HEADER_SIZE;
+    row->checksum = bytes[count - 1];
+    return CYACD_OK;
+}
+
+static cyacd_status cyacd_parse_row_v1(cyacd_reader *reader, cyacd_row *row)
+{
+    const char *line = reader->line;
+    size_t length = reader->line_len;
+    
+    if (length >= sizeof(CYACD2_APPINFO_PREFIX) - 1 && 0 == memcmp(line, CYACD2_APPINFO_PREFIX, sizeof(CYACD2_APPINFO_PREFIX) - 1))
+    {
+        const char *start = line + sizeof(CYACD2_APPINFO_PREFIX) - 1;
+        const char *end = line + length;
+        const char *separator = NULL;
+        for (const char *p = start; p + sizeof(CYACD2_APPINFO_SEPARATOR) - 1 <= end; p++)
+        {
+            if (0 == memcmp(p, CYACD2_APPINFO_SEPARATOR, sizeof(CYACD2_APPINFO_SEPARATOR) - 1))
+            {
+                separator = p;
+                break;
+            }
+        }
+        if (separator == NULL)
+        {
+            return CYACD_ERR_ROW;
+        }
+        const char *sizeStart = separator + sizeof(CYACD2_APPINFO_SEPARATOR) - 1;
+        if (cyacd_parse_hex_number(start, (size_t)(separator - start), &row->app_start) ||
+            cyacd_parse_hex_number(sizeStart, (size_t)(end - sizeStart), &row->app_size))
+        {
+            return CYACD_ERR_ROW;
+        }
+        row->type = CYACD_ROW_APPINFO;
+        row->data_length = 0;
+        row->data = NULL;
+        return CYACD_OK;
+    }
+    
+    if (length >= sizeof(CYACD2_EIV_PREFIX) - 1 && 0 == memcmp(line, CYACD2_EIV_PREFIX, sizeof(CYACD2_EIV_PREFIX) - 1))
+    {
+        const char *hex = line + sizeof(CYACD2_EIV_PREFIX) - 1;
+        size_t hexLength = length - (sizeof(CYACD2_EIV_PREFIX) - 1);
+        if (cyacd_decode_hex(hex, hexLength, reader->row_data))
+        {
+            return CYACD_ERR_ROW;
+        }
+        row->type = CYACD_ROW_EIV;
+        row->data_length = (uint16_t)(hexLength / 2);
+        row->data = reader->row_data;
+        return CYACD_OK;
+    }
+    
+    if (length >= sizeof(CYACD2_DATA_PREFIX) - 1 && 0 == memcmp(line, CYACD2_DATA_PREFIX, sizeof(CYACD2_DATA_PREFIX) - 1))
+    {
+        const char *hex = line + sizeof(CYACD2_DATA_PREFIX) - 1;
+        size_t hexLength = length - (sizeof(CYACD2_DATA_PREFIX) - 1);
+        if (hexLength < CYACD2_ADDRESS_SIZE * 2 || cyacd_decode_hex(hex, hexLength, reader->row_data))
+        {
+            return CYACD_ERR_ROW;
+        }
+        row->type = CYACD_ROW_DATA;
+        row->address = cyacd_read_le32(reader->row_data);
+        row->data_length = (uint16_t)(hexLength / 2 - CYACD2_ADDRESS_SIZE);
+        row->data = reader->row_data + CYACD2_ADDRESS_SIZE;
+        return CYACD_OK;
+    }
+    
+    return CYACD_ERR_ROW;
+}
+
+static cyacd_reader *cyacd_reader_create(int fd, const char *buffer, size_t length, cyacd_format format, cyacd_status *status)
+{
+    cyacd_reader *reader = (cyacd_reader *)malloc(sizeof(cyacd_reader));
+    if (reader == NULL)
+    {
+        if (status)
+        {
+            *status = CYACD_ERR_IO;
+        }
+        return NULL;
+    }
+    
+    reader->format = format;
+    reader->fd = fd;
+    reader->source_size = length;
+    reader->buffer = (fd < 0) ? buffer : reader->read_buffer;
+    reader->buffer_pos = 0;
+    reader->buffer_len = (fd < 0) ? length : 0;
+    reader->line_len = 0;
+    
+    cyacd_status result = cyacd_parse_header(reader);
+    if (status)
+    {
+        *status = result;
+    }
+    if (result != CYACD_OK)
+    {
+        cyacd_reader_close(reader);
+        return NULL;
+    }
+    return reader;
+}
+
+cyacd_reader *cyacd_reader_open(const char *path, cyacd_format format, cyacd_status *status)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        if (status)
+        {
+            *status = CYACD_ERR_IO;
+        }
+        return NULL;
+    }
+    
+    struct stat fileStat;
+    size_t size = (0 == fstat(fd, &fileStat) && fileStat.st_size > 0) ? (size_t)fileStat.st_size : 0;
+    return cyacd_reader_create(fd, NULL, size, format, status);
+}
+
+cyacd_reader *cyacd_reader_open_memory(const char *buffer, size_t length, cyacd_format format, cyacd_status *status)
+{
+    return cyacd_reader_create(-1, buffer, length, format, status);
+}
+
+const cyacd_header *cyacd_reader_header(const cyacd_reader *reader)
+{
+    return &reader->header;
+}
+
+size_t cyacd_reader_source_size(const cyacd_reader *reader)
+{
+    return reader->source_size;
+}
+
+cyacd_status cyacd_reader_next(cyacd_reader *reader, cyacd_row *row)
+{
+    int line = cyacd_read_line(reader);
+    if (line != LINE_OK)
+    {
+        return cyacd_status_for_line(line);
+    }
+    
+    memset(row, 0, sizeof(*row));
+    if (CYACD_FORMAT_CYACD == reader->format)
+    {
+        return cyacd_parse_row(reader, row);
+    }
+    return cyacd_parse_row_v1(reader, row);
+}
+
+void cyacd_reader_close(cyacd_reader *reader)
+{
+    if (reader == NULL)
+    {
+        return;
+    }
+    if (reader->fd >= 0)
+    {
+        close(reader->fd);
+    }
+    free(reader);
+}
+
+cyacd_status cyacd_parse_file(const char *path, cyacd_format format,
+                              void (*header_handler)(void *context, const cyacd_header *header),
+                              int (*row_handler)(void *context, const cyacd_row *row),
+                              void *context)
+{
+    cyacd_status status;
+    cyacd_reader *reader = cyacd_reader_open(path, format, &status);
+    if (reader == NULL)
+    {
+        return status;
+    }
+    
+    if (header_handler)
+    {
+        header_handler(context, cyacd_reader_header(reader));
+    }
+    
+    cyacd_row row;
+    while (CYACD_OK == (status = cyacd_reader_next(reader, &row)))
+    {
+        if (row_handler && row_handler(context, &row))
+        {
+            break;
+        }
+    }
+    
+    cyacd_reader_close(reader);
+    return (CYACD_END == status) ? CYACD_OK : status;
+}
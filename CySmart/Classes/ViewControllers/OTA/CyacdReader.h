@@ -0,0 +1,181 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#ifndef CyacdReader_h
+#define CyacdReader_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ *  @discussion Size of the buffer used to read the file
+ *
+ */
+#define CYACD_READ_BUFFER_SIZE      4096
+
+/*!
+ *  @discussion Maximum length of a single line of the file after junk characters are stripped
+ *
+ */
+#define CYACD_MAX_LINE_LENGTH       8192
+
+typedef enum
+{
+    CYACD_FORMAT_CYACD = 0,
+    CYACD_FORMAT_CYACD2
+} cyacd_format;
+
+typedef enum
+{
+    CYACD_OK = 0,
+    CYACD_END,                  // No more rows in the file
+    CYACD_ERR_IO,               // File could not be opened or read
+    CYACD_ERR_EMPTY,            // File has no content
+    CYACD_ERR_HEADER,           // Header line is missing or malformed
+    CYACD_ERR_VERSION,          // Unsupported file version (CYACD2)
+    CYACD_ERR_FORMAT,           // Data row is too short (CYACD)
+    CYACD_ERR_ROW,              // Data row is malformed
+    CYACD_ERR_LINE_TOO_LONG     // Line exceeds CYACD_MAX_LINE_LENGTH
+} cyacd_status;
+
+typedef enum
+{
+    CYACD_ROW_EIV = 0,          // Encryption initial vector (CYACD2)
+    CYACD_ROW_DATA,             // Flash row
+    CYACD_ROW_APPINFO           // Application start and size (CYACD2)
+} cyacd_row_type;
+
+/*!
+ *  @struct cyacd_header
+ *
+ *  @discussion Decoded header line of the file
+ *
+ */
+typedef struct
+{
+    uint8_t file_version;       // 0 for CYACD, 1 for CYACD2
+    uint32_t silicon_id;
+    uint8_t silicon_rev;
+    uint8_t checksum_type;
+    uint8_t app_id;             // CYACD2 only
+    uint32_t product_id;        // CYACD2 only
+} cyacd_header;
+
+/*!
+ *  @struct cyacd_row
+ *
+ *  @discussion Decoded row of the file. data points into the reader and stays valid until the next call to the reader.
+ *
+ */
+typedef struct
+{
+    cyacd_row_type type;
+    uint8_t array_id;           // CYACD only
+    uint16_t row_number;        // CYACD only
+    uint8_t checksum;           // CYACD only
+    uint32_t address;           // CYACD2 data rows only
+    uint32_t app_start;         // APPINFO rows only
+    uint32_t app_size;          // APPINFO rows only
+    uint16_t data_length;
+    const uint8_t *data;
+} cyacd_row;
+
+typedef struct cyacd_reader cyacd_reader;
+
+/*!
+ *  @function cyacd_reader_open
+ *
+ *  @discussion Opens the file at path and parses its header. Returns NULL and sets status on failure.
+ *
+ */
+cyacd_reader *cyacd_reader_open(const char *path, cyacd_format format, cyacd_status *status);
+
+/*!
+ *  @function cyacd_reader_open_memory
+ *
+ *  @discussion Same as cyacd_reader_open but reads from a buffer in memory. The buffer must outlive the reader.
+ *
+ */
+cyacd_reader *cyacd_reader_open_memory(const char *buffer, size_t length, cyacd_format format, cyacd_status *status);
+
+/*!
+ *  @function cyacd_reader_header
+ *
+ *  @discussion Returns the decoded header of the file
+ *
+ */
+const cyacd_header *cyacd_reader_header(const cyacd_reader *reader);
+
+/*!
+ *  @function cyacd_reader_next
+ *
+ *  @discussion Decodes the next row of the file. Returns CYACD_END when there are no more rows.
+ *
+ */
+cyacd_status cyacd_reader_next(cyacd_reader *reader, cyacd_row *row);
+
+/*!
+ *  @function cyacd_reader_source_size
+ *
+ *  @discussion Returns the size of the underlying file or buffer in bytes
+ *
+ */
+size_t cyacd_reader_source_size(const cyacd_reader *reader);
+
+/*!
+ *  @function cyacd_reader_close
+ *
+ *  @discussion Closes the file and releases the reader
+ *
+ */
+void cyacd_reader_close(cyacd_reader *reader);
+
+/*!
+ *  @function cyacd_parse_file
+ *
+ *  @discussion Parses the whole file in a single pass and calls row_handler for each row. Parsing stops when row_handler returns non-zero.
+ *
+ */
+cyacd_status cyacd_parse_file(const char *path, cyacd_format format,
+                              void (*header_handler)(void *context, const cyacd_header *header),
+                              int (*row_handler)(void *context, const cyacd_row *row),
+                              void *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CyacdReader_h */
@@ -0,0 +1,105 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import <Foundation/Foundation.h>
+
+/*!
+ *  @struct OTACheckpoint
+ *
+ *  @discussion Progress of an interrupted upgrade
+ *
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t rowIndex;      // Index of the last programmed and verified row
+    uint32_t rowCount;      // Row count of the image
+    int16_t arrayID;        // Flash array ID of the row (CYACD), -1 otherwise
+} OTACheckpoint;
+
+/*!
+ *  @class OTACheckpointStore
+ *
+ *  @discussion Persists the checkpoint of the last interrupted upgrade of each device together with the hash of its
+ *  image, and the hash of the image last flashed to each device, in the user defaults
+ *
+ */
+@interface OTACheckpointStore : NSObject
+
+/*!
+ *  @method loadCheckpoint: forDevice: imageHash:
+ *
+ *  @discussion Reads the checkpoint stored for the device. Returns NO if there is none or it belongs to another image.
+ *
+ */
++ (BOOL) loadCheckpoint:(OTACheckpoint *)checkpoint forDevice:(NSString *)deviceID imageHash:(NSData *)imageHash;
+
+/*!
+ *  @method saveCheckpoint: forDevice: imageHash:
+ *
+ *  @discussion Stores the checkpoint for the device and image, replacing the checkpoint of any other image
+ *
+ */
++ (void) saveCheckpoint:(OTACheckpoint)checkpoint forDevice:(NSString *)deviceID imageHash:(NSData *)imageHash;
+
+/*!
+ *  @method removeCheckpointForDevice:
+ *
+ *  @discussion Removes the checkpoint stored for the device, whatever image it belongs to
+ *
+ */
++ (void) removeCheckpointForDevice:(NSString *)deviceID;
+
+/*!
+ *  @method flashedImageHashForDevice:
+ *
+ *  @discussion Returns the hash of the image last flashed to the device, nil if unknown
+ *
+ */
++ (NSData *) flashedImageHashForDevice:(NSString *)deviceID;
+
+/*!
+ *  @method saveFlashedImageHash: forDevice:
+ *
+ *  @discussion Stores the hash of the image flashed to the device
+ *
+ */
++ (void) saveFlashedImageHash:(NSData *)imageHash forDevice:(NSString *)deviceID;
+
+/*!
+ *  @method removeFlashedImageHashForDevice:
+ *
+ *  @discussion Forgets the image flashed to the device, once its flash is about to be rewritten
+ *
+ */
++ (void) removeFlashedImageHashForDevice:(NSString *)deviceID;
+
+@end
@@ -0,0 +1,120 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import <Foundation/Foundation.h>
+
+@class OTAFirmwareImage;
+@class OTAImageDigest;
+
+/*!
+ *  @class OTADeltaPlan
+ *
+ *  @discussion Decides which rows of a CYACD image may be skipped, and counts the rows skipped and written. A row is a
+ *  candidate for skipping only if its CRC32 matches the digest of the image previously flashed to the device; VERIFY_ROW
+ *  then confirms the device still holds it. Without a previous digest every row is programmed.
+ *
+ */
+@interface OTADeltaPlan : NSObject
+
+/*!
+ *  @property skippedRowCount
+ *
+ *  @discussion Number of rows found unchanged on the device
+ *
+ */
+@property (nonatomic, readonly) NSUInteger skippedRowCount;
+
+/*!
+ *  @property writtenRowCount
+ *
+ *  @discussion Number of rows programmed
+ *
+ */
+@property (nonatomic, readonly) NSUInteger writtenRowCount;
+
+/*!
+ *  @property skippedByteCount
+ *
+ *  @discussion Row data bytes not sent since the rows were unchanged
+ *
+ */
+@property (nonatomic, readonly) NSUInteger skippedByteCount;
+
+/*!
+ *  @property writtenByteCount
+ *
+ *  @discussion Row data bytes sent to the device
+ *
+ */
+@property (nonatomic, readonly) NSUInteger writtenByteCount;
+
+/*!
+ *  @method initWithImage: previousDigest:
+ *
+ *  @discussion Creates the plan for the image. previousDigest is the digest of the image last flashed to the device, may be nil.
+ *
+ */
+- (instancetype) initWithImage:(OTAFirmwareImage *)image previousDigest:(OTAImageDigest *)previousDigest;
+
+/*!
+ *  @method shouldVerifyRowAtIndex:
+ *
+ *  @discussion Returns YES if the row matches the previously flashed image and should be confirmed using VERIFY_ROW instead of programming
+ *
+ */
+- (BOOL) shouldVerifyRowAtIndex:(NSUInteger)index;
+
+/*!
+ *  @method markRowSkippedAtIndex:
+ *
+ *  @discussion Records that the row matched the device flash and was not programmed
+ *
+ */
+- (void) markRowSkippedAtIndex:(NSUInteger)index;
+
+/*!
+ *  @method markRowWrittenAtIndex:
+ *
+ *  @discussion Records that the row was programmed
+ *
+ */
+- (void) markRowWrittenAtIndex:(NSUInteger)index;
+
+/*!
+ *  @method report
+ *
+ *  @discussion Returns the summary of rows skipped versus written
+ *
+ */
+- (NSString *) report;
+
+@end
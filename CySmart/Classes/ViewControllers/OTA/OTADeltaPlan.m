@@ -0,0 +1,121 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import "OTADeltaPlan.h"
+#import "OTAFirmwareImage.h"
+#import "OTAImageDigest.h"
+#import "Constants.h"
+
+/*!
+ *  @class OTADeltaPlan
+ *
+ *  @discussion Class to track the rows of a delta upgrade
+ *
+ */
+@implementation OTADeltaPlan
+{
+    OTAFirmwareImage *_image;
+    OTAImageDigest *_previousDigest;
+}
+
+- (instancetype) initWithImage:(OTAFirmwareImage *)image previousDigest:(OTAImageDigest *)previousDigest
+{
+    self = [super init];
+    if (self)
+    {
+        _image = image;
+        
+        // Rows can be compared by index only if the layout of both images is the same
+        if (previousDigest.rowCount == image.rowCount)
+        {
+            _previousDigest = previousDigest;
+        }
+    }
+    return self;
+}
+
+/*!
+ *  @method shouldVerifyRowAtIndex:
+ *
+ *  @discussion Returns YES if the row matches the previously flashed image and should be confirmed using VERIFY_ROW instead of programming
+ *
+ */
+- (BOOL) shouldVerifyRowAtIndex:(NSUInteger)index
+{
+    // The 8-bit VERIFY_ROW checksum alone is too weak to decide a row is unchanged
+    if (_previousDigest == nil)
+    {
+        return NO;
+    }
+    
+    // The verify checksum covers the array ID, row number and length, the CRC32 covers the payload
+    const OTARowDigest *previous = [_previousDigest rowDigestAtIndex:index];
+    const OTARowDigest *current = [_image.digest rowDigestAtIndex:index];
+    return previous->crc32 == current->crc32 && previous->verifyChecksum == current->verifyChecksum;
+}
+
+/*!
+ *  @method markRowSkippedAtIndex:
+ *
+ *  @discussion Records that the row matched the device flash and was not programmed
+ *
+ */
+- (void) markRowSkippedAtIndex:(NSUInteger)index
+{
+    _skippedRowCount++;
+    _skippedByteCount += [_image rowAtIndex:index]->dataLength;
+}
+
+/*!
+ *  @method markRowWrittenAtIndex:
+ *
+ *  @discussion Records that the row was programmed
+ *
+ */
+- (void) markRowWrittenAtIndex:(NSUInteger)index
+{
+    _writtenRowCount++;
+    _writtenByteCount += [_image rowAtIndex:index]->dataLength;
+}
+
+/*!
+ *  @method report
+ *
+ *  @discussion Returns the summary of rows skipped versus written
+ *
+ */
+- (NSString *) report
+{
+    return [NSString stringWithFormat:LOCALIZEDSTRING(@"OTADeltaUpgradeReport"), (unsigned long)_writtenRowCount, (unsigned long)_writtenByteCount, (unsigned long)_skippedRowCount, (unsigned long)_skippedByteCount];
+}
+
+@end
@@ -31,6 +31,7 @@
  */
 
 #import <Foundation/Foundation.h>
+#import "OTAFirmwareImage.h"
 
 @interface OTAFileParser : NSObject
 
@@ -39,12 +40,6 @@
 #define CHECKSUM_TYPE       @"CheckSumType"
 #define ROW_ID              @"RowID"
 #define ROW_COUNT           @"RowCount"
-#define ARRAY_ID            @"ArrayID"
-#define ROW_NUMBER          @"RowNumber"
-#define DATA_LENGTH         @"DataLength"
-#define DATA_ARRAY          @"DataArray"
-#define CHECKSUM_OTA        @"CheckSum"
-#define ROW_TYPE            @"RowType"
 #define FILE_VERSION        @"FileVersion"
 #define APPINFO_APP_START   @"APPINFO_APP_START"
 #define APPINFO_APP_SIZE    @"APPINFO_APP_SIZE"
@@ -60,7 +55,7 @@ typedef NS_ENUM(uint8_t, RowType) {
  *  @discussion Method for parsing the OTA firmware file (CYACD)
  *
  */
-- (void) parseFirmwareFileWithName:(NSString *)fileName path:(NSString *)filePath onFinish:(void(^)(NSMutableDictionary * header, NSArray * rowData, NSArray * rowIdArray, NSError * error))finish;
+- (void) parseFirmwareFileWithName:(NSString *)fileName path:(NSString *)filePath onFinish:(void(^)(NSMutableDictionary * header, OTAFirmwareImage * image, NSArray * rowIdArray, NSError * error))finish;
 
 /*!
  *  @method parseFirmwareFileWithName_v1: andPath: onFinish:
@@ -68,6 +63,6 @@ typedef NS_ENUM(uint8_t, RowType) {
  *  @discussion Method for parsing the OTA firmware file (CYACD2)
  *
  */
-- (void) parseFirmwareFileWithName_v1:(NSString *)fileName path:(NSString *)filePath onFinish:(void(^)(NSMutableDictionary *header, NSDictionary *appInfo, NSArray *rowData, NSError *error))finish;
+- (void) parseFirmwareFileWithName_v1:(NSString *)fileName path:(NSString *)filePath onFinish:(void(^)(NSMutableDictionary *header, NSDictionary *appInfo, OTAFirmwareImage *image, NSError *error))finish;
 
 @end
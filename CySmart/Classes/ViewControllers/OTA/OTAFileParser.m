@@ -31,22 +31,16 @@
  */
 
 #import "OTAFileParser.h"
+#import "CyacdReader.h"
 #import "Constants.h"
 #import "Utilities.h"
 
-#define FILE_HEADER_MAX_LENGTH      12
-#define FILE_HEADER_MAX_LENGTH_V1   24
 #define FILE_PARSER_ERROR_CODE      555
 
-#define APPINFO_PREFIX                      @"@APPINFO:0x"
-#define APPINFO_SEPARATOR                   @",0x"
-#define EIV_PREFIX                          @"@EIV:"
-#define DATA_PREFIX                         @":"
-
 /*!
  *  @class OTAFileParser
  *
- *  @discussion Class to parse the bootloader file
+ *  @discussion Class to parse the bootloader file. The file is streamed through CyacdReader, row payload is decoded straight into the firmware image.
  *
  */
 
@@ -58,111 +52,69 @@
  *  @discussion Method for parsing the OTA firmware file (CYACD)
  *
  */
-- (void) parseFirmwareFileWithName:(NSString *)fileName path:(NSString *)filePath onFinish:(void(^)(NSMutableDictionary * header, NSArray * rowData, NSArray * rowIdArray, NSError * error))finish
+- (void) parseFirmwareFileWithName:(NSString *)fileName path:(NSString *)filePath onFinish:(void(^)(NSMutableDictionary * header, OTAFirmwareImage * image, NSArray * rowIdArray, NSError * error))finish
 {
-    NSMutableDictionary * fileHeaderDict = [NSMutableDictionary new];
-    NSMutableArray * fileDataArray = [NSMutableArray new];
+    NSString * fullPath = [NSString pathWithComponents:[NSArray arrayWithObjects:filePath, fileName, nil]];
+    cyacd_status status;
+    cyacd_reader * reader = cyacd_reader_open([fullPath fileSystemRepresentation], CYACD_FORMAT_CYACD, &status);
+    if (NULL == reader)
+    {
+        finish(nil, nil, nil, [self errorForStatus:status]);
+        return;
+    }
+    
+    NSMutableDictionary * fileHeaderDict = [self headerDictionaryFromHeader:cyacd_reader_header(reader)];
+    
+    // Row payload takes roughly half of the hex characters in the file
+    OTAFirmwareImage * firmwareImage = [[OTAFirmwareImage alloc] initWithCapacity:cyacd_reader_source_size(reader) / 2];
     NSMutableArray * rowIdArray = [NSMutableArray new];
-    NSError * error;
     
-    NSString * fileContents = [NSString stringWithContentsOfFile:[NSString pathWithComponents:[NSArray arrayWithObjects:filePath, fileName, nil]]
-                                                        encoding:NSUTF8StringEncoding error:nil];
-    if (fileContents && fileContents.length > 0)
+    //Counting Rows in each RowID
+    int rowID = -1;
+    int rowCount = 0;
+    
+    NSData * fileHash = [OTAImageDigest hashForFileAtPath:fullPath];
+    
+    cyacd_row cyacdRow;
+    while (CYACD_OK == (status = cyacd_reader_next(reader, &cyacdRow)))
     {
-        // Separate by new line
-        NSMutableArray * fileContentsArray = (NSMutableArray *)[fileContents componentsSeparatedByCharactersInSet:[NSCharacterSet newlineCharacterSet]];
-        if (fileContentsArray)
+        OTAFirmwareRow row = {0};
+        row.rowType = RowTypeData;
+        row.arrayID = cyacdRow.array_id;
+        row.rowNumber = cyacdRow.row_number;
+        row.dataLength = cyacdRow.data_length;
+        row.checksum = cyacdRow.checksum;
+        [firmwareImage appendRow:row bytes:cyacdRow.data];
+        
+        if (rowID == cyacdRow.array_id)
         {
-            fileContentsArray = [self removeEmptyRowsAndJunkDataFromArray:fileContentsArray];
-            NSString * fileHeader = [fileContentsArray objectAtIndex:0];
-            
-            if (fileHeader.length >= FILE_HEADER_MAX_LENGTH)
-            {
-                //Parse header
-                [fileHeaderDict setObject:[NSNumber numberWithInt:iFileVersionTypeCYACD] forKey:FILE_VERSION];//Version of 0 for CYACD files
-                [fileHeaderDict setObject:[fileHeader substringWithRange:NSMakeRange(0, 8)] forKey:SILICON_ID];
-                [fileHeaderDict setObject:[fileHeader substringWithRange:NSMakeRange(8, 2)] forKey:SILICON_REV];
-                [fileHeaderDict setObject:[fileHeader substringWithRange:NSMakeRange(10, 2)] forKey:CHECKSUM_TYPE];
-                [fileContentsArray removeObjectAtIndex:0];
-                
-                //Parse data row
-                NSString * rowID = @"";
-                int rowCount = 0;
-                NSMutableDictionary * rowIdDict = [NSMutableDictionary new];
-                NSCharacterSet * charsToRemove = [NSCharacterSet characterSetWithCharactersInString:@"@:"];
-                
-                for (int i = 0; i < fileContentsArray.count; i++)
-                {
-                    //Strip '@' and ':' prefix off
-                    NSString * dataRowString = [fileContentsArray objectAtIndex:i];
-                    dataRowString = [[dataRowString componentsSeparatedByCharactersInSet:charsToRemove] componentsJoinedByString:@""];
-                    if (dataRowString.length > 20)
-                    {
-                        
-                        if ([self parseDataRowString:dataRowString] != nil)
-                        {
-                            [fileDataArray addObject:[self parseDataRowString:dataRowString]];
-                            
-                            //Counting Rows in each RowID
-                            if ([rowID  isEqual: @""])
-                            {
-                                rowID = [dataRowString substringWithRange:NSMakeRange(0, 2)];
-                                rowCount++;
-                            }
-                            else if ([rowID isEqual:[dataRowString substringWithRange:NSMakeRange(0, 2)]] )
-                            {
-                                rowCount++;
-                            }
-                            else
-                            {
-                                [rowIdDict setValue:rowID forKey:ROW_ID];
-                                [rowIdDict setValue:[NSNumber numberWithInt:rowCount] forKey:ROW_COUNT];
-                                [rowIdArray addObject:(NSDictionary *)rowIdDict];
-                                rowIdDict = [NSMutableDictionary new];
-                                rowID = [dataRowString substringWithRange:NSMakeRange(0, 2)];
-                                rowCount = 1;
-                            }
-                        }
-                        else
-                        {
-                            error = [[NSError alloc] initWithDomain:PARSING_ERROR code:FILE_PARSER_ERROR_CODE userInfo:[NSDictionary dictionaryWithObject:LOCALIZEDSTRING(@"invalidFile") forKey:NSLocalizedDescriptionKey]];
-                            finish(nil,nil,nil, error);
-                        }
-                    }
-                    else
-                    {
-                        error = [[NSError alloc] initWithDomain:FILE_FORMAT_ERROR code:FILE_PARSER_ERROR_CODE userInfo:[NSDictionary dictionaryWithObject:LOCALIZEDSTRING(@"dataFormatInvalid") forKey:NSLocalizedDescriptionKey]];
-                        finish(nil,nil,nil, error);
-                        break;
-                    }
-                }
-                
-                if (!error)
-                {
-                    //Counting Rows in each RowID. Adding last RowID count to Dict.
-                    [rowIdDict setValue:rowID forKey:ROW_ID];
-                    [rowIdDict setValue:[NSNumber numberWithInt:rowCount] forKey:ROW_COUNT];
-                    [rowIdArray addObject:(NSDictionary *)rowIdDict];
-                    finish(fileHeaderDict, fileDataArray, rowIdArray, nil);
-                }
-            }
-            else
-            {
-                error = [[NSError alloc] initWithDomain:PARSING_ERROR code:FILE_PARSER_ERROR_CODE userInfo:[NSDictionary dictionaryWithObject:LOCALIZEDSTRING(@"invalidFile") forKey:NSLocalizedDescriptionKey]];
-                finish(nil,nil,nil, error);
-            }
+            rowCount++;
         }
         else
         {
-            error = [[NSError alloc] initWithDomain:PARSING_ERROR code:FILE_PARSER_ERROR_CODE userInfo:[NSDictionary dictionaryWithObject:LOCALIZEDSTRING(@"parsingFailed") forKey:NSLocalizedDescriptionKey]];
-            finish(nil,nil,nil, error);
+            if (rowID >= 0)
+            {
+                [rowIdArray addObject:[self rowIdDictionaryWithArrayID:rowID count:rowCount]];
+            }
+            rowID = cyacdRow.array_id;
+            rowCount = 1;
         }
     }
-    else
+    cyacd_reader_close(reader);
+    
+    if (CYACD_END != status)
+    {
+        finish(nil, nil, nil, [self errorForStatus:status]);
+        return;
+    }
+    
+    //Adding last RowID count
+    if (rowID >= 0)
     {
-        error = [[NSError alloc] initWithDomain:FILE_EMPTY_ERROR code:FILE_PARSER_ERROR_CODE userInfo:[NSDictionary dictionaryWithObject:LOCALIZEDSTRING(@"fileEmpty") forKey:NSLocalizedDescriptionKey]];
-        finish(nil,nil,nil, error);
+        [rowIdArray addObject:[self rowIdDictionaryWithArrayID:rowID count:rowCount]];
     }
+    [self attachDigestToImage:firmwareImage fileHash:fileHash];
+    finish(fileHeaderDict, firmwareImage, rowIdArray, nil);
 }
 
 /*!
@@ -171,292 +123,133 @@
  *  @discussion Parses the OTA firmware file (CYACD2)
  *
  */
-- (void) parseFirmwareFileWithName_v1:(NSString *)fileName path:(NSString *)filePath onFinish:(void(^)(NSMutableDictionary *header, NSDictionary *appInfo, NSArray *rowData, NSError *error))finish
+- (void) parseFirmwareFileWithName_v1:(NSString *)fileName path:(NSString *)filePath onFinish:(void(^)(NSMutableDictionary *header, NSDictionary *appInfo, OTAFirmwareImage *image, NSError *error))finish
 {
-    NSMutableDictionary *fileHeaderDict = [NSMutableDictionary new];
+    NSString *fullPath = [NSString pathWithComponents:[NSArray arrayWithObjects:filePath, fileName, nil]];
+    cyacd_status status;
+    cyacd_reader *reader = cyacd_reader_open([fullPath fileSystemRepresentation], CYACD_FORMAT_CYACD2, &status);
+    if (NULL == reader)
+    {
+        finish(nil, nil, nil, [self errorForStatus:status]);
+        return;
+    }
+    
+    NSMutableDictionary *fileHeaderDict = [self headerDictionaryFromHeader:cyacd_reader_header(reader)];
+    OTAFirmwareImage *firmwareImage = [[OTAFirmwareImage alloc] initWithCapacity:cyacd_reader_source_size(reader) / 2];
     NSDictionary *appInfoDict = nil;
-    NSMutableArray *fileDataArr = [NSMutableArray new];
-    NSError *error;
+    NSData *fileHash = [OTAImageDigest hashForFileAtPath:fullPath];
     
-    NSString *fileContents = [NSString stringWithContentsOfFile:[NSString pathWithComponents:[NSArray arrayWithObjects:filePath, fileName, nil]]
-                                                        encoding:NSUTF8StringEncoding error:nil];
-    if (fileContents && fileContents.length > 0)
+    cyacd_row cyacdRow;
+    while (CYACD_OK == (status = cyacd_reader_next(reader, &cyacdRow)))
     {
-        // Separate by new line
-        NSMutableArray * fileContentsArr = (NSMutableArray *)[fileContents componentsSeparatedByCharactersInSet:[NSCharacterSet newlineCharacterSet]];
-        if (fileContentsArr)
+        if (CYACD_ROW_APPINFO == cyacdRow.type)
         {
-            fileContentsArr = [self removeEmptyRowsAndJunkDataFromArray:fileContentsArr];
-            NSString * fileHeader = [fileContentsArr objectAtIndex:0];
-            
-            if (fileHeader.length >= FILE_HEADER_MAX_LENGTH_V1)
-            {
-                NSData * fileHeaderData = [Utilities dataFromHexString:fileHeader];
-                uint8_t fileVersion = ((uint8_t *)[fileHeaderData bytes])[0];
-                
-                if (iFileVersionTypeCYACD2 == fileVersion)
-                {
-                    //Parse header
-                    [fileHeaderDict setObject:[NSNumber numberWithInt:fileVersion] forKey:FILE_VERSION];
-                    
-                    NSData * siliconIDData = [Utilities dataFromHexString:[fileHeader substringWithRange:NSMakeRange(2, 8)]];
-                    NSString * siliconIDStr = [Utilities HEXStringLittleFromByteArray:(uint8_t *)[siliconIDData bytes] ofSize:4];
-                    [fileHeaderDict setObject:siliconIDStr forKey:SILICON_ID];
-                    
-                    [fileHeaderDict setObject:[fileHeader substringWithRange:NSMakeRange(10, 2)] forKey:SILICON_REV];
-                    [fileHeaderDict setObject:[fileHeader substringWithRange:NSMakeRange(12, 2)] forKey:CHECKSUM_TYPE];
-                    
-                    NSString * appIDStr = [fileHeader substringWithRange:NSMakeRange(14, 2)];
-                    NSData * appIDData = [Utilities dataFromHexString:appIDStr];
-                    uint8_t appID = ((uint8_t *)[appIDData bytes])[0];
-                    [fileHeaderDict setObject:[NSNumber numberWithUnsignedChar:appID] forKey:APP_ID];
-                    
-                    NSString * productIDStr = [fileHeader substringWithRange:NSMakeRange(16, 8)];
-                    NSData * productIDData = [Utilities dataFromHexString:productIDStr];
-                    uint32_t productID = [Utilities parse4ByteValueLittleFromByteArray:(uint8_t *)[productIDData bytes]];
-                    [fileHeaderDict setObject:[NSNumber numberWithUnsignedInt:productID] forKey:PRODUCT_ID];
-                    
-                    [fileContentsArr removeObjectAtIndex:0];//Remove header line
-                    
-                    //Parse data lines
-                    for (int i = 0; i < fileContentsArr.count; i++)
-                    {
-                        BOOL success = NO;
-                        NSString * dataRowStr = [fileContentsArr objectAtIndex:i];
-                        if ([dataRowStr hasPrefix:APPINFO_PREFIX])
-                        {
-                            //Process APPINFO row
-                            appInfoDict = [self parseAppInfoRowString_v1:dataRowStr];
-                            success = (appInfoDict != nil);
-                        }
-                        else if ([dataRowStr hasPrefix:EIV_PREFIX])
-                        {
-                            //Process EIV row
-                            dataRowStr = [dataRowStr substringFromIndex:[EIV_PREFIX length]];//Strip "@EIV:" prefix off
-                            NSDictionary *dataRowDict = [self parseEivRowString_v1:dataRowStr];
-                            success = (dataRowDict != nil);
-                            [fileDataArr addObject:dataRowDict];
-                        }
-                        else if ([dataRowStr hasPrefix:DATA_PREFIX])
-                        {
-                            //Process data row
-                            dataRowStr = [dataRowStr substringFromIndex:[DATA_PREFIX length]];//Strip ":" prefix off
-                            NSDictionary *dataRowDict = [self parseDataRowString_v1:dataRowStr];
-                            success = (dataRowDict != nil);
-                            [fileDataArr addObject:dataRowDict];
-                        }
-                        
-                        if (!success)
-                        {
-                            error = [[NSError alloc] initWithDomain:PARSING_ERROR code:FILE_PARSER_ERROR_CODE userInfo:[NSDictionary dictionaryWithObject:LOCALIZEDSTRING(@"invalidFile") forKey:NSLocalizedDescriptionKey]];
-                            finish(nil, nil, nil, error);
-                            break;
-                        }
-                    }
-                    
-                    if (!error)
-                    {
-                        finish(fileHeaderDict, appInfoDict, fileDataArr, nil);
-                    }
-                }
-                else
-                {
-                    error = [[NSError alloc] initWithDomain:PARSING_ERROR code:FILE_PARSER_ERROR_CODE userInfo:[NSDictionary dictionaryWithObject:LOCALIZEDSTRING(@"unsupportedFileVersion") forKey:NSLocalizedDescriptionKey]];
-                    finish(nil, nil, nil, error);
-                }
-            }
-            else
-            {
-                error = [[NSError alloc] initWithDomain:PARSING_ERROR code:FILE_PARSER_ERROR_CODE userInfo:[NSDictionary dictionaryWithObject:LOCALIZEDSTRING(@"invalidFile") forKey:NSLocalizedDescriptionKey]];
-                finish(nil, nil, nil, error);
-            }
+            appInfoDict = @{APPINFO_APP_START : @(cyacdRow.app_start), APPINFO_APP_SIZE : @(cyacdRow.app_size)};
+            continue;
+        }
+        
+        OTAFirmwareRow row = {0};
+        row.dataLength = cyacdRow.data_length;
+        if (CYACD_ROW_EIV == cyacdRow.type)
+        {
+            row.rowType = RowTypeEiv;
         }
         else
         {
-            error = [[NSError alloc] initWithDomain:PARSING_ERROR code:FILE_PARSER_ERROR_CODE userInfo:[NSDictionary dictionaryWithObject:LOCALIZEDSTRING(@"parsingFailed") forKey:NSLocalizedDescriptionKey]];
-            finish(nil, nil, nil, error);
+            row.rowType = RowTypeData;
+            row.address = cyacdRow.address;
         }
+        [firmwareImage appendRow:row bytes:cyacdRow.data];
     }
-    else
-    {
-        error = [[NSError alloc] initWithDomain:FILE_EMPTY_ERROR code:FILE_PARSER_ERROR_CODE userInfo:[NSDictionary dictionaryWithObject:LOCALIZEDSTRING(@"fileEmpty") forKey:NSLocalizedDescriptionKey]];
-        finish(nil, nil, nil, error);
-    }
-}
-
-/*!
- *  @method removeEmptyRowsAndJunkDataFromArray:
- *
- *  @discussion Method for empty rows and junk data from the parsed array of data
- *
- */
-- (NSMutableArray *)removeEmptyRowsAndJunkDataFromArray:(NSMutableArray *)dataArray
-{
-    NSMutableCharacterSet * charsToRemain = [[NSMutableCharacterSet alloc] init];
-    [charsToRemain formUnionWithCharacterSet:[NSCharacterSet alphanumericCharacterSet]];
-    [charsToRemain addCharactersInString:@"@:,"];// CYACD - data rows start with ':'; CYACD2 - data rows start with ':', EIV row starts with '@EIV:', APPINFO row starts with '@APPINFO:'
-    NSCharacterSet * charsToRemove = [charsToRemain invertedSet];
+    cyacd_reader_close(reader);
     
-    for (int i = 0; i < dataArray.count; ) {
-        if ([[dataArray objectAtIndex:i] isEqualToString:@""]) {
-            [dataArray removeObjectAtIndex:i];
-        }else{
-            NSString *trimmedReplacement = [[[dataArray objectAtIndex:i]componentsSeparatedByCharactersInSet:charsToRemove]
-                                            componentsJoinedByString:@""];
-            [dataArray replaceObjectAtIndex:i withObject:trimmedReplacement];
-            i++;
-        }
+    if (CYACD_END != status)
+    {
+        finish(nil, nil, nil, [self errorForStatus:status]);
+        return;
     }
-    return dataArray;
+    [self attachDigestToImage:firmwareImage fileHash:fileHash];
+    finish(fileHeaderDict, appInfoDict, firmwareImage, nil);
 }
 
 /*!
- *  @method parseRowDataString:
+ *  @method attachDigestToImage: fileHash:
  *
- *  @discussion Method for parsing each row of data in the firmware file.
+ *  @discussion Attaches row digests to the parsed image. Digests cached for the file are reused, otherwise they are computed and cached.
  *
  */
-- (NSMutableDictionary *)parseDataRowString:(NSString *)rowData
+- (void)attachDigestToImage:(OTAFirmwareImage *)image fileHash:(NSData *)fileHash
 {
-    NSMutableDictionary * rowDataDict = [NSMutableDictionary new];
-    
-    [rowDataDict setValue:[rowData substringWithRange:NSMakeRange(0, 2)] forKey:ARRAY_ID];
-    [rowDataDict setValue:[rowData substringWithRange:NSMakeRange(2, 4)] forKey:ROW_NUMBER];
-    [rowDataDict setValue:[rowData substringWithRange:NSMakeRange(6, 4)] forKey:DATA_LENGTH];
-    
-    NSString * dataString = [rowData substringWithRange:NSMakeRange(10, rowData.length - 12)];
-    if ([Utilities getIntegerFromHexString:[rowDataDict objectForKey:DATA_LENGTH]] != dataString.length/2 )
+    OTAImageDigest * digest = [OTAImageDigest cachedDigestForFileHash:fileHash];
+    if (digest == nil || digest.rowCount != image.rowCount)
     {
-        return nil;
+        digest = [[OTAImageDigest alloc] initWithImage:image fileHash:fileHash];
+        [digest writeToCache];
     }
-    
-    NSMutableArray * byteArray = [NSMutableArray new];
-    for (int i = 0; i + 2 <= dataString.length; i += 2) {
-        [byteArray addObject:[dataString substringWithRange:NSMakeRange(i, 2)]];
-    }
-    [rowDataDict setValue:byteArray forKey:DATA_ARRAY];
-    [rowDataDict setValue:[rowData substringWithRange:NSMakeRange(rowData.length - 2, 2)] forKey:CHECKSUM_OTA];
-    
-    return rowDataDict;
+    image.digest = digest;
 }
 
 /*!
- *  @method parseDataRowString_v1:
+ *  @method headerDictionaryFromHeader:
  *
- *  @discussion Method for parsing data row in firmware file (CYACD2).
+ *  @discussion Converts parsed file header into the dictionary used by the upgrade flow
  *
  */
-- (NSMutableDictionary *)parseDataRowString_v1:(NSString *)rowData
+- (NSMutableDictionary *)headerDictionaryFromHeader:(const cyacd_header *)header
 {
-    const int ADDR_LEN = 8;
-    
-    if (nil == rowData || [rowData length] < ADDR_LEN || ([rowData length] - ADDR_LEN) % 2)
+    NSMutableDictionary * fileHeaderDict = [NSMutableDictionary new];
+    [fileHeaderDict setObject:[NSNumber numberWithUnsignedChar:header->file_version] forKey:FILE_VERSION];
+    [fileHeaderDict setObject:[NSString stringWithFormat:@"%08x", header->silicon_id] forKey:SILICON_ID];
+    [fileHeaderDict setObject:[NSString stringWithFormat:@"%02x", header->silicon_rev] forKey:SILICON_REV];
+    [fileHeaderDict setObject:[NSString stringWithFormat:@"%02x", header->checksum_type] forKey:CHECKSUM_TYPE];
+    if (iFileVersionTypeCYACD2 == header->file_version)
     {
-        return nil;
+        [fileHeaderDict setObject:[NSNumber numberWithUnsignedChar:header->app_id] forKey:APP_ID];
+        [fileHeaderDict setObject:[NSNumber numberWithUnsignedInt:header->product_id] forKey:PRODUCT_ID];
     }
-    
-    NSMutableDictionary * rowDataDict = [NSMutableDictionary new];
-    [rowDataDict setObject:[NSNumber numberWithUnsignedChar:RowTypeData] forKey:ROW_TYPE];
-    
-    NSString * addrStr = [rowData substringWithRange:NSMakeRange(0, ADDR_LEN)];
-    NSData * addrData = [Utilities dataFromHexString:addrStr];
-    uint32_t addr = [Utilities parse4ByteValueLittleFromByteArray:(uint8_t *)[addrData bytes]];
-    [rowDataDict setObject:[NSNumber numberWithUnsignedInt:addr] forKey:ADDRESS];
-    
-    NSString * dataStr = [rowData substringWithRange:NSMakeRange(ADDR_LEN, [rowData length] - ADDR_LEN)];
-    
-    NSData * bytesData = [Utilities dataFromHexString:dataStr];
-    uint32_t crc32 = [Utilities CRC32ForByteArray:(uint8_t *)[bytesData bytes] ofSize:(uint32_t)[bytesData length]];
-    
-    [rowDataDict setObject:[NSNumber numberWithUnsignedInt:crc32] forKey:CRC_32];
-    [rowDataDict setObject:[NSNumber numberWithUnsignedInt:(uint32_t)[bytesData length]] forKey:DATA_LENGTH];
-    
-    NSMutableArray * byteArr = [NSMutableArray new];
-    for (int i = 0; i + 2 <= dataStr.length; i += 2) {
-        [byteArr addObject:[dataStr substringWithRange:NSMakeRange(i, 2)]];
-    }
-    [rowDataDict setValue:byteArr forKey:DATA_ARRAY];
-    
-    return rowDataDict;
+    return fileHeaderDict;
 }
 
 /*!
- *  @method parseAppInfoRowString_v1:
+ *  @method rowIdDictionaryWithArrayID: count:
  *
- *  @discussion Parses APPINFO row in firmware file (CYACD2).
+ *  @discussion Returns row count entry for a flash array (CYACD)
  *
  */
-- (NSMutableDictionary *)parseAppInfoRowString_v1:(NSString *)rowData
+- (NSDictionary *)rowIdDictionaryWithArrayID:(int)arrayID count:(int)rowCount
 {
-    if (nil == rowData)
-        return nil;
-    
-    NSMutableDictionary * rowDataDict = [NSMutableDictionary new];
-    
-    NSRange range = [rowData rangeOfString:APPINFO_SEPARATOR];
-    if (range.length <= 0)
-        return nil;
-
-    NSUInteger separatorIndex = range.location;
-    NSUInteger pos = APPINFO_PREFIX.length;
-    NSUInteger length = separatorIndex - pos;
-    NSString *appStartStr = [rowData substringWithRange:NSMakeRange(pos, length)];
-    NSData *appStartData = [Utilities dataFromHexString:appStartStr isLSB:NO];
-    if (appStartData == nil || appStartData.length == 0 || appStartData.length > 4)
-        return nil;
-    
-    uint8_t appStartBytes[4] = {0,0,0,0};//If data is less than 4 bytes then high bytes will be set to 0
-    for (int i = 0; i < appStartData.length; i++)
-    {
-        appStartBytes[i] = ((uint8_t *)appStartData.bytes)[i];
-    }
-    uint32_t appStart = [Utilities parse4ByteValueLittleFromByteArray:appStartBytes];
-    [rowDataDict setValue:@(appStart) forKey:APPINFO_APP_START];
-    
-    pos += length + APPINFO_SEPARATOR.length;
-    length = rowData.length - pos;
-    NSString *appSizeStr = [rowData substringWithRange:NSMakeRange(pos, length)];
-    NSData *appSizeData = [Utilities dataFromHexString:appSizeStr isLSB:NO];
-    if (appSizeData == nil || appSizeData.length == 0)
-        return nil;
-
-    uint8_t appSizeBytes[4] = {0,0,0,0};//If data is less than 4 bytes then high bytes will be set to 0
-    for (int i = 0; i < appSizeData.length; i++)
-    {
-        appSizeBytes[i] = ((uint8_t *)appSizeData.bytes)[i];
-    }
-    uint32_t appSize = [Utilities parse4ByteValueLittleFromByteArray:appSizeBytes];
-    [rowDataDict setValue:@(appSize) forKey:APPINFO_APP_SIZE];
-    
-    return rowDataDict;
+    return @{ROW_ID : [NSString stringWithFormat:@"%02X", arrayID], ROW_COUNT : [NSNumber numberWithInt:rowCount]};
 }
 
 /*!
- *  @method parseEivRowString_v1:
+ *  @method errorForStatus:
  *
- *  @discussion Parses EIV row in firmware file (CYACD2).
+ *  @discussion Maps reader status to the parser error reported to the upgrade flow
  *
  */
-- (NSMutableDictionary *)parseEivRowString_v1:(NSString *)rowData
+- (NSError *)errorForStatus:(cyacd_status)status
 {
-    if (nil == rowData || [rowData length] % 2)
-    {
-        return nil;
-    }
+    NSString * domain = PARSING_ERROR;
+    NSString * message = LOCALIZEDSTRING(@"invalidFile");
     
-    NSMutableDictionary * rowDataDict = [NSMutableDictionary new];
-    [rowDataDict setValue:[NSNumber numberWithUnsignedChar:RowTypeEiv] forKey:ROW_TYPE];
-    
-    uint32_t numBytes = (uint32_t)(rowData.length / 2);
-    [rowDataDict setObject:[NSNumber numberWithUnsignedInt:numBytes] forKey:DATA_LENGTH];
-    
-    NSMutableArray * dataArr = [NSMutableArray new];
-    for (int i = 0; i + 2 <= rowData.length; i += 2) {
-        [dataArr addObject:[rowData substringWithRange:NSMakeRange(i, 2)]];
+    switch (status)
+    {
+        case CYACD_ERR_IO:
+        case CYACD_ERR_EMPTY:
+            domain = FILE_EMPTY_ERROR;
+            message = LOCALIZEDSTRING(@"fileEmpty");
+            break;
+        case CYACD_ERR_VERSION:
+            message = LOCALIZEDSTRING(@"unsupportedFileVersion");
+            break;
+        case CYACD_ERR_FORMAT:
+            domain = FILE_FORMAT_ERROR;
+            message = LOCALIZEDSTRING(@"dataFormatInvalid");
+            break;
+        default:
+            break;
     }
-    [rowDataDict setValue:dataArr forKey:DATA_ARRAY];
-    
-    return rowDataDict;
+    return [[NSError alloc] initWithDomain:domain code:FILE_PARSER_ERROR_CODE userInfo:[NSDictionary dictionaryWithObject:message forKey:NSLocalizedDescriptionKey]];
 }
 
 @end
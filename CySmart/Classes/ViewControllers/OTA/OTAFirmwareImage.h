@@ -0,0 +1,126 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import "OTAImageDigest.h"
+
+/*!
+ *  @struct OTAFirmwareRow
+ *
+ *  @discussion Packed descriptor of a single row of the firmware image. Row payload lives in the image byte buffer at dataOffset.
+ *
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t dataOffset;    // Offset of the row payload in the image byte buffer
+    uint32_t address;       // Flash address (CYACD2)
+    uint16_t rowNumber;     // Flash row number (CYACD)
+    uint16_t dataLength;    // Length of the row payload in bytes
+    uint8_t arrayID;        // Flash array ID (CYACD)
+    uint8_t checksum;       // Row checksum from the file (CYACD)
+    uint8_t rowType;        // RowType (CYACD2)
+    uint8_t reserved;
+} OTAFirmwareRow;
+
+/*!
+ *  @class OTAFirmwareImage
+ *
+ *  @discussion Compact in-memory firmware image: one contiguous byte buffer holding the payload of all rows plus a packed row table
+ *
+ */
+@interface OTAFirmwareImage : NSObject
+
+/*!
+ *  @property data
+ *
+ *  @discussion Contiguous buffer holding the payload of all rows
+ *
+ */
+@property (nonatomic, readonly) NSData *data;
+
+/*!
+ *  @property rowCount
+ *
+ *  @discussion Number of rows in the image
+ *
+ */
+@property (nonatomic, readonly) NSUInteger rowCount;
+
+/*!
+ *  @property digest
+ *
+ *  @discussion Precomputed row digests of the image
+ *
+ */
+@property (nonatomic, strong) OTAImageDigest *digest;
+
+/*!
+ *  @method initWithCapacity:
+ *
+ *  @discussion Creates an empty image with space reserved for the given number of payload bytes
+ *
+ */
+- (instancetype) initWithCapacity:(NSUInteger)capacity;
+
+/*!
+ *  @method appendRow: bytes:
+ *
+ *  @discussion Appends a row to the image. The dataOffset of the row is assigned by the image.
+ *
+ */
+- (void) appendRow:(OTAFirmwareRow)row bytes:(const uint8_t *)bytes;
+
+/*!
+ *  @method rowAtIndex:
+ *
+ *  @discussion Returns the packed descriptor of the row at index
+ *
+ */
+- (const OTAFirmwareRow *) rowAtIndex:(NSUInteger)index;
+
+/*!
+ *  @method bytesForRowAtIndex:
+ *
+ *  @discussion Returns pointer to the payload of the row at index
+ *
+ */
+- (const uint8_t *) bytesForRowAtIndex:(NSUInteger)index;
+
+/*!
+ *  @method dataForRowAtIndex: range:
+ *
+ *  @discussion Returns a slice of the row payload. The returned data references the image buffer without copying and must not outlive the image.
+ *
+ */
+- (NSData *) dataForRowAtIndex:(NSUInteger)index range:(NSRange)range;
+
+@end
@@ -0,0 +1,145 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import "OTAFirmwareImage.h"
+
+/*!
+ *  @class OTAFirmwareImage
+ *
+ *  @discussion Class to hold the parsed firmware image
+ *
+ */
+@interface OTAFirmwareImage ()
+{
+    NSMutableData * imageData;
+    NSMutableData * rowTable;
+}
+
+@end
+
+@implementation OTAFirmwareImage
+
+- (instancetype) init
+{
+    return [self initWithCapacity:0];
+}
+
+- (instancetype) initWithCapacity:(NSUInteger)capacity
+{
+    self = [super init];
+    if (self)
+    {
+        imageData = [[NSMutableData alloc] initWithCapacity:capacity];
+        rowTable = [NSMutableData new];
+    }
+    return self;
+}
+
+-(NSData *) data
+{
+    return imageData;
+}
+
+-(NSUInteger) rowCount
+{
+    return rowTable.length / sizeof(OTAFirmwareRow);
+}
+
+/*!
+ *  @method appendRow: bytes:
+ *
+ *  @discussion Appends a row to the image. The dataOffset of the row is assigned by the image.
+ *
+ */
+- (void) appendRow:(OTAFirmwareRow)row bytes:(const uint8_t *)bytes
+{
+    row.dataOffset = (uint32_t)imageData.length;
+    if (row.dataLength > 0 && bytes != NULL)
+    {
+        [imageData appendBytes:bytes length:row.dataLength];
+    }
+    else
+    {
+        row.dataLength = 0;
+    }
+    [rowTable appendBytes:&row length:sizeof(OTAFirmwareRow)];
+}
+
+/*!
+ *  @method rowAtIndex:
+ *
+ *  @discussion Returns the packed descriptor of the row at index
+ *
+ */
+- (const OTAFirmwareRow *) rowAtIndex:(NSUInteger)index
+{
+    if (index >= self.rowCount)
+    {
+        return NULL;
+    }
+    return ((const OTAFirmwareRow *)rowTable.bytes) + index;
+}
+
+/*!
+ *  @method bytesForRowAtIndex:
+ *
+ *  @discussion Returns pointer to the payload of the row at index
+ *
+ */
+- (const uint8_t *) bytesForRowAtIndex:(NSUInteger)index
+{
+    const OTAFirmwareRow * row = [self rowAtIndex:index];
+    if (row == NULL)
+    {
+        return NULL;
+    }
+    return ((const uint8_t *)imageData.bytes) + row->dataOffset;
+}
+
+/*!
+ *  @method dataForRowAtIndex: range:
+ *
+ *  @discussion Returns a slice of the row payload. The returned data references the image buffer without copying and must not outlive the image.
+ *
+ */
+- (NSData *) dataForRowAtIndex:(NSUInteger)index range:(NSRange)range
+{
+    const OTAFirmwareRow * row = [self rowAtIndex:index];
+    if (row == NULL || NSMaxRange(range) > row->dataLength)
+    {
+        return nil;
+    }
+    uint8_t * bytes = ((uint8_t *)imageData.mutableBytes) + row->dataOffset + range.location;
+    return [NSData dataWithBytesNoCopy:bytes length:range.length freeWhenDone:NO];
+}
+
+@end
@@ -0,0 +1,152 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import <Foundation/Foundation.h>
+
+@class OTAFirmwareImage;
+
+/*!
+ *  @struct OTARowDigest
+ *
+ *  @discussion Precomputed digests of a single row of the firmware image
+ *
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t crc32;             // CRC32 of the row payload, sent with PROGRAM_DATA (CYACD2)
+    uint8_t verifyChecksum;     // Checksum expected in the VERIFY_ROW response (CYACD)
+    uint8_t reserved[3];
+} OTARowDigest;
+
+typedef NS_ENUM(NSUInteger, OTAImageVerificationResult)
+{
+    OTAImageVerificationPassed = 0,
+    OTAImageVerificationRowMismatch,    // Row checksum reported by the device differs from the digest
+    OTAImageVerificationAppInvalid      // Device reported the application checksum as invalid
+};
+
+/*!
+ *  @class OTAImageDigest
+ *
+ *  @discussion Digest table of a firmware image: per-row checksum and CRC32 plus whole-application checksums.
+ *  Digests are stored in a sidecar file in the caches directory named after the SHA-256 hash of the firmware file,
+ *  so flashing the same file again skips the hashing of rows. The file hash is cached too, by path, size and
+ *  modification date, so an unchanged file is not read again to hash it.
+ *
+ */
+@interface OTAImageDigest : NSObject
+
+/*!
+ *  @property fileHash
+ *
+ *  @discussion SHA-256 hash of the firmware file
+ *
+ */
+@property (nonatomic, readonly) NSData *fileHash;
+
+/*!
+ *  @property rowCount
+ *
+ *  @discussion Number of rows in the digest table
+ *
+ */
+@property (nonatomic, readonly) NSUInteger rowCount;
+
+/*!
+ *  @property appChecksum
+ *
+ *  @discussion 2's complement of the 8-bit sum of the payload of all rows
+ *
+ */
+@property (nonatomic, readonly) uint8_t appChecksum;
+
+/*!
+ *  @property appCRC32
+ *
+ *  @discussion CRC32 of the payload of all rows in file order
+ *
+ */
+@property (nonatomic, readonly) uint32_t appCRC32;
+
+/*!
+ *  @method hashForFileAtPath:
+ *
+ *  @discussion Returns SHA-256 hash of the file at path, nil if the file cannot be read. The file is hashed only if
+ *  its size or modification date changed since it was last hashed.
+ *
+ */
++ (NSData *) hashForFileAtPath:(NSString *)path;
+
+/*!
+ *  @method cachedDigestForFileHash:
+ *
+ *  @discussion Returns the digest stored for the file hash, nil if there is none
+ *
+ */
++ (instancetype) cachedDigestForFileHash:(NSData *)fileHash;
+
+/*!
+ *  @method initWithImage: fileHash:
+ *
+ *  @discussion Computes the digest of every row of the image in a single pass
+ *
+ */
+- (instancetype) initWithImage:(OTAFirmwareImage *)image fileHash:(NSData *)fileHash;
+
+/*!
+ *  @method rowDigestAtIndex:
+ *
+ *  @discussion Returns the digests of the row at index
+ *
+ */
+- (const OTARowDigest *) rowDigestAtIndex:(NSUInteger)index;
+
+/*!
+ *  @method writeToCache
+ *
+ *  @discussion Stores the digest in the caches directory
+ *
+ */
+- (BOOL) writeToCache;
+
+/*!
+ *  @method verifyDeviceRowChecksums: fromRowAtIndex: appValid: mismatchedRows:
+ *
+ *  @discussion Checks the whole image against the device: row checksums collected from VERIFY_ROW responses (one byte
+ *  per row from firstRow on, nil when rows are not verified one by one) and the VERIFY_CHECKSUM/VERIFY_APP result.
+ *  Rows before firstRow were programmed by an interrupted upgrade that was resumed; no VERIFY_ROW response of this
+ *  upgrade covers them, so only the application checksum of the device vouches for them.
+ *
+ */
+- (OTAImageVerificationResult) verifyDeviceRowChecksums:(NSData *)rowChecksums fromRowAtIndex:(NSUInteger)firstRow appValid:(BOOL)appValid mismatchedRows:(NSIndexSet **)mismatchedRows;
+
+@end
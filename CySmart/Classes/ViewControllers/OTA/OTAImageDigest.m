@@ -0,0 +1,320 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import "OTAImageDigest.h"
+#import "OTAFirmwareImage.h"
+#import "CyChecksum.h"
+#import <CommonCrypto/CommonDigest.h>
+
+#define DIGEST_CACHE_DIRECTORY      @"OTADigests"
+#define DIGEST_FILE_EXTENSION       @"digest"
+#define DIGEST_FILE_MAGIC           0x4441544F  // "OTAD"
+#define DIGEST_FILE_VERSION         1
+
+#define FILE_HASH_INDEX_NAME        @"FileHashes.plist"
+#define FILE_HASH_SIZE              @"Size"
+#define FILE_HASH_MODIFICATION_DATE @"ModificationDate"
+#define FILE_HASH_HASH              @"Hash"
+
+/*
+ * Header of the sidecar digest file, followed by the table of OTARowDigest
+ */
+typedef struct __attribute__((packed))
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t rowCount;
+    uint32_t appCRC32;
+    uint8_t appChecksum;
+    uint8_t padding[3];
+} OTADigestFileHeader;
+
+/*!
+ *  @class OTAImageDigest
+ *
+ *  @discussion Class to hold the precomputed digests of a firmware image
+ *
+ */
+@interface OTAImageDigest ()
+{
+    NSData * rowTable;
+}
+
+@end
+
+@implementation OTAImageDigest
+
+/*!
+ *  @method cacheDirectory
+ *
+ *  @discussion Returns path of the directory of the digest cache
+ *
+ */
++ (NSString *) cacheDirectory
+{
+    NSString * cachesPath = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+    return [cachesPath stringByAppendingPathComponent:DIGEST_CACHE_DIRECTORY];
+}
+
+/*!
+ *  @method hashForFileAtPath:
+ *
+ *  @discussion Returns SHA-256 hash of the file at path, nil if the file cannot be read. The file is hashed only if
+ *  its size or modification date changed since it was last hashed.
+ *
+ */
++ (NSData *) hashForFileAtPath:(NSString *)path
+{
+    NSDictionary * attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:path error:nil];
+    if (attributes == nil)
+    {
+        return nil;
+    }
+    NSNumber * size = attributes[NSFileSize];
+    NSNumber * modificationDate = @([[attributes fileModificationDate] timeIntervalSinceReferenceDate]);
+    NSString * indexPath = [[self cacheDirectory] stringByAppendingPathComponent:FILE_HASH_INDEX_NAME];
+    
+    @synchronized (self)
+    {
+        NSDictionary * entry = [NSDictionary dictionaryWithContentsOfFile:indexPath][path];
+        NSData * cachedHash = entry[FILE_HASH_HASH];
+        if ([entry[FILE_HASH_SIZE] isEqual:size] && [entry[FILE_HASH_MODIFICATION_DATE] isEqual:modificationDate] &&
+            [cachedHash isKindOfClass:[NSData class]] && cachedHash.length == CC_SHA256_DIGEST_LENGTH)
+        {
+            return cachedHash;
+        }
+    }
+    
+    NSData * fileData = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:nil];
+    if (fileData == nil)
+    {
+        return nil;
+    }
+    
+    NSMutableData * hash = [NSMutableData dataWithLength:CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(fileData.bytes, (CC_LONG)fileData.length, hash.mutableBytes);
+    
+    @synchronized (self)
+    {
+        // Entries of files that are gone are dropped, so the index does not outgrow the firmware files
+        NSMutableDictionary * index = [NSMutableDictionary new];
+        [[NSDictionary dictionaryWithContentsOfFile:indexPath] enumerateKeysAndObjectsUsingBlock:^(NSString * indexedPath, id indexedEntry, BOOL * stop) {
+            if ([[NSFileManager defaultManager] fileExistsAtPath:indexedPath])
+            {
+                index[indexedPath] = indexedEntry;
+            }
+        }];
+        index[path] = @{FILE_HASH_SIZE : size, FILE_HASH_MODIFICATION_DATE : modificationDate, FILE_HASH_HASH : hash};
+        [[NSFileManager defaultManager] createDirectoryAtPath:[self cacheDirectory] withIntermediateDirectories:YES attributes:nil error:nil];
+        [index writeToFile:indexPath atomically:YES];
+    }
+    return hash;
+}
+
+/*!
+ *  @method cachePathForFileHash:
+ *
+ *  @discussion Returns path of the sidecar digest file for the file hash
+ *
+ */
++ (NSString *) cachePathForFileHash:(NSData *)fileHash
+{
+    NSMutableString * fileName = [NSMutableString stringWithCapacity:fileHash.length * 2];
+    const uint8_t * bytes = fileHash.bytes;
+    for (NSUInteger i = 0; i < fileHash.length; i++)
+    {
+        [fileName appendFormat:@"%02x", bytes[i]];
+    }
+    return [[self cacheDirectory] stringByAppendingPathComponent:[fileName stringByAppendingPathExtension:DIGEST_FILE_EXTENSION]];
+}
+
+/*!
+ *  @method cachedDigestForFileHash:
+ *
+ *  @discussion Returns the digest stored for the file hash, nil if there is none
+ *
+ */
++ (instancetype) cachedDigestForFileHash:(NSData *)fileHash
+{
+    if (fileHash == nil)
+    {
+        return nil;
+    }
+    
+    NSData * fileData = [NSData dataWithContentsOfFile:[self cachePathForFileHash:fileHash]];
+    if (fileData.length < sizeof(OTADigestFileHeader))
+    {
+        return nil;
+    }
+    
+    OTADigestFileHeader header;
+    [fileData getBytes:&header length:sizeof(header)];
+    NSUInteger tableLength = (NSUInteger)header.rowCount * sizeof(OTARowDigest);
+    if (DIGEST_FILE_MAGIC != header.magic || DIGEST_FILE_VERSION != header.version || fileData.length != sizeof(header) + tableLength)
+    {
+        return nil;
+    }
+    
+    OTAImageDigest * digest = [[self alloc] init];
+    digest->_fileHash = fileHash;
+    digest->_rowCount = header.rowCount;
+    digest->_appChecksum = header.appChecksum;
+    digest->_appCRC32 = header.appCRC32;
+    digest->rowTable = [fileData subdataWithRange:NSMakeRange(sizeof(header), tableLength)];
+    return digest;
+}
+
+/*!
+ *  @method initWithImage: fileHash:
+ *
+ *  @discussion Computes the digest of every row of the image in a single pass
+ *
+ */
+- (instancetype) initWithImage:(OTAFirmwareImage *)image fileHash:(NSData *)fileHash
+{
+    self = [super init];
+    if (self)
+    {
+        _fileHash = fileHash;
+        _rowCount = image.rowCount;
+        
+        NSMutableData * table = [NSMutableData dataWithLength:_rowCount * sizeof(OTARowDigest)];
+        OTARowDigest * digests = table.mutableBytes;
+        uint32_t appCRC32 = 0;
+        uint8_t appSum = 0;
+        
+        for (NSUInteger i = 0; i < _rowCount; i++)
+        {
+            const OTAFirmwareRow * row = [image rowAtIndex:i];
+            const uint8_t * bytes = [image bytesForRowAtIndex:i];
+            
+            uint8_t rowSum = 0;
+            for (uint16_t j = 0; j < row->dataLength; j++)
+            {
+                rowSum += bytes[j];
+            }
+            appSum += rowSum;
+            
+            digests[i].crc32 = cy_crc32c(bytes, row->dataLength);
+            appCRC32 = cy_crc32c_update(appCRC32, bytes, row->dataLength);
+            
+            // Device returns the sum of the row payload plus the row header fields
+            digests[i].verifyChecksum = row->checksum + row->arrayID + row->rowNumber + (row->rowNumber >> 8) + row->dataLength + (row->dataLength >> 8);
+        }
+        
+        _appChecksum = (uint8_t)(~appSum + 1);
+        _appCRC32 = appCRC32;
+        rowTable = table;
+    }
+    return self;
+}
+
+/*!
+ *  @method rowDigestAtIndex:
+ *
+ *  @discussion Returns the digests of the row at index
+ *
+ */
+- (const OTARowDigest *) rowDigestAtIndex:(NSUInteger)index
+{
+    if (index >= _rowCount)
+    {
+        return NULL;
+    }
+    return ((const OTARowDigest *)rowTable.bytes) + index;
+}
+
+/*!
+ *  @method writeToCache
+ *
+ *  @discussion Stores the digest in the caches directory
+ *
+ */
+- (BOOL) writeToCache
+{
+    if (_fileHash == nil)
+    {
+        return NO;
+    }
+    
+    NSString * path = [OTAImageDigest cachePathForFileHash:_fileHash];
+    [[NSFileManager defaultManager] createDirectoryAtPath:[path stringByDeletingLastPathComponent] withIntermediateDirectories:YES attributes:nil error:nil];
+    
+    OTADigestFileHeader header = {0};
+    header.magic = DIGEST_FILE_MAGIC;
+    header.version = DIGEST_FILE_VERSION;
+    header.rowCount = (uint32_t)_rowCount;
+    header.appCRC32 = _appCRC32;
+    header.appChecksum = _appChecksum;
+    
+    NSMutableData * fileData = [NSMutableData dataWithBytes:&header length:sizeof(header)];
+    [fileData appendData:rowTable];
+    return [fileData writeToFile:path atomically:YES];
+}
+
+/*!
+ *  @method verifyDeviceRowChecksums: fromRowAtIndex: appValid: mismatchedRows:
+ *
+ *  @discussion Checks the whole image against the device using the precomputed digests. Rows before firstRow are
+ *  left to the application checksum.
+ *
+ */
+- (OTAImageVerificationResult) verifyDeviceRowChecksums:(NSData *)rowChecksums fromRowAtIndex:(NSUInteger)firstRow appValid:(BOOL)appValid mismatchedRows:(NSIndexSet **)mismatchedRows
+{
+    NSMutableIndexSet * mismatched = [NSMutableIndexSet new];
+    if (rowChecksums != nil)
+    {
+        const uint8_t * checksums = rowChecksums.bytes;
+        const OTARowDigest * digests = rowTable.bytes;
+        for (NSUInteger i = firstRow; i < _rowCount; i++)
+        {
+            if (i - firstRow >= rowChecksums.length || checksums[i - firstRow] != digests[i].verifyChecksum)
+            {
+                [mismatched addIndex:i];
+            }
+        }
+    }
+    
+    if (mismatchedRows)
+    {
+        *mismatchedRows = mismatched;
+    }
+    
+    if (mismatched.count > 0)
+    {
+        return OTAImageVerificationRowMismatch;
+    }
+    return appValid ? OTAImageVerificationPassed : OTAImageVerificationAppInvalid;
+}
+
+@end
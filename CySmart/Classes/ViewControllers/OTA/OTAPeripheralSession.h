@@ -0,0 +1,142 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import <CoreBluetooth/CoreBluetooth.h>
+#import "OTASession.h"
+
+@class OTAPeripheralSession;
+
+@protocol OTAPeripheralSessionDelegate <NSObject>
+
+/*!
+ *  @method peripheralSessionDidBecomeReady:
+ *
+ *  @discussion Invoked when notifications of the bootloader characteristic are enabled
+ *
+ */
+- (void) peripheralSessionDidBecomeReady:(OTAPeripheralSession *)session;
+
+/*!
+ *  @method peripheralSession: didReceiveResponse:
+ *
+ *  @discussion Invoked for every notification of the bootloader characteristic
+ *
+ */
+- (void) peripheralSession:(OTAPeripheralSession *)session didReceiveResponse:(NSData *)response;
+
+/*!
+ *  @method peripheralSessionCanWrite:
+ *
+ *  @discussion Invoked when the peripheral can take writes again after writePacket: returned NO
+ *
+ */
+- (void) peripheralSessionCanWrite:(OTAPeripheralSession *)session;
+
+/*!
+ *  @method peripheralSession: didFailWithError:
+ *
+ *  @discussion Invoked when the bootloader service or characteristic cannot be used
+ *
+ */
+- (void) peripheralSession:(OTAPeripheralSession *)session didFailWithError:(NSError *)error;
+
+@end
+
+/*!
+ *  @class OTAPeripheralSession
+ *
+ *  @discussion Upgrade session of one peripheral in a multi-device upgrade: the peripheral, its bootloader
+ *  characteristic and the bootloader state machine with its own command queue and progress
+ *
+ */
+@interface OTAPeripheralSession : NSObject <CBPeripheralDelegate>
+
+/*!
+ *  @property peripheral
+ *
+ *  @discussion Peripheral being upgraded
+ *
+ */
+@property (nonatomic, readonly) CBPeripheral *peripheral;
+
+/*!
+ *  @property jobIndex
+ *
+ *  @discussion Index of the session in the scheduler
+ *
+ */
+@property (nonatomic) int jobIndex;
+
+/*!
+ *  @property session
+ *
+ *  @discussion Bootloader state machine of the peripheral
+ *
+ */
+@property (nonatomic, readonly) ota_session *session;
+
+/*!
+ *  @property progress
+ *
+ *  @discussion Fraction of the rows programmed and verified
+ *
+ */
+@property (nonatomic, readonly) float progress;
+
+@property (nonatomic, weak) id<OTAPeripheralSessionDelegate> delegate;
+
+/*!
+ *  @method initWithPeripheral: image:
+ *
+ *  @discussion Creates the session of the peripheral for the image. The image must outlive the session.
+ *
+ */
+- (instancetype) initWithPeripheral:(CBPeripheral *)peripheral image:(const ota_session_image *)image;
+
+/*!
+ *  @method prepare
+ *
+ *  @discussion Discovers the bootloader characteristic of the connected peripheral and enables its notifications
+ *
+ */
+- (void) prepare;
+
+/*!
+ *  @method writePacket: length:
+ *
+ *  @discussion Writes a command packet to the bootloader characteristic. Returns NO if the peripheral cannot take it now.
+ *
+ */
+- (BOOL) writePacket:(const uint8_t *)bytes length:(uint16_t)length;
+
+@end
@@ -0,0 +1,215 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import "OTAPeripheralSession.h"
+#import "Constants.h"
+
+#define SESSION_WRITE_WITH_RESP_MAX_DATA_SIZE   133
+#define SESSION_WRITE_NO_RESP_MAX_DATA_SIZE     300
+#define SESSION_SEND_DATA_WINDOW_SIZE           4
+#define SESSION_PACKET_OVERHEAD                 7
+
+/*!
+ *  @class OTAPeripheralSession
+ *
+ *  @discussion Class to run the bootloader protocol with a single peripheral of a multi-device upgrade
+ *
+ */
+@implementation OTAPeripheralSession
+{
+    const ota_session_image *_image;
+    ota_session _session;
+    CBCharacteristic *bootloaderCharacteristic;
+    BOOL isWriteWithoutResponseSupported;
+    NSUInteger writeLength;
+}
+
+- (instancetype) initWithPeripheral:(CBPeripheral *)peripheral image:(const ota_session_image *)image
+{
+    self = [super init];
+    if (self)
+    {
+        _peripheral = peripheral;
+        _image = image;
+        _jobIndex = -1;
+        ota_session_init(&_session, image, 1, SESSION_WRITE_WITH_RESP_MAX_DATA_SIZE);
+    }
+    return self;
+}
+
+- (ota_session *) session
+{
+    return &_session;
+}
+
+- (float) progress
+{
+    if (_image->row_count == 0)
+    {
+        return ota_session_finished(&_session) ? 1.0f : 0.0f;
+    }
+    return (float)_session.row_index / _image->row_count;
+}
+
+/*!
+ *  @method prepare
+ *
+ *  @discussion Discovers the bootloader characteristic of the connected peripheral and enables its notifications
+ *
+ */
+- (void) prepare
+{
+    _peripheral.delegate = self;
+    [_peripheral discoverServices:@[CUSTOM_BOOT_LOADER_SERVICE_UUID]];
+}
+
+/*!
+ *  @method writePacket: length:
+ *
+ *  @discussion Writes a command packet to the bootloader characteristic. Returns NO if the peripheral cannot take it now.
+ *
+ */
+- (BOOL) writePacket:(const uint8_t *)bytes length:(uint16_t)length
+{
+    if (bootloaderCharacteristic == nil)
+    {
+        return NO;
+    }
+    
+    if (!isWriteWithoutResponseSupported)
+    {
+        [_peripheral writeValue:[NSData dataWithBytes:bytes length:length] forCharacteristic:bootloaderCharacteristic type:CBCharacteristicWriteWithResponse];
+        return YES;
+    }
+    
+    if ([_peripheral respondsToSelector:@selector(canSendWriteWithoutResponse)] && !_peripheral.canSendWriteWithoutResponse)
+    {
+        return NO;
+    }
+    
+    // Write the packet in chunks of the negotiated MTU size
+    for (NSUInteger offset = 0; offset < length; offset += writeLength)
+    {
+        NSUInteger chunkLength = MIN(length - offset, writeLength);
+        [_peripheral writeValue:[NSData dataWithBytes:bytes + offset length:chunkLength] forCharacteristic:bootloaderCharacteristic type:CBCharacteristicWriteWithoutResponse];
+    }
+    return YES;
+}
+
+/*!
+ *  @method failWithError:
+ *
+ *  @discussion Reports that the bootloader characteristic cannot be used
+ *
+ */
+- (void) failWithError:(NSError *)error
+{
+    [self.delegate peripheralSession:self didFailWithError:error];
+}
+
+#pragma mark - CBPeripheralDelegate
+
+- (void) peripheral:(CBPeripheral *)peripheral didDiscoverServices:(NSError *)error
+{
+    for (CBService *service in peripheral.services)
+    {
+        if ([service.UUID isEqual:CUSTOM_BOOT_LOADER_SERVICE_UUID])
+        {
+            [peripheral discoverCharacteristics:@[BOOT_LOADER_CHARACTERISTIC_UUID] forService:service];
+            return;
+        }
+    }
+    [self failWithError:error];
+}
+
+- (void) peripheral:(CBPeripheral *)peripheral didDiscoverCharacteristicsForService:(CBService *)service error:(NSError *)error
+{
+    for (CBCharacteristic *characteristic in service.characteristics)
+    {
+        if ([characteristic.UUID isEqual:BOOT_LOADER_CHARACTERISTIC_UUID])
+        {
+            bootloaderCharacteristic = characteristic;
+            isWriteWithoutResponseSupported = (characteristic.properties & CBCharacteristicPropertyWriteWithoutResponse) != 0;
+            
+            uint32_t chunkSize = SESSION_WRITE_WITH_RESP_MAX_DATA_SIZE;
+            uint16_t window = 1;
+            if (isWriteWithoutResponseSupported)
+            {
+                writeLength = MAX([peripheral maximumWriteValueLengthForType:CBCharacteristicWriteWithoutResponse], (NSUInteger)1);
+                chunkSize = ota_transfer_chunk_size((uint32_t)writeLength, SESSION_PACKET_OVERHEAD, SESSION_WRITE_NO_RESP_MAX_DATA_SIZE);
+                if (chunkSize == 0)
+                {
+                    chunkSize = SESSION_WRITE_NO_RESP_MAX_DATA_SIZE;
+                }
+                window = SESSION_SEND_DATA_WINDOW_SIZE;
+            }
+            ota_session_init(&_session, _image, window, chunkSize);
+            
+            [peripheral setNotifyValue:YES forCharacteristic:characteristic];
+            return;
+        }
+    }
+    [self failWithError:error];
+}
+
+- (void) peripheral:(CBPeripheral *)peripheral didUpdateNotificationStateForCharacteristic:(CBCharacteristic *)characteristic error:(NSError *)error
+{
+    if (error != nil || !characteristic.isNotifying)
+    {
+        [self failWithError:error];
+        return;
+    }
+    [self.delegate peripheralSessionDidBecomeReady:self];
+}
+
+- (void) peripheral:(CBPeripheral *)peripheral didUpdateValueForCharacteristic:(CBCharacteristic *)characteristic error:(NSError *)error
+{
+    if (error == nil && characteristic == bootloaderCharacteristic)
+    {
+        [self.delegate peripheralSession:self didReceiveResponse:characteristic.value];
+    }
+}
+
+- (void) peripheral:(CBPeripheral *)peripheral didWriteValueForCharacteristic:(CBCharacteristic *)characteristic error:(NSError *)error
+{
+    if (error != nil)
+    {
+        [self failWithError:error];
+    }
+}
+
+- (void) peripheralIsReadyToSendWriteWithoutResponse:(CBPeripheral *)peripheral
+{
+    [self.delegate peripheralSessionCanWrite:self];
+}
+
+@end
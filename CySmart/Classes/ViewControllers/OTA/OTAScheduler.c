@@ -0,0 +1,257 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#include "OTAScheduler.h"
+
+#include <string.h>
+
+#define OTA_SCHEDULER_TOKEN_SCALE       1000000ULL
+
+// Burst allowance of the bandwidth limit, in milliseconds of traffic
+#define OTA_SCHEDULER_BURST_MS          50
+
+static void ota_scheduler_finish_job(ota_scheduler *scheduler, unsigned job)
+{
+    ota_scheduler_job *entry = &scheduler->jobs[job];
+    if (entry->state != OTA_JOB_ACTIVE && entry->state != OTA_JOB_CONNECTING)
+    {
+        return;
+    }
+    
+    entry->state = (entry->session->state == OTA_SESSION_DONE) ? OTA_JOB_DONE : OTA_JOB_FAILED;
+    scheduler->connections--;
+    if (scheduler->callbacks.finished)
+    {
+        scheduler->callbacks.finished(scheduler->context, job, entry->session);
+    }
+}
+
+static void ota_scheduler_refill(ota_scheduler *scheduler, uint64_t now_us)
+{
+    if (now_us > scheduler->last_refill_us)
+    {
+        uint64_t tokens = scheduler->tokens + (now_us - scheduler->last_refill_us) * scheduler->bytes_per_second;
+        scheduler->tokens = tokens < scheduler->bucket_size ? tokens : scheduler->bucket_size;
+    }
+    scheduler->last_refill_us = now_us;
+}
+
+/*!
+ *  @function ota_scheduler_connect_pending
+ *
+ *  @discussion Connects waiting devices in the order they were added while connection slots are free
+ *
+ */
+static void ota_scheduler_connect_pending(ota_scheduler *scheduler)
+{
+    for (unsigned job = 0; job < scheduler->job_count && scheduler->connections < scheduler->max_connections; job++)
+    {
+        if (scheduler->jobs[job].state == OTA_JOB_PENDING)
+        {
+            scheduler->jobs[job].state = OTA_JOB_CONNECTING;
+            scheduler->connections++;
+            scheduler->callbacks.connect(scheduler->context, job);
+        }
+    }
+}
+
+void ota_scheduler_init(ota_scheduler *scheduler, uint16_t max_connections, uint32_t bytes_per_second,
+                        const ota_scheduler_callbacks *callbacks, void *context)
+{
+    memset(scheduler, 0, sizeof(*scheduler));
+    scheduler->max_connections = max_connections > 0 ? max_connections : 1;
+    scheduler->bytes_per_second = bytes_per_second;
+    scheduler->callbacks = *callbacks;
+    scheduler->context = context;
+    
+    // The bucket always holds at least one packet of the largest size, or that packet would never pass
+    uint64_t burst = (uint64_t)bytes_per_second * OTA_SCHEDULER_BURST_MS / 1000;
+    if (burst < OTA_SESSION_MAX_PACKET)
+    {
+        burst = OTA_SESSION_MAX_PACKET;
+    }
+    scheduler->bucket_size = burst * OTA_SCHEDULER_TOKEN_SCALE;
+    scheduler->tokens = scheduler->bucket_size;
+}
+
+int ota_scheduler_add_job(ota_scheduler *scheduler, ota_session *session)
+{
+    if (scheduler->job_count == OTA_SCHEDULER_MAX_JOBS)
+    {
+        return -1;
+    }
+    
+    ota_scheduler_job *entry = &scheduler->jobs[scheduler->job_count];
+    entry->session = session;
+    entry->state = OTA_JOB_PENDING;
+    return scheduler->job_count++;
+}
+
+void ota_scheduler_on_connected(ota_scheduler *scheduler, unsigned job)
+{
+    if (job >= scheduler->job_count || scheduler->jobs[job].state != OTA_JOB_CONNECTING)
+    {
+        return;
+    }
+    
+    scheduler->jobs[job].state = OTA_JOB_ACTIVE;
+    ota_session_start(scheduler->jobs[job].session);
+}
+
+void ota_scheduler_on_response(ota_scheduler *scheduler, unsigned job, const uint8_t *bytes, uint32_t length)
+{
+    if (job >= scheduler->job_count || scheduler->jobs[job].state != OTA_JOB_ACTIVE)
+    {
+        return;
+    }
+    
+    ota_session_on_response(scheduler->jobs[job].session, bytes, length);
+    if (ota_session_finished(scheduler->jobs[job].session))
+    {
+        ota_scheduler_finish_job(scheduler, job);
+    }
+}
+
+void ota_scheduler_on_disconnected(ota_scheduler *scheduler, unsigned job)
+{
+    if (job >= scheduler->job_count)
+    {
+        return;
+    }
+    
+    ota_session_on_disconnect(scheduler->jobs[job].session);
+    ota_scheduler_finish_job(scheduler, job);
+}
+
+uint64_t ota_scheduler_poll(ota_scheduler *scheduler, uint64_t now_us)
+{
+    ota_scheduler_connect_pending(scheduler);
+    
+    if (scheduler->bytes_per_second > 0)
+    {
+        ota_scheduler_refill(scheduler, now_us);
+    }
+    
+    // Serve the connected sessions in turns of one packet until nothing more can be written
+    uint64_t wait_tokens = 0;
+    int progress = 1;
+    while (progress)
+    {
+        progress = 0;
+        for (unsigned turn = 0; turn < scheduler->job_count; turn++)
+        {
+            unsigned job = (scheduler->next_job + turn) % scheduler->job_count;
+            ota_scheduler_job *entry = &scheduler->jobs[job];
+            if (entry->state != OTA_JOB_ACTIVE)
+            {
+                continue;
+            }
+            
+            const ota_session_packet *packet = ota_session_next_packet(entry->session);
+            if (packet == NULL)
+            {
+                continue;
+            }
+            
+            uint64_t cost = packet->length * OTA_SCHEDULER_TOKEN_SCALE;
+            if (scheduler->bytes_per_second > 0 && scheduler->tokens < cost)
+            {
+                if (wait_tokens == 0 || cost - scheduler->tokens < wait_tokens)
+                {
+                    wait_tokens = cost - scheduler->tokens;
+                }
+                continue;
+            }
+            
+            if (!scheduler->callbacks.write(scheduler->context, job, packet->bytes, packet->length))
+            {
+                continue;
+            }
+            
+            if (scheduler->bytes_per_second > 0)
+            {
+                scheduler->tokens -= cost;
+            }
+            scheduler->bytes_sent += packet->length;
+            ota_session_packet_sent(entry->session);
+            if (ota_session_finished(entry->session))
+            {
+                ota_scheduler_finish_job(scheduler, job);
+            }
+            progress = 1;
+        }
+        scheduler->next_job = scheduler->job_count ? (scheduler->next_job + 1) % scheduler->job_count : 0;
+    }
+    
+    // Sessions which sent EXIT_BOOTLOADER freed their slots
+    ota_scheduler_connect_pending(scheduler);
+    
+    if (wait_tokens == 0)
+    {
+        return OTA_SCHEDULER_WAIT_EVENT;
+    }
+    return (wait_tokens + scheduler->bytes_per_second - 1) / scheduler->bytes_per_second;
+}
+
+void ota_scheduler_cancel(ota_scheduler *scheduler)
+{
+    for (unsigned job = 0; job < scheduler->job_count; job++)
+    {
+        ota_scheduler_job *entry = &scheduler->jobs[job];
+        ota_session_on_disconnect(entry->session);
+        if (entry->state == OTA_JOB_PENDING)
+        {
+            entry->state = OTA_JOB_FAILED;
+            if (scheduler->callbacks.finished)
+            {
+                scheduler->callbacks.finished(scheduler->context, job, entry->session);
+            }
+        }
+        else
+        {
+            ota_scheduler_finish_job(scheduler, job);
+        }
+    }
+}
+
+unsigned ota_scheduler_unfinished_jobs(const ota_scheduler *scheduler)
+{
+    unsigned count = 0;
+    for (unsigned job = 0; job < scheduler->job_count; job++)
+    {
+        if (scheduler->jobs[job].state != OTA_JOB_DONE && scheduler->jobs[job].state != OTA_JOB_FAILED)
+        {
+            count++;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#ifndef OTAScheduler_h
+#define OTAScheduler_h
+
+#include <stdint.h>
+#include "OTASession.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ *  @discussion Maximum number of devices a scheduler upgrades in one run
+ *
+ */
+#define OTA_SCHEDULER_MAX_JOBS      64
+
+/*!
+ *  @discussion Returned by ota_scheduler_poll when only a connection or a response can make progress
+ *
+ */
+#define OTA_SCHEDULER_WAIT_EVENT    UINT64_MAX
+
+typedef enum
+{
+    OTA_JOB_PENDING = 0,            // Waiting for a free connection slot
+    OTA_JOB_CONNECTING,             // Connection requested
+    OTA_JOB_ACTIVE,                 // Connected, session running
+    OTA_JOB_DONE,
+    OTA_JOB_FAILED
+} ota_job_state;
+
+/*!
+ *  @struct ota_scheduler_callbacks
+ *
+ *  @discussion Link operations of the scheduler. job is the index returned by ota_scheduler_add_job.
+ *
+ *  connect requests a connection; the link calls ota_scheduler_on_connected or ota_scheduler_on_disconnected later.
+ *  write writes a command packet to the bootloader characteristic and returns 0 if the link cannot take it now.
+ *  finished reports the end of the session; the link disconnects the device.
+ *
+ */
+typedef struct
+{
+    void (*connect)(void *context, unsigned job);
+    int (*write)(void *context, unsigned job, const uint8_t *bytes, uint16_t length);
+    void (*finished)(void *context, unsigned job, const ota_session *session);
+} ota_scheduler_callbacks;
+
+typedef struct
+{
+    ota_session *session;
+    ota_job_state state;
+} ota_scheduler_job;
+
+/*!
+ *  @struct ota_scheduler
+ *
+ *  @discussion Runs the sessions of several devices at once. At most max_connections devices are connected or
+ *  connecting at a time; the others wait in the order they were added. The packets of all sessions share a token
+ *  bucket of bytes_per_second, so the on-air bandwidth stays within the limit however many devices are active.
+ *  Connected sessions take turns, one packet each, so a device with a deep window cannot starve the others.
+ *
+ *  The scheduler does no I/O and keeps no clock. The caller passes the time to ota_scheduler_poll and calls it again
+ *  after every link event or after the delay it returns.
+ *
+ */
+typedef struct
+{
+    ota_scheduler_job jobs[OTA_SCHEDULER_MAX_JOBS];
+    uint16_t job_count;
+    uint16_t max_connections;
+    uint16_t connections;
+    uint16_t next_job;                  // Job served first in the next round
+    uint32_t bytes_per_second;          // 0 for no limit
+    uint64_t tokens;                    // Bucket level in bytes scaled by 1000000
+    uint64_t bucket_size;
+    uint64_t last_refill_us;
+    uint64_t bytes_sent;
+    ota_scheduler_callbacks callbacks;
+    void *context;
+} ota_scheduler;
+
+/*!
+ *  @function ota_scheduler_init
+ *
+ *  @discussion Initializes the scheduler. max_connections is at least 1, bytes_per_second 0 disables the bandwidth limit.
+ *
+ */
+void ota_scheduler_init(ota_scheduler *scheduler, uint16_t max_connections, uint32_t bytes_per_second,
+                        const ota_scheduler_callbacks *callbacks, void *context);
+
+/*!
+ *  @function ota_scheduler_add_job
+ *
+ *  @discussion Adds the initialized session of a device. Returns the job index, -1 if the scheduler is full.
+ *
+ */
+int ota_scheduler_add_job(ota_scheduler *scheduler, ota_session *session);
+
+/*!
+ *  @function ota_scheduler_on_connected
+ *
+ *  @discussion Starts the session of the job once its bootloader characteristic notifies
+ *
+ */
+void ota_scheduler_on_connected(ota_scheduler *scheduler, unsigned job);
+
+/*!
+ *  @function ota_scheduler_on_response
+ *
+ *  @discussion Passes a notification of the bootloader characteristic to the session of the job
+ *
+ */
+void ota_scheduler_on_response(ota_scheduler *scheduler, unsigned job, const uint8_t *bytes, uint32_t length);
+
+/*!
+ *  @function ota_scheduler_on_disconnected
+ *
+ *  @discussion Frees the connection slot of the job, failing the session if it did not complete
+ *
+ */
+void ota_scheduler_on_disconnected(ota_scheduler *scheduler, unsigned job);
+
+/*!
+ *  @function ota_scheduler_poll
+ *
+ *  @discussion Connects waiting devices while slots are free and writes queued packets while the bandwidth allows.
+ *  Returns the delay in microseconds after which the bandwidth limit lets the next packet through, or
+ *  OTA_SCHEDULER_WAIT_EVENT.
+ *
+ */
+uint64_t ota_scheduler_poll(ota_scheduler *scheduler, uint64_t now_us);
+
+/*!
+ *  @function ota_scheduler_cancel
+ *
+ *  @discussion Fails every job not yet finished. The finished callback is invoked for each of them.
+ *
+ */
+void ota_scheduler_cancel(ota_scheduler *scheduler);
+
+/*!
+ *  @function ota_scheduler_unfinished_jobs
+ *
+ *  @discussion Returns the number of jobs neither done nor failed
+ *
+ */
+unsigned ota_scheduler_unfinished_jobs(const ota_scheduler *scheduler);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OTAScheduler_h */
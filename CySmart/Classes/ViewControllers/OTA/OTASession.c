@@ -0,0 +1,372 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#include "OTASession.h"
+
+#include <string.h>
+
+#define OTA_SESSION_START_BYTE          0x01
+#define OTA_SESSION_END_BYTE            0x17
+#define OTA_SESSION_PACKET_OVERHEAD     7
+#define OTA_SESSION_PACKET_HEADER       4
+
+#define OTA_SESSION_STATUS_SUCCESS      0x00
+
+#define OTA_SESSION_VERIFY_CHECKSUM     0x31
+#define OTA_SESSION_GET_FLASH_SIZE      0x32
+#define OTA_SESSION_SEND_DATA           0x37
+#define OTA_SESSION_ENTER_BOOTLOADER    0x38
+#define OTA_SESSION_PROGRAM_ROW         0x39
+#define OTA_SESSION_VERIFY_ROW          0x3A
+#define OTA_SESSION_EXIT_BOOTLOADER     0x3B
+
+static void ota_session_fail(ota_session *session, ota_session_error error)
+{
+    session->state = OTA_SESSION_FAILED;
+    session->error = error;
+    session->queue_count = 0;
+}
+
+/*!
+ *  @function ota_session_queue_packet
+ *
+ *  @discussion Frames the command with the payload given as header and data parts and appends it to the command queue
+ *
+ */
+static void ota_session_queue_packet(ota_session *session, uint8_t command,
+                                     const uint8_t *header, uint16_t header_length,
+                                     const uint8_t *data, uint32_t data_length)
+{
+    if (session->queue_count == OTA_SESSION_QUEUE_LENGTH)
+    {
+        ota_session_fail(session, OTA_SESSION_ERR_PROTOCOL);
+        return;
+    }
+    
+    ota_session_packet *packet = &session->queue[(session->queue_head + session->queue_count) % OTA_SESSION_QUEUE_LENGTH];
+    uint16_t payload_length = (uint16_t)(header_length + data_length);
+    uint8_t *bytes = packet->bytes;
+    
+    bytes[0] = OTA_SESSION_START_BYTE;
+    bytes[1] = command;
+    bytes[2] = (uint8_t)payload_length;
+    bytes[3] = (uint8_t)(payload_length >> 8);
+    if (header_length > 0)
+    {
+        memcpy(bytes + OTA_SESSION_PACKET_HEADER, header, header_length);
+    }
+    if (data_length > 0)
+    {
+        memcpy(bytes + OTA_SESSION_PACKET_HEADER + header_length, data, data_length);
+    }
+    
+    uint16_t index = OTA_SESSION_PACKET_HEADER + payload_length;
+    uint16_t checksum = cy_packet_checksum(session->image->checksum_type, bytes, index);
+    bytes[index++] = (uint8_t)checksum;
+    bytes[index++] = (uint8_t)(checksum >> 8);
+    bytes[index++] = OTA_SESSION_END_BYTE;
+    
+    packet->command = command;
+    packet->length = index;
+    session->queue_count++;
+}
+
+/*!
+ *  @function ota_session_send_row_packets
+ *
+ *  @discussion Queues every SEND_DATA/PROGRAM_ROW packet the transfer engine allows before a response is needed
+ *
+ */
+static void ota_session_send_row_packets(ota_session *session)
+{
+    const ota_session_row *row = &session->image->rows[session->row_index];
+    ota_transfer_packet packet;
+    
+    while (session->state == OTA_SESSION_PROGRAMMING && ota_transfer_next_packet(&session->transfer, &packet))
+    {
+        if (packet.command == OTA_SESSION_SEND_DATA)
+        {
+            ota_session_queue_packet(session, OTA_SESSION_SEND_DATA, NULL, 0, row->data + packet.offset, packet.length);
+        }
+        else
+        {
+            uint8_t header[3] = { row->array_id, (uint8_t)row->row_number, (uint8_t)(row->row_number >> 8) };
+            ota_session_queue_packet(session, OTA_SESSION_PROGRAM_ROW, header, sizeof(header), row->data + packet.offset, packet.length);
+        }
+    }
+}
+
+/*!
+ *  @function ota_session_program_row
+ *
+ *  @discussion Starts programming the current row, fetching the flash size first when the row is in another array
+ *
+ */
+static void ota_session_program_row(ota_session *session)
+{
+    const ota_session_row *row = &session->image->rows[session->row_index];
+    
+    if ((int32_t)row->array_id != session->flash_array_id)
+    {
+        session->flash_array_id = row->array_id;
+        ota_session_queue_packet(session, OTA_SESSION_GET_FLASH_SIZE, &row->array_id, 1, NULL, 0);
+        return;
+    }
+    
+    if (row->row_number < session->first_row || row->row_number > session->last_row)
+    {
+        ota_session_fail(session, OTA_SESSION_ERR_ROW_BOUNDS);
+        return;
+    }
+    
+    ota_transfer_begin_row(&session->transfer, row->length, session->chunk_size);
+    ota_session_send_row_packets(session);
+}
+
+static void ota_session_verify_app(ota_session *session)
+{
+    session->state = OTA_SESSION_VERIFYING_APP;
+    ota_session_queue_packet(session, OTA_SESSION_VERIFY_CHECKSUM, NULL, 0, NULL, 0);
+}
+
+/*!
+ *  @function ota_session_next_row
+ *
+ *  @discussion Moves to the next row, or verifies the application after the last one
+ *
+ */
+static void ota_session_next_row(ota_session *session)
+{
+    session->row_index++;
+    if (session->row_index < session->image->row_count)
+    {
+        ota_session_program_row(session);
+    }
+    else
+    {
+        ota_session_verify_app(session);
+    }
+}
+
+void ota_session_init(ota_session *session, const ota_session_image *image, uint16_t window, uint32_t chunk_size)
+{
+    memset(session, 0, sizeof(*session));
+    session->image = image;
+    session->flash_array_id = -1;
+    session->chunk_size = (chunk_size == 0 || chunk_size > OTA_SESSION_MAX_CHUNK) ? OTA_SESSION_MAX_CHUNK : chunk_size;
+    ota_transfer_init(&session->transfer, OTA_SESSION_SEND_DATA, OTA_SESSION_PROGRAM_ROW, window);
+}
+
+void ota_session_start(ota_session *session)
+{
+    if (session->state != OTA_SESSION_IDLE)
+    {
+        return;
+    }
+    
+    session->state = OTA_SESSION_ENTERING;
+    ota_session_queue_packet(session, OTA_SESSION_ENTER_BOOTLOADER, session->image->security_key, session->image->security_key_length, NULL, 0);
+}
+
+const ota_session_packet *ota_session_next_packet(const ota_session *session)
+{
+    if (session->queue_count == 0)
+    {
+        return NULL;
+    }
+    return &session->queue[session->queue_head];
+}
+
+void ota_session_packet_sent(ota_session *session)
+{
+    if (session->queue_count == 0)
+    {
+        return;
+    }
+    
+    uint8_t command = session->queue[session->queue_head].command;
+    session->queue_head = (session->queue_head + 1) % OTA_SESSION_QUEUE_LENGTH;
+    session->queue_count--;
+    session->commands_sent++;
+    
+    if (command == OTA_SESSION_EXIT_BOOTLOADER)
+    {
+        // The bootloader launches the application without responding
+        session->state = OTA_SESSION_DONE;
+        return;
+    }
+    session->awaiting[(session->awaiting_head + session->awaiting_count) % OTA_SESSION_QUEUE_LENGTH] = command;
+    session->awaiting_count++;
+}
+
+ota_session_state ota_session_on_response(ota_session *session, const uint8_t *bytes, uint32_t length)
+{
+    if (ota_session_finished(session))
+    {
+        return session->state;
+    }
+    
+    // Responses are matched against the commands in the order they were written
+    if (session->awaiting_count == 0 || length < OTA_SESSION_PACKET_OVERHEAD || bytes[0] != OTA_SESSION_START_BYTE)
+    {
+        ota_session_fail(session, OTA_SESSION_ERR_PROTOCOL);
+        return session->state;
+    }
+    uint32_t data_length = bytes[2] | ((uint32_t)bytes[3] << 8);
+    if (length < OTA_SESSION_PACKET_OVERHEAD + data_length)
+    {
+        ota_session_fail(session, OTA_SESSION_ERR_PROTOCOL);
+        return session->state;
+    }
+    
+    uint8_t command = session->awaiting[session->awaiting_head];
+    session->awaiting_head = (session->awaiting_head + 1) % OTA_SESSION_QUEUE_LENGTH;
+    session->awaiting_count--;
+    session->responses_received++;
+    
+    uint8_t status = bytes[1];
+    const uint8_t *data = bytes + OTA_SESSION_PACKET_HEADER;
+    
+    if (command == OTA_SESSION_SEND_DATA || command == OTA_SESSION_PROGRAM_ROW)
+    {
+        switch (ota_transfer_on_response(&session->transfer, command, status))
+        {
+            case OTA_TRANSFER_CONTINUE:
+                ota_session_send_row_packets(session);
+                break;
+            case OTA_TRANSFER_ROW_DONE:
+            {
+                const ota_session_row *row = &session->image->rows[session->row_index];
+                uint8_t header[3] = { row->array_id, (uint8_t)row->row_number, (uint8_t)(row->row_number >> 8) };
+                ota_session_queue_packet(session, OTA_SESSION_VERIFY_ROW, header, sizeof(header), NULL, 0);
+                break;
+            }
+            case OTA_TRANSFER_FAILED:
+                session->device_status = status;
+                ota_session_fail(session, OTA_SESSION_ERR_STATUS);
+                break;
+            default:
+                ota_session_fail(session, OTA_SESSION_ERR_PROTOCOL);
+                break;
+        }
+        return session->state;
+    }
+    
+    if (status != OTA_SESSION_STATUS_SUCCESS)
+    {
+        session->device_status = status;
+        ota_session_fail(session, OTA_SESSION_ERR_STATUS);
+        return session->state;
+    }
+    
+    switch (command)
+    {
+        case OTA_SESSION_ENTER_BOOTLOADER:
+        {
+            if (data_length < 5)
+            {
+                ota_session_fail(session, OTA_SESSION_ERR_PROTOCOL);
+                break;
+            }
+            uint32_t silicon_id = data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+            if (silicon_id != session->image->silicon_id || data[4] != session->image->silicon_rev)
+            {
+                ota_session_fail(session, OTA_SESSION_ERR_SILICON);
+                break;
+            }
+            if (session->image->row_count == 0)
+            {
+                ota_session_verify_app(session);
+                break;
+            }
+            session->state = OTA_SESSION_PROGRAMMING;
+            ota_session_program_row(session);
+            break;
+        }
+        case OTA_SESSION_GET_FLASH_SIZE:
+            if (data_length < 4)
+            {
+                ota_session_fail(session, OTA_SESSION_ERR_PROTOCOL);
+                break;
+            }
+            session->first_row = data[0] | (uint16_t)(data[1] << 8);
+            session->last_row = data[2] | (uint16_t)(data[3] << 8);
+            ota_session_program_row(session);
+            break;
+        case OTA_SESSION_VERIFY_ROW:
+            if (data_length < 1)
+            {
+                ota_session_fail(session, OTA_SESSION_ERR_PROTOCOL);
+            }
+            else if (data[0] != session->image->rows[session->row_index].verify_checksum)
+            {
+                ota_session_fail(session, OTA_SESSION_ERR_ROW_CHECKSUM);
+            }
+            else
+            {
+                ota_session_next_row(session);
+            }
+            break;
+        case OTA_SESSION_VERIFY_CHECKSUM:
+            if (data_length < 1)
+            {
+                ota_session_fail(session, OTA_SESSION_ERR_PROTOCOL);
+            }
+            else if (data[0] == 0)
+            {
+                ota_session_fail(session, OTA_SESSION_ERR_APP_INVALID);
+            }
+            else
+            {
+                session->state = OTA_SESSION_EXITING;
+                ota_session_queue_packet(session, OTA_SESSION_EXIT_BOOTLOADER, NULL, 0, NULL, 0);
+            }
+            break;
+        default:
+            ota_session_fail(session, OTA_SESSION_ERR_PROTOCOL);
+            break;
+    }
+    return session->state;
+}
+
+void ota_session_on_disconnect(ota_session *session)
+{
+    if (!ota_session_finished(session))
+    {
+        ota_session_fail(session, OTA_SESSION_ERR_DISCONNECTED);
+    }
+}
+
+int ota_session_finished(const ota_session *session)
+{
+    return session->state == OTA_SESSION_DONE || session->state == OTA_SESSION_FAILED;
+}
@@ -0,0 +1,220 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#ifndef OTASession_h
+#define OTASession_h
+
+#include <stdint.h>
+#include "OTATransferEngine.h"
+#include "CyChecksum.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ *  @discussion Largest SEND_DATA payload a session sends
+ *
+ */
+#define OTA_SESSION_MAX_CHUNK           512
+
+/*!
+ *  @discussion Largest command packet: PROGRAM_ROW with array ID and row number plus the packet framing
+ *
+ */
+#define OTA_SESSION_MAX_PACKET          (OTA_SESSION_MAX_CHUNK + 3 + 7)
+
+#define OTA_SESSION_QUEUE_LENGTH        (OTA_TRANSFER_MAX_WINDOW + 1)
+
+typedef enum
+{
+    OTA_SESSION_IDLE = 0,
+    OTA_SESSION_ENTERING,           // ENTER_BOOTLOADER sent
+    OTA_SESSION_PROGRAMMING,        // Rows are sent, programmed and verified
+    OTA_SESSION_VERIFYING_APP,      // VERIFY_CHECKSUM sent
+    OTA_SESSION_EXITING,            // EXIT_BOOTLOADER queued
+    OTA_SESSION_DONE,
+    OTA_SESSION_FAILED
+} ota_session_state;
+
+typedef enum
+{
+    OTA_SESSION_OK = 0,
+    OTA_SESSION_ERR_STATUS,         // Device rejected a command, see device_status
+    OTA_SESSION_ERR_SILICON,        // Silicon ID or revision of the device does not match the image
+    OTA_SESSION_ERR_ROW_BOUNDS,     // Row number is outside the flash array reported by the device
+    OTA_SESSION_ERR_ROW_CHECKSUM,   // VERIFY_ROW checksum does not match the image
+    OTA_SESSION_ERR_APP_INVALID,    // Device reported the application checksum as invalid
+    OTA_SESSION_ERR_PROTOCOL,       // Malformed or unexpected response
+    OTA_SESSION_ERR_DISCONNECTED    // Link dropped before the upgrade completed
+} ota_session_error;
+
+/*!
+ *  @struct ota_session_row
+ *
+ *  @discussion Row of a CYACD image. verify_checksum is the checksum expected in the VERIFY_ROW response.
+ *
+ */
+typedef struct
+{
+    uint8_t array_id;
+    uint16_t row_number;
+    uint16_t length;
+    uint8_t verify_checksum;
+    const uint8_t *data;
+} ota_session_row;
+
+/*!
+ *  @struct ota_session_image
+ *
+ *  @discussion CYACD image shared by the sessions flashing it. The rows must outlive the sessions.
+ *
+ */
+typedef struct
+{
+    const ota_session_row *rows;
+    uint32_t row_count;
+    uint32_t silicon_id;
+    uint8_t silicon_rev;
+    cy_checksum_type checksum_type;
+    const uint8_t *security_key;    // Sent with ENTER_BOOTLOADER when security_key_length is non-zero
+    uint8_t security_key_length;
+} ota_session_image;
+
+/*!
+ *  @struct ota_session_packet
+ *
+ *  @discussion Command packet waiting in the command queue of the session
+ *
+ */
+typedef struct
+{
+    uint8_t command;
+    uint16_t length;
+    uint8_t bytes[OTA_SESSION_MAX_PACKET];
+} ota_session_packet;
+
+/*!
+ *  @struct ota_session
+ *
+ *  @discussion Host side bootloader state machine of a single device for CYACD images. The session queues the
+ *  command packets to be written to the bootloader characteristic and consumes the notifications. Row data goes
+ *  through an ota_transfer engine, so each session keeps its own SEND_DATA window.
+ *
+ *  The session does no I/O. The caller writes the queued packets and feeds the responses back, which lets a scheduler
+ *  run any number of sessions side by side.
+ *
+ */
+typedef struct
+{
+    const ota_session_image *image;
+    ota_session_state state;
+    ota_session_error error;
+    uint8_t device_status;              // Status code of the rejected command for OTA_SESSION_ERR_STATUS
+    ota_transfer transfer;
+    uint32_t chunk_size;
+    uint32_t row_index;                 // Index of the row being programmed, equals the rows done
+    int32_t flash_array_id;             // Array of the last GET_FLASH_SIZE, -1 before the first
+    uint16_t first_row;
+    uint16_t last_row;
+    ota_session_packet queue[OTA_SESSION_QUEUE_LENGTH];
+    uint16_t queue_head;
+    uint16_t queue_count;
+    uint8_t awaiting[OTA_SESSION_QUEUE_LENGTH];  // Commands written and awaiting response, oldest first
+    uint16_t awaiting_head;
+    uint16_t awaiting_count;
+    uint32_t commands_sent;
+    uint32_t responses_received;
+} ota_session;
+
+/*!
+ *  @function ota_session_init
+ *
+ *  @discussion Initializes the session for the image. window is the number of SEND_DATA commands sent ahead of their
+ *  responses, chunk_size the SEND_DATA payload size clamped to OTA_SESSION_MAX_CHUNK.
+ *
+ */
+void ota_session_init(ota_session *session, const ota_session_image *image, uint16_t window, uint32_t chunk_size);
+
+/*!
+ *  @function ota_session_start
+ *
+ *  @discussion Queues ENTER_BOOTLOADER. Call once the bootloader characteristic notifies.
+ *
+ */
+void ota_session_start(ota_session *session);
+
+/*!
+ *  @function ota_session_next_packet
+ *
+ *  @discussion Returns the oldest queued command packet, NULL if the session waits for responses
+ *
+ */
+const ota_session_packet *ota_session_next_packet(const ota_session *session);
+
+/*!
+ *  @function ota_session_packet_sent
+ *
+ *  @discussion Removes the packet returned by ota_session_next_packet from the queue once it is written
+ *
+ */
+void ota_session_packet_sent(ota_session *session);
+
+/*!
+ *  @function ota_session_on_response
+ *
+ *  @discussion Handles a response packet of the bootloader. Returns the session state after the response.
+ *
+ */
+ota_session_state ota_session_on_response(ota_session *session, const uint8_t *bytes, uint32_t length);
+
+/*!
+ *  @function ota_session_on_disconnect
+ *
+ *  @discussion Fails the session if the link dropped before the upgrade completed
+ *
+ */
+void ota_session_on_disconnect(ota_session *session);
+
+/*!
+ *  @function ota_session_finished
+ *
+ *  @discussion Returns 1 if the session is done or failed
+ *
+ */
+int ota_session_finished(const ota_session *session);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OTASession_h */
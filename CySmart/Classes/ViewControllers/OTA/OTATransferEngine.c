@@ -0,0 +1,196 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#include "OTATransferEngine.h"
+
+#include <string.h>
+
+#define OTA_TRANSFER_STATUS_SUCCESS     0x00
+
+static void ota_transfer_restart_row(ota_transfer *transfer)
+{
+    transfer->next_offset = 0;
+    transfer->program_sent = 0;
+    transfer->draining = 0;
+    transfer->restarts++;
+}
+
+uint32_t ota_transfer_chunk_size(uint32_t write_length, uint32_t packet_overhead, uint32_t max_payload)
+{
+    if (write_length == 0)
+    {
+        return max_payload;
+    }
+    
+    // Widened so that neither the packet length nor the length of the writes can wrap
+    uint64_t packet_length = (uint64_t)max_payload + packet_overhead;
+    uint64_t writes_length = packet_length / write_length * write_length;
+    if (writes_length == 0)
+    {
+        return max_payload;
+    }
+    if (writes_length <= packet_overhead)
+    {
+        return 0;
+    }
+    return (uint32_t)(writes_length - packet_overhead);
+}
+
+void ota_transfer_init(ota_transfer *transfer, uint8_t send_command, uint8_t program_command, uint16_t window)
+{
+    memset(transfer, 0, sizeof(*transfer));
+    transfer->send_command = send_command;
+    transfer->program_command = program_command;
+    if (window < 1)
+    {
+        window = 1;
+    }
+    else if (window > OTA_TRANSFER_MAX_WINDOW)
+    {
+        window = OTA_TRANSFER_MAX_WINDOW;
+    }
+    transfer->window = window;
+}
+
+void ota_transfer_begin_row(ota_transfer *transfer, uint32_t row_length, uint32_t chunk_size)
+{
+    transfer->row_length = row_length;
+    transfer->chunk_size = chunk_size > 0 ? chunk_size : 1;
+    transfer->next_offset = 0;
+    transfer->program_sent = 0;
+    transfer->draining = 0;
+    transfer->stale_data = 0;
+    transfer->last_error = OTA_TRANSFER_STATUS_SUCCESS;
+    transfer->head = 0;
+    transfer->count = 0;
+}
+
+int ota_transfer_next_packet(ota_transfer *transfer, ota_transfer_packet *packet)
+{
+    if (transfer->draining || transfer->program_sent || transfer->count >= transfer->window)
+    {
+        return 0;
+    }
+    
+    uint32_t remaining = transfer->row_length - transfer->next_offset;
+    if (remaining > transfer->chunk_size)
+    {
+        packet->command = transfer->send_command;
+        packet->length = transfer->chunk_size;
+    }
+    else if (transfer->count == 0)
+    {
+        // Last piece of the row goes with the program command once all chunks are acknowledged
+        packet->command = transfer->program_command;
+        packet->length = remaining;
+        transfer->program_sent = 1;
+    }
+    else
+    {
+        return 0;
+    }
+    packet->offset = transfer->next_offset;
+    transfer->next_offset += packet->length;
+    
+    transfer->in_flight[(transfer->head + transfer->count) % OTA_TRANSFER_MAX_WINDOW] = *packet;
+    transfer->count++;
+    return 1;
+}
+
+ota_transfer_result ota_transfer_on_response(ota_transfer *transfer, uint8_t command, uint8_t status)
+{
+    if (transfer->count == 0 || transfer->in_flight[transfer->head].command != command)
+    {
+        return OTA_TRANSFER_UNEXPECTED;
+    }
+    transfer->head = (uint16_t)((transfer->head + 1) % OTA_TRANSFER_MAX_WINDOW);
+    transfer->count--;
+    
+    if (transfer->draining)
+    {
+        // Data accepted after the rejected command stays in the buffer of the target
+        if (status == OTA_TRANSFER_STATUS_SUCCESS && command == transfer->send_command)
+        {
+            transfer->stale_data = 1;
+        }
+        if (transfer->count == 0)
+        {
+            ota_transfer_restart_row(transfer);
+        }
+        return OTA_TRANSFER_CONTINUE;
+    }
+    
+    if (status != OTA_TRANSFER_STATUS_SUCCESS)
+    {
+        transfer->last_error = status;
+        if (transfer->stale_data)
+        {
+            // The target dropped the stale bytes with this rejection, the row can now be sent cleanly
+            transfer->stale_data = 0;
+            if (transfer->count > 0)
+            {
+                transfer->draining = 1;
+            }
+            else
+            {
+                ota_transfer_restart_row(transfer);
+            }
+            return OTA_TRANSFER_CONTINUE;
+        }
+        if (transfer->window > 1)
+        {
+            // Fall back to stop-and-wait and send the row again
+            transfer->window = 1;
+            if (transfer->count > 0)
+            {
+                transfer->draining = 1;
+            }
+            else
+            {
+                ota_transfer_restart_row(transfer);
+            }
+            return OTA_TRANSFER_CONTINUE;
+        }
+        return OTA_TRANSFER_FAILED;
+    }
+    
+    if (command == transfer->program_command)
+    {
+        return OTA_TRANSFER_ROW_DONE;
+    }
+    return OTA_TRANSFER_CONTINUE;
+}
+
+uint16_t ota_transfer_in_flight(const ota_transfer *transfer)
+{
+    return transfer->count;
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#ifndef OTATransferEngine_h
+#define OTATransferEngine_h
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ *  @discussion Maximum number of row data commands that can be awaiting response at the same time
+ *
+ */
+#define OTA_TRANSFER_MAX_WINDOW     16
+
+typedef enum
+{
+    OTA_TRANSFER_CONTINUE = 0,      // Call ota_transfer_next_packet for more packets to send
+    OTA_TRANSFER_ROW_DONE,          // Program command of the row succeeded
+    OTA_TRANSFER_FAILED,            // Target rejected a command in stop-and-wait mode
+    OTA_TRANSFER_UNEXPECTED         // Response does not match the oldest command awaiting response
+} ota_transfer_result;
+
+/*!
+ *  @struct ota_transfer_packet
+ *
+ *  @discussion Command to be sent for the row. offset and length give the slice of the row data it carries.
+ *
+ */
+typedef struct
+{
+    uint8_t command;
+    uint32_t offset;
+    uint32_t length;
+} ota_transfer_packet;
+
+/*!
+ *  @struct ota_transfer
+ *
+ *  @discussion Transfer state of a single row. The row is sent as a sequence of SEND_DATA commands followed by the
+ *  program command. Up to window SEND_DATA commands are sent without waiting for their responses. The program
+ *  command is held back until every SEND_DATA of the row is acknowledged, so that a rejected chunk never gets
+ *  programmed. Responses are matched against the commands in the order they were sent.
+ *
+ *  When the target rejects a command while more than one is allowed in flight, the window drops to one for the rest
+ *  of the session, the outstanding responses are drained and the row is sent again from the start. The bootloader
+ *  discards the data buffered for the row when it rejects a command, so the row cannot be resumed from the middle.
+ *  Commands already in flight behind the rejected one may still be accepted and buffered; the restarted row then
+ *  fails its length check on the target, which drops the buffer again, so one more restart is allowed in that case.
+ *
+ *  The engine does no I/O. The caller sends the packets and feeds the responses back.
+ *
+ */
+typedef struct
+{
+    uint8_t send_command;           // SEND_DATA
+    uint8_t program_command;        // PROGRAM_ROW (CYACD) or PROGRAM_DATA (CYACD2)
+    uint16_t window;
+    uint32_t row_length;
+    uint32_t chunk_size;
+    uint32_t next_offset;           // Offset of the row data to be sent next
+    uint8_t program_sent;
+    uint8_t draining;               // Waiting for outstanding responses before the row is sent again
+    uint8_t stale_data;             // Target accepted data while draining, so the restarted row follows stale bytes
+    uint8_t last_error;
+    uint16_t head;
+    uint16_t count;
+    ota_transfer_packet in_flight[OTA_TRANSFER_MAX_WINDOW];
+    uint32_t restarts;              // Rows sent again after a rejected command
+} ota_transfer;
+
+/*!
+ *  @function ota_transfer_chunk_size
+ *
+ *  @discussion Returns the largest SEND_DATA payload not exceeding max_payload for which the command packet, payload
+ *  plus packet_overhead bytes, fills whole writes of write_length bytes. Returns max_payload when a single write
+ *  holds the largest packet, and 0 when no such payload exists because the overhead alone fills the writes.
+ *
+ */
+uint32_t ota_transfer_chunk_size(uint32_t write_length, uint32_t packet_overhead, uint32_t max_payload);
+
+/*!
+ *  @function ota_transfer_init
+ *
+ *  @discussion Initializes the engine for a session. window is clamped to 1...OTA_TRANSFER_MAX_WINDOW, 1 gives stop-and-wait.
+ *
+ */
+void ota_transfer_init(ota_transfer *transfer, uint8_t send_command, uint8_t program_command, uint16_t window);
+
+/*!
+ *  @function ota_transfer_begin_row
+ *
+ *  @discussion Starts transfer of a row of row_length bytes split into SEND_DATA payloads of chunk_size bytes
+ *
+ */
+void ota_transfer_begin_row(ota_transfer *transfer, uint32_t row_length, uint32_t chunk_size);
+
+/*!
+ *  @function ota_transfer_next_packet
+ *
+ *  @discussion Returns 1 and fills packet if a command can be sent now, 0 if the engine waits for responses.
+ *  The packet is counted as in flight from this call on.
+ *
+ */
+int ota_transfer_next_packet(ota_transfer *transfer, ota_transfer_packet *packet);
+
+/*!
+ *  @function ota_transfer_on_response
+ *
+ *  @discussion Handles the response for command with the status code reported by the target
+ *
+ */
+ota_transfer_result ota_transfer_on_response(ota_transfer *transfer, uint8_t command, uint8_t status);
+
+/*!
+ *  @function ota_transfer_in_flight
+ *
+ *  @discussion Returns the number of commands awaiting response
+ *
+ */
+uint16_t ota_transfer_in_flight(const ota_transfer *transfer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OTATransferEngine_h */
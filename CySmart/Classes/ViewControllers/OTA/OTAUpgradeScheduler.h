@@ -0,0 +1,70 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import <CoreBluetooth/CoreBluetooth.h>
+#import "OTAFirmwareImage.h"
+
+/*!
+ *  @class OTAUpgradeScheduler
+ *
+ *  @discussion Upgrades several peripherals with the same CYACD image at once. Each peripheral gets its own session;
+ *  the number of peripherals connected at a time and the total on-air bandwidth are limited.
+ *
+ */
+@interface OTAUpgradeScheduler : NSObject
+
+/*!
+ *  @method initWithFirmwareImage: header: securityKey: maxConnections: bytesPerSecond:
+ *
+ *  @discussion Creates the scheduler for the image and file header returned by OTAFileParser. bytesPerSecond 0 disables the bandwidth limit.
+ *
+ */
+- (instancetype) initWithFirmwareImage:(OTAFirmwareImage *)image header:(NSDictionary *)header securityKey:(NSData *)securityKey maxConnections:(NSUInteger)maxConnections bytesPerSecond:(NSUInteger)bytesPerSecond;
+
+/*!
+ *  @method upgradePeripherals: progressHandler: completionHandler:
+ *
+ *  @discussion Upgrades the peripherals. completionHandler is invoked once per peripheral.
+ *
+ */
+- (void) upgradePeripherals:(NSArray *)peripherals progressHandler:(void (^)(CBPeripheral *peripheral, float progress))progressHandler completionHandler:(void (^)(CBPeripheral *peripheral, NSError *error))completionHandler;
+
+/*!
+ *  @method cancel
+ *
+ *  @discussion Disconnects every peripheral still being upgraded
+ *
+ */
+- (void) cancel;
+
+@end
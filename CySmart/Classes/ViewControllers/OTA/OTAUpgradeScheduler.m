@@ -0,0 +1,291 @@
+/*
+ * Copyright Cypress Semiconductor Corporation, 2015-2018 All rights reserved.
+ *
+ * This software, associated documentation and materials ("Software") is
+ * owned by Cypress Semiconductor Corporation ("Cypress") and is
+ * protected by and subject to worldwide patent protection (UnitedStates and foreign), United States copyright laws and international
+ * treaty provisions. Therefore, unless otherwise specified in a separate license agreement between you and Cypress, this Software
+ * must be treated like any other copyrighted material. Reproduction,
+ * modification, translation, compilation, or representation of this
+ * Software in any other form (e.g., paper, magnetic, optical, silicon)
+ * is prohibited without Cypress's express written permission.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO,
+ * NONINFRINGEMENT, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE. Cypress reserves the right to make changes
+ * to the Software without notice. Cypress does not assume any liability
+ * arising out of the application or use of Software or any product or
+ * circuit described in the Software. Cypress does not authorize its
+ * products for use as critical components in any products where a
+ * malfunction or failure may reasonably be expected to result in
+ * significant injury or death ("High Risk Product"). By including
+ * Cypress's product in a High Risk Product, the manufacturer of such
+ * system or application assumes all risk of such use and in doing so
+ * indemnifies Cypress against all liability.
+ *
+ * Use of this Software may be limited by and subject to the applicable
+ * Cypress software license agreement.
+ *
+ *
+ */
+
+#import "OTAUpgradeScheduler.h"
+#import "OTAPeripheralSession.h"
+#import "OTAScheduler.h"
+#import "OTAFileParser.h"
+#import "BootLoaderServiceModel.h"
+#import "CyCBManager.h"
+#import "Constants.h"
+
+#define SCHEDULER_ERROR_DOMAIN  @"OTAUpgradeScheduler"
+
+@interface OTAUpgradeScheduler () <OTAPeripheralSessionDelegate>
+
+- (void) connectSessionAtIndex:(unsigned)job;
+- (BOOL) writePacket:(const uint8_t *)bytes length:(uint16_t)length forSessionAtIndex:(unsigned)job;
+- (void) finishSessionAtIndex:(unsigned)job;
+
+@end
+
+static void scheduler_connect(void *context, unsigned job)
+{
+    [(__bridge OTAUpgradeScheduler *)context connectSessionAtIndex:job];
+}
+
+static int scheduler_write(void *context, unsigned job, const uint8_t *bytes, uint16_t length)
+{
+    return [(__bridge OTAUpgradeScheduler *)context writePacket:bytes length:length forSessionAtIndex:job];
+}
+
+static void scheduler_finished(void *context, unsigned job, const ota_session *session)
+{
+    [(__bridge OTAUpgradeScheduler *)context finishSessionAtIndex:job];
+}
+
+/*!
+ *  @class OTAUpgradeScheduler
+ *
+ *  @discussion Class to run the sessions of a multi-device upgrade on the main run loop
+ *
+ */
+@implementation OTAUpgradeScheduler
+{
+    OTAFirmwareImage *firmwareImage;
+    NSData *securityKey;
+    NSMutableData *rowTable;            // ota_session_row entries pointing into firmwareImage
+    ota_session_image sessionImage;
+    ota_scheduler scheduler;
+    NSMutableArray *sessions;
+    NSTimer *pollTimer;
+    BootLoaderServiceModel *errorMessageModel;
+    
+    void (^progressHandler)(CBPeripheral *peripheral, float progress);
+    void (^completionHandler)(CBPeripheral *peripheral, NSError *error);
+}
+
+- (instancetype) initWithFirmwareImage:(OTAFirmwareImage *)image header:(NSDictionary *)header securityKey:(NSData *)key maxConnections:(NSUInteger)maxConnections bytesPerSecond:(NSUInteger)bytesPerSecond
+{
+    self = [super init];
+    if (self)
+    {
+        firmwareImage = image;
+        securityKey = key;
+        sessions = [NSMutableArray new];
+        errorMessageModel = [[BootLoaderServiceModel alloc] init];
+        
+        rowTable = [NSMutableData dataWithLength:image.rowCount * sizeof(ota_session_row)];
+        ota_session_row *rows = rowTable.mutableBytes;
+        for (NSUInteger i = 0; i < image.rowCount; i++)
+        {
+            const OTAFirmwareRow *row = [image rowAtIndex:i];
+            rows[i].array_id = row->arrayID;
+            rows[i].row_number = row->rowNumber;
+            rows[i].length = row->dataLength;
+            rows[i].verify_checksum = [image.digest rowDigestAtIndex:i]->verifyChecksum;
+            rows[i].data = [image bytesForRowAtIndex:i];
+        }
+        
+        sessionImage.rows = rows;
+        sessionImage.row_count = (uint32_t)image.rowCount;
+        sessionImage.silicon_id = (uint32_t)strtoul([[header objectForKey:SILICON_ID] UTF8String], NULL, 16);
+        sessionImage.silicon_rev = (uint8_t)strtoul([[header objectForKey:SILICON_REV] UTF8String], NULL, 16);
+        sessionImage.checksum_type = (CHECKSUM_TYPE_CRC == [[header objectForKey:CHECKSUM_TYPE] integerValue]) ? CY_CHECKSUM_CRC16 : CY_CHECKSUM_SUM;
+        sessionImage.security_key = key.bytes;
+        sessionImage.security_key_length = (uint8_t)key.length;
+        
+        ota_scheduler_callbacks callbacks = { scheduler_connect, scheduler_write, scheduler_finished };
+        ota_scheduler_init(&scheduler, (uint16_t)MIN(maxConnections, (NSUInteger)OTA_SCHEDULER_MAX_JOBS), (uint32_t)bytesPerSecond, &callbacks, (__bridge void *)self);
+    }
+    return self;
+}
+
+/*!
+ *  @method upgradePeripherals: progressHandler: completionHandler:
+ *
+ *  @discussion Upgrades the peripherals. completionHandler is invoked once per peripheral.
+ *
+ */
+- (void) upgradePeripherals:(NSArray *)peripherals progressHandler:(void (^)(CBPeripheral *peripheral, float progress))progress completionHandler:(void (^)(CBPeripheral *peripheral, NSError *error))completion
+{
+    progressHandler = progress;
+    completionHandler = completion;
+    
+    for (CBPeripheral *peripheral in peripherals)
+    {
+        OTAPeripheralSession *session = [[OTAPeripheralSession alloc] initWithPeripheral:peripheral image:&sessionImage];
+        session.delegate = self;
+        session.jobIndex = ota_scheduler_add_job(&scheduler, session.session);
+        if (session.jobIndex < 0)
+        {
+            completionHandler(peripheral, [NSError errorWithDomain:SCHEDULER_ERROR_DOMAIN code:OTA_SESSION_ERR_PROTOCOL userInfo:nil]);
+            continue;
+        }
+        [sessions addObject:session];
+    }
+    [self poll];
+}
+
+/*!
+ *  @method cancel
+ *
+ *  @discussion Disconnects every peripheral still being upgraded
+ *
+ */
+- (void) cancel
+{
+    ota_scheduler_cancel(&scheduler);
+    [pollTimer invalidate];
+    pollTimer = nil;
+}
+
+/*!
+ *  @method poll
+ *
+ *  @discussion Lets the scheduler connect waiting peripherals and write queued packets, and rearms the timer of the bandwidth limit
+ *
+ */
+- (void) poll
+{
+    [pollTimer invalidate];
+    pollTimer = nil;
+    
+    uint64_t delay = ota_scheduler_poll(&scheduler, (uint64_t)([[NSProcessInfo processInfo] systemUptime] * 1000000.0));
+    if (delay != OTA_SCHEDULER_WAIT_EVENT)
+    {
+        pollTimer = [NSTimer scheduledTimerWithTimeInterval:delay / 1000000.0 target:self selector:@selector(poll) userInfo:nil repeats:NO];
+    }
+}
+
+- (void) connectSessionAtIndex:(unsigned)job
+{
+    OTAPeripheralSession *session = [sessions objectAtIndex:job];
+    __weak OTAUpgradeScheduler *weakSelf = self;
+    [[CyCBManager sharedManager] connectSessionPeripheral:session.peripheral connectionHandler:^(BOOL connected, NSError *error) {
+        [weakSelf session:session didChangeConnectionState:connected];
+    }];
+}
+
+- (void) session:(OTAPeripheralSession *)session didChangeConnectionState:(BOOL)connected
+{
+    if (connected)
+    {
+        [session prepare];
+    }
+    else
+    {
+        ota_scheduler_on_disconnected(&scheduler, session.jobIndex);
+        [self poll];
+    }
+}
+
+- (BOOL) writePacket:(const uint8_t *)bytes length:(uint16_t)length forSessionAtIndex:(unsigned)job
+{
+    return [[sessions objectAtIndex:job] writePacket:bytes length:length];
+}
+
+- (void) finishSessionAtIndex:(unsigned)job
+{
+    OTAPeripheralSession *session = [sessions objectAtIndex:job];
+    [[CyCBManager sharedManager] disconnectSessionPeripheral:session.peripheral];
+    
+    if (progressHandler)
+    {
+        progressHandler(session.peripheral, session.progress);
+    }
+    if (completionHandler)
+    {
+        completionHandler(session.peripheral, [self errorForSession:session.session]);
+    }
+}
+
+/*!
+ *  @method errorForSession:
+ *
+ *  @discussion Returns the error of a failed session, nil if it completed
+ *
+ */
+- (NSError *) errorForSession:(const ota_session *)session
+{
+    if (OTA_SESSION_DONE == session->state)
+    {
+        return nil;
+    }
+    
+    NSString *message;
+    switch (session->error)
+    {
+        case OTA_SESSION_ERR_STATUS:
+            message = [errorMessageModel errorMessageForErrorCode:session->device_status];
+            break;
+        case OTA_SESSION_ERR_SILICON:
+            message = LOCALIZEDSTRING(@"OTASiliconIDMismatchMessage");
+            break;
+        case OTA_SESSION_ERR_ROW_BOUNDS:
+            message = LOCALIZEDSTRING(@"OTARowNoOutOfBoundMessage");
+            break;
+        case OTA_SESSION_ERR_ROW_CHECKSUM:
+            message = LOCALIZEDSTRING(@"OTAChecksumMismatchMessage");
+            break;
+        case OTA_SESSION_ERR_APP_INVALID:
+            message = LOCALIZEDSTRING(@"OTAInvalidApplicationMessage");
+            break;
+        case OTA_SESSION_ERR_DISCONNECTED:
+            message = LOCALIZEDSTRING(@"deviceDisconnectedAlert");
+            break;
+        default:
+            message = LOCALIZEDSTRING(@"OTAWritingFailedMessage");
+            break;
+    }
+    return [NSError errorWithDomain:SCHEDULER_ERROR_DOMAIN code:session->error userInfo:@{NSLocalizedDescriptionKey: message}];
+}
+
+#pragma mark - OTAPeripheralSessionDelegate
+
+- (void) peripheralSessionDidBecomeReady:(OTAPeripheralSession *)session
+{
+    ota_scheduler_on_connected(&scheduler, session.jobIndex);
+    [self poll];
+}
+
+- (void) peripheralSession:(OTAPeripheralSession *)session didReceiveResponse:(NSData *)response
+{
+    ota_scheduler_on_response(&scheduler, session.jobIndex, response.bytes, (uint32_t)response.length);
+    if (progressHandler && !ota_session_finished(session.session))
+    {
+        progressHandler(session.peripheral, session.progress);
+    }
+    [self poll];
+}
+
+- (void) peripheralSessionCanWrite:(OTAPeripheralSession *)session
+{
+    [self poll];
+}
+
+- (void) peripheralSession:(OTAPeripheralSession *)session didFailWithError:(NSError *)error
+{
+    [[CyCBManager sharedManager] disconnectSessionPeripheral:session.peripheral];
+}
+
+@end
@@ -121,9 +121,7 @@
     MyLineChart *pressureChart, *temperatureChart, *accelerometerGraph;
     BOOL isPressureChartVisible, isTemperatureChartVisible, isAccelerometerGraphVisible;
     
-    NSMutableArray *pressureDataArray, *pressureTimeDataArray;
-    NSMutableArray *temperatureDataArray, *temperatureTimeDataArray;
-    NSMutableArray *accelerometerDataArray, *accelerometerTimeDataArray;
+    TimeSeries *pressureSeries, *temperatureSeries, *accelerometerSeries;
     
     //Variables to control Text Field auto positioning when keyboard appears
     CGRect firstResponderRect, keyBoardRect;
@@ -151,14 +149,11 @@
     [self initSensorHubmodel];
     [self initBatteryModel];
     
-    pressureDataArray = [NSMutableArray array];
-    pressureTimeDataArray = [NSMutableArray array];
+    pressureSeries = [[TimeSeries alloc] initWithCapacity:MAX_GRAPH_POINTS];
     
-    temperatureDataArray = [NSMutableArray array];
-    temperatureTimeDataArray = [NSMutableArray array];
+    temperatureSeries = [[TimeSeries alloc] initWithCapacity:MAX_GRAPH_POINTS];
     
-    accelerometerDataArray = [NSMutableArray array];
-    accelerometerTimeDataArray = [NSMutableArray array];
+    accelerometerSeries = [[TimeSeries alloc] initWithCapacity:MAX_GRAPH_POINTS];
     
     startTime = [NSDate date];
     //Method for adding Done button as accessory view to the keyboard's top for each text fields
@@ -222,25 +217,16 @@
         mSensorHubModel = [[SensorHubModel alloc] init];
     }
     
+    [mSensorHubModel setFrameHandler:^(const sensor_frame *frames, NSUInteger count) {
+        [self handleSensorFrames:frames count:count];
+    }];
+    
     [mSensorHubModel startDiscoverAccelerometerCharacteristicsWithHandler:^(BOOL success, NSError *error) {
         
         if (success)
         {
             isAccelerometerCharacteristicsdiscovered = YES;
-            
-            [mSensorHubModel startUpdateAccelerometerXYZValueswithHandler:^(BOOL success, NSError *error) {
-                
-                if (success)
-                {
-                    @synchronized(mSensorHubModel.accelerometer){
-                        accellermeterReadingXValueLbl.text = [NSString stringWithFormat:@"%.0f",mSensorHubModel.accelerometer.xValue];
-                        accellermeterReadingYValueLbl.text = [NSString stringWithFormat:@"%.0f",mSensorHubModel.accelerometer.yValue];
-                        accellermeterReadingZValueLbl.text = [NSString stringWithFormat:@"%.0f",mSensorHubModel.accelerometer.zValue];
-                        
-                        [self handleAccelerometerGraph];
-                    }
-                }
-            }];
+            [mSensorHubModel startUpdateAccelerometerXYZValues];
         }
     }];
     
@@ -249,18 +235,7 @@
         if (success)
         {
             isBarometerCharacteristicsdiscovered = YES;
-            
-            [mSensorHubModel startUpdateBarometerPressureValueWithHandler:^(BOOL success, NSError *error) {
-                
-                if (success)
-                {
-                    @synchronized(mSensorHubModel.barometer)
-                    {
-                        pressureReadingValueLbl.text = mSensorHubModel.barometer.pressureValueString;
-                        [self handlePressureGraph];
-                    }
-                }
-            }];
+            [mSensorHubModel startUpdateBarometerPressureValue];
         }
     }];
     
@@ -269,22 +244,75 @@
         if (success)
         {
             isTemperatureCharacteristicsdiscovered = YES;
-            
-            [mSensorHubModel startUpdateTemperatureValueCharacteristicWithHandler:^(BOOL success, NSError *error) {
-                
-                if (success)
-                {
-                    @synchronized(mSensorHubModel.temperatureSensor){
-                        
-                        temperatureReadingValueLbl.text = mSensorHubModel.temperatureSensor.temperatureValueString;
-                        [self handleTemperatureGraph];
-                    }
-                }
-            }];
+            [mSensorHubModel startUpdateTemperatureValue];
         }
     }];
 }
 
+/*!
+ *  @method handleSensorFrames:count:
+ *
+ *  @discussion Method to add a batch of sensor frames to the graphs and show the latest readings. The labels and the
+ *  visible graphs are updated once per batch.
+ *
+ */
+-(void) handleSensorFrames:(const sensor_frame *)frames count:(NSUInteger)count
+{
+    NSTimeInterval start = [startTime timeIntervalSinceReferenceDate];
+    uint32_t fresh = 0;
+    
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        const sensor_frame *frame = &frames[i];
+        NSTimeInterval timeInterval = frame->timestamp - start;
+        fresh |= frame->fresh;
+        
+        if ((frame->fresh & SENSOR_CHANNEL_BIT(SENSOR_CHANNEL_X)) && frame->values[SENSOR_CHANNEL_X])
+        {
+            [accelerometerSeries appendValue:frame->values[SENSOR_CHANNEL_X] atTime:timeInterval];
+        }
+        if (frame->fresh & SENSOR_CHANNEL_BIT(SENSOR_CHANNEL_PRESSURE))
+        {
+            [pressureSeries appendValue:frame->values[SENSOR_CHANNEL_PRESSURE] atTime:timeInterval];
+        }
+        if (frame->fresh & SENSOR_CHANNEL_BIT(SENSOR_CHANNEL_TEMPERATURE))
+        {
+            [temperatureSeries appendValue:frame->values[SENSOR_CHANNEL_TEMPERATURE] atTime:timeInterval];
+        }
+    }
+    
+    const sensor_frame *latest = &frames[count - 1];
+    
+    if (fresh & SENSOR_ACCELEROMETER_CHANNELS)
+    {
+        accellermeterReadingXValueLbl.text = [NSString stringWithFormat:@"%.0f",latest->values[SENSOR_CHANNEL_X]];
+        accellermeterReadingYValueLbl.text = [NSString stringWithFormat:@"%.0f",latest->values[SENSOR_CHANNEL_Y]];
+        accellermeterReadingZValueLbl.text = [NSString stringWithFormat:@"%.0f",latest->values[SENSOR_CHANNEL_Z]];
+        
+        if(accelerometerGraph && isAccelerometerGraphVisible){
+            [accelerometerGraph updateLineGraphWithSeries:accelerometerSeries];
+        }
+    }
+    
+    if (fresh & SENSOR_CHANNEL_BIT(SENSOR_CHANNEL_PRESSURE))
+    {
+        pressureReadingValueLbl.text = [NSString stringWithFormat:@"%f",latest->values[SENSOR_CHANNEL_PRESSURE]];
+        
+        if(pressureChart && isPressureChartVisible){
+            [pressureChart updateLineGraphWithSeries:pressureSeries];
+        }
+    }
+    
+    if (fresh & SENSOR_CHANNEL_BIT(SENSOR_CHANNEL_TEMPERATURE))
+    {
+        temperatureReadingValueLbl.text = [NSString stringWithFormat:@"%f",latest->values[SENSOR_CHANNEL_TEMPERATURE]];
+        
+        if(temperatureChart && isTemperatureChartVisible){
+            [temperatureChart updateLineGraphWithSeries:temperatureSeries];
+        }
+    }
+}
+
 #pragma mark - Handling acclerometer
 
 /*!
@@ -314,46 +342,6 @@
     }
 }
 
-/*!
- *  @method handleAccelerometerGraph
- *
- *  @discussion Method to handle accelerometer graph
- *
- */
--(void) handleAccelerometerGraph
-{
-    if(mSensorHubModel.accelerometer.xValue)
-    {
-        NSTimeInterval timeInterval = fabs([startTime timeIntervalSinceNow]);
-        [accelerometerTimeDataArray addObject:@(timeInterval)];
-        [accelerometerDataArray addObject:@(mSensorHubModel.accelerometer.xValue)];
-        if(accelerometerGraph && isAccelerometerGraphVisible){
-            [self checkAccelerometerGraphPointsCount];
-            [accelerometerGraph updateLineGraph:accelerometerTimeDataArray Y:accelerometerDataArray ];
-        }
-    }
-}
-
-/*!
- *  @method checkAccelerometerGraphPointsCount
- *
- *  @discussion Method to check the graph plot points
- *
- */
--(void) checkAccelerometerGraphPointsCount{
-    
-    if (accelerometerTimeDataArray.count > MAX_GRAPH_POINTS) {
-        accelerometerTimeDataArray = [[accelerometerTimeDataArray subarrayWithRange:NSMakeRange(accelerometerTimeDataArray.count - MAX_GRAPH_POINTS,MAX_GRAPH_POINTS)] mutableCopy];
-        accelerometerGraph.chartView.setXmin = YES;
-    }else{
-        accelerometerGraph.chartView.setXmin = NO;
-    }
-    
-    if (accelerometerDataArray.count > MAX_GRAPH_POINTS) {
-        accelerometerDataArray = [[accelerometerDataArray subarrayWithRange:NSMakeRange(accelerometerDataArray.count - MAX_GRAPH_POINTS,MAX_GRAPH_POINTS)] mutableCopy];
-    }
-}
-
 
 #pragma mark - Handling Temperature sensor
 
@@ -387,46 +375,6 @@
     }
 }
 
-/*!
- *  @method handleTemperatureGraph
- *
- *  @discussion Method to temperature graph
- *
- */
--(void) handleTemperatureGraph
-{
-    if(mSensorHubModel.temperatureSensor.temperatureValueString)
-    {
-        NSTimeInterval timeInterval = fabs([startTime timeIntervalSinceNow]);
-        [temperatureTimeDataArray addObject:@(timeInterval)];
-        [temperatureDataArray addObject:@([mSensorHubModel.temperatureSensor.temperatureValueString floatValue])];
-        if(temperatureChart && isTemperatureChartVisible){
-            [self checkTemeperatureGraphPointsCount];
-            [temperatureChart updateLineGraph:temperatureTimeDataArray Y:temperatureDataArray];
-        }
-    }
-}
-
-
-/*!
- *  @method checkTemeperatureGraphPointsCount
- *
- *  @discussion Method to check the graph plot points
- *
- */
--(void) checkTemeperatureGraphPointsCount{
-    
-    if (temperatureTimeDataArray.count > MAX_GRAPH_POINTS) {
-        temperatureTimeDataArray = [[temperatureTimeDataArray subarrayWithRange:NSMakeRange(temperatureTimeDataArray.count - MAX_GRAPH_POINTS,MAX_GRAPH_POINTS)] mutableCopy];
-        temperatureChart.chartView.setXmin = YES;
-    }else{
-        temperatureChart.chartView.setXmin = NO;
-    }
-    
-    if (temperatureDataArray.count > MAX_GRAPH_POINTS) {
-        temperatureDataArray = [[temperatureDataArray subarrayWithRange:NSMakeRange(temperatureDataArray.count - MAX_GRAPH_POINTS,MAX_GRAPH_POINTS)] mutableCopy];
-    }
-}
 
 
 #pragma mark - Handling battery service
@@ -515,47 +463,6 @@
 }
 
 
-/*!
- *  @method handlePressureGraph
- *
- *  @discussion Method to handle pressure graph
- *
- */
--(void) handlePressureGraph
-{
-    if(mSensorHubModel.barometer.pressureValueString)
-    {
-        NSTimeInterval timeInterval = fabs([startTime timeIntervalSinceNow]);
-        [pressureTimeDataArray addObject:@(timeInterval)];
-        [pressureDataArray addObject:@([mSensorHubModel.barometer.pressureValueString floatValue])];
-        if(pressureChart && isPressureChartVisible){
-            [self checkPressureGraphPointsCount];
-            [pressureChart updateLineGraph:pressureTimeDataArray Y:pressureDataArray ];
-        }
-    }
-}
-
-/*!
- *  @method checkPressureGraphPointsCount
- *
- *  @discussion Method to check the graph plot points
- *
- */
--(void) checkPressureGraphPointsCount{
-    
-    if (pressureTimeDataArray.count > MAX_GRAPH_POINTS) {
-        pressureTimeDataArray = [[pressureTimeDataArray subarrayWithRange:NSMakeRange(pressureTimeDataArray.count - MAX_GRAPH_POINTS,MAX_GRAPH_POINTS)] mutableCopy];
-        pressureChart.chartView.setXmin = YES;
-    }else{
-        pressureChart.chartView.setXmin = NO;
-    }
-    
-    if (pressureDataArray.count > MAX_GRAPH_POINTS) {
-        pressureDataArray = [[pressureDataArray subarrayWithRange:NSMakeRange(pressureDataArray.count - MAX_GRAPH_POINTS,MAX_GRAPH_POINTS)] mutableCopy];
-    }
-}
-
-
 #pragma mark - Button Actions
 
 /*!
@@ -628,9 +535,8 @@
             accelerometerGraph.shareButton.frame = CGRectMake(0, 0, 0, 0);
         }
         
-        if([accelerometerTimeDataArray count]){
-            [self checkAccelerometerGraphPointsCount];
-            [accelerometerGraph updateLineGraph:accelerometerTimeDataArray Y:accelerometerDataArray ];
+        if([accelerometerSeries count]){
+            [accelerometerGraph updateLineGraphWithSeries:accelerometerSeries];
         }
         [accellerometerGraphView addSubview:accelerometerGraph];
     }
@@ -684,9 +590,8 @@
             
         }
         
-        if([temperatureTimeDataArray count]){
-            [self checkTemeperatureGraphPointsCount];
-            [temperatureChart updateLineGraph:temperatureTimeDataArray Y:temperatureDataArray ];
+        if([temperatureSeries count]){
+            [temperatureChart updateLineGraphWithSeries:temperatureSeries];
         }
         [temperatureGraphView addSubview:temperatureChart];
     }
@@ -741,9 +646,8 @@
         }
        
         
-        if([pressureTimeDataArray count]){
-            [self checkPressureGraphPointsCount];
-            [pressureChart updateLineGraph:pressureTimeDataArray Y:pressureDataArray ];
+        if([pressureSeries count]){
+            [pressureChart updateLineGraphWithSeries:pressureSeries];
         }
         [pressureGraphView addSubview:pressureChart];
 
@@ -58,8 +58,7 @@
     KLCPopup* kPopup;
     MyLineChart *myChart;
     BOOL isStartTimeSet;
-    NSMutableArray *rpmDataArray;
-    NSMutableArray *timeDataArray;
+    TimeSeries *rpmSeries;
     
     NSTimeInterval previousTimeInterval;
     float xAxisTimeInterval;
@@ -89,8 +88,7 @@
     [super viewDidLoad];
     // Do any additional setup after loading the view.
 
-    rpmDataArray = [NSMutableArray array];
-    timeDataArray = [NSMutableArray array];
+    rpmSeries = [[TimeSeries alloc] initWithCapacity:MAX_GRAPH_POINTS];
     [self initializeView];
     
     // Initialize CSC model
@@ -367,8 +365,6 @@
         }
         else
         {
-            [rpmDataArray addObject:@(mCSCModel.cadence)];
-            
             NSTimeInterval timeInterval = fabs([startTime timeIntervalSinceNow]);
             
             if (previousTimeInterval == 0)
@@ -381,12 +377,11 @@
                 xAxisTimeInterval = timeInterval - previousTimeInterval;
             }
             
-            [timeDataArray addObject:@(timeInterval)];
+            [rpmSeries appendValue:mCSCModel.cadence atTime:timeInterval];
             
             if(myChart && kPopup.isShowing)
             {
-                [self checkGraphPointsCount];
-                [myChart updateLineGraph:timeDataArray Y:rpmDataArray];
+                [myChart updateLineGraphWithSeries:rpmSeries];
                 [myChart setXaxisScaleWithValue:nearbyintf(xAxisTimeInterval)];
             }
             previousTimeInterval = timeInterval;
@@ -471,10 +466,9 @@
     [myChart addXLabel:TIME yLabel:CYCLING_GRAPH_YLABEL];
     myChart.delegate = self;
     
-    if([timeDataArray count])
+    if([rpmSeries count])
     {
-        [self checkGraphPointsCount];
-        [myChart updateLineGraph:timeDataArray Y:rpmDataArray];
+        [myChart updateLineGraphWithSeries:rpmSeries];
         
         KLCPopupLayout layout = KLCPopupLayoutMake(KLCPopupHorizontalLayoutCenter,
                                                    KLCPopupVerticalLayoutBottom);
@@ -492,26 +486,6 @@
     
 }
 
-/*!
- *  @method checkGraphPointsCount
- *
- *  @discussion Method to check the graph plot points
- *
- */
--(void) checkGraphPointsCount{
-    
-    if (timeDataArray.count > MAX_GRAPH_POINTS) {
-        timeDataArray = [[timeDataArray subarrayWithRange:NSMakeRange(timeDataArray.count - MAX_GRAPH_POINTS,MAX_GRAPH_POINTS)] mutableCopy];
-        myChart.chartView.setXmin = YES;
-    }else{
-        myChart.chartView.setXmin = NO;
-    }
-    
-    if (rpmDataArray.count > MAX_GRAPH_POINTS) {
-        rpmDataArray = [[rpmDataArray subarrayWithRange:NSMakeRange(rpmDataArray.count - MAX_GRAPH_POINTS,MAX_GRAPH_POINTS)] mutableCopy];
-    }
-}
-
 /*!
  *  @method shareScreen:
  *
@@ -34,14 +34,19 @@
 #import "FirmwareUpgradeHomeViewController.h"
 #import "FirmwareFileSelectionViewController.h"
 #import "OTAFileParser.h"
+#import "OTATransferEngine.h"
+#import "OTACheckpointStore.h"
+#import "OTADeltaPlan.h"
 #import "BootLoaderServiceModel.h"
 #import "Utilities.h"
 #import "CyCBManager.h"
+#import "LoggerHandler.h"
 
 #define BACK_BUTTON_ALERT_TAG  200
 
 #define UPGRADE_RESUME_ALERT_TAG 201
 #define UPGRADE_STOP_ALERT_TAG  202
+#define MULTI_DEVICE_UPGRADE_ALERT_TAG  206
 
 #define APP_UPGRADE_BTN_TAG 203
 #define APP_STACK_UPGRADE_COMBINED_BTN_TAG  204
@@ -50,6 +55,12 @@
 #define WRITE_WITH_RESP_MAX_DATA_SIZE   133
 #define WRITE_NO_RESP_MAX_DATA_SIZE   300
 
+// Number of SEND_DATA commands sent ahead of their responses when write w/o response is supported
+#define SEND_DATA_WINDOW_SIZE   4
+
+// Skip rows unchanged since the image last flashed to the device, confirmed using VERIFY_ROW (CYACD)
+#define DELTA_UPGRADE_ENABLED   1
+
 #define FIRMWARE_SELECTION_SEGUE    @"firmwareSelectionPageSegue"
 
 /*!
@@ -90,20 +101,25 @@
     BootLoaderServiceModel *bootloaderModel;
     BOOL isBootloaderCharacteristicFound, isWritingFile1;
     
-    NSArray *firmwareFileList, *fileRowDataArray;
-    NSMutableArray *currentRowDataArray;
-    uint32_t currentRowDataAddress;
-    uint32_t currentRowDataCRC32;
+    NSArray *firmwareFileList;
+    OTAFirmwareImage *firmwareImage;
+    ota_transfer rowTransfer;
+    NSMutableData *deviceRowChecksums; // Row checksums from VERIFY_ROW responses from firstCheckedRowIndex on (CYACD)
+    NSUInteger firstCheckedRowIndex; // Rows before it were programmed by the interrupted upgrade that is resumed (CYACD)
+    BOOL isVerifyingCheckpointRow; // YES while the row of a resumed checkpoint is re-verified (CYACD)
+    BOOL isVerifyingRowBeforeProgramming; // YES while a row is compared with the device flash in delta upgrade (CYACD)
+    OTADeltaPlan *deltaPlan;
     
     NSDictionary *fileHeaderDict;
     NSDictionary *appInfoDict;
     OTAMode firmwareUpgradeMode;
     int currentRowNumber, currentIndex;
-    NSString *currentArrayID;
+    int currentArrayID;
     int fileWritingProgress;
     int maxDataSize;
     ActiveApp activeApp; // Active Application for Dual Application Bootloader projects
     NSData *securityKey; // Security Key for CYACD files
+    NSArray *nearbyBootloaderPeripherals; // Devices in bootloader mode offered for upgrade with the same file (CYACD)
 }
 
 @end
@@ -312,26 +328,26 @@
     NSString *fileName = [firmwareFile valueForKey:FILE_NAME];
     NSString *filePath = [firmwareFile valueForKey:FILE_PATH];
     if ([[fileName pathExtension] caseInsensitiveCompare:@"cyacd2"] == NSOrderedSame) {
-        [fileParser parseFirmwareFileWithName_v1:fileName path:filePath onFinish:^(NSMutableDictionary *header, NSDictionary *appInfo, NSArray *rowData, NSError *error) {
+        [fileParser parseFirmwareFileWithName_v1:fileName path:filePath onFinish:^(NSMutableDictionary *header, NSDictionary *appInfo, OTAFirmwareImage *image, NSError *error) {
             if(error) {
                 [Utilities alertWithTitle:APP_NAME message:error.localizedDescription];
                 [self initView];
-            } else if (header && rowData) {
+            } else if (header && image) {
                 fileHeaderDict = header;
                 appInfoDict = appInfo;
-                fileRowDataArray = rowData;
+                firmwareImage = image;
                 [self initializeFileTransfer_v1];
             }
         }];
     } else {
-        [fileParser parseFirmwareFileWithName:fileName path:filePath onFinish:^(NSMutableDictionary *header, NSArray *rowData, NSArray *rowIdArray, NSError *error) {
+        [fileParser parseFirmwareFileWithName:fileName path:filePath onFinish:^(NSMutableDictionary *header, OTAFirmwareImage *image, NSArray *rowIdArray, NSError *error) {
             if(error) {
                 [Utilities alertWithTitle:APP_NAME message:error.localizedDescription];
                 [self initView];
-            } else if (header && rowData && rowIdArray) {
+            } else if (header && image && rowIdArray) {
                 fileHeaderDict = header;
-                fileRowDataArray = rowData;
-                [self initializeFileTransfer];
+                firmwareImage = image;
+                [self offerNearbyDevicesUpgrade];
             }
         }];
     }
@@ -394,6 +410,44 @@
 
 #pragma mark - OTA Upgrade
 
+/*!
+ *  @method offerNearbyDevicesUpgrade
+ *
+ *  @discussion Offers to upgrade the nearby devices in bootloader mode with the same file alongside the connected device, then begins the file transfer (CYACD)
+ *
+ */
+-(void) offerNearbyDevicesUpgrade {
+    nearbyBootloaderPeripherals = nil;
+    NSArray *peripherals = [[CyCBManager sharedManager] bootloaderPeripherals];
+    if (peripherals.count > 0 && app_stack_separate != firmwareUpgradeMode && NoChange == activeApp) {
+        nearbyBootloaderPeripherals = peripherals;
+        UIAlertView *multiDeviceAlert = [[UIAlertView alloc] initWithTitle:APP_NAME message:[NSString stringWithFormat:LOCALIZEDSTRING(@"OTAMultiDeviceUpgradeConfirmMessage"), (unsigned long)peripherals.count] delegate:self cancelButtonTitle:@"No" otherButtonTitles:@"Yes", nil];
+        multiDeviceAlert.tag = MULTI_DEVICE_UPGRADE_ALERT_TAG;
+        [multiDeviceAlert show];
+    } else {
+        [self initializeFileTransfer];
+    }
+}
+
+/*!
+ *  @method upgradeNearbyDevices
+ *
+ *  @discussion Upgrades the nearby devices in bootloader mode through the multi-device scheduler of CyCBManager
+ *
+ */
+-(void) upgradeNearbyDevices {
+    [[CyCBManager sharedManager] upgradePeripherals:nearbyBootloaderPeripherals firmwareImage:firmwareImage header:fileHeaderDict securityKey:securityKey completionHandler:^(NSUInteger upgradedCount, NSUInteger failedCount) {
+        NSString *report = [NSString stringWithFormat:LOCALIZEDSTRING(@"OTAMultiDeviceUpgradeReport"), (unsigned long)upgradedCount, (unsigned long)failedCount];
+        [[LoggerHandler logManager] addLogData:report];
+        
+        UILocalNotification *notification = [[UILocalNotification alloc] init];
+        notification.fireDate = [NSDate dateWithTimeIntervalSinceNow:1];
+        notification.alertBody = report;
+        [[UIApplication sharedApplication] scheduleLocalNotification:notification];
+    }];
+    nearbyBootloaderPeripherals = nil;
+}
+
 /*!
  *  @method initServiceModel
  *
@@ -415,7 +469,8 @@
              isBootloaderCharacteristicFound = YES;
              if (bootloaderModel.isWriteWithoutResponseSupported)
              {
-                 maxDataSize = WRITE_NO_RESP_MAX_DATA_SIZE;
+                 // Size SEND_DATA payload so that the packets fill whole writes of negotiated MTU size
+                 maxDataSize = [bootloaderModel sendDataPayloadSizeWithLimit:WRITE_NO_RESP_MAX_DATA_SIZE];
              }
              else
              {
@@ -434,6 +489,31 @@
 -(void) initializeFileTransfer {
     if (isBootloaderCharacteristicFound) {
         currentIndex = 0;
+        currentArrayID = -1;
+        deviceRowChecksums = [NSMutableData dataWithCapacity:firmwareImage.rowCount];
+        firstCheckedRowIndex = 0;
+        isVerifyingCheckpointRow = NO;
+        isVerifyingRowBeforeProgramming = NO;
+        deltaPlan = nil;
+        if (DELTA_UPGRADE_ENABLED) {
+            // Only rows matching the digest of the image last flashed to the device are candidates for skipping
+            OTAImageDigest *previousDigest = [OTAImageDigest cachedDigestForFileHash:[OTACheckpointStore flashedImageHashForDevice:[self connectedDeviceID]]];
+            deltaPlan = [[OTADeltaPlan alloc] initWithImage:firmwareImage previousDigest:previousDigest];
+        }
+        // Rows are about to be rewritten: until VERIFY_CHECKSUM passes, the device holds no known image
+        [OTACheckpointStore removeFlashedImageHashForDevice:[self connectedDeviceID]];
+        
+        // Resume an interrupted upgrade of the same image from the last verified row
+        OTACheckpoint checkpoint;
+        if ([self loadCheckpoint:&checkpoint]) {
+            currentIndex = checkpoint.rowIndex;
+            firstCheckedRowIndex = checkpoint.rowIndex;
+            isVerifyingCheckpointRow = YES;
+        } else {
+            // A checkpoint of another image stops describing the device flash once this upgrade writes to it
+            [self removeCheckpoint];
+        }
+        ota_transfer_init(&rowTransfer, SEND_DATA, PROGRAM_ROW, bootloaderModel.isWriteWithoutResponseSupported ? SEND_DATA_WINDOW_SIZE : 1);
         [self registerForBootloaderCharacteristicNotifications];
         
         bootloaderModel.fileVersion = [[fileHeaderDict objectForKey:FILE_VERSION] integerValue];
@@ -442,9 +522,9 @@
         
         // Set checksum type
         if (CHECKSUM_TYPE_CRC == [[fileHeaderDict objectForKey:CHECKSUM_TYPE] integerValue]) {
-            [bootloaderModel setCheckSumType:CRC_16];
+            [bootloaderModel setCheckSumType:CY_CHECKSUM_CRC16];
         } else{
-            [bootloaderModel setCheckSumType:CHECK_SUM];
+            [bootloaderModel setCheckSumType:CY_CHECKSUM_SUM];
         }
         
         // Write ENTER_BOOTLOADER command
@@ -468,15 +548,26 @@
 -(void) initializeFileTransfer_v1 {
     if (isBootloaderCharacteristicFound) {
         currentIndex = 0;
+        [OTACheckpointStore removeFlashedImageHashForDevice:[self connectedDeviceID]];
+        
+        // Resume an interrupted upgrade of the same image by programming the last checkpointed row again
+        OTACheckpoint checkpoint;
+        if ([self loadCheckpoint:&checkpoint]) {
+            currentIndex = checkpoint.rowIndex;
+        } else {
+            // A checkpoint of another image stops describing the device flash once this upgrade writes to it
+            [self removeCheckpoint];
+        }
+        ota_transfer_init(&rowTransfer, SEND_DATA, PROGRAM_DATA, bootloaderModel.isWriteWithoutResponseSupported ? SEND_DATA_WINDOW_SIZE : 1);
         [self registerForBootloaderCharacteristicNotifications_v1];
         
         bootloaderModel.fileVersion = [[fileHeaderDict objectForKey:FILE_VERSION] integerValue];
         
         // Set checksum type
         if ([[fileHeaderDict objectForKey:CHECKSUM_TYPE] integerValue]) {
-            [bootloaderModel setCheckSumType:CRC_16];
+            [bootloaderModel setCheckSumType:CY_CHECKSUM_CRC16];
         } else {
-            [bootloaderModel setCheckSumType:CHECK_SUM];
+            [bootloaderModel setCheckSumType:CY_CHECKSUM_SUM];
         }
         
         [self sendEnterBootloaderCmd];
@@ -530,17 +621,16 @@
 }
 
 - (void)sendGetFlashSizeCmd {
-    NSDictionary *rowDataDict = [fileRowDataArray objectAtIndex:currentIndex];
-    NSString *arrayID = [rowDataDict objectForKey:ARRAY_ID];
-    currentArrayID = arrayID;
-    NSDictionary *dataDict = [NSDictionary dictionaryWithObject:arrayID forKey:FLASH_ARRAY_ID];
+    const OTAFirmwareRow *row = [firmwareImage rowAtIndex:currentIndex];
+    currentArrayID = row->arrayID;
+    NSDictionary *dataDict = [NSDictionary dictionaryWithObject:@(row->arrayID) forKey:FLASH_ARRAY_ID];
     NSData *data = [bootloaderModel createPacketWithCommandCode:GET_FLASH_SIZE dataLength:1 data:dataDict];
     [bootloaderModel writeCharacteristicValueWithData:data command:GET_FLASH_SIZE];
 }
 
 - (void)sendVerifyRowCmd {
-    NSDictionary *rowDataDict = [fileRowDataArray objectAtIndex:currentIndex];
-    NSDictionary *dataDict = [NSDictionary dictionaryWithObjectsAndKeys:[rowDataDict objectForKey:ARRAY_ID], FLASH_ARRAY_ID, @(currentRowNumber), FLASH_ROW_NUMBER, nil];
+    const OTAFirmwareRow *row = [firmwareImage rowAtIndex:currentIndex];
+    NSDictionary *dataDict = [NSDictionary dictionaryWithObjectsAndKeys:@(row->arrayID), FLASH_ARRAY_ID, @(currentRowNumber), FLASH_ROW_NUMBER, nil];
     NSData *data = [bootloaderModel createPacketWithCommandCode:VERIFY_ROW dataLength:3 data:dataDict];
     [bootloaderModel writeCharacteristicValueWithData:data command:VERIFY_ROW];
 }
@@ -556,6 +646,14 @@
     [bootloaderModel writeCharacteristicValueWithData:data command:SET_ACTIVE_APP];
 }
 
+- (void)sendSetEivCmdForRowAtIndex:(int)index {
+    const OTAFirmwareRow *row = [firmwareImage rowAtIndex:index];
+    NSData *eivData = [firmwareImage dataForRowAtIndex:index range:NSMakeRange(0, row->dataLength)];
+    NSDictionary *dataDict = [NSDictionary dictionaryWithObject:eivData forKey:ROW_DATA];
+    NSData *data = [bootloaderModel createPacketWithCommandCode_v1:SET_EIV dataLength:row->dataLength data:dataDict];
+    [bootloaderModel writeCharacteristicValueWithData:data command:SET_EIV];
+}
+
 - (void)sendExitBootloaderCmd {
     NSData *data = [bootloaderModel createPacketWithCommandCode:EXIT_BOOTLOADER dataLength:0 data:nil];
     [bootloaderModel writeCharacteristicValueWithData:data command:EXIT_BOOTLOADER];
@@ -569,6 +667,12 @@
  */
 -(void) handleResponseForCommand:(id)command error:(unsigned char)error {
   NSLog(@"Cypress: handleResponseForCommand:%@ error:%d", command, error);
+    if ([command isEqual:@(SEND_DATA)] || [command isEqual:@(PROGRAM_ROW)]) {
+        if (![self handleRowTransferResponseForCommand:command error:error]) {
+            return;
+        }
+    }
+    
     if (SUCCESS == error) {
         if ([command isEqual:@(ENTER_BOOTLOADER)]) {
             // Compare siliconID and siliconRev
@@ -584,7 +688,7 @@
                 [self initView];
             }
         } else if ([command isEqual:@(GET_APP_STATUS)]) {
-            if (currentIndex == 0) {
+            if (currentIndex < firmwareImage.rowCount) {
                 // The 1st time the GetAppStatus is called
                 if (bootloaderModel.isDualAppBootloaderAppActive) {
                     [Utilities alertWithTitle:APP_NAME message:LOCALIZEDSTRING(@"OTAProgrammingOfActiveAppIsNotAllowedError")];
@@ -592,7 +696,7 @@
                 } else {
                     [self sendGetFlashSizeCmd];
                 }
-            } else if (currentIndex == fileRowDataArray.count){
+            } else if (currentIndex == firmwareImage.rowCount){
                 // The 2nd time the GetAppStatus is called
                 if (bootloaderModel.isDualAppBootloaderAppValid) { // It looks strange but it is so. The same logic is used by CySmart PC Tool.
                     [Utilities alertWithTitle:APP_NAME message:LOCALIZEDSTRING(@"OTAInvalidActiveAppProgrammedError")];
@@ -602,12 +706,12 @@
                 }
             }
         } else if ([command isEqual:@(GET_FLASH_SIZE)]) {
-            [self startProgrammingDataRowAtIndex:currentIndex];
-        } else if ([command isEqual:@(SEND_DATA)]) {
-            if (bootloaderModel.isSendRowDataSuccess) {
-                [self programDataRowAtIndex:currentIndex];
+            if (isVerifyingCheckpointRow) {
+                // Verify the row of the checkpoint before resuming after it
+                currentRowNumber = [firmwareImage rowAtIndex:currentIndex]->rowNumber;
+                [self sendVerifyRowCmd];
             } else {
-                [Utilities alertWithTitle:APP_NAME message:LOCALIZEDSTRING(@"OTASendDataCommandFailed")];
+                [self startProgrammingDataRowAtIndex:currentIndex];
             }
         } else if ([command isEqual:@(PROGRAM_ROW)]) {
             // Check row check sum
@@ -618,22 +722,47 @@
                 [self initView];
             }
         } else if ([command isEqual:@(VERIFY_ROW)]) {
-            // Compare checksum received from the device and the one from the file row
-            NSDictionary *rowDataDict = [fileRowDataArray objectAtIndex:currentIndex];
+            // Compare checksum received from the device and the one precomputed for the file row
+            uint8_t deviceChecksum = bootloaderModel.checksum;
+            BOOL isChecksumMatching = [firmwareImage.digest rowDigestAtIndex:currentIndex]->verifyChecksum == deviceChecksum;
+            BOOL isRowProgrammed = YES;
             
-            uint8_t rowChecksum = [Utilities getIntegerFromHexString:[rowDataDict objectForKey:CHECKSUM_OTA]];
-            uint8_t arrayID = [Utilities getIntegerFromHexString:[rowDataDict objectForKey:ARRAY_ID]];
-            uint16_t rowNumber = [Utilities getIntegerFromHexString:[rowDataDict objectForKey:ROW_NUMBER]];
-            uint16_t dataLength = [Utilities getIntegerFromHexString:[rowDataDict objectForKey:DATA_LENGTH]];
+            if (isVerifyingCheckpointRow) {
+                if (!isChecksumMatching) {
+                    // The device flash does not hold the checkpointed data
+                    [self discardCheckpointAndStartOver];
+                    return;
+                }
+                isVerifyingCheckpointRow = NO;
+                
+                // Rows up to the checkpoint were programmed by the interrupted upgrade
+                for (int i = 0; i < currentIndex; i++) {
+                    [deltaPlan markRowWrittenAtIndex:i];
+                }
+            } else if (isVerifyingRowBeforeProgramming) {
+                isVerifyingRowBeforeProgramming = NO;
+                isRowProgrammed = NO;
+                if (!isChecksumMatching) {
+                    // The row differs from the device flash, program it
+                    [self writeDataRowAtIndex:currentIndex];
+                    return;
+                }
+            }
+            [deviceRowChecksums appendBytes:&deviceChecksum length:1];
             
-            uint8_t sum = rowChecksum + arrayID + rowNumber + (rowNumber >> 8) + dataLength + (dataLength >> 8);
-            if (sum == bootloaderModel.checksum) {
+            if (isChecksumMatching) {
+                if (isRowProgrammed) {
+                    [deltaPlan markRowWrittenAtIndex:currentIndex];
+                } else {
+                    [deltaPlan markRowSkippedAtIndex:currentIndex];
+                }
+                [self saveCheckpointForRowAtIndex:currentIndex];
                 currentIndex++;
                 
                 // Update UI with file writing progress
-                float percentage = ((float) currentIndex/fileRowDataArray.count) * 100;
+                float percentage = ((float) currentIndex/firmwareImage.rowCount) * 100;
                 
-                fileWritingProgress = (firmwareFile1NameContainerView.frame.size.width * currentIndex)/fileRowDataArray.count;
+                fileWritingProgress = (firmwareFile1NameContainerView.frame.size.width * currentIndex)/firmwareImage.rowCount;
                 if (isWritingFile1) {
                     firmwareUpgradeProgressLabel1TrailingSpaceConstraint.constant = firmwareFile1NameContainerView.frame.size.width - fileWritingProgress;
                     firmwareFile1UpgradePercentageLabel.text = [NSString stringWithFormat:@"%d %%",(int)percentage];
@@ -647,7 +776,7 @@
                 }];
                 
                 // Writing next line from file
-                if (currentIndex < fileRowDataArray.count) {
+                if (currentIndex < firmwareImage.rowCount) {
                     [self startProgrammingDataRowAtIndex:currentIndex];
                 } else {
                     if (NoChange != activeApp) {
@@ -662,8 +791,10 @@
                 currentIndex = 0;
             }
         } else if ([command isEqual:@(VERIFY_CHECKSUM)]) {
-            if (bootloaderModel.isAppValid) {
+            [self removeCheckpoint];
+            if (OTAImageVerificationPassed == [firmwareImage.digest verifyDeviceRowChecksums:deviceRowChecksums fromRowAtIndex:firstCheckedRowIndex appValid:bootloaderModel.isAppValid mismatchedRows:NULL]) {
                 [currentOperationLabel setText:LOCALIZEDSTRING(@"OTAUpgradeCompletedMessage")];
+                [self recordFlashedImage];
                 
                 if (app_stack_separate == firmwareUpgradeMode && isWritingFile1) {
                     [[CyCBManager sharedManager] setBootloaderFileArray:firmwareFileList];
@@ -690,6 +821,10 @@
                 currentIndex = 0;
             }
         } else if ([command isEqual:@(SET_ACTIVE_APP)]) {
+            // The image was not checked with VERIFY_CHECKSUM, so it is not recorded as flashed
+            [self removeCheckpoint];
+            [self logDeltaReport];
+            
             [[UIApplication sharedApplication] cancelAllLocalNotifications];
             UILocalNotification *n1 = [[UILocalNotification alloc] init];
             n1.fireDate = [NSDate dateWithTimeIntervalSinceNow: 5];
@@ -698,12 +833,30 @@
             
             [self sendExitBootloaderCmd];
         }
+    } else if ([command isEqual:@(VERIFY_ROW)] && isVerifyingCheckpointRow) {
+        // The checkpointed row cannot be read back, so the resume is abandoned rather than the upgrade
+        [self discardCheckpointAndStartOver];
     } else {
         [Utilities alertWithTitle:APP_NAME message:[bootloaderModel errorMessageForErrorCode:error]];
         [self initView];
     }
 }
 
+/*!
+ *  @method discardCheckpointAndStartOver
+ *
+ *  @discussion Drops the checkpoint that could not be verified and programs the image from the first row (CYACD)
+ *
+ */
+-(void) discardCheckpointAndStartOver {
+    isVerifyingCheckpointRow = NO;
+    [self removeCheckpoint];
+    currentIndex = 0;
+    firstCheckedRowIndex = 0;
+    deviceRowChecksums.length = 0;
+    [self startProgrammingDataRowAtIndex:currentIndex];
+}
+
 /*!
  *  @method handleResponseForCommand_v1:error:
  *
@@ -712,6 +865,12 @@
  */
 -(void) handleResponseForCommand_v1:(id)command error:(unsigned char)error {
   NSLog(@"Cypress: handleResponseForCommand_v1: %@ error: %d", command, error);
+    if ([command isEqual:@(SEND_DATA)] || [command isEqual:@(PROGRAM_DATA)]) {
+        if (![self handleRowTransferResponseForCommand:command error:error]) {
+            return;
+        }
+    }
+    
     if (SUCCESS == error) {
         if ([command isEqual:@(ENTER_BOOTLOADER)]) {
             // Compare Silicon ID and Silicon Rev string
@@ -726,13 +885,13 @@
                     appStart = [appInfoDict[APPINFO_APP_START] unsignedIntValue];
                     appSize = [appInfoDict[APPINFO_APP_SIZE] unsignedIntValue];
                 } else {
-                    for (NSDictionary *rowDict in fileRowDataArray) {
-                        if (RowTypeData == [[rowDict objectForKey:ROW_TYPE] unsignedCharValue]) {
-                            uint32_t addr = [[rowDict objectForKey:ADDRESS] unsignedIntValue];
-                            if (addr < appStart) {
-                                appStart = addr;
+                    for (NSUInteger i = 0; i < firmwareImage.rowCount; i++) {
+                        const OTAFirmwareRow *row = [firmwareImage rowAtIndex:i];
+                        if (RowTypeData == row->rowType) {
+                            if (row->address < appStart) {
+                                appStart = row->address;
                             }
-                            appSize += [[rowDict objectForKey:DATA_LENGTH] unsignedIntValue];
+                            appSize += row->dataLength;
                         }
                     }
                 }
@@ -746,31 +905,22 @@
                 [self initView];
             }
         } else if ([command isEqual:@(SET_APP_METADATA)]) {
-            NSDictionary *rowDataDict = [fileRowDataArray objectAtIndex:currentIndex];
-            if (RowTypeEiv == [[rowDataDict objectForKey:ROW_TYPE] unsignedCharValue]) {
-                /* Send SET_EIV command */
-                NSArray *dataArr = [rowDataDict objectForKey:DATA_ARRAY];
-                NSDictionary * dataDict = [NSDictionary dictionaryWithObject:dataArr forKey:ROW_DATA];
-                NSData *data = [bootloaderModel createPacketWithCommandCode_v1:SET_EIV dataLength:[dataArr count] data:dataDict];
-                [bootloaderModel writeCharacteristicValueWithData:data command:SET_EIV];
+            if (RowTypeEiv == [firmwareImage rowAtIndex:currentIndex]->rowType) {
+                [self sendSetEivCmdForRowAtIndex:currentIndex];
             } else {
                 //Process data row
                 [self startProgrammingDataRowAtIndex_v1:currentIndex];
             }
-        } else if ([command isEqual:@(SEND_DATA)]) {
-            /* Send SEND_DATA/PROGRAM_DATA commands */
-            if (bootloaderModel.isSendRowDataSuccess) {
-                [self programDataRowAtIndex_v1:currentIndex];
-            } else {
-                [Utilities alertWithTitle:APP_NAME message:LOCALIZEDSTRING(@"OTASendDataCommandFailed")];
-            }
         } else if ([command isEqual:@(PROGRAM_DATA)] || [command isEqual:@(SET_EIV)]) {
             // Update progress and proceed to next row
             if (bootloaderModel.isProgramRowDataSuccess) {
+                if ([command isEqual:@(PROGRAM_DATA)]) {
+                    [self saveCheckpointForRowAtIndex:currentIndex];
+                }
                 currentIndex++;
                 
-                float percentage = ((float) currentIndex/fileRowDataArray.count) * 100;
-                fileWritingProgress = (firmwareFile1NameContainerView.frame.size.width * currentIndex)/fileRowDataArray.count;
+                float percentage = ((float) currentIndex/firmwareImage.rowCount) * 100;
+                fileWritingProgress = (firmwareFile1NameContainerView.frame.size.width * currentIndex)/firmwareImage.rowCount;
                 if (isWritingFile1) {
                     firmwareUpgradeProgressLabel1TrailingSpaceConstraint.constant = firmwareFile1NameContainerView.frame.size.width - fileWritingProgress;
                     firmwareFile1UpgradePercentageLabel.text = [NSString stringWithFormat:@"%d %%",(int)percentage];
@@ -783,14 +933,9 @@
                     [self.view layoutIfNeeded];
                 }];
                 
-                if (currentIndex < fileRowDataArray.count) {
-                    NSDictionary * rowDataDict = [fileRowDataArray objectAtIndex:currentIndex];
-                    if (RowTypeEiv == [[rowDataDict objectForKey:ROW_TYPE] unsignedCharValue]) {
-                        /* Send SET_EIV command */
-                        NSArray * dataArr = [rowDataDict objectForKey:DATA_ARRAY];
-                        NSDictionary * dataDict = [NSDictionary dictionaryWithObject:dataArr forKey:ROW_DATA];
-                        NSData * data = [bootloaderModel createPacketWithCommandCode_v1:SET_EIV dataLength:[dataArr count] data:dataDict];
-                        [bootloaderModel writeCharacteristicValueWithData:data command:SET_EIV];
+                if (currentIndex < firmwareImage.rowCount) {
+                    if (RowTypeEiv == [firmwareImage rowAtIndex:currentIndex]->rowType) {
+                        [self sendSetEivCmdForRowAtIndex:currentIndex];
                     } else {
                         //Process data row (program next row)
                         [self startProgrammingDataRowAtIndex_v1:currentIndex];
@@ -807,7 +952,8 @@
                 [self initView];
             }
         } else if ([command isEqual:@(VERIFY_APP)]) {
-            if (bootloaderModel.isAppValid) {
+            [self removeCheckpoint];
+            if (OTAImageVerificationPassed == [firmwareImage.digest verifyDeviceRowChecksums:nil fromRowAtIndex:0 appValid:bootloaderModel.isAppValid mismatchedRows:NULL]) {
                 [currentOperationLabel setText:LOCALIZEDSTRING(@"OTAUpgradeCompletedMessage")];
                 
                 // Storing selected files
@@ -843,6 +989,120 @@
     }
 }
 
+/*!
+ *  @method connectedDeviceID
+ *
+ *  @discussion Returns the identifier of the device being upgraded
+ *
+ */
+-(NSString *) connectedDeviceID {
+    return [[[[CyCBManager sharedManager] myPeripheral] identifier] UUIDString];
+}
+
+/*!
+ *  @method loadCheckpoint:
+ *
+ *  @discussion Reads the checkpoint of the connected device for the current image. Returns NO if the upgrade cannot be resumed.
+ *
+ */
+-(BOOL) loadCheckpoint:(OTACheckpoint *)checkpoint {
+    if (![OTACheckpointStore loadCheckpoint:checkpoint forDevice:[self connectedDeviceID] imageHash:firmwareImage.digest.fileHash]) {
+        return NO;
+    }
+    
+    if (checkpoint->rowCount != firmwareImage.rowCount || checkpoint->rowIndex >= firmwareImage.rowCount) {
+        return NO;
+    }
+    
+    // EIV rows (CYACD2) set up the encryption of the rows after them, so these upgrades always start over
+    for (NSUInteger i = 0; i < firmwareImage.rowCount; i++) {
+        if (RowTypeEiv == [firmwareImage rowAtIndex:i]->rowType) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+/*!
+ *  @method saveCheckpointForRowAtIndex:
+ *
+ *  @discussion Stores the row as the last programmed and verified row of the current image on the connected device
+ *
+ */
+-(void) saveCheckpointForRowAtIndex:(int)index {
+    OTACheckpoint checkpoint;
+    checkpoint.rowIndex = index;
+    checkpoint.rowCount = (uint32_t)firmwareImage.rowCount;
+    checkpoint.arrayID = (iFileVersionTypeCYACD2 == bootloaderModel.fileVersion) ? -1 : [firmwareImage rowAtIndex:index]->arrayID;
+    
+    [OTACheckpointStore saveCheckpoint:checkpoint forDevice:[self connectedDeviceID] imageHash:firmwareImage.digest.fileHash];
+}
+
+/*!
+ *  @method removeCheckpoint
+ *
+ *  @discussion Removes the checkpoint of the connected device
+ *
+ */
+-(void) removeCheckpoint {
+    [OTACheckpointStore removeCheckpointForDevice:[self connectedDeviceID]];
+}
+
+/*!
+ *  @method recordFlashedImage
+ *
+ *  @discussion Stores the current image as the one flashed to the connected device and logs the rows skipped versus written (CYACD)
+ *
+ */
+-(void) recordFlashedImage {
+    [OTACheckpointStore saveFlashedImageHash:firmwareImage.digest.fileHash forDevice:[self connectedDeviceID]];
+    [self logDeltaReport];
+}
+
+/*!
+ *  @method logDeltaReport
+ *
+ *  @discussion Logs the rows skipped versus written (CYACD)
+ *
+ */
+-(void) logDeltaReport {
+    if (deltaPlan) {
+        NSString *report = [deltaPlan report];
+        NSLog(@"Cypress: %@", report);
+        [[LoggerHandler logManager] addLogData:[NSString stringWithFormat:@"[%@] %@", [[[CyCBManager sharedManager] myPeripheral] name], report]];
+    }
+}
+
+/*!
+ *  @method handleRowTransferResponseForCommand:error:
+ *
+ *  @discussion Passes the response for a row data command to the transfer engine. Returns YES when the program command of the row succeeded and the response should be handled as usual.
+ *
+ */
+-(BOOL) handleRowTransferResponseForCommand:(id)command error:(unsigned char)error {
+    switch (ota_transfer_on_response(&rowTransfer, [command unsignedCharValue], error)) {
+        case OTA_TRANSFER_ROW_DONE:
+            return YES;
+        case OTA_TRANSFER_CONTINUE:
+            // Send the next packets of the row, or the whole row again after a fallback to stop-and-wait
+            if (iFileVersionTypeCYACD2 == bootloaderModel.fileVersion) {
+                [self programDataRowAtIndex_v1:currentIndex];
+            } else {
+                [self programDataRowAtIndex:currentIndex];
+            }
+            break;
+        case OTA_TRANSFER_FAILED:
+            [Utilities alertWithTitle:APP_NAME message:[bootloaderModel errorMessageForErrorCode:error]];
+            [self initView];
+            break;
+        default:
+            [Utilities alertWithTitle:APP_NAME message:LOCALIZEDSTRING(@"OTAWritingFailedMessage")];
+            [self initView];
+            break;
+    }
+    return NO;
+}
+
 /*!
  *  @method startProgrammingDataRowAtIndex:
  *
@@ -851,29 +1111,35 @@
  */
 -(void) startProgrammingDataRowAtIndex:(int) index
 {
-    NSDictionary *rowDataDict = [fileRowDataArray objectAtIndex:index];
+    const OTAFirmwareRow *row = [firmwareImage rowAtIndex:index];
     
     // Check for change in arrayID
-    if (![[rowDataDict objectForKey:ARRAY_ID] isEqual:currentArrayID])
+    if (row->arrayID != currentArrayID)
     {
         // GET_FLASH_SIZE command is passed to get the new start and end row numbers
-        NSDictionary * rowDataDictionary = [fileRowDataArray objectAtIndex:index];
-        NSDictionary * dict = [NSDictionary dictionaryWithObject:[rowDataDictionary objectForKey:ARRAY_ID] forKey:FLASH_ARRAY_ID];
+        NSDictionary * dict = [NSDictionary dictionaryWithObject:@(row->arrayID) forKey:FLASH_ARRAY_ID];
         NSData * data = [bootloaderModel createPacketWithCommandCode:GET_FLASH_SIZE dataLength:1 data:dict];
         [bootloaderModel writeCharacteristicValueWithData:data command:GET_FLASH_SIZE];
         
-        currentArrayID = [rowDataDictionary objectForKey:ARRAY_ID];
+        currentArrayID = row->arrayID;
         return;
     }
     
     // Check whether the row number falls in the range obtained from the device
-    currentRowNumber = [Utilities getIntegerFromHexString:[rowDataDict objectForKey:ROW_NUMBER]];
+    currentRowNumber = row->rowNumber;
     
     if (currentRowNumber >= bootloaderModel.startRowNumber && currentRowNumber <= bootloaderModel.endRowNumber)
     {
-        /* Write data using PROGRAM_ROW command */
-        currentRowDataArray = [[rowDataDict objectForKey:DATA_ARRAY] mutableCopy];
-        [self programDataRowAtIndex:index];
+        if ([deltaPlan shouldVerifyRowAtIndex:index])
+        {
+            // Compare the row with the device flash first, it is programmed only if it differs
+            isVerifyingRowBeforeProgramming = YES;
+            [self sendVerifyRowCmd];
+        }
+        else
+        {
+            [self writeDataRowAtIndex:index];
+        }
     }
     else
     {
@@ -883,6 +1149,18 @@
     }
 }
 
+/*!
+ *  @method writeDataRowAtIndex:
+ *
+ *  @discussion Method to write the data of a row using SEND_DATA/PROGRAM_ROW commands
+ *
+ */
+-(void) writeDataRowAtIndex:(int) index
+{
+    ota_transfer_begin_row(&rowTransfer, [firmwareImage rowAtIndex:index]->dataLength, maxDataSize);
+    [self programDataRowAtIndex:index];
+}
+
 /*!
  *  @method startProgrammingDataRowAtIndex_v1:
  *
@@ -891,65 +1169,70 @@
  */
 -(void) startProgrammingDataRowAtIndex_v1:(int) index
 {
-    NSDictionary *rowDataDict = [fileRowDataArray objectAtIndex:index];
-    
-    //Write data using SEND_DATA/PROGRAM_ROW commands
-    currentRowDataArray = [[rowDataDict objectForKey:DATA_ARRAY] mutableCopy];
-    currentRowDataAddress = [[rowDataDict objectForKey:ADDRESS] unsignedIntValue];
-    currentRowDataCRC32 = [[rowDataDict objectForKey:CRC_32] unsignedIntValue];
-    
+    //Write data using SEND_DATA/PROGRAM_DATA commands
+    ota_transfer_begin_row(&rowTransfer, [firmwareImage rowAtIndex:index]->dataLength, maxDataSize);
     [self programDataRowAtIndex_v1:index];
 }
 
 /*!
  *  @method programDataRowAtIndex:
  *
- *  @discussion Method to write the data in a row
+ *  @discussion Method to write the data in a row. Sends every packet the transfer engine allows before a response is needed.
  *
  */
 -(void) programDataRowAtIndex:(int)index
 {
-    NSDictionary *rowDataDict = [fileRowDataArray objectAtIndex:index];
+    const OTAFirmwareRow *row = [firmwareImage rowAtIndex:index];
+    ota_transfer_packet packet;
     
-    if (currentRowDataArray.count > maxDataSize)
-    {
-        NSDictionary *dataDict = [NSDictionary dictionaryWithObjectsAndKeys:[currentRowDataArray subarrayWithRange:NSMakeRange(0, maxDataSize)], ROW_DATA, nil];
-        NSData *data = [bootloaderModel createPacketWithCommandCode:SEND_DATA dataLength:maxDataSize data:dataDict];
-        [bootloaderModel writeCharacteristicValueWithData:data command:SEND_DATA];
-        [currentRowDataArray removeObjectsInRange:NSMakeRange(0, maxDataSize)];
-    }
-    else
+    while (ota_transfer_next_packet(&rowTransfer, &packet))
     {
-        //Last packet data
-        NSDictionary *dataDict = [NSDictionary dictionaryWithObjectsAndKeys:[rowDataDict objectForKey:ARRAY_ID],FLASH_ARRAY_ID,
-                                  @(currentRowNumber),FLASH_ROW_NUMBER,
-                                  currentRowDataArray,ROW_DATA, nil];
-        NSData *data = [bootloaderModel createPacketWithCommandCode:PROGRAM_ROW dataLength:currentRowDataArray.count+3 data:dataDict];
-        [bootloaderModel writeCharacteristicValueWithData:data command:PROGRAM_ROW];
+        NSData *rowData = [firmwareImage dataForRowAtIndex:index range:NSMakeRange(packet.offset, packet.length)];
+        if (SEND_DATA == packet.command)
+        {
+            NSDictionary *dataDict = [NSDictionary dictionaryWithObjectsAndKeys:rowData, ROW_DATA, nil];
+            NSData *data = [bootloaderModel createPacketWithCommandCode:SEND_DATA dataLength:packet.length data:dataDict];
+            [bootloaderModel writeCharacteristicValueWithData:data command:SEND_DATA];
+        }
+        else
+        {
+            //Last packet data
+            NSDictionary *dataDict = [NSDictionary dictionaryWithObjectsAndKeys:@(row->arrayID),FLASH_ARRAY_ID,
+                                      @(currentRowNumber),FLASH_ROW_NUMBER,
+                                      rowData,ROW_DATA, nil];
+            NSData *data = [bootloaderModel createPacketWithCommandCode:PROGRAM_ROW dataLength:packet.length+3 data:dataDict];
+            [bootloaderModel writeCharacteristicValueWithData:data command:PROGRAM_ROW];
+        }
     }
 }
 
 /*!
  *  @method programDataRowAtIndex_v1:
  *
- *  @discussion Method to write the data in a row
+ *  @discussion Method to write the data in a row. Sends every packet the transfer engine allows before a response is needed.
  *
  */
 -(void) programDataRowAtIndex_v1:(int)index
 {
-    if (currentRowDataArray.count > maxDataSize)
-    {
-        NSDictionary * dataDict = [NSDictionary dictionaryWithObjectsAndKeys:[currentRowDataArray subarrayWithRange:NSMakeRange(0, maxDataSize)], ROW_DATA, nil];
-        NSData * data = [bootloaderModel createPacketWithCommandCode_v1:SEND_DATA dataLength:maxDataSize data:dataDict];
-        [bootloaderModel writeCharacteristicValueWithData:data command:SEND_DATA];
-        [currentRowDataArray removeObjectsInRange:NSMakeRange(0, maxDataSize)];
-    }
-    else
+    const OTAFirmwareRow *row = [firmwareImage rowAtIndex:index];
+    ota_transfer_packet packet;
+    
+    while (ota_transfer_next_packet(&rowTransfer, &packet))
     {
-        //Last packet data
-        NSDictionary * dataDict = [NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithUnsignedInt:currentRowDataAddress], ADDRESS, [NSNumber numberWithUnsignedInt:currentRowDataCRC32], CRC_32, currentRowDataArray, ROW_DATA, nil];
-        NSData * data = [bootloaderModel createPacketWithCommandCode_v1:PROGRAM_DATA dataLength:(currentRowDataArray.count + 8) data:dataDict];
-        [bootloaderModel writeCharacteristicValueWithData:data command:PROGRAM_DATA];
+        NSData * rowData = [firmwareImage dataForRowAtIndex:index range:NSMakeRange(packet.offset, packet.length)];
+        if (SEND_DATA == packet.command)
+        {
+            NSDictionary * dataDict = [NSDictionary dictionaryWithObjectsAndKeys:rowData, ROW_DATA, nil];
+            NSData * data = [bootloaderModel createPacketWithCommandCode_v1:SEND_DATA dataLength:packet.length data:dataDict];
+            [bootloaderModel writeCharacteristicValueWithData:data command:SEND_DATA];
+        }
+        else
+        {
+            //Last packet data
+            NSDictionary * dataDict = [NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithUnsignedInt:row->address], ADDRESS, [NSNumber numberWithUnsignedInt:[firmwareImage.digest rowDigestAtIndex:index]->crc32], CRC_32, rowData, ROW_DATA, nil];
+            NSData * data = [bootloaderModel createPacketWithCommandCode_v1:PROGRAM_DATA dataLength:(packet.length + 8) data:dataDict];
+            [bootloaderModel writeCharacteristicValueWithData:data command:PROGRAM_DATA];
+        }
     }
 }
 
@@ -961,9 +1244,18 @@
     {
         if (buttonIndex)
         {
+            [[CyCBManager sharedManager] cancelPeripheralUpgrades];
             [self.navigationController popToRootViewControllerAnimated:YES];
         }
     }
+    if (alertView.tag == MULTI_DEVICE_UPGRADE_ALERT_TAG) {
+        if (buttonIndex == 1)
+        {
+            [self upgradeNearbyDevices];
+        }
+        nearbyBootloaderPeripherals = nil;
+        [self initializeFileTransfer];
+    }
     if (alertView.tag == UPGRADE_RESUME_ALERT_TAG) {
         if (buttonIndex == 1)
         {
@@ -985,6 +1277,7 @@
         
         if (buttonIndex == 1) {
             
+            [[CyCBManager sharedManager] cancelPeripheralUpgrades];
             [self.navigationController popToRootViewControllerAnimated:YES];
         }
     }
@@ -40,9 +40,10 @@
 #define NO_RECORD                       @"No Record"
 
 #define READ_LAST_RECORD_COMMAND        @"0106"
-#define READ_ALL_REORDS_COMMAND         @"0101"
 #define DELETE_ALL_STORED_RECORDS       @"0201"
 
+#define DOWNLOAD_PROGRESS_FORMAT        @"%lu records (%.0f/s)"
+
 
 /*!
  *  @class GlucoseViewController
@@ -56,6 +57,7 @@
     GlucoseModel *mGlucoseModel;
     BOOL isCharacteritsticsFound;
     NSDictionary *selectedRecordDict;
+    NSUInteger selectedRecordIndex;
     DropDownView *recordDropDown;
 }
 
@@ -197,7 +199,7 @@
  */
 -(IBAction)dropDownButtonClicked:(UIButton *)sender{
     
-    if (mGlucoseModel.recordNameArray.count > 0) {
+    if (mGlucoseModel.recordCount > 0) {
         [self showDropDownWithButton:sender];
     }
  }
@@ -219,7 +221,7 @@
             recordDropDown = nil;
         }
         
-        recordDropDown = [[DropDownView alloc] initWithDelegate:self titles:mGlucoseModel.recordNameArray onButton:dropDownButton withFrame:_selectedRecordNameTextfield.frame];
+        recordDropDown = [[DropDownView alloc] initWithDelegate:self titles:[mGlucoseModel recordNames] onButton:dropDownButton withFrame:_selectedRecordNameTextfield.frame];
         
         [recordDropDown showView];
         
@@ -248,18 +250,10 @@
             
             if (success)
             {
-                if (mGlucoseModel.glucoseRecords.count > 0) {
-                    NSDictionary *dataDict = [mGlucoseModel getGlucoseData:[mGlucoseModel.glucoseRecords lastObject]];
-                    selectedRecordDict = dataDict;
-                    [self updateGlucoseTextFieldsWithDataDict:dataDict];
-                }
+                [self showLatestRecord];
             }
             _readAllRecordButton.enabled = YES;
             _deleteAllRecordButton.enabled = YES;
-            
-            if (mGlucoseModel.recordNameArray.count > 0) {
-                _selectedRecordNameTextfield.text = [mGlucoseModel.recordNameArray lastObject];
-            }
         }];
         
         [mGlucoseModel writeRACPCharacteristicWithValueString:READ_LAST_RECORD_COMMAND];
@@ -279,23 +273,37 @@
         _readLastRecordButton.enabled = NO;
         _deleteAllRecordButton.enabled = NO;
         
-        [mGlucoseModel updateCharacteristicWithHandler:^(BOOL success, NSError *error) {
+        // Records stream in one by one; only their count is shown until the kit reports the end of them
+        [mGlucoseModel readAllRecordsWithProgressHandler:^(NSUInteger recordCount, double recordsPerSecond, BOOL finished) {
+            
+            if (!finished) {
+                _selectedRecordNameTextfield.text = [NSString stringWithFormat:DOWNLOAD_PROGRESS_FORMAT, (unsigned long)recordCount, recordsPerSecond];
+                return;
+            }
             
             _readLastRecordButton.enabled = YES;
             _deleteAllRecordButton.enabled = YES;
             
-            if (mGlucoseModel.glucoseRecords.count > 0) {
-                NSDictionary *dataDict = [mGlucoseModel getGlucoseData:[mGlucoseModel.glucoseRecords lastObject]];
-                selectedRecordDict = dataDict;
-                [self updateGlucoseTextFieldsWithDataDict:dataDict];
-            }
-            
-            if (mGlucoseModel.recordNameArray.count > 0) {
-                _selectedRecordNameTextfield.text = [mGlucoseModel.recordNameArray lastObject];
-            }
-
+            [self showLatestRecord];
         }];
-        [mGlucoseModel writeRACPCharacteristicWithValueString:READ_ALL_REORDS_COMMAND];
+    }
+}
+
+/*
+ *  @method showLatestRecord
+ *
+ *  @discussion Method to show the record received last
+ *
+ */
+-(void) showLatestRecord{
+    
+    NSUInteger index = mGlucoseModel.latestRecordIndex;
+    if (index != NSNotFound) {
+        NSDictionary *dataDict = [mGlucoseModel glucoseDataAtIndex:index];
+        selectedRecordIndex = index;
+        selectedRecordDict = dataDict;
+        [self updateGlucoseTextFieldsWithDataDict:dataDict];
+        _selectedRecordNameTextfield.text = [mGlucoseModel recordNameAtIndex:index];
     }
 }
 
@@ -343,12 +351,7 @@
 -(IBAction)additionalInfoButtonClicked:(id)sender{
     
     GlucoseContextVC *contextVC = [self.storyboard instantiateViewControllerWithIdentifier:CONTEXT_VC_ID];
-    
-    for (NSData *data in mGlucoseModel.contextInfoArray) {
-        if ([[selectedRecordDict objectForKey:SEQUENCE_NUMBER] integerValue] == [[[mGlucoseModel getGlucoseContextInfoFromData:data] objectForKey:SEQUENCE_NUMBER] integerValue]) {
-            contextVC.glucoseContextDict = [mGlucoseModel getGlucoseContextInfoFromData:data];
-        }
-    }
+    contextVC.glucoseContextDict = [mGlucoseModel contextInfoForRecordAtIndex:selectedRecordIndex];
 
     [self.navigationController pushViewController:contextVC animated:YES];
 }
@@ -416,7 +419,7 @@
                 recordDropDown = nil;
             }
             
-            recordDropDown = [[DropDownView alloc] initWithDelegate:self titles:mGlucoseModel.recordNameArray onButton:_dropDownButton withFrame:_selectedRecordNameTextfield.frame];
+            recordDropDown = [[DropDownView alloc] initWithDelegate:self titles:[mGlucoseModel recordNames] onButton:_dropDownButton withFrame:_selectedRecordNameTextfield.frame];
             
             [recordDropDown showView];
         }
@@ -435,8 +438,9 @@
 -(void)dropDown:(DropDownView*)dropDown valueSelected:(NSString*)value index:(int) index{
     
     _selectedRecordNameTextfield.text = value;
-    NSDictionary *dataDict = [mGlucoseModel getGlucoseData:[mGlucoseModel.glucoseRecords objectAtIndex:index]];
+    NSDictionary *dataDict = [mGlucoseModel glucoseDataAtIndex:index];
     
+    selectedRecordIndex = index;
     selectedRecordDict = dataDict;
     [self updateGlucoseTextFieldsWithDataDict:dataDict];
 }
@@ -447,7 +451,7 @@
 
 -(BOOL)textFieldShouldBeginEditing:(UITextField *)textField{
     
-    if (mGlucoseModel.recordNameArray.count > 0) {
+    if (mGlucoseModel.recordCount > 0) {
         [self showDropDownWithButton:_dropDownButton];
     }
     return NO;
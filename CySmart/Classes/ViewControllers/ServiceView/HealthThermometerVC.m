@@ -48,8 +48,7 @@
     
     KLCPopup* kPopup;
     MyLineChart *myChart;
-    NSMutableArray *healthDataArray;
-    NSMutableArray *timeDataArray;
+    TimeSeries *healthSeries;
     NSDate *startTime;
     NSTimeInterval previousTimeInterval;
     float xAxisTimeInterval;
@@ -70,8 +69,7 @@
     [super viewDidLoad];
     // Do any additional setup after loading the view.
     
-    healthDataArray = [NSMutableArray array];
-    timeDataArray = [NSMutableArray array];
+    healthSeries = [[TimeSeries alloc] initWithCapacity:MAX_GRAPH_POINTS];
     
     [self initializeView];
     
@@ -194,7 +192,6 @@
     if([mThermometerModel.tempStringValue floatValue])
     {
         NSTimeInterval timeInterval = fabs([startTime timeIntervalSinceNow]);
-        [timeDataArray addObject:@(timeInterval)];
         
         if (previousTimeInterval == 0)
         {
@@ -209,18 +206,17 @@
         if ([_temperatureUnitLabel.text isEqualToString:@"°F"])
         {
             float celciusValue = ([mThermometerModel.tempStringValue floatValue] - 32) * 5 / 9;
-            [healthDataArray addObject:@(celciusValue)];
+            [healthSeries appendValue:celciusValue atTime:timeInterval];
         }
         else
         {
-            [healthDataArray addObject:@([mThermometerModel.tempStringValue floatValue])];
+            [healthSeries appendValue:[mThermometerModel.tempStringValue floatValue] atTime:timeInterval];
         }
         
         if(myChart && kPopup.isShowing)
         {
             [myChart setXaxisScaleWithValue:nearbyintf(xAxisTimeInterval)];
-            [self checkGraphPointsCount];
-            [myChart updateLineGraph:timeDataArray Y:healthDataArray ];
+            [myChart updateLineGraphWithSeries:healthSeries];
         }
         previousTimeInterval = timeInterval;
     }
@@ -245,10 +241,9 @@
     [myChart setXaxisScaleWithValue:nearbyintf(xAxisTimeInterval)];
     myChart.delegate = self;
     
-    if([timeDataArray count])
+    if([healthSeries count])
     {
-        [self checkGraphPointsCount];
-        [myChart updateLineGraph:timeDataArray Y:healthDataArray ];
+        [myChart updateLineGraphWithSeries:healthSeries];
         KLCPopupLayout layout = KLCPopupLayoutMake(KLCPopupHorizontalLayoutCenter,
                                                    KLCPopupVerticalLayoutBottom);
         
@@ -266,26 +261,6 @@
 }
 
 
-/*!
- *  @method checkGraphPointsCount
- *
- *  @discussion Method to check the graph plot points
- *
- */
--(void) checkGraphPointsCount{
-    
-    if (timeDataArray.count > MAX_GRAPH_POINTS) {
-        timeDataArray = [[timeDataArray subarrayWithRange:NSMakeRange(timeDataArray.count - MAX_GRAPH_POINTS,MAX_GRAPH_POINTS)] mutableCopy];
-        myChart.chartView.setXmin = YES;
-    }else{
-        myChart.chartView.setXmin = NO;
-    }
-    
-    if (healthDataArray.count > MAX_GRAPH_POINTS) {
-        healthDataArray = [[healthDataArray subarrayWithRange:NSMakeRange(healthDataArray.count - MAX_GRAPH_POINTS,MAX_GRAPH_POINTS)] mutableCopy];
-    }
-}
-
 
 /*!
  *  @method shareScreen:
@@ -45,8 +45,7 @@
 @interface HeartRateMesurementVC ()<lineChartDelegate> {
     HRMModel *hrmModel;
     MyLineChart *myChart;
-    NSMutableArray *hrmDataArray;
-    NSMutableArray *timeDataArray;
+    TimeSeries *hrmSeries;
     KLCPopup *kPopup;
     NSDate *startTime;
     NSTimeInterval previousTimeInterval;
@@ -85,8 +84,7 @@
     // Initialize model
     [self initHRMModel];
     
-    hrmDataArray = [NSMutableArray array];
-    timeDataArray = [NSMutableArray array];
+    hrmSeries = [[TimeSeries alloc] initWithCapacity:MAX_GRAPH_POINTS];
     
     // Initialize time
     startTime = [NSDate date];
@@ -242,12 +240,10 @@
             xAxisTimeInterval = timeInterval - previousTimeInterval;
         }
         
-        [timeDataArray addObject:@(timeInterval)];
-        [hrmDataArray addObject:@(hrmModel.bpmValue)];
+        [hrmSeries appendValue:hrmModel.bpmValue atTime:timeInterval];
         
         if(myChart && kPopup.isShowing) {
-            [self checkGraphPointsCount];
-            [myChart updateLineGraph:timeDataArray Y:hrmDataArray ];
+            [myChart updateLineGraphWithSeries:hrmSeries];
             [myChart setXaxisScaleWithValue:nearbyintf(xAxisTimeInterval)];
         }
         previousTimeInterval = timeInterval;
@@ -285,9 +281,8 @@
     [myChart addXLabel:TIME yLabel:HEART_RATE_YLABEL];
     myChart.delegate = self;
     
-    if([timeDataArray count]) {
-        [self checkGraphPointsCount];
-        [myChart updateLineGraph:timeDataArray Y:hrmDataArray ];
+    if([hrmSeries count]) {
+        [myChart updateLineGraphWithSeries:hrmSeries];
         
         KLCPopupLayout layout = KLCPopupLayoutMake(KLCPopupHorizontalLayoutCenter,
                                                    KLCPopupVerticalLayoutBottom);
@@ -306,25 +301,6 @@
     }
 }
 
-/*!
- *  @method checkGraphPointsCount
- *
- *  @discussion Method to check the graph plot points
- *
- */
--(void) checkGraphPointsCount {
-    if (timeDataArray.count > MAX_GRAPH_POINTS) {
-        timeDataArray = [[timeDataArray subarrayWithRange:NSMakeRange(timeDataArray.count - MAX_GRAPH_POINTS,MAX_GRAPH_POINTS)] mutableCopy];
-        myChart.chartView.setXmin = YES;
-    } else {
-        myChart.chartView.setXmin = NO;
-    }
-    
-    if (hrmDataArray.count > MAX_GRAPH_POINTS) {
-        hrmDataArray = [[hrmDataArray subarrayWithRange:NSMakeRange( hrmDataArray.count - MAX_GRAPH_POINTS,MAX_GRAPH_POINTS)] mutableCopy];
-    }
-}
-
 /*!
  *  @method applicationDidEnterForeground:
  *
@@ -53,8 +53,7 @@
     KLCPopup* kPopup;
     MyLineChart *myChart;
     BOOL isCharacteristicsFound, isStartTimeSet;
-    NSMutableArray *rscDataArray;
-    NSMutableArray *timeDataArray;
+    TimeSeries *rscSeries;
     
     int timerValue;
     NSTimeInterval previousTimeInterval;
@@ -84,8 +83,7 @@
 - (void)viewDidLoad {
     [super viewDidLoad];
     
-    rscDataArray = [NSMutableArray array];
-    timeDataArray = [NSMutableArray array];
+    rscSeries = [[TimeSeries alloc] initWithCapacity:MAX_GRAPH_POINTS];
     // Do any additional setup after loading the view.
     [self initializeView];
     
@@ -231,10 +229,9 @@
     myChart.graphTitleLabel.text = RSC_GRAPH_HEADER;
     [myChart addXLabel:TIME yLabel:RSC_GRAPH_YLABEL];
     myChart.delegate = self;
-    if([timeDataArray count])
+    if([rscSeries count])
     {
-        [self checkGraphPointsCount];
-        [myChart updateLineGraph:timeDataArray Y:rscDataArray ];
+        [myChart updateLineGraphWithSeries:rscSeries];
     
         KLCPopupLayout layout = KLCPopupLayoutMake(KLCPopupHorizontalLayoutCenter,
                                                    KLCPopupVerticalLayoutBottom);
@@ -254,42 +251,6 @@
 }
 
 
-/*!
- *  @method checkGraphPointsCount
- *
- *  @discussion Method to check the graph plot points
- *
- */
--(void) checkGraphPointsCount{
-    
-    if (timeDataArray.count > MAX_GRAPH_POINTS) {
-        timeDataArray = [[timeDataArray subarrayWithRange:NSMakeRange(timeDataArray.count - MAX_GRAPH_POINTS,MAX_GRAPH_POINTS)] mutableCopy];
-        myChart.chartView.setXmin = YES;
-    }else{
-        myChart.chartView.setXmin = NO;
-    }
-    
-    if (rscDataArray.count > MAX_GRAPH_POINTS) {
-        rscDataArray = [[rscDataArray subarrayWithRange:NSMakeRange(rscDataArray.count - MAX_GRAPH_POINTS,MAX_GRAPH_POINTS)] mutableCopy];
-    }
-}
-/*!
- *  @method shareScreen:
- *
- *  @discussion Method to share the screen
- *
- */
-
--(void)shareScreen:(id)sender
-{
-    UIImage *screenShot = [Utilities captureScreenShot];
-    [kPopup dismiss:YES];
-    CGRect rect = [(UIButton *)sender frame];
-    
-    CGRect newRect = CGRectMake(rect.origin.x, rect.origin.y + (self.view.frame.size.height/2), rect.size.width, rect.size.height);
-    [self showActivityPopover:[self saveImage:screenShot] Rect:newRect excludedActivities:nil];
-}
-
 
 /*!
  *  @method startCountingTime:
@@ -366,7 +327,6 @@
     if(mRSCModel.InstantaneousSpeed)
     {
         NSTimeInterval timeInterval = fabs([startTime timeIntervalSinceNow]);
-        [timeDataArray addObject:@(timeInterval)];
         
         if (previousTimeInterval == 0)
         {
@@ -378,11 +338,10 @@
             xAxisTimeInterval = timeInterval - previousTimeInterval;
         }
         
-        [rscDataArray addObject:@(mRSCModel.InstantaneousSpeed)];
+        [rscSeries appendValue:mRSCModel.InstantaneousSpeed atTime:timeInterval];
         if(myChart && kPopup.isShowing)
         {
-            [self checkGraphPointsCount];
-            [myChart updateLineGraph:timeDataArray Y:rscDataArray ];
+            [myChart updateLineGraphWithSeries:rscSeries];
             [myChart setXaxisScaleWithValue:nearbyintf(xAxisTimeInterval)];
         }
         previousTimeInterval = timeInterval;
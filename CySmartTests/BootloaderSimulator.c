@@ -0,0 +1,389 @@
+//
+//  BootloaderSimulator.c
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#include "BootloaderSimulator.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BOOTLOADER_SIM_START_BYTE           0x01
+#define BOOTLOADER_SIM_END_BYTE             0x17
+#define BOOTLOADER_SIM_PACKET_OVERHEAD      7
+#define BOOTLOADER_SIM_PACKET_HEADER        4
+
+#define BOOTLOADER_SIM_VERIFY_CHECKSUM      0x31
+#define BOOTLOADER_SIM_GET_FLASH_SIZE       0x32
+#define BOOTLOADER_SIM_SEND_DATA            0x37
+#define BOOTLOADER_SIM_ENTER_BOOTLOADER     0x38
+#define BOOTLOADER_SIM_PROGRAM_ROW          0x39
+#define BOOTLOADER_SIM_VERIFY_ROW           0x3A
+#define BOOTLOADER_SIM_EXIT_BOOTLOADER      0x3B
+#define BOOTLOADER_SIM_PROGRAM_DATA         0x49
+#define BOOTLOADER_SIM_SET_APP_METADATA     0x4C
+#define BOOTLOADER_SIM_SET_EIV              0x4D
+
+#define BOOTLOADER_SIM_SUCCESS              0x00
+#define BOOTLOADER_SIM_ERR_LENGTH           0x03
+#define BOOTLOADER_SIM_ERR_DATA             0x04
+#define BOOTLOADER_SIM_ERR_COMMAND          0x05
+#define BOOTLOADER_SIM_ERR_CHECKSUM         0x08
+#define BOOTLOADER_SIM_ERR_ARRAY            0x09
+#define BOOTLOADER_SIM_ERR_ROW              0x0A
+
+static uint32_t bootloader_sim_read32(const uint8_t *bytes)
+{
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+/*!
+ *  @function bootloader_sim_respond
+ *
+ *  @discussion Frames a response packet with the status and data. Any error also discards the SEND_DATA buffer, as
+ *  the device does.
+ *
+ */
+static uint32_t bootloader_sim_respond(bootloader_sim *sim, uint8_t status, const uint8_t *data, uint16_t length, uint8_t *response)
+{
+    sim->last_status = status;
+    if (status != BOOTLOADER_SIM_SUCCESS)
+    {
+        sim->errors++;
+        sim->buffered = 0;
+    }
+
+    response[0] = BOOTLOADER_SIM_START_BYTE;
+    response[1] = status;
+    response[2] = (uint8_t)length;
+    response[3] = (uint8_t)(length >> 8);
+    if (length > 0)
+    {
+        memcpy(response + BOOTLOADER_SIM_PACKET_HEADER, data, length);
+    }
+
+    uint32_t index = BOOTLOADER_SIM_PACKET_HEADER + length;
+    uint16_t checksum = cy_packet_checksum(sim->config.checksum_type, response, index);
+    response[index++] = (uint8_t)checksum;
+    response[index++] = (uint8_t)(checksum >> 8);
+    response[index++] = BOOTLOADER_SIM_END_BYTE;
+    return index;
+}
+
+/*!
+ *  @function bootloader_sim_buffer
+ *
+ *  @discussion Appends data to the SEND_DATA buffer. Returns 0 if the buffer overflows.
+ *
+ */
+static int bootloader_sim_buffer(bootloader_sim *sim, const uint8_t *data, uint32_t length)
+{
+    if (sim->buffered + length > BOOTLOADER_SIM_BUFFER_SIZE)
+    {
+        return 0;
+    }
+    memcpy(sim->buffer + sim->buffered, data, length);
+    sim->buffered += length;
+    return 1;
+}
+
+static uint32_t bootloader_sim_enter(bootloader_sim *sim, const uint8_t *data, uint16_t length, uint8_t *response)
+{
+    const bootloader_sim_config *config = &sim->config;
+
+    if (config->file_version == BOOTLOADER_SIM_CYACD2)
+    {
+        if (length != 4)
+        {
+            return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_LENGTH, NULL, 0, response);
+        }
+        if (bootloader_sim_read32(data) != config->product_id)
+        {
+            return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_DATA, NULL, 0, response);
+        }
+    }
+    else if (config->security_key_length > 0)
+    {
+        if (length != config->security_key_length || memcmp(data, config->security_key, length) != 0)
+        {
+            return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_DATA, NULL, 0, response);
+        }
+    }
+    else if (length != 0)
+    {
+        return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_LENGTH, NULL, 0, response);
+    }
+
+    sim->in_bootloader = 1;
+    sim->buffered = 0;
+    sim->app_metadata_set = 0;
+
+    uint8_t info[8] = {
+        (uint8_t)config->silicon_id, (uint8_t)(config->silicon_id >> 8),
+        (uint8_t)(config->silicon_id >> 16), (uint8_t)(config->silicon_id >> 24),
+        config->silicon_rev,
+        (uint8_t)config->bootloader_version, (uint8_t)(config->bootloader_version >> 8),
+        (uint8_t)(config->bootloader_version >> 16)
+    };
+    return bootloader_sim_respond(sim, BOOTLOADER_SIM_SUCCESS, info, sizeof(info), response);
+}
+
+static uint32_t bootloader_sim_cyacd_command(bootloader_sim *sim, uint8_t command, const uint8_t *data, uint16_t length, uint8_t *response)
+{
+    const bootloader_sim_config *config = &sim->config;
+
+    switch (command)
+    {
+        case BOOTLOADER_SIM_GET_FLASH_SIZE:
+        {
+            if (length != 1)
+            {
+                return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_LENGTH, NULL, 0, response);
+            }
+            if (data[0] >= config->array_count)
+            {
+                return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_ARRAY, NULL, 0, response);
+            }
+            uint16_t last_row = (uint16_t)(config->first_row + config->rows_per_array - 1);
+            uint8_t rows[4] = {
+                (uint8_t)config->first_row, (uint8_t)(config->first_row >> 8), (uint8_t)last_row, (uint8_t)(last_row >> 8)
+            };
+            return bootloader_sim_respond(sim, BOOTLOADER_SIM_SUCCESS, rows, sizeof(rows), response);
+        }
+        case BOOTLOADER_SIM_PROGRAM_ROW:
+        case BOOTLOADER_SIM_VERIFY_ROW:
+        {
+            if (length < 3 || (command == BOOTLOADER_SIM_VERIFY_ROW && length != 3))
+            {
+                return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_LENGTH, NULL, 0, response);
+            }
+            if (data[0] >= config->array_count)
+            {
+                return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_ARRAY, NULL, 0, response);
+            }
+            uint8_t *row = bootloader_sim_row(sim, data[0], (uint16_t)(data[1] | (data[2] << 8)));
+            if (row == NULL)
+            {
+                return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_ROW, NULL, 0, response);
+            }
+
+            if (command == BOOTLOADER_SIM_VERIFY_ROW)
+            {
+                uint8_t sum = 0;
+                for (uint16_t i = 0; i < config->row_size; i++)
+                {
+                    sum += row[i];
+                }
+                uint8_t checksum = (uint8_t)-sum;
+                return bootloader_sim_respond(sim, BOOTLOADER_SIM_SUCCESS, &checksum, 1, response);
+            }
+
+            if (!bootloader_sim_buffer(sim, data + 3, length - 3u) || sim->buffered != config->row_size)
+            {
+                return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_LENGTH, NULL, 0, response);
+            }
+            memcpy(row, sim->buffer, config->row_size);
+            sim->buffered = 0;
+            sim->flash_writes++;
+            return bootloader_sim_respond(sim, BOOTLOADER_SIM_SUCCESS, NULL, 0, response);
+        }
+        case BOOTLOADER_SIM_VERIFY_CHECKSUM:
+        {
+            uint8_t sum = config->app_checksum;
+            for (size_t i = 0; i < sim->flash_length; i++)
+            {
+                sum += sim->flash[i];
+            }
+            uint8_t valid = (sum == 0);
+            return bootloader_sim_respond(sim, BOOTLOADER_SIM_SUCCESS, &valid, 1, response);
+        }
+        default:
+            return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_COMMAND, NULL, 0, response);
+    }
+}
+
+static uint32_t bootloader_sim_cyacd2_command(bootloader_sim *sim, uint8_t command, const uint8_t *data, uint16_t length, uint8_t *response)
+{
+    const bootloader_sim_config *config = &sim->config;
+
+    switch (command)
+    {
+        case BOOTLOADER_SIM_SET_APP_METADATA:
+        {
+            if (length != 9)
+            {
+                return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_LENGTH, NULL, 0, response);
+            }
+            uint32_t start = bootloader_sim_read32(data + 1);
+            uint32_t size = bootloader_sim_read32(data + 5);
+            if (bootloader_sim_address(sim, start, size) == NULL)
+            {
+                return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_DATA, NULL, 0, response);
+            }
+            sim->app_id = data[0];
+            sim->app_start = start;
+            sim->app_size = size;
+            sim->app_metadata_set = 1;
+            return bootloader_sim_respond(sim, BOOTLOADER_SIM_SUCCESS, NULL, 0, response);
+        }
+        case BOOTLOADER_SIM_PROGRAM_DATA:
+        {
+            if (length < 8 || !bootloader_sim_buffer(sim, data + 8, length - 8u))
+            {
+                return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_LENGTH, NULL, 0, response);
+            }
+            if (cy_crc32c(sim->buffer, sim->buffered) != bootloader_sim_read32(data + 4))
+            {
+                return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_CHECKSUM, NULL, 0, response);
+            }
+            uint8_t *flash = bootloader_sim_address(sim, bootloader_sim_read32(data), sim->buffered);
+            if (flash == NULL)
+            {
+                return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_DATA, NULL, 0, response);
+            }
+            memcpy(flash, sim->buffer, sim->buffered);
+            sim->buffered = 0;
+            sim->flash_writes++;
+            return bootloader_sim_respond(sim, BOOTLOADER_SIM_SUCCESS, NULL, 0, response);
+        }
+        case BOOTLOADER_SIM_SET_EIV:
+        {
+            if (length != 0 && length != 16)
+            {
+                return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_LENGTH, NULL, 0, response);
+            }
+            return bootloader_sim_respond(sim, BOOTLOADER_SIM_SUCCESS, NULL, 0, response);
+        }
+        case BOOTLOADER_SIM_VERIFY_CHECKSUM:
+        {
+            if (length != 1)
+            {
+                return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_LENGTH, NULL, 0, response);
+            }
+            uint8_t valid = sim->app_metadata_set && data[0] == sim->app_id;
+            if (valid && config->app_crc32 != 0)
+            {
+                valid = cy_crc32c(bootloader_sim_address(sim, sim->app_start, sim->app_size), sim->app_size) == config->app_crc32;
+            }
+            return bootloader_sim_respond(sim, BOOTLOADER_SIM_SUCCESS, &valid, 1, response);
+        }
+        default:
+            return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_COMMAND, NULL, 0, response);
+    }
+}
+
+int bootloader_sim_init(bootloader_sim *sim, const bootloader_sim_config *config)
+{
+    memset(sim, 0, sizeof(*sim));
+    sim->config = *config;
+
+    if (config->file_version == BOOTLOADER_SIM_CYACD2)
+    {
+        sim->flash_length = config->flash_size;
+    }
+    else
+    {
+        sim->flash_length = (size_t)config->array_count * config->rows_per_array * config->row_size;
+    }
+
+    sim->flash = calloc(sim->flash_length > 0 ? sim->flash_length : 1, 1);
+    return sim->flash != NULL;
+}
+
+void bootloader_sim_free(bootloader_sim *sim)
+{
+    free(sim->flash);
+    sim->flash = NULL;
+    sim->flash_length = 0;
+}
+
+uint32_t bootloader_sim_handle(bootloader_sim *sim, const uint8_t *packet, uint32_t length, uint8_t *response)
+{
+    sim->commands++;
+
+    if (length < BOOTLOADER_SIM_PACKET_OVERHEAD || packet[0] != BOOTLOADER_SIM_START_BYTE)
+    {
+        return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_DATA, NULL, 0, response);
+    }
+
+    uint16_t data_length = (uint16_t)(packet[2] | (packet[3] << 8));
+    if ((uint32_t)data_length + BOOTLOADER_SIM_PACKET_OVERHEAD != length || packet[length - 1] != BOOTLOADER_SIM_END_BYTE)
+    {
+        return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_LENGTH, NULL, 0, response);
+    }
+
+    uint16_t checksum = (uint16_t)(packet[length - 3] | (packet[length - 2] << 8));
+    if (checksum != cy_packet_checksum(sim->config.checksum_type, packet, length - 3))
+    {
+        return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_CHECKSUM, NULL, 0, response);
+    }
+
+    uint8_t command = packet[1];
+    const uint8_t *data = packet + BOOTLOADER_SIM_PACKET_HEADER;
+
+    if (command == BOOTLOADER_SIM_ENTER_BOOTLOADER)
+    {
+        return bootloader_sim_enter(sim, data, data_length, response);
+    }
+    if (!sim->in_bootloader)
+    {
+        return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_COMMAND, NULL, 0, response);
+    }
+    if (command == BOOTLOADER_SIM_EXIT_BOOTLOADER)
+    {
+        sim->in_bootloader = 0;
+        sim->buffered = 0;
+        sim->last_status = BOOTLOADER_SIM_SUCCESS;
+        return 0;
+    }
+    if (command == BOOTLOADER_SIM_SEND_DATA)
+    {
+        if (!bootloader_sim_buffer(sim, data, data_length))
+        {
+            return bootloader_sim_respond(sim, BOOTLOADER_SIM_ERR_LENGTH, NULL, 0, response);
+        }
+        return bootloader_sim_respond(sim, BOOTLOADER_SIM_SUCCESS, NULL, 0, response);
+    }
+
+    if (sim->config.file_version == BOOTLOADER_SIM_CYACD2)
+    {
+        return bootloader_sim_cyacd2_command(sim, command, data, data_length, response);
+    }
+    return bootloader_sim_cyacd_command(sim, command, data, data_length, response);
+}
+
+uint8_t *bootloader_sim_row(bootloader_sim *sim, uint8_t array_id, uint16_t row_number)
+{
+    const bootloader_sim_config *config = &sim->config;
+
+    if (config->file_version != BOOTLOADER_SIM_CYACD || array_id >= config->array_count
+        || row_number < config->first_row || row_number - config->first_row >= config->rows_per_array)
+    {
+        return NULL;
+    }
+    size_t row = (size_t)array_id * config->rows_per_array + (row_number - config->first_row);
+    return sim->flash + row * config->row_size;
+}
+
+uint8_t *bootloader_sim_address(bootloader_sim *sim, uint32_t address, uint32_t length)
+{
+    const bootloader_sim_config *config = &sim->config;
+
+    if (config->file_version != BOOTLOADER_SIM_CYACD2 || address < config->flash_address
+        || (uint64_t)(address - config->flash_address) + length > config->flash_size)
+    {
+        return NULL;
+    }
+    return sim->flash + (address - config->flash_address);
+}
+
+int bootloader_sim_is_programming_command(const bootloader_sim *sim, uint8_t command)
+{
+    if (sim->config.file_version == BOOTLOADER_SIM_CYACD2)
+    {
+        return command == BOOTLOADER_SIM_PROGRAM_DATA;
+    }
+    return command == BOOTLOADER_SIM_PROGRAM_ROW;
+}
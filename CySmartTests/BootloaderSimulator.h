@@ -0,0 +1,140 @@
+//
+//  BootloaderSimulator.h
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#ifndef BootloaderSimulator_h
+#define BootloaderSimulator_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include "CyChecksum.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BOOTLOADER_SIM_CYACD            0
+#define BOOTLOADER_SIM_CYACD2           1
+
+/*!
+ *  @discussion Size of the SEND_DATA buffer of the simulated bootloader
+ *
+ */
+#define BOOTLOADER_SIM_BUFFER_SIZE      1024
+
+/*!
+ *  @discussion Largest response packet: ENTER_BOOTLOADER data plus the packet framing
+ *
+ */
+#define BOOTLOADER_SIM_MAX_RESPONSE     16
+
+/*!
+ *  @struct bootloader_sim_config
+ *
+ *  @discussion Device the simulator mimics. CYACD devices expose array_count flash arrays of rows_per_array rows of
+ *  row_size bytes each, numbered from first_row. CYACD2 devices expose flash_size bytes of flash at flash_address.
+ *
+ */
+typedef struct
+{
+    uint8_t file_version;               // BOOTLOADER_SIM_CYACD or BOOTLOADER_SIM_CYACD2
+    uint32_t silicon_id;
+    uint8_t silicon_rev;
+    uint32_t bootloader_version;        // 3 bytes, reported by ENTER_BOOTLOADER
+    cy_checksum_type checksum_type;
+    const uint8_t *security_key;        // CYACD: ENTER_BOOTLOADER must carry this key when security_key_length is non-zero
+    uint8_t security_key_length;
+    uint8_t array_count;
+    uint16_t first_row;
+    uint16_t rows_per_array;
+    uint16_t row_size;
+    uint8_t app_checksum;               // CYACD: VERIFY_CHECKSUM passes when the 8-bit sum of flash plus this is 0
+    uint32_t product_id;                // CYACD2: expected in ENTER_BOOTLOADER
+    uint32_t flash_address;
+    uint32_t flash_size;
+    uint32_t app_crc32;                 // CYACD2: CRC32C of the application VERIFY_APP expects, 0 to skip the check
+} bootloader_sim_config;
+
+/*!
+ *  @struct bootloader_sim
+ *
+ *  @discussion Simulated PSoC bootloader. The simulator parses command packets exactly as the device does, keeps the
+ *  SEND_DATA buffer and the flash contents, and builds the response packets. It has no notion of time; link latency
+ *  and flash write time are modelled by the caller.
+ *
+ */
+typedef struct
+{
+    bootloader_sim_config config;
+    uint8_t *flash;
+    size_t flash_length;
+    uint8_t buffer[BOOTLOADER_SIM_BUFFER_SIZE];
+    uint32_t buffered;
+    uint8_t in_bootloader;
+    uint8_t app_id;
+    uint32_t app_start;
+    uint32_t app_size;
+    uint8_t app_metadata_set;
+    uint32_t commands;
+    uint32_t flash_writes;
+    uint32_t errors;
+    uint8_t last_status;
+} bootloader_sim;
+
+/*!
+ *  @function bootloader_sim_init
+ *
+ *  @discussion Initializes the simulator with erased flash. Returns 0 if the flash cannot be allocated.
+ *
+ */
+int bootloader_sim_init(bootloader_sim *sim, const bootloader_sim_config *config);
+
+/*!
+ *  @function bootloader_sim_free
+ *
+ *  @discussion Releases the flash of the simulator
+ *
+ */
+void bootloader_sim_free(bootloader_sim *sim);
+
+/*!
+ *  @function bootloader_sim_handle
+ *
+ *  @discussion Handles a command packet and writes the response packet to response, which holds at least
+ *  BOOTLOADER_SIM_MAX_RESPONSE bytes. Returns the response length, 0 for EXIT_BOOTLOADER which is not answered.
+ *
+ */
+uint32_t bootloader_sim_handle(bootloader_sim *sim, const uint8_t *packet, uint32_t length, uint8_t *response);
+
+/*!
+ *  @function bootloader_sim_row
+ *
+ *  @discussion Returns the flash contents of a CYACD row, NULL if the row does not exist
+ *
+ */
+uint8_t *bootloader_sim_row(bootloader_sim *sim, uint8_t array_id, uint16_t row_number);
+
+/*!
+ *  @function bootloader_sim_address
+ *
+ *  @discussion Returns the flash contents at a CYACD2 address, NULL if length bytes do not fit in flash
+ *
+ */
+uint8_t *bootloader_sim_address(bootloader_sim *sim, uint32_t address, uint32_t length);
+
+/*!
+ *  @function bootloader_sim_is_programming_command
+ *
+ *  @discussion Returns 1 if the command writes flash, i.e. PROGRAM_ROW or PROGRAM_DATA
+ *
+ */
+int bootloader_sim_is_programming_command(const bootloader_sim *sim, uint8_t command);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BootloaderSimulator_h */
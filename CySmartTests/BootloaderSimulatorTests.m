@@ -0,0 +1,293 @@
+//
+//  BootloaderSimulatorTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "BootLoaderServiceModel.h"
+#import "Constants.h"
+#import "BootloaderSimulator.h"
+#import "OTABenchmark.h"
+
+#define TEST_ROW_COUNT      32
+#define TEST_ROW_SIZE       128
+#define TEST_SILICON_ID     0x04A61193
+#define TEST_SILICON_REV    0x11
+#define TEST_PRODUCT_ID     0x01020304
+#define TEST_FLASH_ADDRESS  0x10000000
+
+@interface BootloaderSimulatorTests : XCTestCase
+{
+    BootLoaderServiceModel *serviceModel;
+    uint8_t rowData[TEST_ROW_COUNT][TEST_ROW_SIZE];
+    ota_session_row rows[TEST_ROW_COUNT];
+    ota_session_image image;
+    bootloader_sim_config cyacdDevice;
+    bootloader_sim_config cyacd2Device;
+    uint8_t response[BOOTLOADER_SIM_MAX_RESPONSE];
+}
+
+@end
+
+@implementation BootloaderSimulatorTests
+
+- (void)setUp {
+    [super setUp];
+    serviceModel = [[BootLoaderServiceModel alloc] init];
+    [serviceModel setCheckSumType:CY_CHECKSUM_SUM];
+
+    uint8_t appSum = 0;
+    for (int i = 0; i < TEST_ROW_COUNT; i++) {
+        uint8_t sum = 0;
+        for (int j = 0; j < TEST_ROW_SIZE; j++) {
+            rowData[i][j] = (uint8_t)(i * 31 + j * 7);
+            sum += rowData[i][j];
+        }
+        appSum += sum;
+        rows[i] = (ota_session_row){ 0, (uint16_t)i, TEST_ROW_SIZE, (uint8_t)-sum, rowData[i] };
+    }
+    image = (ota_session_image){ rows, TEST_ROW_COUNT, TEST_SILICON_ID, TEST_SILICON_REV, CY_CHECKSUM_SUM, NULL, 0 };
+
+    cyacdDevice = (bootloader_sim_config){
+        .file_version = BOOTLOADER_SIM_CYACD,
+        .silicon_id = TEST_SILICON_ID,
+        .silicon_rev = TEST_SILICON_REV,
+        .bootloader_version = 0x010203,
+        .checksum_type = CY_CHECKSUM_SUM,
+        .array_count = 1,
+        .rows_per_array = TEST_ROW_COUNT,
+        .row_size = TEST_ROW_SIZE,
+        .app_checksum = (uint8_t)-appSum,
+    };
+
+    cyacd2Device = (bootloader_sim_config){
+        .file_version = BOOTLOADER_SIM_CYACD2,
+        .silicon_id = TEST_SILICON_ID,
+        .silicon_rev = TEST_SILICON_REV,
+        .checksum_type = CY_CHECKSUM_SUM,
+        .product_id = TEST_PRODUCT_ID,
+        .flash_address = TEST_FLASH_ADDRESS,
+        .flash_size = sizeof(rowData),
+        .app_crc32 = cy_crc32c(rowData, sizeof(rowData)),
+    };
+}
+
+- (uint8_t)send:(NSData *)packet toSimulator:(bootloader_sim *)sim {
+    uint32_t length = bootloader_sim_handle(sim, packet.bytes, (uint32_t)packet.length, response);
+    XCTAssertGreaterThanOrEqual(length, 7u);
+    return response[1];
+}
+
+- (void)testCYACDCommands {
+    bootloader_sim sim;
+    XCTAssertTrue(bootloader_sim_init(&sim, &cyacdDevice));
+
+    NSData *enter = [serviceModel createPacketWithCommandCode:ENTER_BOOTLOADER dataLength:0 data:nil];
+    XCTAssertEqual([self send:enter toSimulator:&sim], SUCCESS);
+    XCTAssertEqual(response[4] | response[5] << 8 | response[6] << 16 | (uint32_t)response[7] << 24, (uint32_t)TEST_SILICON_ID);
+    XCTAssertEqual(response[8], TEST_SILICON_REV);
+
+    NSData *flashSize = [serviceModel createPacketWithCommandCode:GET_FLASH_SIZE dataLength:1 data:@{FLASH_ARRAY_ID: @0}];
+    XCTAssertEqual([self send:flashSize toSimulator:&sim], SUCCESS);
+    XCTAssertEqual(response[6] | response[7] << 8, TEST_ROW_COUNT - 1);
+
+    for (int i = 0; i < TEST_ROW_COUNT; i++) {
+        NSData *head = [NSData dataWithBytes:rowData[i] length:TEST_ROW_SIZE / 2];
+        NSData *tail = [NSData dataWithBytes:rowData[i] + TEST_ROW_SIZE / 2 length:TEST_ROW_SIZE / 2];
+        NSData *send = [serviceModel createPacketWithCommandCode:SEND_DATA dataLength:head.length data:@{ROW_DATA: head}];
+        XCTAssertEqual([self send:send toSimulator:&sim], SUCCESS);
+
+        NSDictionary *row = @{FLASH_ARRAY_ID: @0, FLASH_ROW_NUMBER: @(i), ROW_DATA: tail};
+        NSData *program = [serviceModel createPacketWithCommandCode:PROGRAM_ROW dataLength:tail.length + 3 data:row];
+        XCTAssertEqual([self send:program toSimulator:&sim], SUCCESS);
+
+        NSData *verify = [serviceModel createPacketWithCommandCode:VERIFY_ROW dataLength:3 data:row];
+        XCTAssertEqual([self send:verify toSimulator:&sim], SUCCESS);
+        XCTAssertEqual(response[4], rows[i].verify_checksum);
+    }
+
+    NSData *verifyApp = [serviceModel createPacketWithCommandCode:VERIFY_CHECKSUM dataLength:0 data:nil];
+    XCTAssertEqual([self send:verifyApp toSimulator:&sim], SUCCESS);
+    XCTAssertEqual(response[4], 1);
+
+    NSData *exit = [serviceModel createPacketWithCommandCode:EXIT_BOOTLOADER dataLength:0 data:nil];
+    XCTAssertEqual(bootloader_sim_handle(&sim, exit.bytes, (uint32_t)exit.length, response), 0u);
+    XCTAssertEqual(sim.flash_writes, (uint32_t)TEST_ROW_COUNT);
+    XCTAssertEqual(memcmp(sim.flash, rowData, sizeof(rowData)), 0);
+    bootloader_sim_free(&sim);
+}
+
+- (void)testCYACDRejectsBadCommands {
+    bootloader_sim sim;
+    XCTAssertTrue(bootloader_sim_init(&sim, &cyacdDevice));
+
+    NSData *flashSize = [serviceModel createPacketWithCommandCode:GET_FLASH_SIZE dataLength:1 data:@{FLASH_ARRAY_ID: @0}];
+    XCTAssertEqual([self send:flashSize toSimulator:&sim], ERR_COMMAND, @"Commands before ENTER_BOOTLOADER are rejected");
+
+    NSMutableData *enter = [[serviceModel createPacketWithCommandCode:ENTER_BOOTLOADER dataLength:0 data:nil] mutableCopy];
+    ((uint8_t *)enter.mutableBytes)[4] ^= 0xFF;
+    XCTAssertEqual([self send:enter toSimulator:&sim], ERR_CHECKSUM);
+    ((uint8_t *)enter.mutableBytes)[4] ^= 0xFF;
+    XCTAssertEqual([self send:enter toSimulator:&sim], SUCCESS);
+
+    NSData *array = [serviceModel createPacketWithCommandCode:GET_FLASH_SIZE dataLength:1 data:@{FLASH_ARRAY_ID: @1}];
+    XCTAssertEqual([self send:array toSimulator:&sim], ERR_ARRAY);
+
+    NSData *half = [NSData dataWithBytes:rowData[0] length:TEST_ROW_SIZE / 2];
+    NSDictionary *outOfRange = @{FLASH_ARRAY_ID: @0, FLASH_ROW_NUMBER: @(TEST_ROW_COUNT), ROW_DATA: half};
+    NSData *row = [serviceModel createPacketWithCommandCode:PROGRAM_ROW dataLength:half.length + 3 data:outOfRange];
+    XCTAssertEqual([self send:row toSimulator:&sim], ERR_ROW);
+
+    // A short row is rejected and leaves nothing behind in the SEND_DATA buffer
+    NSData *send = [serviceModel createPacketWithCommandCode:SEND_DATA dataLength:half.length data:@{ROW_DATA: half}];
+    XCTAssertEqual([self send:send toSimulator:&sim], SUCCESS);
+    NSDictionary *shortRow = @{FLASH_ARRAY_ID: @0, FLASH_ROW_NUMBER: @0, ROW_DATA: [half subdataWithRange:NSMakeRange(0, 8)]};
+    NSData *program = [serviceModel createPacketWithCommandCode:PROGRAM_ROW dataLength:8 + 3 data:shortRow];
+    XCTAssertEqual([self send:program toSimulator:&sim], ERR_LENGTH);
+    XCTAssertEqual(sim.buffered, 0u);
+    XCTAssertEqual(sim.flash_writes, 0u);
+    bootloader_sim_free(&sim);
+}
+
+- (void)testCYACDSecurityKey {
+    static const uint8_t key[SECURITY_KEY_NUM_BYTES] = {0x49, 0xA1, 0x34, 0xB6, 0xC7, 0x79};
+    cyacdDevice.security_key = key;
+    cyacdDevice.security_key_length = sizeof(key);
+    bootloader_sim sim;
+    XCTAssertTrue(bootloader_sim_init(&sim, &cyacdDevice));
+
+    NSData *noKey = [serviceModel createPacketWithCommandCode:ENTER_BOOTLOADER dataLength:0 data:nil];
+    XCTAssertEqual([self send:noKey toSimulator:&sim], ERR_DATA);
+
+    NSData *keyData = [NSData dataWithBytes:key length:sizeof(key)];
+    NSData *enter = [serviceModel createPacketWithCommandCode:ENTER_BOOTLOADER dataLength:sizeof(key) data:@{SECURITY_KEY: keyData}];
+    XCTAssertEqual([self send:enter toSimulator:&sim], SUCCESS);
+    bootloader_sim_free(&sim);
+}
+
+- (void)testCYACD2Commands {
+    bootloader_sim sim;
+    XCTAssertTrue(bootloader_sim_init(&sim, &cyacd2Device));
+
+    NSData *wrongProduct = [serviceModel createPacketWithCommandCode_v1:ENTER_BOOTLOADER dataLength:4 data:@{PRODUCT_ID: @(TEST_PRODUCT_ID + 1)}];
+    XCTAssertEqual([self send:wrongProduct toSimulator:&sim], ERR_DATA);
+    NSData *enter = [serviceModel createPacketWithCommandCode_v1:ENTER_BOOTLOADER dataLength:4 data:@{PRODUCT_ID: @(TEST_PRODUCT_ID)}];
+    XCTAssertEqual([self send:enter toSimulator:&sim], SUCCESS);
+
+    NSDictionary *metadata = @{APP_ID: @1, APP_META_APP_START: @(TEST_FLASH_ADDRESS), APP_META_APP_SIZE: @(sizeof(rowData))};
+    NSData *setMetadata = [serviceModel createPacketWithCommandCode_v1:SET_APP_METADATA dataLength:9 data:metadata];
+    XCTAssertEqual([self send:setMetadata toSimulator:&sim], SUCCESS);
+
+    NSData *eiv = [serviceModel createPacketWithCommandCode_v1:SET_EIV dataLength:0 data:@{ROW_DATA: [NSData data]}];
+    XCTAssertEqual([self send:eiv toSimulator:&sim], SUCCESS);
+
+    NSDictionary *verifyData = @{APP_ID: @1};
+    NSData *verify = [serviceModel createPacketWithCommandCode_v1:VERIFY_APP dataLength:1 data:verifyData];
+    XCTAssertEqual([self send:verify toSimulator:&sim], SUCCESS);
+    XCTAssertEqual(response[4], 0, @"Erased flash does not hold the application");
+
+    for (int i = 0; i < TEST_ROW_COUNT; i++) {
+        NSData *head = [NSData dataWithBytes:rowData[i] length:TEST_ROW_SIZE / 2];
+        NSData *tail = [NSData dataWithBytes:rowData[i] + TEST_ROW_SIZE / 2 length:TEST_ROW_SIZE / 2];
+        NSData *send = [serviceModel createPacketWithCommandCode_v1:SEND_DATA dataLength:head.length data:@{ROW_DATA: head}];
+        XCTAssertEqual([self send:send toSimulator:&sim], SUCCESS);
+
+        uint32_t crc = cy_crc32c(rowData[i], TEST_ROW_SIZE);
+        NSDictionary *row = @{ADDRESS: @(TEST_FLASH_ADDRESS + i * TEST_ROW_SIZE), CRC_32: @(crc), ROW_DATA: tail};
+        NSData *program = [serviceModel createPacketWithCommandCode_v1:PROGRAM_DATA dataLength:tail.length + 8 data:row];
+        XCTAssertEqual([self send:program toSimulator:&sim], SUCCESS);
+    }
+
+    XCTAssertEqual([self send:verify toSimulator:&sim], SUCCESS);
+    XCTAssertEqual(response[4], 1);
+    XCTAssertEqual(memcmp(sim.flash, rowData, sizeof(rowData)), 0);
+    bootloader_sim_free(&sim);
+}
+
+- (void)testCYACD2RejectsRowWithBadCRC {
+    bootloader_sim sim;
+    XCTAssertTrue(bootloader_sim_init(&sim, &cyacd2Device));
+    NSData *enter = [serviceModel createPacketWithCommandCode_v1:ENTER_BOOTLOADER dataLength:4 data:@{PRODUCT_ID: @(TEST_PRODUCT_ID)}];
+    XCTAssertEqual([self send:enter toSimulator:&sim], SUCCESS);
+
+    NSData *data = [NSData dataWithBytes:rowData[0] length:TEST_ROW_SIZE];
+    uint32_t crc = cy_crc32c(rowData[0], TEST_ROW_SIZE) ^ 1;
+    NSDictionary *row = @{ADDRESS: @(TEST_FLASH_ADDRESS), CRC_32: @(crc), ROW_DATA: data};
+    NSData *program = [serviceModel createPacketWithCommandCode_v1:PROGRAM_DATA dataLength:data.length + 8 data:row];
+    XCTAssertEqual([self send:program toSimulator:&sim], ERR_CHECKSUM);
+
+    NSDictionary *outside = @{ADDRESS: @(TEST_FLASH_ADDRESS + sizeof(rowData)), CRC_32: @(crc ^ 1), ROW_DATA: data};
+    program = [serviceModel createPacketWithCommandCode_v1:PROGRAM_DATA dataLength:data.length + 8 data:outside];
+    XCTAssertEqual([self send:program toSimulator:&sim], ERR_DATA);
+    XCTAssertEqual(sim.flash_writes, 0u);
+    bootloader_sim_free(&sim);
+}
+
+- (ota_bench_config)benchConfigWithWindow:(uint16_t)window {
+    ota_bench_config config = {
+        .devices = 1,
+        .max_connections = 1,
+        .window = window,
+        .chunk_size = 13,
+        .link = {
+            .connect_us = 1000000,
+            .latency_us = 7500,
+            .mtu = 20,
+            .write_time_us = 3750,
+            .retransmit_us = 15000,
+            .flash_write_us = 12000,
+            .command_us = 200,
+        },
+        .seed = 1,
+    };
+    return config;
+}
+
+- (void)testPipelineUpgradesEveryDevice {
+    ota_bench_config config = [self benchConfigWithWindow:4];
+    config.devices = 6;
+    config.max_connections = 2;
+    config.link.loss_per_million = 20000;
+
+    ota_bench_result result;
+    XCTAssertTrue(ota_bench_run(&config, &image, &cyacdDevice, &result));
+    XCTAssertEqual(result.devices_done, 6u);
+    XCTAssertEqual(result.rows, 6u * TEST_ROW_COUNT);
+    XCTAssertGreaterThan(result.retransmissions, 0u);
+}
+
+- (void)testPipelineReportsWrongSilicon {
+    cyacdDevice.silicon_id ^= 1;
+    ota_bench_config config = [self benchConfigWithWindow:4];
+    ota_bench_result result;
+    XCTAssertFalse(ota_bench_run(&config, &image, &cyacdDevice, &result));
+    XCTAssertEqual(result.devices_failed, 1u);
+}
+
+- (void)testSendDataWindowCutsRoundTrips {
+    ota_bench_config stopAndWait = [self benchConfigWithWindow:1];
+    ota_bench_config pipelined = [self benchConfigWithWindow:4];
+    ota_bench_result stopAndWaitResult, pipelinedResult;
+
+    XCTAssertTrue(ota_bench_run(&stopAndWait, &image, &cyacdDevice, &stopAndWaitResult));
+    XCTAssertTrue(ota_bench_run(&pipelined, &image, &cyacdDevice, &pipelinedResult));
+
+    // Ten commands per row of 128 bytes in chunks of 13 bytes, plus VERIFY_ROW
+    XCTAssertGreaterThan(stopAndWaitResult.round_trips_per_row, 10.0);
+    XCTAssertLessThan(pipelinedResult.round_trips_per_row, 4.0);
+    XCTAssertGreaterThan(pipelinedResult.rows_per_second, stopAndWaitResult.rows_per_second);
+}
+
+- (void)testPipelinePerformance {
+    ota_bench_config config = [self benchConfigWithWindow:4];
+    config.devices = 8;
+    config.max_connections = 4;
+    [self measureBlock:^{
+        ota_bench_result result;
+        ota_bench_run(&config, &image, &cyacdDevice, &result);
+    }];
+}
+
+@end
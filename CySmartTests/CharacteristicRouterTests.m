@@ -0,0 +1,106 @@
+//
+//  CharacteristicRouterTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "CharacteristicRouter.h"
+
+#define TEST_SERVICE_UUID           [CBUUID UUIDWithString:@"00040020-0000-1000-8000-00805F9B0131"]
+#define TEST_READING_UUID           [CBUUID UUIDWithString:@"00040021-0000-1000-8000-00805F9B0131"]
+#define TEST_INTERVAL_UUID          [CBUUID UUIDWithString:@"00040022-0000-1000-8000-00805F9B0131"]
+
+@interface CharacteristicRouterTests : XCTestCase
+{
+    CharacteristicRouter *router;
+    CBMutableService *service;
+    CBMutableCharacteristic *reading;
+    CBMutableCharacteristic *interval;
+}
+
+@end
+
+@implementation CharacteristicRouterTests
+
+- (void)setUp {
+    [super setUp];
+    router = [[CharacteristicRouter alloc] init];
+    service = [[CBMutableService alloc] initWithType:TEST_SERVICE_UUID primary:YES];
+    reading = [[CBMutableCharacteristic alloc] initWithType:TEST_READING_UUID properties:CBCharacteristicPropertyNotify value:nil permissions:CBAttributePermissionsReadable];
+    interval = [[CBMutableCharacteristic alloc] initWithType:TEST_INTERVAL_UUID properties:CBCharacteristicPropertyRead value:nil permissions:CBAttributePermissionsReadable];
+    service.characteristics = @[reading, interval];
+}
+
+- (void)testSubscribersAreResolvedOnDiscovery {
+    __block int readings = 0;
+    [router subscribeToCharacteristic:TEST_READING_UUID ofService:TEST_SERVICE_UUID handler:^(CBCharacteristic *characteristic, NSError *error) {
+        XCTAssertEqual(characteristic, self->reading);
+        readings++;
+    }];
+    XCTAssertFalse([router dispatchValueOfCharacteristic:reading error:nil]);
+
+    [router resolveCharacteristicsOfService:service];
+    XCTAssertTrue([router dispatchValueOfCharacteristic:reading error:nil]);
+    XCTAssertFalse([router dispatchValueOfCharacteristic:interval error:nil]);
+    XCTAssertEqual(readings, 1);
+
+    // A disconnect forgets the characteristics, not the subscriptions
+    [router removeResolvedCharacteristics];
+    XCTAssertFalse([router dispatchValueOfCharacteristic:reading error:nil]);
+    [router resolveCharacteristicsOfService:service];
+    XCTAssertTrue([router dispatchValueOfCharacteristic:reading error:nil]);
+    XCTAssertEqual(readings, 2);
+}
+
+- (void)testEverySubscriberReceivesTheValue {
+    [router resolveCharacteristicsOfService:service];
+
+    __block int first = 0, second = 0;
+    id subscription = [router subscribeToCharacteristic:TEST_READING_UUID ofService:TEST_SERVICE_UUID handler:^(CBCharacteristic *characteristic, NSError *error) {
+        first++;
+    }];
+    [router subscribeToCharacteristic:TEST_READING_UUID ofService:TEST_SERVICE_UUID handler:^(CBCharacteristic *characteristic, NSError *error) {
+        second++;
+    }];
+    [router dispatchValueOfCharacteristic:reading error:nil];
+    XCTAssertEqual(first, 1);
+    XCTAssertEqual(second, 1);
+
+    [router unsubscribe:subscription];
+    [router unsubscribe:subscription];
+    [router dispatchValueOfCharacteristic:reading error:nil];
+    XCTAssertEqual(first, 1);
+    XCTAssertEqual(second, 2);
+}
+
+- (void)testHandlerMayUnsubscribeWhileDispatched {
+    [router resolveCharacteristicsOfService:service];
+
+    __block int calls = 0;
+    __block id subscription = nil;
+    CharacteristicRouter *testRouter = router;
+    subscription = [router subscribeToCharacteristic:TEST_READING_UUID ofService:TEST_SERVICE_UUID handler:^(CBCharacteristic *characteristic, NSError *error) {
+        calls++;
+        [testRouter unsubscribe:subscription];
+    }];
+    XCTAssertTrue([router dispatchValueOfCharacteristic:reading error:nil]);
+    XCTAssertFalse([router dispatchValueOfCharacteristic:reading error:nil]);
+    XCTAssertEqual(calls, 1);
+}
+
+- (void)testDispatchPerformance {
+    __block NSUInteger count = 0;
+    [router subscribeToCharacteristic:TEST_READING_UUID ofService:TEST_SERVICE_UUID handler:^(CBCharacteristic *characteristic, NSError *error) {
+        count++;
+    }];
+    [router resolveCharacteristicsOfService:service];
+    [self measureBlock:^{
+        for (int i = 0; i < 100000; i++) {
+            [self->router dispatchValueOfCharacteristic:self->reading error:nil];
+        }
+    }];
+}
+
+@end
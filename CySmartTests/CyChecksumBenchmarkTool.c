@@ -0,0 +1,192 @@
+//
+//  CyChecksumBenchmarkTool.c
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+/*
+ * Command line benchmark of the CyChecksum functions against the bitwise and nibble table code they replaced. It is
+ * not part of any Xcode target; build and run it from the repository root on any host with a C99 compiler. The CRC32
+ * instructions are used only when the compiler enables them, so build it once with and once without them:
+ *
+ *  cc -std=gnu99 -O2 -ICySmart/Classes/UtilClasses CySmartTests/CyChecksumBenchmarkTool.c \
+ *      CySmart/Classes/UtilClasses/CyChecksum.c -lpthread -o checksum_benchmark && ./checksum_benchmark [megabytes]
+ *
+ *  cc -std=gnu99 -O2 -msse4.2 ...                      (x86-64, SSE4.2)
+ *  cc -std=gnu99 -O2 -march=armv8-a+crc ...            (arm64, CRC extension)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "CyChecksum.h"
+
+// Lengths of a bootloader command packet, a flash row and a firmware image
+static const size_t bench_lengths[] = { 64, 512, 1 << 20 };
+#define BENCH_LENGTH_COUNT  (sizeof(bench_lengths) / sizeof(bench_lengths[0]))
+
+/*
+ * Nibble table CRC-32C of Utilities CRC32ForByteArray:ofSize: before CyChecksum
+ */
+static uint32_t bench_crc32c_nibble(const uint8_t *data, size_t size)
+{
+    enum {
+        g0 = 0x82F63B78,
+        g1 = (g0 >> 1) & 0x7fffffff,
+        g2 = (g0 >> 2) & 0x3fffffff,
+        g3 = (g0 >> 3) & 0x1fffffff,
+    };
+    static const uint32_t table[16] =
+    {
+        0,                  (uint32_t)g3,           (uint32_t)g2,           (uint32_t)(g2^g3),
+        (uint32_t)g1,       (uint32_t)(g1^g3),      (uint32_t)(g1^g2),      (uint32_t)(g1^g2^g3),
+        (uint32_t)g0,       (uint32_t)(g0^g3),      (uint32_t)(g0^g2),      (uint32_t)(g0^g2^g3),
+        (uint32_t)(g0^g1),  (uint32_t)(g0^g1^g3),   (uint32_t)(g0^g1^g2),   (uint32_t)(g0^g1^g2^g3),
+    };
+
+    uint32_t crc = 0xFFFFFFFF;
+    while (size != 0)
+    {
+        --size;
+        crc = crc ^ *data++;
+        crc = (crc >> 4) ^ table[crc & 0xF];
+        crc = (crc >> 4) ^ table[crc & 0xF];
+    }
+    return ~crc;
+}
+
+/*
+ * Bitwise CRC-16 of BootLoaderServiceModel calculateChecksumWithCommandPacket:withSize:type: before CyChecksum
+ */
+static uint16_t bench_crc16_bitwise(const uint8_t *array, size_t size)
+{
+    uint16_t sum = 0xffff;
+    if (size == 0)
+    {
+        return (uint16_t)~sum;
+    }
+
+    do
+    {
+        uint16_t tmp = 0x00ff & *array++;
+        for (int i = 0; i < 8; i++, tmp >>= 1)
+        {
+            sum = ((sum & 0x0001) ^ (tmp & 0x0001)) ? (uint16_t)((sum >> 1) ^ 0x8408) : (uint16_t)(sum >> 1);
+        }
+    }
+    while (--size);
+
+    sum = (uint16_t)~sum;
+    return (uint16_t)((sum << 8) | (sum >> 8));
+}
+
+static uint32_t bench_run_nibble(const uint8_t *data, size_t length)   { return bench_crc32c_nibble(data, length); }
+static uint32_t bench_run_sw(const uint8_t *data, size_t length)       { return cy_crc32c_sw(0, data, length); }
+#if defined(__SSE4_2__) || defined(__ARM_FEATURE_CRC32)
+static uint32_t bench_run_crc32c(const uint8_t *data, size_t length)   { return cy_crc32c(data, length); }
+#endif
+static uint32_t bench_run_bitwise(const uint8_t *data, size_t length)  { return bench_crc16_bitwise(data, length); }
+static uint32_t bench_run_crc16(const uint8_t *data, size_t length)    { return cy_crc16(data, length); }
+static uint32_t bench_run_sum16(const uint8_t *data, size_t length)    { return cy_sum16(data, length); }
+
+typedef struct
+{
+    const char *name;
+    uint32_t (*run)(const uint8_t *data, size_t length);
+    uint32_t (*reference)(const uint8_t *data, size_t length);
+} bench_function;
+
+static const bench_function bench_functions[] = {
+    { "CRC-32C nibble table",   bench_run_nibble,   NULL },
+    { "CRC-32C slice-by-8",     bench_run_sw,       bench_run_nibble },
+#if defined(__SSE4_2__)
+    { "CRC-32C SSE4.2",         bench_run_crc32c,   bench_run_nibble },
+#elif defined(__ARM_FEATURE_CRC32)
+    { "CRC-32C ARMv8 CRC",      bench_run_crc32c,   bench_run_nibble },
+#endif
+    { "CRC-16 bitwise",         bench_run_bitwise,  NULL },
+    { "CRC-16 table",           bench_run_crc16,    bench_run_bitwise },
+    { "sum",                    bench_run_sum16,    NULL },
+};
+
+static double bench_now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t megabytes = argc > 1 ? strtoul(argv[1], NULL, 10) : 64;
+    if (megabytes == 0)
+    {
+        fprintf(stderr, "usage: %s [megabytes per measurement]\n", argv[0]);
+        return 2;
+    }
+
+    // One extra byte so that every length is also measured unaligned
+    size_t capacity = bench_lengths[BENCH_LENGTH_COUNT - 1] + 1;
+    uint8_t *buffer = malloc(capacity);
+    if (buffer == NULL)
+    {
+        return 1;
+    }
+    uint32_t random = 2463534242u;
+    for (size_t i = 0; i < capacity; i++)
+    {
+        random ^= random << 13;
+        random ^= random >> 17;
+        random ^= random << 5;
+        buffer[i] = (uint8_t)random;
+    }
+
+#if defined(__SSE4_2__) || defined(__ARM_FEATURE_CRC32)
+    printf("cy_crc32c uses the CRC32 instructions\n\n");
+#else
+    printf("cy_crc32c uses slice-by-8, build with the CRC32 instructions enabled to measure them\n\n");
+#endif
+    printf("%-24s %10s %10s %10s %10s\n", "MB/s", "64 B", "512 B", "1 MB", "1 MB + 1");
+
+    int failed = 0;
+    for (size_t f = 0; f < sizeof(bench_functions) / sizeof(bench_functions[0]); f++)
+    {
+        const bench_function *function = &bench_functions[f];
+        printf("%-24s", function->name);
+        for (size_t l = 0; l <= BENCH_LENGTH_COUNT; l++)
+        {
+            // The last column is the longest length one byte off alignment
+            size_t length = bench_lengths[l < BENCH_LENGTH_COUNT ? l : BENCH_LENGTH_COUNT - 1];
+            const uint8_t *data = buffer + (l < BENCH_LENGTH_COUNT ? 0 : 1);
+
+            if (function->reference != NULL && function->run(data, length) != function->reference(data, length))
+            {
+                failed = 1;
+                printf(" %10s", "MISMATCH");
+                continue;
+            }
+
+            size_t iterations = megabytes * (1 << 20) / length;
+            if (iterations == 0)
+            {
+                iterations = 1;
+            }
+            volatile uint32_t sink = 0;
+            double start = bench_now();
+            for (size_t i = 0; i < iterations; i++)
+            {
+                sink ^= function->run(data, length);
+            }
+            double elapsed = bench_now() - start;
+            (void)sink;
+            printf(" %10.0f", (double)iterations * length / (1 << 20) / elapsed);
+        }
+        printf("\n");
+    }
+
+    free(buffer);
+    return failed;
+}
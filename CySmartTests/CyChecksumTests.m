@@ -0,0 +1,86 @@
+//
+//  CyChecksumTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "CyChecksum.h"
+
+/*
+ * Golden values computed with the nibble table CRC32 from Utilities and the bitwise checksum from BootLoaderServiceModel
+ */
+static const uint8_t enterBootloaderPacket[] = {0x01, 0x38, 0x00, 0x00};
+static const uint8_t sendDataPacket[] = {0x01, 0x37, 0x04, 0x00, 0xDE, 0xAD, 0xBE, 0xEF};
+
+@interface CyChecksumTests : XCTestCase
+{
+    uint8_t ramp[256];
+}
+
+@end
+
+@implementation CyChecksumTests
+
+- (void)setUp {
+    [super setUp];
+    for (size_t i = 0; i < sizeof(ramp); i++) {
+        ramp[i] = (uint8_t)i;
+    }
+}
+
+- (void)testCRC32C {
+    XCTAssertEqual(cy_crc32c("123456789", 9), (uint32_t)0xE3069283);
+    XCTAssertEqual(cy_crc32c(ramp, sizeof(ramp)), (uint32_t)0x9C44184B);
+    XCTAssertEqual(cy_crc32c(ramp + 3, 37), (uint32_t)0x8D9FE24B);
+    XCTAssertEqual(cy_crc32c(ramp, 0), (uint32_t)0);
+}
+
+- (void)testCRC32CSoftwareMatchesDefault {
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t length = 0; length <= sizeof(ramp) - offset; length++) {
+            XCTAssertEqual(cy_crc32c_sw(0, ramp + offset, length), cy_crc32c(ramp + offset, length));
+        }
+    }
+}
+
+- (void)testCRC32CUpdate {
+    uint32_t crc = cy_crc32c(ramp, 100);
+    XCTAssertEqual(cy_crc32c_update(crc, ramp + 100, 156), cy_crc32c(ramp, sizeof(ramp)));
+}
+
+- (void)testCRC16 {
+    XCTAssertEqual(cy_crc16("123456789", 9), (uint16_t)0x6E90);
+    XCTAssertEqual(cy_crc16(enterBootloaderPacket, sizeof(enterBootloaderPacket)), (uint16_t)0x09A0);
+    XCTAssertEqual(cy_crc16(sendDataPacket, sizeof(sendDataPacket)), (uint16_t)0x271A);
+    XCTAssertEqual(cy_crc16(ramp, sizeof(ramp)), (uint16_t)0x3C30);
+    XCTAssertEqual(cy_crc16(ramp, 0), (uint16_t)0);
+}
+
+- (void)testSum16 {
+    XCTAssertEqual(cy_sum16(enterBootloaderPacket, sizeof(enterBootloaderPacket)), (uint16_t)0xFFC7);
+    XCTAssertEqual(cy_sum16(sendDataPacket, sizeof(sendDataPacket)), (uint16_t)0xFC8C);
+    XCTAssertEqual(cy_sum16(ramp, sizeof(ramp)), (uint16_t)0x8080);
+}
+
+- (void)testPacketChecksumType {
+    XCTAssertEqual(cy_packet_checksum(CY_CHECKSUM_SUM, sendDataPacket, sizeof(sendDataPacket)), (uint16_t)0xFC8C);
+    XCTAssertEqual(cy_packet_checksum(CY_CHECKSUM_CRC16, sendDataPacket, sizeof(sendDataPacket)), (uint16_t)0x271A);
+}
+
+- (void)testCRC32CPerformance {
+    NSMutableData *image = [NSMutableData dataWithLength:1024 * 1024];
+    [self measureBlock:^{
+        cy_crc32c(image.bytes, image.length);
+    }];
+}
+
+- (void)testCRC16Performance {
+    NSMutableData *image = [NSMutableData dataWithLength:1024 * 1024];
+    [self measureBlock:^{
+        cy_crc16(image.bytes, image.length);
+    }];
+}
+
+@end
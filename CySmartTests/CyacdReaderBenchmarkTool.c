@@ -0,0 +1,372 @@
+//
+//  CyacdReaderBenchmarkTool.c
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+/*
+ * Command line benchmark of CyacdReader against the way the CYACD parser worked before it: the whole file read into a
+ * string, split into a string per line, stripped of junk characters into another string, and every row cut into
+ * substrings, one per data byte. The previous parser was Foundation code; it is modelled here with one heap block per
+ * string it created, so the comparison shows the cost of the approach rather than of Foundation itself. It is not part
+ * of any Xcode target; build and run it from the repository root on any host with a C99 compiler:
+ *
+ *  cc -std=gnu99 -O2 -ICySmart/Classes/ViewControllers/OTA CySmartTests/CyacdReaderBenchmarkTool.c \
+ *      CySmart/Classes/ViewControllers/OTA/CyacdReader.c -o cyacd_benchmark && ./cyacd_benchmark [rows] [row_size]
+ *
+ * Without arguments it measures images of 64 KB, 512 KB and 2 MB in rows of 128 bytes; with them, the one image.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "CyacdReader.h"
+
+#define BENCH_RUNS          5
+#define BENCH_ROW_SIZE      128
+#define BENCH_MAX_ROW_SIZE  ((CYACD_MAX_LINE_LENGTH - 13) / 2)   // ':', 10 header and 2 checksum characters
+
+static size_t bench_allocations;
+static size_t bench_allocated;
+
+static void *bench_alloc(size_t size)
+{
+    bench_allocations++;
+    bench_allocated += size;
+    void *block = malloc(size);
+    if (block == NULL)
+    {
+        abort();
+    }
+    return block;
+}
+
+static char *bench_substring(const char *string, size_t start, size_t length)
+{
+    char *copy = bench_alloc(length + 1);
+    memcpy(copy, string + start, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+typedef struct
+{
+    char *array_id;
+    char *row_number;
+    char *data_length;
+    char *checksum;
+    size_t byte_count;
+    char **bytes;
+} bench_legacy_row;
+
+static void bench_legacy_free_row(bench_legacy_row *row)
+{
+    for (size_t i = 0; i < row->byte_count; i++)
+    {
+        free(row->bytes[i]);
+    }
+    free(row->bytes);
+    free(row->array_id);
+    free(row->row_number);
+    free(row->data_length);
+    free(row->checksum);
+}
+
+/*
+ * parseDataRowString: of the previous parser
+ */
+static int bench_legacy_parse_row(const char *line, size_t length, bench_legacy_row *row)
+{
+    row->array_id = bench_substring(line, 0, 2);
+    row->row_number = bench_substring(line, 2, 4);
+    row->data_length = bench_substring(line, 6, 4);
+    char *data = bench_substring(line, 10, length - 12);
+    size_t data_length = length - 12;
+    if (strtoul(row->data_length, NULL, 16) != data_length / 2)
+    {
+        free(data);
+        return 0;
+    }
+
+    row->byte_count = data_length / 2;
+    row->bytes = bench_alloc(row->byte_count * sizeof(char *));
+    for (size_t i = 0; i < row->byte_count; i++)
+    {
+        row->bytes[i] = bench_substring(data, i * 2, 2);
+    }
+    row->checksum = bench_substring(line, length - 2, 2);
+    free(data);
+    return 1;
+}
+
+static int bench_is_line_char(char c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '@' || c == ':' || c == ',';
+}
+
+/*
+ * parseFirmwareFileWithName:path:onFinish: of the previous parser. Returns the number of rows, -1 on error.
+ */
+static long bench_legacy_parse(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        return -1;
+    }
+    fseek(file, 0, SEEK_END);
+    size_t size = (size_t)ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char *contents = bench_alloc(size + 1);
+    size_t read = fread(contents, 1, size, file);
+    fclose(file);
+    contents[read] = '\0';
+
+    // componentsSeparatedByCharactersInSet: and removeEmptyRowsAndJunkDataFromArray:
+    size_t line_count = 0;
+    size_t line_capacity = 64;
+    char **lines = bench_alloc(line_capacity * sizeof(char *));
+    for (size_t start = 0; start <= read; )
+    {
+        size_t end = start;
+        while (end < read && contents[end] != '\n' && contents[end] != '\r')
+        {
+            end++;
+        }
+        if (end > start)
+        {
+            char *line = bench_substring(contents, start, end - start);
+            char *stripped = bench_alloc(end - start + 1);
+            size_t length = 0;
+            for (char *p = line; *p; p++)
+            {
+                if (bench_is_line_char(*p))
+                {
+                    stripped[length++] = *p;
+                }
+            }
+            stripped[length] = '\0';
+            free(line);
+            if (line_count == line_capacity)
+            {
+                line_capacity *= 2;
+                char **grown = bench_alloc(line_capacity * sizeof(char *));
+                memcpy(grown, lines, line_count * sizeof(char *));
+                free(lines);
+                lines = grown;
+            }
+            lines[line_count++] = stripped;
+        }
+        start = end + 1;
+    }
+    free(contents);
+
+    long result = line_count > 0 && strlen(lines[0]) >= 12 ? (long)line_count - 1 : -1;
+    bench_legacy_row *rows = bench_alloc(line_count * sizeof(bench_legacy_row));
+    size_t row_count = 0;
+    for (size_t i = 1; i < line_count && result >= 0; i++)
+    {
+        char *row = bench_alloc(strlen(lines[i]) + 1);
+        size_t length = 0;
+        for (char *p = lines[i]; *p; p++)
+        {
+            if (*p != '@' && *p != ':')
+            {
+                row[length++] = *p;
+            }
+        }
+        row[length] = '\0';
+
+        // The previous parser parsed every row twice, once to validate it and once to keep it
+        bench_legacy_row parsed;
+        if (length <= 20 || !bench_legacy_parse_row(row, length, &parsed))
+        {
+            result = -1;
+        }
+        else
+        {
+            bench_legacy_free_row(&parsed);
+            bench_legacy_parse_row(row, length, &rows[row_count++]);
+        }
+        free(row);
+    }
+
+    for (size_t i = 0; i < row_count; i++)
+    {
+        bench_legacy_free_row(&rows[i]);
+    }
+    free(rows);
+    for (size_t i = 0; i < line_count; i++)
+    {
+        free(lines[i]);
+    }
+    free(lines);
+    return result;
+}
+
+/*
+ * OTAFileParser with CyacdReader: rows decoded straight into a contiguous image. Returns the number of rows, -1 on error.
+ */
+static long bench_reader_parse(const char *path)
+{
+    cyacd_status status;
+    cyacd_reader *reader = cyacd_reader_open(path, CYACD_FORMAT_CYACD, &status);
+    if (reader == NULL)
+    {
+        return -1;
+    }
+    size_t capacity = cyacd_reader_source_size(reader) / 2;
+    uint8_t *image = bench_alloc(capacity);
+    size_t used = 0;
+    long rows = 0;
+
+    cyacd_row row;
+    while (CYACD_OK == (status = cyacd_reader_next(reader, &row)))
+    {
+        if (used + row.data_length > capacity)
+        {
+            break;
+        }
+        memcpy(image + used, row.data, row.data_length);
+        used += row.data_length;
+        rows++;
+    }
+    cyacd_reader_close(reader);
+    free(image);
+    return CYACD_END == status ? rows : -1;
+}
+
+static int bench_write_file(const char *path, uint32_t row_count, uint16_t row_size)
+{
+    FILE *file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        return 0;
+    }
+    fprintf(file, "04A611930100\r\n");
+    uint32_t random = 2463534242u;
+    for (uint32_t i = 0; i < row_count; i++)
+    {
+        uint8_t array_id = (uint8_t)(i / 512);
+        uint16_t row_number = (uint16_t)(i % 512);
+        uint8_t sum = (uint8_t)(array_id + (row_number >> 8) + row_number + (row_size >> 8) + row_size);
+        fprintf(file, ":%02X%04X%04X", array_id, row_number, row_size);
+        for (uint16_t j = 0; j < row_size; j++)
+        {
+            random ^= random << 13;
+            random ^= random >> 17;
+            random ^= random << 5;
+            fprintf(file, "%02X", (uint8_t)random);
+            sum += (uint8_t)random;
+        }
+        fprintf(file, "%02X\r\n", (uint8_t)-sum);
+    }
+    return fclose(file) == 0;
+}
+
+static double bench_now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+typedef struct
+{
+    const char *name;
+    uint32_t row_count;
+} bench_image;
+
+static const bench_image bench_images[] = {
+    { "64 KB",  64 * 1024 / BENCH_ROW_SIZE },
+    { "512 KB", 512 * 1024 / BENCH_ROW_SIZE },
+    { "2 MB",   2 * 1024 * 1024 / BENCH_ROW_SIZE },
+};
+
+static int bench_measure(const char *image, const char *name, long (*parse)(const char *path), const char *path,
+                         uint32_t row_count, size_t file_size)
+{
+    double best = 0;
+    for (int run = 0; run < BENCH_RUNS; run++)
+    {
+        bench_allocations = 0;
+        bench_allocated = 0;
+        double start = bench_now();
+        long rows = parse(path);
+        double elapsed = bench_now() - start;
+        if (rows != (long)row_count)
+        {
+            printf("%-8s %-12s FAILED\n", image, name);
+            return 0;
+        }
+        if (run == 0 || elapsed < best)
+        {
+            best = elapsed;
+        }
+    }
+    printf("%-8s %-12s %10zu %10.2f %10.1f %12zu %12zu\n", image, name, file_size, best * 1e3, file_size / best / (1 << 20),
+           bench_allocations, bench_allocated);
+    return 1;
+}
+
+/*
+ * Writes the image to a temporary file and measures both parsers on it
+ */
+static int bench_run_image(const char *image, uint32_t row_count, uint16_t row_size)
+{
+    char path[] = "/tmp/cyacd_benchmark_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0)
+    {
+        return 0;
+    }
+    close(fd);
+    if (!bench_write_file(path, row_count, row_size))
+    {
+        unlink(path);
+        return 0;
+    }
+    FILE *file = fopen(path, "rb");
+    fseek(file, 0, SEEK_END);
+    size_t file_size = (size_t)ftell(file);
+    fclose(file);
+
+    int ok = bench_measure(image, "previous", bench_legacy_parse, path, row_count, file_size);
+    ok &= bench_measure(image, "CyacdReader", bench_reader_parse, path, row_count, file_size);
+    unlink(path);
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    bench_image custom = { "custom", 0 };
+    const bench_image *images = bench_images;
+    size_t image_count = sizeof(bench_images) / sizeof(bench_images[0]);
+    uint16_t row_size = BENCH_ROW_SIZE;
+    if (argc > 1)
+    {
+        custom.row_count = (uint32_t)strtoul(argv[1], NULL, 10);
+        row_size = argc > 2 ? (uint16_t)strtoul(argv[2], NULL, 10) : BENCH_ROW_SIZE;
+        images = &custom;
+        image_count = 1;
+    }
+    // Array IDs are 8 bits with 512 rows each
+    if (images[0].row_count == 0 || images[0].row_count > 256 * 512 || row_size == 0 || row_size > BENCH_MAX_ROW_SIZE)
+    {
+        fprintf(stderr, "usage: %s [rows <= %d] [row_size <= %d]\n", argv[0], 256 * 512, BENCH_MAX_ROW_SIZE);
+        return 2;
+    }
+
+    printf("Rows of %u bytes, best of %d runs\n\n", row_size, BENCH_RUNS);
+    printf("%-8s %-12s %10s %10s %10s %12s %12s\n", "image", "parser", "file bytes", "ms", "MB/s", "allocations", "bytes");
+    int ok = 1;
+    for (size_t i = 0; i < image_count; i++)
+    {
+        ok &= bench_run_image(images[i].name, images[i].row_count, row_size);
+    }
+    return !ok;
+}
@@ -0,0 +1,224 @@
+//
+//  CyacdReaderTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "CyacdReader.h"
+
+/*
+ * Silicon ID 0x04A61193, revision 0x01, sum checksum. The row checksums are the 2's complement of the row bytes.
+ */
+static const char cyacdFile[] =
+    "04A611930100\r\n"
+    ":00000100050102030405EB\r\n"
+    "\r\n"
+    "  :010002000611121314151676 \x01\r\n";
+
+/*
+ * Version 1, silicon ID 0x04A61193, revision 0x01, CRC-16 checksum, application 2, product ID 0x12345678
+ */
+static const char cyacd2File[] =
+    "019311A60401010278563412\n"
+    "@APPINFO:0x10000000,0x200\n"
+    "@EIV:00112233\n"
+    ":00000010A1A2A3A4\n";
+
+@interface CyacdReaderTests : XCTestCase
+
+@end
+
+@implementation CyacdReaderTests
+
+- (cyacd_reader *)openText:(const char *)text format:(cyacd_format)format status:(cyacd_status *)status {
+    return cyacd_reader_open_memory(text, strlen(text), format, status);
+}
+
+- (cyacd_status)firstRowStatusOfText:(const char *)text format:(cyacd_format)format {
+    cyacd_status status;
+    cyacd_reader *reader = [self openText:text format:format status:&status];
+    XCTAssertTrue(reader != NULL);
+    if (reader == NULL) {
+        return status;
+    }
+    cyacd_row row;
+    status = cyacd_reader_next(reader, &row);
+    cyacd_reader_close(reader);
+    return status;
+}
+
+/*
+ * CYACD data row of length data bytes, as hex
+ */
+- (NSString *)rowWithDataLength:(uint16_t)length {
+    NSMutableString *row = [NSMutableString stringWithFormat:@"000001%04X", length];
+    uint8_t sum = 0x01 + (uint8_t)(length >> 8) + (uint8_t)length;
+    for (uint16_t i = 0; i < length; i++) {
+        [row appendFormat:@"%02X", (uint8_t)i];
+        sum += (uint8_t)i;
+    }
+    [row appendFormat:@"%02X", (uint8_t)-sum];
+    return row;
+}
+
+- (void)testCyacdRows {
+    cyacd_status status;
+    cyacd_reader *reader = [self openText:cyacdFile format:CYACD_FORMAT_CYACD status:&status];
+    XCTAssertEqual(status, CYACD_OK);
+
+    const cyacd_header *header = cyacd_reader_header(reader);
+    XCTAssertEqual(header->file_version, 0);
+    XCTAssertEqual(header->silicon_id, 0x04A61193u);
+    XCTAssertEqual(header->silicon_rev, 0x01);
+    XCTAssertEqual(header->checksum_type, 0x00);
+
+    cyacd_row row;
+    XCTAssertEqual(cyacd_reader_next(reader, &row), CYACD_OK);
+    XCTAssertEqual(row.type, CYACD_ROW_DATA);
+    XCTAssertEqual(row.array_id, 0);
+    XCTAssertEqual(row.row_number, 1);
+    XCTAssertEqual(row.data_length, 5);
+    XCTAssertEqual(row.checksum, 0xEB);
+    const uint8_t first[] = {0x01, 0x02, 0x03, 0x04, 0x05};
+    XCTAssertEqual(memcmp(row.data, first, sizeof(first)), 0);
+
+    // Blank lines, spaces and control characters are skipped
+    XCTAssertEqual(cyacd_reader_next(reader, &row), CYACD_OK);
+    XCTAssertEqual(row.array_id, 1);
+    XCTAssertEqual(row.row_number, 2);
+    XCTAssertEqual(row.data_length, 6);
+    XCTAssertEqual(row.checksum, 0x76);
+    XCTAssertEqual(row.data[5], 0x16);
+
+    XCTAssertEqual(cyacd_reader_next(reader, &row), CYACD_END);
+    cyacd_reader_close(reader);
+}
+
+- (void)testCyacd2Header {
+    cyacd_status status;
+    cyacd_reader *reader = [self openText:cyacd2File format:CYACD_FORMAT_CYACD2 status:&status];
+    XCTAssertEqual(status, CYACD_OK);
+
+    const cyacd_header *header = cyacd_reader_header(reader);
+    XCTAssertEqual(header->file_version, 1);
+    XCTAssertEqual(header->silicon_id, 0x04A61193u);
+    XCTAssertEqual(header->silicon_rev, 0x01);
+    XCTAssertEqual(header->checksum_type, 0x01);
+    XCTAssertEqual(header->app_id, 0x02);
+    XCTAssertEqual(header->product_id, 0x12345678u);
+    cyacd_reader_close(reader);
+
+    // Unsupported version, too short and not hex
+    XCTAssertTrue([self openText:"029311A60401010278563412\n" format:CYACD_FORMAT_CYACD2 status:&status] == NULL);
+    XCTAssertEqual(status, CYACD_ERR_VERSION);
+    XCTAssertTrue([self openText:"019311A604010102785634\n" format:CYACD_FORMAT_CYACD2 status:&status] == NULL);
+    XCTAssertEqual(status, CYACD_ERR_HEADER);
+    XCTAssertTrue([self openText:"019311A60401010278563G12\n" format:CYACD_FORMAT_CYACD2 status:&status] == NULL);
+    XCTAssertEqual(status, CYACD_ERR_HEADER);
+    XCTAssertTrue([self openText:"\r\n\r\n" format:CYACD_FORMAT_CYACD2 status:&status] == NULL);
+    XCTAssertEqual(status, CYACD_ERR_EMPTY);
+}
+
+- (void)testCyacd2Rows {
+    cyacd_reader *reader = [self openText:cyacd2File format:CYACD_FORMAT_CYACD2 status:NULL];
+    cyacd_row row;
+
+    XCTAssertEqual(cyacd_reader_next(reader, &row), CYACD_OK);
+    XCTAssertEqual(row.type, CYACD_ROW_APPINFO);
+    XCTAssertEqual(row.app_start, 0x10000000u);
+    XCTAssertEqual(row.app_size, 0x200u);
+
+    XCTAssertEqual(cyacd_reader_next(reader, &row), CYACD_OK);
+    XCTAssertEqual(row.type, CYACD_ROW_EIV);
+    XCTAssertEqual(row.data_length, 4);
+    XCTAssertEqual(row.data[3], 0x33);
+
+    XCTAssertEqual(cyacd_reader_next(reader, &row), CYACD_OK);
+    XCTAssertEqual(row.type, CYACD_ROW_DATA);
+    XCTAssertEqual(row.address, 0x10000000u);
+    XCTAssertEqual(row.data_length, 4);
+    XCTAssertEqual(row.data[0], 0xA1);
+
+    XCTAssertEqual(cyacd_reader_next(reader, &row), CYACD_END);
+    cyacd_reader_close(reader);
+}
+
+- (void)testMalformedRows {
+    // Not longer than the row header and checksum
+    XCTAssertEqual([self firstRowStatusOfText:"04A611930100\n:0000010004DEADBEEFC4\n" format:CYACD_FORMAT_CYACD], CYACD_ERR_FORMAT);
+    // Data length does not match the data
+    XCTAssertEqual([self firstRowStatusOfText:"04A611930100\n:00000100060102030405EB\n" format:CYACD_FORMAT_CYACD], CYACD_ERR_ROW);
+    // Not a hex digit
+    XCTAssertEqual([self firstRowStatusOfText:"04A611930100\n:00000100050102030G05EB\n" format:CYACD_FORMAT_CYACD], CYACD_ERR_ROW);
+    // Odd number of hex digits
+    XCTAssertEqual([self firstRowStatusOfText:"04A611930100\n:00000100050102030405EB0\n" format:CYACD_FORMAT_CYACD], CYACD_ERR_ROW);
+
+    const char *header = "019311A60401010278563412\n";
+    NSArray *rows = @[@":00000010A1A2A3A\n",          // Odd number of hex digits
+                      @":000000\n",                   // Address cut short
+                      @"@EIV:0011223\n",              // Odd number of hex digits
+                      @"@APPINFO:0x10000000\n",       // No size
+                      @"@APPINFO:0x,0x200\n",         // No start
+                      @"@APPINFO:0x123456789,0x200\n",// Start longer than 32 bits
+                      @"00000010A1A2A3A4\n"];         // No row prefix
+    for (NSString *row in rows) {
+        NSString *text = [NSString stringWithFormat:@"%s%@", header, row];
+        XCTAssertEqual([self firstRowStatusOfText:text.UTF8String format:CYACD_FORMAT_CYACD2], CYACD_ERR_ROW, @"%@", row);
+    }
+}
+
+- (void)testLineLengthLimit {
+    // 4096 bytes, the longest row that fits a line
+    NSString *longest = [self rowWithDataLength:CYACD_MAX_LINE_LENGTH / 2 - 6];
+    XCTAssertEqual(longest.length, (NSUInteger)CYACD_MAX_LINE_LENGTH);
+    NSString *text = [NSString stringWithFormat:@"04A611930100\n%@\n", longest];
+    cyacd_reader *reader = [self openText:text.UTF8String format:CYACD_FORMAT_CYACD status:NULL];
+    cyacd_row row;
+    XCTAssertEqual(cyacd_reader_next(reader, &row), CYACD_OK);
+    XCTAssertEqual(row.data_length, CYACD_MAX_LINE_LENGTH / 2 - 6);
+    XCTAssertEqual(row.data[row.data_length - 1], (uint8_t)(row.data_length - 1));
+    cyacd_reader_close(reader);
+
+    // One character more is rejected rather than cut
+    text = [NSString stringWithFormat:@"04A611930100\n:%@\n", longest];
+    XCTAssertEqual([self firstRowStatusOfText:text.UTF8String format:CYACD_FORMAT_CYACD], CYACD_ERR_LINE_TOO_LONG);
+
+    cyacd_status status;
+    NSMutableString *header = [NSMutableString stringWithString:@"04A611930100"];
+    while (header.length <= CYACD_MAX_LINE_LENGTH) {
+        [header appendString:@"00"];
+    }
+    XCTAssertTrue([self openText:header.UTF8String format:CYACD_FORMAT_CYACD status:&status] == NULL);
+    XCTAssertEqual(status, CYACD_ERR_LINE_TOO_LONG);
+}
+
+- (void)testFileLinesSpanReadBuffers {
+    NSMutableString *text = [NSMutableString stringWithString:@"04A611930100\r\n"];
+    for (int i = 0; i < 64; i++) {
+        [text appendFormat:@":%@\r\n", [self rowWithDataLength:(uint16_t)(100 + i * 37)]];
+    }
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    XCTAssertTrue([text writeToFile:path atomically:NO encoding:NSUTF8StringEncoding error:nil]);
+
+    cyacd_status status;
+    cyacd_reader *reader = cyacd_reader_open(path.fileSystemRepresentation, CYACD_FORMAT_CYACD, &status);
+    XCTAssertEqual(status, CYACD_OK);
+    XCTAssertEqual(cyacd_reader_source_size(reader), (size_t)text.length);
+
+    cyacd_row row;
+    for (int i = 0; i < 64; i++) {
+        XCTAssertEqual(cyacd_reader_next(reader, &row), CYACD_OK);
+        XCTAssertEqual(row.data_length, 100 + i * 37);
+        XCTAssertEqual(row.data[row.data_length - 1], (uint8_t)(row.data_length - 1));
+    }
+    XCTAssertEqual(cyacd_reader_next(reader, &row), CYACD_END);
+    cyacd_reader_close(reader);
+    [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+
+    XCTAssertTrue(cyacd_reader_open(path.fileSystemRepresentation, CYACD_FORMAT_CYACD, &status) == NULL);
+    XCTAssertEqual(status, CYACD_ERR_IO);
+}
+
+@end
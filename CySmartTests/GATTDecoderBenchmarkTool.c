@@ -0,0 +1,160 @@
+//
+//  GATTDecoderBenchmarkTool.c
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+/*
+ * Command line benchmark of the GATTDecoder layouts: the throughput of every characteristic type, decoded one value per
+ * gatt_decode call as the characteristic models do, and all at once through gatt_decode_batch. The values are the ones
+ * of GATTDecoderTests. It is not part of any Xcode target; build and run it from the repository root on any host with
+ * a C99 compiler:
+ *
+ *  cc -std=gnu99 -O2 -ICySmart/Classes/UtilClasses CySmartTests/GATTDecoderBenchmarkTool.c \
+ *      CySmart/Classes/UtilClasses/GATTDecoder.c CySmart/Classes/UtilClasses/GATTMeasurements.c \
+ *      -lm -o gatt_benchmark && ./gatt_benchmark [values]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "GATTMeasurements.h"
+
+#define BENCH_RUNS  5
+
+static const uint8_t bench_heart_rate[] = {0x18, 0x48, 0x10, 0x00, 0x00, 0x04, 0x00, 0x02};
+static const uint8_t bench_csc[] = {0x03, 0x10, 0x00, 0x00, 0x00, 0x00, 0x04, 0x05, 0x00, 0x00, 0x08};
+static const uint8_t bench_rsc[] = {0x03, 0x00, 0x03, 0xA0, 0x64, 0x00, 0xE8, 0x03, 0x00, 0x00};
+static const uint8_t bench_temperature[] = {0x06, 0x6C, 0x01, 0x00, 0xFF, 0xE2, 0x07, 0x03, 0x0F, 0x0A, 0x1E, 0x00, 0x02};
+static const uint8_t bench_blood_pressure[] = {0x1E, 0x78, 0x00, 0x50, 0x00, 0x5A, 0x00, 0xE2, 0x07, 0x03, 0x0F, 0x0A,
+                                               0x1E, 0x00, 0x48, 0x00, 0x01, 0x00, 0x00};
+static const uint8_t bench_glucose[] = {0x1B, 0x07, 0x00, 0xE2, 0x07, 0x03, 0x0F, 0x0A, 0x1E, 0x00, 0x0A, 0x00, 0x5F,
+                                        0xB0, 0x11, 0x00, 0x00};
+static const uint8_t bench_glucose_context[] = {0xDF, 0x07, 0x00, 0x00, 0x01, 0x32, 0xF0, 0x02, 0x11, 0x0A, 0x00, 0x05,
+                                                0x01, 0x10, 0xB0, 0x41, 0x00};
+
+typedef struct
+{
+    const char *name;
+    const gatt_layout *layout;
+    const uint8_t *bytes;
+    uint32_t length;
+} bench_characteristic;
+
+static const bench_characteristic bench_characteristics[] = {
+    { "Heart Rate",             &gatt_heart_rate_measurement_layout,        bench_heart_rate,       sizeof(bench_heart_rate) },
+    { "CSC",                    &gatt_csc_measurement_layout,               bench_csc,              sizeof(bench_csc) },
+    { "RSC",                    &gatt_rsc_measurement_layout,               bench_rsc,              sizeof(bench_rsc) },
+    { "Temperature",            &gatt_temperature_measurement_layout,       bench_temperature,      sizeof(bench_temperature) },
+    { "Blood Pressure",         &gatt_blood_pressure_measurement_layout,    bench_blood_pressure,   sizeof(bench_blood_pressure) },
+    { "Glucose",                &gatt_glucose_measurement_layout,           bench_glucose,          sizeof(bench_glucose) },
+    { "Glucose Context",        &gatt_glucose_context_layout,               bench_glucose_context,  sizeof(bench_glucose_context) },
+};
+
+static double bench_now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/*
+ * Fastest of BENCH_RUNS runs, in seconds
+ */
+static double bench_single(const bench_characteristic *characteristic, const gatt_value *values, uint32_t count, uint8_t *results)
+{
+    double best = 0;
+    for (int run = 0; run < BENCH_RUNS; run++)
+    {
+        double start = bench_now();
+        for (uint32_t i = 0; i < count; i++)
+        {
+            gatt_decode(characteristic->layout, values[i].bytes, values[i].length, results + (size_t)i * characteristic->layout->result_size);
+        }
+        double elapsed = bench_now() - start;
+        if (run == 0 || elapsed < best)
+        {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+static double bench_batch(const bench_characteristic *characteristic, const gatt_value *values, uint32_t count, uint8_t *results)
+{
+    double best = 0;
+    for (int run = 0; run < BENCH_RUNS; run++)
+    {
+        double start = bench_now();
+        gatt_decode_batch(characteristic->layout, values, count, results);
+        double elapsed = bench_now() - start;
+        if (run == 0 || elapsed < best)
+        {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t count = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : 1000000;
+    if (count == 0)
+    {
+        fprintf(stderr, "usage: %s [values per measurement]\n", argv[0]);
+        return 2;
+    }
+
+    size_t result_capacity = 0;
+    for (size_t c = 0; c < sizeof(bench_characteristics) / sizeof(bench_characteristics[0]); c++)
+    {
+        if (bench_characteristics[c].layout->result_size > result_capacity)
+        {
+            result_capacity = bench_characteristics[c].layout->result_size;
+        }
+    }
+    gatt_value *values = malloc(count * sizeof(gatt_value));
+    uint8_t *single_results = malloc(count * result_capacity);
+    uint8_t *batch_results = malloc(count * result_capacity);
+    if (values == NULL || single_results == NULL || batch_results == NULL)
+    {
+        return 1;
+    }
+
+    printf("%u values per measurement, best of %d runs\n\n", count, BENCH_RUNS);
+    printf("%-18s %6s %16s %16s %12s\n", "", "bytes", "gatt_decode M/s", "batch M/s", "batch MB/s");
+
+    int failed = 0;
+    for (size_t c = 0; c < sizeof(bench_characteristics) / sizeof(bench_characteristics[0]); c++)
+    {
+        const bench_characteristic *characteristic = &bench_characteristics[c];
+        for (uint32_t i = 0; i < count; i++)
+        {
+            values[i] = (gatt_value){ characteristic->bytes, characteristic->length };
+        }
+
+        double single = bench_single(characteristic, values, count, single_results);
+        double batch = bench_batch(characteristic, values, count, batch_results);
+
+        // Both ways must decode every value, to the same results
+        size_t results_size = (size_t)count * characteristic->layout->result_size;
+        if (gatt_decode_batch(characteristic->layout, values, count, batch_results) != count ||
+            memcmp(single_results, batch_results, results_size) != 0)
+        {
+            failed = 1;
+            printf("%-18s %6u %16s\n", characteristic->name, characteristic->length, "MISMATCH");
+            continue;
+        }
+
+        printf("%-18s %6u %16.1f %16.1f %12.0f\n", characteristic->name, characteristic->length,
+               count / single / 1e6, count / batch / 1e6, (double)count * characteristic->length / (1 << 20) / batch);
+    }
+
+    free(batch_results);
+    free(single_results);
+    free(values);
+    return failed;
+}
@@ -0,0 +1,195 @@
+//
+//  GATTDecoderTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "GATTMeasurements.h"
+
+#define FUZZ_ROUNDS         50000
+#define BENCHMARK_VALUES    100000
+
+@interface GATTDecoderTests : XCTestCase
+
+@end
+
+@implementation GATTDecoderTests
+
+- (NSArray *)layouts {
+    return @[[NSValue valueWithPointer:&gatt_heart_rate_measurement_layout], [NSValue valueWithPointer:&gatt_csc_measurement_layout],
+             [NSValue valueWithPointer:&gatt_rsc_measurement_layout], [NSValue valueWithPointer:&gatt_temperature_measurement_layout],
+             [NSValue valueWithPointer:&gatt_blood_pressure_measurement_layout], [NSValue valueWithPointer:&gatt_glucose_measurement_layout],
+             [NSValue valueWithPointer:&gatt_glucose_context_layout]];
+}
+
+- (void)testHeartRateMeasurement {
+    const uint8_t value[] = {0x19, 0x2C, 0x01, 0x10, 0x00, 0x00, 0x04, 0x00, 0x02};
+    gatt_heart_rate_measurement measurement;
+    XCTAssertEqual(gatt_decode_heart_rate_measurement(value, sizeof(value), &measurement), (uint32_t)sizeof(value));
+    XCTAssertEqual(measurement.heart_rate, 300u);
+    XCTAssertEqual(measurement.energy_expended, 16u);
+    XCTAssertEqual(measurement.rr_interval_count, 2u);
+    XCTAssertEqual(measurement.rr_intervals[0], 1024);
+    XCTAssertEqual(measurement.rr_intervals[1], 512);
+
+    // The heart rate is 16 bit, but only one byte of it is there
+    XCTAssertEqual(gatt_decode_heart_rate_measurement(value, 2, &measurement), 0u);
+    XCTAssertEqual(measurement.header.present, 0u);
+    XCTAssertEqual(gatt_decode_heart_rate_measurement(value, 0, &measurement), 0u);
+}
+
+- (void)testCyclingAndRunningMeasurements {
+    const uint8_t csc[] = {0x03, 0x10, 0x00, 0x00, 0x00, 0x00, 0x04, 0x05, 0x00, 0x00, 0x08};
+    gatt_csc_measurement cycling;
+    XCTAssertEqual(gatt_decode_csc_measurement(csc, sizeof(csc), &cycling), (uint32_t)sizeof(csc));
+    XCTAssertEqual(cycling.wheel_revolutions, 16u);
+    XCTAssertEqual(cycling.last_wheel_event_time, 1024u);
+    XCTAssertEqual(cycling.crank_revolutions, 5u);
+    XCTAssertEqual(cycling.last_crank_event_time, 2048u);
+
+    const uint8_t rsc[] = {0x02, 0x00, 0x03, 0xA0, 0xE8, 0x03, 0x00, 0x00};
+    gatt_rsc_measurement running;
+    XCTAssertEqual(gatt_decode_rsc_measurement(rsc, sizeof(rsc), &running), (uint32_t)sizeof(rsc));
+    XCTAssertEqual(running.speed, 768u);
+    XCTAssertEqual(running.cadence, 160u);
+    XCTAssertEqual(running.stride_length, 0u);
+    XCTAssertEqual(running.total_distance, 1000u);
+    XCTAssertEqual(gatt_decode_rsc_measurement(rsc, 7, &running), 0u);
+}
+
+- (void)testTemperatureAndBloodPressureMeasurements {
+    const uint8_t temperature[] = {0x06, 0x6C, 0x01, 0x00, 0xFF, 0xE2, 0x07, 0x03, 0x0F, 0x0A, 0x1E, 0x00, 0x02};
+    gatt_temperature_measurement thermometer;
+    XCTAssertEqual(gatt_decode_temperature_measurement(temperature, sizeof(temperature), &thermometer), (uint32_t)sizeof(temperature));
+    XCTAssertEqualWithAccuracy(thermometer.temperature, 36.4f, 0.0001f);
+    XCTAssertEqual(thermometer.time_stamp.year, 2018);
+    XCTAssertEqual(thermometer.time_stamp.day, 15);
+    XCTAssertEqual(thermometer.temperature_type, 2u);
+
+    const uint8_t pressure[] = {0x04, 0x78, 0x00, 0x50, 0x00, 0x5A, 0x00, 0x48, 0x00};
+    gatt_blood_pressure_measurement bloodPressure;
+    XCTAssertEqual(gatt_decode_blood_pressure_measurement(pressure, sizeof(pressure), &bloodPressure), (uint32_t)sizeof(pressure));
+    XCTAssertEqual(bloodPressure.systolic, 120.0f);
+    XCTAssertEqual(bloodPressure.diastolic, 80.0f);
+    XCTAssertEqual(bloodPressure.pulse_rate, 72.0f);
+}
+
+- (void)testGlucoseMeasurementAndContext {
+    const uint8_t measurement[] = {0x13, 0x07, 0x00, 0xE2, 0x07, 0x03, 0x0F, 0x0A, 0x1E, 0x00, 0x0A, 0x00, 0x5F, 0xB0, 0x11};
+    gatt_glucose_measurement glucose;
+    XCTAssertEqual(gatt_decode_glucose_measurement(measurement, sizeof(measurement), &glucose), (uint32_t)sizeof(measurement));
+    XCTAssertEqual(glucose.sequence_number, 7u);
+    XCTAssertEqual(glucose.time_offset, 10);
+    XCTAssertEqualWithAccuracy(glucose.concentration, 0.00095f, 0.000001f);
+    XCTAssertEqual(glucose.type_and_location, 0x11u);
+
+    // Extended flags come before the carbohydrate, HbA1c after the medication
+    const uint8_t context[] = {0xC1, 0x07, 0x00, 0x00, 0x01, 0x32, 0xF0, 0x41, 0x00};
+    gatt_glucose_context info;
+    XCTAssertEqual(gatt_decode_glucose_context(context, sizeof(context), &info), (uint32_t)sizeof(context));
+    XCTAssertEqual(info.carbohydrate_id, 1u);
+    XCTAssertEqualWithAccuracy(info.carbohydrate, 5.0f, 0.0001f);
+    XCTAssertEqual(info.hba1c, 65.0f);
+}
+
+- (void)testSpecialFloatValues {
+    XCTAssertTrue(isnan(gatt_sfloat_value(0x07FF)));
+    XCTAssertTrue(isnan(gatt_sfloat_value(0x0800)));
+    XCTAssertEqual(gatt_sfloat_value(0x07FE), INFINITY);
+    XCTAssertEqual(gatt_sfloat_value(0x0802), -INFINITY);
+    XCTAssertEqualWithAccuracy(gatt_sfloat_value(0xF072), 11.4f, 0.0001f);
+    XCTAssertTrue(isnan(gatt_float_value(0x007FFFFF)));
+    XCTAssertEqualWithAccuracy(gatt_float_value(0xFF00016C), 36.4f, 0.0001f);
+}
+
+- (void)testBatchDecoding {
+    const uint8_t good[] = {0x00, 0x48};
+    const uint8_t truncated[] = {0x01, 0x48};
+    gatt_value values[3] = {{good, sizeof(good)}, {truncated, sizeof(truncated)}, {good, sizeof(good)}};
+    gatt_heart_rate_measurement results[3];
+    XCTAssertEqual(gatt_decode_batch(&gatt_heart_rate_measurement_layout, values, 3, results), 2u);
+    XCTAssertEqual(results[0].heart_rate, 72u);
+    XCTAssertEqual(results[1].header.present, 0u);
+    XCTAssertTrue(results[2].header.present & GATT_DECODED);
+}
+
+// Random values, each in a buffer of its exact size so that a read past the end trips the address sanitizer
+- (void)testRandomValuesAreDecodedWithinBounds {
+    srand48(22);
+    NSArray *layouts = [self layouts];
+    uint8_t result[256], again[256];
+    uint8_t empty = 0;
+    for (int round = 0; round < FUZZ_ROUNDS; round++) {
+        const gatt_layout *layout = [layouts[round % layouts.count] pointerValue];
+        XCTAssertLessThanOrEqual(layout->result_size, sizeof(result));
+        uint32_t length = (uint32_t)(drand48() * 40);
+        // malloc(0) may return NULL, which the decoders need not accept, so an empty value points at a dummy byte
+        uint8_t *bytes = (length != 0) ? malloc(length) : &empty;
+        for (uint32_t index = 0; index < length; index++) {
+            bytes[index] = (uint8_t)(drand48() * 256);
+        }
+
+        uint32_t decoded = gatt_decode(layout, bytes, length, result);
+        XCTAssertLessThanOrEqual(decoded, length);
+        if (decoded != 0) {
+            // The bytes after the last field change nothing
+            XCTAssertEqual(gatt_decode(layout, bytes, decoded, again), decoded);
+            XCTAssertEqual(memcmp(result, again, layout->result_size), 0);
+        }
+        if (length != 0) {
+            free(bytes);
+        }
+    }
+}
+
+- (void)measureLayout:(const gatt_layout *)layout value:(const uint8_t *)bytes length:(uint32_t)length {
+    gatt_value *values = malloc(BENCHMARK_VALUES * sizeof(gatt_value));
+    for (int index = 0; index < BENCHMARK_VALUES; index++) {
+        values[index] = (gatt_value){bytes, length};
+    }
+    void *results = malloc(BENCHMARK_VALUES * (size_t)layout->result_size);
+    [self measureBlock:^{
+        XCTAssertEqual(gatt_decode_batch(layout, values, BENCHMARK_VALUES, results), (uint32_t)BENCHMARK_VALUES);
+    }];
+    free(results);
+    free(values);
+}
+
+- (void)testHeartRateThroughput {
+    const uint8_t value[] = {0x18, 0x48, 0x10, 0x00, 0x00, 0x04, 0x00, 0x02};
+    [self measureLayout:&gatt_heart_rate_measurement_layout value:value length:sizeof(value)];
+}
+
+- (void)testCSCThroughput {
+    const uint8_t value[] = {0x03, 0x10, 0x00, 0x00, 0x00, 0x00, 0x04, 0x05, 0x00, 0x00, 0x08};
+    [self measureLayout:&gatt_csc_measurement_layout value:value length:sizeof(value)];
+}
+
+- (void)testRSCThroughput {
+    const uint8_t value[] = {0x03, 0x00, 0x03, 0xA0, 0x64, 0x00, 0xE8, 0x03, 0x00, 0x00};
+    [self measureLayout:&gatt_rsc_measurement_layout value:value length:sizeof(value)];
+}
+
+- (void)testTemperatureThroughput {
+    const uint8_t value[] = {0x06, 0x6C, 0x01, 0x00, 0xFF, 0xE2, 0x07, 0x03, 0x0F, 0x0A, 0x1E, 0x00, 0x02};
+    [self measureLayout:&gatt_temperature_measurement_layout value:value length:sizeof(value)];
+}
+
+- (void)testBloodPressureThroughput {
+    const uint8_t value[] = {0x1E, 0x78, 0x00, 0x50, 0x00, 0x5A, 0x00, 0xE2, 0x07, 0x03, 0x0F, 0x0A, 0x1E, 0x00, 0x48, 0x00, 0x01, 0x00, 0x00};
+    [self measureLayout:&gatt_blood_pressure_measurement_layout value:value length:sizeof(value)];
+}
+
+- (void)testGlucoseThroughput {
+    const uint8_t value[] = {0x1B, 0x07, 0x00, 0xE2, 0x07, 0x03, 0x0F, 0x0A, 0x1E, 0x00, 0x0A, 0x00, 0x5F, 0xB0, 0x11, 0x00, 0x00};
+    [self measureLayout:&gatt_glucose_measurement_layout value:value length:sizeof(value)];
+}
+
+- (void)testGlucoseContextThroughput {
+    const uint8_t value[] = {0xDF, 0x07, 0x00, 0x00, 0x01, 0x32, 0xF0, 0x02, 0x11, 0x0A, 0x00, 0x05, 0x01, 0x10, 0xB0, 0x41, 0x00};
+    [self measureLayout:&gatt_glucose_context_layout value:value length:sizeof(value)];
+}
+
+@end
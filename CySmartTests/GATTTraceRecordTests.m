@@ -0,0 +1,115 @@
+//
+//  GATTTraceRecordTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <CoreBluetooth/CoreBluetooth.h>
+#import "GATTTraceRecord.h"
+#import "GATTTraceFormatter.h"
+#import "ResourceHandler.h"
+#import "Utilities.h"
+
+@interface GATTTraceRecordTests : XCTestCase
+
+@end
+
+@implementation GATTTraceRecordTests
+
+- (gatt_trace_record)recordWithOperation:(gatt_trace_opcode)operation payload:(NSData *)payload {
+    gatt_trace_record record = {0};
+    record.opcode = operation;
+    memset(record.peripheral, 0x5A, sizeof(record.peripheral));
+    record.service.length = 2;
+    record.service.bytes[0] = 0x18;
+    record.service.bytes[1] = 0x0D;
+    record.characteristic.length = 2;
+    record.characteristic.bytes[0] = 0x2A;
+    record.characteristic.bytes[1] = 0x37;
+    record.payload = payload.bytes;
+    record.payload_length = (uint16_t)payload.length;
+    return record;
+}
+
+- (NSData *)encodeRecord:(const gatt_trace_record *)record {
+    NSMutableData *data = [NSMutableData dataWithLength:gatt_trace_record_size(record)];
+    XCTAssertEqual(gatt_trace_record_encode(record, data.mutableBytes), data.length);
+    return data;
+}
+
+- (void)testRecordRoundTrip {
+    NSData *payload = [NSData dataWithBytes:(uint8_t[]){0x16, 0x48, 0x00, 0xFF} length:4];
+    gatt_trace_record record = [self recordWithOperation:GATT_TRACE_NOTIFY_RESPONSE payload:payload];
+    record.descriptor.length = 16;
+    memset(record.descriptor.bytes, 0xC3, 16);
+    record.status = -7;
+    NSData *encoded = [self encodeRecord:&record];
+
+    gatt_trace_record decoded;
+    XCTAssertTrue(gatt_trace_record_decode(encoded.bytes, encoded.length, &decoded));
+    XCTAssertEqual(decoded.opcode, GATT_TRACE_NOTIFY_RESPONSE);
+    XCTAssertEqual(decoded.status, -7);
+    XCTAssertEqual(memcmp(decoded.peripheral, record.peripheral, 16), 0);
+    XCTAssertEqual(decoded.service.length, 2);
+    XCTAssertEqual(decoded.descriptor.length, 16);
+    XCTAssertEqual(memcmp(decoded.descriptor.bytes, record.descriptor.bytes, 16), 0);
+    XCTAssertEqualObjects([NSData dataWithBytes:decoded.payload length:decoded.payload_length], payload);
+}
+
+- (void)testTruncatedRecordIsRejected {
+    NSData *payload = [NSData dataWithBytes:(uint8_t[]){0x01, 0x02, 0x03} length:3];
+    gatt_trace_record record = [self recordWithOperation:GATT_TRACE_WRITE_REQUEST payload:payload];
+    NSData *encoded = [self encodeRecord:&record];
+
+    gatt_trace_record decoded;
+    for (NSUInteger length = 0; length < encoded.length; length++)
+    {
+        XCTAssertFalse(gatt_trace_record_decode(encoded.bytes, length, &decoded));
+    }
+}
+
+- (void)testHexMatchesLoggerFormat {
+    NSData *data = [NSData dataWithBytes:(uint8_t[]){0x00, 0x0A, 0xB1, 0xFF} length:4];
+    char hex[3 * 4];
+    XCTAssertEqual(gatt_trace_format_hex(data.bytes, data.length, hex), (size_t)11);
+    XCTAssertEqual(strcmp(hex, "00 0A B1 FF"), 0);
+    XCTAssertEqualObjects([Utilities convertDataToLoggerFormat:data], @"[00 0A B1 FF]");
+    XCTAssertEqualObjects([Utilities convertDataToLoggerFormat:[NSData data]], @"[ ]");
+}
+
+- (void)testFormatterRendersLogText {
+    GATTTraceFormatter *formatter = [[GATTTraceFormatter alloc] init];
+    NSString *service = [ResourceHandler getServiceNameForUUID:[CBUUID UUIDWithString:@"180D"]];
+    NSString *characteristic = [ResourceHandler getCharacteristicNameForUUID:[CBUUID UUIDWithString:@"2A37"]];
+
+    NSData *payload = [NSData dataWithBytes:(uint8_t[]){0x16, 0x48} length:2];
+    gatt_trace_record record = [self recordWithOperation:GATT_TRACE_NOTIFY_RESPONSE payload:payload];
+    NSString *expected = [NSString stringWithFormat:@"[%@|%@] %@%@ [16 48]", service, characteristic, NOTIFY_RESPONSE, DATA_SEPERATOR];
+    XCTAssertEqualObjects([formatter eventForRecord:&record], expected);
+
+    record = [self recordWithOperation:GATT_TRACE_START_NOTIFY payload:nil];
+    expected = [NSString stringWithFormat:@"[%@|%@] %@", service, characteristic, START_NOTIFY];
+    XCTAssertEqualObjects([formatter eventForRecord:&record], expected);
+
+    NSData *description = [@"Unlikely error" dataUsingEncoding:NSUTF8StringEncoding];
+    record = [self recordWithOperation:GATT_TRACE_WRITE_RESPONSE payload:description];
+    record.status = 14;
+    expected = [NSString stringWithFormat:@"[%@|%@] %@- %@Unlikely error", service, characteristic, WRITE_REQUEST_STATUS, WRITE_ERROR];
+    XCTAssertEqualObjects([formatter eventForRecord:&record], expected);
+}
+
+- (void)testEncodePerformance {
+    uint8_t value[20] = {0};
+    NSData *payload = [NSData dataWithBytes:value length:sizeof(value)];
+    gatt_trace_record record = [self recordWithOperation:GATT_TRACE_NOTIFY_RESPONSE payload:payload];
+    uint8_t buffer[GATT_TRACE_MAX_HEADER_SIZE + sizeof(value)];
+    [self measureBlock:^{
+        for (int i = 0; i < 1000000; i++) {
+            gatt_trace_record_encode(&record, buffer);
+        }
+    }];
+}
+
+@end
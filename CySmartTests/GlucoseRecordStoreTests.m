@@ -0,0 +1,108 @@
+//
+//  GlucoseRecordStoreTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "GlucoseRecordStore.h"
+
+#define FULL_HISTORY        65536
+
+@interface GlucoseRecordStoreTests : XCTestCase
+{
+    glucose_record_store store;
+}
+
+@end
+
+@implementation GlucoseRecordStoreTests
+
+- (void)setUp {
+    [super setUp];
+    XCTAssertTrue(glucose_store_init(&store));
+}
+
+- (void)tearDown {
+    glucose_store_free(&store);
+    [super tearDown];
+}
+
+- (gatt_glucose_measurement)measurementWithSequenceNumber:(uint16_t)sequenceNumber {
+    gatt_glucose_measurement measurement = {0};
+    measurement.sequence_number = sequenceNumber;
+    measurement.base_time = (gatt_date_time){2018, 3, 15, 10, 30, 0};
+    return measurement;
+}
+
+- (void)testCalendarSeconds {
+    gatt_date_time epoch = {1970, 1, 1, 0, 0, 0};
+    XCTAssertEqual(glucose_calendar_seconds(&epoch), 0);
+    gatt_date_time leapDay = {2000, 2, 29, 0, 0, 0};
+    XCTAssertEqual(glucose_calendar_seconds(&leapDay), 951782400);
+    gatt_date_time measured = {2018, 3, 15, 10, 30, 0};
+    XCTAssertEqual(glucose_calendar_seconds(&measured), 1521109800);
+}
+
+- (void)testRecordsAreIndexedBySequenceNumber {
+    for (uint16_t i = 0; i < 5000; i++) {
+        gatt_glucose_measurement measurement = [self measurementWithSequenceNumber:i * 13];
+        measurement.time_offset = -i;
+        XCTAssertEqual(glucose_store_add_measurement(&store, &measurement), (int32_t)i);
+    }
+    XCTAssertEqual(store.record_count, 5000u);
+    for (uint16_t i = 0; i < 5000; i++) {
+        XCTAssertEqual(glucose_store_find(&store, i * 13), (int32_t)i);
+    }
+    XCTAssertEqual(glucose_store_find(&store, 1), GLUCOSE_NO_RECORD);
+    XCTAssertEqual(store.records[2].time, 1521109800 - 120);
+
+    // A record received again replaces the earlier one and becomes the latest
+    gatt_glucose_measurement again = [self measurementWithSequenceNumber:13];
+    again.concentration = 1;
+    XCTAssertEqual(glucose_store_add_measurement(&store, &again), 1);
+    XCTAssertEqual(store.record_count, 5000u);
+    XCTAssertEqual(store.latest, 1);
+    XCTAssertEqual(store.records[1].measurement.concentration, 1.0f);
+
+    glucose_store_clear(&store);
+    XCTAssertEqual(store.record_count, 0u);
+    XCTAssertEqual(store.latest, GLUCOSE_NO_RECORD);
+    XCTAssertEqual(glucose_store_find(&store, 13), GLUCOSE_NO_RECORD);
+}
+
+- (void)testContextsMatchTheirRecords {
+    gatt_glucose_context early = {0};
+    early.sequence_number = 5;
+    early.meal = 2;
+    XCTAssertEqual(glucose_store_add_context(&store, &early), 0);
+
+    for (uint16_t i = 0; i < 10; i++) {
+        gatt_glucose_measurement measurement = [self measurementWithSequenceNumber:i];
+        glucose_store_add_measurement(&store, &measurement);
+    }
+    gatt_glucose_context late = {0};
+    late.sequence_number = 7;
+    late.meal = 3;
+    XCTAssertEqual(glucose_store_add_context(&store, &late), 1);
+
+    XCTAssertEqual(glucose_store_context_of(&store, 5)->meal, 2);
+    XCTAssertEqual(glucose_store_context_of(&store, 7)->meal, 3);
+    XCTAssertTrue(glucose_store_context_of(&store, 6) == NULL);
+    XCTAssertTrue(glucose_store_context_of(&store, 10) == NULL);
+}
+
+- (void)testFullHistoryDownloadPerformance {
+    [self measureBlock:^{
+        glucose_store_clear(&self->store);
+        for (uint32_t i = 0; i < FULL_HISTORY; i++) {
+            gatt_glucose_measurement measurement = [self measurementWithSequenceNumber:(uint16_t)i];
+            glucose_store_add_measurement(&self->store, &measurement);
+        }
+    }];
+    XCTAssertEqual(store.record_count, (uint32_t)FULL_HISTORY);
+    XCTAssertEqual(glucose_store_find(&store, FULL_HISTORY - 1), FULL_HISTORY - 1);
+}
+
+@end
@@ -0,0 +1,231 @@
+//
+//  LogQueryTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "LogQueryIndex.h"
+#import "LogExport.h"
+
+#define TEST_DAY            20180315
+#define START_US            1521122520000000LL
+#define PERIPHERALS         3
+
+static const uint8_t bootloaderCharacteristic[16] = {0x00, 0x06, 0x00, 0x01, 0xF8, 0xCE, 0x11, 0xE4, 0xAB, 0xF4, 0x00, 0x02, 0xA5, 0xD5, 0xC5, 0x1B};
+static const uint8_t heartRateCharacteristic[2] = {0x2A, 0x37};
+
+@interface LogQueryTests : XCTestCase
+{
+    NSString *directory;
+    log_segment_writer writer;
+    log_query_index index;
+}
+
+@end
+
+@implementation LogQueryTests
+
+- (void)setUp {
+    [super setUp];
+    directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    [[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:nil];
+    XCTAssertTrue(log_segment_writer_open(&writer, directory.fileSystemRepresentation, 1));
+    XCTAssertTrue(log_query_index_open(&index, directory.fileSystemRepresentation, TEST_DAY));
+}
+
+- (void)tearDown {
+    log_query_index_close(&index);
+    log_segment_writer_close(&writer);
+    [[NSFileManager defaultManager] removeItemAtPath:directory error:nil];
+    [super tearDown];
+}
+
+/*!
+ *  @method appendRecords:
+ *
+ *  @discussion Appends count records, one per 10 ms. Every tenth is a text record; the others rotate through the
+ *  peripherals, alternate between the bootloader and heart rate characteristics and between notifications and writes.
+ *
+ */
+- (void)appendRecords:(int)count {
+    for (int i = 0; i < count; i++) {
+        int64_t timestamp = START_US + 10000LL * i;
+        if (i % 10 == 0) {
+            const char *text = "Connection established";
+            XCTAssertTrue(log_segment_writer_append(&writer, TEST_DAY, timestamp, LOG_SEGMENT_TEXT_RECORD, text, (uint32_t)strlen(text)));
+            continue;
+        }
+
+        uint8_t value[4] = {0x01, (uint8_t)i, 0x00, 0x17};
+        gatt_trace_record record = {0};
+        record.opcode = i % 2 ? GATT_TRACE_NOTIFY_RESPONSE : GATT_TRACE_WRITE_REQUEST;
+        memset(record.peripheral, i % PERIPHERALS, sizeof(record.peripheral));
+        record.service.length = 2;
+        record.service.bytes[0] = 0x18;
+        if (i % 4 < 2) {
+            record.characteristic.length = sizeof(bootloaderCharacteristic);
+            memcpy(record.characteristic.bytes, bootloaderCharacteristic, sizeof(bootloaderCharacteristic));
+        } else {
+            record.characteristic.length = sizeof(heartRateCharacteristic);
+            memcpy(record.characteristic.bytes, heartRateCharacteristic, sizeof(heartRateCharacteristic));
+        }
+        record.payload = value;
+        record.payload_length = sizeof(value);
+
+        uint8_t bytes[GATT_TRACE_MAX_HEADER_SIZE + sizeof(value)];
+        size_t length = gatt_trace_record_encode(&record, bytes);
+        XCTAssertTrue(log_segment_writer_append(&writer, TEST_DAY, timestamp, LOG_SEGMENT_TRACE_RECORD, bytes, (uint32_t)length));
+    }
+    XCTAssertTrue(log_segment_writer_flush(&writer));
+    XCTAssertTrue(log_query_index_refresh(&index));
+}
+
+- (void)bootloaderNotificationsQuery:(log_query *)query peripheral:(uint8_t)peripheral {
+    memset(query, 0, sizeof(*query));
+    query->from_us = INT64_MIN;
+    query->to_us = INT64_MAX;
+    query->match_peripheral = 1;
+    memset(query->peripheral, peripheral, sizeof(query->peripheral));
+    query->characteristic.length = sizeof(bootloaderCharacteristic);
+    memcpy(query->characteristic.bytes, bootloaderCharacteristic, sizeof(bootloaderCharacteristic));
+    query->operations = LOG_QUERY_OPERATION(GATT_TRACE_NOTIFY_RESPONSE);
+}
+
+- (NSArray *)matchesOfQuery:(const log_query *)query {
+    NSMutableArray *matches = [NSMutableArray array];
+    log_query_cursor cursor;
+    log_query_cursor_open(&cursor, &index, query);
+    log_query_match match;
+    while (log_query_cursor_next(&cursor, &match)) {
+        [matches addObject:@(match.index)];
+    }
+    return matches;
+}
+
+/*!
+ *  @method expectedMatchesOfQuery:
+ *
+ *  @discussion Applies the trace filters of the query to every record
+ *
+ */
+- (NSArray *)expectedMatchesOfQuery:(const log_query *)query count:(int)count {
+    NSMutableArray *matches = [NSMutableArray array];
+    for (int i = 0; i < count; i++) {
+        int64_t timestamp = START_US + 10000LL * i;
+        if (i % 10 == 0 || timestamp < query->from_us || timestamp >= query->to_us) {
+            continue;
+        }
+        if (i % PERIPHERALS == query->peripheral[0] && i % 4 < 2 && i % 2) {
+            [matches addObject:@(i)];
+        }
+    }
+    return matches;
+}
+
+- (void)testIndexedQueryMatchesScan {
+    [self appendRecords:5000];
+    XCTAssertEqual(index.indexed, 5000u);
+    XCTAssertTrue(index.ordered);
+
+    log_query query;
+    [self bootloaderNotificationsQuery:&query peripheral:1];
+    query.from_us = START_US + 10000LL * 1200;
+    query.to_us = START_US + 10000LL * 3100;
+    XCTAssertEqualObjects([self matchesOfQuery:&query], [self expectedMatchesOfQuery:&query count:5000]);
+
+    // A peripheral that never logged matches nothing
+    memset(query.peripheral, 9, sizeof(query.peripheral));
+    XCTAssertEqual([self matchesOfQuery:&query].count, 0u);
+}
+
+- (void)testRefreshIndexesNewRecordsOnly {
+    log_query query;
+    [self bootloaderNotificationsQuery:&query peripheral:2];
+    [self appendRecords:1000];
+    NSUInteger before = [self matchesOfQuery:&query].count;
+
+    // Later records of the same day continue where the first batch ended
+    for (int i = 1000; i < 2000; i++) {
+        uint8_t value = 0;
+        gatt_trace_record record = {0};
+        record.opcode = GATT_TRACE_NOTIFY_RESPONSE;
+        memset(record.peripheral, 2, sizeof(record.peripheral));
+        record.characteristic.length = sizeof(bootloaderCharacteristic);
+        memcpy(record.characteristic.bytes, bootloaderCharacteristic, sizeof(bootloaderCharacteristic));
+        record.payload = &value;
+        record.payload_length = 1;
+        uint8_t bytes[GATT_TRACE_MAX_HEADER_SIZE + 1];
+        size_t length = gatt_trace_record_encode(&record, bytes);
+        XCTAssertTrue(log_segment_writer_append(&writer, TEST_DAY, START_US + 10000LL * i, LOG_SEGMENT_TRACE_RECORD, bytes, (uint32_t)length));
+    }
+    XCTAssertTrue(log_segment_writer_flush(&writer));
+    XCTAssertTrue(log_query_index_refresh(&index));
+    XCTAssertEqual(index.indexed, 2000u);
+    XCTAssertEqual([self matchesOfQuery:&query].count, before + 1000);
+}
+
+- (void)testPatternSearch {
+    [self appendRecords:100];
+
+    log_query query = {0};
+    query.from_us = INT64_MIN;
+    query.to_us = INT64_MAX;
+    query.pattern_type = LOG_QUERY_TEXT_PATTERN;
+    query.pattern = (const uint8_t *)"CONNECTION";
+    query.pattern_length = 10;
+    XCTAssertEqual([self matchesOfQuery:&query].count, 10u);
+
+    uint8_t bytes[3] = {0x01, 0x21, 0x00};
+    query.pattern_type = LOG_QUERY_BYTE_PATTERN;
+    query.pattern = bytes;
+    query.pattern_length = sizeof(bytes);
+    XCTAssertEqualObjects([self matchesOfQuery:&query], @[@0x21]);
+}
+
+- (void)testExportFormats {
+    [self appendRecords:200];
+    log_query query;
+    [self bootloaderNotificationsQuery:&query peripheral:0];
+    NSUInteger expected = [self matchesOfQuery:&query].count;
+
+    NSString *path = [directory stringByAppendingPathComponent:@"export"];
+    for (int format = LOG_EXPORT_CSV; format <= LOG_EXPORT_PCAP; format++) {
+        FILE *file = fopen(path.fileSystemRepresentation, "wb");
+        XCTAssertTrue(log_export_begin(file, format));
+        log_query_cursor cursor;
+        log_query_cursor_open(&cursor, &index, &query);
+        log_query_match match;
+        while (log_query_cursor_next(&cursor, &match)) {
+            XCTAssertTrue(log_export_match(file, format, &match));
+        }
+        fclose(file);
+
+        NSData *data = [NSData dataWithContentsOfFile:path];
+        if (format == LOG_EXPORT_PCAP) {
+            const uint8_t *header = data.bytes;
+            XCTAssertEqual(header[0], 0xD4);
+            XCTAssertEqual(header[20], LOG_EXPORT_PCAP_LINKTYPE);
+            continue;
+        }
+        NSString *text = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+        NSArray *lines = [[text stringByTrimmingCharactersInSet:[NSCharacterSet newlineCharacterSet]] componentsSeparatedByString:@"\n"];
+        XCTAssertEqual(lines.count, expected + (format == LOG_EXPORT_CSV ? 1 : 0));
+        XCTAssertTrue([lines.lastObject containsString:@"00060001-F8CE-11E4-ABF4-0002A5D5C51B"]);
+        XCTAssertTrue([lines.lastObject containsString:@"notify_response"]);
+    }
+}
+
+- (void)testQueryPerformance {
+    [self appendRecords:100000];
+    log_query query;
+    [self bootloaderNotificationsQuery:&query peripheral:1];
+    query.from_us = START_US + 10000LL * 40000;
+    query.to_us = START_US + 10000LL * 58000;
+    [self measureBlock:^{
+        [self matchesOfQuery:&query];
+    }];
+}
+
+@end
@@ -0,0 +1,122 @@
+//
+//  LogRecordQueueTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "LogRecordQueue.h"
+
+#define PRODUCER_COUNT          4
+#define RECORDS_PER_PRODUCER    50000
+
+@interface LogRecordQueueTests : XCTestCase
+{
+    log_record_queue queue;
+}
+
+@end
+
+@implementation LogRecordQueueTests
+
+- (void)setUp {
+    [super setUp];
+    XCTAssertTrue(log_record_queue_init(&queue, 1000));
+}
+
+- (void)tearDown {
+    log_record_queue_free(&queue);
+    [super tearDown];
+}
+
+- (void)testFullQueueDropsRecords {
+    log_record_queue small;
+    XCTAssertTrue(log_record_queue_init(&small, 3));
+
+    // Capacity rounds up to 4
+    size_t depth = 0;
+    for (uintptr_t i = 1; i <= 4; i++) {
+        XCTAssertTrue(log_record_queue_push(&small, i, (void *)i, &depth));
+        XCTAssertEqual(depth, (size_t)i);
+    }
+    XCTAssertFalse(log_record_queue_push(&small, 5, (void *)5, &depth));
+    XCTAssertEqual(log_record_queue_dropped(&small), 1u);
+    XCTAssertEqual(log_record_queue_high_water(&small), (size_t)4);
+
+    log_record record;
+    for (uintptr_t i = 1; i <= 4; i++) {
+        XCTAssertTrue(log_record_queue_pop(&small, &record));
+        XCTAssertEqual((uintptr_t)record.payload, i);
+        XCTAssertEqual(record.timestamp, (double)i);
+    }
+    XCTAssertFalse(log_record_queue_pop(&small, &record));
+    XCTAssertEqual(log_record_queue_depth(&small), (size_t)0);
+    log_record_queue_free(&small);
+}
+
+- (void)testConcurrentProducersKeepOrder {
+    log_record_queue *q = &queue;
+    __block uint64_t retries = 0;
+    __block uint64_t badDepths = 0;
+
+    dispatch_group_t group = dispatch_group_create();
+    for (uintptr_t producer = 0; producer < PRODUCER_COUNT; producer++) {
+        dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            uint64_t full = 0;
+            uint64_t bad = 0;
+            for (uintptr_t i = 0; i < RECORDS_PER_PRODUCER; i++) {
+                size_t depth = 0;
+                while (!log_record_queue_push(q, 0, (void *)(producer << 24 | i), &depth)) {
+                    full++;
+                }
+                // The consumer pops concurrently, the depth of a pushed record must still count the record itself
+                if (depth == 0 || depth > q->mask + 1) {
+                    bad++;
+                }
+            }
+            @synchronized (self) {
+                retries += full;
+                badDepths += bad;
+            }
+        });
+    }
+
+    long last[PRODUCER_COUNT];
+    for (int i = 0; i < PRODUCER_COUNT; i++) {
+        last[i] = -1;
+    }
+
+    NSUInteger received = 0;
+    log_record record;
+    while (received < PRODUCER_COUNT * RECORDS_PER_PRODUCER) {
+        if (log_record_queue_pop(q, &record)) {
+            uintptr_t producer = (uintptr_t)record.payload >> 24;
+            long value = (long)((uintptr_t)record.payload & 0xFFFFFF);
+            XCTAssertEqual(value, last[producer] + 1);
+            last[producer] = value;
+            received++;
+        }
+    }
+
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+    XCTAssertEqual(log_record_queue_dropped(q), retries);
+    XCTAssertEqual(badDepths, 0u);
+    XCTAssertLessThanOrEqual(log_record_queue_high_water(q), (size_t)1024);
+}
+
+- (void)testPushPerformance {
+    log_record_queue *q = &queue;
+    [self measureBlock:^{
+        log_record record;
+        for (int round = 0; round < 100; round++) {
+            for (uintptr_t i = 0; i < 1000; i++) {
+                log_record_queue_push(q, 0, (void *)i, NULL);
+            }
+            while (log_record_queue_pop(q, &record)) {
+            }
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,216 @@
+//
+//  LogSegmentStoreTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "LogSegmentStore.h"
+
+#define TEST_DAY        20180315
+#define NEXT_DAY        20180316
+
+@interface LogSegmentStoreTests : XCTestCase
+{
+    NSString *directory;
+    log_segment_writer writer;
+}
+
+@end
+
+@implementation LogSegmentStoreTests
+
+- (void)setUp {
+    [super setUp];
+    directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    [[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:nil];
+    XCTAssertTrue(log_segment_writer_open(&writer, directory.fileSystemRepresentation, 1));
+}
+
+- (void)tearDown {
+    log_segment_writer_close(&writer);
+    [[NSFileManager defaultManager] removeItemAtPath:directory error:nil];
+    [super tearDown];
+}
+
+- (NSString *)eventAtIndex:(int)index {
+    return [NSString stringWithFormat:@"[00060001-F8CE-11E4-ABF4-0002A5D5C51B] Write request sent with value : [01 37 %02X 00 %02X 17] %d",
+            index & 0xFF, (index * 7) & 0xFF, index];
+}
+
+- (NSString *)decodeEntry:(const log_segment_entry *)entry {
+    NSMutableData *buffer = [NSMutableData dataWithLength:entry->length];
+    XCTAssertTrue(log_segment_entry_decode(entry, buffer.mutableBytes));
+    return [[NSString alloc] initWithData:buffer encoding:NSUTF8StringEncoding];
+}
+
+- (void)testRecordsRoundTrip {
+    for (int i = 0; i < 1000; i++) {
+        const char *event = [self eventAtIndex:i].UTF8String;
+        XCTAssertTrue(log_segment_writer_append(&writer, TEST_DAY, 1000000LL * i, LOG_SEGMENT_TEXT_RECORD, event, (uint32_t)strlen(event)));
+    }
+    XCTAssertTrue(log_segment_writer_flush(&writer));
+
+    log_segment_reader reader;
+    XCTAssertTrue(log_segment_reader_open(&reader, directory.fileSystemRepresentation, TEST_DAY));
+    XCTAssertEqual(reader.count, 1000u);
+
+    for (uint32_t i = 0; i < reader.count; i++) {
+        log_segment_entry entry;
+        XCTAssertTrue(log_segment_reader_entry(&reader, i, &entry));
+        XCTAssertEqual(entry.timestamp_us, 1000000LL * i);
+        XCTAssertEqualObjects([self decodeEntry:&entry], [self eventAtIndex:i]);
+    }
+    log_segment_entry entry;
+    XCTAssertFalse(log_segment_reader_entry(&reader, reader.count, &entry));
+    log_segment_reader_close(&reader);
+}
+
+- (void)testRepetitivePayloadIsCompressed {
+    NSMutableString *dump = [NSMutableString string];
+    for (int i = 0; i < 64; i++) {
+        [dump appendString:@"00 11 22 33 "];
+    }
+    const char *bytes = dump.UTF8String;
+    XCTAssertTrue(log_segment_writer_append(&writer, TEST_DAY, 1, LOG_SEGMENT_TEXT_RECORD, bytes, (uint32_t)strlen(bytes)));
+    XCTAssertTrue(log_segment_writer_flush(&writer));
+
+    log_segment_reader reader;
+    XCTAssertTrue(log_segment_reader_open(&reader, directory.fileSystemRepresentation, TEST_DAY));
+    log_segment_entry entry;
+    XCTAssertTrue(log_segment_reader_entry(&reader, 0, &entry));
+    XCTAssertTrue(entry.compressed);
+    XCTAssertLessThan(entry.stored_length, entry.length / 4);
+    XCTAssertEqualObjects([self decodeEntry:&entry], dump);
+
+    // A truncated compressed payload is rejected, never decoded out of bounds
+    entry.stored_length -= 1;
+    NSMutableData *output = [NSMutableData dataWithLength:entry.length];
+    XCTAssertFalse(log_segment_entry_decode(&entry, output.mutableBytes));
+    log_segment_reader_close(&reader);
+}
+
+- (void)testPartialRecordIsDroppedOnReopen {
+    const char *first = "first";
+    XCTAssertTrue(log_segment_writer_append(&writer, TEST_DAY, 1, LOG_SEGMENT_TEXT_RECORD, first, 5));
+    log_segment_writer_close(&writer);
+
+    // Header of a record whose payload never made it to disk
+    NSString *path = [directory stringByAppendingPathComponent:[NSString stringWithFormat:@"%08u.cylog", TEST_DAY]];
+    NSFileHandle *file = [NSFileHandle fileHandleForWritingAtPath:path];
+    [file seekToEndOfFile];
+    uint8_t torn[LOG_SEGMENT_RECORD_HEADER_SIZE] = {2, 0, 0, 0, 0, 0, 0, 0, 100, 0, 0, 0, 100, 0, 0, 0};
+    [file writeData:[NSData dataWithBytes:torn length:sizeof(torn)]];
+    [file closeFile];
+
+    log_segment_reader reader;
+    XCTAssertTrue(log_segment_reader_open(&reader, directory.fileSystemRepresentation, TEST_DAY));
+    XCTAssertEqual(reader.count, 1u);
+    log_segment_reader_close(&reader);
+
+    XCTAssertTrue(log_segment_writer_open(&writer, directory.fileSystemRepresentation, 0));
+    XCTAssertTrue(log_segment_writer_append(&writer, TEST_DAY, 3, LOG_SEGMENT_TEXT_RECORD, "second", 6));
+    XCTAssertTrue(log_segment_writer_flush(&writer));
+
+    XCTAssertTrue(log_segment_reader_open(&reader, directory.fileSystemRepresentation, TEST_DAY));
+    XCTAssertEqual(reader.count, 2u);
+    log_segment_entry entry;
+    XCTAssertTrue(log_segment_reader_entry(&reader, 1, &entry));
+    XCTAssertEqual(entry.timestamp_us, 3);
+    XCTAssertEqualObjects([self decodeEntry:&entry], @"second");
+    log_segment_reader_close(&reader);
+}
+
+- (void)testUnreadableSegmentIsSetAside {
+    NSString *path = [directory stringByAppendingPathComponent:[NSString stringWithFormat:@"%08u.cylog", TEST_DAY]];
+    NSString *unreadablePath = [path stringByAppendingString:@".unreadable"];
+    NSData *garbage = [@"not a log segment, but somebody's data" dataUsingEncoding:NSUTF8StringEncoding];
+    XCTAssertTrue([garbage writeToFile:path atomically:NO]);
+
+    XCTAssertTrue(log_segment_writer_append(&writer, TEST_DAY, 1, LOG_SEGMENT_TEXT_RECORD, "first", 5));
+    XCTAssertTrue(log_segment_writer_flush(&writer));
+    XCTAssertEqualObjects([NSData dataWithContentsOfFile:unreadablePath], garbage);
+
+    log_segment_reader reader;
+    XCTAssertTrue(log_segment_reader_open(&reader, directory.fileSystemRepresentation, TEST_DAY));
+    XCTAssertEqual(reader.count, 1u);
+    log_segment_reader_close(&reader);
+
+    // A second unreadable segment of the day does not replace the first one
+    log_segment_writer_close(&writer);
+    XCTAssertTrue([garbage writeToFile:path atomically:NO]);
+    XCTAssertTrue(log_segment_writer_open(&writer, directory.fileSystemRepresentation, 1));
+    XCTAssertFalse(log_segment_writer_append(&writer, TEST_DAY, 2, LOG_SEGMENT_TEXT_RECORD, "second", 6));
+    XCTAssertEqualObjects([NSData dataWithContentsOfFile:path], garbage);
+    XCTAssertEqualObjects([NSData dataWithContentsOfFile:unreadablePath], garbage);
+
+    // Removing the day removes the file set aside with it
+    XCTAssertTrue(log_segment_writer_remove_day(&writer, TEST_DAY));
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:unreadablePath]);
+}
+
+- (void)testRefreshIndexesAppendedRecords {
+    log_segment_reader reader;
+    XCTAssertTrue(log_segment_reader_open(&reader, directory.fileSystemRepresentation, TEST_DAY));
+    XCTAssertEqual(reader.count, 0u);
+
+    int written = 0;
+    for (int round = 0; round < 5; round++) {
+        for (int i = 0; i < 700; i++, written++) {
+            const char *event = [self eventAtIndex:written].UTF8String;
+            XCTAssertTrue(log_segment_writer_append(&writer, TEST_DAY, written, LOG_SEGMENT_TEXT_RECORD, event, (uint32_t)strlen(event)));
+        }
+        XCTAssertTrue(log_segment_writer_flush(&writer));
+        XCTAssertTrue(log_segment_reader_refresh(&reader));
+        XCTAssertEqual(reader.count, (uint32_t)written);
+    }
+
+    log_segment_entry entry;
+    XCTAssertTrue(log_segment_reader_entry(&reader, written - 1, &entry));
+    XCTAssertEqualObjects([self decodeEntry:&entry], [self eventAtIndex:written - 1]);
+
+    // A day removed and started again is indexed from the start
+    XCTAssertTrue(log_segment_writer_remove_day(&writer, TEST_DAY));
+    XCTAssertTrue(log_segment_writer_append(&writer, TEST_DAY, 1, LOG_SEGMENT_TEXT_RECORD, "again", 5));
+    XCTAssertTrue(log_segment_writer_flush(&writer));
+    XCTAssertTrue(log_segment_reader_refresh(&reader));
+    XCTAssertEqual(reader.count, 1u);
+    XCTAssertTrue(log_segment_reader_entry(&reader, 0, &entry));
+    XCTAssertEqualObjects([self decodeEntry:&entry], @"again");
+    log_segment_reader_close(&reader);
+}
+
+- (void)testDaysAreSeparateSegments {
+    XCTAssertTrue(log_segment_writer_append(&writer, NEXT_DAY, 2, LOG_SEGMENT_TEXT_RECORD, "b", 1));
+    XCTAssertTrue(log_segment_writer_append(&writer, TEST_DAY, 1, LOG_SEGMENT_TEXT_RECORD, "a", 1));
+    XCTAssertTrue(log_segment_writer_flush(&writer));
+
+    uint32_t days[4];
+    XCTAssertEqual(log_segment_list_days(directory.fileSystemRepresentation, days, 4), (size_t)2);
+    XCTAssertEqual(days[0], (uint32_t)TEST_DAY);
+    XCTAssertEqual(days[1], (uint32_t)NEXT_DAY);
+
+    XCTAssertTrue(log_segment_writer_remove_day(&writer, TEST_DAY));
+    XCTAssertEqual(log_segment_list_days(directory.fileSystemRepresentation, days, 4), (size_t)1);
+    XCTAssertEqual(days[0], (uint32_t)NEXT_DAY);
+
+    log_segment_reader reader;
+    XCTAssertTrue(log_segment_reader_open(&reader, directory.fileSystemRepresentation, TEST_DAY));
+    XCTAssertEqual(reader.count, 0u);
+    log_segment_reader_close(&reader);
+}
+
+- (void)testAppendPerformance {
+    const char *event = [self eventAtIndex:42].UTF8String;
+    uint32_t length = (uint32_t)strlen(event);
+    __block int64_t timestamp = 0;
+    [self measureBlock:^{
+        for (int i = 0; i < 100000; i++) {
+            log_segment_writer_append(&self->writer, TEST_DAY, timestamp++, LOG_SEGMENT_TEXT_RECORD, event, length);
+        }
+        log_segment_writer_flush(&self->writer);
+    }];
+}
+
+@end
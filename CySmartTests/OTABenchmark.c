@@ -0,0 +1,322 @@
+//
+//  OTABenchmark.c
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#include "OTABenchmark.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define OTA_BENCH_EVENT_CONNECTED   0
+#define OTA_BENCH_EVENT_RESPONSE    1
+
+typedef struct
+{
+    uint64_t time_us;
+    uint64_t sequence;                  // Keeps events of the same time in the order they were posted
+    unsigned job;
+    uint8_t type;
+    uint8_t length;
+    uint8_t bytes[BOOTLOADER_SIM_MAX_RESPONSE];
+} ota_bench_event;
+
+typedef struct
+{
+    bootloader_sim sim;
+    uint64_t uplink_free_us;            // Air time of the previous write ends
+    uint64_t downlink_free_us;
+    uint64_t device_free_us;            // Device finished the previous command
+} ota_bench_device;
+
+typedef struct
+{
+    const ota_bench_config *config;
+    ota_bench_device *devices;
+    ota_session *sessions;
+    ota_bench_event *events;
+    unsigned event_count;
+    unsigned event_capacity;
+    uint64_t sequence;
+    uint64_t now_us;
+    uint64_t finished_us;
+    uint32_t random;
+    ota_bench_result *result;
+} ota_bench;
+
+static uint32_t ota_bench_random(ota_bench *bench)
+{
+    // xorshift32, deterministic for a seed
+    uint32_t x = bench->random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    bench->random = x;
+    return x;
+}
+
+static void ota_bench_post(ota_bench *bench, uint64_t time_us, unsigned job, uint8_t type, const uint8_t *bytes, uint32_t length)
+{
+    if (bench->event_count == bench->event_capacity)
+    {
+        return;
+    }
+
+    ota_bench_event *event = &bench->events[bench->event_count++];
+    event->time_us = time_us;
+    event->sequence = bench->sequence++;
+    event->job = job;
+    event->type = type;
+    event->length = (uint8_t)length;
+    if (length > 0)
+    {
+        memcpy(event->bytes, bytes, length);
+    }
+}
+
+/*!
+ *  @function ota_bench_take_event
+ *
+ *  @discussion Removes the earliest event if it is due no later than deadline_us. The queue is tiny, a few events per
+ *  connected device, so a linear scan beats keeping a heap.
+ *
+ */
+static int ota_bench_take_event(ota_bench *bench, uint64_t deadline_us, ota_bench_event *event)
+{
+    unsigned earliest = bench->event_count;
+    for (unsigned i = 0; i < bench->event_count; i++)
+    {
+        const ota_bench_event *candidate = &bench->events[i];
+        if (earliest == bench->event_count || candidate->time_us < bench->events[earliest].time_us
+            || (candidate->time_us == bench->events[earliest].time_us && candidate->sequence < bench->events[earliest].sequence))
+        {
+            earliest = i;
+        }
+    }
+
+    if (earliest == bench->event_count || bench->events[earliest].time_us > deadline_us)
+    {
+        return 0;
+    }
+    *event = bench->events[earliest];
+    bench->events[earliest] = bench->events[--bench->event_count];
+    return 1;
+}
+
+/*!
+ *  @function ota_bench_transmit
+ *
+ *  @discussion Sends length bytes over one direction of the link starting no earlier than start_us. Returns the time
+ *  the last write is through, retransmissions included.
+ *
+ */
+static uint64_t ota_bench_transmit(ota_bench *bench, uint64_t start_us, uint32_t length)
+{
+    const ota_bench_link *link = &bench->config->link;
+    uint32_t mtu = link->mtu > 0 ? link->mtu : 20;
+    uint32_t writes = (length + mtu - 1) / mtu;
+    uint64_t time_us = start_us;
+
+    for (uint32_t i = 0; i < writes; i++)
+    {
+        bench->result->writes++;
+        while (link->loss_per_million > 0 && ota_bench_random(bench) % 1000000 < link->loss_per_million)
+        {
+            bench->result->writes++;
+            bench->result->retransmissions++;
+            time_us += link->retransmit_us;
+        }
+        time_us += link->write_time_us;
+    }
+    return time_us;
+}
+
+static void ota_bench_connect(void *context, unsigned job)
+{
+    ota_bench *bench = context;
+    ota_bench_device *device = &bench->devices[job];
+    uint64_t connected_us = bench->now_us + bench->config->link.connect_us;
+
+    device->uplink_free_us = connected_us;
+    device->downlink_free_us = connected_us;
+    device->device_free_us = connected_us;
+    ota_bench_post(bench, connected_us, job, OTA_BENCH_EVENT_CONNECTED, NULL, 0);
+}
+
+static int ota_bench_write(void *context, unsigned job, const uint8_t *bytes, uint16_t length)
+{
+    ota_bench *bench = context;
+    const ota_bench_link *link = &bench->config->link;
+    ota_bench_device *device = &bench->devices[job];
+    uint8_t response[BOOTLOADER_SIM_MAX_RESPONSE];
+
+    bench->result->commands++;
+
+    uint64_t start_us = device->uplink_free_us > bench->now_us ? device->uplink_free_us : bench->now_us;
+    device->uplink_free_us = ota_bench_transmit(bench, start_us, length);
+
+    uint64_t arrival_us = device->uplink_free_us + link->latency_us;
+    uint64_t process_us = arrival_us > device->device_free_us ? arrival_us : device->device_free_us;
+    process_us += bootloader_sim_is_programming_command(&device->sim, bytes[1]) ? link->flash_write_us : link->command_us;
+    device->device_free_us = process_us;
+
+    uint32_t response_length = bootloader_sim_handle(&device->sim, bytes, length, response);
+    if (response_length > 0)
+    {
+        uint64_t notify_us = process_us > device->downlink_free_us ? process_us : device->downlink_free_us;
+        device->downlink_free_us = ota_bench_transmit(bench, notify_us, response_length);
+        ota_bench_post(bench, device->downlink_free_us + link->latency_us, job, OTA_BENCH_EVENT_RESPONSE, response, response_length);
+    }
+    return 1;
+}
+
+static void ota_bench_finished(void *context, unsigned job, const ota_session *session)
+{
+    ota_bench *bench = context;
+    (void)job;
+    bench->finished_us = bench->now_us;
+    if (session->state == OTA_SESSION_DONE)
+    {
+        bench->result->devices_done++;
+    }
+    else
+    {
+        bench->result->devices_failed++;
+    }
+}
+
+static int ota_bench_flash_matches(bootloader_sim *sim, const ota_session_image *image)
+{
+    for (uint32_t i = 0; i < image->row_count; i++)
+    {
+        const ota_session_row *row = &image->rows[i];
+        const uint8_t *flash = bootloader_sim_row(sim, row->array_id, row->row_number);
+        if (flash == NULL || row->length != sim->config.row_size || memcmp(flash, row->data, row->length) != 0)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int ota_bench_run(const ota_bench_config *config, const ota_session_image *image,
+                  const bootloader_sim_config *device, ota_bench_result *result)
+{
+    memset(result, 0, sizeof(*result));
+    if (config->devices == 0 || config->devices > OTA_SCHEDULER_MAX_JOBS)
+    {
+        return 0;
+    }
+
+    ota_bench bench;
+    memset(&bench, 0, sizeof(bench));
+    bench.config = config;
+    bench.result = result;
+    bench.random = config->seed != 0 ? config->seed : 1;
+    bench.event_capacity = config->devices * (OTA_SESSION_QUEUE_LENGTH + 2);
+    bench.devices = calloc(config->devices, sizeof(ota_bench_device));
+    bench.sessions = calloc(config->devices, sizeof(ota_session));
+    bench.events = calloc(bench.event_capacity, sizeof(ota_bench_event));
+
+    ota_scheduler *scheduler = malloc(sizeof(ota_scheduler));
+    int ok = bench.devices != NULL && bench.sessions != NULL && bench.events != NULL && scheduler != NULL;
+    uint16_t initialized = 0;
+
+    for (; ok && initialized < config->devices; initialized++)
+    {
+        if (!bootloader_sim_init(&bench.devices[initialized].sim, device))
+        {
+            ok = 0;
+            break;
+        }
+    }
+
+    if (ok)
+    {
+        ota_scheduler_callbacks callbacks = { ota_bench_connect, ota_bench_write, ota_bench_finished };
+        ota_scheduler_init(scheduler, config->max_connections, config->bytes_per_second, &callbacks, &bench);
+        for (uint16_t i = 0; i < config->devices; i++)
+        {
+            ota_session_init(&bench.sessions[i], image, config->window, config->chunk_size);
+            ota_scheduler_add_job(scheduler, &bench.sessions[i]);
+        }
+
+        while (ota_scheduler_unfinished_jobs(scheduler) > 0)
+        {
+            uint64_t delay_us = ota_scheduler_poll(scheduler, bench.now_us);
+            if (ota_scheduler_unfinished_jobs(scheduler) == 0)
+            {
+                break;
+            }
+
+            uint64_t wake_us = delay_us == OTA_SCHEDULER_WAIT_EVENT ? UINT64_MAX : bench.now_us + delay_us;
+            ota_bench_event event;
+            if (ota_bench_take_event(&bench, wake_us, &event))
+            {
+                bench.now_us = event.time_us;
+                if (event.type == OTA_BENCH_EVENT_CONNECTED)
+                {
+                    ota_scheduler_on_connected(scheduler, event.job);
+                }
+                else
+                {
+                    if (bench.sessions[event.job].awaiting_count == 1)
+                    {
+                        result->round_trips++;
+                    }
+                    ota_scheduler_on_response(scheduler, event.job, event.bytes, event.length);
+                }
+            }
+            else if (wake_us != UINT64_MAX)
+            {
+                bench.now_us = wake_us;
+            }
+            else
+            {
+                // Nothing in flight and nothing to send: the sessions are stuck
+                ota_scheduler_cancel(scheduler);
+            }
+        }
+
+        for (uint16_t i = 0; i < config->devices; i++)
+        {
+            if (bench.sessions[i].state == OTA_SESSION_DONE)
+            {
+                result->rows += image->row_count;
+                for (uint32_t row = 0; row < image->row_count; row++)
+                {
+                    result->payload_bytes += image->rows[row].length;
+                }
+                if (!ota_bench_flash_matches(&bench.devices[i].sim, image))
+                {
+                    result->flash_mismatches++;
+                }
+            }
+        }
+
+        result->elapsed_us = bench.finished_us;
+        result->bytes_sent = scheduler->bytes_sent;
+        if (result->elapsed_us > 0)
+        {
+            result->rows_per_second = result->rows * 1e6 / result->elapsed_us;
+            result->bytes_per_second = result->payload_bytes * 1e6 / result->elapsed_us;
+        }
+        if (result->rows > 0)
+        {
+            result->round_trips_per_row = (double)result->round_trips / result->rows;
+        }
+        ok = result->devices_done == config->devices && result->flash_mismatches == 0;
+    }
+
+    for (uint16_t i = 0; i < initialized; i++)
+    {
+        bootloader_sim_free(&bench.devices[i].sim);
+    }
+    free(scheduler);
+    free(bench.events);
+    free(bench.sessions);
+    free(bench.devices);
+    return ok;
+}
@@ -0,0 +1,97 @@
+//
+//  OTABenchmark.h
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#ifndef OTABenchmark_h
+#define OTABenchmark_h
+
+#include <stdint.h>
+#include "OTAScheduler.h"
+#include "BootloaderSimulator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ *  @struct ota_bench_link
+ *
+ *  @discussion BLE link between the host and one simulated device. A command packet goes out as writes of at most
+ *  mtu bytes, each taking write_time_us of air time; a write is lost with probability loss_per_million and sent again
+ *  after retransmit_us, as the link layer does in the next connection event. Notifications travel the same way in
+ *  the other direction. latency_us is added once per direction.
+ *
+ */
+typedef struct
+{
+    uint32_t connect_us;                // Connection, discovery and notification enable
+    uint32_t latency_us;
+    uint16_t mtu;
+    uint32_t write_time_us;
+    uint32_t loss_per_million;
+    uint32_t retransmit_us;
+    uint32_t flash_write_us;            // Device time of PROGRAM_ROW/PROGRAM_DATA
+    uint32_t command_us;                // Device time of any other command
+} ota_bench_link;
+
+/*!
+ *  @struct ota_bench_config
+ *
+ *  @discussion Multi-device upgrade to simulate. Every device runs an ota_session with the given window and chunk
+ *  size under an ota_scheduler, exactly as OTAUpgradeScheduler drives real peripherals.
+ *
+ */
+typedef struct
+{
+    uint16_t devices;
+    uint16_t max_connections;
+    uint32_t bytes_per_second;          // Scheduler bandwidth limit, 0 for none
+    uint16_t window;
+    uint32_t chunk_size;
+    ota_bench_link link;
+    uint32_t seed;                      // Seed of the packet loss generator
+} ota_bench_config;
+
+/*!
+ *  @struct ota_bench_result
+ *
+ *  @discussion Totals of a run in simulated time. A round trip is a response the session had to wait for with no
+ *  other command in flight, so stop-and-wait transfers count every command and pipelined ones only the stalls.
+ *
+ */
+typedef struct
+{
+    uint64_t elapsed_us;
+    uint32_t devices_done;
+    uint32_t devices_failed;
+    uint32_t flash_mismatches;          // Devices reported done whose flash differs from the image
+    uint64_t rows;
+    uint64_t payload_bytes;
+    uint64_t bytes_sent;                // Command packet bytes including the framing
+    uint64_t commands;
+    uint64_t round_trips;
+    uint64_t writes;                    // Link layer writes including retransmissions
+    uint64_t retransmissions;
+    double rows_per_second;
+    double bytes_per_second;            // Row payload bytes per second
+    double round_trips_per_row;
+} ota_bench_result;
+
+/*!
+ *  @function ota_bench_run
+ *
+ *  @discussion Upgrades config->devices simulated bootloaders set up from device with the image and fills result.
+ *  Returns 1 if every device completed with flash matching the image.
+ *
+ */
+int ota_bench_run(const ota_bench_config *config, const ota_session_image *image,
+                  const bootloader_sim_config *device, ota_bench_result *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OTABenchmark_h */
@@ -0,0 +1,141 @@
+//
+//  OTABenchmarkTool.c
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+/*
+ * Command line benchmark of the OTA pipeline against simulated bootloaders. It is not part of any Xcode target;
+ * build and run it from the repository root on any host with a C99 compiler:
+ *
+ *  cc -std=gnu99 -O2 -ICySmart/Classes/UtilClasses -ICySmart/Classes/ViewControllers/OTA -ICySmartTests \
+ *      CySmartTests/OTABenchmarkTool.c CySmartTests/OTABenchmark.c CySmartTests/BootloaderSimulator.c \
+ *      CySmart/Classes/ViewControllers/OTA/OTAScheduler.c CySmart/Classes/ViewControllers/OTA/OTASession.c \
+ *      CySmart/Classes/ViewControllers/OTA/OTATransferEngine.c CySmart/Classes/UtilClasses/CyChecksum.c \
+ *      -o ota_benchmark && ./ota_benchmark [rows] [row_size]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "OTABenchmark.h"
+
+typedef struct
+{
+    const char *name;
+    uint16_t devices;
+    uint16_t max_connections;
+    uint16_t window;
+    uint16_t mtu;
+    uint32_t loss_per_million;
+} ota_benchmark_scenario;
+
+// Link parameters of a 15 ms connection interval with four writes per connection event
+#define BENCH_CONNECT_US        1500000
+#define BENCH_LATENCY_US        7500
+#define BENCH_WRITE_TIME_US     3750
+#define BENCH_RETRANSMIT_US     15000
+#define BENCH_FLASH_WRITE_US    12000
+#define BENCH_COMMAND_US        200
+
+static const ota_benchmark_scenario scenarios[] = {
+    { "stop-and-wait, MTU 20",          1, 1, 1, 20,  0 },
+    { "stop-and-wait, MTU 247",         1, 1, 1, 247, 0 },
+    { "window 4, MTU 247",              1, 1, 4, 247, 0 },
+    { "window 4, MTU 247, 1% loss",     1, 1, 4, 247, 10000 },
+    { "window 4, MTU 247, 5% loss",     1, 1, 4, 247, 50000 },
+    { "4 devices, 4 links, window 4",   4, 4, 4, 247, 0 },
+    { "8 devices, 3 links, window 4",   8, 3, 4, 247, 10000 },
+};
+
+int main(int argc, char *argv[])
+{
+    uint32_t row_count = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : 256;
+    uint16_t row_size = argc > 2 ? (uint16_t)strtoul(argv[2], NULL, 10) : 512;
+    if (row_count == 0 || row_size == 0 || row_size > OTA_SESSION_MAX_CHUNK)
+    {
+        fprintf(stderr, "usage: %s [rows] [row_size <= %d]\n", argv[0], OTA_SESSION_MAX_CHUNK);
+        return 2;
+    }
+
+    uint8_t *data = malloc((size_t)row_count * row_size);
+    ota_session_row *rows = malloc(row_count * sizeof(ota_session_row));
+    if (data == NULL || rows == NULL)
+    {
+        return 1;
+    }
+
+    uint32_t random = 2463534242u;
+    uint8_t app_sum = 0;
+    for (uint32_t i = 0; i < row_count; i++)
+    {
+        uint8_t sum = 0;
+        uint8_t *row = data + (size_t)i * row_size;
+        for (uint16_t j = 0; j < row_size; j++)
+        {
+            random ^= random << 13;
+            random ^= random >> 17;
+            random ^= random << 5;
+            row[j] = (uint8_t)random;
+            sum += row[j];
+        }
+        app_sum += sum;
+        rows[i] = (ota_session_row){ 0, (uint16_t)i, row_size, (uint8_t)-sum, row };
+    }
+
+    ota_session_image image = { rows, row_count, 0x04A61193, 0x11, CY_CHECKSUM_SUM, NULL, 0 };
+    bootloader_sim_config device = {
+        .file_version = BOOTLOADER_SIM_CYACD,
+        .silicon_id = image.silicon_id,
+        .silicon_rev = image.silicon_rev,
+        .bootloader_version = 0x010203,
+        .checksum_type = CY_CHECKSUM_SUM,
+        .array_count = 1,
+        .first_row = 0,
+        .rows_per_array = (uint16_t)row_count,
+        .row_size = row_size,
+        .app_checksum = (uint8_t)-app_sum,
+    };
+
+    printf("%u rows of %u bytes per device\n\n", row_count, row_size);
+    printf("%-32s %9s %10s %10s %8s %8s\n", "scenario", "rows/s", "bytes/s", "RT/row", "retx", "time s");
+
+    int failed = 0;
+    for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++)
+    {
+        const ota_benchmark_scenario *scenario = &scenarios[i];
+
+        // Every command packet fills a single write
+        uint32_t chunk = (uint32_t)scenario->mtu - 7;
+        ota_bench_config config = {
+            .devices = scenario->devices,
+            .max_connections = scenario->max_connections,
+            .bytes_per_second = 0,
+            .window = scenario->window,
+            .chunk_size = chunk,
+            .link = {
+                .connect_us = BENCH_CONNECT_US,
+                .latency_us = BENCH_LATENCY_US,
+                .mtu = scenario->mtu,
+                .write_time_us = BENCH_WRITE_TIME_US,
+                .loss_per_million = scenario->loss_per_million,
+                .retransmit_us = BENCH_RETRANSMIT_US,
+                .flash_write_us = BENCH_FLASH_WRITE_US,
+                .command_us = BENCH_COMMAND_US,
+            },
+            .seed = 1,
+        };
+
+        ota_bench_result result;
+        int ok = ota_bench_run(&config, &image, &device, &result);
+        failed |= !ok;
+        printf("%-32s %9.1f %10.0f %10.2f %8llu %8.2f%s\n", scenario->name, result.rows_per_second, result.bytes_per_second,
+               result.round_trips_per_row, (unsigned long long)result.retransmissions, result.elapsed_us / 1e6,
+               ok ? "" : "  FAILED");
+    }
+
+    free(rows);
+    free(data);
+    return failed;
+}
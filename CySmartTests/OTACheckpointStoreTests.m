@@ -0,0 +1,107 @@
+//
+//  OTACheckpointStoreTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "OTACheckpointStore.h"
+
+@interface OTACheckpointStoreTests : XCTestCase
+
+@end
+
+@implementation OTACheckpointStoreTests
+{
+    NSString *deviceID;
+    NSData *imageA;
+    NSData *imageB;
+}
+
+- (void)setUp {
+    [super setUp];
+    deviceID = [[NSUUID UUID] UUIDString];
+    imageA = [NSData dataWithBytes:"imageA" length:6];
+    imageB = [NSData dataWithBytes:"imageB" length:6];
+}
+
+- (void)tearDown {
+    [OTACheckpointStore removeCheckpointForDevice:deviceID];
+    [OTACheckpointStore removeFlashedImageHashForDevice:deviceID];
+    [super tearDown];
+}
+
+- (OTACheckpoint)checkpointAtRow:(uint32_t)rowIndex {
+    OTACheckpoint checkpoint;
+    checkpoint.rowIndex = rowIndex;
+    checkpoint.rowCount = 1000;
+    checkpoint.arrayID = 0;
+    return checkpoint;
+}
+
+- (void)testNoCheckpoint {
+    OTACheckpoint checkpoint;
+    XCTAssertFalse([OTACheckpointStore loadCheckpoint:&checkpoint forDevice:deviceID imageHash:imageA]);
+    XCTAssertFalse([OTACheckpointStore loadCheckpoint:&checkpoint forDevice:nil imageHash:imageA]);
+    XCTAssertFalse([OTACheckpointStore loadCheckpoint:&checkpoint forDevice:deviceID imageHash:nil]);
+}
+
+- (void)testSaveAndLoad {
+    [OTACheckpointStore saveCheckpoint:[self checkpointAtRow:900] forDevice:deviceID imageHash:imageA];
+
+    OTACheckpoint checkpoint;
+    XCTAssertTrue([OTACheckpointStore loadCheckpoint:&checkpoint forDevice:deviceID imageHash:imageA]);
+    XCTAssertEqual(checkpoint.rowIndex, 900u);
+    XCTAssertEqual(checkpoint.rowCount, 1000u);
+    XCTAssertEqual(checkpoint.arrayID, 0);
+}
+
+- (void)testCheckpointOfOtherImageIsNotLoaded {
+    [OTACheckpointStore saveCheckpoint:[self checkpointAtRow:900] forDevice:deviceID imageHash:imageA];
+
+    OTACheckpoint checkpoint;
+    XCTAssertFalse([OTACheckpointStore loadCheckpoint:&checkpoint forDevice:deviceID imageHash:imageB]);
+}
+
+- (void)testCheckpointOfOtherImageIsReplaced {
+    // Image A is interrupted, image B is then flashed part way: the checkpoint of A must not survive
+    [OTACheckpointStore saveCheckpoint:[self checkpointAtRow:900] forDevice:deviceID imageHash:imageA];
+    [OTACheckpointStore saveCheckpoint:[self checkpointAtRow:10] forDevice:deviceID imageHash:imageB];
+
+    OTACheckpoint checkpoint;
+    XCTAssertFalse([OTACheckpointStore loadCheckpoint:&checkpoint forDevice:deviceID imageHash:imageA]);
+    XCTAssertTrue([OTACheckpointStore loadCheckpoint:&checkpoint forDevice:deviceID imageHash:imageB]);
+    XCTAssertEqual(checkpoint.rowIndex, 10u);
+}
+
+- (void)testRemoveClearsCheckpointOfAnyImage {
+    [OTACheckpointStore saveCheckpoint:[self checkpointAtRow:900] forDevice:deviceID imageHash:imageA];
+    [OTACheckpointStore removeCheckpointForDevice:deviceID];
+
+    OTACheckpoint checkpoint;
+    XCTAssertFalse([OTACheckpointStore loadCheckpoint:&checkpoint forDevice:deviceID imageHash:imageA]);
+}
+
+- (void)testCheckpointsAreKeptPerDevice {
+    NSString *otherDeviceID = [[NSUUID UUID] UUIDString];
+    [OTACheckpointStore saveCheckpoint:[self checkpointAtRow:900] forDevice:deviceID imageHash:imageA];
+    [OTACheckpointStore saveCheckpoint:[self checkpointAtRow:5] forDevice:otherDeviceID imageHash:imageA];
+    [OTACheckpointStore removeCheckpointForDevice:otherDeviceID];
+
+    OTACheckpoint checkpoint;
+    XCTAssertTrue([OTACheckpointStore loadCheckpoint:&checkpoint forDevice:deviceID imageHash:imageA]);
+    XCTAssertEqual(checkpoint.rowIndex, 900u);
+}
+
+- (void)testFlashedImageHash {
+    XCTAssertNil([OTACheckpointStore flashedImageHashForDevice:deviceID]);
+
+    [OTACheckpointStore saveFlashedImageHash:imageA forDevice:deviceID];
+    XCTAssertEqualObjects([OTACheckpointStore flashedImageHashForDevice:deviceID], imageA);
+
+    [OTACheckpointStore removeFlashedImageHashForDevice:deviceID];
+    XCTAssertNil([OTACheckpointStore flashedImageHashForDevice:deviceID]);
+}
+
+@end
@@ -0,0 +1,74 @@
+//
+//  OTADeltaPlanTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "OTADeltaPlan.h"
+#import "OTAFileParser.h"
+#import "OTAImageDigest.h"
+
+@interface OTADeltaPlanTests : XCTestCase
+
+@end
+
+@implementation OTADeltaPlanTests
+
+/*
+ * Image of three 4 byte rows in array 0, the payload of row changedRow is different
+ */
+- (OTAFirmwareImage *)imageWithChangedRow:(NSInteger)changedRow {
+    OTAFirmwareImage *image = [[OTAFirmwareImage alloc] initWithCapacity:12];
+    for (uint16_t i = 0; i < 3; i++) {
+        OTAFirmwareRow row = {0};
+        row.rowType = RowTypeData;
+        row.rowNumber = i;
+        row.dataLength = 4;
+        uint8_t bytes[4] = {(uint8_t)i, 0x11, 0x22, (i == changedRow) ? 0x44 : 0x33};
+        [image appendRow:row bytes:bytes];
+    }
+    image.digest = [[OTAImageDigest alloc] initWithImage:image fileHash:[NSData dataWithBytes:"hash" length:4]];
+    return image;
+}
+
+- (void)testRowsAreProgrammedWithoutPreviousDigest {
+    OTADeltaPlan *plan = [[OTADeltaPlan alloc] initWithImage:[self imageWithChangedRow:-1] previousDigest:nil];
+    for (NSUInteger i = 0; i < 3; i++) {
+        XCTAssertFalse([plan shouldVerifyRowAtIndex:i]);
+    }
+}
+
+- (void)testOnlyRowsMatchingPreviousDigestAreVerified {
+    OTAImageDigest *previous = [self imageWithChangedRow:-1].digest;
+    OTADeltaPlan *plan = [[OTADeltaPlan alloc] initWithImage:[self imageWithChangedRow:1] previousDigest:previous];
+    XCTAssertTrue([plan shouldVerifyRowAtIndex:0]);
+    XCTAssertFalse([plan shouldVerifyRowAtIndex:1]);
+    XCTAssertTrue([plan shouldVerifyRowAtIndex:2]);
+}
+
+- (void)testPreviousDigestOfDifferentLayoutIsIgnored {
+    OTAFirmwareImage *previousImage = [[OTAFirmwareImage alloc] initWithCapacity:4];
+    OTAFirmwareRow row = {0};
+    row.dataLength = 4;
+    uint8_t bytes[4] = {0x00, 0x11, 0x22, 0x33};
+    [previousImage appendRow:row bytes:bytes];
+    OTAImageDigest *previous = [[OTAImageDigest alloc] initWithImage:previousImage fileHash:[NSData dataWithBytes:"prev" length:4]];
+
+    OTADeltaPlan *plan = [[OTADeltaPlan alloc] initWithImage:[self imageWithChangedRow:-1] previousDigest:previous];
+    XCTAssertFalse([plan shouldVerifyRowAtIndex:0]);
+}
+
+- (void)testCounts {
+    OTADeltaPlan *plan = [[OTADeltaPlan alloc] initWithImage:[self imageWithChangedRow:-1] previousDigest:nil];
+    [plan markRowWrittenAtIndex:0];
+    [plan markRowWrittenAtIndex:1];
+    [plan markRowSkippedAtIndex:2];
+    XCTAssertEqual(plan.writtenRowCount, 2u);
+    XCTAssertEqual(plan.writtenByteCount, 8u);
+    XCTAssertEqual(plan.skippedRowCount, 1u);
+    XCTAssertEqual(plan.skippedByteCount, 4u);
+}
+
+@end
@@ -0,0 +1,169 @@
+//
+//  OTAFileParserTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "OTAFileParser.h"
+#import "Constants.h"
+
+/*
+ * Silicon ID 0x04A61193, revision 0x1A, sum checksum. Two rows in array 0, one row in array 1.
+ */
+static NSString * const cyacdFixture =
+    @"04A611931A00\r\n"
+    @":00000100050102030405EB\r\n"
+    @":0000020004A0B1C2D314\r\n"
+    @":010000000311223396\r\n";
+
+/*
+ * Version 1, silicon ID 0x04A61193, revision 0x1A, CRC-16 checksum, application 2, product ID 0x12345678
+ */
+static NSString * const cyacd2Fixture =
+    @"019311A6041A010278563412\n"
+    @"@APPINFO:0x10000000,0x200\n"
+    @"@EIV:00112233\n"
+    @":00000010A1A2A3A4\n";
+
+@interface OTAFileParserTests : XCTestCase
+{
+    NSString *directory;
+}
+
+@end
+
+@implementation OTAFileParserTests
+
+- (void)setUp {
+    [super setUp];
+    directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    [[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:nil];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:directory error:nil];
+    [super tearDown];
+}
+
+- (NSString *)writeFixture:(NSString *)contents name:(NSString *)name {
+    [contents writeToFile:[directory stringByAppendingPathComponent:name] atomically:YES encoding:NSASCIIStringEncoding error:nil];
+    return name;
+}
+
+- (void)assertRow:(const OTAFirmwareRow *)row bytes:(const uint8_t *)bytes equal:(const uint8_t *)expected length:(uint16_t)length {
+    XCTAssertEqual(row->dataLength, length);
+    XCTAssertEqual(memcmp(bytes, expected, length), 0);
+}
+
+- (void)testCyacdHeaderAndRows {
+    __block NSMutableDictionary *header = nil;
+    __block OTAFirmwareImage *image = nil;
+    __block NSArray *rowIds = nil;
+    __block NSError *error = nil;
+    [[OTAFileParser new] parseFirmwareFileWithName:[self writeFixture:cyacdFixture name:@"fixture.cyacd"] path:directory onFinish:^(NSMutableDictionary *h, OTAFirmwareImage *i, NSArray *r, NSError *e) {
+        header = h;
+        image = i;
+        rowIds = r;
+        error = e;
+    }];
+    XCTAssertNil(error);
+
+    // Compared against the lowercase strings BootLoaderServiceModel builds from the device response
+    XCTAssertEqualObjects(header[SILICON_ID], @"04a61193");
+    XCTAssertEqualObjects(header[SILICON_REV], @"1a");
+    XCTAssertEqualObjects(header[CHECKSUM_TYPE], @"00");
+    XCTAssertEqualObjects(header[FILE_VERSION], @0);
+
+    NSArray *expectedRowIds = @[@{ROW_ID : @"00", ROW_COUNT : @2}, @{ROW_ID : @"01", ROW_COUNT : @1}];
+    XCTAssertEqualObjects(rowIds, expectedRowIds);
+
+    XCTAssertEqual(image.rowCount, 3u);
+    XCTAssertEqual(image.data.length, 12u);
+    XCTAssertEqual(image.digest.rowCount, 3u);
+
+    const OTAFirmwareRow *row = [image rowAtIndex:0];
+    XCTAssertEqual(row->rowType, RowTypeData);
+    XCTAssertEqual(row->arrayID, 0);
+    XCTAssertEqual(row->rowNumber, 1);
+    XCTAssertEqual(row->checksum, 0xEB);
+    XCTAssertEqual(row->dataOffset, 0u);
+    const uint8_t first[] = {0x01, 0x02, 0x03, 0x04, 0x05};
+    [self assertRow:row bytes:[image bytesForRowAtIndex:0] equal:first length:sizeof(first)];
+
+    row = [image rowAtIndex:1];
+    XCTAssertEqual(row->arrayID, 0);
+    XCTAssertEqual(row->rowNumber, 2);
+    XCTAssertEqual(row->checksum, 0x14);
+    XCTAssertEqual(row->dataOffset, 5u);
+    const uint8_t second[] = {0xA0, 0xB1, 0xC2, 0xD3};
+    [self assertRow:row bytes:[image bytesForRowAtIndex:1] equal:second length:sizeof(second)];
+
+    row = [image rowAtIndex:2];
+    XCTAssertEqual(row->arrayID, 1);
+    XCTAssertEqual(row->rowNumber, 0);
+    XCTAssertEqual(row->checksum, 0x96);
+    XCTAssertEqual(row->dataOffset, 9u);
+    const uint8_t third[] = {0x11, 0x22, 0x33};
+    [self assertRow:row bytes:[image bytesForRowAtIndex:2] equal:third length:sizeof(third)];
+
+    NSData *slice = [image dataForRowAtIndex:1 range:NSMakeRange(1, 2)];
+    const uint8_t sliceBytes[] = {0xB1, 0xC2};
+    XCTAssertEqualObjects(slice, [NSData dataWithBytes:sliceBytes length:sizeof(sliceBytes)]);
+}
+
+- (void)testCyacd2HeaderAndRows {
+    __block NSMutableDictionary *header = nil;
+    __block NSDictionary *appInfo = nil;
+    __block OTAFirmwareImage *image = nil;
+    __block NSError *error = nil;
+    [[OTAFileParser new] parseFirmwareFileWithName_v1:[self writeFixture:cyacd2Fixture name:@"fixture.cyacd2"] path:directory onFinish:^(NSMutableDictionary *h, NSDictionary *a, OTAFirmwareImage *i, NSError *e) {
+        header = h;
+        appInfo = a;
+        image = i;
+        error = e;
+    }];
+    XCTAssertNil(error);
+
+    XCTAssertEqualObjects(header[SILICON_ID], @"04a61193");
+    XCTAssertEqualObjects(header[SILICON_REV], @"1a");
+    XCTAssertEqualObjects(header[CHECKSUM_TYPE], @"01");
+    XCTAssertEqualObjects(header[FILE_VERSION], @1);
+    XCTAssertEqualObjects(header[APP_ID], @2);
+    XCTAssertEqualObjects(header[PRODUCT_ID], @0x12345678u);
+
+    XCTAssertEqualObjects(appInfo[APPINFO_APP_START], @0x10000000u);
+    XCTAssertEqualObjects(appInfo[APPINFO_APP_SIZE], @0x200u);
+
+    XCTAssertEqual(image.rowCount, 2u);
+    const OTAFirmwareRow *row = [image rowAtIndex:0];
+    XCTAssertEqual(row->rowType, RowTypeEiv);
+    const uint8_t eiv[] = {0x00, 0x11, 0x22, 0x33};
+    [self assertRow:row bytes:[image bytesForRowAtIndex:0] equal:eiv length:sizeof(eiv)];
+
+    row = [image rowAtIndex:1];
+    XCTAssertEqual(row->rowType, RowTypeData);
+    XCTAssertEqual(row->address, 0x10000000u);
+    const uint8_t data[] = {0xA1, 0xA2, 0xA3, 0xA4};
+    [self assertRow:row bytes:[image bytesForRowAtIndex:1] equal:data length:sizeof(data)];
+}
+
+- (void)testMalformedFile {
+    __block NSError *error = nil;
+    __block OTAFirmwareImage *image = nil;
+    NSString *name = [self writeFixture:@"04A611931A00\r\n:00000100050102030405\r\n" name:@"short.cyacd"];
+    [[OTAFileParser new] parseFirmwareFileWithName:name path:directory onFinish:^(NSMutableDictionary *h, OTAFirmwareImage *i, NSArray *r, NSError *e) {
+        image = i;
+        error = e;
+    }];
+    XCTAssertNil(image);
+    XCTAssertEqualObjects(error.domain, FILE_FORMAT_ERROR);
+
+    [[OTAFileParser new] parseFirmwareFileWithName:@"missing.cyacd" path:directory onFinish:^(NSMutableDictionary *h, OTAFirmwareImage *i, NSArray *r, NSError *e) {
+        error = e;
+    }];
+    XCTAssertEqualObjects(error.domain, FILE_EMPTY_ERROR);
+}
+
+@end
@@ -0,0 +1,124 @@
+//
+//  OTAImageDigestTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "OTAFirmwareImage.h"
+#import "OTAImageDigest.h"
+
+@interface OTAImageDigestTests : XCTestCase
+
+@end
+
+@implementation OTAImageDigestTests
+{
+    NSString *directory;
+}
+
+- (void)setUp {
+    [super setUp];
+    directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    [[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:nil];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:directory error:nil];
+    [super tearDown];
+}
+
+/*
+ * Image of three 4 byte rows in array 0, with a hash of its own so that cache entries of tests do not collide
+ */
+- (OTAFirmwareImage *)image {
+    OTAFirmwareImage *image = [[OTAFirmwareImage alloc] initWithCapacity:12];
+    for (uint16_t i = 0; i < 3; i++) {
+        OTAFirmwareRow row = {0};
+        row.rowType = RowTypeData;
+        row.rowNumber = i;
+        row.dataLength = 4;
+        row.checksum = (uint8_t)(0x10 * i);
+        uint8_t bytes[4] = {(uint8_t)i, 0x11, 0x22, 0x33};
+        [image appendRow:row bytes:bytes];
+    }
+    uuid_t hash;
+    [[NSUUID UUID] getUUIDBytes:hash];
+    image.digest = [[OTAImageDigest alloc] initWithImage:image fileHash:[NSData dataWithBytes:hash length:sizeof(hash)]];
+    return image;
+}
+
+- (NSData *)checksumsOfDigest:(OTAImageDigest *)digest fromRow:(NSUInteger)firstRow {
+    NSMutableData *checksums = [NSMutableData new];
+    for (NSUInteger i = firstRow; i < digest.rowCount; i++) {
+        [checksums appendBytes:&[digest rowDigestAtIndex:i]->verifyChecksum length:1];
+    }
+    return checksums;
+}
+
+- (void)testFileHashIsCachedUntilTheFileChanges {
+    NSString *path = [directory stringByAppendingPathComponent:@"image.cyacd"];
+    NSDate *modificationDate = [NSDate dateWithTimeIntervalSinceReferenceDate:500000000];
+    XCTAssertTrue([@"first" writeToFile:path atomically:NO encoding:NSUTF8StringEncoding error:nil]);
+    [[NSFileManager defaultManager] setAttributes:@{NSFileModificationDate : modificationDate} ofItemAtPath:path error:nil];
+    NSData *firstHash = [OTAImageDigest hashForFileAtPath:path];
+    XCTAssertEqual(firstHash.length, 32u);
+
+    // Same size and modification date: the cached hash is returned without reading the file
+    XCTAssertTrue([@"other" writeToFile:path atomically:NO encoding:NSUTF8StringEncoding error:nil]);
+    [[NSFileManager defaultManager] setAttributes:@{NSFileModificationDate : modificationDate} ofItemAtPath:path error:nil];
+    XCTAssertEqualObjects([OTAImageDigest hashForFileAtPath:path], firstHash);
+
+    [[NSFileManager defaultManager] setAttributes:@{NSFileModificationDate : [modificationDate dateByAddingTimeInterval:1]} ofItemAtPath:path error:nil];
+    NSData *secondHash = [OTAImageDigest hashForFileAtPath:path];
+    XCTAssertEqual(secondHash.length, 32u);
+    XCTAssertNotEqualObjects(secondHash, firstHash);
+
+    XCTAssertNil([OTAImageDigest hashForFileAtPath:[directory stringByAppendingPathComponent:@"missing.cyacd"]]);
+}
+
+- (void)testDigestCacheRoundTrip {
+    OTAImageDigest *digest = [self image].digest;
+    XCTAssertTrue([digest writeToCache]);
+
+    OTAImageDigest *cached = [OTAImageDigest cachedDigestForFileHash:digest.fileHash];
+    XCTAssertNotNil(cached);
+    XCTAssertEqual(cached.rowCount, digest.rowCount);
+    XCTAssertEqual(cached.appChecksum, digest.appChecksum);
+    XCTAssertEqual(cached.appCRC32, digest.appCRC32);
+    for (NSUInteger i = 0; i < digest.rowCount; i++) {
+        XCTAssertEqual(memcmp([cached rowDigestAtIndex:i], [digest rowDigestAtIndex:i], sizeof(OTARowDigest)), 0);
+    }
+}
+
+- (void)testRowChecksumsAreVerified {
+    OTAImageDigest *digest = [self image].digest;
+    NSMutableData *checksums = [[self checksumsOfDigest:digest fromRow:0] mutableCopy];
+    XCTAssertEqual([digest verifyDeviceRowChecksums:checksums fromRowAtIndex:0 appValid:YES mismatchedRows:NULL], OTAImageVerificationPassed);
+    XCTAssertEqual([digest verifyDeviceRowChecksums:checksums fromRowAtIndex:0 appValid:NO mismatchedRows:NULL], OTAImageVerificationAppInvalid);
+
+    ((uint8_t *)checksums.mutableBytes)[1] ^= 0xFF;
+    NSIndexSet *mismatched = nil;
+    XCTAssertEqual([digest verifyDeviceRowChecksums:checksums fromRowAtIndex:0 appValid:YES mismatchedRows:&mismatched], OTAImageVerificationRowMismatch);
+    XCTAssertEqualObjects(mismatched, [NSIndexSet indexSetWithIndex:1]);
+
+    // A missing row checksum is a mismatch too
+    checksums.length = 2;
+    XCTAssertEqual([digest verifyDeviceRowChecksums:checksums fromRowAtIndex:0 appValid:YES mismatchedRows:&mismatched], OTAImageVerificationRowMismatch);
+    XCTAssertTrue([mismatched containsIndex:2]);
+}
+
+- (void)testResumedRowsAreLeftToTheApplicationChecksum {
+    OTAImageDigest *digest = [self image].digest;
+    NSMutableData *checksums = [[self checksumsOfDigest:digest fromRow:1] mutableCopy];
+    XCTAssertEqual([digest verifyDeviceRowChecksums:checksums fromRowAtIndex:1 appValid:YES mismatchedRows:NULL], OTAImageVerificationPassed);
+    XCTAssertEqual([digest verifyDeviceRowChecksums:checksums fromRowAtIndex:1 appValid:NO mismatchedRows:NULL], OTAImageVerificationAppInvalid);
+
+    ((uint8_t *)checksums.mutableBytes)[1] ^= 0xFF;
+    NSIndexSet *mismatched = nil;
+    XCTAssertEqual([digest verifyDeviceRowChecksums:checksums fromRowAtIndex:1 appValid:YES mismatchedRows:&mismatched], OTAImageVerificationRowMismatch);
+    XCTAssertEqualObjects(mismatched, [NSIndexSet indexSetWithIndex:2]);
+}
+
+@end
@@ -0,0 +1,149 @@
+//
+//  OTATransferEngineTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "OTATransferEngine.h"
+
+#define TEST_SEND_DATA          0x37
+#define TEST_PROGRAM_ROW        0x39
+#define TEST_STATUS_SUCCESS     0x00
+#define TEST_STATUS_ERROR       0x03
+
+@interface OTATransferEngineTests : XCTestCase
+{
+    ota_transfer transfer;
+}
+
+@end
+
+@implementation OTATransferEngineTests
+
+- (void)setUp {
+    [super setUp];
+    ota_transfer_init(&transfer, TEST_SEND_DATA, TEST_PROGRAM_ROW, 4);
+}
+
+- (void)expectPacket:(uint8_t)command offset:(uint32_t)offset length:(uint32_t)length {
+    ota_transfer_packet packet;
+    XCTAssertEqual(ota_transfer_next_packet(&transfer, &packet), 1);
+    XCTAssertEqual(packet.command, command);
+    XCTAssertEqual(packet.offset, offset);
+    XCTAssertEqual(packet.length, length);
+}
+
+- (void)expectNoPacket {
+    ota_transfer_packet packet;
+    XCTAssertEqual(ota_transfer_next_packet(&transfer, &packet), 0);
+}
+
+- (void)testChunkSize {
+    // Packets that fit a single write are not split
+    XCTAssertEqual(ota_transfer_chunk_size(0, 7, 133), 133u);
+    XCTAssertEqual(ota_transfer_chunk_size(244, 7, 133), 133u);
+
+    // Command packets fill whole writes
+    XCTAssertEqual(ota_transfer_chunk_size(20, 7, 133), 133u);
+    XCTAssertEqual(ota_transfer_chunk_size(20, 7, 150), 133u);
+    XCTAssertEqual(ota_transfer_chunk_size(182, 7, 300), 175u);
+
+    // The overhead alone fills the writes, no payload fits
+    XCTAssertEqual(ota_transfer_chunk_size(20, 45, 10), 0u);
+    XCTAssertEqual(ota_transfer_chunk_size(20, 40, 5), 0u);
+
+    // Lengths near the top of the range do not wrap
+    XCTAssertEqual(ota_transfer_chunk_size(20, 7, UINT32_MAX), 4294967293u);
+    XCTAssertEqual(ota_transfer_chunk_size(UINT32_MAX, UINT32_MAX, 1), 0u);
+}
+
+- (void)testWindowIsClamped {
+    ota_transfer_init(&transfer, TEST_SEND_DATA, TEST_PROGRAM_ROW, 0);
+    XCTAssertEqual(transfer.window, 1);
+    ota_transfer_init(&transfer, TEST_SEND_DATA, TEST_PROGRAM_ROW, 1000);
+    XCTAssertEqual(transfer.window, OTA_TRANSFER_MAX_WINDOW);
+}
+
+- (void)testWindowLimitsCommandsInFlight {
+    ota_transfer_begin_row(&transfer, 100, 10);
+    for (uint32_t i = 0; i < 4; i++) {
+        [self expectPacket:TEST_SEND_DATA offset:i * 10 length:10];
+    }
+    [self expectNoPacket];
+    XCTAssertEqual(ota_transfer_in_flight(&transfer), 4);
+
+    XCTAssertEqual(ota_transfer_on_response(&transfer, TEST_SEND_DATA, TEST_STATUS_SUCCESS), OTA_TRANSFER_CONTINUE);
+    [self expectPacket:TEST_SEND_DATA offset:40 length:10];
+    [self expectNoPacket];
+}
+
+- (void)testProgramWaitsForEveryChunk {
+    ota_transfer_begin_row(&transfer, 25, 10);
+    [self expectPacket:TEST_SEND_DATA offset:0 length:10];
+    [self expectPacket:TEST_SEND_DATA offset:10 length:10];
+
+    // The last piece is held until both chunks are acknowledged
+    [self expectNoPacket];
+    XCTAssertEqual(ota_transfer_on_response(&transfer, TEST_SEND_DATA, TEST_STATUS_SUCCESS), OTA_TRANSFER_CONTINUE);
+    [self expectNoPacket];
+    XCTAssertEqual(ota_transfer_on_response(&transfer, TEST_SEND_DATA, TEST_STATUS_SUCCESS), OTA_TRANSFER_CONTINUE);
+
+    [self expectPacket:TEST_PROGRAM_ROW offset:20 length:5];
+    [self expectNoPacket];
+    XCTAssertEqual(ota_transfer_on_response(&transfer, TEST_PROGRAM_ROW, TEST_STATUS_SUCCESS), OTA_TRANSFER_ROW_DONE);
+    XCTAssertEqual(transfer.restarts, 0u);
+}
+
+- (void)testRejectedChunkFallsBackToStopAndWait {
+    ota_transfer_begin_row(&transfer, 40, 10);
+    [self expectPacket:TEST_SEND_DATA offset:0 length:10];
+    [self expectPacket:TEST_SEND_DATA offset:10 length:10];
+    [self expectPacket:TEST_SEND_DATA offset:20 length:10];
+
+    // The rejection drains the commands in flight before the row is sent again
+    XCTAssertEqual(ota_transfer_on_response(&transfer, TEST_SEND_DATA, TEST_STATUS_ERROR), OTA_TRANSFER_CONTINUE);
+    XCTAssertEqual(transfer.window, 1);
+    XCTAssertEqual(transfer.last_error, TEST_STATUS_ERROR);
+    [self expectNoPacket];
+    XCTAssertEqual(ota_transfer_on_response(&transfer, TEST_SEND_DATA, TEST_STATUS_SUCCESS), OTA_TRANSFER_CONTINUE);
+    [self expectNoPacket];
+    XCTAssertEqual(ota_transfer_on_response(&transfer, TEST_SEND_DATA, TEST_STATUS_SUCCESS), OTA_TRANSFER_CONTINUE);
+    XCTAssertEqual(transfer.restarts, 1u);
+
+    // Stop-and-wait from now on
+    for (uint32_t offset = 0; offset < 30; offset += 10) {
+        [self expectPacket:TEST_SEND_DATA offset:offset length:10];
+        [self expectNoPacket];
+        XCTAssertEqual(ota_transfer_on_response(&transfer, TEST_SEND_DATA, TEST_STATUS_SUCCESS), OTA_TRANSFER_CONTINUE);
+    }
+
+    // Data accepted while draining made the target reject the row once more, which is allowed
+    [self expectPacket:TEST_PROGRAM_ROW offset:30 length:10];
+    XCTAssertEqual(ota_transfer_on_response(&transfer, TEST_PROGRAM_ROW, TEST_STATUS_ERROR), OTA_TRANSFER_CONTINUE);
+    XCTAssertEqual(transfer.restarts, 2u);
+
+    for (uint32_t offset = 0; offset < 30; offset += 10) {
+        [self expectPacket:TEST_SEND_DATA offset:offset length:10];
+        XCTAssertEqual(ota_transfer_on_response(&transfer, TEST_SEND_DATA, TEST_STATUS_SUCCESS), OTA_TRANSFER_CONTINUE);
+    }
+    [self expectPacket:TEST_PROGRAM_ROW offset:30 length:10];
+    XCTAssertEqual(ota_transfer_on_response(&transfer, TEST_PROGRAM_ROW, TEST_STATUS_SUCCESS), OTA_TRANSFER_ROW_DONE);
+
+    // A rejection in stop-and-wait fails the row
+    ota_transfer_begin_row(&transfer, 40, 10);
+    [self expectPacket:TEST_SEND_DATA offset:0 length:10];
+    XCTAssertEqual(ota_transfer_on_response(&transfer, TEST_SEND_DATA, TEST_STATUS_ERROR), OTA_TRANSFER_FAILED);
+}
+
+- (void)testUnexpectedResponses {
+    ota_transfer_begin_row(&transfer, 20, 10);
+    XCTAssertEqual(ota_transfer_on_response(&transfer, TEST_SEND_DATA, TEST_STATUS_SUCCESS), OTA_TRANSFER_UNEXPECTED);
+
+    [self expectPacket:TEST_SEND_DATA offset:0 length:10];
+    XCTAssertEqual(ota_transfer_on_response(&transfer, TEST_PROGRAM_ROW, TEST_STATUS_SUCCESS), OTA_TRANSFER_UNEXPECTED);
+    XCTAssertEqual(ota_transfer_in_flight(&transfer), 1);
+}
+
+@end
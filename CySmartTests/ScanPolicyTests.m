@@ -0,0 +1,150 @@
+//
+//  ScanPolicyTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ScanPolicy.h"
+
+@interface ScanPolicyTests : XCTestCase
+{
+    ScanRegistry *registry;
+    ScanPolicyEngine *engine;
+    NSMutableArray *identifiers;
+}
+
+@end
+
+@implementation ScanPolicyTests
+
+- (void)setUp {
+    [super setUp];
+    registry = [[ScanRegistry alloc] initWithPublishInterval:0.2];
+    engine = [[ScanPolicyEngine alloc] initWithCentralManager:nil registry:registry];
+    identifiers = [NSMutableArray array];
+    for (int i = 0; i < 10; i++) {
+        [identifiers addObject:[NSUUID UUID]];
+    }
+}
+
+- (void)tearDown {
+    [engine stop];
+    [super tearDown];
+}
+
+- (BOOL)advertise:(int)device RSSI:(int)RSSI data:(NSDictionary *)data time:(NSTimeInterval)time {
+    return [engine handleAdvertisementOfPeripheral:nil identifier:identifiers[device] advertisementData:data RSSI:@(RSSI) time:time];
+}
+
+- (BOOL)runUntilScanning:(BOOL)scanning {
+    NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:2];
+    while (engine.scanning != scanning && [deadline timeIntervalSinceNow] > 0) {
+        [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+    return engine.scanning == scanning;
+}
+
+- (void)testFilterAdmitsNewPeripheralsOnly {
+    ScanFilter *filter = [[ScanFilter alloc] init];
+    filter.nameText = @"therm";
+    filter.manufacturerDataPrefix = [NSData dataWithBytes:"\x31\x01" length:2];
+    filter.minimumRSSI = @(-70);
+    ScanPolicy *policy = [ScanPolicy defaultPolicy];
+    policy.filter = filter;
+    engine.policy = policy;
+
+    NSData *cypress = [NSData dataWithBytes:"\x31\x01\x05" length:3];
+    XCTAssertTrue([self advertise:0 RSSI:-60 data:@{CBAdvertisementDataLocalNameKey: @"Thermometer", CBAdvertisementDataManufacturerDataKey: cypress} time:0]);
+    XCTAssertFalse([self advertise:1 RSSI:-80 data:@{CBAdvertisementDataLocalNameKey: @"Thermometer", CBAdvertisementDataManufacturerDataKey: cypress} time:0]);
+    XCTAssertFalse([self advertise:2 RSSI:-60 data:@{CBAdvertisementDataLocalNameKey: @"Heart Rate", CBAdvertisementDataManufacturerDataKey: cypress} time:0]);
+    XCTAssertFalse([self advertise:3 RSSI:-60 data:@{CBAdvertisementDataLocalNameKey: @"Thermometer"} time:0]);
+    XCTAssertFalse([self advertise:4 RSSI:RSSI_UNDEFINED_VALUE data:@{CBAdvertisementDataLocalNameKey: @"Thermometer", CBAdvertisementDataManufacturerDataKey: cypress} time:0]);
+    [registry publishChangesAtTime:0];
+    XCTAssertEqual(registry.devices.count, 1u);
+
+    // An admitted peripheral is updated by advertisements that would not admit it
+    XCTAssertTrue([self advertise:0 RSSI:-90 data:@{CBAdvertisementDataIsConnectable: @YES} time:1]);
+    XCTAssertEqualObjects([registry deviceWithIdentifier:identifiers[0]].mRSSI, @(-90));
+}
+
+- (void)testUpdatesAreRateLimited {
+    ScanPolicy *policy = [ScanPolicy defaultPolicy];
+    policy.minimumUpdateInterval = 0.5;
+    engine.policy = policy;
+
+    [self advertise:0 RSSI:-60 data:@{} time:0];
+    [registry publishChangesAtTime:0];
+    CBPeripheralExt *device = registry.devices[0];
+
+    // Advertisements within the interval only mark the peripheral as seen
+    [self advertise:0 RSSI:-20 data:@{CBAdvertisementDataLocalNameKey: @"Thermometer"} time:0.3];
+    XCTAssertEqualObjects(device.mRSSI, @(-60));
+    XCTAssertNil(device.mAdvertisementData[CBAdvertisementDataLocalNameKey]);
+    XCTAssertEqualWithAccuracy(device.lastSeenTime, 0.3, 0.001);
+    XCTAssertNil([registry publishChangesAtTime:0.3]);
+
+    [self advertise:0 RSSI:-20 data:@{CBAdvertisementDataLocalNameKey: @"Thermometer"} time:0.6];
+    XCTAssertEqualObjects(device.mRSSI, @(-20));
+    XCTAssertEqualObjects(device.mAdvertisementData[CBAdvertisementDataLocalNameKey], @"Thermometer");
+    XCTAssertEqualObjects([registry publishChangesAtTime:0.6].updatedIndexes, [NSIndexSet indexSetWithIndex:0]);
+}
+
+- (void)testPausedTimeDoesNotAgePeripherals {
+    registry.staleInterval = 5;
+    [self advertise:0 RSSI:-60 data:@{} time:0];
+    [registry startPublishingAtTime:0];
+    [registry publishChangesAtTime:0];
+    [registry stopPublishingAtTime:1];
+
+    // 99 s paused: 4 s of scanning without advertisements when publishing resumes at 100 and 7 s at 103
+    [registry startPublishingAtTime:100];
+    XCTAssertNil([registry publishChangesAtTime:103]);
+    XCTAssertEqual(registry.devices.count, 1u);
+    XCTAssertEqualObjects([registry publishChangesAtTime:106].removedIndexes, [NSIndexSet indexSetWithIndex:0]);
+    [registry stopPublishingAtTime:106];
+
+    // Without a stale interval peripherals are kept
+    registry.staleInterval = 0;
+    [self advertise:1 RSSI:-60 data:@{} time:0];
+    [registry publishChangesAtTime:0];
+    XCTAssertNil([registry publishChangesAtTime:1000]);
+    XCTAssertEqual(registry.devices.count, 1u);
+}
+
+- (void)testScanWindowsAlternate {
+    [engine start];
+    XCTAssertTrue(engine.started);
+    XCTAssertTrue(engine.scanning);
+
+    ScanPolicy *policy = [ScanPolicy defaultPolicy];
+    policy.scanWindow = 0.05;
+    policy.scanInterval = 0.15;
+    XCTAssertTrue([policy isDutyCycled]);
+    engine.policy = policy;
+    XCTAssertTrue(engine.scanning);
+    for (int cycle = 0; cycle < 3; cycle++) {
+        XCTAssertTrue([self runUntilScanning:NO]);
+        XCTAssertTrue([self runUntilScanning:YES]);
+    }
+
+    [engine stop];
+    XCTAssertFalse(engine.started);
+    XCTAssertFalse(engine.scanning);
+    [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.3]];
+    XCTAssertFalse(engine.scanning);
+}
+
+- (void)testContinuousScanStaysOpen {
+    ScanPolicy *policy = [ScanPolicy defaultPolicy];
+    policy.scanWindow = 1;
+    policy.scanInterval = 1;
+    XCTAssertFalse([policy isDutyCycled]);
+    engine.policy = policy;
+    [engine start];
+    [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+    XCTAssertTrue(engine.scanning);
+}
+
+@end
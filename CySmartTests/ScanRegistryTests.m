@@ -0,0 +1,137 @@
+//
+//  ScanRegistryTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ScanRegistry.h"
+
+@interface ScanRegistryTests : XCTestCase
+{
+    ScanRegistry *registry;
+    NSMutableArray *identifiers;
+}
+
+@end
+
+@implementation ScanRegistryTests
+
+- (void)setUp {
+    [super setUp];
+    registry = [[ScanRegistry alloc] initWithPublishInterval:0.2];
+    identifiers = [NSMutableArray array];
+    for (int i = 0; i < 500; i++) {
+        [identifiers addObject:[NSUUID UUID]];
+    }
+}
+
+- (void)advertise:(int)device RSSI:(int)RSSI data:(NSDictionary *)data time:(NSTimeInterval)time {
+    [registry updateWithPeripheral:nil identifier:identifiers[device] advertisementData:data RSSI:@(RSSI) time:time];
+}
+
+- (void)testAdvertisementsAreCoalescedIntoOneDiff {
+    for (int round = 0; round < 20; round++) {
+        for (int i = 0; i < 300; i++) {
+            [self advertise:i RSSI:-60 data:@{CBAdvertisementDataLocalNameKey: @"CySmart"} time:1.0];
+        }
+    }
+    XCTAssertEqual(registry.devices.count, 0u);
+
+    ScanRegistryDiff *diff = [registry publishChangesAtTime:1.0];
+    XCTAssertEqualObjects(diff.insertedIndexes, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 300)]);
+    XCTAssertEqual(diff.removedIndexes.count, 0u);
+    XCTAssertEqual(diff.updatedIndexes.count, 0u);
+    XCTAssertEqual(registry.devices.count, 300u);
+    XCTAssertEqual([registry deviceWithIdentifier:identifiers[42]].scanIndex, 42u);
+
+    // The same RSSI and data again change nothing
+    [self advertise:7 RSSI:-60 data:@{CBAdvertisementDataLocalNameKey: @"CySmart"} time:1.1];
+    XCTAssertNil([registry publishChangesAtTime:1.1]);
+}
+
+- (void)testUpdatesAreInPlace {
+    [self advertise:0 RSSI:-80 data:@{CBAdvertisementDataIsConnectable: @YES} time:0];
+    [self advertise:1 RSSI:-50 data:@{} time:0];
+    [registry publishChangesAtTime:0];
+    CBPeripheralExt *device = registry.devices[0];
+
+    // A scan response adds to the advertisement data
+    [self advertise:0 RSSI:-40 data:@{CBAdvertisementDataLocalNameKey: @"Thermometer"} time:0.5];
+    ScanRegistryDiff *diff = [registry publishChangesAtTime:0.5];
+    XCTAssertEqualObjects(diff.updatedIndexes, [NSIndexSet indexSetWithIndex:0]);
+    XCTAssertEqual(diff.insertedIndexes.count, 0u);
+    XCTAssertEqual(registry.devices[0], device);
+    XCTAssertEqualObjects(device.mAdvertisementData[CBAdvertisementDataLocalNameKey], @"Thermometer");
+    XCTAssertEqualObjects(device.mAdvertisementData[CBAdvertisementDataIsConnectable], @YES);
+    XCTAssertEqualObjects(device.mRSSI, @(-40));
+    XCTAssertEqualWithAccuracy(device.smoothedRSSI, -70.0, 0.001);
+    XCTAssertEqualWithAccuracy(device.lastSeenTime, 0.5, 0.001);
+
+    // An unavailable RSSI leaves the average alone
+    [self advertise:0 RSSI:RSSI_UNDEFINED_VALUE data:@{} time:0.6];
+    XCTAssertEqualWithAccuracy(device.smoothedRSSI, -70.0, 0.001);
+}
+
+- (void)testStalePeripheralsAreRemoved {
+    for (int i = 0; i < 5; i++) {
+        [self advertise:i RSSI:-60 data:@{} time:0];
+    }
+    [registry publishChangesAtTime:0];
+
+    registry.staleInterval = 5;
+    [self advertise:1 RSSI:-60 data:@{} time:4];
+    [self advertise:3 RSSI:-60 data:@{} time:4];
+    [self advertise:5 RSSI:-60 data:@{} time:6];
+    ScanRegistryDiff *diff = [registry publishChangesAtTime:6];
+
+    NSMutableIndexSet *removed = [NSMutableIndexSet indexSet];
+    [removed addIndex:0];
+    [removed addIndex:2];
+    [removed addIndex:4];
+    XCTAssertEqualObjects(diff.removedIndexes, removed);
+    XCTAssertEqualObjects(diff.insertedIndexes, [NSIndexSet indexSetWithIndex:2]);
+    XCTAssertEqual(registry.devices.count, 3u);
+    XCTAssertEqualObjects([registry.devices[1] identifier], identifiers[3]);
+    XCTAssertEqual([registry.devices[1] scanIndex], 1u);
+    XCTAssertNil([registry deviceWithIdentifier:identifiers[0]]);
+
+    // A removed peripheral that comes back is found again
+    [self advertise:0 RSSI:-60 data:@{} time:7];
+    XCTAssertEqualObjects([registry publishChangesAtTime:7].insertedIndexes, [NSIndexSet indexSetWithIndex:3]);
+}
+
+- (void)testRemoveAllDevicesPublishesRemoval {
+    __block ScanRegistryDiff *published = nil;
+    registry.publishHandler = ^(ScanRegistryDiff *diff) {
+        published = diff;
+    };
+    for (int i = 0; i < 3; i++) {
+        [self advertise:i RSSI:-60 data:@{} time:0];
+    }
+    [registry publishChangesAtTime:0];
+    XCTAssertEqual(published.insertedIndexes.count, 3u);
+
+    [self advertise:3 RSSI:-60 data:@{} time:0];
+    [registry removeAllDevices];
+    XCTAssertEqualObjects(published.removedIndexes, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 3)]);
+    XCTAssertEqual(registry.devices.count, 0u);
+    XCTAssertNil([registry publishChangesAtTime:0]);
+}
+
+- (void)testAdvertisementPerformance {
+    NSDictionary *data = @{CBAdvertisementDataLocalNameKey: @"CySmart"};
+    __block NSTimeInterval time = 0;
+    [self measureBlock:^{
+        for (int round = 0; round < 100; round++) {
+            for (int i = 0; i < 500; i++) {
+                [self advertise:i RSSI:-60 - (round + i) % 20 data:data time:time];
+            }
+            time += 0.01;
+            [self->registry publishChangesAtTime:time];
+        }
+    }];
+}
+
+@end
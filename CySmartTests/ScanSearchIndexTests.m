@@ -0,0 +1,154 @@
+//
+//  ScanSearchIndexTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ScanSearchIndex.h"
+
+@interface ScanSearchIndexTests : XCTestCase
+{
+    ScanRegistry *registry;
+    ScanSearchIndex *searchIndex;
+    NSMutableArray *identifiers;
+}
+
+@end
+
+@implementation ScanSearchIndexTests
+
+- (void)setUp {
+    [super setUp];
+    registry = [[ScanRegistry alloc] initWithPublishInterval:0.2];
+    searchIndex = [[ScanSearchIndex alloc] initWithRegistry:registry];
+    identifiers = [NSMutableArray array];
+}
+
+- (void)advertiseName:(NSString *)name RSSI:(int)RSSI data:(NSDictionary *)data time:(NSTimeInterval)time {
+    [identifiers addObject:[NSUUID UUID]];
+    NSMutableDictionary *advertisement = [NSMutableDictionary dictionaryWithDictionary:data];
+    advertisement[CBAdvertisementDataLocalNameKey] = name;
+    [registry updateWithPeripheral:nil identifier:identifiers.lastObject advertisementData:advertisement RSSI:@(RSSI) time:time];
+}
+
+- (void)publishAtTime:(NSTimeInterval)time {
+    ScanRegistryDiff *diff = [registry publishChangesAtTime:time];
+    if (diff) {
+        [searchIndex applyDiff:diff];
+    }
+}
+
+- (NSArray *)matchingNames {
+    return [[searchIndex matchingDevices] valueForKey:@"displayName"];
+}
+
+- (ScanFilter *)filterWithText:(NSString *)text {
+    ScanFilter *filter = [[ScanFilter alloc] init];
+    filter.nameText = text;
+    return filter;
+}
+
+- (void)testNamesAreFolded {
+    for (NSString *name in @[@"CySmart Thermometer", @"Café Sensor", @"CYSMART Hub", @"Heart Rate"]) {
+        [self advertiseName:name RSSI:-60 data:nil time:0];
+    }
+    [self publishAtTime:0];
+
+    searchIndex.filter = [self filterWithText:@" cysmart "];
+    XCTAssertEqualObjects([self matchingNames], (@[@"CySmart Thermometer", @"CYSMART Hub"]));
+    searchIndex.filter = [self filterWithText:@"cafe"];
+    XCTAssertEqualObjects([self matchingNames], @[@"Café Sensor"]);
+
+    ScanFilter *prefix = [self filterWithText:@"sensor"];
+    prefix.matchesNamePrefix = YES;
+    searchIndex.filter = prefix;
+    XCTAssertEqual([self matchingNames].count, 0u);
+    prefix.nameText = @"hea";
+    searchIndex.filter = prefix;
+    XCTAssertEqualObjects([self matchingNames], @[@"Heart Rate"]);
+}
+
+- (void)testNarrowingMatchesFullSearch {
+    NSArray *words = @[@"cy", @"smart", @"sens", @"hub", @"ota", @"tag"];
+    for (int i = 0; i < 400; i++) {
+        [self advertiseName:[NSString stringWithFormat:@"%@%@ %d", words[i % 6], words[(i / 6) % 6], i] RSSI:-40 - i % 60 data:nil time:0];
+    }
+    [self publishAtTime:0];
+
+    ScanSearchIndex *fresh = [[ScanSearchIndex alloc] initWithRegistry:registry];
+    NSString *typed = @"smartcy 1";
+    for (NSUInteger length = 1; length <= typed.length; length++) {
+        ScanFilter *filter = [self filterWithText:[typed substringToIndex:length]];
+        filter.minimumRSSI = @(-90 + (int)length * 3);
+        searchIndex.filter = filter;
+        fresh.filter = nil;
+        fresh.filter = filter;
+        XCTAssertEqualObjects(searchIndex.matchingIndexes, fresh.matchingIndexes);
+    }
+    XCTAssertGreaterThan(searchIndex.matchingIndexes.count, 0u);
+}
+
+- (void)testDiscoveriesJoinActiveResults {
+    [self advertiseName:@"Tag 1" RSSI:-60 data:nil time:0];
+    [self advertiseName:@"Hub" RSSI:-60 data:nil time:0];
+    [self advertiseName:@"Tag 2" RSSI:-60 data:nil time:0];
+    [self publishAtTime:0];
+    searchIndex.filter = [self filterWithText:@"tag"];
+    XCTAssertEqualObjects([self matchingNames], (@[@"Tag 1", @"Tag 2"]));
+
+    // The first two go stale while a new tag is found
+    registry.staleInterval = 5;
+    [registry updateWithPeripheral:nil identifier:identifiers[2] advertisementData:@{} RSSI:@(-60) time:4];
+    [self advertiseName:@"Tag 3" RSSI:-60 data:nil time:6];
+    [self publishAtTime:6];
+    XCTAssertEqualObjects([self matchingNames], (@[@"Tag 2", @"Tag 3"]));
+    XCTAssertEqualObjects(searchIndex.matchingIndexes, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 2)]);
+
+    // A name from a scan response is searched again
+    [registry updateWithPeripheral:nil identifier:identifiers[2] advertisementData:@{CBAdvertisementDataLocalNameKey: @"Renamed"} RSSI:@(-60) time:6.5];
+    [self publishAtTime:6.5];
+    XCTAssertEqualObjects([self matchingNames], @[@"Tag 3"]);
+}
+
+- (void)testAdvertisementFilters {
+    CBUUID *heartRate = [CBUUID UUIDWithString:@"180D"];
+    CBUUID *battery = [CBUUID UUIDWithString:@"180F"];
+    uint8_t cypress[4] = {0x31, 0x01, 0x05, 0x00};
+    [self advertiseName:@"A" RSSI:-50 data:@{CBAdvertisementDataServiceUUIDsKey: @[heartRate]} time:0];
+    [self advertiseName:@"B" RSSI:-80 data:@{CBAdvertisementDataServiceUUIDsKey: @[battery, heartRate],
+                                            CBAdvertisementDataManufacturerDataKey: [NSData dataWithBytes:cypress length:4]} time:0];
+    [self advertiseName:@"C" RSSI:-70 data:@{CBAdvertisementDataManufacturerDataKey: [NSData dataWithBytes:cypress length:1]} time:0];
+    [self publishAtTime:0];
+
+    ScanFilter *filter = [[ScanFilter alloc] init];
+    filter.serviceUUIDs = @[heartRate];
+    searchIndex.filter = filter;
+    XCTAssertEqualObjects([self matchingNames], (@[@"A", @"B"]));
+
+    filter.serviceUUIDs = nil;
+    filter.manufacturerDataPrefix = [NSData dataWithBytes:cypress length:2];
+    searchIndex.filter = filter;
+    XCTAssertEqualObjects([self matchingNames], @[@"B"]);
+
+    filter.manufacturerDataPrefix = nil;
+    filter.minimumRSSI = @(-75);
+    searchIndex.filter = filter;
+    XCTAssertEqualObjects([self matchingNames], (@[@"A", @"C"]));
+}
+
+- (void)testTypingPerformance {
+    for (int i = 0; i < 2000; i++) {
+        [self advertiseName:[NSString stringWithFormat:@"CySmart Device %d", i] RSSI:-60 data:nil time:0];
+    }
+    [self publishAtTime:0];
+    [self measureBlock:^{
+        for (NSString *text in @[@"c", @"cy", @"cys", @"cysm", @"cysma", @"cysmar", @"cysmart", @"cysmart d", @"cysmart de"]) {
+            self->searchIndex.filter = [self filterWithText:text];
+        }
+        self->searchIndex.filter = nil;
+    }];
+}
+
+@end
@@ -0,0 +1,138 @@
+//
+//  SensorFrameQueueTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "SensorFrameQueue.h"
+
+#define READER_COUNT            3
+#define FRAME_COUNT             200000
+
+@interface SensorFrameQueueTests : XCTestCase
+{
+    sensor_frame_queue queue;
+    sensor_frame_assembler assembler;
+}
+
+@end
+
+@implementation SensorFrameQueueTests
+
+- (void)setUp {
+    [super setUp];
+    XCTAssertTrue(sensor_frame_queue_init(&queue, 1000));
+    sensor_frame_assembler_init(&assembler, SENSOR_ACCELEROMETER_CHANNELS, 0.1);
+}
+
+- (void)tearDown {
+    sensor_frame_queue_free(&queue);
+    [super tearDown];
+}
+
+- (void)testAxesAreAlignedIntoFrames {
+    sensor_frame_reader reader;
+    sensor_frame_reader_init(&reader, &queue);
+    sensor_frame frames[4];
+
+    XCTAssertEqual(sensor_frame_assembler_add(&assembler, &queue, SENSOR_CHANNEL_X, 1, 10.0), 0u);
+    XCTAssertEqual(sensor_frame_assembler_add(&assembler, &queue, SENSOR_CHANNEL_PRESSURE, 5, 10.01), 0u);
+    XCTAssertEqual(sensor_frame_assembler_add(&assembler, &queue, SENSOR_CHANNEL_Y, 2, 10.02), 0u);
+    XCTAssertEqual(sensor_frame_assembler_add(&assembler, &queue, SENSOR_CHANNEL_Z, 3, 10.03), 1u);
+    XCTAssertEqual(sensor_frame_reader_read(&reader, frames, 4), 1u);
+    XCTAssertEqual(frames[0].timestamp, 10.0);
+    XCTAssertEqual(frames[0].fresh, SENSOR_ACCELEROMETER_CHANNELS | SENSOR_CHANNEL_BIT(SENSOR_CHANNEL_PRESSURE));
+    XCTAssertEqual(frames[0].values[SENSOR_CHANNEL_Z], 3.0f);
+
+    // A repeated axis closes the frame, and channels not sampled keep their last value
+    XCTAssertEqual(sensor_frame_assembler_add(&assembler, &queue, SENSOR_CHANNEL_X, 4, 10.1), 0u);
+    XCTAssertEqual(sensor_frame_assembler_add(&assembler, &queue, SENSOR_CHANNEL_X, 5, 10.11), 1u);
+    XCTAssertEqual(sensor_frame_reader_read(&reader, frames, 4), 1u);
+    XCTAssertEqual(frames[0].fresh, SENSOR_CHANNEL_BIT(SENSOR_CHANNEL_X));
+    XCTAssertEqual(frames[0].values[SENSOR_CHANNEL_X], 4.0f);
+    XCTAssertEqual(frames[0].values[SENSOR_CHANNEL_PRESSURE], 5.0f);
+
+    // So does a sample later than the window
+    XCTAssertEqual(sensor_frame_assembler_add(&assembler, &queue, SENSOR_CHANNEL_TEMPERATURE, 25, 10.5), 1u);
+    XCTAssertEqual(sensor_frame_assembler_flush(&assembler, &queue), 1u);
+    XCTAssertEqual(sensor_frame_assembler_flush(&assembler, &queue), 0u);
+    XCTAssertEqual(sensor_frame_reader_read(&reader, frames, 4), 2u);
+    XCTAssertEqual(frames[1].values[SENSOR_CHANNEL_TEMPERATURE], 25.0f);
+    XCTAssertEqual(frames[1].valid, (1u << SENSOR_CHANNEL_COUNT) - 1);
+}
+
+- (void)testSlowReaderSkipsOverwrittenFrames {
+    sensor_frame_reader reader;
+    sensor_frame_reader_init(&reader, &queue);
+
+    for (int i = 0; i < 3000; i++) {
+        sensor_frame frame = {0};
+        frame.timestamp = i;
+        sensor_frame_queue_publish(&queue, &frame);
+    }
+    XCTAssertEqual(sensor_frame_queue_published(&queue), 3000u);
+
+    // Capacity rounds up to 1024
+    sensor_frame frames[2048];
+    XCTAssertEqual(sensor_frame_reader_read(&reader, frames, 2048), 1024u);
+    XCTAssertEqual(reader.overrun, 3000u - 1024);
+    XCTAssertEqual(frames[0].timestamp, 3000.0 - 1024);
+    XCTAssertEqual(sensor_frame_reader_read(&reader, frames, 2048), 0u);
+}
+
+- (void)testReadersSeeEveryFrameInOrder {
+    sensor_frame_queue *q = &queue;
+    __block uint64_t delivered = 0;
+
+    dispatch_group_t group = dispatch_group_create();
+    for (int i = 0; i < READER_COUNT; i++) {
+        dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            sensor_frame_reader reader = {q, 0, 0};
+            sensor_frame frames[64];
+            double last = -1;
+            uint64_t received = 0, torn = 0;
+            while (reader.position < FRAME_COUNT) {
+                uint32_t count = sensor_frame_reader_read(&reader, frames, 64);
+                for (uint32_t j = 0; j < count; j++) {
+                    if (frames[j].timestamp <= last || frames[j].values[SENSOR_CHANNEL_Y] != (float)frames[j].timestamp) {
+                        torn++;
+                    }
+                    last = frames[j].timestamp;
+                }
+                received += count;
+            }
+            XCTAssertEqual(torn, 0u);
+            XCTAssertEqual(received + reader.overrun, (uint64_t)FRAME_COUNT);
+            @synchronized (self) {
+                delivered += received;
+            }
+        });
+    }
+
+    for (int i = 0; i < FRAME_COUNT; i++) {
+        sensor_frame frame = {0};
+        frame.timestamp = i;
+        frame.values[SENSOR_CHANNEL_Y] = i;
+        sensor_frame_queue_publish(q, &frame);
+    }
+
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+    XCTAssertGreaterThan(delivered, 0u);
+}
+
+- (void)testAssemblePerformance {
+    sensor_frame_queue *q = &queue;
+    sensor_frame_assembler *a = &assembler;
+    [self measureBlock:^{
+        double timestamp = 0;
+        for (int i = 0; i < 100000; i++, timestamp += 0.01) {
+            sensor_frame_assembler_add(a, q, SENSOR_CHANNEL_X, i, timestamp);
+            sensor_frame_assembler_add(a, q, SENSOR_CHANNEL_Y, i, timestamp);
+            sensor_frame_assembler_add(a, q, SENSOR_CHANNEL_Z, i, timestamp);
+        }
+    }];
+}
+
+@end
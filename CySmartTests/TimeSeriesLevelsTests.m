@@ -0,0 +1,135 @@
+//
+//  TimeSeriesLevelsTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TimeSeriesLevels.h"
+
+@interface TimeSeriesLevelsTests : XCTestCase
+{
+    time_series_buffer buffer;
+    time_series_levels levels;
+}
+
+@end
+
+@implementation TimeSeriesLevelsTests
+
+- (void)tearDown {
+    time_series_levels_free(&levels);
+    time_series_free(&buffer);
+    [super tearDown];
+}
+
+- (void)openWithCapacity:(uint32_t)capacity {
+    XCTAssertTrue(time_series_init(&buffer, capacity));
+    XCTAssertTrue(time_series_levels_init(&levels, capacity));
+}
+
+- (void)testRangeMatchesEverySample {
+    [self openWithCapacity:500];
+    srand48(20);
+    for (int i = 0; i < 1700; i++) {
+        time_series_append(&buffer, i, (i % 97 == 0) ? NAN : (float)(drand48() * 200 - 100));
+        if (i % 61 != 0) {
+            continue;
+        }
+        time_series_levels_sync(&levels, &buffer);
+        uint32_t count = time_series_count(&buffer);
+        for (int query = 0; query < 50; query++) {
+            uint32_t start = (uint32_t)(drand48() * count);
+            uint32_t end = start + (uint32_t)(drand48() * (count - start + 1));
+            float minimum = INFINITY, maximum = -INFINITY;
+            for (uint32_t index = start; index < end; index++) {
+                float value = time_series_value_at(&buffer, index);
+                if (!isnan(value)) {
+                    minimum = MIN(minimum, value);
+                    maximum = MAX(maximum, value);
+                }
+            }
+            time_series_summary summary;
+            int found = time_series_range_min_max(&levels, &buffer, start, end, &summary);
+            XCTAssertEqual(found, minimum <= maximum);
+            if (found) {
+                XCTAssertEqual(summary.minimum, minimum);
+                XCTAssertEqual(summary.maximum, maximum);
+            }
+        }
+    }
+}
+
+- (void)testDecimationKeepsColumnExtremes {
+    [self openWithCapacity:4096];
+    for (int i = 0; i < 10000; i++) {
+        time_series_append(&buffer, i * 0.5, sinf(i * 0.01f) * 50 + (i % 13));
+    }
+    double from = time_series_time_at(&buffer, 0);
+    double to = time_series_time_at(&buffer, time_series_count(&buffer) - 1) + 0.5;
+    uint32_t columns = 320;
+    time_series_point points[2 * 320];
+    uint32_t count = time_series_decimate(&levels, &buffer, from, to, columns, points);
+    XCTAssertLessThanOrEqual(count, 2 * columns);
+
+    // Points are in time order and every column keeps its smallest and largest value
+    for (uint32_t index = 1; index < count; index++) {
+        XCTAssertLessThanOrEqual(points[index - 1].time, points[index].time);
+    }
+    double width = (to - from) / columns;
+    for (uint32_t column = 0; column < columns; column++) {
+        float minimum = INFINITY, maximum = -INFINITY;
+        for (uint32_t index = 0; index < time_series_count(&buffer); index++) {
+            double time = time_series_time_at(&buffer, index);
+            if (time >= from + column * width && time < from + (column + 1) * width) {
+                minimum = MIN(minimum, time_series_value_at(&buffer, index));
+                maximum = MAX(maximum, time_series_value_at(&buffer, index));
+            }
+        }
+        float pointMinimum = INFINITY, pointMaximum = -INFINITY;
+        for (uint32_t index = 0; index < count; index++) {
+            if (points[index].time >= from + column * width && points[index].time < from + (column + 1) * width) {
+                pointMinimum = MIN(pointMinimum, points[index].value);
+                pointMaximum = MAX(pointMaximum, points[index].value);
+            }
+        }
+        XCTAssertEqual(pointMinimum, minimum);
+        XCTAssertEqual(pointMaximum, maximum);
+    }
+}
+
+- (void)testSparseRangeKeepsEverySample {
+    [self openWithCapacity:64];
+    for (int i = 0; i < 10; i++) {
+        time_series_append(&buffer, i, i * 2);
+    }
+    time_series_point points[200];
+    XCTAssertEqual(time_series_decimate(&levels, &buffer, 0, 10, 100, points), 10u);
+    for (uint32_t index = 0; index < 10; index++) {
+        XCTAssertEqual(points[index].time, (double)index);
+        XCTAssertEqual(points[index].value, index * 2.0f);
+    }
+
+    // A cleared buffer is summarized again from its new samples
+    time_series_clear(&buffer);
+    time_series_levels_reset(&levels);
+    time_series_append(&buffer, 20, -1);
+    XCTAssertEqual(time_series_decimate(&levels, &buffer, 0, 30, 100, points), 1u);
+    XCTAssertEqual(points[0].value, -1.0f);
+}
+
+- (void)testDecimatePerformance {
+    [self openWithCapacity:1 << 20];
+    for (int i = 0; i < (1 << 20); i++) {
+        time_series_append(&buffer, i, (float)(i % 1000));
+    }
+    static time_series_point points[2 * 2000];
+    [self measureBlock:^{
+        for (int frame = 0; frame < 60; frame++) {
+            time_series_decimate(&self->levels, &self->buffer, frame * 1000, (1 << 20) - frame * 1000, 2000, points);
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,93 @@
+//
+//  TimeSeriesTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "TimeSeries.h"
+
+@interface TimeSeriesTests : XCTestCase
+
+@end
+
+@implementation TimeSeriesTests
+
+- (void)testOldestSamplesAreOverwritten {
+    XCTAssertNil([[TimeSeries alloc] initWithCapacity:0]);
+
+    TimeSeries *series = [[TimeSeries alloc] initWithCapacity:5];
+    for (int i = 0; i < 12; i++) {
+        [series appendValue:i * 10 atTime:i];
+    }
+    XCTAssertEqual(series.count, 5u);
+    XCTAssertEqual(series.droppedCount, 7u);
+    for (NSUInteger i = 0; i < series.count; i++) {
+        XCTAssertEqual([series timeAtIndex:i], 7.0 + i);
+        XCTAssertEqual([series valueAtIndex:i], (7.0f + i) * 10);
+    }
+
+    [series removeAllSamples];
+    XCTAssertEqual(series.count, 0u);
+    float minimum, maximum;
+    XCTAssertFalse([series getMinimumValue:&minimum maximumValue:&maximum]);
+}
+
+- (void)testRangeFollowsTheWindow {
+    TimeSeries *series = [[TimeSeries alloc] initWithCapacity:16];
+    float values[1000];
+    srand48(19);
+    for (int i = 0; i < 1000; i++) {
+        values[i] = (i % 97 == 0) ? NAN : (float)(drand48() * 200 - 100);
+        [series appendValue:values[i] atTime:i];
+
+        float expectedMinimum = INFINITY, expectedMaximum = -INFINITY;
+        for (int j = MAX(0, i - 15); j <= i; j++) {
+            if (!isnan(values[j])) {
+                expectedMinimum = MIN(expectedMinimum, values[j]);
+                expectedMaximum = MAX(expectedMaximum, values[j]);
+            }
+        }
+        float minimum, maximum;
+        XCTAssertTrue([series getMinimumValue:&minimum maximumValue:&maximum]);
+        XCTAssertEqual(minimum, expectedMinimum);
+        XCTAssertEqual(maximum, expectedMaximum);
+    }
+}
+
+- (void)testWindowIsReadInPlace {
+    TimeSeries *series = [[TimeSeries alloc] initWithCapacity:8];
+    for (int i = 0; i < 13; i++) {
+        [series appendValue:i atTime:i];
+    }
+
+    // Samples 5 to 12 sit at ring positions 5 to 7 and 0 to 4
+    time_series_window window = [series windowInRange:NSMakeRange(1, 6)];
+    XCTAssertEqual(window.length[0], 2u);
+    XCTAssertEqual(window.length[1], 4u);
+    XCTAssertEqual(window.values[0][0], 6.0f);
+    XCTAssertEqual(window.values[1][0], 8.0f);
+    XCTAssertEqual(window.times[1][3], 11.0);
+
+    window = [series windowInRange:NSMakeRange(6, 100)];
+    XCTAssertEqual(window.length[0], 2u);
+    XCTAssertEqual(window.length[1], 0u);
+    XCTAssertEqual(window.values[0][1], 12.0f);
+
+    window = [series windowInRange:NSMakeRange(8, 1)];
+    XCTAssertEqual(window.length[0] + window.length[1], 0u);
+}
+
+- (void)testAppendPerformance {
+    TimeSeries *series = [[TimeSeries alloc] initWithCapacity:200];
+    [self measureBlock:^{
+        float minimum, maximum;
+        for (int i = 0; i < 1000000; i++) {
+            [series appendValue:(float)(i % 251) atTime:i];
+            [series getMinimumValue:&minimum maximumValue:&maximum];
+        }
+    }];
+}
+
+@end
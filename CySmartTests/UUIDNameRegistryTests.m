@@ -0,0 +1,105 @@
+//
+//  UUIDNameRegistryTests.m
+//  CySmartTests
+//
+//  Copyright (c) 2015-2018   . All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <CoreBluetooth/CoreBluetooth.h>
+#import "ResourceHandler.h"
+#import "UUIDNameRegistry.h"
+
+#define NAMES_PLIST     @"serviceAndCharacteristicNames"
+
+@interface UUIDNameRegistryTests : XCTestCase
+
+@end
+
+@implementation UUIDNameRegistryTests
+
+- (void)tearDown {
+    [ResourceHandler removeAllUserDefinedNames];
+    [super tearDown];
+}
+
+- (NSArray *)sampleUUIDs {
+    return @[[CBUUID UUIDWithString:@"180D"], [CBUUID UUIDWithString:@"2A37"], [CBUUID UUIDWithString:@"2A1C"],
+             [CBUUID UUIDWithString:@"00060001-F8CE-11E4-ABF4-0002A5D5C51B"], [CBUUID UUIDWithString:@"FFF0"]];
+}
+
+- (void)testTableMatchesPlist {
+    NSDictionary *plist = [ResourceHandler getItemsFromPropertyList:NAMES_PLIST];
+    XCTAssertGreaterThan(plist.count, 0u);
+
+    // Keys in their shortest form are in the table as they are; longer forms of them name the same UUID
+    for (NSString *key in plist) {
+        if (key.length == 8 || [key hasSuffix:@"-0000-1000-8000-00805F9B34FB"]) {
+            continue;
+        }
+        XCTAssertEqualObjects([ResourceHandler getServiceNameForUUID:[CBUUID UUIDWithString:key]], plist[key], @"%@", key);
+    }
+    XCTAssertEqualObjects([ResourceHandler getServiceNameForUUID:[CBUUID UUIDWithString:@"0000CAB5"]], @"CapSense Service");
+    XCTAssertEqualObjects([ResourceHandler getServiceNameForUUID:[CBUUID UUIDWithString:@"1234"]], @"Unknown Service");
+    XCTAssertEqualObjects([ResourceHandler getCharacteristicNameForUUID:[CBUUID UUIDWithString:@"1234"]], @"Unknown Characteristic");
+}
+
+- (void)testLookupOfLongForms {
+    const uint8_t heartRate[16] = {0x00, 0x00, 0x18, 0x0D, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x34, 0xFB};
+    const uint8_t shortHeartRate[2] = {0x18, 0x0D};
+    uint32_t slot = uuid_name_lookup(shortHeartRate, 2);
+    XCTAssertNotEqual(slot, UUID_NAME_NOT_FOUND);
+    XCTAssertEqual(uuid_name_lookup(heartRate, 16), slot);
+    XCTAssertEqual(uuid_name_lookup(heartRate + 2, 4), slot);
+    XCTAssertEqual(strcmp(uuid_name_at(slot, NULL, NULL), "Heart Rate Service"), 0);
+    XCTAssertEqual(uuid_name_lookup(heartRate, 3), UUID_NAME_NOT_FOUND);
+
+    // Every slot is found again by its own UUID
+    uint32_t count = 0;
+    for (uint32_t index = 0; index < uuid_name_table_size(); index++) {
+        uint8_t bytes[16];
+        uint32_t length;
+        if (uuid_name_at(index, bytes, &length) != NULL) {
+            XCTAssertEqual(uuid_name_lookup(bytes, length), index);
+            count++;
+        }
+    }
+    XCTAssertGreaterThan(count, 100u);
+}
+
+- (void)testUserDefinedNamesOverrideTable {
+    CBUUID *heartRate = [CBUUID UUIDWithString:@"180D"];
+    CBUUID *custom = [CBUUID UUIDWithString:@"0000AB01-1111-2222-3333-444455556666"];
+    [ResourceHandler mergeUserDefinedNames:@{heartRate: @"Chest Strap", custom: @"Custom Service"}];
+    XCTAssertEqualObjects([ResourceHandler getServiceNameForUUID:heartRate], @"Chest Strap");
+    XCTAssertEqualObjects([ResourceHandler getServiceNameForUUID:custom], @"Custom Service");
+
+    [ResourceHandler setUserDefinedName:nil forUUID:heartRate];
+    XCTAssertEqualObjects([ResourceHandler getServiceNameForUUID:heartRate], @"Heart Rate Service");
+
+    [ResourceHandler removeAllUserDefinedNames];
+    XCTAssertEqualObjects([ResourceHandler getCharacteristicNameForUUID:custom], @"Unknown Characteristic");
+}
+
+// Per-lookup cost of reading the plist on every call, as getServiceNameForUUID: used to
+- (void)testPlistLookupPerformance {
+    NSArray *UUIDs = [self sampleUUIDs];
+    [self measureBlock:^{
+        for (int i = 0; i < 200; i++) {
+            CBUUID *UUID = UUIDs[i % UUIDs.count];
+            NSDictionary *names = [ResourceHandler getItemsFromPropertyList:NAMES_PLIST];
+            (void)[names objectForKey:UUID.UUIDString];
+        }
+    }];
+}
+
+- (void)testTableLookupPerformance {
+    NSArray *UUIDs = [self sampleUUIDs];
+    [self measureBlock:^{
+        for (int i = 0; i < 200000; i++) {
+            (void)[ResourceHandler getServiceNameForUUID:UUIDs[i % UUIDs.count]];
+        }
+    }];
+}
+
+@end
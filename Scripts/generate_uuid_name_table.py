@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+#
+# Generates CySmart/Classes/UtilClasses/UUIDNameTable.h, the compiled form of
+# serviceAndCharacteristicNames.plist looked up by UUIDNameRegistry.c.
+# Run it again whenever the plist changes:
+#
+#     python3 Scripts/generate_uuid_name_table.py
+#
+
+import os
+import plistlib
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+PLIST = os.path.join(ROOT, "CySmart", "Resources", "Plist", "serviceAndCharacteristicNames.plist")
+OUTPUT = os.path.join(ROOT, "CySmart", "Classes", "UtilClasses", "UUIDNameTable.h")
+
+BASE_UUID_SUFFIX = bytes.fromhex("00001000800000805F9B34FB")
+ENTRIES_PER_BUCKET = 4
+MAX_SEED = 0xFFFF
+
+
+def canonical_bytes(key):
+    """Same reduction as uuid_name_canonicalize: Bluetooth base UUIDs and 32 bit UUIDs below 0x10000 are 16 bit."""
+    data = bytes.fromhex(key.replace("-", ""))
+    if len(data) not in (2, 4, 16):
+        sys.exit("%s is not a 16, 32 or 128 bit UUID" % key)
+    if len(data) == 16 and data[4:] == BASE_UUID_SUFFIX:
+        data = data[:4]
+    if len(data) == 4 and data[:2] == b"\0\0":
+        data = data[2:]
+    return data
+
+
+def uuid_hash(data, seed):
+    """Same hash as uuid_name_hash."""
+    value = (2166136261 ^ seed) & 0xFFFFFFFF
+    value = ((value ^ len(data)) * 16777619) & 0xFFFFFFFF
+    for byte in data:
+        value = ((value ^ byte) * 16777619) & 0xFFFFFFFF
+    value ^= value >> 15
+    value = (value * 0x2C1B3C6D) & 0xFFFFFFFF
+    value ^= value >> 12
+    return value
+
+
+def power_of_two_at_least(count):
+    size = 1
+    while size < count:
+        size *= 2
+    return size
+
+
+def build(names):
+    table_size = power_of_two_at_least(len(names))
+    bucket_count = power_of_two_at_least(max(1, len(names) // ENTRIES_PER_BUCKET))
+
+    buckets = [[] for _ in range(bucket_count)]
+    for key in names:
+        buckets[uuid_hash(key, 0) & (bucket_count - 1)].append(key)
+
+    # Largest buckets first, each gets the first seed that puts all its keys in free slots
+    seeds = [0] * bucket_count
+    slots = [None] * table_size
+    for bucket in sorted(range(bucket_count), key=lambda index: -len(buckets[index])):
+        keys = buckets[bucket]
+        if not keys:
+            continue
+        for seed in range(1, MAX_SEED + 1):
+            taken = [uuid_hash(key, seed) & (table_size - 1) for key in keys]
+            if len(set(taken)) == len(taken) and all(slots[slot] is None for slot in taken):
+                break
+        else:
+            sys.exit("No seed places bucket %d, add more buckets" % bucket)
+        seeds[bucket] = seed
+        for key, slot in zip(keys, taken):
+            slots[slot] = key
+    return seeds, slots
+
+
+def c_string(text):
+    return '"%s\\0"' % text.replace("\\", "\\\\").replace('"', '\\"')
+
+
+def main():
+    with open(PLIST, "rb") as plist:
+        source = plistlib.load(plist)
+
+    # CBUUID reports the short form of a UUID, so a short key wins over a long key of the same UUID
+    names = {}
+    for key, name in sorted(source.items(), key=lambda item: (len(item[0]), item[0])):
+        data = canonical_bytes(key)
+        if data in names:
+            if names[data] != name:
+                sys.stderr.write("Skipping %s, the UUID is named %s\n" % (key, names[data]))
+            continue
+        names[data] = name
+
+    seeds, slots = build(names)
+
+    # Names are interned, UUIDs with the same name share it
+    strings = []
+    offsets = {}
+    offset = 0
+    for name in sorted(set(names.values())):
+        offsets[name] = offset
+        strings.append(name)
+        offset += len(name.encode("utf-8")) + 1
+    if offset > 0xFFFF:
+        sys.exit("Names do not fit 16 bit offsets")
+
+    lines = [
+        "/*",
+        " * Generated by Scripts/generate_uuid_name_table.py from serviceAndCharacteristicNames.plist.",
+        " * Do not edit.",
+        " */",
+        "",
+        "#define UUID_NAME_COUNT             %d" % len(names),
+        "#define UUID_NAME_TABLE_SIZE        %d" % len(slots),
+        "#define UUID_NAME_BUCKET_COUNT      %d" % len(seeds),
+        "",
+        "static const uint16_t uuid_name_seeds[UUID_NAME_BUCKET_COUNT] = {",
+    ]
+    for start in range(0, len(seeds), 16):
+        lines.append("    " + " ".join("%d," % seed for seed in seeds[start:start + 16]))
+    lines += ["};", "", "static const uuid_name_entry uuid_name_entries[UUID_NAME_TABLE_SIZE] = {"]
+    for key in slots:
+        if key is None:
+            lines.append("    {0, {0}, 0},")
+        else:
+            lines.append("    {%d, {%s}, %d},    /* %s */" % (
+                len(key), ", ".join("0x%02X" % byte for byte in key), offsets[names[key]], names[key].replace("*/", "* /")))
+    lines += ["};", "", "static const char uuid_name_strings[] ="]
+    lines += ["    " + c_string(name) for name in strings]
+    lines[-1] += ";"
+
+    with open(OUTPUT, "w", newline="\r\n") as output:
+        output.write("\n".join(lines) + "\n")
+
+
+if __name__ == "__main__":
+    main()